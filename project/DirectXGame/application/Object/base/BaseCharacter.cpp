@@ -16,7 +16,6 @@ void BaseCharacter::Initialize()
 void BaseCharacter::Update()
 {
 	// ワールド変換の更新
-	object3d_->SetCamera(camera_);
 	object3d_->SetTranslate(worldTransform_.GetTranslate());
 	object3d_->SetRotate(worldTransform_.GetRotate());
 	object3d_->SetScale(worldTransform_.GetScale());
@@ -1,5 +1,6 @@
 #include "Enemy.h"
 #include <CollisionTypeIdDef.h>
+#include <LightManager.h>
 #include <Object3dCommon.h>
 #include <ParticleEmitter.h>
 #include <PlayerChargeBullet.h>
@@ -13,6 +14,16 @@ namespace {
 	constexpr float kUpdateDeltaTime = 1.0f / 60.0f;
 	constexpr float kDeathDeltaTime = 1.0f / 120.0f;
 	constexpr float kRotationSpeedHalf = 0.005f;
+
+	// 撃破・被弾時に足す光（LightManager のクラスタのライト）
+	constexpr Vector4 kExplosionLightColor = { 1.0f, 0.55f, 0.2f, 1.0f };
+	constexpr float kExplosionLightIntensity = 4.0f;
+	constexpr float kExplosionLightRadius = 8.0f;
+	constexpr float kExplosionLightDecay = 2.0f;
+	constexpr float kExplosionLightLifeTime = 0.6f;
+	constexpr float kHitLightIntensity = 2.0f;
+	constexpr float kHitLightRadius = 4.0f;
+	constexpr float kHitLightLifeTime = 0.15f;
 }
 
 Enemy::Enemy()
@@ -24,6 +35,17 @@ Enemy::Enemy()
 	++sNextSerialNumber_;
 }
 
+Enemy::~Enemy()
+{
+	// 発射中の弾をプールへ返却
+	if (bulletPool_) {
+		for (EnemyBullet* bullet : bullets_) {
+			bulletPool_->Release(bullet);
+		}
+	}
+	bullets_.clear();
+}
+
 void Enemy::Initialize()
 {
 	// デフォルトパラメータで初期化
@@ -57,9 +79,6 @@ void Enemy::Initialize(const std::string& parameterFileName)
 	worldTransform.SetRotate(Vector3{ 0.0f, 3.0f, 0.0f });
 	worldTransform.SetTranslate(Vector3{ 10.0f, 0.0f, 0.0f });
 
-	// 敵のカメラを取得
-	camera_ = Object3dCommon::GetInstance()->GetDefaultCamera();
-
 	// 敵の3Dオブジェクトを生成・初期化
 	object3d_ = std::make_unique<Object3d>();
 	object3d_->Initialize("enemy.obj");
@@ -92,6 +111,13 @@ void Enemy::Initialize(const std::string& parameterFileName)
 
 	SetRadius(parameters_.colliderRadius);
 
+	// 弾プール（共有プールが設定されていなければ個別に生成）
+	if (!bulletPool_) {
+		ownedBulletPool_ = std::make_unique<EnemyBulletPool>();
+		ownedBulletPool_->Initialize();
+		bulletPool_ = ownedBulletPool_.get();
+	}
+
 	// 敵の攻撃パターンを初期化
 	attack_ = std::make_unique<EnemyAttack>();
 	attack_->Initialize("enemyAttackParameters"); // パラメータファイルから読み込み
@@ -105,13 +131,13 @@ void Enemy::Initialize(const std::string& parameterFileName)
 
 void Enemy::Update()
 {
-	// 弾の削除
-	bullets_.remove_if([](std::unique_ptr<EnemyBullet>& bullet) {
-		return !bullet->IsAlive();
-	});
+	// 弾の削除（プールへ返却）
+	MyEngine::EraseUnorderedIf(bullets_,
+		[](EnemyBullet* bullet) { return !bullet->IsAlive(); },
+		[this](EnemyBullet* bullet) { bulletPool_->Release(bullet); });
 
 	// 弾の更新
-	for (auto& bullet : bullets_) {
+	for (EnemyBullet* bullet : bullets_) {
 		bullet->Update();
 	}
 
@@ -134,7 +160,7 @@ void Enemy::Update()
 		}
 
 		if (controlEnabled_) {
-			attack_->Update(this, player_, bullets_, kUpdateDeltaTime);
+			attack_->Update(this, player_, kUpdateDeltaTime);
 		}
 
 		if (hp_ <= 0) {
@@ -147,7 +173,6 @@ void Enemy::Update()
 	worldTransform.Update();
 
 	// 敵のワールド変換を更新
-	object3d_->SetCamera(camera_);
 	object3d_->SetScale(worldTransform.GetScale());
 	object3d_->SetRotate(worldTransform.GetRotate());
 	object3d_->SetTranslate(worldTransform.GetTranslate());
@@ -211,7 +236,7 @@ void Enemy::Draw()
 		// 敵の描画
 		BaseCharacter::Draw();
 		// 弾の描画
-		for (auto& bullet : bullets_) {
+		for (EnemyBullet* bullet : bullets_) {
 			bullet->Draw();
 		}
 	}
@@ -239,6 +264,20 @@ void Enemy::Move()
 {
 }
 
+EnemyBullet* Enemy::FireBullet(const Vector3& velocity)
+{
+	EnemyBullet* bullet = bulletPool_->SpawnBullet(worldTransform.GetTranslate(), velocity);
+	bullets_.push_back(bullet);
+	return bullet;
+}
+
+EnemyHomingMissile* Enemy::FireMissile(const Vector3& velocity, Player* player)
+{
+	EnemyHomingMissile* missile = bulletPool_->SpawnMissile(worldTransform.GetTranslate(), velocity, player);
+	bullets_.push_back(missile);
+	return missile;
+}
+
 void Enemy::Attack()
 {
 }
@@ -276,6 +315,15 @@ void Enemy::PlayDeathParticleOnce()
 			enemyDeathEmitter_->SetParticleCount(parameters_.deathParticleCount);
 			enemyDeathEmitter_->Update();
 		}
+
+		// 爆発の光
+		LightManager::PointLight light{};
+		light.color = kExplosionLightColor;
+		light.position = GetWorldTransform().GetTranslate();
+		light.intensity = kExplosionLightIntensity;
+		light.radius = kExplosionLightRadius;
+		light.decay = kExplosionLightDecay;
+		LightManager::GetInstance()->AddPointLight(light, kExplosionLightLifeTime);
 		hasPlayedDeathParticle_ = true;
 	}
 }
@@ -289,6 +337,15 @@ void Enemy::PlayHitParticle()
 			enemyHitEmitter_->SetParticleCount(parameters_.hitParticleCount);
 			enemyHitEmitter_->Update();
 		}
+
+		// 被弾の光
+		LightManager::PointLight light{};
+		light.color = kExplosionLightColor;
+		light.position = GetWorldTransform().GetTranslate();
+		light.intensity = kHitLightIntensity;
+		light.radius = kHitLightRadius;
+		light.decay = kExplosionLightDecay;
+		LightManager::GetInstance()->AddPointLight(light, kHitLightLifeTime);
 		hasPlayedHitParticle_ = true;
 	}
 }
@@ -4,8 +4,9 @@
 #include <ParticleEmitter.h>
 #include <EnemyBullet.h>
 #include "EnemyAttack.h"
+#include "EnemyBulletPool.h"
 #include <memory>
-#include <list>
+#include <vector>
 #include <cstdint>
 #include <string>
 #include <CurveMoveManager.h>
@@ -81,6 +82,9 @@ public:
 	// コンストラクタ
 	Enemy();
 
+	// デストラクタ（発射中の弾をプールへ返却）
+	~Enemy();
+
 	// 初期化
 	void Initialize() override;
 
@@ -111,6 +115,12 @@ public:
 	// 敵ヒット時にパーティクルを出す
 	void PlayHitParticle();
 
+	// 通常弾の発射（プールから取得）
+	EnemyBullet* FireBullet(const Vector3& velocity);
+
+	// ミサイルの発射（プールから取得）
+	EnemyHomingMissile* FireMissile(const Vector3& velocity, Player* player);
+
 	void StartCurveMove();
 
 	bool HasStartedCurve() const { return hasStartedCurveMove_; }
@@ -146,7 +156,7 @@ public:
 	Player* GetPlayer() const { return player_; }
 
 	// 敵の弾リストを取得
-	std::list<std::unique_ptr<EnemyBullet>>& GetBullets() { return bullets_; }
+	const std::vector<EnemyBullet*>& GetBullets() const { return bullets_; }
 
 	// 敵のステートを取得
 	EnemyState GetState() const { return state_; }
@@ -165,6 +175,9 @@ public:
 	// プレイヤーへのポインタを設定
 	void SetPlayer(Player* player) { player_ = player; }
 
+	// 共有の弾プールを設定（Initialize前に設定する。未設定なら個別に生成）
+	void SetBulletPool(EnemyBulletPool* bulletPool) { bulletPool_ = bulletPool; }
+
 	// エネミー操作有効化フラグの設定
 	void SetControlEnabled(bool enabled) { controlEnabled_ = enabled; } 
 
@@ -201,9 +214,6 @@ private:
 	// 敵のシリアルナンバー
 	uint32_t serialNumber_ = 0;
 
-	// 敵のカメラ
-	MyEngine::Camera* camera_ = nullptr;
-
 	// 敵のリスポーンタイム
 	float respawnTime_ = EnemyDefaults::kRespawnTimeSec;
 	
@@ -228,8 +238,14 @@ private:
 	// 敵ヒット時にパーティクルを一度だけ再生するためのフラグ
 	bool hasPlayedHitParticle_ = false;
 
-	// 敵の弾リスト
-	std::list<std::unique_ptr<EnemyBullet>> bullets_;
+	// 弾プール（シーンと共有）
+	EnemyBulletPool* bulletPool_ = nullptr;
+
+	// 共有プールが無い場合の個別プール
+	std::unique_ptr<EnemyBulletPool> ownedBulletPool_;
+
+	// 発射中の弾（密配列）
+	std::vector<EnemyBullet*> bullets_;
 
 	// 発射間隔（秒）
 	float shotInterval_ = EnemyDefaults::kShotIntervalSec;
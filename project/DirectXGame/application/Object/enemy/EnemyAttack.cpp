@@ -4,13 +4,33 @@
 #include <Enemy.h>
 #include <Player.h>
 #include "JsonLoader.h"
+#include <FastMath.h>
+#include <FrameArena.h>
 
 #ifdef USE_IMGUI
 #include <imgui.h>
 #endif
 
+namespace {
+	// 角度ごとの XY 平面上の速度（速さは speed）。sin / cos は配列でまとめて求める
+	MyEngine::FrameVector<Vector3> MakeDirectionalVelocities(const MyEngine::FrameVector<float>& angles, float speed)
+	{
+		std::pmr::memory_resource* resource = angles.get_allocator().resource();
+		MyEngine::FrameVector<float> sines(angles.size(), resource);
+		MyEngine::FrameVector<float> cosines(angles.size(), resource);
+		Math::FastSinCos(angles.data(), sines.data(), cosines.data(), angles.size());
+
+		MyEngine::FrameVector<Vector3> velocities(resource);
+		velocities.reserve(angles.size());
+		for (size_t i = 0; i < angles.size(); ++i) {
+			velocities.push_back({ cosines[i] * speed, sines[i] * speed, 0.0f });
+		}
+		return velocities;
+	}
+}
+
 // パターン1: 画面右側で上下移動しつつ扇形弾
-void EnemyAttackPatternFan::Update(Enemy* enemy, Player*, std::list<std::unique_ptr<EnemyBullet>>& bullets, float deltaTime) {
+void EnemyAttackPatternFan::Update(Enemy* enemy, Player*, float deltaTime) {
 	// 上下移動
 	Vector3 t = enemy->GetWorldTransform().GetTranslate();
 	t.y += moveDir_ * parameters_.fanMoveSpeedY;
@@ -27,15 +47,13 @@ void EnemyAttackPatternFan::Update(Enemy* enemy, Player*, std::list<std::unique_
 	if (shotTimer_ >= parameters_.fanShotIntervalSec) {
 		const float baseAngle = parameters_.fanBaseAngle;
 		const float spread = parameters_.fanSpread;
+		MyEngine::FrameVector<float> angles(MyEngine::FrameArena::GetInstance()->GetResource());
 		for (int32_t i = 0; i < parameters_.fanShotCount; ++i) {
-			float angle = baseAngle - spread / 2.0f + spread * (float(i) / float(parameters_.fanShotCount - 1));
-			Vector3 v = { std::cos(angle) * parameters_.fanBulletSpeed,
-						  std::sin(angle) * parameters_.fanBulletSpeed,
-						  0.0f };
-			auto bullet = std::make_unique<EnemyBullet>();
-			bullet->Initialize(enemy->GetWorldTransform().GetTranslate(), v, "enemyBulletParameters");
+			angles.push_back(baseAngle - spread / 2.0f + spread * (float(i) / float(parameters_.fanShotCount - 1)));
+		}
+		for (const Vector3& v : MakeDirectionalVelocities(angles, parameters_.fanBulletSpeed)) {
+			EnemyBullet* bullet = enemy->FireBullet(v);
 			bullet->Update();
-			bullets.push_back(std::move(bullet));
 		}
 		shotTimer_ = 0.0f;
 	}
@@ -48,20 +66,19 @@ void EnemyAttackPatternFan::DrawImGui(int32_t idx, bool selected) {
 }
 
 // パターン2: 右側中央で自機狙い弾連射
-void EnemyAttackPatternAimed::Update(Enemy* enemy, Player* player, std::list<std::unique_ptr<EnemyBullet>>& bullets, float deltaTime) {
+void EnemyAttackPatternAimed::Update(Enemy* enemy, Player* player, float deltaTime) {
 	shotTimer_ += deltaTime;
 	if (shotTimer_ >= parameters_.aimedShotIntervalSec && player) {
 		Vector3 toPlayer = player->GetCenterPosition() - enemy->GetWorldTransform().GetTranslate();
-		float len = std::sqrt(toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y + toPlayer.z * toPlayer.z);
-		if (len > parameters_.aimedMinLen) {
+		float lengthSq = toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y + toPlayer.z * toPlayer.z;
+		if (lengthSq > parameters_.aimedMinLen * parameters_.aimedMinLen) {
 			float speed = parameters_.aimedBulletSpeed * parameters_.bulletSpeedScale;
-			Vector3 v = { toPlayer.x / len * speed,
-						  toPlayer.y / len * speed,
+			float inverseLength = Math::FastReciprocalSqrt(lengthSq);
+			Vector3 v = { toPlayer.x * inverseLength * speed,
+						  toPlayer.y * inverseLength * speed,
 						  0.0f };
-			auto bullet = std::make_unique<EnemyBullet>();
-			bullet->Initialize(enemy->GetWorldTransform().GetTranslate(), v, "enemyBulletParameters");
+			EnemyBullet* bullet = enemy->FireBullet(v);
 			bullet->Update();
-			bullets.push_back(std::move(bullet));
 		}
 		shotTimer_ = 0.0f;
 	}
@@ -74,7 +91,7 @@ void EnemyAttackPatternAimed::DrawImGui(int32_t idx, bool selected) {
 }
 
 // パターン3: 全方位弾+左突進→左で消えて右から復活
-void EnemyAttackPatternRush::Update(Enemy* enemy, Player*, std::list<std::unique_ptr<EnemyBullet>>& bullets, float deltaTime) {
+void EnemyAttackPatternRush::Update(Enemy* enemy, Player*, float deltaTime) {
 	if (!rushing_) {
 		Vector3 t = enemy->GetWorldTransform().GetTranslate();
 		t.x = parameters_.rushStartX;
@@ -91,15 +108,13 @@ void EnemyAttackPatternRush::Update(Enemy* enemy, Player*, std::list<std::unique
 	// 全方位弾
 	shotTimer_ += deltaTime;
 	if (shotTimer_ >= parameters_.rushShotIntervalSec) {
+		MyEngine::FrameVector<float> angles(MyEngine::FrameArena::GetInstance()->GetResource());
 		for (int32_t i = 0; i < parameters_.rushRingCount; ++i) {
-			float angle = 2.0f * EnemyAttackDefaults::kPi * float(i) / float(parameters_.rushRingCount);
-			Vector3 v = { std::cos(angle) * parameters_.rushRingSpeed,
-						  std::sin(angle) * parameters_.rushRingSpeed,
-						  0.0f };
-			auto bullet = std::make_unique<EnemyBullet>();
-			bullet->Initialize(enemy->GetWorldTransform().GetTranslate(), v, "enemyBulletParameters");
+			angles.push_back(2.0f * EnemyAttackDefaults::kPi * float(i) / float(parameters_.rushRingCount));
+		}
+		for (const Vector3& v : MakeDirectionalVelocities(angles, parameters_.rushRingSpeed)) {
+			EnemyBullet* bullet = enemy->FireBullet(v);
 			bullet->Update();
-			bullets.push_back(std::move(bullet));
 		}
 		shotTimer_ = 0.0f;
 	}
@@ -117,7 +132,7 @@ void EnemyAttackPatternRush::DrawImGui(int32_t idx, bool selected) {
 }
 
 // パターン4: 待機
-void EnemyAttackPatternWait::Update(Enemy* enemy, Player*, std::list<std::unique_ptr<EnemyBullet>>&, float /*deltaTime*/) {
+void EnemyAttackPatternWait::Update(Enemy* enemy, Player*, float /*deltaTime*/) {
 	// 待機中は特に何もしない
 }
 
@@ -130,7 +145,6 @@ void EnemyAttackPatternWait::DrawImGui(int32_t idx, bool selected) {
 void EnemyAttackPatternMissile::Update(
 	Enemy* enemy,
 	Player* player,
-	std::list<std::unique_ptr<EnemyBullet>>& bullets,
 	float deltaTime)
 {
 	shotTimer_ += deltaTime;
@@ -141,27 +155,15 @@ void EnemyAttackPatternMissile::Update(
 	const float spread = EnemyAttackDefaults::kPi / 6.0f;
 	const float baseAngle = EnemyAttackDefaults::kPi;
 
+	MyEngine::FrameVector<float> angles(MyEngine::FrameArena::GetInstance()->GetResource());
 	for (int i = 0; i < missileCount; ++i) {
-
-		float angle =
+		angles.push_back(
 			baseAngle - spread / 2.0f +
-			spread * (float(i) / float(missileCount - 1));
-
-		Vector3 vel{
-			std::cos(angle) * 0.12f,
-			std::sin(angle) * 0.12f,
-			0.0f
-		};
-
-		auto missile = std::make_unique<EnemyHomingMissile>();
-
-		missile->Initialize(
-			enemy->GetWorldTransform().GetTranslate(),
-			vel,
-			player,
-			"enemyBulletParameters");
+			spread * (float(i) / float(missileCount - 1)));
+	}
 
-		bullets.push_back(std::move(missile));
+	for (const Vector3& vel : MakeDirectionalVelocities(angles, 0.12f)) {
+		enemy->FireMissile(vel, player);
 	}
 
 	shotTimer_ = 0.0f;
@@ -193,7 +195,7 @@ void EnemyAttack::Initialize(const std::string& parameterFileName) {
 	}
 }
 
-void EnemyAttack::Update(Enemy* enemy, Player* player, std::list<std::unique_ptr<EnemyBullet>>& bullets, float deltaTime) {
+void EnemyAttack::Update(Enemy* enemy, Player* player, float deltaTime) {
 	// パターン遷移管理
 	patternTimer_ += deltaTime;
 
@@ -223,7 +225,7 @@ void EnemyAttack::Update(Enemy* enemy, Player* player, std::list<std::unique_ptr
 
 	// パターン実行
 	if (currentPattern_ >= 0 && currentPattern_ < int32_t(patterns_.size())) {
-		patterns_[currentPattern_]->Update(enemy, player, bullets, deltaTime);
+		patterns_[currentPattern_]->Update(enemy, player, deltaTime);
 	}
 }
 
@@ -1,7 +1,6 @@
 #pragma once
 #include <memory>
 #include <vector>
-#include <list>
 #include <cstdint>
 #include <EnemyBullet.h>
 #include <Player.h>
@@ -96,7 +95,7 @@ public:
 	virtual ~EnemyAttackPattern() = default;
 
 	// 更新
-	virtual void Update(Enemy* enemy, Player* player, std::list<std::unique_ptr<EnemyBullet>>& bullets, float deltaTime) = 0;
+	virtual void Update(Enemy* enemy, Player* player, float deltaTime) = 0;
 
 	// ImGui描画
 	virtual void DrawImGui(int32_t idx, bool selected) = 0;
@@ -118,7 +117,7 @@ protected:
 class EnemyAttackPatternFan : public EnemyAttackPattern {
 public:
 	// 更新
-	void Update(Enemy* enemy, Player* player, std::list<std::unique_ptr<EnemyBullet>>& bullets, float deltaTime) override;
+	void Update(Enemy* enemy, Player* player, float deltaTime) override;
 
 	// ImGui描画
 	void DrawImGui(int32_t idx, bool selected) override;
@@ -137,7 +136,7 @@ private:
 class EnemyAttackPatternAimed : public EnemyAttackPattern {
 public:
 	// 更新
-	void Update(Enemy* enemy, Player* player, std::list<std::unique_ptr<EnemyBullet>>& bullets, float deltaTime) override;
+	void Update(Enemy* enemy, Player* player, float deltaTime) override;
 
 	// ImGui描画
 	void DrawImGui(int32_t idx, bool selected) override;
@@ -155,7 +154,7 @@ private:
 class EnemyAttackPatternRush : public EnemyAttackPattern {
 public:
 	// 更新
-	void Update(Enemy* enemy, Player* player, std::list<std::unique_ptr<EnemyBullet>>& bullets, float deltaTime) override;
+	void Update(Enemy* enemy, Player* player, float deltaTime) override;
 
 	// ImGui描画
 	void DrawImGui(int32_t idx, bool selected) override;
@@ -174,7 +173,7 @@ private:
 class EnemyAttackPatternWait : public EnemyAttackPattern {
 public:
 	// 更新
-	void Update(Enemy* enemy, Player*, std::list<std::unique_ptr<EnemyBullet>>&, float deltaTime) override;
+	void Update(Enemy* enemy, Player*, float deltaTime) override;
 
 	// ImGui描画
 	void DrawImGui(int32_t idx, bool selected) override;
@@ -193,7 +192,6 @@ public:
 	void Update(
 		Enemy* enemy,
 		Player* player,
-		std::list<std::unique_ptr<EnemyBullet>>& bullets,
 		float deltaTime) override;
 
 	void DrawImGui(int32_t idx, bool selected) override;
@@ -217,7 +215,7 @@ public:
 	void Initialize(const std::string& parameterFileName);
 
 	// 更新
-	void Update(Enemy* enemy, Player* player, std::list<std::unique_ptr<EnemyBullet>>& bullets, float deltaTime);
+	void Update(Enemy* enemy, Player* player, float deltaTime);
 
 	// ImGui描画
 	void DrawImGui();
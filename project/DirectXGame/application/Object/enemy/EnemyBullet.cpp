@@ -9,6 +9,13 @@ void EnemyBullet::Initialize(const Vector3& position, const Vector3& velocity)
 }
 
 void EnemyBullet::Initialize(const Vector3& position, const Vector3& velocity, const std::string& parameterFileName)
+{
+	// 生成と発射をまとめて行う
+	Create(parameterFileName);
+	Spawn(position, velocity);
+}
+
+void EnemyBullet::Create(const std::string& parameterFileName)
 {
 	// パラメータファイルから読み込み（空文字列の場合はデフォルトパラメータを使用）
 	if (!parameterFileName.empty()) {
@@ -17,6 +24,19 @@ void EnemyBullet::Initialize(const Vector3& position, const Vector3& velocity, c
 		parameters_ = defaultParameters_;
 	}
 
+	// 定数バッファを持つリソースはここでのみ生成する
+	worldTransform_.Initialize();
+
+	// オブジェクトを設定
+	objectBullet_ = std::make_unique<Object3d>();
+	objectBullet_->Initialize(parameters_.modelFileName);
+
+	// 発射されるまでは非アクティブ
+	isAlive_ = false;
+}
+
+void EnemyBullet::Spawn(const Vector3& position, const Vector3& velocity)
+{
 	// ColliderにIDをセット
 	Collider::SetTypeID(static_cast<uint32_t>(CollisionTypeIdDef::kEnemyBullet));
 
@@ -25,16 +45,12 @@ void EnemyBullet::Initialize(const Vector3& position, const Vector3& velocity, c
 	lifeFrame_ = parameters_.lifeFrames;
 	radius_    = parameters_.radius;
 
-	worldTransform_.Initialize();
 	worldTransform_.SetScale(parameters_.initScale);
 	worldTransform_.SetRotate(parameters_.initRotate);
 	worldTransform_.SetTranslate(position);
 
 	velocity_ = velocity;
 
-	// オブジェクトを設定
-	objectBullet_ = std::make_unique<Object3d>();
-	objectBullet_->Initialize(parameters_.modelFileName);
 	objectBullet_->SetScale(worldTransform_.GetScale());
 	objectBullet_->SetTranslate(worldTransform_.GetTranslate());
 
@@ -47,6 +47,12 @@ public:
 	// パラメータファイルから初期化
 	void Initialize(const Vector3& position, const Vector3& velocity, const std::string& parameterFileName);
 
+	// プール用の事前生成（パラメータ読み込みとリソース確保のみ行い、非アクティブで待機）
+	void Create(const std::string& parameterFileName);
+
+	// プールからの再利用（状態のみリセットし、リソースは再確保しない）
+	void Spawn(const Vector3& position, const Vector3& velocity);
+
 	// 更新
 	virtual void Update();
     
@@ -74,6 +80,9 @@ public:
 
 	const Vector3& GetVelocity() const { return velocity_; }
 
+	// 描画用オブジェクトを取得（視錐台カリングの登録に使う）
+	Object3d* GetObject3d() const { return objectBullet_.get(); }
+
 	void SetVelocity(const Vector3& velocity) { velocity_ = velocity; }
 
 	// 位置を設定
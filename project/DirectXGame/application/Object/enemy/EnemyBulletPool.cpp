@@ -0,0 +1,39 @@
+#include "EnemyBulletPool.h"
+#include <CollisionTypeIdDef.h>
+
+void EnemyBulletPool::Initialize(uint32_t bulletCapacity, uint32_t missileCapacity)
+{
+	// パラメータの読み込みとGPUリソースの確保は事前生成時に一度だけ行う
+	bulletPool_.Initialize(bulletCapacity, [](EnemyBullet& bullet) {
+		bullet.Create(EnemyBulletPoolDefaults::kParameterFileName);
+	});
+	missilePool_.Initialize(missileCapacity, [](EnemyHomingMissile& missile) {
+		missile.Create(EnemyBulletPoolDefaults::kParameterFileName);
+	});
+}
+
+EnemyBullet* EnemyBulletPool::SpawnBullet(const Vector3& position, const Vector3& velocity)
+{
+	EnemyBullet* bullet = bulletPool_.Acquire();
+	bullet->Spawn(position, velocity);
+	return bullet;
+}
+
+EnemyHomingMissile* EnemyBulletPool::SpawnMissile(const Vector3& position, const Vector3& velocity, Player* player)
+{
+	EnemyHomingMissile* missile = missilePool_.Acquire();
+	missile->Spawn(position, velocity, player);
+	return missile;
+}
+
+void EnemyBulletPool::Release(EnemyBullet* bullet)
+{
+	// 返却時に非アクティブ化しておく
+	bullet->SetAlive(false);
+
+	if (bullet->GetTypeID() == static_cast<uint32_t>(CollisionTypeIdDef::kEnemyMissile)) {
+		missilePool_.Release(static_cast<EnemyHomingMissile*>(bullet));
+	} else {
+		bulletPool_.Release(bullet);
+	}
+}
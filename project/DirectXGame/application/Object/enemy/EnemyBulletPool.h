@@ -0,0 +1,58 @@
+#pragma once
+#include <ObjectPool.h>
+#include "EnemyBullet.h"
+#include "EnemyHomingMissile.h"
+#include <cstdint>
+
+// 前方宣言
+class Player;
+
+/// <summary>
+/// 敵弾プールの調整用定数
+/// </summary>
+namespace EnemyBulletPoolDefaults {
+	inline constexpr uint32_t kBulletCapacity  = 128; // 通常弾の事前生成数
+	inline constexpr uint32_t kMissileCapacity = 16;  // ミサイルの事前生成数
+	inline constexpr const char* kParameterFileName = "enemyBulletParameters";
+}
+
+/// <summary>
+/// 敵の弾・ミサイルのオブジェクトプール
+/// 複数の敵で共有し、発射時の生成・リソース確保を無くす
+/// </summary>
+class EnemyBulletPool
+{
+public:
+	/*------メンバ関数------*/
+
+	// 初期化（弾とミサイルを事前生成）
+	void Initialize(
+		uint32_t bulletCapacity = EnemyBulletPoolDefaults::kBulletCapacity,
+		uint32_t missileCapacity = EnemyBulletPoolDefaults::kMissileCapacity);
+
+	// 通常弾の取得と発射
+	EnemyBullet* SpawnBullet(const Vector3& position, const Vector3& velocity);
+
+	// ミサイルの取得と発射
+	EnemyHomingMissile* SpawnMissile(const Vector3& position, const Vector3& velocity, Player* player);
+
+	// 返却（種類はコライダーIDで判別）
+	void Release(EnemyBullet* bullet);
+
+	/*------ゲッター------*/
+
+	// 使用中の通常弾数
+	size_t GetActiveBulletCount() const { return bulletPool_.GetActiveCount(); }
+
+	// 使用中のミサイル数
+	size_t GetActiveMissileCount() const { return missilePool_.GetActiveCount(); }
+
+private:
+	/*------メンバ変数------*/
+
+	// 通常弾
+	MyEngine::ObjectPool<EnemyBullet> bulletPool_;
+
+	// ミサイル
+	MyEngine::ObjectPool<EnemyHomingMissile> missilePool_;
+};
@@ -1,6 +1,16 @@
 #include "EnemyHomingMissile.h"
 #include <cmath>
 #include <CollisionTypeIdDef.h>
+#include <FastMath.h>
+#include <LightManager.h>
+
+namespace {
+    // 噴射の光（毎フレーム足す。LightManager のクラスタのライト）
+    constexpr Vector4 kExhaustLightColor = { 1.0f, 0.3f, 0.1f, 1.0f };
+    constexpr float kExhaustLightIntensity = 1.5f;
+    constexpr float kExhaustLightRadius = 3.0f;
+    constexpr float kExhaustLightDecay = 2.0f;
+}
 
 void EnemyHomingMissile::Initialize(
     const Vector3& pos,
@@ -8,19 +18,29 @@ void EnemyHomingMissile::Initialize(
     Player* player,
     const std::string& paramFile)
 {
-    EnemyBullet::Initialize(pos, velocity, paramFile);
+    EnemyBullet::Create(paramFile);
+    Spawn(pos, velocity, player);
+}
+
+void EnemyHomingMissile::Spawn(const Vector3& pos, const Vector3& velocity, Player* player)
+{
+    EnemyBullet::Spawn(pos, velocity);
     player_ = player;
 
+    // 再利用時は追尾タイマーを戻す
+    timer_ = 0.0f;
+
     Collider::SetTypeID(static_cast<uint32_t>(CollisionTypeIdDef::kEnemyMissile));
 
     // 初速を一定速度に揃える（重要）
     Vector3 vel = GetVelocity();
 
-    float len = std::sqrt(vel.x * vel.x + vel.y * vel.y + vel.z * vel.z);
-    if (len > 0.001f) {
-        vel.x /= len;
-        vel.y /= len;
-        vel.z /= len;
+    float lengthSq = vel.x * vel.x + vel.y * vel.y + vel.z * vel.z;
+    if (lengthSq > 0.001f * 0.001f) {
+        float inverseLength = Math::FastReciprocalSqrt(lengthSq);
+        vel.x *= inverseLength;
+        vel.y *= inverseLength;
+        vel.z *= inverseLength;
     }
 
     vel *= speed_;
@@ -37,17 +57,18 @@ void EnemyHomingMissile::Update()
         Vector3 pos = GetWorldTransform().GetTranslate();
         Vector3 toPlayer = player_->GetCenterPosition() - pos;
 
-        float len = std::sqrt(
+        float lengthSq =
             toPlayer.x * toPlayer.x +
             toPlayer.y * toPlayer.y +
-            toPlayer.z * toPlayer.z);
+            toPlayer.z * toPlayer.z;
 
-        if (len > 0.001f) {
+        if (lengthSq > 0.001f * 0.001f) {
 
             // 方向ベクトル（正規化）
+            float inverseLength = Math::FastReciprocalSqrt(lengthSq);
             Vector3 dir{
-                toPlayer.x / len,
-                toPlayer.y / len,
+                toPlayer.x * inverseLength,
+                toPlayer.y * inverseLength,
                 0.0f
             };
 
@@ -58,15 +79,16 @@ void EnemyHomingMissile::Update()
             vel.y += (dir.y - vel.y) * rotateSpeed_;
 
             // ★ここが超重要：速度を一定にする
-            float vlen = std::sqrt(
+            float velocityLengthSq =
                 vel.x * vel.x +
                 vel.y * vel.y +
-                vel.z * vel.z);
+                vel.z * vel.z;
 
-            if (vlen > 0.001f) {
-                vel.x /= vlen;
-                vel.y /= vlen;
-                vel.z /= vlen;
+            if (velocityLengthSq > 0.001f * 0.001f) {
+                float inverseVelocityLength = Math::FastReciprocalSqrt(velocityLengthSq);
+                vel.x *= inverseVelocityLength;
+                vel.y *= inverseVelocityLength;
+                vel.z *= inverseVelocityLength;
             }
 
             vel *= speed_;
@@ -77,6 +99,17 @@ void EnemyHomingMissile::Update()
 
     // 通常更新
     EnemyBullet::Update();
+
+    // 噴射の光
+    if (IsAlive()) {
+        MyEngine::LightManager::PointLight light{};
+        light.color = kExhaustLightColor;
+        light.position = GetWorldTransform().GetTranslate();
+        light.intensity = kExhaustLightIntensity;
+        light.radius = kExhaustLightRadius;
+        light.decay = kExhaustLightDecay;
+        MyEngine::LightManager::GetInstance()->AddPointLight(light);
+    }
 }
 
 void EnemyHomingMissile::OnCollision(Collider* other)
@@ -12,6 +12,9 @@ public:
         Player* player,
         const std::string& paramFile);
 
+    // プールからの再利用（Create済みのミサイルを発射する）
+    void Spawn(const Vector3& pos, const Vector3& velocity, Player* player);
+
     void Update() override;
 
     void OnCollision(Collider* other) override;
@@ -1,4 +1,5 @@
 #include "Player.h"
+#include <LightManager.h>
 #include <Object3dCommon.h>
 #include <CollisionTypeIdDef.h>
 #include <PlayerBullet.h>
@@ -10,6 +11,15 @@
 #include <imgui.h>
 #endif
 
+namespace {
+	// 撃破時に足す光（LightManager のクラスタのライト）
+	constexpr Vector4 kExplosionLightColor = { 1.0f, 0.6f, 0.3f, 1.0f };
+	constexpr float kExplosionLightIntensity = 5.0f;
+	constexpr float kExplosionLightRadius = 10.0f;
+	constexpr float kExplosionLightDecay = 2.0f;
+	constexpr float kExplosionLightLifeTime = 1.0f;
+}
+
 Player::Player()
 	: worldTransform_(BaseCharacter::GetWorldTransform())
 {
@@ -47,9 +57,6 @@ void Player::Initialize(const std::string& parameterFileName)
 	worldTransform_.SetRotate(parameters_.initRotate);
 	worldTransform_.SetTranslate(parameters_.initTranslate);
 
-	// プレイヤーのカメラを取得
-	camera_ = Object3dCommon::GetInstance()->GetDefaultCamera();
-
 	// 3Dオブジェクトの初期化
 	
 	object3d_ = std::make_unique<Object3d>();
@@ -69,6 +76,15 @@ void Player::Initialize(const std::string& parameterFileName)
 	explosionEmitter_ = std::make_unique<ParticleEmitter>(ParticleManager::GetInstance(), "explosion");
 	explosionEmitter_->SetUseRingParticle(true);
 	explosionEmitter_->SetExplosion(true);
+
+	// 弾プールの事前生成（パラメータ読み込みとGPUリソース確保はここで一度だけ行う）
+	bulletPool_.Initialize(PlayerDefaults::kBulletPoolCapacity, [](PlayerBullet& bullet) {
+		bullet.Create("playerBulletParameters");
+	});
+	chargeBulletPool_.Initialize(PlayerDefaults::kChargeBulletPoolCapacity, [](PlayerChargeBullet& bullet) {
+		bullet.Create("playerChargeBulletParameters");
+	});
+	bullets_.reserve(PlayerDefaults::kBulletPoolCapacity + PlayerDefaults::kChargeBulletPoolCapacity);
 }
 
 void Player::Update()
@@ -77,16 +93,10 @@ void Player::Update()
 	BaseCharacter::Update();
 
 	// 弾の削除
-	bullets_.remove_if([](std::unique_ptr<PlayerBullet>& bullet) {
-		if (!bullet->IsAlive()) {
-			bullet.reset();
-			return true;
-		}
-		return false;
-	});
+	ReleaseDeadBullets();
 
 	// 弾の更新
-	for (auto& bullet : bullets_) {
+	for (PlayerBullet* bullet : bullets_) {
 		bullet->Update();
 	}
 
@@ -114,7 +124,6 @@ void Player::Update()
 	worldTransform_.Update();
 
 	// 3Dオブジェクトへ反映	
-	object3d_->SetCamera(GetCamera());
 	object3d_->SetTranslate(worldTransform_.GetTranslate());
 	object3d_->SetRotate(worldTransform_.GetRotate());
 	object3d_->SetScale(worldTransform_.GetScale());
@@ -128,7 +137,7 @@ void Player::Draw()
 		return;
 	}
 	BaseCharacter::Draw();
-	for (auto& bullet : bullets_) {
+	for (PlayerBullet* bullet : bullets_) {
 		bullet->Draw();
 	}
 }
@@ -179,17 +188,17 @@ void Player::Attack()
 	else {
 		// チャージショット
 		if (isCharging_ && chargeReady_) {
-			auto chargeBullet = std::make_unique<PlayerChargeBullet>();
-			chargeBullet->Initialize(worldTransform_.GetTranslate(), "playerChargeBulletParameters");
+			PlayerChargeBullet* chargeBullet = chargeBulletPool_.Acquire();
+			chargeBullet->Spawn(worldTransform_.GetTranslate());
 			chargeBullet->Update();
-			bullets_.push_back(std::move(chargeBullet));
+			bullets_.push_back(chargeBullet);
 		}
 		// 通常ショット
 		else if (isCharging_ && chargeTime_ < parameters_.chargeReadySec) {
-			auto bullet = std::make_unique<PlayerBullet>();
-			bullet->Initialize(worldTransform_.GetTranslate(), "playerBulletParameters");
+			PlayerBullet* bullet = bulletPool_.Acquire();
+			bullet->Spawn(worldTransform_.GetTranslate());
 			bullet->Update();
-			bullets_.push_back(std::move(bullet));
+			bullets_.push_back(bullet);
 		}
 		// リセット
 		isCharging_ = false;
@@ -198,6 +207,20 @@ void Player::Attack()
 	}
 }
 
+void Player::ReleaseDeadBullets()
+{
+	// 種類（コライダーID）に応じたプールへ返却
+	MyEngine::EraseUnorderedIf(bullets_,
+		[](PlayerBullet* bullet) { return !bullet->IsAlive(); },
+		[this](PlayerBullet* bullet) {
+			if (bullet->GetTypeID() == static_cast<uint32_t>(CollisionTypeIdDef::kPlayerChargeBullet)) {
+				chargeBulletPool_.Release(static_cast<PlayerChargeBullet*>(bullet));
+			} else {
+				bulletPool_.Release(bullet);
+			}
+		});
+}
+
 void Player::OnCollision(Collider* other)
 {
 	if (IsAlive()) {
@@ -243,6 +266,15 @@ void Player::PlayDeathParticleOnce()
 			explosionEmitter_->SetParticleCount(parameters_.explosionCount);
 			explosionEmitter_->Update();
 		}
+
+		// 爆発の光
+		MyEngine::LightManager::PointLight light{};
+		light.color = kExplosionLightColor;
+		light.position = worldTransform_.GetTranslate();
+		light.intensity = kExplosionLightIntensity;
+		light.radius = kExplosionLightRadius;
+		light.decay = kExplosionLightDecay;
+		MyEngine::LightManager::GetInstance()->AddPointLight(light, kExplosionLightLifeTime);
 		hasPlayedDeathParticle_ = true;
 	}
 }
@@ -2,14 +2,14 @@
 #include "BaseCharacter.h"
 #include "ParticleManager.h"
 #include "ParticleEmitter.h"
+#include "PlayerChargeBullet.h"
+#include <ObjectPool.h>
 #include <memory>
-#include <list>
+#include <vector>
 #include <string>
 #include <cstdint>
 
 // 前方宣言
-class PlayerBullet;
-class PlayerChargeBullet;
 struct Vector3;
 
 /// <summary>
@@ -35,6 +35,10 @@ namespace PlayerDefaults {
 	inline constexpr Vector3  kInitScale  = { 1.0f, 1.0f, 1.0f };
 	inline constexpr Vector3  kInitRotate = { 0.0f, 0.0f, 0.0f };
 	inline constexpr Vector3  kInitTranslate = { 0.0f, 0.0f, 0.0f };
+
+	// 弾プールの事前生成数
+	inline constexpr uint32_t kBulletPoolCapacity       = 64;
+	inline constexpr uint32_t kChargeBulletPoolCapacity = 8;
 }
 
 /// <summary>
@@ -111,6 +115,9 @@ public:
 	// プレイヤー死亡時に一度だけパーティクルを出す
 	void PlayDeathParticleOnce();
 
+	// 死亡した弾をプールへ返却
+	void ReleaseDeadBullets();
+
 	// 中心座標を取得する純粋仮想関数
 	Vector3 GetCenterPosition() const override;
 
@@ -119,11 +126,8 @@ public:
 
 	/*------ゲッター------*/
 
-	// プレイヤーの弾を取得
-	std::list<std::unique_ptr<PlayerBullet>>& GetBullets() { return bullets_; }
-
-	// プレイヤーのチャージ弾を取得
-	std::list<std::unique_ptr<PlayerChargeBullet>>& GetChargeBullets() { return chargeBullets_; }
+	// プレイヤーの弾を取得（通常弾・チャージ弾の両方を含む）
+	const std::vector<PlayerBullet*>& GetBullets() const { return bullets_; }
 
 	// プレイヤーのコントロール有効フラグを取得
 	bool GetPlayerControlEnabled() const { return controlEnabled_; }
@@ -154,11 +158,14 @@ private:
 	// パラメータ（JSONから読み込み）
 	PlayerParameters parameters_;
 
-	// 武器
-	std::list<std::unique_ptr<PlayerBullet>> bullets_;
+	// 通常弾プール
+	MyEngine::ObjectPool<PlayerBullet> bulletPool_;
 
-	// チャージ弾
-	std::list<std::unique_ptr<PlayerChargeBullet>> chargeBullets_;
+	// チャージ弾プール
+	MyEngine::ObjectPool<PlayerChargeBullet> chargeBulletPool_;
+
+	// 発射中の弾（密配列）
+	std::vector<PlayerBullet*> bullets_;
 
 	// プレイヤーの移動速度
 	float moveSpeed_ = PlayerDefaults::kMoveSpeed;
@@ -174,9 +181,6 @@ private:
 
 	// プレイヤーのシリアルナンバー
 	uint32_t serialNumber_ = 0;
-	
-	// プレイヤーのカメラ
-	MyEngine::Camera* camera_ = nullptr;
 
 	// 発射フラグ
 	bool isShot_ = false;
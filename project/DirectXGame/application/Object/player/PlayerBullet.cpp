@@ -11,6 +11,13 @@ void PlayerBullet::Initialize(const Vector3& position)
 }
 
 void PlayerBullet::Initialize(const Vector3& position, const std::string& parameterFileName)
+{
+	// 生成と発射をまとめて行う
+	Create(parameterFileName);
+	Spawn(position);
+}
+
+void PlayerBullet::Create(const std::string& parameterFileName)
 {
 	// パラメータファイルから読み込み（空文字列の場合はデフォルトパラメータを使用）
 	if (!parameterFileName.empty()) {
@@ -19,6 +26,24 @@ void PlayerBullet::Initialize(const Vector3& position, const std::string& parame
 		parameters_ = defaultParameters_;
 	}
 
+	CreateResources();
+}
+
+void PlayerBullet::CreateResources()
+{
+	// 定数バッファを持つリソースはここでのみ生成する
+	worldTransform_.Initialize();
+
+	// 弾オブジェクト
+	objectBullet_ = std::make_unique<Object3d>();
+	objectBullet_->Initialize(parameters_.modelFileName);
+
+	// 発射されるまでは非アクティブ
+	isAlive_ = false;
+}
+
+void PlayerBullet::Spawn(const Vector3& position)
+{
 	// ColliderにIDをセット
 	Collider::SetTypeID(static_cast<uint32_t>(CollisionTypeIdDef::kPlayerBullet));
 
@@ -27,14 +52,10 @@ void PlayerBullet::Initialize(const Vector3& position, const std::string& parame
 	lifeFrame_ = parameters_.lifeFrames;
 	radius_    = parameters_.radius;
 
-	worldTransform_.Initialize();
 	worldTransform_.SetScale(parameters_.initScale);
 	worldTransform_.SetRotate(parameters_.initRotate);
 	worldTransform_.SetTranslate(position);
 
-	// 弾オブジェクト
-	objectBullet_ = std::make_unique<Object3d>();
-	objectBullet_->Initialize(parameters_.modelFileName);
 	objectBullet_->SetScale(worldTransform_.GetScale());
 	objectBullet_->SetTranslate(worldTransform_.GetTranslate());
 
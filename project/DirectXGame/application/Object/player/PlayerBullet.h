@@ -58,6 +58,12 @@ public:
 	// パラメータファイルから初期化
 	virtual void Initialize(const Vector3& position, const std::string& parameterFileName);
 
+	// プール用の事前生成（パラメータ読み込みとリソース確保のみ行い、非アクティブで待機）
+	virtual void Create(const std::string& parameterFileName);
+
+	// プールからの再利用（状態のみリセットし、リソースは再確保しない）
+	virtual void Spawn(const Vector3& position);
+
 	// 更新
 	virtual void Update();
 
@@ -84,6 +90,9 @@ public:
 	// 半径の取得
 	float GetRadius() const { return radius_; }
 
+	// 描画用オブジェクトの取得（視錐台カリングの登録に使う）
+	Object3d* GetObject3d() const { return objectBullet_.get(); }
+
 	// パラメータの取得
 	const PlayerBulletParameters& GetParameters() const { return parameters_; }
 
@@ -108,6 +117,11 @@ public:
 	static const PlayerBulletParameters& GetDefaultParameters();
 
 protected:
+	/*------メンバ関数------*/
+
+	// 現在のパラメータでワールド変換・オブジェクトを生成
+	void CreateResources();
+
 	/*------メンバ変数------*/
 
 	// パラメータ（JSONから読み込み）
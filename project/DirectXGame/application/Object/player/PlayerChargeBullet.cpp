@@ -5,11 +5,7 @@
 // 静的メンバ変数の初期化
 uint32_t PlayerChargeBullet::sNextSerialNumber_ = PlayerChargeBulletDefaults::kSerialStart;
 
-PlayerChargeBullet::PlayerChargeBullet()
-{
-	// シリアルナンバーを設定
-	serialNumber_ = sNextSerialNumber_++;
-}
+PlayerChargeBullet::PlayerChargeBullet() = default;
 
 void PlayerChargeBullet::Initialize(const Vector3& position)
 {
@@ -18,6 +14,13 @@ void PlayerChargeBullet::Initialize(const Vector3& position)
 }
 
 void PlayerChargeBullet::Initialize(const Vector3& position, const std::string& parameterFileName)
+{
+	// 生成と発射をまとめて行う
+	Create(parameterFileName);
+	Spawn(position);
+}
+
+void PlayerChargeBullet::Create(const std::string& parameterFileName)
 {
 	// パラメータファイルから読み込み（空文字列の場合はデフォルトパラメータを使用）
 	if (!parameterFileName.empty()) {
@@ -29,14 +32,20 @@ void PlayerChargeBullet::Initialize(const Vector3& position, const std::string&
 	// パラメータを適用
 	damage_ = chargeBulletParameters_.damage;
 
-	// 基底クラスのパラメータを設定してから初期化
+	// 基底クラスのパラメータを設定してからリソースを生成
 	PlayerBullet::SetParameters(chargeBulletParameters_.baseBulletParams);
-	
-	// 基底の初期化（位置・Transformなど）
-	// 空文字列を渡すことで、既に設定されたパラメータを使用
-	PlayerBullet::Initialize(position, "");
+	PlayerBullet::CreateResources();
+}
+
+void PlayerChargeBullet::Spawn(const Vector3& position)
+{
+	// 基底の発射処理（位置・Transformなど）
+	PlayerBullet::Spawn(position);
+
+	// 再利用時も弾ごとに別のシリアルナンバーを振る
+	serialNumber_ = sNextSerialNumber_++;
 
-	// チャージ弾のコライダーID（基底クラスの初期化後に上書き）
+	// チャージ弾のコライダーID（基底クラスの処理後に上書き）
 	Collider::SetTypeID(static_cast<uint32_t>(CollisionTypeIdDef::kPlayerChargeBullet));
 
 	// worldTransformのスケールを拡大（パラメータから倍率取得）
@@ -48,6 +48,12 @@ public:
 	// パラメータファイルから初期化
 	void Initialize(const Vector3& position, const std::string& parameterFileName);
 
+	// プール用の事前生成
+	void Create(const std::string& parameterFileName) override;
+
+	// プールからの再利用
+	void Spawn(const Vector3& position) override;
+
 	// 更新
 	void Update() override;
 
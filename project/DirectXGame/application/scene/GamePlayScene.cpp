@@ -32,6 +32,10 @@ void GamePlayScene::Initialize(DirectXCommon* directXCommon, WinApp* winApp)
 	InitializeUIObjects();
 	InitializeGameTimers();
 	InitializePostEffects();
+
+	// 更新処理のタスクグラフ
+	BuildUpdateGraph(updateGraph_);
+	updateGraph_.Compile();
 }
 
 void GamePlayScene::InitializeSprite()
@@ -66,7 +70,7 @@ void GamePlayScene::InitializeSprite()
 void GamePlayScene::InitializeAudio()
 {
 	Audio::GetInstance()->Initialize();
-	soundData1_ = Audio::GetInstance()->SoundLoadWave("resources/Alarm01.wav");
+	soundData1_ = Audio::GetInstance()->LoadSound("resources/Alarm01.wav");
 }
 
 void GamePlayScene::InitializeFade()
@@ -85,7 +89,6 @@ void GamePlayScene::InitializePlayer()
 
 	// プレイヤーの弾のリストを取得
 	playerBullets_ = &player_->GetBullets();
-	playerChargeBullets_ = &player_->GetChargeBullets();
 }
 
 void GamePlayScene::InitializeEnemyCurves()
@@ -113,6 +116,11 @@ void GamePlayScene::InitializeLevelData()
 {
 	levelData_ = JsonLoader::Load("test");
 	LoadLevel(levelData_);
+
+	// 敵の弾プール（全ての敵で共有）
+	enemyBulletPool_ = std::make_unique<EnemyBulletPool>();
+	enemyBulletPool_->Initialize();
+
 	CreateObjectsFromLevelData();
 
 	// プレイヤー配置データからプレイヤーを配置
@@ -241,26 +249,76 @@ void GamePlayScene::InitializePostEffects()
 
 void GamePlayScene::Update()
 {
-	// 入力処理
-	UpdateInput();
+	// 入力 → フェード → 演出 → プレイヤー → 敵 / レベルオブジェクト → カメラ → 衝突 → ポーズ → UI → カメラモード
+	// の順に宣言したタスクを、読み書きするものが重ならない範囲で並列に実行する
+	updateGraph_.Execute();
+}
+
+void GamePlayScene::BuildUpdateGraph(FrameTaskGraph& graph)
+{
+	const auto isInGame = [this]() { return gameSceneState_ == GameSceneState::InGame; };
+
+	// 入力処理（ポーズの切り替え）
+	graph.AddTask("Input", {}, { "Input", "SceneState" }, [this]() { UpdateInput(); });
 
 	// フェードとシーン遷移
-	UpdateFadeAndTransitions();
+	graph.AddTask("Transitions", { "Player" }, { "SceneState", "Fade" }, [this]() { UpdateFadeAndTransitions(); });
 
-	// 状態に応じた更新
-	if (gameSceneState_ == GameSceneState::InGame) {
-		UpdateGame();
-	}
-	else if (gameSceneState_ == GameSceneState::Pause) {
-		UpdatePause();
-	}
+	// ゲームクリア演出・スタート演出
+	graph.AddTask("Staging", {}, { "SceneState", "Player", "Enemies", "Camera" }, [this, isInGame]() {
+		if (isInGame()) {
+			UpdateStaging();
+		}
+		});
+
+	// プレイヤー（カーブに沿ったカメラ移動と弾を含む）
+	graph.AddTask("Player", { "Input", "SceneState" }, { "Player", "Bullets", "Camera", "Particles" }, [this, isInGame]() {
+		if (isInGame()) {
+			UpdatePlayer();
+		}
+		});
+
+	// 敵のAI（倒された敵・弾の片付けを含む）
+	graph.AddTask("Enemies", { "Player", "SceneState", "Camera" }, { "Enemies", "Bullets", "Colliders", "Particles" }, [this, isInGame]() {
+		if (isInGame()) {
+			UpdateEnemies();
+			CleanupDestroyedObjects();
+		}
+		});
+
+	// レベルデータのオブジェクト（自分の定数バッファにしか書かないため、敵の更新と並列にワーカーで実行する）
+	graph.AddTask("LevelObjects", { "SceneState", "Camera" }, { "LevelObjects" }, [this, isInGame]() {
+		if (isInGame()) {
+			UpdateLevelObjects();
+		}
+		}, TaskAffinity::AnyThread);
+
+	// カメラ行列の更新（ゲームクリア演出中は除く）
+	graph.AddTask("Camera", { "SceneState" }, { "Camera" }, [this, isInGame]() {
+		if (isInGame() && !gameClearCameraMoving_) {
+			cameraManager_->Update();
+		}
+		});
+
+	// 衝突判定
+	graph.AddTask("Collision", { "SceneState" }, { "Player", "Enemies", "Bullets", "Colliders", "SceneState" }, [this, isInGame]() {
+		if (isInGame()) {
+			UpdateCollisionSystem();
+		}
+		});
+
+	// ポーズメニュー
+	graph.AddTask("Pause", { "Input" }, { "SceneState", "Fade", "UI" }, [this]() {
+		if (gameSceneState_ == GameSceneState::Pause) {
+			UpdatePause();
+		}
+		});
 
 	// UIの更新
-	UpdateUIObjects();
+	graph.AddTask("UI", { "Player", "Camera" }, { "UI" }, [this]() { UpdateUIObjects(); });
 
-	// カメラの更新
-	UpdateCameraSystem();
-	
+	// カメラモードに応じたカメラの更新
+	graph.AddTask("CameraMode", { "Player" }, { "Camera" }, [this]() { UpdateCameraSystem(); });
 }
 
 void GamePlayScene::Draw()
@@ -284,8 +342,7 @@ void GamePlayScene::Draw()
 
 void GamePlayScene::Finalize()
 {
-	// オーディオの終了処理
-	Audio::GetInstance()->SoundUnload(&soundData1_);
+	// オーディオの終了処理（サウンドデータはシーン切り替え時に AssetLoader が解放する）
 	Audio::GetInstance()->Finalize();
 }
 
@@ -368,6 +425,22 @@ void GamePlayScene::DrawImGui()
 
 	// レベルデータから生成したオブジェクトのImGui調整
 	DrawImGuiImportObjectsFromJson();
+
+	// 視錐台カリングとインスタンシングの結果（直前のフレーム）
+	frustumCuller_.DrawImGui();
+	Object3dRenderQueue::GetInstance()->DrawImGui();
+
+	// 更新処理のタスクグラフ（直前のフレームの計測値）
+	if (ImGui::TreeNode("Update Graph")) {
+		ImGui::Text("Frame %.3f ms / Critical path %.3f ms", updateGraph_.GetLastFrameMilliseconds(), updateGraph_.GetCriticalPathMilliseconds());
+		for (uint32_t i = 0; i < updateGraph_.GetTaskCount(); ++i) {
+			ImGui::Text("%-12s %.3f ms  thread %u", updateGraph_.GetTaskName(i).c_str(), updateGraph_.GetTaskMilliseconds(i), updateGraph_.GetTaskThreadIndex(i));
+		}
+		if (ImGui::Button("Dump")) {
+			updateGraph_.WriteDump(FrameTaskGraphConstants::kDefaultDumpFilePath);
+		}
+		ImGui::TreePop();
+	}
 	ImGui::End();
 	player_->DrawImGui();
 
@@ -385,24 +458,7 @@ void GamePlayScene::CreateObjectsFromLevelData()
 {
 	// レベルデータからオブジェクトを生成、配置
 	for (auto& objectData : levelData_->objects) {
-		if (objectData.disabled) {
-			// 無効なオブジェクトはスキップ
-			continue;
-		}
-		// ファイル名から登録済みモデルを検索
-		Model* model = nullptr;
-		auto it = models_.find(objectData.fileName);
-		if (it != models_.end()) { model = it->second.get(); }
-		// モデルを指定して3Dオブジェクトを生成
-		auto newObject = std::make_unique<Object3d>();
-		newObject->Initialize(objectData.fileName + ".obj");
-		// 平行移動
-		newObject->SetTranslate(objectData.translation);
-		// 回転角
-		newObject->SetRotate(objectData.rotation);
-		// スケーリング
-		newObject->SetScale(objectData.scaling);
-		objects_.push_back(std::move(newObject));
+		CreateLevelObject(objectData, TransformHierarchyConstants::kNoParent);
 	}
 
 	// レベルデータから敵を生成、配置
@@ -413,6 +469,7 @@ void GamePlayScene::CreateObjectsFromLevelData()
 		if (it != models_.end()) { model = it->second.get(); }
 		// 敵オブジェクトの生成
 		auto newEnemy = std::make_unique<Enemy>();
+		newEnemy->SetBulletPool(enemyBulletPool_.get());
 		newEnemy->Initialize();
 		
 		newEnemy->SetPosition(enemyData.translation);
@@ -449,27 +506,48 @@ void GamePlayScene::CreateObjectsFromLevelData()
 	}
 }
 
+void GamePlayScene::CreateLevelObject(const LevelData::ObjectData& objectData, uint32_t parentNode)
+{
+	if (objectData.disabled) {
+		// 無効なオブジェクトはスキップ（子も生成しない）
+		return;
+	}
+	// モデルを指定して3Dオブジェクトを生成
+	auto newObject = std::make_unique<Object3d>();
+	newObject->Initialize(objectData.fileName + ".obj");
+	objects_.push_back(std::move(newObject));
+
+	// 平行移動・回転角・スケーリングは階層で管理し、親が動いたときも含めて変わったものだけ行列を計算し直す
+	const uint32_t node = levelHierarchy_.Add(objectData.scaling, objectData.rotation, objectData.translation, parentNode);
+	levelObjectNodes_.push_back(node);
+
+	// 子オブジェクト
+	for (const auto& child : objectData.children) {
+		CreateLevelObject(child, node);
+	}
+}
+
 void GamePlayScene::DrawImGuiImportObjectsFromJson()
 {
 #ifdef USE_IMGUI
 	// レベルデータから生成したオブジェクトのImGui調整
 	for (size_t i = 0; i < objects_.size(); ++i) {
-		auto& obj = objects_[i];
 		ImGui::PushID(static_cast<int32_t>(i)); // 複数オブジェクト対応
 
-		// 位置・回転・スケールの取得
-		Vector3 pos = obj->GetTranslate();
-		Vector3 rot = obj->GetRotate();
-		Vector3 scale = obj->GetScale();
+		// 位置・回転・スケールの取得（レベルデータのオブジェクトの変換は levelHierarchy_ が持つ）
+		const uint32_t node = levelObjectNodes_[i];
+		Vector3 pos = levelHierarchy_.GetTranslate(node);
+		Vector3 rot = levelHierarchy_.GetRotate(node);
+		Vector3 scale = levelHierarchy_.GetScale(node);
 
 		if (ImGui::SliderFloat3("position", &pos.x, -10.0f, 10.0f)) {
-			obj->SetTranslate(pos);
+			levelHierarchy_.SetTranslate(node, pos);
 		}
 		if (ImGui::SliderFloat3("Rotation", &rot.x, -180.0f, 180.0f)) {
-			obj->SetRotate(rot);
+			levelHierarchy_.SetRotate(node, rot);
 		}
 		if (ImGui::SliderFloat3("Scale", &scale.x, 0.01f, 10.0f)) {
-			obj->SetScale(scale);
+			levelHierarchy_.SetScale(node, scale);
 		}
 
 		ImGui::PopID();
@@ -516,25 +594,16 @@ void GamePlayScene::CheckAllCollisions()
 			collisionManager_->AddCollider(enemy.get());
 
 			// 敵の弾も登録
-			for (const auto& bullet : enemy->GetBullets()) {
-				if (bullet) {
-					collisionManager_->AddCollider(bullet.get());
-				}
+			for (EnemyBullet* bullet : enemy->GetBullets()) {
+				collisionManager_->AddCollider(bullet);
 			}
 		}
 	}
 
-	// プレイヤー弾
-	for (const auto& bullet : *playerBullets_) {
-		if (bullet && bullet->IsAlive()) {
-			collisionManager_->AddCollider(bullet.get());
-		}
-	}
-
-	// チャージ弾
-	for (const auto& chargeBullet : *playerChargeBullets_) {
-		if (chargeBullet && chargeBullet->IsAlive()) {
-			collisionManager_->AddCollider(chargeBullet.get());
+	// プレイヤー弾（チャージ弾を含む）
+	for (PlayerBullet* bullet : *playerBullets_) {
+		if (bullet->IsAlive()) {
+			collisionManager_->AddCollider(bullet);
 		}
 	}
 
@@ -740,24 +809,9 @@ void GamePlayScene::UpdatePlayerFollowCamera()
 
 bool GamePlayScene::IsInCameraView(const Vector3& worldPos)
 {
+	// カメラが毎フレーム作り直している視錐台で、半径 0 の球（点）として判定する
 	Camera* cam = cameraManager_->GetMainCamera();
-	Matrix4x4 viewProj = cam->GetViewProjectionMatrix();
-
-	// ワールド → クリップ
-	Vector4 clip = Multiply(viewProj, Vector4{ worldPos.x, worldPos.y, worldPos.z, 1.0f });
-	if (clip.w == 0.0f) return false;
-
-	// NDCへ変換
-	Vector3 ndc = {
-		clip.x / clip.w,
-		clip.y / clip.w,
-		clip.z / clip.w
-	};
-
-	// NDCが -1～1 の範囲なら画面内
-	return (ndc.x >= -1.0f && ndc.x <= 1.0f &&
-		ndc.y >= -1.0f && ndc.y <= 1.0f &&
-		ndc.z >= 0.0f && ndc.z <= 1.0f);
+	return IsVisible(cam->GetFrustum(), BoundingSphere{ worldPos, 0.0f });
 }
 
 void GamePlayScene::UpdateGameClear()
@@ -876,7 +930,7 @@ void GamePlayScene::UpdateGameClear()
 	}
 }
 
-void GamePlayScene::UpdateGame()
+void GamePlayScene::UpdateStaging()
 {
 	// ゲームクリア時の更新
 	UpdateGameClear();
@@ -889,17 +943,6 @@ void GamePlayScene::UpdateGame()
 		Object3dCommon::GetInstance()->SetDefaultCamera(cameraManager_->GetMainCamera());
 		//return; // 他の更新をスキップ
 	}
-
-	// ゲームオブジェクトの更新
-	UpdateGameObjects();
-
-	// 通常のカメラ更新（ゲームクリア演出中は除く）
-	if (!gameClearCameraMoving_) {
-		cameraManager_->Update();
-	}
-
-	// 衝突判定の更新
-	UpdateCollisionSystem();
 }
 
 void GamePlayScene::UpdatePause()
@@ -992,33 +1035,40 @@ void GamePlayScene::UpdateFadeAndTransitions()
 	fadeManager_->Update();
 }
 
-// ゲームオブジェクトの更新
-void GamePlayScene::UpdateGameObjects()
+// レベルデータから読み込んだオブジェクトの更新
+void GamePlayScene::UpdateLevelObjects()
 {
-	// 読み込んだ全オブジェクトの更新
-	for (auto& obj : objects_) {
-		obj->Update();
+	// 変更のあったノード（とその子孫）だけワールド行列を計算し直す
+	levelHierarchy_.Update();
+
+	// 変わった行列だけ渡す。行列もカメラも変わっていなければ Object3d の Update は GPU に書き込まない
+	for (size_t i = 0; i < objects_.size(); ++i) {
+		const uint32_t node = levelObjectNodes_[i];
+		if (levelHierarchy_.IsWorldChanged(node)) {
+			objects_[i]->SetWorldMatrix(levelHierarchy_.GetWorldMatrix(node));
+		}
+		objects_[i]->Update();
 	}
+}
 
+// プレイヤーの更新
+void GamePlayScene::UpdatePlayer()
+{
 	// ゲームオーバーでない場合のみプレイヤー更新
-	if (!isGameOver_) {
-		player_->Update();
+	if (isGameOver_) {
+		return;
+	}
 
-		// カメラ追従更新
-		if (!isStartCameraEasing_) {
-			UpdatePlayerFollowCamera();
-			RestrictPlayerInsideCameraView();
-		}
+	player_->Update();
 
-		// プレイヤーの弾の奥行き調整
-		UpdatePlayerBullets();
+	// カメラ追従更新
+	if (!isStartCameraEasing_) {
+		UpdatePlayerFollowCamera();
+		RestrictPlayerInsideCameraView();
 	}
 
-	// 敵の更新
-	UpdateEnemies();
-
-	// 不要になったオブジェクトの削除
-	CleanupDestroyedObjects();
+	// プレイヤーの弾の奥行き調整
+	UpdatePlayerBullets();
 }
 
 // プレイヤーの弾の更新
@@ -1096,23 +1146,8 @@ void GamePlayScene::CleanupDestroyedObjects()
 		enemies_.end()
 	);
 
-	// プレイヤー弾
-	playerBullets_->erase(
-		std::remove_if(playerBullets_->begin(), playerBullets_->end(),
-			[](const std::unique_ptr<PlayerBullet>& b) {
-				return !b->IsAlive();
-			}),
-		playerBullets_->end()
-	);
-
-	// チャージ弾
-	playerChargeBullets_->erase(
-		std::remove_if(playerChargeBullets_->begin(), playerChargeBullets_->end(),
-			[](const std::unique_ptr<PlayerChargeBullet>& b) {
-				return !b->IsAlive();
-			}),
-		playerChargeBullets_->end()
-	);
+	// プレイヤー弾（チャージ弾を含む）をプールへ返却
+	player_->ReleaseDeadBullets();
 }
 
 // カメラの更新処理
@@ -1286,8 +1321,14 @@ void GamePlayScene::UpdateCollisionSystem()
 // ゲームオブジェクトの描画
 void GamePlayScene::DrawGameObjects()
 {
+	// コマンドを積む前に画面外のオブジェクトを外す
+	CullGameObjects();
+
 	Object3dCommon::GetInstance()->DrawSettings();
 
+	// ここから Flush までの Object3d の描画は、同じモデルのものをまとめてインスタンシング描画する（同じモデルの中は手前から）
+	Object3dRenderQueue::GetInstance()->Begin(cameraManager_->GetMainCamera());
+
 	// レベルデータから読み込んだオブジェクト
 	for (auto& obj : objects_) {
 		obj->Draw();
@@ -1306,6 +1347,29 @@ void GamePlayScene::DrawGameObjects()
 	}
 
 	skydome_->Draw();
+
+	Object3dRenderQueue::GetInstance()->Flush();
+}
+
+// 描画するオブジェクトの視錐台カリング
+void GamePlayScene::CullGameObjects()
+{
+	// スカイドームは常にカメラを囲むので対象にしない
+	frustumCuller_.Begin();
+	for (auto& obj : objects_) {
+		frustumCuller_.Add(obj.get());
+	}
+	frustumCuller_.Add(player_->GetObject3d());
+	for (PlayerBullet* bullet : player_->GetBullets()) {
+		frustumCuller_.Add(bullet->GetObject3d());
+	}
+	for (auto& enemy : enemies_) {
+		frustumCuller_.Add(enemy->GetObject3d());
+		for (EnemyBullet* bullet : enemy->GetBullets()) {
+			frustumCuller_.Add(bullet->GetObject3d());
+		}
+	}
+	frustumCuller_.Execute(*cameraManager_->GetMainCamera());
 }
 
 // UIの描画
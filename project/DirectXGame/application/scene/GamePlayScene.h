@@ -22,6 +22,10 @@
 #include <GrayscalePostEffect.h>
 #include <PostEffectManager.h>
 #include <Camera.h>
+#include <FrameTaskGraph.h>
+#include <TransformHierarchy.h>
+#include <FrustumCuller.h>
+#include <Object3dRenderQueue.h>
 
 /// 調整用定数（マジックナンバー排除）
 namespace GamePlayDefaults {
@@ -90,9 +94,15 @@ public:
 	// ImGui描画
 	void DrawImGui() override;
 
+	// 更新処理のタスクグラフを組み立てる（Initialize 前でも呼べる。起動引数でのグラフの書き出しにも使う）
+	void BuildUpdateGraph(MyEngine::FrameTaskGraph& graph);
+
 	// ローダーから読み込んだレベルデータからオブジェクトを生成、配置する関数
 	void CreateObjectsFromLevelData();
 
+	// レベルデータのオブジェクトを 1 つ生成する（子オブジェクトも parentNode の子として再帰的に生成する）
+	void CreateLevelObject(const LevelData::ObjectData& objectData, uint32_t parentNode);
+
 	// JSONから読み込んだオブジェクトのImGui調整
 	void DrawImGuiImportObjectsFromJson();
 
@@ -148,14 +158,17 @@ private:
 	// プレイヤーがカメラに追従する
 	void UpdatePlayerFollowCamera();
 
+	// 更新処理のタスクグラフ
+	MyEngine::FrameTaskGraph updateGraph_;
+
 	// カメラの中に入っているか
 	bool IsInCameraView(const Vector3& worldPos);
 
 	// ゲームクリアの演出更新
 	void UpdateGameClear();
 
-	// InGameの更新処理
-	void UpdateGame();
+	// ゲームクリア演出・スタート演出の更新
+	void UpdateStaging();
 
 	// ポーズ画面の更新処理
 	void UpdatePause();
@@ -187,20 +200,17 @@ private:
 	// スプライトの座標
 	Vector2 spritePosition_ = GamePlayDefaults::kSpritePos;
 
-	// オーディオ
-	SoundData soundData1_;
+	// オーディオ（Audio のキャッシュが所有。マニフェストで先読みされる）
+	const SoundData* soundData1_ = nullptr;
 
 	// プレイヤー
 	std::unique_ptr<Player> player_ = nullptr;
 
-	// プレイヤーの弾
-	std::list<std::unique_ptr<PlayerBullet>>* playerBullets_;
-
-	// プレイヤーのチャージ弾
-	std::list<std::unique_ptr<PlayerChargeBullet>>* playerChargeBullets_;
+	// プレイヤーの弾（通常弾・チャージ弾）
+	const std::vector<PlayerBullet*>* playerBullets_ = nullptr;
 
-	// 敵の弾
-	std::list<std::unique_ptr<EnemyBullet>>* enemyBullets_;
+	// 敵の弾プール（敵より先に宣言し、敵の破棄後に解放する）
+	std::unique_ptr<EnemyBulletPool> enemyBulletPool_;
 
 	// 敵
 	std::unique_ptr<Enemy> enemy_ = nullptr;
@@ -214,6 +224,13 @@ private:
 	// 複数のオブジェクトを管理するためのコンテナ
 	std::vector<std::unique_ptr<Object3d>> objects_;
 
+	// レベルデータのオブジェクトの変換（objects_ と同じ順に levelObjectNodes_ のノードを持つ）
+	MyEngine::TransformHierarchy levelHierarchy_;
+	std::vector<uint32_t> levelObjectNodes_;
+
+	// 視錐台カリング（描画の直前にレベルオブジェクト・キャラクター・弾をまとめて判定する）
+	MyEngine::FrustumCuller frustumCuller_;
+
 	// スカイボックス
 	std::unique_ptr<Skybox> skybox_ = nullptr;
 
@@ -403,7 +420,8 @@ private:
 	// 更新系
 	void UpdateInput();
 	void UpdateFadeAndTransitions();
-	void UpdateGameObjects();
+	void UpdatePlayer();
+	void UpdateLevelObjects();
 	void UpdatePlayerBullets();
 	void UpdateEnemies();
 	void UpdateEnemyBehavior(Enemy* enemy);
@@ -415,6 +433,9 @@ private:
 
 	// 描画系
 	void DrawGameObjects();
+
+	// 描画するオブジェクトの視錐台カリング
+	void CullGameObjects();
 	void DrawUI();
 	void DrawSkybox();
 	void DrawFade();
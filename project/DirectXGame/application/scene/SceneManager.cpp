@@ -1,6 +1,8 @@
 #include "SceneManager.h"
 #include "DirectXCommon.h"
 #include <imgui.h>
+#include <AssetLoader.h>
+#include <AllocationCounter.h>
 
 SceneManager::~SceneManager()
 {
@@ -15,45 +17,30 @@ void SceneManager::Initialize(WinApp* winApp)
 	directXCommon_ = DirectXCommon::GetInstance();
 	winApp_ = winApp;
 
-	// 初期シーンを設定
-	nowScene_ = std::make_unique<TitleScene>();
-	nowScene_->Initialize(directXCommon_, winApp_);
+	// シーン内のオブジェクト（弾・敵など）のヒープ確保を Scene として数える（各サブシステム内ではそのタグが優先される）
+	MemoryTagScope memoryTag(MemoryTag::Scene);
 
 	// シーンの初期設定（定数化）
 	currentSceneNo_ = SceneDefaults::kInitialSceneNo;
 	prevSceneNo_ = SceneDefaults::kNoPrevSceneNo;
+
+	// 初期シーンのアセットを読み込んでから初期シーンを設定
+	AssetLoader::GetInstance()->EnterScene(GetManifestName(currentSceneNo_));
+	nowScene_ = CreateScene(currentSceneNo_);
+	nowScene_->Initialize(directXCommon_, winApp_);
 }
 
 void SceneManager::Update()
 {
+	MemoryTagScope memoryTag(MemoryTag::Scene);
+
 	// シーン遷移のチェック
 	if (nowScene_) {
 		// 次のシーンが要求されているかチェック
 		std::optional<int32_t> nextScene = nowScene_->GetNextScene();
 		
 		if (nextScene.has_value()) {
-			// シーン番号を更新
-			prevSceneNo_ = currentSceneNo_;
-			currentSceneNo_ = nextScene.value();
-			
-			//---------------------------------------
-			// 旧シーンの終了処理
-			nowScene_->Finalize();
-			
-			//---------------------------------------
-			// 新シーンの生成と初期化
-			if (currentSceneNo_ == GAMEPLAY) {
-				nowScene_ = std::make_unique<GamePlayScene>();
-			} else if (currentSceneNo_ == TITLE) {
-				nowScene_ = std::make_unique<TitleScene>();
-			} else if (currentSceneNo_ == GAMEOVER) {
-				nowScene_ = std::make_unique<GameOverScene>();
-			}
-			
-			// 新シーンの初期化
-			if (nowScene_) {
-				nowScene_->Initialize(directXCommon_, winApp_);
-			}
+			ChangeScene(nextScene.value());
 		}
 	}
 
@@ -97,32 +84,59 @@ void SceneManager::DrawImGui()
 	// デバッグ用のシーン強制切り替え処理
 	auto& nextScene = debugNextScene;
 	if (nextScene.has_value() && currentSceneNo_ != nextScene.value()) {
-		// 旧シーンの終了処理
-		if (nowScene_) {
-			nowScene_->Finalize();
-		}
+		ChangeScene(nextScene.value());
+	}
+#endif
+	if (nowScene_) {
+		nowScene_->DrawImGui();
+	}
+}
 
-		prevSceneNo_ = currentSceneNo_;
-		currentSceneNo_ = nextScene.value();
+void SceneManager::ChangeScene(int32_t nextSceneNo)
+{
+	MemoryTagScope memoryTag(MemoryTag::Scene);
 
-		// 新シーンの生成
-		if (currentSceneNo_ == GAMEPLAY) {
-			nowScene_ = std::make_unique<GamePlayScene>();
-		}
-		else if (currentSceneNo_ == TITLE) {
-			nowScene_ = std::make_unique<TitleScene>();
-		}
-		else if (currentSceneNo_ == GAMEOVER) {
-			nowScene_ = std::make_unique<GameOverScene>();
-		}
+	// シーン番号を更新
+	prevSceneNo_ = currentSceneNo_;
+	currentSceneNo_ = nextSceneNo;
 
-		// 新シーンの初期化
-		if (nowScene_) {
-			nowScene_->Initialize(directXCommon_, winApp_);
-		}
+	//---------------------------------------
+	// 旧シーンの終了処理と破棄（旧シーンのオブジェクトが解放対象のアセットを参照しないように先に破棄する）
+	if (nowScene_) {
+		nowScene_->Finalize();
+		nowScene_.reset();
 	}
-#endif
+
+	//---------------------------------------
+	// 旧シーン専用のアセットを解放し、新シーンのアセットを並列に読み込む
+	AssetLoader::GetInstance()->EnterScene(GetManifestName(currentSceneNo_));
+
+	//---------------------------------------
+	// 新シーンの生成と初期化
+	nowScene_ = CreateScene(currentSceneNo_);
 	if (nowScene_) {
-		nowScene_->DrawImGui();
+		nowScene_->Initialize(directXCommon_, winApp_);
+	}
+}
+
+std::unique_ptr<BaseScene> SceneManager::CreateScene(int32_t sceneNo)
+{
+	if (sceneNo == GAMEPLAY) {
+		return std::make_unique<GamePlayScene>();
+	} else if (sceneNo == TITLE) {
+		return std::make_unique<TitleScene>();
+	} else if (sceneNo == GAMEOVER) {
+		return std::make_unique<GameOverScene>();
+	}
+	return nullptr;
+}
+
+const char* SceneManager::GetManifestName(int32_t sceneNo)
+{
+	if (sceneNo == GAMEPLAY) {
+		return SceneDefaults::kGamePlayManifestName;
+	} else if (sceneNo == GAMEOVER) {
+		return SceneDefaults::kGameOverManifestName;
 	}
+	return SceneDefaults::kTitleManifestName;
 }
@@ -15,6 +15,11 @@ namespace SceneDefaults {
 	inline constexpr int32_t kInitialSceneNo = TITLE;
 	// 未設定の過去シーン番号
 	inline constexpr int32_t kNoPrevSceneNo  = -1;
+
+	// シーンごとのアセットマニフェスト名（resources/manifests/名前.json）
+	inline constexpr const char* kTitleManifestName    = "title";
+	inline constexpr const char* kGamePlayManifestName = "gameplay";
+	inline constexpr const char* kGameOverManifestName = "gameover";
 }
 
 class SceneManager
@@ -36,6 +41,15 @@ public:
 	void DrawImGui();
 	
 private:
+	// シーン切り替え（旧シーン破棄 → アセット入れ替え → 新シーン初期化）
+	void ChangeScene(int32_t nextSceneNo);
+
+	// シーン番号からシーンを生成
+	static std::unique_ptr<BaseScene> CreateScene(int32_t sceneNo);
+
+	// シーン番号からマニフェスト名を取得
+	static const char* GetManifestName(int32_t sceneNo);
+
 	// 現在のシーン
 	std::unique_ptr<BaseScene> nowScene_ = nullptr;
 
@@ -3,6 +3,7 @@
 #include <Object3dCommon.h>
 #include <Lerp.h>
 #include <ParticleManager.h>
+#include <AssetLoader.h>
 
 void TitleScene::Initialize(DirectXCommon* directXCommon, WinApp* winApp)
 {
@@ -19,7 +20,7 @@ void TitleScene::Initialize(DirectXCommon* directXCommon, WinApp* winApp)
 
 	// オーディオの初期化
 	Audio::GetInstance()->Initialize();
-	soundData1_ = Audio::GetInstance()->SoundLoadWave("resources/Alarm01.wav");
+	soundData1_ = Audio::GetInstance()->LoadSound("resources/Alarm01.wav");
 	
 	// プレイヤーの初期化
 	player_ = std::make_unique<Object3d>();
@@ -34,6 +35,13 @@ void TitleScene::Initialize(DirectXCommon* directXCommon, WinApp* winApp)
 	sprite_ = std::make_unique<Sprite>();
 	sprite_->Initialize(directXCommon, "resources/StageClear.png");
 
+	// 読み込みゲージの初期化
+	loadingGaugeSprite_ = std::make_unique<Sprite>();
+	loadingGaugeSprite_->Initialize(directXCommon, "resources/white.png");
+	loadingGaugeSprite_->SetPosition(TitleDefaults::kLoadingGaugePos);
+	loadingGaugeSprite_->SetSize(TitleDefaults::kLoadingGaugeSize);
+	loadingGaugeSprite_->SetColor(TitleDefaults::kLoadingGaugeColor);
+
 	// ワールド変換の初期化
 	titleLogoTransform_.Initialize();
 	titleLogoTransform_.SetRotate(TitleDefaults::kTitleLogoRot);
@@ -200,7 +208,9 @@ void TitleScene::Update()
 		break;
 
 		case TitleStartState::FadeOut:
-			if (fadeManager_->GetFadeState() == FadeManager::EffectState::Finish)
+			// ゲームプレイ用アセットの非同期読み込みが終わるまで遷移しない
+			if (fadeManager_->GetFadeState() == FadeManager::EffectState::Finish &&
+				AssetLoader::GetInstance()->IsIdle())
 			{
 				RequestSceneChange(GAMEPLAY);
 			}
@@ -227,6 +237,8 @@ void TitleScene::Update()
 	dock_->Update();
 	sprite_->SetPosition(spritePosition_);
 	sprite_->Update();
+	loadingGaugeSprite_->SetVisibleRate(AssetLoader::GetInstance()->GetProgress());
+	loadingGaugeSprite_->Update();
 
 	fadeManager_->Update();
 	cameraManager_->Update();
@@ -259,6 +271,11 @@ void TitleScene::Draw()
 	/*------スプライトの更新------*/
 	SpriteCommon::GetInstance()->DrawSettings();
 	//sprite_->Draw();
+
+	// 非同期読み込み中のみゲージを表示
+	if (!AssetLoader::GetInstance()->IsIdle()) {
+		loadingGaugeSprite_->Draw();
+	}
 	
 	// フェードマネージャの描画
 	fadeManager_->Draw();
@@ -266,8 +283,7 @@ void TitleScene::Draw()
 
 void TitleScene::Finalize()
 {
-	// サウンドデータ解放
-	Audio::GetInstance()->SoundUnload(&soundData1_);
+	// サウンドデータはシーン切り替え時に AssetLoader が解放する
 	Audio::GetInstance()->Finalize();
 }
 
@@ -278,6 +294,8 @@ void TitleScene::DrawImGui()
 	ImGui::Begin("TitleScene");
 	// ステート
 	ImGui::Text("State: %d", static_cast<int>(startState_));
+	// 非同期読み込みの進捗
+	ImGui::Text("Loading: %u / %u", AssetLoader::GetInstance()->GetCompletedCount(), AssetLoader::GetInstance()->GetRequestedCount());
 	
 	// プレイヤーの位置
 	Vector3 playerPos = playerTransform_.GetTranslate();
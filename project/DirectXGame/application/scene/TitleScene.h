@@ -41,6 +41,11 @@ namespace TitleDefaults {
 	inline constexpr float kCameraRadius   = 5.0f;   // プレイヤーからの距離
 	inline constexpr float kCameraHeight   = 2.0f;   // カメラの高さ
 	inline constexpr float kPiOver2        = 3.14159f / 2.0f;
+
+	// 読み込みゲージ
+	inline constexpr Vector2 kLoadingGaugePos{ 440.0f, 680.0f };
+	inline constexpr Vector2 kLoadingGaugeSize{ 400.0f, 8.0f };
+	inline constexpr Vector4 kLoadingGaugeColor{ 1.0f, 1.0f, 1.0f, 0.8f };
 }
 
 /// <summary>
@@ -98,8 +103,8 @@ private:
 	// 入力の初期化
 	std::unique_ptr<Input> input_ = nullptr;
 
-	// オーディオ
-	SoundData soundData1_;
+	// オーディオ（Audio のキャッシュが所有。マニフェストで先読みされる）
+	const SoundData* soundData1_ = nullptr;
 
 	// プレイヤー
 	std::unique_ptr<Object3d> player_ = nullptr;
@@ -155,5 +160,8 @@ private:
 	Vector2 spritePosition_ = { 0.0f, 0.0f };
 
 	std::unique_ptr<ParticleEmitter> thrusterEmitter_;
+
+	// 読み込みゲージ（ゲームプレイ用アセットの非同期読み込み進捗）
+	std::unique_ptr<Sprite> loadingGaugeSprite_;
 };
 
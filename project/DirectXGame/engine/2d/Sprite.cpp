@@ -39,11 +39,20 @@ namespace MyEngine {
 		constexpr float kSpriteScaleZ = 1.0f;
 	}
 
+	Sprite::~Sprite()
+	{
+		TextureManager::GetInstance()->ReleaseTexture(textureHandle_);
+	}
+
 	void Sprite::Initialize(DirectXCommon* dxCommon, std::string textureFilePath)
 	{
 		dxCommon_ = dxCommon;
 		filePath_ = textureFilePath;
 
+		// テクスチャのハンドルを取得（未読み込みならここで読み込む）。参照はデストラクタで手放す
+		TextureManager::GetInstance()->ReleaseTexture(textureHandle_);
+		textureHandle_ = TextureManager::GetInstance()->LoadTexture(filePath_);
+
 		// 頂点データの作成
 		CreateVertexData();
 
@@ -68,7 +77,7 @@ namespace MyEngine {
 		float visibleRight = left + (right - left) * visibleRate_;
 
 		// テクスチャメタデータの取得
-		const DirectX::TexMetadata& metadata = TextureManager::GetInstance()->GetMetaData(filePath_);
+		const DirectX::TexMetadata& metadata = TextureManager::GetInstance()->GetMetaData(textureHandle_);
 
 		// テクスチャ座標の正規化
 		float tex_left = textureLeftTop_.x / static_cast<float>(metadata.width);
@@ -151,7 +160,7 @@ namespace MyEngine {
 		dxCommon_->GetCommandList()->SetGraphicsRootConstantBufferView(1, wvpResource_->GetGPUVirtualAddress());
 
 		// テクスチャDescriptorTableを設定（RootParameter配列の2番目）
-		dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(filePath_));
+		dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(textureHandle_));
 
 		// 描画コマンド（インデックス付き描画）
 		dxCommon_->GetCommandList()->DrawIndexedInstanced(SpriteDefaults::kIndexCount, 1, 0, 0, 0);
@@ -216,7 +225,7 @@ namespace MyEngine {
 	void Sprite::AdjustTextureSize()
 	{
 		// テクスチャメタデータを取得
-		const DirectX::TexMetadata& metadata = TextureManager::GetInstance()->GetMetaData(filePath_);
+		const DirectX::TexMetadata& metadata = TextureManager::GetInstance()->GetMetaData(textureHandle_);
 
 		// テクスチャサイズを設定
 		textureSize_.x = static_cast<float>(metadata.width);
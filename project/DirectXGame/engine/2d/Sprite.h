@@ -75,6 +75,9 @@ namespace MyEngine{
 	public:
 		/*------メンバ関数------*/
 
+		// デストラクタ（テクスチャの参照を手放す）
+		~Sprite();
+
 		// 初期化
 		void Initialize(DirectXCommon* dxCommon, std::string textureFilePath);
 
@@ -215,6 +218,9 @@ namespace MyEngine{
 		// テクスチャファイルパス
 		std::string filePath_;
 
+		// テクスチャハンドル（毎フレームの更新・描画ではこちらで引く）
+		TextureHandle textureHandle_;
+
 		// 表示割合（0.0f～1.0f）
 		float visibleRate_ = 1.0f;
 	};
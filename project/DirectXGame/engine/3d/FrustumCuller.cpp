@@ -0,0 +1,56 @@
+#include "FrustumCuller.h"
+#include "Object3d.h"
+#include "Camera.h"
+#include <Frustum.h>
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif
+
+//
+// FrustumCuller
+// - 描画の直前（コマンドを積む前）に、登録された Object3d の境界球をカメラの視錐台でまとめて判定する。
+// - 境界球は構造体の配列ではなく BoundingSphere の連続した配列に集めてから Math::CullSpheres に渡す（SIMD で 4 つずつ判定）。
+// - 判定結果は Object3d::SetCulled で各オブジェクトに持たせる。呼び出し側の描画順はそのままで、Draw が画面外のものを飛ばす。
+// - 配列はメンバに持って毎フレーム clear するだけなので、数が落ち着けば確保は起きない。
+//
+namespace MyEngine {
+	void FrustumCuller::Begin()
+	{
+		objects_.clear();
+		spheres_.clear();
+		visibleObjects_.clear();
+	}
+
+	void FrustumCuller::Add(Object3d* object)
+	{
+		if (!object) {
+			return;
+		}
+		objects_.push_back(object);
+		spheres_.push_back(object->GetWorldBoundingSphere());
+	}
+
+	void FrustumCuller::Execute(const Camera& camera)
+	{
+		visibleIndices_.resize(spheres_.size());
+		const size_t visibleCount = Math::CullSpheres(camera.GetFrustum(), spheres_.data(), spheres_.size(), visibleIndices_.data());
+
+		// いったん全てをカリング済みにし、見えるものだけ戻す
+		for (Object3d* object : objects_) {
+			object->SetCulled(true);
+		}
+		visibleObjects_.reserve(visibleCount);
+		for (size_t i = 0; i < visibleCount; i++) {
+			Object3d* object = objects_[visibleIndices_[i]];
+			object->SetCulled(false);
+			visibleObjects_.push_back(object);
+		}
+	}
+
+	void FrustumCuller::DrawImGui() const
+	{
+#ifdef USE_IMGUI
+		ImGui::Text("Frustum Culling  visible: %zu  culled: %zu", GetVisibleCount(), GetCulledCount());
+#endif
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <BoundingSphere.h>
+#include <cstdint>
+#include <vector>
+
+namespace MyEngine {
+	// 前方宣言
+	class Object3d;
+	class Camera;
+
+	/// <summary>
+	/// 視錐台カリング（描画コマンドを積む前に画面外の Object3d を外す）
+	/// </summary>
+	class FrustumCuller
+	{
+	public:
+		/*------メンバ関数------*/
+
+		// フレームの開始（登録を空にする。配列の容量は使い回す）
+		void Begin();
+
+		// カリング対象の登録（Update 後のワールド行列から境界球を求める）
+		void Add(Object3d* object);
+
+		// カメラの視錐台でまとめて判定し、各 Object3d にカリング結果を設定する
+		void Execute(const Camera& camera);
+
+		// ImGui でカリング結果を表示する
+		void DrawImGui() const;
+
+		/*------ゲッター------*/
+
+		// 見えると判定されたオブジェクト（Execute 後に有効）
+		const std::vector<Object3d*>& GetVisibleObjects() const { return visibleObjects_; }
+		size_t GetVisibleCount() const { return visibleObjects_.size(); }
+		size_t GetCulledCount() const { return objects_.size() - visibleObjects_.size(); }
+
+	private:
+		/*------メンバ変数------*/
+
+		// 登録されたオブジェクトと、対応するワールド座標の境界球
+		std::vector<Object3d*> objects_;
+		std::vector<BoundingSphere> spheres_;
+
+		// 見える球の番号（CullSpheres の書き込み先）
+		std::vector<uint32_t> visibleIndices_;
+
+		// 見えるオブジェクト
+		std::vector<Object3d*> visibleObjects_;
+	};
+}
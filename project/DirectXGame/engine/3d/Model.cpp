@@ -2,38 +2,49 @@
 #include "MakeIdentity4x4.h"
 #include "TextureManager.h"
 #include "ResourceManager.h"
+#include "ObjLoader.h"
 
 //
 // Model.cpp
-// - OBJ/MTL ファイルを読み込み、頂点・法線・UV をパースして ModelData を構築する。
+// - OBJ/MTL ファイルのパースは ObjLoader で行い、ここでは結果の ModelData から GPU リソースを作る。
 // - GPU 用 Upload ヒープに頂点バッファとマテリアル用定数バッファを作成・初期化する。
 // - 描画時はマテリアル CBV とテクスチャ SRV をルートにセットして DrawInstanced を発行する
 //
 // 注意点 / 前提
-// - 現在の実装は面 (f) を三角形のみサポート（ngons は非対応）
-// - OBJ 内のインデックスは「位置/UV/法線」の形式であることを前提としている
-// - DirectX の座標系変換（右手系→左手系）や UV 縦反転を行い、エンジン側の期待する形式に合わせている
 // - 外部で DirectX, TextureManager の初期化が済んでいること
 //
 namespace MyEngine {
 
+	Model::~Model()
+	{
+		// 参照が 0 になったテクスチャは TextureManager がメモリ予算に応じて解放する
+		TextureManager::GetInstance()->ReleaseTexture(textureHandle_);
+	}
+
 	void Model::Initialize(ModelCommon* modelCommon, const std::string& directorypath, const std::string& filename)
+	{
+		// .obj をパースして ModelData を構築する（頂点配列・MaterialData 等を取得）
+		// -> ObjLoader::LoadObjFile は v/vt/vn/f/mtllib を処理し、ModelData を返す
+		Initialize(modelCommon, ObjLoader::LoadObjFile(directorypath, filename));
+	}
+
+	/// パース済みデータからの初期化
+	/// - OBJ のパースはワーカースレッドで済ませ、GPU リソース作成だけをメインスレッドで行う場合に使う
+	void Model::Initialize(ModelCommon* modelCommon, ModelData modelData)
 	{
 		// ModelCommon の参照を保存（描画時に DX コマンドリスト等を取得するため）
 		modelCommon_ = modelCommon;
-
-		// .obj をパースして ModelData を構築する（頂点配列・MaterialData 等を取得）
-		// -> LoadObjFile は v/vt/vn/f/mtllib を処理し、ModelData を返す
-		modelData_ = LoadObjFile(directorypath, filename);
+		modelData_ = std::move(modelData);
 
 		// GPU 用バッファ類を作成して初期化
 		CreateVertexData();
 		CreateMaterialData();
 
-		// OBJ が参照するテクスチャを TextureManager に登録しておく
-		TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
+		// OBJ が参照するテクスチャを TextureManager に登録し、ハンドル（参照）を保持しておく
+		TextureManager::GetInstance()->ReleaseTexture(textureHandle_);
+		textureHandle_ = TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
 		// 登録済みテクスチャのインデックスを ModelData に保存（参照情報として保持）
-		modelData_.material.textureIndex = TextureManager::GetInstance()->GetTextureIndexByFilePath(modelData_.material.textureFilePath);
+		modelData_.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(textureHandle_);
 	}
 
 	/// 描画
@@ -47,92 +58,13 @@ namespace MyEngine {
 		// マテリアル用定数バッファ（CBV）をルートに設定（RootParameter の b0 を想定）
 		modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
 
-		// テクスチャ SRV をルートのデスクリプタテーブルに設定（テクスチャはファイルパスで管理）
-		modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(modelData_.material.textureFilePath));
+		// テクスチャ SRV をルートのデスクリプタテーブルに設定（初期化時に取得したハンドルで O(1) に引く）
+		modelCommon_->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(textureHandle_));
 
 		// DrawInstanced: 頂点数分を描画、インスタンス数は1
 		modelCommon_->GetDxCommon()->GetCommandList()->DrawInstanced(UINT(modelData_.vertices.size()), 1, 0, 0);
 	}
 
-	/// MTL ファイルを読み込み MaterialData を構築する
-	/// - 対応: map_Kd を読み取りテクスチャファイルパスを materialData に格納する
-	/// - directoryPath/filename の組でファイルを開き、1行ずつ解析する
-	MaterialData Model::LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename)
-	{
-		MaterialData materialData;
-		std::string line;
-
-		std::ifstream file(directoryPath + "/" + filename);
-		assert(file.is_open());
-
-		while (std::getline(file, line)) {
-			std::string identifier;
-			std::istringstream s(line);
-			s >> identifier;
-
-			// map_Kd が見つかったらテクスチャ名を読み取り、ディレクトリと連結してフルパス化する
-			if (identifier == kMtlIdentifierTexture) {
-				std::string textureFilename;
-				s >> textureFilename;
-				materialData.textureFilePath = directoryPath + "/" + textureFilename;
-			}
-		}
-		return materialData;
-	}
-
-	/// OBJ ファイルをパースして ModelData を構築する
-	/// - サポートする識別子: v, vt, vn, f, mtllib
-	/// - 面 (f) の各頂点は "posIndex/uvIndex/normalIndex" の形式を想定
-	/// - 各要素は1オフセット（OBJ の 1 始まり）なので内部で -1 して参照する
-	ModelData Model::LoadObjFile(const std::string& directoryPath, const std::string& filename)
-	{
-		ModelData modelData;
-
-		// 一時的に読み込む要素配列（OBJ 内の生データ）
-		std::vector<Vector4> positions; // v: 位置（w を 1 に設定）
-		std::vector<Vector3> normals;   // vn: 法線
-		std::vector<Vector2> texcoords; // vt: テクスチャ座標
-
-		std::string line;
-		std::ifstream file(directoryPath + "/" + filename);
-		assert(file.is_open());
-
-		// ファイルを1行ずつ処理
-		while (std::getline(file, line)) {
-			std::string identifier;
-			std::istringstream s(line);
-			s >> identifier;
-
-			// 頂点位置: "v x y z"
-			if (identifier == kObjIdentifierVertex) {
-				Vector4 position = ParseVertexPosition(s);
-				positions.push_back(position);
-			}
-			// テクスチャ座標: "vt u v"
-			else if (identifier == kObjIdentifierTexCoord) {
-				Vector2 texcoord = ParseTexCoord(s);
-				texcoords.push_back(texcoord);
-			}
-			// 法線: "vn x y z"
-			else if (identifier == kObjIdentifierNormal) {
-				Vector3 normal = ParseNormal(s);
-				normals.push_back(normal);
-			}
-			// 面: "f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3"
-			else if (identifier == kObjIdentifierFace) {
-				ParseFace(s, positions, texcoords, normals, modelData);
-			}
-			// マテリアルライブラリ参照: "mtllib filename.mtl"
-			else if (identifier == kObjIdentifierMaterialLib) {
-				std::string materialFilename;
-				s >> materialFilename;
-				modelData.material = LoadMaterialTemplateFile(directoryPath, materialFilename);
-			}
-		}
-
-		return modelData;
-	}
-
 	/// 頂点バッファを作成して CPU 側の頂点配列を GPU にコピーする
 	/// - modelData_.vertices に格納された頂点群を Upload ヒープ上に確保したバッファへ memcpy する
 	void Model::CreateVertexData()
@@ -169,76 +101,4 @@ namespace MyEngine {
 		materialData_->enableLighting = kDefaultLightingEnabled;
 		materialData_->uvTransform = MakeIdentity4x4();
 	}
-
-	// ===== ヘルパー関数 =====
-
-	Vector4 Model::ParseVertexPosition(std::istringstream& stream)
-	{
-		Vector4 position;
-		stream >> position.x >> position.y >> position.z;
-		// 右手系 OBJ を左手系レンダラーに合わせるため X 軸を反転
-		position.x *= kCoordinateFlipScale;
-		position.w = kDefaultPositionW;
-		return position;
-	}
-
-	Vector2 Model::ParseTexCoord(std::istringstream& stream)
-	{
-		Vector2 texcoord;
-		stream >> texcoord.x >> texcoord.y;
-		// OBJ の V は上方向が +、DirectX は下方向が + なので反転
-		texcoord.y = 1.0f - texcoord.y;
-		return texcoord;
-	}
-
-	Vector3 Model::ParseNormal(std::istringstream& stream)
-	{
-		Vector3 normal;
-		stream >> normal.x >> normal.y >> normal.z;
-		// 法線の X も位置同様反転して座標系を合わせる
-		normal.x *= kCoordinateFlipScale;
-		return normal;
-	}
-
-	void Model::ParseFace(
-		std::istringstream& stream,
-		const std::vector<Vector4>& positions,
-		const std::vector<Vector2>& texcoords,
-		const std::vector<Vector3>& normals,
-		ModelData& modelData)
-	{
-		// 本実装は三角形のみ対応
-		VertexData triangle[kFaceVertexCount];
-
-		for (int32_t faceVertex = 0; faceVertex < kFaceVertexCount; ++faceVertex) {
-			std::string vertexDefinition;
-			stream >> vertexDefinition;
-
-			// "pos/tex/normal" を '/' で分割してインデックスを取得
-			uint32_t elementIndices[kFaceElementCount];
-			ParseVertexIndices(vertexDefinition, elementIndices);
-
-			// インデックスから実データを取得
-			Vector4 position = positions[elementIndices[0] - kObjIndexOffset];
-			Vector2 texcoord = texcoords[elementIndices[1] - kObjIndexOffset];
-			Vector3 normal = normals[elementIndices[2] - kObjIndexOffset];
-			triangle[faceVertex] = { position, texcoord, normal };
-		}
-
-		// 頂点の登録順を逆にして回り順を調整
-		modelData.vertices.push_back(triangle[2]);
-		modelData.vertices.push_back(triangle[1]);
-		modelData.vertices.push_back(triangle[0]);
-	}
-
-	void Model::ParseVertexIndices(const std::string& vertexDefinition, uint32_t* outIndices)
-	{
-		std::istringstream v(vertexDefinition);
-
-		for (int32_t element = 0; element < kFaceElementCount; ++element) {
-			std::string index;
-			std::getline(v, index, kFaceDelimiter);
-			outIndices[element] = std::stoi(index);
-		}
-	}
 }// namespace MyEngine
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "ModelManager.h"
+#include "AllocationCounter.h"
+#include "ObjLoader.h"
 
 namespace MyEngine
 {
@@ -42,6 +44,9 @@ namespace MyEngine
 			return;
 		}
 
+		// 頂点データなどのヒープ確保を Model として数える
+		MemoryTagScope memoryTag(MemoryTag::Model);
+
 		// Model を生成して初期化
 		std::unique_ptr<Model> model = CreateAndInitializeModel(filePath);
 
@@ -49,6 +54,29 @@ namespace MyEngine
 		RegisterModel(filePath, std::move(model));
 	}
 
+	// パース済みデータからモデルを登録
+	// - AssetLoader がワーカースレッドで DecodeModel した結果をメインスレッドで受け取る想定
+	// - 同期読み込みと重なった場合は先に登録された方を使う
+	void ModelManager::LoadModelFromData(const std::string& filePath, ModelData modelData)
+	{
+		if (IsModelLoaded(filePath)) {
+			return;
+		}
+
+		MemoryTagScope memoryTag(MemoryTag::Model);
+		std::unique_ptr<Model> model = std::make_unique<Model>();
+		model->Initialize(modelCommon_.get(), std::move(modelData));
+		RegisterModel(filePath, std::move(model));
+	}
+
+	// OBJ のパース
+	// - ファイル読み込みと頂点配列の構築のみで D3D には触れない
+	ModelData ModelManager::DecodeModel(const std::string& filePath)
+	{
+		MemoryTagScope memoryTag(MemoryTag::Model);
+		return ObjLoader::LoadObjFile(kDefaultResourceDirectory, filePath);
+	}
+
 	// 読み込み済みモデルを取得
 	// - filePath に一致するモデルが登録されていればポインタを返す。
 	// - 見つからなければ nullptr を返す（呼び出し側で nullptr チェックが必要）。
@@ -61,6 +89,14 @@ namespace MyEngine
 		return nullptr;
 	}
 
+	// モデルの解放
+	// - AssetLoader がシーン切り替え時に、次のシーンで使わないモデルを解放する
+	// - 参照テクスチャは TextureManager 側で別に管理しているためここでは解放しない
+	void ModelManager::UnloadModel(const std::string& filePath)
+	{
+		models_.erase(filePath);
+	}
+
 	// 終了処理
 	// - 現状は明示的な処理なし。ただし将来的にリソース解放や map の clear を入れる場所
 	void ModelManager::Finalize()
@@ -44,6 +44,15 @@ namespace MyEngine {
 		// モデルの読み込み
 		void LoadModel(const std::string& filePath);
 
+		// パース済みデータからモデルを登録（GPUリソース作成のみ、メインスレッド専用）
+		void LoadModelFromData(const std::string& filePath, ModelData modelData);
+
+		// OBJファイルのパース（CPUのみ。ワーカースレッドから呼び出し可）
+		static ModelData DecodeModel(const std::string& filePath);
+
+		// モデルの解放（参照している Object3d が無いタイミングで呼ぶこと）
+		void UnloadModel(const std::string& filePath);
+
 		// 終了処理
 		void Finalize();
 
@@ -0,0 +1,170 @@
+#include "ObjLoader.h"
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+//
+// ObjLoader
+// - OBJ/MTL ファイルを読み込み、頂点・法線・UV をパースして ModelData を構築する（Model.cpp から切り出したもの）。
+// - ファイル読み込みと頂点配列の構築のみで D3D には触れない。GPU リソースの作成は Model が行う。
+//
+// 注意点 / 前提
+// - 面 (f) は三角形のみサポート（ngons は非対応）
+// - OBJ 内のインデックスは「位置/UV/法線」の形式であることを前提としている
+// - DirectX の座標系変換（右手系→左手系）や UV 縦反転を行い、エンジン側の期待する形式に合わせている
+//
+namespace MyEngine {
+	using namespace ObjLoaderConstants;
+
+	namespace {
+		Vector4 ParseVertexPosition(std::istringstream& stream)
+		{
+			Vector4 position;
+			stream >> position.x >> position.y >> position.z;
+			// 右手系 OBJ を左手系レンダラーに合わせるため X 軸を反転
+			position.x *= kCoordinateFlipScale;
+			position.w = kDefaultPositionW;
+			return position;
+		}
+
+		Vector2 ParseTexCoord(std::istringstream& stream)
+		{
+			Vector2 texcoord;
+			stream >> texcoord.x >> texcoord.y;
+			// OBJ の V は上方向が +、DirectX は下方向が + なので反転
+			texcoord.y = 1.0f - texcoord.y;
+			return texcoord;
+		}
+
+		Vector3 ParseNormal(std::istringstream& stream)
+		{
+			Vector3 normal;
+			stream >> normal.x >> normal.y >> normal.z;
+			// 法線の X も位置同様反転して座標系を合わせる
+			normal.x *= kCoordinateFlipScale;
+			return normal;
+		}
+
+		void ParseVertexIndices(const std::string& vertexDefinition, uint32_t* outIndices)
+		{
+			std::istringstream v(vertexDefinition);
+
+			for (int32_t element = 0; element < kFaceElementCount; ++element) {
+				std::string index;
+				std::getline(v, index, kFaceDelimiter);
+				outIndices[element] = std::stoi(index);
+			}
+		}
+
+		void ParseFace(
+			std::istringstream& stream,
+			const std::vector<Vector4>& positions,
+			const std::vector<Vector2>& texcoords,
+			const std::vector<Vector3>& normals,
+			ModelData& modelData)
+		{
+			// 本実装は三角形のみ対応
+			VertexData triangle[kFaceVertexCount];
+
+			for (int32_t faceVertex = 0; faceVertex < kFaceVertexCount; ++faceVertex) {
+				std::string vertexDefinition;
+				stream >> vertexDefinition;
+
+				// "pos/tex/normal" を '/' で分割してインデックスを取得
+				uint32_t elementIndices[kFaceElementCount];
+				ParseVertexIndices(vertexDefinition, elementIndices);
+
+				// インデックスから実データを取得
+				Vector4 position = positions[elementIndices[0] - kObjIndexOffset];
+				Vector2 texcoord = texcoords[elementIndices[1] - kObjIndexOffset];
+				Vector3 normal = normals[elementIndices[2] - kObjIndexOffset];
+				triangle[faceVertex] = { position, texcoord, normal };
+			}
+
+			// 頂点の登録順を逆にして回り順を調整
+			modelData.vertices.push_back(triangle[2]);
+			modelData.vertices.push_back(triangle[1]);
+			modelData.vertices.push_back(triangle[0]);
+		}
+	}
+
+	/// MTL ファイルを読み込み MaterialData を構築する
+	/// - 対応: map_Kd を読み取りテクスチャファイルパスを materialData に格納する
+	/// - directoryPath/filename の組でファイルを開き、1行ずつ解析する
+	MaterialData ObjLoader::LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename)
+	{
+		MaterialData materialData;
+		std::string line;
+
+		std::ifstream file(directoryPath + "/" + filename);
+		assert(file.is_open());
+
+		while (std::getline(file, line)) {
+			std::string identifier;
+			std::istringstream s(line);
+			s >> identifier;
+
+			// map_Kd が見つかったらテクスチャ名を読み取り、ディレクトリと連結してフルパス化する
+			if (identifier == kMtlIdentifierTexture) {
+				std::string textureFilename;
+				s >> textureFilename;
+				materialData.textureFilePath = directoryPath + "/" + textureFilename;
+			}
+		}
+		return materialData;
+	}
+
+	/// OBJ ファイルをパースして ModelData を構築する
+	/// - サポートする識別子: v, vt, vn, f, mtllib
+	/// - 面 (f) の各頂点は "posIndex/uvIndex/normalIndex" の形式を想定
+	/// - 各要素は1オフセット（OBJ の 1 始まり）なので内部で -1 して参照する
+	ModelData ObjLoader::LoadObjFile(const std::string& directoryPath, const std::string& filename)
+	{
+		ModelData modelData;
+
+		// 一時的に読み込む要素配列（OBJ 内の生データ）
+		std::vector<Vector4> positions; // v: 位置（w を 1 に設定）
+		std::vector<Vector3> normals;   // vn: 法線
+		std::vector<Vector2> texcoords; // vt: テクスチャ座標
+
+		std::string line;
+		std::ifstream file(directoryPath + "/" + filename);
+		assert(file.is_open());
+
+		// ファイルを1行ずつ処理
+		while (std::getline(file, line)) {
+			std::string identifier;
+			std::istringstream s(line);
+			s >> identifier;
+
+			// 頂点位置: "v x y z"
+			if (identifier == kObjIdentifierVertex) {
+				positions.push_back(ParseVertexPosition(s));
+			}
+			// テクスチャ座標: "vt u v"
+			else if (identifier == kObjIdentifierTexCoord) {
+				texcoords.push_back(ParseTexCoord(s));
+			}
+			// 法線: "vn x y z"
+			else if (identifier == kObjIdentifierNormal) {
+				normals.push_back(ParseNormal(s));
+			}
+			// 面: "f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3"
+			else if (identifier == kObjIdentifierFace) {
+				ParseFace(s, positions, texcoords, normals, modelData);
+			}
+			// マテリアルライブラリ参照: "mtllib filename.mtl"
+			else if (identifier == kObjIdentifierMaterialLib) {
+				std::string materialFilename;
+				s >> materialFilename;
+				modelData.material = LoadMaterialTemplateFile(directoryPath, materialFilename);
+			}
+		}
+
+		// 視錐台カリング用の境界球（ローカル座標）
+		modelData.boundingSphere = Math::ComputeBoundingSphere(modelData.vertices);
+
+		return modelData;
+	}
+}
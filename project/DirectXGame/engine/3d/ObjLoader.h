@@ -0,0 +1,38 @@
+#pragma once
+#include "ModelData.h"
+#include <cstdint>
+#include <string>
+
+namespace MyEngine {
+	// ObjLoader用の定数
+	namespace ObjLoaderConstants {
+		// OBJファイル形式の定数
+		constexpr int32_t kFaceVertexCount = 3;      // 三角形の頂点数
+		constexpr int32_t kFaceElementCount = 3;     // pos/uv/normal の要素数
+		constexpr int32_t kObjIndexOffset = 1;       // OBJファイルの1始まりインデックスのオフセット
+
+		// 座標変換の定数
+		constexpr float kCoordinateFlipScale = -1.0f;  // 右手系→左手系の反転係数
+		constexpr float kDefaultPositionW = 1.0f;      // 位置ベクトルのw成分
+
+		// 識別子文字列
+		constexpr const char* kObjIdentifierVertex = "v";
+		constexpr const char* kObjIdentifierTexCoord = "vt";
+		constexpr const char* kObjIdentifierNormal = "vn";
+		constexpr const char* kObjIdentifierFace = "f";
+		constexpr const char* kObjIdentifierMaterialLib = "mtllib";
+		constexpr const char* kMtlIdentifierTexture = "map_Kd";
+		constexpr char kFaceDelimiter = '/';
+	}
+
+	/// <summary>
+	/// OBJ / MTL ファイルのパース（CPU のみ。D3D に触れないのでワーカースレッドや project/tests から呼べる）
+	/// </summary>
+	namespace ObjLoader {
+		// .mtlファイルの読み込み
+		MaterialData LoadMaterialTemplateFile(const std::string& directoryPath, const std::string& filename);
+
+		// .objファイルの読み取り
+		ModelData LoadObjFile(const std::string& directoryPath, const std::string& filename);
+	}
+}
@@ -12,45 +12,75 @@
 #include <imgui.h>
 #include "DirectXCommon.h"
 #include <ResourceManager.h>
+#include "Object3dRenderQueue.h"
+#include "LightManager.h"
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
 //
 // Object3d
 // - 単一の 3D オブジェクトを表すクラス実装。
 // - OBJ ファイルの読み込み・頂点/マテリアルバッファ作成、描画、GUI 操作を含む。
-// - カメラ／ライト用の定数バッファも保持し、必要時に GPU に渡す。
+// - カメラとライトは LightManager の共通の定数バッファを使い、ここではライトの輝度の上書きの番号だけを持つ。
+// - Object3dRenderQueue の記録中は Draw でコマンドを積まずにキューへ渡し、同じ OBJ・同じ状態のものをまとめて描く。
 // 
 using namespace Math;
 namespace MyEngine {
+	namespace {
+		// OBJ ファイル名ごとに番号を振る（Initialize は読み込みスレッドからも呼ばれうるので排他する）
+		uint32_t FindOrAddMeshId(const std::string& fileName)
+		{
+			static std::mutex mutex;
+			static std::unordered_map<std::string, uint32_t> meshIds;
+			std::lock_guard<std::mutex> lock(mutex);
+			auto [it, inserted] = meshIds.try_emplace(fileName, static_cast<uint32_t>(meshIds.size()) + 1);
+			return it->second;
+		}
+
+		// FNV-1a (64bit)
+		constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+		constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+		uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+		{
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			for (size_t i = 0; i < size; ++i) {
+				hash ^= bytes[i];
+				hash *= kFnvPrime;
+			}
+			return hash;
+		}
+	}
+
+	Object3d::~Object3d()
+	{
+		// 参照が 0 になったテクスチャは TextureManager がメモリ予算に応じて解放する
+		TextureManager::GetInstance()->ReleaseTexture(textureHandle_);
+		TextureManager::GetInstance()->ReleaseTexture(skyboxTextureHandle_);
+	}
+
 	void Object3d::Initialize(const std::string& fileName)
 	{
 		// OBJファイルを読み込み
 		modelData_ = LoadObjFile(Object3dConstants::kDefaultResourceDirectory, fileName);
+		meshId_ = FindOrAddMeshId(fileName);
 
 		// リソース作成
 		CreateVertexData();
 		CreateMaterialData();
-		CreateDirectionalLightData();
 
-		// テクスチャの読み込み
-		TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
+		// テクスチャの読み込み（ハンドル＝参照を保持し、デストラクタで手放す）
+		TextureManager::GetInstance()->ReleaseTexture(textureHandle_);
+		textureHandle_ = TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
 
 		// デフォルトのスカイボックステクスチャを読み込み
-		filePath_ = Object3dConstants::kDefaultSkyboxFilePath;
-		TextureManager::GetInstance()->LoadTexture(filePath_);
-		skyboxGpuHandle_ = TextureManager::GetInstance()->GetSrvHandleGPU(filePath_);
+		SetSkyboxFilePath(Object3dConstants::kDefaultSkyboxFilePath);
 
 		// マテリアルのGPUハンドル取得
-		modelData_.material.gpuHandle = TextureManager::GetInstance()->GetSrvHandleGPU(modelData_.material.textureFilePath);
+		modelData_.material.gpuHandle = TextureManager::GetInstance()->GetSrvHandleGPU(textureHandle_);
 
 		// ワールド変換の初期化
 		worldTransform.Initialize();
-
-		// デフォルトカメラの取得
-		camera_ = Object3dCommon::GetInstance()->GetDefaultCamera();
-
-		// ライト用リソース作成
-		CreateCameraResource();
-		CreatePointLightResource();
-		CreateSpotLightResource();
 	}
 
 	void Object3d::Update()
@@ -60,11 +90,20 @@ namespace MyEngine {
 
 	void Object3d::Draw()
 	{
-		BindVertexBuffer();
-		SetMaterialCBV();
+		// 視錐台カリングで画面外と判定されていればコマンドを積まない
+		if (isCulled_) {
+			return;
+		}
+
+		// 描画キューの記録中はキューに積む（モデルを重ねて描くものはキューが通常のパイプラインで 1 つずつ描く）
+		Object3dRenderQueue* renderQueue = Object3dRenderQueue::GetInstance();
+		if (renderQueue->IsRecording()) {
+			renderQueue->Add(this);
+			return;
+		}
+
+		SetBatchState();
 		worldTransform.SetPipeline();
-		SetTextureSRVs();
-		SetLightingCBVs();
 
 		// モデルが設定されていれば描画
 		if (model_) {
@@ -138,63 +177,10 @@ namespace MyEngine {
 			}
 		}
 
-		return modelData;
-	}
-
-	void Object3d::CreateCameraResource()
-	{
-		cameraResource_ = ResourceManager::CreateBufferResource(
-			Object3dCommon::GetInstance()->GetDxCommon()->GetDevice().Get(),
-			sizeof(CameraForGPU));
-		cameraResource_->Map(0, nullptr, reinterpret_cast<void**>(&cameraData_));
-		cameraData_->worldPosition = camera_->GetTranslate();
-	}
-
-	void Object3d::CreatePointLightResource()
-	{
-		pointLightResource_ = ResourceManager::CreateBufferResource(
-			Object3dCommon::GetInstance()->GetDxCommon()->GetDevice().Get(),
-			sizeof(PointLight));
-		pointLightResource_->Map(0, nullptr, reinterpret_cast<void**>(&pointLightData_));
-
-		// デフォルト値の設定
-		pointLightData_->position = { 0.0f, Object3dConstants::kDefaultLightPositionY, 0.0f };
-		pointLightData_->color = {
-			Object3dConstants::kDefaultMaterialColorR,
-			Object3dConstants::kDefaultMaterialColorG,
-			Object3dConstants::kDefaultMaterialColorB,
-			Object3dConstants::kDefaultMaterialColorA
-		};
-		pointLightData_->intensity = Object3dConstants::kDefaultPointLightIntensity;
-		pointLightData_->radius = Object3dConstants::kDefaultPointLightRadius;
-		pointLightData_->decay = Object3dConstants::kDefaultPointLightDecay;
-
-		pointLightResource_->Unmap(0, nullptr);
-	}
-
-	void Object3d::CreateSpotLightResource()
-	{
-		spotLightResource_ = ResourceManager::CreateBufferResource(
-			Object3dCommon::GetInstance()->GetDxCommon()->GetDevice().Get(),
-			sizeof(SpotLight));
-		spotLightResource_->Map(0, nullptr, reinterpret_cast<void**>(&spotLightData_));
+		// 視錐台カリング用の境界球（ローカル座標）
+		modelData.boundingSphere = ComputeBoundingSphere(modelData.vertices);
 
-		// デフォルト値の設定
-		spotLightData_->position = { 0.0f, Object3dConstants::kDefaultLightPositionY, 0.0f };
-		spotLightData_->color = {
-			Object3dConstants::kDefaultMaterialColorR,
-			Object3dConstants::kDefaultMaterialColorG,
-			Object3dConstants::kDefaultMaterialColorB,
-			Object3dConstants::kDefaultMaterialColorA
-		};
-		spotLightData_->intensity = Object3dConstants::kDefaultSpotLightIntensity;
-		spotLightData_->direction = { 0.0f, Object3dConstants::kDefaultDirectionalLightDirectionY, 0.0f };
-		spotLightData_->cosAngle = std::cos(std::numbers::pi_v<float> / Object3dConstants::kSpotLightAngleDivisor);
-		spotLightData_->cosFalloffStart = std::cos(std::numbers::pi_v<float> / Object3dConstants::kSpotLightFalloffAngleDivisor);
-		spotLightData_->distance = Object3dConstants::kDefaultSpotLightDistance;
-		spotLightData_->decay = Object3dConstants::kDefaultSpotLightDecay;
-
-		spotLightResource_->Unmap(0, nullptr);
+		return modelData;
 	}
 
 	void Object3d::DrawImGui()
@@ -216,26 +202,15 @@ namespace MyEngine {
 		if (ImGui::DragFloat3("scale", &scale.x, 0.01f)) {
 			worldTransform.SetScale(scale);
 		}
-		ImGui::ColorEdit4("color", &materialData_->color.x);
-		ImGui::ColorEdit4("lightColor", &directionalLightData_->color.x);
-		ImGui::DragFloat3("lightDirection", &directionalLightData_->direction.x, 0.01f);
-		ImGui::DragFloat("intensity", &directionalLightData_->intensity, 0.01f);
-		ImGui::SliderFloat("environmentCoefficient", &materialData_->environmentCoefficient, 0.0f, 1.0f);
-
-		// ポイントライト
-		ImGui::ColorEdit4("pointLightColor", &pointLightData_->color.x);
-		ImGui::DragFloat3("pointLightPosition", &pointLightData_->position.x, 0.01f);
-		ImGui::DragFloat("pointLightIntensity", &pointLightData_->intensity, 0.01f);
-
-		// スポットライト
-		ImGui::ColorEdit4("spotLightColor", &spotLightData_->color.x);
-		ImGui::DragFloat3("spotLightPosition", &spotLightData_->position.x, 0.01f);
-		ImGui::DragFloat3("spotLightDirection", &spotLightData_->direction.x, 0.01f);
-		ImGui::DragFloat("spotLightIntensity", &spotLightData_->intensity, 0.01f);
-		ImGui::DragFloat("spotLightDistance", &spotLightData_->distance, 0.01f);
-		ImGui::DragFloat("spotLightDecay", &spotLightData_->decay, 0.01f);
-		ImGui::DragFloat("spotLightCosAngle", &spotLightData_->cosAngle, 0.01f);
-		ImGui::DragFloat("spotLightCosFalloffStart", &spotLightData_->cosFalloffStart, 0.01f);
+		bool isMaterialChanged = ImGui::ColorEdit4("color", &material_.color.x);
+		isMaterialChanged |= ImGui::SliderFloat("environmentCoefficient", &material_.environmentCoefficient, 0.0f, 1.0f);
+		if (isMaterialChanged) {
+			*materialData_ = material_;
+			UpdateMaterialHash();
+		}
+
+		// ライト（シーン共通なので全ての Object3d に反映される）
+		LightManager::GetInstance()->DrawImGui();
 
 		ImGui::End();
 #endif
@@ -247,12 +222,66 @@ namespace MyEngine {
 		model_ = ModelManager::GetInstance()->FindModel(filePath);
 	}
 
+	BoundingSphere Object3d::GetWorldBoundingSphere() const
+	{
+		// 自前の頂点と、設定されたモデルの頂点の両方を描くので、両方を含む球にする
+		BoundingSphere localSphere = modelData_.boundingSphere;
+		if (model_) {
+			localSphere = modelData_.vertices.empty()
+				? model_->GetModelData().boundingSphere
+				: MergeBoundingSphere(localSphere, model_->GetModelData().boundingSphere);
+		}
+		return TransformBoundingSphere(localSphere, worldTransform.GetAffineMatWorld());
+	}
+
+	bool Object3d::HasSameBatchState(const Object3d& other) const
+	{
+		return meshId_ == other.meshId_ &&
+			modelData_.material.gpuHandle.ptr == other.modelData_.material.gpuHandle.ptr &&
+			skyboxGpuHandle_.ptr == other.skyboxGpuHandle_.ptr &&
+			lightOverrideIndex_ == other.lightOverrideIndex_ &&
+			std::memcmp(&material_, &other.material_, sizeof(Material)) == 0;
+	}
+
+	uint64_t Object3d::GetBatchStateHash() const
+	{
+		// HasSameBatchState で比べるものと同じ組（マテリアルは控えておいたハッシュ）
+		const uint64_t state[] = {
+			meshId_,
+			modelData_.material.gpuHandle.ptr,
+			skyboxGpuHandle_.ptr,
+			lightOverrideIndex_,
+			materialHash_
+		};
+		return HashBytes(kFnvOffsetBasis, state, sizeof(state));
+	}
+
+	void Object3d::SetBatchState()
+	{
+		BindVertexBuffer();
+		SetMaterialCBV();
+		SetTextureSRVs();
+		SetLightOverride();
+	}
+
+	void Object3d::UpdateLightOverride()
+	{
+		lightOverrideIndex_ = LightManager::GetInstance()->FindOrAddOverride(lightOverride_);
+	}
+
+	void Object3d::UpdateMaterialHash()
+	{
+		materialHash_ = HashBytes(kFnvOffsetBasis, &material_, sizeof(Material));
+	}
+
 	void Object3d::SetSkyboxFilePath(std::string filePath)
 	{
-		// スカイボックス用テクスチャを設定し、SRV ハンドルを更新する
+		// スカイボックス用テクスチャを設定し、SRV ハンドルを更新する（前のテクスチャの参照は手放す）
 		filePath_ = filePath;
-		TextureManager::GetInstance()->LoadTexture(filePath_);
-		skyboxGpuHandle_ = TextureManager::GetInstance()->GetSrvHandleGPU(filePath_);
+		TextureHandle previousHandle = skyboxTextureHandle_;
+		skyboxTextureHandle_ = TextureManager::GetInstance()->LoadTexture(filePath_);
+		TextureManager::GetInstance()->ReleaseTexture(previousHandle);
+		skyboxGpuHandle_ = TextureManager::GetInstance()->GetSrvHandleGPU(skyboxTextureHandle_);
 	}
 
 	void Object3d::CreateVertexData()
@@ -283,35 +312,18 @@ namespace MyEngine {
 		materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
 
 		// デフォルト値の設定
-		materialData_->color = Vector4(
+		material_ = {};
+		material_.color = Vector4(
 			Object3dConstants::kDefaultMaterialColorR,
 			Object3dConstants::kDefaultMaterialColorG,
 			Object3dConstants::kDefaultMaterialColorB,
 			Object3dConstants::kDefaultMaterialColorA);
-		materialData_->enableLighting = Object3dConstants::kDefaultLightingEnabled;
-		materialData_->shininess = Object3dConstants::kDefaultShininess;
-		materialData_->uvTransform = MakeIdentity4x4();
-		materialData_->environmentCoefficient = Object3dConstants::kDefaultEnvironmentCoefficient;
-	}
-
-	void Object3d::CreateDirectionalLightData()
-	{
-		directionalLightResource_ = ResourceManager::CreateBufferResource(
-			Object3dCommon::GetInstance()->GetDxCommon()->GetDevice().Get(),
-			sizeof(DirectionalLight));
-		directionalLightResource_->Map(0, nullptr, reinterpret_cast<void**>(&directionalLightData_));
-
-		// デフォルト値の設定
-		directionalLightData_->color = {
-			Object3dConstants::kDefaultMaterialColorR,
-			Object3dConstants::kDefaultMaterialColorG,
-			Object3dConstants::kDefaultMaterialColorB,
-			Object3dConstants::kDefaultMaterialColorA
-		};
-		directionalLightData_->direction = { 0.0f, Object3dConstants::kDefaultDirectionalLightDirectionY, 0.0f };
-		directionalLightData_->intensity = Object3dConstants::kDefaultLightIntensity;
-
-		Normalize(directionalLightData_->direction);
+		material_.enableLighting = Object3dConstants::kDefaultLightingEnabled;
+		material_.shininess = Object3dConstants::kDefaultShininess;
+		material_.uvTransform = MakeIdentity4x4();
+		material_.environmentCoefficient = Object3dConstants::kDefaultEnvironmentCoefficient;
+		*materialData_ = material_;
+		UpdateMaterialHash();
 	}
 
 	// ===== OBJパース用ヘルパー関数 =====
@@ -437,25 +449,11 @@ namespace MyEngine {
 			0, materialResource_->GetGPUVirtualAddress());
 	}
 
-	void Object3d::SetLightingCBVs()
+	void Object3d::SetLightOverride()
 	{
-		auto* commandList = Object3dCommon::GetInstance()->GetDxCommon()->GetCommandList();
-
-		// ディレクショナルライト (slot 3)
-		commandList->SetGraphicsRootConstantBufferView(
-			3, directionalLightResource_->GetGPUVirtualAddress());
-
-		// カメラ (slot 4)
-		commandList->SetGraphicsRootConstantBufferView(
-			4, cameraResource_->GetGPUVirtualAddress());
-
-		// ポイントライト (slot 5)
-		commandList->SetGraphicsRootConstantBufferView(
-			5, pointLightResource_->GetGPUVirtualAddress());
-
-		// スポットライト (slot 6)
-		commandList->SetGraphicsRootConstantBufferView(
-			6, spotLightResource_->GetGPUVirtualAddress());
+		// ライトの輝度の上書きの番号（ライトとカメラ本体は Object3dCommon::DrawSettings で設定済み）
+		Object3dCommon::GetInstance()->GetDxCommon()->GetCommandList()->SetGraphicsRoot32BitConstant(
+			Object3dCommonConstants::kRootParameterIndexLightOverride, lightOverrideIndex_, 0);
 	}
 
 	void Object3d::SetTextureSRVs()
@@ -466,10 +464,10 @@ namespace MyEngine {
 		commandList->SetGraphicsRootDescriptorTable(
 			2, modelData_.material.gpuHandle);
 
-		// スカイボックス (slot 7)
+		// スカイボックス
 		if (skyboxGpuHandle_.ptr != 0) {
 			commandList->SetGraphicsRootDescriptorTable(
-				7, skyboxGpuHandle_);
+				Object3dCommonConstants::kRootParameterIndexEnvironmentMap, skyboxGpuHandle_);
 		}
 	}
 }
\ No newline at end of file
@@ -17,6 +17,8 @@
 #include <Material.h>
 #include <VertexData.h>
 #include <ModelData.h>
+#include <BoundingSphere.h>
+#include <LightManager.h>
 
 namespace MyEngine {
 	// 前方宣言
@@ -32,15 +34,6 @@ namespace MyEngine {
 		constexpr uint32_t kSphereSubdivision = 32;
 		constexpr uint32_t kSphereVerticesPerQuad = 6;
 
-		// ライトのデフォルト値
-		constexpr float kDefaultLightIntensity = 3.0f;
-		constexpr float kDefaultPointLightIntensity = 1.0f;
-		constexpr float kDefaultPointLightRadius = 10.0f;
-		constexpr float kDefaultPointLightDecay = 1.0f;
-		constexpr float kDefaultSpotLightIntensity = 4.0f;
-		constexpr float kDefaultSpotLightDistance = 7.0f;
-		constexpr float kDefaultSpotLightDecay = 2.0f;
-
 		// マテリアルのデフォルト値
 		constexpr float kDefaultMaterialColorR = 1.0f;
 		constexpr float kDefaultMaterialColorG = 1.0f;
@@ -50,14 +43,6 @@ namespace MyEngine {
 		constexpr float kDefaultEnvironmentCoefficient = 0.0f;
 		constexpr bool kDefaultLightingEnabled = true;
 
-		// ポジションのデフォルト値
-		constexpr float kDefaultLightPositionY = 2.0f;
-		constexpr float kDefaultDirectionalLightDirectionY = -1.0f;
-
-		// スポットライトの角度
-		constexpr float kSpotLightAngleDivisor = 3.0f;
-		constexpr float kSpotLightFalloffAngleDivisor = 6.0f;
-
 		// OBJ形式の定数
 		constexpr int32_t kFaceVertexCount = 3;
 		constexpr int32_t kFaceElementCount = 3;
@@ -88,38 +73,8 @@ namespace MyEngine {
 			Matrix4x4 worldInverseTranspose;
 		};
 
-		// ディレクショナルライトデータ
-		struct DirectionalLight {
-			Vector4 color; // ライトの色
-			Vector3 direction; // ライトの向き
-			float intensity; // 輝度
-		};
-
-		struct CameraForGPU {
-			Vector3 worldPosition; // カメラのワールド座標
-		};
-
-		// ポイントライトデータ
-		struct PointLight {
-			Vector4 color; // ライトの色
-			Vector3 position; // ライトの位置
-			float intensity; // 輝度
-			float radius; // ライトの届く最大距離
-			float decay; // 減衰率
-		};
-
-		// スポットライトデータ
-		struct SpotLight {
-			Vector4 color; // ライトの色
-			Vector3 position; // ライトの位置
-			float intensity; // 輝度
-			Vector3 direction; // ライトの向き
-			float cosAngle; // スポットライトの角度
-			float cosFalloffStart; // スポットライトの開始角度の余弦値
-			float distance; // ライトの届く最大距離
-			float decay; // 減衰率
-			float padding[2]; // パディング
-		};
+		// デストラクタ（テクスチャの参照を手放す）
+		~Object3d();
 
 		// 初期化
 		void Initialize(const std::string& fileName);
@@ -143,6 +98,24 @@ namespace MyEngine {
 		const Vector3& GetScale() const { return worldTransform.GetScale(); }
 		const Vector3& GetRotate() const { return worldTransform.GetRotate(); }
 		const Vector3& GetTranslate() const { return worldTransform.GetTranslate(); }
+		// ワールド座標の境界球（Update 後のワールド行列で変換する）
+		BoundingSphere GetWorldBoundingSphere() const;
+		// 視錐台カリングで画面外と判定されたか（FrustumCuller が毎フレーム設定する）
+		bool IsCulled() const { return isCulled_; }
+		const WorldTransform& GetWorldTransform() const { return worldTransform; }
+		// 読み込んだ OBJ ファイルごとの番号（同じファイルなら頂点も同じなのでインスタンシングでまとめられる）
+		uint32_t GetMeshId() const { return meshId_; }
+		UINT GetVertexCount() const { return UINT(modelData_.vertices.size()); }
+		// モデルを重ねて描くか（インスタンシングでまとめられない）
+		bool HasModel() const { return model_ != nullptr; }
+
+		// インスタンシング描画用（Object3dRenderQueue から使う）
+		// 同じ DrawInstanced にまとめられるか（メッシュ・テクスチャ・マテリアル・ライトが全て同じ）
+		bool HasSameBatchState(const Object3d& other) const;
+		// HasSameBatchState で比べる状態のハッシュ（並べ替えキー用。同じ値でもまとめる前に HasSameBatchState で確かめる）
+		uint64_t GetBatchStateHash() const;
+		// 変換行列以外の状態（頂点バッファ・マテリアル・テクスチャ・ライト）を設定する
+		void SetBatchState();
 
 		// セッター
 		void SetModel(Model* model) { model_ = model; }
@@ -151,21 +124,25 @@ namespace MyEngine {
 		void SetRotate(const Vector3& rotate) { worldTransform.SetRotate(rotate); }
 		void SetTranslate(const Vector3& translate) { worldTransform.SetTranslate(translate); }
 		void SetWorldTransform(const WorldTransform& worldTransform) { this->worldTransform = worldTransform; }
-		void SetCamera(Camera* camera) { camera_ = camera; }
+		void SetWorldMatrix(const Affine3x4& world) { worldTransform.SetWorldMatrix(world); }
 		void SetSkyboxFilePath(std::string filePath);
-		void SetPointLight(float intensity) { pointLightData_->intensity = intensity; }
-		void SetSpotLight(float intensity) { spotLightData_->intensity = intensity; }
-		void SetDirectionalLight(float intensity) { directionalLightData_->intensity = intensity; }
-		void SetMaterialColor(const Vector4& color) { materialData_->color = color; }
+		// ライトの輝度をこのオブジェクトだけ上書きする（ライト本体は LightManager のシーン共通のもの）
+		void SetPointLight(float intensity) { lightOverride_.pointIntensity = intensity; UpdateLightOverride(); }
+		void SetSpotLight(float intensity) { lightOverride_.spotIntensity = intensity; UpdateLightOverride(); }
+		void SetDirectionalLight(float intensity) { lightOverride_.directionalIntensity = intensity; UpdateLightOverride(); }
+		void SetMaterialColor(const Vector4& color) { material_.color = color; materialData_->color = color; UpdateMaterialHash(); }
+		void SetCulled(bool isCulled) { isCulled_ = isCulled; }
 
 	private:
 		// リソース作成
 		void CreateVertexData();
 		void CreateMaterialData();
-		void CreateDirectionalLightData();
-		void CreateCameraResource();
-		void CreatePointLightResource();
-		void CreateSpotLightResource();
+
+		// ライトの輝度の上書きを LightManager に登録し、番号を取り直す
+		void UpdateLightOverride();
+
+		// material_ を変えたらハッシュを取り直す
+		void UpdateMaterialHash();
 
 		// OBJパース用ヘルパー関数
 		static Vector4 ParseVertexPosition(std::istringstream& stream);
@@ -186,7 +163,7 @@ namespace MyEngine {
 		// 描画ヘルパー
 		void BindVertexBuffer();
 		void SetMaterialCBV();
-		void SetLightingCBVs();
+		void SetLightOverride();
 		void SetTextureSRVs();
 
 		// Model共通データ
@@ -199,20 +176,16 @@ namespace MyEngine {
 		Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource_;
 		Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
 		Microsoft::WRL::ComPtr<ID3D12Resource> wvpResource_;
-		Microsoft::WRL::ComPtr<ID3D12Resource> directionalLightResource_;
-		Microsoft::WRL::ComPtr<ID3D12Resource> cameraResource_;
-		Microsoft::WRL::ComPtr<ID3D12Resource> pointLightResource_;
-		Microsoft::WRL::ComPtr<ID3D12Resource> spotLightResource_;
 
 		// バッファリソース内のデータを指すポインタ
 		VertexData* vertexData_ = nullptr;
-		Material* materialData_ = nullptr;
+		Material* materialData_ = nullptr; // 書き込み専用（アップロードヒープは CPU から読むと遅い）
 		WorldTransformationMatrix* worldTransformationMatrixData_ = nullptr;
-		DirectionalLight* directionalLightData_ = nullptr;
-		// カメラにデータを書き込む
-		CameraForGPU* cameraData_ = nullptr;
-		PointLight* pointLightData_ = nullptr;
-		SpotLight* spotLightData_ = nullptr;
+
+		// マテリアルの CPU 側の控え（変更はここに書いてから materialData_ へ書き写す。バッチの比較もこちらで行う）
+		Material material_{};
+		// material_ のハッシュ（GetBatchStateHash で毎フレーム material_ 全体を読まないように控えておく）
+		uint64_t materialHash_ = 0;
 
 		// 頂点バッファビュー
 		D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
@@ -220,9 +193,6 @@ namespace MyEngine {
 		// ワールド変換
 		WorldTransform worldTransform;
 
-		// カメラ
-		Camera* camera_ = nullptr;
-
 		// 球体の分割数
 		uint32_t kSubdivision_ = Object3dConstants::kSphereSubdivision;
 
@@ -236,7 +206,21 @@ namespace MyEngine {
 		// ファイルパス
 		std::string filePath_;
 
+		// モデルとスカイボックスのテクスチャのハンドル（参照を持つ）
+		TextureHandle textureHandle_{};
+		TextureHandle skyboxTextureHandle_{};
+
 		// スカイボックスのGPUハンドル
 		D3D12_GPU_DESCRIPTOR_HANDLE skyboxGpuHandle_{};
+
+		// 視錐台カリングで画面外と判定されたか（true の間は Draw でコマンドを積まない）
+		bool isCulled_ = false;
+
+		// 読み込んだ OBJ ファイルの番号（0 は未読み込み）
+		uint32_t meshId_ = 0;
+
+		// ライトの輝度の上書きと、LightManager に登録した番号（0 は上書き無し）
+		LightManager::LightOverride lightOverride_;
+		uint32_t lightOverrideIndex_ = 0;
 	};
 } // namespace MyEngine
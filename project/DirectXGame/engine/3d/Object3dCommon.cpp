@@ -4,10 +4,13 @@
 #include "Logger.h"
 #include <SrvManager.h>
 #include "DirectXCommon.h"
+#include "LightManager.h"
 
 //
 // Object3dCommon
 // - シーン内の 3D 描画で共通に使うパイプライン（RootSignature / PSO / 入力レイアウト 等）を初期化・管理するシングルトン。
+// - インスタンシング描画用のパイプラインも持つ。通常の描画との違いは変換行列の渡し方だけ
+//   （定数バッファ 1 つ → StructuredBuffer とその中の先頭番号のルート定数）なので、他のルートパラメータの番号は同じにしてある。
 //
 
 namespace MyEngine {
@@ -40,6 +43,7 @@ namespace MyEngine {
 
 		// ルートシグネチャと PSO の構築
 		GraphicsPipelineInitialize();
+		InstancingPipelineInitialize();
 	}
 
 	// 描画前設定
@@ -58,6 +62,32 @@ namespace MyEngine {
 		// DescriptorHeap (SRV) をコマンドリストに紐づける
 		ID3D12DescriptorHeap* descriptorHeaps[] = { srvManager_->GetDescriptorHeap() };
 		dxCommon_->GetCommandList()->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
+
+		// ライトとカメラ（シーン共通なのでパスごとに 1 回だけ）
+		SetLightingRootParameters();
+	}
+
+	// インスタンシング描画の共通設定
+	// - DescriptorHeap とトポロジは DrawSettings で設定済みのものをそのまま使う
+	void Object3dCommon::DrawSettingsInstancing()
+	{
+		dxCommon_->GetCommandList()->SetGraphicsRootSignature(instancingRootSignature_.Get());
+		dxCommon_->GetCommandList()->SetPipelineState(instancingPipelineState_.Get());
+
+		// ルートシグネチャを切り替えると設定が消えるので、ライトとカメラを設定し直す
+		SetLightingRootParameters();
+	}
+
+	// ライトとカメラの定数バッファと、クラスタのライトの StructuredBuffer を設定する
+	void Object3dCommon::SetLightingRootParameters()
+	{
+		LightManager* lightManager = LightManager::GetInstance();
+		ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+		commandList->SetGraphicsRootConstantBufferView(kRootParameterIndexLighting, lightManager->GetGPUVirtualAddress());
+		commandList->SetGraphicsRootShaderResourceView(kRootParameterIndexClusterPointLights, lightManager->GetClusterPointLightAddress());
+		commandList->SetGraphicsRootShaderResourceView(kRootParameterIndexClusterSpotLights, lightManager->GetClusterSpotLightAddress());
+		commandList->SetGraphicsRootShaderResourceView(kRootParameterIndexClusters, lightManager->GetClusterAddress());
+		commandList->SetGraphicsRootShaderResourceView(kRootParameterIndexClusterLightIndices, lightManager->GetClusterLightIndexAddress());
 	}
 
 	// RootSignature の構築
@@ -65,22 +95,19 @@ namespace MyEngine {
 	//   rootParameters[0] : Material CBV (b0)    - Pixel シェーダで参照
 	//   rootParameters[1] : Transformation CBV (b0) - Vertex シェーダで参照
 	//   rootParameters[2] : Texture SRV (t0) via DescriptorTable - Pixel シェーダで参照
-	//   rootParameters[3] : DirectionalLight CBV (b1) - Pixel シェーダで参照
-	//   rootParameters[4] : Camera CBV (b2) - Pixel シェーダで参照
-	//   rootParameters[5] : PointLight CBV (b3) - Pixel シェーダで参照
-	//   rootParameters[6] : SpotLight CBV (b4) - Pixel シェーダで参照
-	//   rootParameters[7] : EnvironmentMap SRV (t1) via DescriptorTable - Pixel シェーダで参照
+	//   rootParameters[3] : Lighting CBV (b1) - ライトとカメラ（LightManager の共通バッファ）。Pixel シェーダで参照
+	//   rootParameters[4] : LightOverride 定数 (b2) - ライトの輝度の上書きの番号。Pixel シェーダで参照
+	//   rootParameters[5] : EnvironmentMap SRV (t1) via DescriptorTable - Pixel シェーダで参照
+	//   rootParameters[6..9] : クラスタの点光源・スポットライト・クラスタ・番号の StructuredBuffer (t2..t5) をルート SRV で - Pixel シェーダで参照
 	//
 	// - また、静的サンプラ（バイリニア）をルートシグネチャに含めている。
 	void Object3dCommon::RootSignatureInitialize()
 	{
-		HRESULT hr;
-
 		// ルートシグネチャ記述
 		D3D12_ROOT_SIGNATURE_DESC descriptionRootSignature{};
 		descriptionRootSignature.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
 
-		// ルートパラメータ配列（CBV x6 相当 + 2つの DescriptorTable）
+		// ルートパラメータ配列（CBV・ルート定数・ルート SRV + 2つの DescriptorTable）
 		D3D12_ROOT_PARAMETER rootParameters[kRootParameterCount] = {};
 		D3D12_DESCRIPTOR_RANGE descriptorRanges[kDescriptorRangeCount] = {};
 
@@ -96,20 +123,7 @@ namespace MyEngine {
 		descriptionRootSignature.NumParameters = kRootParameterCount;
 
 		// シリアライズしてルートシグネチャを生成
-		Microsoft::WRL::ComPtr<ID3DBlob> signatureBlob = nullptr;
-		Microsoft::WRL::ComPtr<ID3DBlob> errorBlob = nullptr;
-
-		hr = D3D12SerializeRootSignature(&descriptionRootSignature,
-			D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
-		if (FAILED(hr)) {
-			Logger::Log(reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
-			assert(false);
-		}
-
-		rootSignature_ = nullptr;
-		hr = dxCommon_->GetDevice()->CreateRootSignature(0, signatureBlob->GetBufferPointer(),
-			signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature_));
-		assert(SUCCEEDED(hr));
+		rootSignature_ = CreateRootSignature(descriptionRootSignature);
 
 		SetupInputLayout();
 		SetupBlendState();
@@ -125,13 +139,85 @@ namespace MyEngine {
 	{
 		RootSignatureInitialize();
 
-		HRESULT hr;
+		graphicsPipelineState_ = CreatePipelineState(rootSignature_.Get(), vertexShaderBlob_.Get());
+	}
+
+	// インスタンシング描画用のルートシグネチャと PSO の生成
+	// - ルートパラメータは通常の描画と同じものを作ってから、1 番（変換行列）を StructuredBuffer のテーブルに置き換え、
+	//   8 番に先頭インスタンスの番号を足す（SV_InstanceID は DrawInstanced の StartInstanceLocation を含まないため）。
+	// - 入力レイアウト・ブレンド・ラスタライザ・深度・ピクセルシェーダーは RootSignatureInitialize で用意したものを共有する。
+	void Object3dCommon::InstancingPipelineInitialize()
+	{
+		D3D12_ROOT_PARAMETER rootParameters[kInstancingRootParameterCount] = {};
+		D3D12_DESCRIPTOR_RANGE descriptorRanges[kInstancingDescriptorRangeCount] = {};
+		SetupRootParameters(rootParameters, descriptorRanges);
+
+		// DescriptorRange: インスタンスごとの変換行列 (t0) - Vertex
+		D3D12_DESCRIPTOR_RANGE& instanceRange = descriptorRanges[kDescriptorRangeCount];
+		instanceRange.BaseShaderRegister = kInstanceTransformationRegister;
+		instanceRange.NumDescriptors = 1;
+		instanceRange.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+		instanceRange.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+		// rootParameters[1] : Transformation StructuredBuffer Table (t0) - Vertex
+		rootParameters[kRootParameterIndexTransformation] = {};
+		rootParameters[kRootParameterIndexTransformation].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+		rootParameters[kRootParameterIndexTransformation].DescriptorTable.pDescriptorRanges = &instanceRange;
+		rootParameters[kRootParameterIndexTransformation].DescriptorTable.NumDescriptorRanges = 1;
+		rootParameters[kRootParameterIndexTransformation].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
+		// rootParameters[10] : 先頭インスタンスの番号 (b0 のルート定数) - Vertex
+		rootParameters[kRootParameterIndexInstanceOffset].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+		rootParameters[kRootParameterIndexInstanceOffset].Constants.ShaderRegister = kInstanceOffsetRegister;
+		rootParameters[kRootParameterIndexInstanceOffset].Constants.Num32BitValues = kInstanceOffsetConstantCount;
+		rootParameters[kRootParameterIndexInstanceOffset].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+
+		D3D12_STATIC_SAMPLER_DESC staticSamplers[kStaticSamplerCount] = {};
+		SetupStaticSamplers(staticSamplers);
+
+		D3D12_ROOT_SIGNATURE_DESC descriptionRootSignature{};
+		descriptionRootSignature.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+		descriptionRootSignature.pStaticSamplers = staticSamplers;
+		descriptionRootSignature.NumStaticSamplers = kStaticSamplerCount;
+		descriptionRootSignature.pParameters = rootParameters;
+		descriptionRootSignature.NumParameters = kInstancingRootParameterCount;
+		instancingRootSignature_ = CreateRootSignature(descriptionRootSignature);
+
+		instancingVertexShaderBlob_ = dxCommon_->CompileShader(kInstancingVertexShaderPath, kVertexShaderProfile);
+		assert(instancingVertexShaderBlob_ != nullptr);
+
+		instancingPipelineState_ = CreatePipelineState(instancingRootSignature_.Get(), instancingVertexShaderBlob_.Get());
+	}
+
+	// ===== ヘルパー関数 =====
+
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> Object3dCommon::CreateRootSignature(const D3D12_ROOT_SIGNATURE_DESC& description)
+	{
+		Microsoft::WRL::ComPtr<ID3DBlob> signatureBlob = nullptr;
+		Microsoft::WRL::ComPtr<ID3DBlob> errorBlob = nullptr;
+
+		HRESULT hr = D3D12SerializeRootSignature(&description,
+			D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
+		if (FAILED(hr)) {
+			Logger::Log(reinterpret_cast<char*>(errorBlob->GetBufferPointer()));
+			assert(false);
+		}
+
+		Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature = nullptr;
+		hr = dxCommon_->GetDevice()->CreateRootSignature(0, signatureBlob->GetBufferPointer(),
+			signatureBlob->GetBufferSize(), IID_PPV_ARGS(&rootSignature));
+		assert(SUCCEEDED(hr));
+		return rootSignature;
+	}
+
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> Object3dCommon::CreatePipelineState(ID3D12RootSignature* rootSignature, IDxcBlob* vertexShaderBlob)
+	{
 		D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsPipelineStateDesc{};
-		graphicsPipelineStateDesc.pRootSignature = rootSignature_.Get();
+		graphicsPipelineStateDesc.pRootSignature = rootSignature;
 		graphicsPipelineStateDesc.InputLayout = inputLayoutDesc_;
 		graphicsPipelineStateDesc.BlendState.RenderTarget[0] = blendDesc_;
 		graphicsPipelineStateDesc.RasterizerState = rasterizerDesc_;
-		graphicsPipelineStateDesc.VS = { vertexShaderBlob_->GetBufferPointer(), vertexShaderBlob_->GetBufferSize() };
+		graphicsPipelineStateDesc.VS = { vertexShaderBlob->GetBufferPointer(), vertexShaderBlob->GetBufferSize() };
 		graphicsPipelineStateDesc.PS = { pixelShaderBlob_->GetBufferPointer(), pixelShaderBlob_->GetBufferSize() };
 		graphicsPipelineStateDesc.DepthStencilState = depthStencilDesc_;
 		graphicsPipelineStateDesc.DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT;
@@ -141,12 +227,12 @@ namespace MyEngine {
 		graphicsPipelineStateDesc.SampleDesc.Count = 1;
 		graphicsPipelineStateDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
 
-		hr = dxCommon_->GetDevice()->CreateGraphicsPipelineState(&graphicsPipelineStateDesc, IID_PPV_ARGS(&graphicsPipelineState_));
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> pipelineState = nullptr;
+		HRESULT hr = dxCommon_->GetDevice()->CreateGraphicsPipelineState(&graphicsPipelineStateDesc, IID_PPV_ARGS(&pipelineState));
 		assert(SUCCEEDED(hr));
+		return pipelineState;
 	}
 
-	// ===== ヘルパー関数 =====
-
 	void Object3dCommon::SetupInputLayout()
 	{
 		inputElementDescs_[0].SemanticName = "POSITION";
@@ -226,31 +312,36 @@ namespace MyEngine {
 		rootParameters[kRootParameterIndexTexture].DescriptorTable.NumDescriptorRanges = 1;
 		rootParameters[kRootParameterIndexTexture].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
-		// rootParameters[3] : DirectionalLight CBV (b1) - Pixel
-		rootParameters[kRootParameterIndexDirectionalLight].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-		rootParameters[kRootParameterIndexDirectionalLight].Descriptor.ShaderRegister = kDirectionalLightRegister;
-		rootParameters[kRootParameterIndexDirectionalLight].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-
-		// rootParameters[4] : Camera CBV (b2) - Pixel
-		rootParameters[kRootParameterIndexCamera].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-		rootParameters[kRootParameterIndexCamera].Descriptor.ShaderRegister = kCameraRegister;
-		rootParameters[kRootParameterIndexCamera].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+		// rootParameters[3] : Lighting CBV (b1) - Pixel
+		rootParameters[kRootParameterIndexLighting].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+		rootParameters[kRootParameterIndexLighting].Descriptor.ShaderRegister = kLightingRegister;
+		rootParameters[kRootParameterIndexLighting].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
-		// rootParameters[5] : PointLight CBV (b3) - Pixel
-		rootParameters[kRootParameterIndexPointLight].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-		rootParameters[kRootParameterIndexPointLight].Descriptor.ShaderRegister = kPointLightRegister;
-		rootParameters[kRootParameterIndexPointLight].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+		// rootParameters[4] : LightOverride 定数 (b2) - Pixel
+		rootParameters[kRootParameterIndexLightOverride].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+		rootParameters[kRootParameterIndexLightOverride].Constants.ShaderRegister = kLightOverrideRegister;
+		rootParameters[kRootParameterIndexLightOverride].Constants.Num32BitValues = kLightOverrideConstantCount;
+		rootParameters[kRootParameterIndexLightOverride].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
 
-		// rootParameters[6] : SpotLight CBV (b4) - Pixel
-		rootParameters[kRootParameterIndexSpotLight].ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
-		rootParameters[kRootParameterIndexSpotLight].Descriptor.ShaderRegister = kSpotLightRegister;
-		rootParameters[kRootParameterIndexSpotLight].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-
-		// rootParameters[7] : EnvironmentMap SRV Table (t1) - Pixel
+		// rootParameters[5] : EnvironmentMap SRV Table (t1) - Pixel
 		rootParameters[kRootParameterIndexEnvironmentMap].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
 		rootParameters[kRootParameterIndexEnvironmentMap].DescriptorTable.pDescriptorRanges = &descriptorRanges[1];
 		rootParameters[kRootParameterIndexEnvironmentMap].DescriptorTable.NumDescriptorRanges = 1;
 		rootParameters[kRootParameterIndexEnvironmentMap].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+		// rootParameters[6..9] : クラスタのライトの StructuredBuffer (t2..t5) - Pixel
+		// 毎フレーム丸ごと書き換えるバッファなので、デスクリプタを作らずルート SRV で渡す
+		const uint32_t clusterParameterIndices[] = {
+			kRootParameterIndexClusterPointLights, kRootParameterIndexClusterSpotLights,
+			kRootParameterIndexClusters, kRootParameterIndexClusterLightIndices };
+		const uint32_t clusterRegisters[] = {
+			kClusterPointLightsRegister, kClusterSpotLightsRegister,
+			kClustersRegister, kClusterLightIndicesRegister };
+		for (uint32_t i = 0; i < _countof(clusterParameterIndices); i++) {
+			rootParameters[clusterParameterIndices[i]].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+			rootParameters[clusterParameterIndices[i]].Descriptor.ShaderRegister = clusterRegisters[i];
+			rootParameters[clusterParameterIndices[i]].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+		}
 	}
 
 	void Object3dCommon::SetupStaticSamplers(D3D12_STATIC_SAMPLER_DESC* staticSamplers)
@@ -16,7 +16,7 @@ namespace MyEngine {
 		constexpr uint32_t kInputElementCount = 3;
 
 		// ルートパラメータの数
-		constexpr uint32_t kRootParameterCount = 8;
+		constexpr uint32_t kRootParameterCount = 10;
 
 		// 静的サンプラの数
 		constexpr uint32_t kStaticSamplerCount = 1;
@@ -27,6 +27,7 @@ namespace MyEngine {
 		// シェーダーパス
 		constexpr const wchar_t* kVertexShaderPath = L"Resources/shaders/Object3d.VS.hlsl";
 		constexpr const wchar_t* kPixelShaderPath = L"Resources/shaders/Object3d.PS.hlsl";
+		constexpr const wchar_t* kInstancingVertexShaderPath = L"Resources/shaders/Object3dInstancing.VS.hlsl";
 		constexpr const wchar_t* kVertexShaderProfile = L"vs_6_0";
 		constexpr const wchar_t* kPixelShaderProfile = L"ps_6_0";
 
@@ -34,22 +35,38 @@ namespace MyEngine {
 		constexpr uint32_t kRootParameterIndexMaterial = 0;
 		constexpr uint32_t kRootParameterIndexTransformation = 1;
 		constexpr uint32_t kRootParameterIndexTexture = 2;
-		constexpr uint32_t kRootParameterIndexDirectionalLight = 3;
-		constexpr uint32_t kRootParameterIndexCamera = 4;
-		constexpr uint32_t kRootParameterIndexPointLight = 5;
-		constexpr uint32_t kRootParameterIndexSpotLight = 6;
-		constexpr uint32_t kRootParameterIndexEnvironmentMap = 7;
+		constexpr uint32_t kRootParameterIndexLighting = 3;
+		constexpr uint32_t kRootParameterIndexLightOverride = 4;
+		constexpr uint32_t kRootParameterIndexEnvironmentMap = 5;
+		constexpr uint32_t kRootParameterIndexClusterPointLights = 6;
+		constexpr uint32_t kRootParameterIndexClusterSpotLights = 7;
+		constexpr uint32_t kRootParameterIndexClusters = 8;
+		constexpr uint32_t kRootParameterIndexClusterLightIndices = 9;
+
+		// ライトの輝度の上書きの番号（ルート定数）
+		constexpr uint32_t kLightOverrideConstantCount = 1;
+
+		// インスタンシング描画用のルートシグネチャ
+		// 1 番は変換行列の StructuredBuffer（t0）のテーブルに置き換え、10 番に先頭インスタンスの番号（b0 のルート定数）を足す
+		constexpr uint32_t kInstancingRootParameterCount = 11;
+		constexpr uint32_t kInstancingDescriptorRangeCount = 3;
+		constexpr uint32_t kRootParameterIndexInstanceOffset = 10;
+		constexpr uint32_t kInstanceOffsetConstantCount = 1;
 
 		// シェーダーレジスタ番号
 		constexpr uint32_t kMaterialRegister = 0;
 		constexpr uint32_t kTransformationRegister = 0;
 		constexpr uint32_t kTextureRegister = 0;
-		constexpr uint32_t kDirectionalLightRegister = 1;
-		constexpr uint32_t kCameraRegister = 2;
-		constexpr uint32_t kPointLightRegister = 3;
-		constexpr uint32_t kSpotLightRegister = 4;
+		constexpr uint32_t kLightingRegister = 1;
+		constexpr uint32_t kLightOverrideRegister = 2;
 		constexpr uint32_t kEnvironmentMapRegister = 1;
+		constexpr uint32_t kClusterPointLightsRegister = 2;
+		constexpr uint32_t kClusterSpotLightsRegister = 3;
+		constexpr uint32_t kClustersRegister = 4;
+		constexpr uint32_t kClusterLightIndicesRegister = 5;
 		constexpr uint32_t kSamplerRegister = 0;
+		constexpr uint32_t kInstanceTransformationRegister = 0;
+		constexpr uint32_t kInstanceOffsetRegister = 0;
 	}
 
 	/// <summary>
@@ -72,9 +89,12 @@ namespace MyEngine {
 		// 初期化
 		void Initialize(SrvManager* srvManager);
 
-		// 共通描画設定
+		// 共通描画設定（ライトとカメラの定数バッファもここで設定する）
 		void DrawSettings();
 
+		// インスタンシング描画の共通設定（Object3dRenderQueue がまとめて描くときに使う）
+		void DrawSettingsInstancing();
+
 		// セッター
 		void SetDefaultCamera(Camera* camera) { defaultCamera_ = camera; }
 
@@ -89,6 +109,15 @@ namespace MyEngine {
 		// グラフィックスパイプラインの初期化
 		void GraphicsPipelineInitialize();
 
+		// インスタンシング描画用のルートシグネチャと PSO の初期化
+		void InstancingPipelineInitialize();
+
+		// ルートシグネチャの生成（シリアライズして作成する）
+		Microsoft::WRL::ComPtr<ID3D12RootSignature> CreateRootSignature(const D3D12_ROOT_SIGNATURE_DESC& description);
+
+		// PSO の生成（頂点シェーダーとルートシグネチャ以外の設定は共通）
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> CreatePipelineState(ID3D12RootSignature* rootSignature, IDxcBlob* vertexShaderBlob);
+
 		// 入力レイアウトの設定
 		void SetupInputLayout();
 
@@ -110,6 +139,9 @@ namespace MyEngine {
 		// 静的サンプラの設定
 		void SetupStaticSamplers(D3D12_STATIC_SAMPLER_DESC* staticSamplers);
 
+		// ライトとクラスタのライトをコマンドリストに設定（DrawSettings / DrawSettingsInstancing で共通）
+		void SetLightingRootParameters();
+
 		// シングルトンインスタンス
 		static std::shared_ptr<Object3dCommon> sInstance_;
 
@@ -139,6 +171,11 @@ namespace MyEngine {
 		// グラフィックスパイプライン
 		Microsoft::WRL::ComPtr<ID3D12PipelineState> graphicsPipelineState_ = nullptr;
 
+		// インスタンシング描画用（ピクセルシェーダーと入力レイアウトは通常の描画と共通）
+		Microsoft::WRL::ComPtr<ID3D12RootSignature> instancingRootSignature_ = nullptr;
+		Microsoft::WRL::ComPtr<IDxcBlob> instancingVertexShaderBlob_;
+		Microsoft::WRL::ComPtr<ID3D12PipelineState> instancingPipelineState_ = nullptr;
+
 		// デフォルトカメラ
 		Camera* defaultCamera_ = nullptr;
 
@@ -0,0 +1,216 @@
+#include "Object3dRenderQueue.h"
+#include "Object3d.h"
+#include "Object3dCommon.h"
+#include "Camera.h"
+#include "DirectXCommon.h"
+#include <SrvManager.h>
+#include <ResourceManager.h>
+#include <cassert>
+#include <cstring>
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif
+
+//
+// Object3dRenderQueue
+// - Object3d::Draw は記録中（Begin ～ Flush）だとコマンドを積まず、ここに積むだけにする。
+// - 並べ替えと状態の省略は RenderCommandRecorder に任せる。キーは
+//   (不透明レイヤー, パイプライン, バッチの状態, カメラからの距離) で、このクラスは RenderCommandSink として結果を受け取る。
+//   * パイプライン：インスタンシング用か、モデルを重ねて描くため 1 つずつ描く通常のものか。切り替えは最大 2 回。
+//   * マテリアル：バッチの状態（メッシュ・テクスチャ・マテリアル・ライトの組）の番号。変わったらまとめている描画を確定する。
+//     メッシュの番号だけだと、同じメッシュで色やライトが違うものが距離順に交互に並び、その度に DrawInstanced が区切られる。
+//     状態の組ごとに番号を振ってから距離で並べるので、同じ状態のものは必ず連続し、状態の数だけの DrawInstanced になる。
+//   * 番号はハッシュから振るので、万一ハッシュが衝突しても Draw で HasSameBatchState を確かめ、違えばそこで区切る。
+// - 変換行列は WorldTransform の CPU 側の写しを StructuredBuffer に詰め、先頭の番号をルート定数で渡す（ParticleManager と同じ形）。
+// - 不透明・深度テスト有りの描画だけなので、並べ替えで描画順が変わっても結果は変わらない。
+// - インスタンスバッファが足りなくなった分は、最後に通常の Object3d::Draw で 1 つずつ描く。
+//
+namespace MyEngine {
+	using namespace Object3dRenderQueueConstants;
+	using namespace Object3dCommonConstants;
+
+	Object3dRenderQueue* Object3dRenderQueue::GetInstance()
+	{
+		static Object3dRenderQueue instance;
+		return &instance;
+	}
+
+	void Object3dRenderQueue::Initialize(SrvManager* srvManager)
+	{
+		srvManager_ = srvManager;
+
+		// インスタンスバッファ作成
+		instanceResource_ = ResourceManager::CreateBufferResource(
+			Object3dCommon::GetInstance()->GetDxCommon()->GetDevice().Get(),
+			sizeof(WorldTransform::TransformationMatrix) * kMaxInstanceCount);
+		instanceResource_->Map(0, nullptr, reinterpret_cast<void**>(&instanceData_));
+
+		// インスタンシング用SRVの生成
+		srvIndex_ = srvManager_->Allocate();
+		srvManager_->CreateSRVforStructuredBuffer(
+			srvIndex_,
+			instanceResource_.Get(),
+			kMaxInstanceCount,
+			sizeof(WorldTransform::TransformationMatrix));
+	}
+
+	void Object3dRenderQueue::BeginFrame()
+	{
+		instanceCursor_ = 0;
+		lastStats_ = stats_;
+		lastDrawCallCount_ = drawCallCount_;
+		stats_ = {};
+		drawCallCount_ = 0;
+	}
+
+	void Object3dRenderQueue::Begin(const Camera* camera)
+	{
+		assert(!isRecording_ && "Object3dRenderQueue::Begin called twice without Flush");
+		objects_.clear();
+		recorder_.Reset();
+		batchStateIds_.clear();
+		camera_ = camera;
+		isRecording_ = true;
+	}
+
+	void Object3dRenderQueue::Add(Object3d* object)
+	{
+		assert(isRecording_);
+
+		// カメラからの距離の 2 乗（平方根を取らなくても大小は同じ）
+		float distanceSq = 0.0f;
+		if (camera_) {
+			const Affine3x4& world = object->GetWorldTransform().GetAffineMatWorld();
+			const Vector3& eye = camera_->GetTranslate();
+			const float dx = world.m[3][0] - eye.x;
+			const float dy = world.m[3][1] - eye.y;
+			const float dz = world.m[3][2] - eye.z;
+			distanceSq = dx * dx + dy * dy + dz * dz;
+		}
+
+		const uint32_t pipeline = object->HasModel() ? kPipelineImmediate : kPipelineInstancing;
+		recorder_.Record(RenderSortKey::kLayerOpaque, pipeline, FindOrAddBatchStateId(*object),
+			RenderSortKey::EncodeDepth(distanceSq), static_cast<uint32_t>(objects_.size()));
+		objects_.push_back(object);
+	}
+
+	void Object3dRenderQueue::Flush()
+	{
+		assert(isRecording_);
+		isRecording_ = false;
+		if (objects_.empty()) {
+			return;
+		}
+
+		recorder_.Sort();
+
+		// ここから先の Object3d::Draw は記録中ではないのでその場で描かれる
+		overflowObjects_.clear();
+		boundPipeline_ = kPipelineImmediate;
+		const RenderSubmitStats stats = recorder_.Submit(*this);
+		FlushBatch();
+
+		stats_.commandCount += stats.commandCount;
+		stats_.pipelineBindCount += stats.pipelineBindCount;
+		stats_.materialBindCount += stats.materialBindCount;
+		stats_.skippedPipelineBinds += stats.skippedPipelineBinds;
+		stats_.skippedMaterialBinds += stats.skippedMaterialBinds;
+
+		// 呼び出し側には通常のパイプラインで返す（足りなかった分もここで描く）
+		if (boundPipeline_ != kPipelineImmediate || !overflowObjects_.empty()) {
+			Object3dCommon::GetInstance()->DrawSettings();
+		}
+		for (Object3d* object : overflowObjects_) {
+			object->Draw();
+			++drawCallCount_;
+		}
+	}
+
+	void Object3dRenderQueue::DrawImGui() const
+	{
+#ifdef USE_IMGUI
+		ImGui::Text("Object3d draws: %u  (submitted %u)", lastDrawCallCount_, lastStats_.commandCount);
+		ImGui::Text("  pipeline binds %u (skipped %u)  batch state binds %u (skipped %u)",
+			lastStats_.pipelineBindCount, lastStats_.skippedPipelineBinds,
+			lastStats_.materialBindCount, lastStats_.skippedMaterialBinds);
+#endif
+	}
+
+	// ===== RenderCommandSink =====
+
+	void Object3dRenderQueue::BindPipeline(uint32_t pipeline)
+	{
+		FlushBatch();
+		boundPipeline_ = pipeline;
+
+		Object3dCommon* common = Object3dCommon::GetInstance().get();
+		if (pipeline == kPipelineInstancing) {
+			common->DrawSettingsInstancing();
+			common->GetDxCommon()->GetCommandList()->SetGraphicsRootDescriptorTable(
+				kRootParameterIndexTransformation, srvManager_->GetGPUDescriptorHandle(srvIndex_));
+		}
+		else {
+			common->DrawSettings();
+		}
+	}
+
+	void Object3dRenderQueue::BindMaterial([[maybe_unused]] uint32_t material)
+	{
+		FlushBatch();
+	}
+
+	void Object3dRenderQueue::Draw(uint32_t payload)
+	{
+		Object3d* object = objects_[payload];
+
+		// モデルを重ねて描くものはその場で描く
+		if (boundPipeline_ == kPipelineImmediate) {
+			object->Draw();
+			++drawCallCount_;
+			return;
+		}
+
+		// 状態が違えばそこで区切る
+		if (batchCount_ > 0 && !batchFirst_->HasSameBatchState(*object)) {
+			FlushBatch();
+		}
+		if (instanceCursor_ >= kMaxInstanceCount) {
+			overflowObjects_.push_back(object);
+			return;
+		}
+
+		// 変換行列を詰める
+		if (batchCount_ == 0) {
+			batchFirst_ = object;
+			batchOffset_ = instanceCursor_;
+		}
+		std::memcpy(&instanceData_[instanceCursor_++], &object->GetWorldTransform().GetTransformationMatrix(),
+			sizeof(WorldTransform::TransformationMatrix));
+		++batchCount_;
+	}
+
+	void Object3dRenderQueue::FlushBatch()
+	{
+		if (batchCount_ == 0) {
+			return;
+		}
+
+		// 区間の状態は先頭のものを 1 回だけ設定する
+		auto* commandList = Object3dCommon::GetInstance()->GetDxCommon()->GetCommandList();
+		batchFirst_->SetBatchState();
+		commandList->SetGraphicsRoot32BitConstant(kRootParameterIndexInstanceOffset, batchOffset_, 0);
+		commandList->DrawInstanced(batchFirst_->GetVertexCount(), batchCount_, 0, 0);
+		++drawCallCount_;
+
+		batchFirst_ = nullptr;
+		batchCount_ = 0;
+	}
+
+	uint32_t Object3dRenderQueue::FindOrAddBatchStateId(const Object3d& object)
+	{
+		auto [it, inserted] = batchStateIds_.try_emplace(object.GetBatchStateHash(), static_cast<uint32_t>(batchStateIds_.size()));
+		// 並べ替えキーのマテリアル（24 ビット）に収まること
+		assert(it->second <= RenderSortKey::kMaterialMask && "Object3dRenderQueue: too many batch states in one Begin/Flush");
+		return it->second;
+	}
+}
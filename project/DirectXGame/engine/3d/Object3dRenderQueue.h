@@ -0,0 +1,134 @@
+#pragma once
+#include <WorldTransform.h>
+#include <RenderCommandRecorder.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <wrl.h>
+#include <d3d12.h>
+
+namespace MyEngine {
+	// 前方宣言
+	class Object3d;
+	class Camera;
+	class SrvManager;
+
+	// Object3dRenderQueue用の定数
+	namespace Object3dRenderQueueConstants {
+		// 1 フレームでインスタンシング描画できる数（変換行列 192 バイト × この数の StructuredBuffer を 1 つ持つ）
+		constexpr uint32_t kMaxInstanceCount = 1024;
+
+		// 並べ替えキーのパイプライン（インスタンシング描画を先に、モデルを重ねて描くものを後に描く）
+		constexpr uint32_t kPipelineInstancing = 0;
+		constexpr uint32_t kPipelineImmediate = 1;
+	}
+
+	/// <summary>
+	/// Object3d の描画キュー（メッシュ・テクスチャ・マテリアル・ライトが同じ描画をまとめてインスタンシング描画する）
+	/// </summary>
+	class Object3dRenderQueue : public RenderCommandSink
+	{
+	public:
+		/*------メンバ関数------*/
+
+		// シングルトンインスタンス
+		static Object3dRenderQueue* GetInstance();
+
+		// コンストラクタ・デストラクタ
+		Object3dRenderQueue() = default;
+		~Object3dRenderQueue() override = default;
+
+		// コピー禁止
+		Object3dRenderQueue(const Object3dRenderQueue&) = delete;
+		Object3dRenderQueue& operator=(const Object3dRenderQueue&) = delete;
+
+		// 初期化（インスタンスごとの変換行列のバッファと SRV を作る）
+		void Initialize(SrvManager* srvManager);
+
+		// フレームの開始（インスタンスバッファの書き込み位置と統計を戻す）
+		void BeginFrame();
+
+		// 記録の開始（この間の Object3d::Draw はコマンドを積まずにキューに積む）
+		// camera を渡すと同じ状態の中を手前から描く（深度テストで奥のピクセルを省く）
+		// 呼ぶ前に Object3dCommon::DrawSettings でデスクリプタヒープを設定しておくこと
+		void Begin(const Camera* camera = nullptr);
+
+		// キューに積む
+		void Add(Object3d* object);
+
+		// 並べ替えてまとめ、コマンドを積む（終わると記録を終了し、通常の Object3d のパイプラインに戻す）
+		void Flush();
+
+		// ImGui で直前のフレームの統計を表示する
+		void DrawImGui() const;
+
+		/*------ゲッター------*/
+
+		bool IsRecording() const { return isRecording_; }
+		uint32_t GetSubmittedCount() const { return lastStats_.commandCount; }
+		uint32_t GetDrawCallCount() const { return lastDrawCallCount_; }
+
+	private:
+		/*------RenderCommandSink------*/
+
+		// パイプラインの切り替え（インスタンシング用か通常か）
+		void BindPipeline(uint32_t pipeline) override;
+
+		// マテリアル（バッチの状態）の切り替え（まとめている途中の描画を確定する）
+		void BindMaterial(uint32_t material) override;
+
+		// 1 つ分の描画（インスタンシング用のときは変換行列を詰めるだけで、状態が変わるまで描画は遅らせる）
+		void Draw(uint32_t payload) override;
+
+		/*------メンバ関数------*/
+
+		// まとめている描画を 1 回の DrawInstanced にする
+		void FlushBatch();
+
+		// バッチの状態の番号（このフレームで初めて見た状態から 0, 1, 2, ... と振る）
+		uint32_t FindOrAddBatchStateId(const Object3d& object);
+
+		/*------メンバ変数------*/
+
+		// 積まれた描画（payload はこの配列の番号）
+		std::vector<Object3d*> objects_;
+		RenderCommandRecorder recorder_;
+
+		// Object3d::GetBatchStateHash からバッチの状態の番号への対応（Begin で空にする）
+		std::unordered_map<uint64_t, uint32_t> batchStateIds_;
+
+		// インスタンスバッファが足りずに通常の描画に回すもの
+		std::vector<Object3d*> overflowObjects_;
+
+		// 記録中か
+		bool isRecording_ = false;
+
+		// 手前から並べるためのカメラ
+		const Camera* camera_ = nullptr;
+
+		// Submit 中に設定されているパイプライン
+		uint32_t boundPipeline_ = Object3dRenderQueueConstants::kPipelineImmediate;
+
+		// まとめている途中の描画（状態は先頭のものを使う）
+		Object3d* batchFirst_ = nullptr;
+		uint32_t batchOffset_ = 0;
+		uint32_t batchCount_ = 0;
+
+		// インスタンスごとの変換行列（Upload ヒープ。GPU は毎フレームの終わりに待つので 1 つを使い回す）
+		Microsoft::WRL::ComPtr<ID3D12Resource> instanceResource_;
+		WorldTransform::TransformationMatrix* instanceData_ = nullptr;
+		uint32_t srvIndex_ = 0;
+
+		// このフレームで次に書き込むインスタンスの位置（1 フレームに複数回 Flush しても前の分を上書きしない）
+		uint32_t instanceCursor_ = 0;
+
+		// 統計（このフレームの途中の値と、直前のフレームの値）
+		RenderSubmitStats stats_;
+		uint32_t drawCallCount_ = 0;
+		RenderSubmitStats lastStats_;
+		uint32_t lastDrawCallCount_ = 0;
+
+		// SrvManager
+		SrvManager* srvManager_ = nullptr;
+	};
+}
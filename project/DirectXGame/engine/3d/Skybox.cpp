@@ -23,6 +23,11 @@ namespace MyEngine {
 	using namespace SkyboxConstants;
 	using namespace Math;
 
+	Skybox::~Skybox()
+	{
+		TextureManager::GetInstance()->ReleaseTexture(textureReference_);
+	}
+
 	void Skybox::Initialize(const std::string& texturePath)
 	{
 		// 入力:
@@ -92,10 +97,12 @@ namespace MyEngine {
 
 	void Skybox::CreateTexture(const std::string& texturePath)
 	{
-		// TextureManager経由で SRV を取得して保持する
+		// TextureManager経由で SRV を取得して保持する（参照はデストラクタで手放す）
 		TextureManager* texMgr = TextureManager::GetInstance().get();
-		texMgr->LoadTexture(texturePath);
-		textureHandle_ = texMgr->GetSrvHandleGPU(texturePath);
+		TextureHandle previousReference = textureReference_;
+		textureReference_ = texMgr->LoadTexture(texturePath);
+		texMgr->ReleaseTexture(previousReference);
+		textureHandle_ = texMgr->GetSrvHandleGPU(textureReference_);
 	}
 
 	void Skybox::SetCamera(Camera* camera)
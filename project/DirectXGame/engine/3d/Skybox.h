@@ -7,6 +7,7 @@
 #include <Vector2.h>
 #include <Vector4.h>
 #include <string>
+#include <TextureManager.h>
 
 namespace MyEngine {
 	// Skybox用の定数
@@ -69,6 +70,9 @@ namespace MyEngine {
 			float padding[3]; // パディング
 		};
 
+		// デストラクタ（テクスチャの参照を手放す）
+		~Skybox();
+
 		// 初期化
 		void Initialize(const std::string& texturePath);
 
@@ -128,6 +132,7 @@ namespace MyEngine {
 		// テクスチャ
 		Microsoft::WRL::ComPtr<ID3D12Resource> textureResource_;
 		D3D12_GPU_DESCRIPTOR_HANDLE textureHandle_{};
+		TextureHandle textureReference_{};
 
 		// マテリアルリソース
 		Microsoft::WRL::ComPtr<ID3D12Resource> materialResource_;
@@ -1,6 +1,8 @@
 #include "Audio.h"
+#include "WaveFile.h"
+#include "AllocationCounter.h"
+#include "LogFormat.h"
 #include <cassert>
-#include <cstring>
 
 //
 // Audio: XAudio2 を使った簡易オーディオユーティリティ
@@ -9,7 +11,15 @@
 // - 注意:
 //   - SoundLoadWave は読み込んだ PCM データを std::vector に格納する。
 //     呼び出し側は使い終わったら SoundUnload を呼んでメモリを解放することができる。
-//   - 実装は簡易的な WAV パーサであり、すべての WAV 形式を扱えるわけではない（基本的な PCM のみ想定）。
+//   - LoadSound / RegisterSound はファイルパスをキーにしたキャッシュを使う（AssetLoader の先読み結果もここに入る）。
+//   - PlayStream は WAV を全体読み込みせず、AudioStream がバックグラウンドで一定サイズずつ読みながら再生する（BGM 向け）。
+//   - WAV の解析は WaveFile（メモリマップ＋ RiffReader）が行い、チャンクの並びや LIST / bext / cue などの有無は問わない。
+//     対応形式は PCM16 / PCM24 / float32 のモノラル・ステレオ。
+//   - SoundPlayWave は VoicePool のボイスを使い回す（再生のたびにボイスを作って破棄しないままにしない）。
+//     ボイス数の上限・同じサウンドの同時再生数を超えた場合は、古い音や優先度の低い音を止めて鳴らす。
+//   - InitializeSoftware で初期化すると XAudio2 の代わりに SoftwareMixer がボイスを合成し、シンク（無出力 / WAV）へ書き出す。
+//     VoicePool からはバックエンドが変わるだけなので、SoundPlayWave 以降の呼び出し側は同じまま動く（ストリーム再生は非対応）。
+//     RenderToWaveFile（"--render-audio"）はこの経路で WAV を合成して書き出すヘッドレス実行の入り口。
 //   - スレッドセーフではない（呼び出しはメインスレッド前提）。
 //
 namespace MyEngine {
@@ -32,6 +42,60 @@ namespace MyEngine {
 		// 副作用: xAudio2_ と masterVoice_ をメンバに保存する
 		InitializeXAudio2();
 		CreateMasteringVoice();
+
+		// 効果音用のボイスプール
+		voiceBackend_ = std::make_unique<XAudio2VoiceBackend>(xAudio2_.Get());
+		voicePool_.Initialize(voiceBackend_.get());
+	}
+
+	void Audio::InitializeSoftware(AudioSinkBase* sink, uint32_t sampleRate)
+	{
+		// XAudio2 は作らず、ソフトウェアミキサーをボイスプールのバックエンドにする
+		auto softwareMixer = std::make_unique<SoftwareMixer>();
+		softwareMixer->Initialize(sink, sampleRate);
+		softwareMixer_ = softwareMixer.get();
+		voiceBackend_ = std::move(softwareMixer);
+		voicePool_.Initialize(voiceBackend_.get());
+	}
+
+	void Audio::RenderSoftware(uint32_t frameCount)
+	{
+		assert(softwareMixer_ != nullptr && "Audio is not initialized with the software mixer!");
+		softwareMixer_->Render(frameCount);
+	}
+
+	bool Audio::RenderToWaveFile(const std::string& outputPath, const std::vector<std::string>& inputPaths)
+	{
+		WavFileAudioSink sink;
+		if (!sink.Open(outputPath, SoftwareMixerConstants::kDefaultSampleRate)) {
+			Logger::LogFormat("[Audio] failed to open {}\n", outputPath);
+			return false;
+		}
+
+		// シングルトンとは別のインスタンスで合成する（XAudio2 は作らない）
+		Audio audio;
+		audio.InitializeSoftware(&sink);
+		for (const std::string& inputPath : inputPaths) {
+			audio.SoundPlayWave(*audio.LoadSound(inputPath));
+		}
+
+		// すべてのボイスが鳴り終わるまで合成する
+		uint64_t renderedFrames = 0;
+		double mixMicroseconds = 0.0;
+		audio.voicePool_.Reclaim();
+		while (audio.voicePool_.GetActiveVoiceCount() > 0) {
+			audio.RenderSoftware(kRenderBlockFrames);
+			audio.voicePool_.Reclaim();
+			renderedFrames += kRenderBlockFrames;
+			mixMicroseconds += audio.softwareMixer_->GetLastMixMicroseconds();
+		}
+
+		audio.Finalize();
+		sink.Close();
+
+		Logger::LogFormat("[Audio] rendered {} frames from {} file(s) to {} (mix {:.2f} ms)\n",
+			renderedFrames, inputPaths.size(), outputPath, mixMicroseconds / 1000.0);
+		return true;
 	}
 
 	SoundData Audio::SoundLoadWave(const char* filename)
@@ -39,164 +103,139 @@ namespace MyEngine {
 		// WAV ファイルを読み込み、SoundData を返す
 		// - filename: 読み込む WAV ファイルのパス（C 文字列）
 		// - 戻り値: 読み込まれた PCM データとフォーマットを含む SoundData
-		// - エラー処理: ファイル形式が不正なら assert で停止する（デバッグビルド向け）
-		//
-		// 実装メモ:
-		// - RIFF / WAVE / fmt / data チャンクのみを順次処理する
-		// - "JUNK" チャンクを見つけた場合はスキップする実装を含む
 		// - 読み込んだバッファは呼び出し元で不要になったら SoundUnload() を呼び解放できる
+		return DecodeWave(filename);
+	}
 
-		// ファイルオープン
-		std::ifstream file;
-		file.open(filename, std::ios::binary);
-		assert(file.is_open());
-
-		// RIFF ヘッダ読み取り
-		RiffHeader riff;
-		ReadRiffHeader(file, riff);
-
-		// fmt チャンクの読み込み
-		FormatChunk format{};
-		ReadFormatChunk(file, format);
-
-		// data チャンクの読み込み（JUNK をスキップする場合あり）
-		ChunkHeader data;
-		ReadDataChunk(file, data);
+	SoundData Audio::DecodeWave(const char* filename)
+	{
+		// - エラー処理: ファイル形式が不正・対応外なら assert で停止する（デバッグビルド向け）
+		//
+		// 実装メモ:
+		// - ファイルをメモリマップし、全チャンクを索引化して fmt / data を取り出す（チャンクの順序は問わない）
+		// - 波形はマップ先から SoundData に 1 回だけコピーする（再生中にマップ先のページフォルトを起こさないため）
+		// - メンバを参照しないため AssetLoader のワーカースレッドから呼び出せる
 
-		// 波形データ本体を読み込む
-		auto pBuffer = ReadWaveData(file, data.size);
+		MemoryTagScope memoryTag(MemoryTag::Audio);
 
-		// ファイルを閉じる
-		file.close();
+		WaveFile waveFile;
+		const bool isOpened = waveFile.Open(filename);
+		assert(isOpened && "Failed to open or unsupported wave file!");
+		(void)isOpened;
 
 		// SoundData を構築して返す
+		const std::span<const uint8_t> samples = waveFile.GetSamples();
 		SoundData soundData = {};
-		soundData.wfex = format.fmt;
-		soundData.pBuffer = std::move(pBuffer);
-		soundData.bufferSize = data.size;
+		soundData.format = waveFile.GetFormat();
+		soundData.wfex = MakeWaveFormatEx(soundData.format);
+		soundData.pBuffer.assign(samples.begin(), samples.end());
+		soundData.bufferSize = static_cast<uint32_t>(samples.size());
 
 		return soundData;
 	}
 
-	void Audio::SoundUnload(SoundData* soundData)
+	const SoundData* Audio::LoadSound(const std::string& filePath)
 	{
-		// SoundData が保持するバッファを解放し、構造体を初期化する
-		soundData->pBuffer.clear();
-		soundData->pBuffer.shrink_to_fit();
-		soundData->bufferSize = 0;
-		soundData->wfex = {};
+		// 未読み込みならその場でデコードして登録（AssetLoader で先読みしていればキャッシュを返すだけ）
+		if (!IsSoundLoaded(filePath)) {
+			RegisterSound(filePath, DecodeWave(filePath.c_str()));
+		}
+		return &sounds_.at(filePath);
 	}
 
-	void Audio::SoundPlayWave(const SoundData& soundData)
+	void Audio::RegisterSound(const std::string& filePath, SoundData soundData)
 	{
-		// SoundData のフォーマット情報を使って SourceVoice を作成し再生する
-		// - 再生完了後のリソース破棄（SourceVoice の DestroyVoice）は現在行っていないため、
-		//   長時間または多数のサウンドを再生する用途では追加の管理が必要
-		IXAudio2SourceVoice* pSourceVoice = CreateSourceVoice(soundData.wfex);
-		PlaySourceVoice(pSourceVoice, soundData);
+		// 二重登録はしない（先に登録された方を使う）
+		MemoryTagScope memoryTag(MemoryTag::Audio);
+		sounds_.try_emplace(filePath, std::move(soundData));
 	}
 
-	void Audio::Finalize()
+	void Audio::UnloadSound(const std::string& filePath)
 	{
-		// 終了処理: マスターボイスの破棄と XAudio2 オブジェクトの解放
-		if (masterVoice_) {
-			masterVoice_->DestroyVoice();
-			masterVoice_ = nullptr;
-		}
-		if (xAudio2_) {
-			xAudio2_.Reset();
+		// 再生中のボイスがバッファを参照しているため、先に止める
+		auto it = sounds_.find(filePath);
+		if (it == sounds_.end()) {
+			return;
 		}
+		voicePool_.StopSound(&it->second);
+		sounds_.erase(it);
 	}
 
-	// ===== ヘルパー関数 =====
-
-	void Audio::InitializeXAudio2()
-	{
-		result_ = XAudio2Create(&xAudio2_, kXAudio2Flags, kDefaultProcessor);
-		assert(SUCCEEDED(result_));
-	}
-
-	void Audio::CreateMasteringVoice()
+	void Audio::SoundUnload(SoundData* soundData)
 	{
-		// マスターボイスの作成（出力デバイスとの接続）
-		result_ = xAudio2_->CreateMasteringVoice(&masterVoice_);
-		assert(SUCCEEDED(result_));
+		// 再生中のボイスを止めてから、SoundData が保持するバッファを解放し、構造体を初期化する
+		voicePool_.StopSound(soundData);
+		soundData->pBuffer.clear();
+		soundData->pBuffer.shrink_to_fit();
+		soundData->bufferSize = 0;
+		soundData->wfex = {};
+		soundData->format = {};
 	}
 
-	void Audio::ReadRiffHeader(std::ifstream& file, RiffHeader& riff)
+	bool Audio::SoundPlayWave(const SoundData& soundData, int32_t priority, uint32_t maxInstances)
 	{
-		file.read(reinterpret_cast<char*>(&riff), sizeof(riff));
-
-		// チャンクID が "RIFF" であることを確認
-		assert(ValidateChunkId(riff.chunk.id, kRiffChunkId));
-
-		// タイプが "WAVE" であることを確認
-		assert(ValidateChunkId(riff.type, kWaveType));
+		// 再生し終えたボイスはプールが回収して同じフォーマットの再生に使い回す
+		VoicePlayRequest request{};
+		request.soundKey = &soundData;
+		request.format = soundData.format;
+		request.samples = std::span<const uint8_t>(soundData.pBuffer.data(), soundData.bufferSize);
+		request.priority = priority;
+		request.maxInstances = maxInstances;
+		return voicePool_.Play(request);
 	}
 
-	void Audio::ReadFormatChunk(std::ifstream& file, FormatChunk& format)
+	AudioStream* Audio::PlayStream(const std::string& filePath, bool isLoop)
 	{
-		file.read(reinterpret_cast<char*>(&format), sizeof(ChunkHeader));
-
-		assert(ValidateChunkId(format.chunk.id, kFmtChunkId));
+		// 再生し終えたストリームを片付ける
+		std::erase_if(streams_, [](const std::unique_ptr<AudioStream>& stream) { return !stream->IsPlaying(); });
 
-		// fmt 本体を読み込む（可変長なので chunk.size を使う）
-		assert(format.chunk.size <= sizeof(format.fmt));
-		file.read(reinterpret_cast<char*>(&format.fmt), format.chunk.size);
-	}
-
-	void Audio::ReadDataChunk(std::ifstream& file, ChunkHeader& data)
-	{
-		file.read(reinterpret_cast<char*>(&data), sizeof(data));
+		assert(xAudio2_ && "Streaming requires XAudio2!");
 
-		// "JUNK" チャンクを検出したらスキップ
-		SkipJunkChunk(file, data);
+		MemoryTagScope memoryTag(MemoryTag::Audio);
+		auto stream = std::make_unique<AudioStream>();
+		stream->Initialize(xAudio2_.Get(), filePath, isLoop);
+		stream->Play();
 
-		// data チャンクであることを確認
-		assert(ValidateChunkId(data.id, kDataChunkId));
+		streams_.push_back(std::move(stream));
+		return streams_.back().get();
 	}
 
-	std::vector<BYTE> Audio::ReadWaveData(std::ifstream& file, uint32_t size)
+	void Audio::StopStream(AudioStream* stream)
 	{
-		std::vector<BYTE> pBuffer(size);
-		file.read(reinterpret_cast<char*>(pBuffer.data()), size);
-		return pBuffer;
+		// 破棄時にスレッドの停止とボイスの破棄が行われる
+		std::erase_if(streams_, [stream](const std::unique_ptr<AudioStream>& element) { return element.get() == stream; });
 	}
 
-	bool Audio::ValidateChunkId(const char* chunkId, const char* expectedId) const
+	void Audio::Finalize()
 	{
-		return std::strncmp(chunkId, expectedId, kChunkIdSize) == 0;
-	}
+		// ストリームとボイスプールはボイスを持つため、マスターボイスより先に破棄する
+		streams_.clear();
+		voicePool_.Finalize();
+		voiceBackend_.reset();
+		softwareMixer_ = nullptr;
 
-	void Audio::SkipJunkChunk(std::ifstream& file, ChunkHeader& data)
-	{
-		if (ValidateChunkId(data.id, kJunkChunkId)) {
-			file.seekg(data.size, std::ios::cur);
-			file.read(reinterpret_cast<char*>(&data), sizeof(data));
+		// 終了処理: マスターボイスの破棄と XAudio2 オブジェクトの解放
+		if (masterVoice_) {
+			masterVoice_->DestroyVoice();
+			masterVoice_ = nullptr;
+		}
+		if (xAudio2_) {
+			xAudio2_.Reset();
 		}
 	}
 
-	IXAudio2SourceVoice* Audio::CreateSourceVoice(const WAVEFORMATEX& wfex)
+	// ===== ヘルパー関数 =====
+
+	void Audio::InitializeXAudio2()
 	{
-		IXAudio2SourceVoice* pSourceVoice = nullptr;
-		result_ = xAudio2_->CreateSourceVoice(&pSourceVoice, &wfex);
+		result_ = XAudio2Create(&xAudio2_, kXAudio2Flags, kDefaultProcessor);
 		assert(SUCCEEDED(result_));
-		return pSourceVoice;
 	}
 
-	void Audio::PlaySourceVoice(IXAudio2SourceVoice* sourceVoice, const SoundData& soundData)
+	void Audio::CreateMasteringVoice()
 	{
-		// XAUDIO2_BUFFER に再生データを詰める
-		XAUDIO2_BUFFER buf{};
-		buf.pAudioData = soundData.pBuffer.data();
-		buf.AudioBytes = soundData.bufferSize;
-		buf.Flags = XAUDIO2_END_OF_STREAM;
-
-		// 再生キューに登録して再生開始
-		result_ = sourceVoice->SubmitSourceBuffer(&buf);
-		assert(SUCCEEDED(result_));
-
-		result_ = sourceVoice->Start();
+		// マスターボイスの作成（出力デバイスとの接続）
+		result_ = xAudio2_->CreateMasteringVoice(&masterVoice_);
 		assert(SUCCEEDED(result_));
 	}
 }
\ No newline at end of file
@@ -2,50 +2,34 @@
 #include <wrl.h>
 #include <xaudio2.h>
 #pragma comment(lib,"xaudio2.lib")
-#include <fstream>
 #include <vector>
 #include <memory>
 #include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "AudioStream.h"
+#include "VoicePool.h"
+#include "XAudio2VoiceBackend.h"
+#include "SoftwareMixer.h"
 
 namespace MyEngine {
 	// Audio用の定数
 	namespace AudioConstants {
-		// チャンクIDのサイズ
-		constexpr size_t kChunkIdSize = 4;
-
-		// チャンクID文字列
-		constexpr const char* kRiffChunkId = "RIFF";
-		constexpr const char* kWaveType = "WAVE";
-		constexpr const char* kFmtChunkId = "fmt ";
-		constexpr const char* kDataChunkId = "data";
-		constexpr const char* kJunkChunkId = "JUNK";
-
 		// XAudio2のデフォルト値
 		constexpr uint32_t kXAudio2Flags = 0;
 		constexpr XAUDIO2_PROCESSOR kDefaultProcessor = XAUDIO2_DEFAULT_PROCESSOR;
-	}
 
-	// チャンクヘッダ
-	struct ChunkHeader {
-		char id[AudioConstants::kChunkIdSize]; // チャンクのID
-		int32_t size; // チャンクのサイズ
-	};
+		// ヘッドレスで合成して WAV に書き出すコマンドライン引数（"--render-audio 出力.wav 入力.wav ..."）
+		constexpr const char* kRenderCommand = "--render-audio";
 
-	// RIFFヘッダチャンク
-	struct RiffHeader {
-		ChunkHeader chunk;
-		char type[AudioConstants::kChunkIdSize];
-	};
-
-	// FMTチャンク
-	struct FormatChunk {
-		ChunkHeader chunk;
-		WAVEFORMATEX fmt;
-	};
+		// ヘッドレスの合成で 1 回の RenderSoftware に渡すフレーム数
+		constexpr uint32_t kRenderBlockFrames = 1024;
+	}
 
 	// サウンドデータ
 	struct SoundData {
 		WAVEFORMATEX wfex; // 波形フォーマット
+		WaveFormat format; // 波形フォーマット（ボイスプールで同じフォーマットのボイスを探すのに使う）
 		std::vector<BYTE> pBuffer; // バッファの先頭アドレス
 		uint32_t bufferSize; // バッファのサイズ
 	};
@@ -70,37 +54,65 @@ namespace MyEngine {
 		// 初期化
 		void Initialize();
 
+		// ソフトウェアミキサーで初期化（XAudio2 を使わない。ヘッドレス実行・自動リプレイ用）
+		// sink は Finalize まで呼び出し側が保持する。合成は RenderSoftware を呼んだ分だけ進む
+		void InitializeSoftware(AudioSinkBase* sink, uint32_t sampleRate = SoftwareMixerConstants::kDefaultSampleRate);
+
+		// ソフトウェアミキサーで frameCount フレーム分を合成してシンクに書き出す
+		void RenderSoftware(uint32_t frameCount);
+
+		// inputPaths の WAV を同時に鳴らし、すべて鳴り終わるまでソフトウェアミキサーで合成して outputPath に書き出す
+		// （XAudio2 もウィンドウも使わない。同じ入力なら常に同じ出力になるため、自動リプレイの音声の比較に使う）
+		static bool RenderToWaveFile(const std::string& outputPath, const std::vector<std::string>& inputPaths);
+
+		// ソフトウェアミキサーの取得（XAudio2 で初期化した場合は nullptr）
+		const SoftwareMixer* GetSoftwareMixer() const { return softwareMixer_; }
+
 		// サウンドデータを読み込む
 		SoundData SoundLoadWave(const char* filename);
 
+		// WAVファイルのデコード（ファイル読み込みのみ。XAudio2に触れないためワーカースレッドから呼び出し可）
+		static SoundData DecodeWave(const char* filename);
+
+		// キャッシュ付きでサウンドを読み込む（読み込み済みならキャッシュを返す）
+		const SoundData* LoadSound(const std::string& filePath);
+
+		// デコード済みサウンドをキャッシュに登録
+		void RegisterSound(const std::string& filePath, SoundData soundData);
+
+		// キャッシュからサウンドを解放
+		void UnloadSound(const std::string& filePath);
+
+		// キャッシュ済みか
+		bool IsSoundLoaded(const std::string& filePath) const { return sounds_.contains(filePath); }
+
 		// 音声データ解放
 		void SoundUnload(SoundData* soundData);
 
-		// 音声再生
-		void SoundPlayWave(const SoundData& soundData);
+		// 音声再生（ボイスプールのボイスを使い回す。鳴らせなかった場合は false）
+		// priority が高いほど他の音からボイスを奪いやすく、maxInstances は同じサウンドを同時に鳴らせる数
+		bool SoundPlayWave(const SoundData& soundData,
+			int32_t priority = VoicePoolConstants::kDefaultPriority,
+			uint32_t maxInstances = VoicePoolConstants::kDefaultMaxInstances);
+
+		// ボイスプールの取得
+		const VoicePool& GetVoicePool() const { return voicePool_; }
+
+		// ストリーム再生（全体をメモリに読み込まず、一定サイズずつ読みながら再生する。BGM 向け）
+		// 戻り値は停止用のポインタで、所有権は Audio が持つ
+		AudioStream* PlayStream(const std::string& filePath, bool isLoop = true);
+
+		// ストリーム再生の停止と破棄
+		void StopStream(AudioStream* stream);
 
 		// 終了
 		void Finalize();
 
 	private:
-		// WAVファイル読み込みヘルパー関数
-		void ReadRiffHeader(std::ifstream& file, RiffHeader& riff);
-		void ReadFormatChunk(std::ifstream& file, FormatChunk& format);
-		void ReadDataChunk(std::ifstream& file, ChunkHeader& data);
-		std::vector<BYTE> ReadWaveData(std::ifstream& file, uint32_t size);
-
-		// チャンク検証
-		bool ValidateChunkId(const char* chunkId, const char* expectedId) const;
-		void SkipJunkChunk(std::ifstream& file, ChunkHeader& data);
-
 		// XAudio2初期化
 		void InitializeXAudio2();
 		void CreateMasteringVoice();
 
-		// SourceVoice作成と再生
-		IXAudio2SourceVoice* CreateSourceVoice(const WAVEFORMATEX& wfex);
-		void PlaySourceVoice(IXAudio2SourceVoice* sourceVoice, const SoundData& soundData);
-
 		// シングルトンインスタンス
 		static std::shared_ptr<Audio> sInstance_;
 
@@ -108,6 +120,19 @@ namespace MyEngine {
 		Microsoft::WRL::ComPtr<IXAudio2> xAudio2_;
 		IXAudio2MasteringVoice* masterVoice_ = nullptr;
 
+		// 効果音用のボイスプールとそのバックエンド（XAudio2 かソフトウェアミキサー）
+		std::unique_ptr<VoiceBackendBase> voiceBackend_;
+		VoicePool voicePool_;
+
+		// ソフトウェアミキサーで初期化した場合のバックエンド（所有は voiceBackend_）
+		SoftwareMixer* softwareMixer_ = nullptr;
+
+		// 読み込み済みサウンド（ファイルパスをキーとする）
+		std::unordered_map<std::string, SoundData> sounds_;
+
+		// 再生中のストリーム
+		std::vector<std::unique_ptr<AudioStream>> streams_;
+
 		// エラーコード
 		HRESULT result_;
 	};
@@ -0,0 +1,93 @@
+#include "AudioSink.h"
+#include "WaveFile.h"
+
+//
+// AudioSink
+// - SoftwareMixer の出力先。
+//   * NullAudioSink：何も出力せず、フレーム数だけ数える（サーバーや計測用）。
+//   * WavFileAudioSink：float32 ステレオの WAV に書き出す（自動リプレイで出力を比較する用）。
+//     data のサイズは書き終えるまで分からないため、Close でヘッダを書き直して確定させる。
+//
+namespace MyEngine {
+	using namespace WaveFileConstants;
+
+	namespace {
+		// 出力フォーマット（float32 ステレオ）
+		constexpr uint16_t kOutputChannels = 2;
+		constexpr uint16_t kOutputBitsPerSample = 32;
+		constexpr uint16_t kOutputBlockAlign = kOutputChannels * kOutputBitsPerSample / 8;
+
+		// リトルエンディアンの値の書き込み
+		template <typename T>
+		void WriteValue(std::ofstream& file, T value)
+		{
+			file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+	}
+
+	WavFileAudioSink::~WavFileAudioSink()
+	{
+		Close();
+	}
+
+	bool WavFileAudioSink::Open(const std::string& filePath, uint32_t sampleRate)
+	{
+		Close();
+
+		file_.open(filePath, std::ios::binary | std::ios::trunc);
+		if (!file_.is_open()) {
+			return false;
+		}
+
+		sampleRate_ = sampleRate;
+		dataSize_ = 0;
+		WriteHeader();
+		return true;
+	}
+
+	void WavFileAudioSink::Close()
+	{
+		if (!file_.is_open()) {
+			return;
+		}
+
+		// サイズを確定したヘッダで上書きする
+		file_.seekp(0, std::ios::beg);
+		WriteHeader();
+		file_.close();
+	}
+
+	void WavFileAudioSink::Write(std::span<const float> samples)
+	{
+		if (!file_.is_open()) {
+			return;
+		}
+		file_.write(reinterpret_cast<const char*>(samples.data()), static_cast<std::streamsize>(samples.size_bytes()));
+		dataSize_ += static_cast<uint32_t>(samples.size_bytes());
+	}
+
+	// ===== ヘルパー関数 =====
+
+	void WavFileAudioSink::WriteHeader()
+	{
+		// RIFF ヘッダ（サイズは "WAVE" 以降の全体）
+		constexpr uint32_t kHeaderBodySize = 4 + 8 + kFormatChunkMinSize + 8;
+		file_.write("RIFF", 4);
+		WriteValue<uint32_t>(file_, kHeaderBodySize + dataSize_);
+		file_.write("WAVE", 4);
+
+		// fmt チャンク
+		file_.write("fmt ", 4);
+		WriteValue<uint32_t>(file_, kFormatChunkMinSize);
+		WriteValue<uint16_t>(file_, kFormatTagFloat);
+		WriteValue<uint16_t>(file_, kOutputChannels);
+		WriteValue<uint32_t>(file_, sampleRate_);
+		WriteValue<uint32_t>(file_, sampleRate_ * kOutputBlockAlign);
+		WriteValue<uint16_t>(file_, kOutputBlockAlign);
+		WriteValue<uint16_t>(file_, kOutputBitsPerSample);
+
+		// data チャンク
+		file_.write("data", 4);
+		WriteValue<uint32_t>(file_, dataSize_);
+	}
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+
+namespace MyEngine {
+
+	/// <summary>
+	/// ソフトウェアミキサーの出力先の基底クラス
+	/// 受け取るのはステレオのインターリーブ（L, R, L, R, ...）の float
+	/// </summary>
+	class AudioSinkBase
+	{
+	public:
+		virtual ~AudioSinkBase() = default;
+
+		// 合成結果の書き出し
+		virtual void Write(std::span<const float> samples) = 0;
+	};
+
+	/// <summary>
+	/// 何も出力しないシンク（ヘッドレス実行・計測用。書き出されたフレーム数だけ数える）
+	/// </summary>
+	class NullAudioSink : public AudioSinkBase
+	{
+	public:
+		void Write(std::span<const float> samples) override { writtenFrameCount_ += samples.size() / 2; }
+
+		// ゲッター
+		uint64_t GetWrittenFrameCount() const { return writtenFrameCount_; }
+
+	private:
+		uint64_t writtenFrameCount_ = 0;
+	};
+
+	/// <summary>
+	/// WAV ファイルに書き出すシンク（float32 ステレオ。リプレイの音声の比較用）
+	/// </summary>
+	class WavFileAudioSink : public AudioSinkBase
+	{
+	public:
+		// コンストラクタ・デストラクタ
+		WavFileAudioSink() = default;
+		~WavFileAudioSink() override;
+
+		// ファイルを作成してヘッダを書く（作成できなければ false）
+		bool Open(const std::string& filePath, uint32_t sampleRate);
+
+		// ヘッダのサイズを確定して閉じる
+		void Close();
+
+		void Write(std::span<const float> samples) override;
+
+		// ゲッター
+		bool IsOpen() const { return file_.is_open(); }
+
+	private:
+		// ヘッダの書き込み（data のサイズは dataSize_ を使う）
+		void WriteHeader();
+
+		std::ofstream file_;
+		uint32_t sampleRate_ = 0;
+		uint32_t dataSize_ = 0;
+	};
+}
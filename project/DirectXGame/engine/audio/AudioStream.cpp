@@ -0,0 +1,180 @@
+#include "AudioStream.h"
+#include <cassert>
+
+//
+// AudioStream
+// - 長い WAV（BGM など）を一定メモリで再生するためのストリーム再生。
+// - 処理の流れ：
+//   1) Initialize で WaveStreamReader がヘッダだけを解析し、kStreamBufferCount 個のバッファ（各 kStreamChunkBytes）を確保する。
+//   2) Play でバッファをすべて埋めてボイスに積み、再生を開始してからストリームスレッドを起動する。
+//   3) ボイスがバッファを再生し終えると OnBufferEnd（オーディオスレッド）が空きを通知し、
+//      ストリームスレッドが次の区間を読み込んで同じバッファに詰め直して積む。
+//   4) ループしない場合は最後の区間に XAUDIO2_END_OF_STREAM を付け、OnStreamEnd で再生終了とする。
+// - バッファはボイスが再生した順に空くため、リングの次のバッファは常に再生済みで上書きしてよい。
+// - コールバックはオーディオスレッドを止めないよう、カウンタ更新と通知だけを行う。
+//
+namespace MyEngine {
+	using namespace WaveStreamConstants;
+
+	WAVEFORMATEX MakeWaveFormatEx(const WaveFormat& format)
+	{
+		WAVEFORMATEX wfex{};
+		wfex.wFormatTag = format.formatTag;
+		wfex.nChannels = format.channels;
+		wfex.nSamplesPerSec = format.samplesPerSec;
+		wfex.nAvgBytesPerSec = format.avgBytesPerSec;
+		wfex.nBlockAlign = format.blockAlign;
+		wfex.wBitsPerSample = format.bitsPerSample;
+		return wfex;
+	}
+
+	AudioStream::~AudioStream()
+	{
+		Stop();
+	}
+
+	void AudioStream::Initialize(IXAudio2* xAudio2, const std::string& filePath, bool isLoop)
+	{
+		assert(xAudio2 != nullptr && "XAudio2 is not initialized!");
+
+		filePath_ = filePath;
+		isLoop_ = isLoop;
+
+		// ヘッダの解析（波形はまだ読まない。PCM16 / PCM24 / float のモノラル・ステレオのみ）
+		const bool isOpened = reader_.Open(filePath_);
+		assert(isOpened && "Failed to open wave file for streaming!");
+		(void)isOpened;
+
+		const WaveFormat& format = reader_.GetFormat();
+		const WAVEFORMATEX wfex = MakeWaveFormatEx(format);
+
+		// このオブジェクトをコールバックとしてボイスを作成
+		HRESULT hr = xAudio2->CreateSourceVoice(&sourceVoice_, &wfex, 0, XAUDIO2_DEFAULT_FREQ_RATIO, this);
+		assert(SUCCEEDED(hr));
+
+		// バッファの確保（ブロック境界で区切れるサイズにする）
+		const size_t bufferSize = kStreamChunkBytes - kStreamChunkBytes % format.blockAlign;
+		for (std::vector<uint8_t>& buffer : buffers_) {
+			buffer.resize(bufferSize);
+		}
+	}
+
+	void AudioStream::Play()
+	{
+		assert(sourceVoice_ != nullptr && "AudioStream is not initialized!");
+		assert(!streamThread_.joinable() && "AudioStream is already playing!");
+
+		// リングのバッファをすべて埋めてから再生を開始する
+		isPlaying_ = true;
+		uint32_t submittedCount = 0;
+		while (submittedCount < kStreamBufferCount && SubmitNextBuffer()) {
+			++submittedCount;
+		}
+		if (submittedCount == 0) {
+			isPlaying_ = false;
+			return;
+		}
+
+		HRESULT hr = sourceVoice_->Start();
+		assert(SUCCEEDED(hr));
+
+		// 以降の読み込みはストリームスレッドが行う
+		streamThread_ = std::thread(&AudioStream::StreamMain, this);
+	}
+
+	void AudioStream::Stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isStopRequested_ = true;
+		}
+		condition_.notify_all();
+
+		if (streamThread_.joinable()) {
+			streamThread_.join();
+		}
+
+		// DestroyVoice はコールバックの完了を待つため、以降このオブジェクトが呼ばれることはない
+		if (sourceVoice_) {
+			sourceVoice_->Stop();
+			sourceVoice_->FlushSourceBuffers();
+			sourceVoice_->DestroyVoice();
+			sourceVoice_ = nullptr;
+		}
+
+		reader_.Close();
+		isPlaying_ = false;
+	}
+
+	// ===== ヘルパー関数 =====
+
+	void AudioStream::StreamMain()
+	{
+		while (true) {
+			// バッファが空くか停止が要求されるまで待つ
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				condition_.wait(lock, [this] { return isStopRequested_ || queuedBufferCount_ < kStreamBufferCount; });
+				if (isStopRequested_) {
+					return;
+				}
+			}
+
+			if (!SubmitNextBuffer()) {
+				// 終端まで積み終えたら、残りのバッファの再生が終わるのを待つ
+				std::unique_lock<std::mutex> lock(mutex_);
+				condition_.wait(lock, [this] { return isStopRequested_ || !isPlaying_; });
+				return;
+			}
+		}
+	}
+
+	bool AudioStream::SubmitNextBuffer()
+	{
+		std::vector<uint8_t>& buffer = buffers_[nextBufferIndex_];
+
+		// 次の区間を読み込む（ループ再生なら終端で先頭に戻る）
+		size_t size = reader_.Read(buffer);
+		if (size == 0 && isLoop_) {
+			reader_.Rewind();
+			size = reader_.Read(buffer);
+		}
+		if (size == 0) {
+			return false;
+		}
+
+		XAUDIO2_BUFFER xAudioBuffer{};
+		xAudioBuffer.pAudioData = buffer.data();
+		xAudioBuffer.AudioBytes = static_cast<UINT32>(size);
+		if (!isLoop_ && reader_.IsEnd()) {
+			xAudioBuffer.Flags = XAUDIO2_END_OF_STREAM;
+		}
+
+		// OnBufferEnd より先に数えておく
+		++queuedBufferCount_;
+		HRESULT hr = sourceVoice_->SubmitSourceBuffer(&xAudioBuffer);
+		assert(SUCCEEDED(hr));
+		(void)hr;
+
+		nextBufferIndex_ = (nextBufferIndex_ + 1) % kStreamBufferCount;
+		return true;
+	}
+
+	void STDMETHODCALLTYPE AudioStream::OnBufferEnd(void*)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			--queuedBufferCount_;
+		}
+		condition_.notify_one();
+	}
+
+	void STDMETHODCALLTYPE AudioStream::OnStreamEnd()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isPlaying_ = false;
+		}
+		condition_.notify_one();
+	}
+}
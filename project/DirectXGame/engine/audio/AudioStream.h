@@ -0,0 +1,89 @@
+#pragma once
+#include <xaudio2.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "WaveStreamReader.h"
+
+namespace MyEngine {
+
+	// WaveFormat から XAudio2 用のフォーマットを作成
+	WAVEFORMATEX MakeWaveFormatEx(const WaveFormat& format);
+
+	/// <summary>
+	/// WAV のストリーム再生
+	/// バックグラウンドスレッドがファイルを一定サイズずつ読み、少数のバッファを使い回してボイスに積み続ける
+	/// </summary>
+	class AudioStream : private IXAudio2VoiceCallback
+	{
+	public:
+		// コンストラクタ・デストラクタ
+		AudioStream() = default;
+		~AudioStream();
+
+		// コピー禁止
+		AudioStream(const AudioStream&) = delete;
+		AudioStream& operator=(const AudioStream&) = delete;
+
+		// 初期化（ファイルを開いてボイスを作成する。再生はしない）
+		void Initialize(IXAudio2* xAudio2, const std::string& filePath, bool isLoop);
+
+		// 再生開始
+		void Play();
+
+		// 停止（スレッドを止めてボイスを破棄する）
+		void Stop();
+
+		// ゲッター
+		bool IsPlaying() const { return isPlaying_; }
+		const std::string& GetFilePath() const { return filePath_; }
+
+	private:
+		// バッファを埋めてボイスに積むスレッド
+		void StreamMain();
+
+		// 次のバッファを読み込んで積む（終端なら false）
+		bool SubmitNextBuffer();
+
+		// IXAudio2VoiceCallback（オーディオスレッドから呼ばれるため待機しないこと）
+		void STDMETHODCALLTYPE OnBufferEnd(void* pBufferContext) override;
+		void STDMETHODCALLTYPE OnStreamEnd() override;
+		void STDMETHODCALLTYPE OnVoiceProcessingPassStart(UINT32) override {}
+		void STDMETHODCALLTYPE OnVoiceProcessingPassEnd() override {}
+		void STDMETHODCALLTYPE OnBufferStart(void*) override {}
+		void STDMETHODCALLTYPE OnLoopEnd(void*) override {}
+		void STDMETHODCALLTYPE OnVoiceError(void*, HRESULT) override {}
+
+		// ファイルパス
+		std::string filePath_;
+
+		// WAV の読み込み（ストリームスレッドのみが触る）
+		WaveStreamReader reader_;
+
+		// ループ再生するか
+		bool isLoop_ = false;
+
+		// ソースボイス
+		IXAudio2SourceVoice* sourceVoice_ = nullptr;
+
+		// ボイスに積むバッファのリング
+		std::array<std::vector<uint8_t>, WaveStreamConstants::kStreamBufferCount> buffers_;
+		uint32_t nextBufferIndex_ = 0;
+
+		// ボイスに積まれているバッファ数
+		std::atomic<uint32_t> queuedBufferCount_ = 0;
+
+		// ストリームスレッド
+		std::thread streamThread_;
+		std::mutex mutex_;
+		std::condition_variable condition_;
+		bool isStopRequested_ = false;
+
+		// 再生中か（最後のバッファを再生し終えたら false）
+		std::atomic<bool> isPlaying_ = false;
+	};
+}
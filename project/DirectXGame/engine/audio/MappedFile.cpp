@@ -0,0 +1,114 @@
+#include "MappedFile.h"
+#include <filesystem>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//
+// MappedFile
+// - WAV などをストリームで読まず、ファイル全体をメモリマップしてバイト列として扱うためのクラス。
+// - 実際のページは触れたときに OS が読み込むため、ファイルサイズぶんのメモリを先に確保することはない。
+// - Windows では CreateFileMapping / MapViewOfFile、それ以外では mmap を使う（ヘッドレス環境でのツール用）。
+//
+namespace MyEngine {
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+#ifdef _WIN32
+	bool MappedFile::Open(const std::string& filePath)
+	{
+		Close();
+
+		HANDLE file = CreateFileW(std::filesystem::path(filePath).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+
+		LARGE_INTEGER fileSize{};
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			CloseHandle(file);
+			return false;
+		}
+
+		const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (view == nullptr) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		fileHandle_ = file;
+		mappingHandle_ = mapping;
+		data_ = static_cast<const uint8_t*>(view);
+		size_ = static_cast<size_t>(fileSize.QuadPart);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (data_) {
+			UnmapViewOfFile(data_);
+		}
+		if (mappingHandle_) {
+			CloseHandle(static_cast<HANDLE>(mappingHandle_));
+		}
+		if (fileHandle_) {
+			CloseHandle(static_cast<HANDLE>(fileHandle_));
+		}
+		data_ = nullptr;
+		size_ = 0;
+		fileHandle_ = nullptr;
+		mappingHandle_ = nullptr;
+	}
+#else
+	bool MappedFile::Open(const std::string& filePath)
+	{
+		Close();
+
+		const int file = open(filePath.c_str(), O_RDONLY);
+		if (file < 0) {
+			return false;
+		}
+
+		struct stat fileStat {};
+		if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+			close(file);
+			return false;
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (view == MAP_FAILED) {
+			return false;
+		}
+
+		data_ = static_cast<const uint8_t*>(view);
+		size_ = static_cast<size_t>(fileStat.st_size);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (data_) {
+			munmap(const_cast<uint8_t*>(data_), size_);
+		}
+		data_ = nullptr;
+		size_ = 0;
+	}
+#endif
+}
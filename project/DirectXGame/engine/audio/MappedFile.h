@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+
+namespace MyEngine {
+
+	/// <summary>
+	/// 読み取り専用のメモリマップドファイル
+	/// ファイル全体をアドレス空間に割り当て、読み込みのコピー無しでバイト列として参照する
+	/// </summary>
+	class MappedFile
+	{
+	public:
+		// コンストラクタ・デストラクタ
+		MappedFile() = default;
+		~MappedFile();
+
+		// コピー禁止
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// ファイルを割り当てる（開けない・空のファイルなら false）
+		bool Open(const std::string& filePath);
+
+		// 割り当ての解除
+		void Close();
+
+		// ゲッター
+		bool IsOpen() const { return data_ != nullptr; }
+		std::span<const uint8_t> GetBytes() const { return { data_, size_ }; }
+
+	private:
+		// 割り当て先と大きさ
+		const uint8_t* data_ = nullptr;
+		size_t size_ = 0;
+
+		// OS のハンドル（Windows はファイルとマッピングオブジェクト、それ以外はファイル記述子）
+		void* fileHandle_ = nullptr;
+		void* mappingHandle_ = nullptr;
+	};
+}
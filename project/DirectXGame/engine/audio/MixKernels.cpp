@@ -0,0 +1,176 @@
+#include "MixKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define MIX_KERNELS_USE_SSE2 1
+#endif
+
+//
+// MixKernels
+// - ソフトウェアミキサーの内側のループ。ボイス数 × フレーム数回呼ばれるため、SSE2 で 4 要素ずつ処理する。
+//   * PCM16 → float：8 サンプルずつ符号拡張して変換する。
+//   * ゲイン：ステレオは {gL, gR, gL, gR} を 2 フレームずつ、モノラルは 1 サンプルを左右に複製して 2 フレームずつ掛けて加算する。
+//   * リサンプル：補間元の 2 サンプルはスカラーで集め、補間（a + (b - a) * t）をベクトルで行う。
+//   * パン：モノラルは等パワー（cos / sin）、ステレオはバランス（中央で 1, 1）。ステレオに等パワーを掛けると中央で 3dB 下がる。
+// - 端数はスカラーで処理する。スカラーとベクトルで同じ演算順にしているため、どちらでも結果は一致する。
+//
+namespace MyEngine::MixKernels {
+
+	namespace {
+		// 整数 PCM の正規化係数
+		constexpr float kPcm16Scale = 1.0f / 32768.0f;
+		constexpr float kPcm24Scale = 1.0f / 8388608.0f;
+
+		// 1 サンプルのバイト数
+		constexpr size_t kPcm16Bytes = 2;
+		constexpr size_t kPcm24Bytes = 3;
+	}
+
+	void ConvertToFloat(std::span<const uint8_t> source, SampleFormat sampleFormat, std::span<float> destination)
+	{
+		const size_t sampleCount = destination.size();
+
+		switch (sampleFormat) {
+		case SampleFormat::Pcm16:
+		{
+			const uint8_t* bytes = source.data();
+			size_t i = 0;
+#ifdef MIX_KERNELS_USE_SSE2
+			const __m128 scale = _mm_set1_ps(kPcm16Scale);
+			for (; i + 8 <= sampleCount; i += 8) {
+				const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i * kPcm16Bytes));
+				// 上位 16bit に置いてから算術シフトで符号拡張する
+				const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+				const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16);
+				_mm_storeu_ps(destination.data() + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+				_mm_storeu_ps(destination.data() + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+			}
+#endif
+			for (; i < sampleCount; ++i) {
+				int16_t value = 0;
+				std::memcpy(&value, bytes + i * kPcm16Bytes, sizeof(value));
+				destination[i] = static_cast<float>(value) * kPcm16Scale;
+			}
+			break;
+		}
+
+		case SampleFormat::Pcm24:
+			for (size_t i = 0; i < sampleCount; ++i) {
+				const uint8_t* bytes = source.data() + i * kPcm24Bytes;
+				// 上位 24bit に詰めてから算術シフトで符号拡張する
+				const int32_t value = static_cast<int32_t>(
+					(static_cast<uint32_t>(bytes[0]) << 8) | (static_cast<uint32_t>(bytes[1]) << 16) | (static_cast<uint32_t>(bytes[2]) << 24)) >> 8;
+				destination[i] = static_cast<float>(value) * kPcm24Scale;
+			}
+			break;
+
+		case SampleFormat::Float32:
+			std::memcpy(destination.data(), source.data(), sampleCount * sizeof(float));
+			break;
+
+		default:
+			std::fill(destination.begin(), destination.end(), 0.0f);
+			break;
+		}
+	}
+
+	void Resample(std::span<const float> source, uint32_t channels, double position, double step, std::span<float> destination, uint32_t frameCount)
+	{
+		// 補間元 a, b と補間係数 t を 4 要素ずつ集めて補間する
+		float a[4];
+		float b[4];
+		float t[4];
+		uint32_t lane = 0;
+		size_t outIndex = 0;
+
+		const auto flush = [&](uint32_t count) {
+#ifdef MIX_KERNELS_USE_SSE2
+			if (count == 4) {
+				const __m128 va = _mm_loadu_ps(a);
+				const __m128 result = _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b), va), _mm_loadu_ps(t)));
+				_mm_storeu_ps(destination.data() + outIndex, result);
+				outIndex += 4;
+				return;
+			}
+#endif
+			for (uint32_t i = 0; i < count; ++i) {
+				destination[outIndex++] = a[i] + (b[i] - a[i]) * t[i];
+			}
+		};
+
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			const double sourcePosition = position + static_cast<double>(frame) * step;
+			const size_t index = static_cast<size_t>(sourcePosition);
+			const float fraction = static_cast<float>(sourcePosition - static_cast<double>(index));
+
+			for (uint32_t channel = 0; channel < channels; ++channel) {
+				a[lane] = source[index * channels + channel];
+				b[lane] = source[(index + 1) * channels + channel];
+				t[lane] = fraction;
+				if (++lane == 4) {
+					flush(4);
+					lane = 0;
+				}
+			}
+		}
+		flush(lane);
+	}
+
+	void MixMono(std::span<const float> source, float gainLeft, float gainRight, std::span<float> bus, uint32_t frameCount)
+	{
+		uint32_t frame = 0;
+#ifdef MIX_KERNELS_USE_SSE2
+		const __m128 gain = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+		for (; frame + 4 <= frameCount; frame += 4) {
+			const __m128 samples = _mm_loadu_ps(source.data() + frame);
+			// {s0, s0, s1, s1} と {s2, s2, s3, s3} に複製する
+			const __m128 low = _mm_unpacklo_ps(samples, samples);
+			const __m128 high = _mm_unpackhi_ps(samples, samples);
+			float* output = bus.data() + frame * 2;
+			_mm_storeu_ps(output, _mm_add_ps(_mm_loadu_ps(output), _mm_mul_ps(low, gain)));
+			_mm_storeu_ps(output + 4, _mm_add_ps(_mm_loadu_ps(output + 4), _mm_mul_ps(high, gain)));
+		}
+#endif
+		for (; frame < frameCount; ++frame) {
+			bus[frame * 2] += source[frame] * gainLeft;
+			bus[frame * 2 + 1] += source[frame] * gainRight;
+		}
+	}
+
+	void MixStereo(std::span<const float> source, float gainLeft, float gainRight, std::span<float> bus, uint32_t frameCount)
+	{
+		uint32_t frame = 0;
+#ifdef MIX_KERNELS_USE_SSE2
+		const __m128 gain = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+		for (; frame + 2 <= frameCount; frame += 2) {
+			float* output = bus.data() + frame * 2;
+			_mm_storeu_ps(output, _mm_add_ps(_mm_loadu_ps(output), _mm_mul_ps(_mm_loadu_ps(source.data() + frame * 2), gain)));
+		}
+#endif
+		for (; frame < frameCount; ++frame) {
+			bus[frame * 2] += source[frame * 2] * gainLeft;
+			bus[frame * 2 + 1] += source[frame * 2 + 1] * gainRight;
+		}
+	}
+
+	void CalculatePanGains(float volume, float pan, uint32_t channels, float& gainLeft, float& gainRight)
+	{
+		pan = std::clamp(pan, -1.0f, 1.0f);
+
+		// ステレオはバランス：中央で左右とも 1（XAudio2 の既定と同じく素通し）、寄せた側の反対だけを絞る
+		if (channels == 2) {
+			gainLeft = volume * (std::min)(1.0f, 1.0f - pan);
+			gainRight = volume * (std::min)(1.0f, 1.0f + pan);
+			return;
+		}
+
+		// モノラルは pan を [0, π/2] の角度に写して cos / sin で配分する（等パワー。中央で左右とも 1/√2）
+		const float angle = (pan + 1.0f) * std::numbers::pi_v<float> * 0.25f;
+		gainLeft = volume * std::cos(angle);
+		gainRight = volume * std::sin(angle);
+	}
+}
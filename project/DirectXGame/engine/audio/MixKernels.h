@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include "WaveFile.h"
+
+namespace MyEngine {
+
+	/// <summary>
+	/// ソフトウェアミキサーのサンプル処理（SSE2 が使えればベクトル化、無ければスカラーで同じ結果を返す）
+	/// バスは常にステレオのインターリーブ（L, R, L, R, ...）の float
+	/// </summary>
+	namespace MixKernels {
+		// 整数 PCM を [-1, 1) の float に変換（チャンネルのインターリーブはそのまま。destination は samples 数ぶん）
+		void ConvertToFloat(std::span<const uint8_t> source, SampleFormat sampleFormat, std::span<float> destination);
+
+		// 線形補間でリサンプルする（source は channels チャンネルのインターリーブで、frameCount + 1 フレーム目まで読む場合がある）
+		// position は source 先頭からの開始位置（0 以上 1 未満）、step は出力 1 フレームあたりに進むソースのフレーム数
+		void Resample(std::span<const float> source, uint32_t channels, double position, double step, std::span<float> destination, uint32_t frameCount);
+
+		// モノラルをゲインを掛けてステレオのバスに加算する
+		void MixMono(std::span<const float> source, float gainLeft, float gainRight, std::span<float> bus, uint32_t frameCount);
+
+		// ステレオをゲインを掛けてステレオのバスに加算する
+		void MixStereo(std::span<const float> source, float gainLeft, float gainRight, std::span<float> bus, uint32_t frameCount);
+
+		// 音量とパン（-1 で左、1 で右）からソースのチャンネル数に応じた左右のゲインを求める
+		// モノラルは等パワー、ステレオはバランス（中央で左右とも volume）
+		void CalculatePanGains(float volume, float pan, uint32_t channels, float& gainLeft, float& gainRight);
+	}
+}
@@ -0,0 +1,69 @@
+#include "RiffReader.h"
+#include <algorithm>
+#include <cstring>
+
+//
+// RiffReader
+// - RIFF 形式（WAV など）のチャンクを先頭から 1 回だけ辿り、ID と本体の範囲を索引にする。
+// - 固定の並び（RIFF → fmt → data）を前提にせず、LIST / bext / cue / JUNK など何個・どの順にあっても扱える。
+// - 入力は信用しない：
+//   * RIFF ヘッダのサイズがファイルより大きい場合はファイル末尾までを対象とする。
+//   * チャンクのサイズが残りより大きい場合は読める範囲だけを索引に入れて走査を終える。
+//   * 奇数サイズのチャンクの後ろにある 1 バイトのパディングを飛ばす。
+// - バイト列はコピーせず span で指すため、メモリマップしたファイルをそのまま渡せる。
+//
+namespace MyEngine {
+	using namespace RiffConstants;
+
+	namespace {
+		// リトルエンディアンの 32bit 値の読み出し（境界チェックは呼び出し側で行う）
+		uint32_t ReadUint32(const uint8_t* bytes)
+		{
+			uint32_t value = 0;
+			std::memcpy(&value, bytes, sizeof(value));
+			return value;
+		}
+	}
+
+	bool RiffReader::Parse(std::span<const uint8_t> bytes)
+	{
+		formType_ = 0;
+		chunks_.clear();
+
+		// RIFF ヘッダ
+		if (bytes.size() < kRiffHeaderSize || ReadUint32(bytes.data()) != kRiffId) {
+			return false;
+		}
+		const uint64_t riffSize = ReadUint32(bytes.data() + 4);
+		formType_ = ReadUint32(bytes.data() + 8);
+
+		// 走査範囲（ヘッダのサイズとファイルサイズの小さい方）
+		const uint64_t end = (std::min)(static_cast<uint64_t>(bytes.size()), riffSize + kChunkHeaderSize);
+
+		uint64_t offset = kRiffHeaderSize;
+		while (offset + kChunkHeaderSize <= end) {
+			const uint32_t id = ReadUint32(bytes.data() + offset);
+			const uint64_t size = ReadUint32(bytes.data() + offset + 4);
+			const uint64_t body = offset + kChunkHeaderSize;
+			const uint64_t available = end - body;
+
+			chunks_.push_back(RiffChunk{ id, bytes.subspan(static_cast<size_t>(body), static_cast<size_t>((std::min)(size, available))) });
+
+			// 途中で切れているチャンクが最後
+			if (size > available) {
+				break;
+			}
+
+			// 次のチャンクへ（2 バイト境界に揃える）
+			offset = body + size + (size & 1);
+		}
+
+		return true;
+	}
+
+	const RiffChunk* RiffReader::FindChunk(uint32_t id) const
+	{
+		auto it = std::find_if(chunks_.begin(), chunks_.end(), [id](const RiffChunk& chunk) { return chunk.id == id; });
+		return it != chunks_.end() ? &*it : nullptr;
+	}
+}
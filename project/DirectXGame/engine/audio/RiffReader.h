@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace MyEngine {
+	// RiffReader用の定数
+	namespace RiffConstants {
+		// 4 文字のチャンクIDを 32bit 値にする（ファイル上のバイト順と同じリトルエンディアン）
+		constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+		{
+			return static_cast<uint32_t>(static_cast<uint8_t>(a))
+				| (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8)
+				| (static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16)
+				| (static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+		}
+
+		// チャンクID
+		constexpr uint32_t kRiffId = MakeFourCC('R', 'I', 'F', 'F');
+		constexpr uint32_t kWaveId = MakeFourCC('W', 'A', 'V', 'E');
+		constexpr uint32_t kFmtId = MakeFourCC('f', 'm', 't', ' ');
+		constexpr uint32_t kDataId = MakeFourCC('d', 'a', 't', 'a');
+
+		// RIFF ヘッダ（"RIFF" + サイズ + 形式）とチャンクヘッダ（ID + サイズ）のサイズ
+		constexpr size_t kRiffHeaderSize = 12;
+		constexpr size_t kChunkHeaderSize = 8;
+	}
+
+	// RIFF のチャンク 1 つ分（data は元のバイト列を指す）
+	struct RiffChunk {
+		uint32_t id = 0;
+		std::span<const uint8_t> data;
+	};
+
+	/// <summary>
+	/// RIFF チャンクの索引
+	/// バイト列を 1 回だけ走査してすべてのチャンクの位置を記録する（中身はコピーしない）
+	/// </summary>
+	class RiffReader
+	{
+	public:
+		// バイト列を解析する（RIFF でなければ false）。bytes は索引を使い終わるまで呼び出し側が保持すること
+		// チャンクの順序や未知のチャンクの有無は問わず、サイズが壊れている場合は読める範囲までを索引にする
+		bool Parse(std::span<const uint8_t> bytes);
+
+		// 指定IDの最初のチャンク（無ければ nullptr）
+		const RiffChunk* FindChunk(uint32_t id) const;
+
+		// ゲッター
+		uint32_t GetFormType() const { return formType_; }
+		const std::vector<RiffChunk>& GetChunks() const { return chunks_; }
+
+	private:
+		// RIFF の形式（"WAVE" など）
+		uint32_t formType_ = 0;
+
+		// 全チャンク（ファイル上の順）
+		std::vector<RiffChunk> chunks_;
+	};
+}
@@ -0,0 +1,166 @@
+#include "SoftwareMixer.h"
+#include "MixKernels.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+
+//
+// SoftwareMixer
+// - Windows / XAudio2 の無い環境（ヘッドレスサーバー、自動リプレイ）で音声を合成するためのミキサー。
+// - Render の流れ（ボイスごと、kMixBlockFrames フレームずつ）：
+//   1) 再生位置から必要なソースフレームを float に変換する（補間用に 1 フレーム多く。終端を越える分は無音）。
+//   2) ソースと出力のサンプリングレートが違う、または再生位置が端数なら線形補間でリサンプルする。
+//   3) 音量とパンから求めた左右のゲインを掛けてステレオのバスに加算する（モノラルは等パワー、ステレオはバランス）。
+//   合成が終わったバスをシンク（NullAudioSink / WavFileAudioSink）に書き出す。
+// - 再生位置は double で進めるため、同じ入力と同じ Render の呼び方なら常に同じ出力になる（決定的）。
+// - Render 1 回ぶんの合成時間と合成したボイス数を記録し、ボイスあたりの合成コストを計測できるようにしている。
+//
+namespace MyEngine {
+	using namespace SoftwareMixerConstants;
+	using namespace VoiceBackendConstants;
+
+	void SoftwareMixer::Initialize(AudioSinkBase* sink, uint32_t sampleRate)
+	{
+		assert(sampleRate > 0);
+
+		sink_ = sink;
+		sampleRate_ = sampleRate;
+		voices_.clear();
+		freeVoiceIds_.clear();
+	}
+
+	void SoftwareMixer::Render(uint32_t frameCount)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+
+		bus_.assign(static_cast<size_t>(frameCount) * 2, 0.0f);
+
+		uint32_t mixedVoiceCount = 0;
+		for (Voice& voice : voices_) {
+			if (voice.isCreated && voice.isPlaying) {
+				MixVoice(voice, frameCount);
+				++mixedVoiceCount;
+			}
+		}
+
+		lastMixMicroseconds_ = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+		lastMixedVoiceCount_ = mixedVoiceCount;
+
+		if (sink_) {
+			sink_->Write(bus_);
+		}
+	}
+
+	uint32_t SoftwareMixer::CreateVoice(const WaveFormat& format)
+	{
+		const SampleFormat sampleFormat = GetSampleFormat(format);
+		if (sampleFormat == SampleFormat::Unknown
+			|| format.channels < WaveFileConstants::kMinChannelCount || format.channels > WaveFileConstants::kMaxChannelCount
+			|| format.samplesPerSec == 0 || format.blockAlign == 0) {
+			return kInvalidVoiceId;
+		}
+
+		uint32_t voiceId = 0;
+		if (!freeVoiceIds_.empty()) {
+			voiceId = freeVoiceIds_.back();
+			freeVoiceIds_.pop_back();
+		}
+		else {
+			voiceId = static_cast<uint32_t>(voices_.size());
+			voices_.emplace_back();
+		}
+
+		Voice& voice = voices_[voiceId];
+		voice = Voice{};
+		voice.isCreated = true;
+		voice.format = format;
+		voice.sampleFormat = sampleFormat;
+		voice.step = static_cast<double>(format.samplesPerSec) / static_cast<double>(sampleRate_);
+		return voiceId;
+	}
+
+	void SoftwareMixer::DestroyVoice(uint32_t voiceId)
+	{
+		assert(voiceId < voices_.size() && voices_[voiceId].isCreated);
+
+		voices_[voiceId] = Voice{};
+		freeVoiceIds_.push_back(voiceId);
+	}
+
+	void SoftwareMixer::Start(uint32_t voiceId, std::span<const uint8_t> samples)
+	{
+		Voice& voice = voices_[voiceId];
+		voice.samples = samples;
+		voice.position = 0.0;
+		voice.isPlaying = !samples.empty();
+	}
+
+	void SoftwareMixer::Stop(uint32_t voiceId)
+	{
+		voices_[voiceId].isPlaying = false;
+	}
+
+	// ===== ヘルパー関数 =====
+
+	void SoftwareMixer::MixVoice(Voice& voice, uint32_t frameCount)
+	{
+		const uint32_t channels = voice.format.channels;
+		const size_t blockAlign = voice.format.blockAlign;
+		const size_t totalFrames = voice.samples.size() / blockAlign;
+
+		float gainLeft = 0.0f;
+		float gainRight = 0.0f;
+		MixKernels::CalculatePanGains(voice.volume, voice.pan, channels, gainLeft, gainRight);
+
+		uint32_t mixedFrames = 0;
+		while (mixedFrames < frameCount) {
+			// ソースの残りから出せる出力フレーム数
+			const double remainingFrames = static_cast<double>(totalFrames) - voice.position;
+			if (remainingFrames <= 0.0) {
+				break;
+			}
+			const uint32_t blockFrames = static_cast<uint32_t>((std::min)({
+				static_cast<double>(kMixBlockFrames),
+				static_cast<double>(frameCount - mixedFrames),
+				std::ceil(remainingFrames / voice.step) }));
+
+			// 必要なソースフレームを float に変換（補間用に 1 フレーム多く。終端を越える分は無音）
+			const size_t firstFrame = static_cast<size_t>(voice.position);
+			const double fraction = voice.position - static_cast<double>(firstFrame);
+			const size_t neededFrames = static_cast<size_t>(fraction + static_cast<double>(blockFrames - 1) * voice.step) + 2;
+			const size_t availableFrames = (std::min)(neededFrames, totalFrames - firstFrame);
+
+			sourceScratch_.resize(neededFrames * channels);
+			MixKernels::ConvertToFloat(
+				voice.samples.subspan(firstFrame * blockAlign, availableFrames * blockAlign),
+				voice.sampleFormat,
+				std::span<float>(sourceScratch_).first(availableFrames * channels));
+			std::fill(sourceScratch_.begin() + availableFrames * channels, sourceScratch_.end(), 0.0f);
+
+			// レートが違うか位置が端数ならリサンプル
+			std::span<const float> source = sourceScratch_;
+			if (voice.step != 1.0 || fraction != 0.0) {
+				resampleScratch_.resize(static_cast<size_t>(blockFrames) * channels);
+				MixKernels::Resample(sourceScratch_, channels, fraction, voice.step, resampleScratch_, blockFrames);
+				source = resampleScratch_;
+			}
+
+			// ゲインを掛けてバスに加算
+			const std::span<float> bus = std::span<float>(bus_).subspan(static_cast<size_t>(mixedFrames) * 2);
+			if (channels == 1) {
+				MixKernels::MixMono(source, gainLeft, gainRight, bus, blockFrames);
+			}
+			else {
+				MixKernels::MixStereo(source, gainLeft, gainRight, bus, blockFrames);
+			}
+
+			voice.position += static_cast<double>(blockFrames) * voice.step;
+			mixedFrames += blockFrames;
+		}
+
+		if (voice.position >= static_cast<double>(totalFrames)) {
+			voice.isPlaying = false;
+		}
+	}
+}
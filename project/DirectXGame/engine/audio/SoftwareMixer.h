@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "AudioSink.h"
+#include "VoiceBackendBase.h"
+
+namespace MyEngine {
+	// SoftwareMixer用の定数
+	namespace SoftwareMixerConstants {
+		// 出力のサンプリングレートのデフォルト値
+		constexpr uint32_t kDefaultSampleRate = 48000;
+
+		// 1 度に変換・合成するフレーム数（作業バッファの大きさ）
+		constexpr uint32_t kMixBlockFrames = 256;
+	}
+
+	/// <summary>
+	/// ソフトウェアミキサー
+	/// XAudio2 を使わずに全ボイスを float のステレオバスに合成し、シンクへ書き出す
+	/// VoiceBackendBase を実装しているため VoicePool からそのまま使える
+	/// </summary>
+	class SoftwareMixer : public VoiceBackendBase
+	{
+	public:
+		// 初期化（sink は呼び出し側が保持する。nullptr なら合成だけ行う）
+		void Initialize(AudioSinkBase* sink, uint32_t sampleRate = SoftwareMixerConstants::kDefaultSampleRate);
+
+		// frameCount フレーム分を合成してシンクに書き出す
+		void Render(uint32_t frameCount);
+
+		// ボイスの音量とパン（-1 で左、1 で右）
+		void SetVoiceVolume(uint32_t voiceId, float volume) { voices_[voiceId].volume = volume; }
+		void SetVoicePan(uint32_t voiceId, float pan) { voices_[voiceId].pan = pan; }
+
+		// VoiceBackendBase
+		uint32_t CreateVoice(const WaveFormat& format) override;
+		void DestroyVoice(uint32_t voiceId) override;
+		void Start(uint32_t voiceId, std::span<const uint8_t> samples) override;
+		void Stop(uint32_t voiceId) override;
+		bool IsPlaying(uint32_t voiceId) const override { return voices_[voiceId].isPlaying; }
+
+		// ゲッター
+		std::span<const float> GetBus() const { return bus_; }
+		uint32_t GetSampleRate() const { return sampleRate_; }
+		// 直前の Render の合成時間（マイクロ秒）と合成したボイス数
+		double GetLastMixMicroseconds() const { return lastMixMicroseconds_; }
+		uint32_t GetLastMixedVoiceCount() const { return lastMixedVoiceCount_; }
+
+	private:
+		// ボイス 1 つ分の状態
+		struct Voice {
+			bool isCreated = false;
+			bool isPlaying = false;
+			WaveFormat format{};
+			SampleFormat sampleFormat = SampleFormat::Unknown;
+			std::span<const uint8_t> samples;
+			// ソースの再生位置（フレーム単位）と出力 1 フレームあたりの進み幅
+			double position = 0.0;
+			double step = 1.0;
+			float volume = 1.0f;
+			float pan = 0.0f;
+		};
+
+		// 1 ボイスをバスに加算する
+		void MixVoice(Voice& voice, uint32_t frameCount);
+
+		// 出力先
+		AudioSinkBase* sink_ = nullptr;
+		uint32_t sampleRate_ = SoftwareMixerConstants::kDefaultSampleRate;
+
+		// ボイス（IDはインデックス）と空きID
+		std::vector<Voice> voices_;
+		std::vector<uint32_t> freeVoiceIds_;
+
+		// ステレオのバスと作業バッファ
+		std::vector<float> bus_;
+		std::vector<float> sourceScratch_;
+		std::vector<float> resampleScratch_;
+
+		// 計測
+		double lastMixMicroseconds_ = 0.0;
+		uint32_t lastMixedVoiceCount_ = 0;
+	};
+}
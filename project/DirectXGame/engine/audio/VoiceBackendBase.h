@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include "WaveFile.h"
+
+namespace MyEngine {
+	// VoiceBackendBase用の定数
+	namespace VoiceBackendConstants {
+		// 無効なボイスID
+		constexpr uint32_t kInvalidVoiceId = UINT32_MAX;
+	}
+
+	/// <summary>
+	/// ボイスの作成・再生を行うバックエンドの基底クラス
+	/// VoicePool はこのインターフェースだけを使うため、XAudio2 以外（テスト用の偽物など）に差し替えられる
+	/// </summary>
+	class VoiceBackendBase
+	{
+	public:
+		virtual ~VoiceBackendBase() = default;
+
+		// 指定フォーマットのボイスを作成（失敗したら kInvalidVoiceId）
+		virtual uint32_t CreateVoice(const WaveFormat& format) = 0;
+
+		// ボイスの破棄
+		virtual void DestroyVoice(uint32_t voiceId) = 0;
+
+		// 波形を積んで再生開始（samples は再生が終わるまで呼び出し側が保持する）
+		virtual void Start(uint32_t voiceId, std::span<const uint8_t> samples) = 0;
+
+		// 再生停止（積んだ波形も破棄する）
+		virtual void Stop(uint32_t voiceId) = 0;
+
+		// 再生中か（積んだ波形がすべて再生し終わったら false）
+		virtual bool IsPlaying(uint32_t voiceId) const = 0;
+	};
+}
@@ -0,0 +1,177 @@
+#include "VoicePool.h"
+#include <cassert>
+
+//
+// VoicePool
+// - 効果音のたびにボイスを作って破棄しない（リークする）のをやめ、固定数のボイスを使い回す。
+// - ボイスは作成時のフォーマットに固定されるため、空きボイスは同じフォーマットの再生にだけ使い回す。
+// - Play でのボイスの選び方（上から順に試す）：
+//   1) 同じサウンドが maxInstances 個鳴っていれば、その中で最も古いものを止めて使う。
+//   2) 同じフォーマットの空きボイス。
+//   3) 上限に達していなければ新しく作る。
+//   4) 別フォーマットの空きボイスを作り直す。
+//   5) 優先度がリクエスト以下のボイスのうち、最も優先度が低く古いものを奪う。どれも高ければ鳴らさない。
+// - 途中で止めたボイスはバックエンド側に破棄待ちのバッファが残り得るため、使い回さずに作り直す。
+//   自然に再生し終えたボイスだけを Reclaim で空きに戻して使い回す。
+// - D3D / XAudio2 には依存せず、バックエンドは VoiceBackendBase 越しに扱う。
+//
+namespace MyEngine {
+	using namespace VoiceBackendConstants;
+
+	void VoicePool::Initialize(VoiceBackendBase* backend, uint32_t maxVoiceCount)
+	{
+		assert(backend != nullptr && "Voice backend is null!");
+		assert(maxVoiceCount > 0);
+
+		Finalize();
+		backend_ = backend;
+		maxVoiceCount_ = maxVoiceCount;
+
+		// Voice* を返すため再確保させない
+		voices_.reserve(maxVoiceCount_);
+	}
+
+	void VoicePool::Finalize()
+	{
+		if (backend_) {
+			for (Voice& voice : voices_) {
+				if (voice.voiceId != kInvalidVoiceId) {
+					backend_->DestroyVoice(voice.voiceId);
+				}
+			}
+		}
+		voices_.clear();
+		backend_ = nullptr;
+	}
+
+	bool VoicePool::Play(const VoicePlayRequest& request)
+	{
+		assert(backend_ != nullptr && "VoicePool is not initialized!");
+
+		// 再生し終えたボイスを先に空きに戻す
+		Reclaim();
+
+		Voice* voice = AcquireVoice(request);
+		if (voice == nullptr) {
+			return false;
+		}
+
+		voice->isActive = true;
+		voice->soundKey = request.soundKey;
+		voice->priority = request.priority;
+		voice->startSerial = nextSerial_++;
+		backend_->Start(voice->voiceId, request.samples);
+		return true;
+	}
+
+	void VoicePool::StopSound(const void* soundKey)
+	{
+		for (Voice& voice : voices_) {
+			if (voice.isActive && voice.soundKey == soundKey) {
+				StopVoice(voice);
+			}
+		}
+	}
+
+	void VoicePool::Reclaim()
+	{
+		for (Voice& voice : voices_) {
+			if (voice.isActive && !backend_->IsPlaying(voice.voiceId)) {
+				voice.isActive = false;
+				voice.soundKey = nullptr;
+			}
+		}
+	}
+
+	uint32_t VoicePool::GetActiveVoiceCount() const
+	{
+		uint32_t count = 0;
+		for (const Voice& voice : voices_) {
+			count += voice.isActive ? 1 : 0;
+		}
+		return count;
+	}
+
+	// ===== ヘルパー関数 =====
+
+	VoicePool::Voice* VoicePool::AcquireVoice(const VoicePlayRequest& request)
+	{
+		// 1) 同じサウンドの同時再生数の上限
+		Voice* oldestSameSound = nullptr;
+		uint32_t sameSoundCount = 0;
+		for (Voice& voice : voices_) {
+			if (voice.isActive && voice.soundKey == request.soundKey) {
+				++sameSoundCount;
+				if (oldestSameSound == nullptr || voice.startSerial < oldestSameSound->startSerial) {
+					oldestSameSound = &voice;
+				}
+			}
+		}
+		if (request.maxInstances > 0 && sameSoundCount >= request.maxInstances) {
+			StopVoice(*oldestSameSound);
+			return RecreateVoice(*oldestSameSound, request.format) ? oldestSameSound : nullptr;
+		}
+
+		// 2) 同じフォーマットの空きボイス
+		for (Voice& voice : voices_) {
+			if (!voice.isActive && voice.voiceId != kInvalidVoiceId && voice.format == request.format) {
+				return &voice;
+			}
+		}
+
+		// 3) 破棄済みのスロットか、上限までの新規作成
+		for (Voice& voice : voices_) {
+			if (voice.voiceId == kInvalidVoiceId) {
+				return RecreateVoice(voice, request.format) ? &voice : nullptr;
+			}
+		}
+		if (voices_.size() < maxVoiceCount_) {
+			Voice& voice = voices_.emplace_back();
+			return RecreateVoice(voice, request.format) ? &voice : nullptr;
+		}
+
+		// 4) 別フォーマットの空きボイスを作り直す
+		for (Voice& voice : voices_) {
+			if (!voice.isActive) {
+				return RecreateVoice(voice, request.format) ? &voice : nullptr;
+			}
+		}
+
+		// 5) 優先度が低く古いボイスを奪う
+		Voice* victim = nullptr;
+		for (Voice& voice : voices_) {
+			if (voice.priority > request.priority) {
+				continue;
+			}
+			if (victim == nullptr || voice.priority < victim->priority
+				|| (voice.priority == victim->priority && voice.startSerial < victim->startSerial)) {
+				victim = &voice;
+			}
+		}
+		if (victim == nullptr) {
+			return nullptr;
+		}
+		StopVoice(*victim);
+		return RecreateVoice(*victim, request.format) ? victim : nullptr;
+	}
+
+	void VoicePool::StopVoice(Voice& voice)
+	{
+		// 止めたボイスは使い回さず破棄する（次に使うときに作り直す）
+		backend_->Stop(voice.voiceId);
+		backend_->DestroyVoice(voice.voiceId);
+		voice.voiceId = kInvalidVoiceId;
+		voice.isActive = false;
+		voice.soundKey = nullptr;
+	}
+
+	bool VoicePool::RecreateVoice(Voice& voice, const WaveFormat& format)
+	{
+		if (voice.voiceId != kInvalidVoiceId) {
+			backend_->DestroyVoice(voice.voiceId);
+		}
+		voice.voiceId = backend_->CreateVoice(format);
+		voice.format = format;
+		return voice.voiceId != kInvalidVoiceId;
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "VoiceBackendBase.h"
+
+namespace MyEngine {
+	// VoicePool用の定数
+	namespace VoicePoolConstants {
+		// 同時に存在できるボイス数の上限
+		constexpr uint32_t kDefaultMaxVoiceCount = 32;
+
+		// 再生優先度のデフォルト値（大きいほど優先）
+		constexpr int32_t kDefaultPriority = 0;
+
+		// 同じサウンドを同時に鳴らせる数のデフォルト値
+		constexpr uint32_t kDefaultMaxInstances = 4;
+	}
+
+	// 再生リクエスト
+	struct VoicePlayRequest {
+		// 同時再生数を数えるためのサウンドの識別子（SoundData のアドレスなど）
+		const void* soundKey = nullptr;
+		WaveFormat format{};
+		std::span<const uint8_t> samples;
+		int32_t priority = VoicePoolConstants::kDefaultPriority;
+		uint32_t maxInstances = VoicePoolConstants::kDefaultMaxInstances;
+	};
+
+	/// <summary>
+	/// ボイスプール
+	/// 固定数のボイスをフォーマットごとに使い回し、足りない場合は優先度の低いものを奪って再生する
+	/// </summary>
+	class VoicePool
+	{
+	public:
+		// 初期化（backend は Finalize まで呼び出し側が保持する）
+		void Initialize(VoiceBackendBase* backend, uint32_t maxVoiceCount = VoicePoolConstants::kDefaultMaxVoiceCount);
+
+		// 終了（全ボイスを破棄する）
+		void Finalize();
+
+		// 再生（鳴らせなかった場合は false）
+		bool Play(const VoicePlayRequest& request);
+
+		// 指定サウンドを再生中のボイスをすべて止める（波形を解放する前に呼ぶ）
+		void StopSound(const void* soundKey);
+
+		// 再生し終えたボイスを空きに戻す
+		void Reclaim();
+
+		// ゲッター
+		uint32_t GetVoiceCount() const { return static_cast<uint32_t>(voices_.size()); }
+		uint32_t GetActiveVoiceCount() const;
+		uint32_t GetMaxVoiceCount() const { return maxVoiceCount_; }
+
+	private:
+		// ボイス 1 つ分の状態
+		struct Voice {
+			uint32_t voiceId = VoiceBackendConstants::kInvalidVoiceId;
+			WaveFormat format{};
+			// 再生中の情報（isActive の間だけ有効）
+			bool isActive = false;
+			const void* soundKey = nullptr;
+			int32_t priority = 0;
+			uint64_t startSerial = 0;
+		};
+
+		// 再生に使うボイスを選ぶ（見つからなければ nullptr）
+		Voice* AcquireVoice(const VoicePlayRequest& request);
+
+		// ボイスを止めて空きにする
+		void StopVoice(Voice& voice);
+
+		// ボイスを指定フォーマットで作り直す
+		bool RecreateVoice(Voice& voice, const WaveFormat& format);
+
+		// バックエンド
+		VoiceBackendBase* backend_ = nullptr;
+
+		// 作成済みのボイス
+		std::vector<Voice> voices_;
+
+		// ボイス数の上限
+		uint32_t maxVoiceCount_ = VoicePoolConstants::kDefaultMaxVoiceCount;
+
+		// 再生開始順の通し番号（古いものから奪うため）
+		uint64_t nextSerial_ = 0;
+	};
+}
@@ -0,0 +1,133 @@
+#include "WaveFile.h"
+#include <cstring>
+
+//
+// WaveFile
+// - WAV をメモリマップし、RiffReader の索引から fmt と data をコピーせずに取り出す。
+// - 対応形式：PCM 16bit / PCM 24bit / IEEE float 32bit、モノラル / ステレオ。
+//   WAVE_FORMAT_EXTENSIBLE は SubFormat を見て PCM / float として扱う。
+// - 検証：チャンネル数・ビット数・blockAlign の整合を確認し、対応外なら Parse / Open が false を返す（assert はしない）。
+//   data の末尾が切れている場合はブロック境界までを波形とする。
+// - 不正な入力でも範囲外を読まないことを前提にしているため、壊れたファイルをそのまま渡してよい。
+//
+namespace MyEngine {
+	using namespace WaveFileConstants;
+
+	namespace {
+		// リトルエンディアンの値の読み出し
+		template <typename T>
+		T ReadValue(std::span<const uint8_t> bytes, size_t offset)
+		{
+			T value{};
+			std::memcpy(&value, bytes.data() + offset, sizeof(T));
+			return value;
+		}
+	}
+
+	SampleFormat GetSampleFormat(const WaveFormat& format)
+	{
+		if (format.formatTag == kFormatTagPcm && format.bitsPerSample == 16) {
+			return SampleFormat::Pcm16;
+		}
+		if (format.formatTag == kFormatTagPcm && format.bitsPerSample == 24) {
+			return SampleFormat::Pcm24;
+		}
+		if (format.formatTag == kFormatTagFloat && format.bitsPerSample == 32) {
+			return SampleFormat::Float32;
+		}
+		return SampleFormat::Unknown;
+	}
+
+	bool WaveFile::Open(const std::string& filePath)
+	{
+		Close();
+
+		if (!mappedFile_.Open(filePath)) {
+			return false;
+		}
+		if (!Parse(mappedFile_.GetBytes())) {
+			mappedFile_.Close();
+			return false;
+		}
+		return true;
+	}
+
+	bool WaveFile::Parse(std::span<const uint8_t> bytes)
+	{
+		format_ = {};
+		sampleFormat_ = SampleFormat::Unknown;
+		formatChunk_ = {};
+		samples_ = {};
+
+		if (!riff_.Parse(bytes) || riff_.GetFormType() != RiffConstants::kWaveId) {
+			return false;
+		}
+
+		const RiffChunk* formatChunk = riff_.FindChunk(RiffConstants::kFmtId);
+		const RiffChunk* dataChunk = riff_.FindChunk(RiffConstants::kDataId);
+		if (formatChunk == nullptr || dataChunk == nullptr || !ParseFormat(formatChunk->data)) {
+			format_ = {};
+			sampleFormat_ = SampleFormat::Unknown;
+			return false;
+		}
+
+		formatChunk_ = formatChunk->data;
+		samples_ = dataChunk->data.first(dataChunk->data.size() - dataChunk->data.size() % format_.blockAlign);
+		return true;
+	}
+
+	void WaveFile::Close()
+	{
+		format_ = {};
+		sampleFormat_ = SampleFormat::Unknown;
+		formatChunk_ = {};
+		samples_ = {};
+		riff_ = RiffReader{};
+		mappedFile_.Close();
+	}
+
+	// ===== ヘルパー関数 =====
+
+	bool WaveFile::ParseFormat(std::span<const uint8_t> chunk)
+	{
+		if (chunk.size() < kFormatChunkMinSize) {
+			return false;
+		}
+
+		format_.formatTag = ReadValue<uint16_t>(chunk, 0);
+		format_.channels = ReadValue<uint16_t>(chunk, 2);
+		format_.samplesPerSec = ReadValue<uint32_t>(chunk, 4);
+		format_.avgBytesPerSec = ReadValue<uint32_t>(chunk, 8);
+		format_.blockAlign = ReadValue<uint16_t>(chunk, 12);
+		format_.bitsPerSample = ReadValue<uint16_t>(chunk, 14);
+
+		// WAVE_FORMAT_EXTENSIBLE は SubFormat GUID の先頭 2 バイトが実際のフォーマットタグ
+		if (format_.formatTag == kFormatTagExtensible) {
+			if (chunk.size() < kExtensibleFormatChunkMinSize) {
+				return false;
+			}
+			format_.formatTag = ReadValue<uint16_t>(chunk, kSubFormatOffset);
+		}
+
+		// チャンネル数
+		if (format_.channels < kMinChannelCount || format_.channels > kMaxChannelCount || format_.samplesPerSec == 0) {
+			return false;
+		}
+
+		// サンプル形式
+		sampleFormat_ = MyEngine::GetSampleFormat(format_);
+		if (sampleFormat_ == SampleFormat::Unknown) {
+			return false;
+		}
+
+		// 1 フレームのバイト数が整合しているか
+		if (format_.blockAlign != format_.channels * format_.bitsPerSample / 8) {
+			sampleFormat_ = SampleFormat::Unknown;
+			return false;
+		}
+
+		// 平均バイト数は書き出し側の誤りが多いため計算し直す
+		format_.avgBytesPerSec = format_.samplesPerSec * format_.blockAlign;
+		return true;
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include "MappedFile.h"
+#include "RiffReader.h"
+
+namespace MyEngine {
+	// WaveFile用の定数
+	namespace WaveFileConstants {
+		// fmt チャンクの最小サイズ（WAVEFORMAT + wBitsPerSample）
+		constexpr size_t kFormatChunkMinSize = 16;
+
+		// WAVE_FORMAT_EXTENSIBLE の fmt チャンクの最小サイズと、SubFormat GUID の位置
+		constexpr size_t kExtensibleFormatChunkMinSize = 40;
+		constexpr size_t kSubFormatOffset = 24;
+
+		// フォーマットタグ
+		constexpr uint16_t kFormatTagPcm = 1;
+		constexpr uint16_t kFormatTagFloat = 3;
+		constexpr uint16_t kFormatTagExtensible = 0xFFFE;
+
+		// 対応するチャンネル数
+		constexpr uint16_t kMinChannelCount = 1;
+		constexpr uint16_t kMaxChannelCount = 2;
+	}
+
+	/// <summary>
+	/// WAV の波形フォーマット（WAVEFORMATEX の先頭部分と同じ並び。Windows ヘッダに依存しない）
+	/// WAVE_FORMAT_EXTENSIBLE の場合、formatTag には SubFormat（PCM / float）を入れる
+	/// </summary>
+	struct WaveFormat {
+		uint16_t formatTag = 0;
+		uint16_t channels = 0;
+		uint32_t samplesPerSec = 0;
+		uint32_t avgBytesPerSec = 0;
+		uint16_t blockAlign = 0;
+		uint16_t bitsPerSample = 0;
+
+		bool operator==(const WaveFormat&) const = default;
+	};
+
+	// 対応するサンプル形式
+	enum class SampleFormat {
+		Unknown,
+		Pcm16,
+		Pcm24,
+		Float32,
+	};
+
+	// フォーマットからサンプル形式を求める（対応外なら Unknown。チャンネル数・blockAlign の検証はしない）
+	SampleFormat GetSampleFormat(const WaveFormat& format);
+
+	/// <summary>
+	/// WAV ファイル
+	/// メモリマップしたファイルを RiffReader で索引化し、fmt / data をコピーせずに参照する
+	/// </summary>
+	class WaveFile
+	{
+	public:
+		// ファイルを割り当てて解析する（対応していない形式なら false）
+		bool Open(const std::string& filePath);
+
+		// メモリ上のバイト列を解析する（bytes は呼び出し側が保持する。false なら内容は空）
+		bool Parse(std::span<const uint8_t> bytes);
+
+		// 閉じる
+		void Close();
+
+		// ゲッター
+		bool IsValid() const { return sampleFormat_ != SampleFormat::Unknown; }
+		const WaveFormat& GetFormat() const { return format_; }
+		SampleFormat GetSampleFormat() const { return sampleFormat_; }
+		std::span<const uint8_t> GetFormatChunk() const { return formatChunk_; }
+		std::span<const uint8_t> GetSamples() const { return samples_; }
+		uint32_t GetFrameCount() const { return IsValid() ? static_cast<uint32_t>(samples_.size() / format_.blockAlign) : 0; }
+		const RiffReader& GetRiff() const { return riff_; }
+
+	private:
+		// fmt チャンクの解析と検証
+		bool ParseFormat(std::span<const uint8_t> chunk);
+
+		// ファイルの割り当て
+		MappedFile mappedFile_;
+
+		// チャンクの索引
+		RiffReader riff_;
+
+		// 波形フォーマット
+		WaveFormat format_{};
+		SampleFormat sampleFormat_ = SampleFormat::Unknown;
+
+		// fmt チャンクと波形（ブロック境界に切り詰めたもの）
+		std::span<const uint8_t> formatChunk_;
+		std::span<const uint8_t> samples_;
+	};
+}
@@ -0,0 +1,43 @@
+#include "WaveStreamReader.h"
+#include <algorithm>
+#include <cstring>
+
+//
+// WaveStreamReader
+// - BGM など長い WAV をストリーム再生するためのリーダー。XAudio2 には触れない。
+// - Open で WaveFile がファイルをメモリマップして fmt / data の範囲を求める（チャンクの並びは問わない）。
+// - Read は data の現在位置から呼び出し側のバッファへ blockAlign 単位でコピーする。
+//   マップしたページは触れた分だけ OS が読み込むため、プロセスが確保するのは呼び出し側のバッファ分だけで済む。
+//   ボイスにマップ先を直接渡さないのは、オーディオスレッドでページフォルトを起こさないため。
+// - ストリーム再生（AudioStream）はバックグラウンドスレッドから Read を呼ぶ。1 つのリーダーを複数スレッドで共有しないこと。
+//
+namespace MyEngine {
+
+	bool WaveStreamReader::Open(const std::string& filePath)
+	{
+		readPosition_ = 0;
+		return waveFile_.Open(filePath);
+	}
+
+	void WaveStreamReader::Close()
+	{
+		waveFile_.Close();
+		readPosition_ = 0;
+	}
+
+	size_t WaveStreamReader::Read(std::span<uint8_t> destination)
+	{
+		if (!IsOpen() || IsEnd()) {
+			return 0;
+		}
+
+		// 残りサイズとバッファサイズの小さい方を、ブロック境界に揃えて読む
+		const std::span<const uint8_t> samples = waveFile_.GetSamples().subspan(readPosition_);
+		size_t size = (std::min)(destination.size(), samples.size());
+		size -= size % GetFormat().blockAlign;
+
+		std::memcpy(destination.data(), samples.data(), size);
+		readPosition_ += size;
+		return size;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <string>
+#include "WaveFile.h"
+
+namespace MyEngine {
+	// WaveStreamReader用の定数
+	namespace WaveStreamConstants {
+		// 1 回の読み込みで読む最大バイト数（ストリーム再生のバッファ 1 つ分）
+		constexpr size_t kStreamChunkBytes = 64 * 1024;
+
+		// ストリーム再生でボイスに積んでおくバッファ数
+		constexpr uint32_t kStreamBufferCount = 3;
+	}
+
+	/// <summary>
+	/// WAV ストリームリーダー
+	/// ファイルをメモリマップして data チャンクの範囲だけを覚え、波形は呼び出し側のバッファへ少しずつ読み出す
+	/// </summary>
+	class WaveStreamReader
+	{
+	public:
+		// ファイルを開いてヘッダを解析する（対応していない形式なら false）
+		bool Open(const std::string& filePath);
+
+		// ファイルを閉じる
+		void Close();
+
+		// 波形を destination に読み出す（blockAlign の倍数に切り詰める）。戻り値は読んだバイト数で、0 なら終端
+		size_t Read(std::span<uint8_t> destination);
+
+		// data チャンクの先頭に戻る
+		void Rewind() { readPosition_ = 0; }
+
+		// ゲッター
+		bool IsOpen() const { return waveFile_.IsValid(); }
+		bool IsEnd() const { return readPosition_ >= waveFile_.GetSamples().size(); }
+		const WaveFormat& GetFormat() const { return waveFile_.GetFormat(); }
+		uint32_t GetDataSize() const { return static_cast<uint32_t>(waveFile_.GetSamples().size()); }
+
+	private:
+		// メモリマップした WAV
+		WaveFile waveFile_;
+
+		// data チャンク内の読み込み位置
+		size_t readPosition_ = 0;
+	};
+}
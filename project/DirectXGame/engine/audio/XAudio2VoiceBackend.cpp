@@ -0,0 +1,88 @@
+#include "XAudio2VoiceBackend.h"
+#include "AudioStream.h"
+#include <cassert>
+
+//
+// XAudio2VoiceBackend
+// - VoicePool から使う XAudio2 のソースボイスの作成・再生・停止。
+// - 再生中かどうかは GetState の BuffersQueued で判定する（コールバックは使わない）。
+// - Stop は FlushSourceBuffers まで行うが、破棄はオーディオスレッドで非同期に行われるため、
+//   VoicePool は止めたボイスを使い回さずに DestroyVoice する。
+//
+namespace MyEngine {
+	using namespace VoiceBackendConstants;
+
+	XAudio2VoiceBackend::XAudio2VoiceBackend(IXAudio2* xAudio2)
+		: xAudio2_(xAudio2)
+	{
+		assert(xAudio2_ != nullptr && "XAudio2 is not initialized!");
+	}
+
+	XAudio2VoiceBackend::~XAudio2VoiceBackend()
+	{
+		for (IXAudio2SourceVoice* sourceVoice : sourceVoices_) {
+			if (sourceVoice) {
+				sourceVoice->DestroyVoice();
+			}
+		}
+	}
+
+	uint32_t XAudio2VoiceBackend::CreateVoice(const WaveFormat& format)
+	{
+		const WAVEFORMATEX wfex = MakeWaveFormatEx(format);
+
+		IXAudio2SourceVoice* sourceVoice = nullptr;
+		if (FAILED(xAudio2_->CreateSourceVoice(&sourceVoice, &wfex))) {
+			return kInvalidVoiceId;
+		}
+
+		// 空いているIDを再利用する
+		if (!freeVoiceIds_.empty()) {
+			const uint32_t voiceId = freeVoiceIds_.back();
+			freeVoiceIds_.pop_back();
+			sourceVoices_[voiceId] = sourceVoice;
+			return voiceId;
+		}
+		sourceVoices_.push_back(sourceVoice);
+		return static_cast<uint32_t>(sourceVoices_.size() - 1);
+	}
+
+	void XAudio2VoiceBackend::DestroyVoice(uint32_t voiceId)
+	{
+		assert(voiceId < sourceVoices_.size() && sourceVoices_[voiceId] != nullptr);
+
+		sourceVoices_[voiceId]->DestroyVoice();
+		sourceVoices_[voiceId] = nullptr;
+		freeVoiceIds_.push_back(voiceId);
+	}
+
+	void XAudio2VoiceBackend::Start(uint32_t voiceId, std::span<const uint8_t> samples)
+	{
+		IXAudio2SourceVoice* sourceVoice = sourceVoices_[voiceId];
+
+		XAUDIO2_BUFFER buffer{};
+		buffer.pAudioData = samples.data();
+		buffer.AudioBytes = static_cast<UINT32>(samples.size());
+		buffer.Flags = XAUDIO2_END_OF_STREAM;
+
+		HRESULT hr = sourceVoice->SubmitSourceBuffer(&buffer);
+		assert(SUCCEEDED(hr));
+		hr = sourceVoice->Start();
+		assert(SUCCEEDED(hr));
+		(void)hr;
+	}
+
+	void XAudio2VoiceBackend::Stop(uint32_t voiceId)
+	{
+		IXAudio2SourceVoice* sourceVoice = sourceVoices_[voiceId];
+		sourceVoice->Stop();
+		sourceVoice->FlushSourceBuffers();
+	}
+
+	bool XAudio2VoiceBackend::IsPlaying(uint32_t voiceId) const
+	{
+		XAUDIO2_VOICE_STATE state{};
+		sourceVoices_[voiceId]->GetState(&state, XAUDIO2_VOICE_NOSAMPLESPLAYED);
+		return state.BuffersQueued > 0;
+	}
+}
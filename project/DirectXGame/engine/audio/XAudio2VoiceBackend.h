@@ -0,0 +1,35 @@
+#pragma once
+#include <xaudio2.h>
+#include <vector>
+#include "VoiceBackendBase.h"
+
+namespace MyEngine {
+
+	/// <summary>
+	/// XAudio2 のソースボイスを使うボイスバックエンド
+	/// </summary>
+	class XAudio2VoiceBackend : public VoiceBackendBase
+	{
+	public:
+		// コンストラクタ・デストラクタ
+		explicit XAudio2VoiceBackend(IXAudio2* xAudio2);
+		~XAudio2VoiceBackend() override;
+
+		// VoiceBackendBase
+		uint32_t CreateVoice(const WaveFormat& format) override;
+		void DestroyVoice(uint32_t voiceId) override;
+		void Start(uint32_t voiceId, std::span<const uint8_t> samples) override;
+		void Stop(uint32_t voiceId) override;
+		bool IsPlaying(uint32_t voiceId) const override;
+
+	private:
+		// XAudio2
+		IXAudio2* xAudio2_ = nullptr;
+
+		// ボイスIDをインデックスとするソースボイス（破棄したものは nullptr）
+		std::vector<IXAudio2SourceVoice*> sourceVoices_;
+
+		// 破棄済みで再利用できるボイスID
+		std::vector<uint32_t> freeVoiceIds_;
+	};
+}
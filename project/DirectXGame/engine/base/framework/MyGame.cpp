@@ -1,4 +1,5 @@
 #include "MyGame.h"
+#include <FrameArena.h>
 
 namespace MyEngine {
 
@@ -22,6 +23,12 @@ namespace MyEngine {
 		// ゲームプレイシーンの更新
 		sceneManager_->DrawImGui();
 
+		// フレームアリーナとヒープ確保回数
+		FrameArena::GetInstance()->DrawImGui();
+
+		// サブシステム別のメモリ統計
+		imGuiManager_->DrawMemoryStats();
+
 #endif
 		imGuiManager_->End();
 
@@ -1,13 +1,30 @@
 #include "SRFramework.h"
 #include "TitleScene.h"
 #include <GetNowTimeInSeconds.h>
+#include <AssetLoader.h>
+#include <JobSystem.h>
+#include <FrameArena.h>
+#include <AllocationCounter.h>
+#include <MemoryReport.h>
+#include <Object3dRenderQueue.h>
+#include <LightManager.h>
 
 namespace MyEngine {
+	namespace {
+		// 起動時に読み込むアセットのマニフェスト（寿命は Global）
+		constexpr const char* kBootManifestName = "common";
+	}
+
 	void SRFramework::Initialize()
 	{
 		// COMの初期化
 		CoInitializeEx(0, COINIT_MULTITHREADED);
 
+		// ジョブシステムの初期化（ワーカースレッドの起動。このスレッドがメインスレッドになる）
+		JobSystem::GetInstance()->Initialize();
+
+		// フレームアリーナの初期化（1 フレームで使い捨てる一時データ用）
+		FrameArena::GetInstance()->Initialize();
 
 
 		// WindowsAPIの初期化
@@ -35,27 +52,15 @@ namespace MyEngine {
 			srvManager_->CreateDepthSRV(DirectXCommon::GetInstance()->GetDepthResource());
 
 		
-		// テクスチャを事前にロード
-		TextureManager::GetInstance()->LoadTexture("resources/uvChecker.png");
-		TextureManager::GetInstance()->LoadTexture("resources/monsterBall.png");
-		TextureManager::GetInstance()->LoadTexture("resources/mori.png");
-		TextureManager::GetInstance()->LoadTexture("resources/mori_Red.png");
-		TextureManager::GetInstance()->LoadTexture("resources/circle2.png");
-		TextureManager::GetInstance()->LoadTexture("resources/gradationLine.png");
-		TextureManager::GetInstance()->LoadTexture("resources/player.png");
-		TextureManager::GetInstance()->LoadTexture("resources/Boss.png");
-		TextureManager::GetInstance()->LoadTexture("resources/player_bullet.png");
-		TextureManager::GetInstance()->LoadTexture("resources/white.png");
-		TextureManager::GetInstance()->LoadTexture("resources/backGround.png");
-		TextureManager::GetInstance()->LoadTexture("resources/fadeWhite.png");
-		TextureManager::GetInstance()->LoadTexture("resources/BackToTitle.png");
-		TextureManager::GetInstance()->LoadTexture("resources/Black.png");
-		TextureManager::GetInstance()->LoadTexture("resources/Dock.png");
-		TextureManager::GetInstance()->LoadTexture("resources/fog.png");
-		TextureManager::GetInstance()->LoadTexture("resources/StageClear.png");
-		TextureManager::GetInstance()->LoadTexture("resources/PressSpaceKey.png");
-		TextureManager::GetInstance()->LoadTexture("resources/ChargeRod.png");
-		TextureManager::GetInstance()->LoadTexture("resources/ChargeGauge.png");
+		// 3Dモデルマネージャの初期化（マニフェストのモデルを登録できるよう先に行う）
+		ModelManager::GetInstance()->Initialize();
+
+		// 非同期アセットローダーの初期化
+		AssetLoader::GetInstance()->Initialize();
+
+		// 起動直後から必要なアセット（スプライト・パーティクル・フェードで使用）はデコードを並列化して待つ
+		// シーンごとのアセットは SceneManager がシーン切り替え時に読み込む
+		AssetLoader::GetInstance()->PreloadManifest(kBootManifestName);
 
 		// スプライト共通部の初期化
 
@@ -65,20 +70,11 @@ namespace MyEngine {
 		// 3Dオブジェクト共通部の初期化
 		Object3dCommon::GetInstance()->Initialize(srvManager_.get());
 
+		// ライトとカメラの共通の定数バッファの初期化（Object3d の初期化より前に行う）
+		LightManager::GetInstance()->Initialize(DirectXCommon::GetInstance());
 
-		// 3Dモデルマネージャの初期化
-		ModelManager::GetInstance()->Initialize();
-
-		// .objファイルからモデルを読み込む
-		ModelManager::GetInstance()->LoadModel("plane.obj");
-		ModelManager::GetInstance()->LoadModel("axis.obj");
-		ModelManager::GetInstance()->LoadModel("BackToTitle.obj"); // ←追加
-		ModelManager::GetInstance()->LoadModel("testCube.obj");
-		ModelManager::GetInstance()->LoadModel("testGround.obj");
-		ModelManager::GetInstance()->LoadModel("Dock.obj");
-		// 弾用モデルを事前にロード
-		ModelManager::GetInstance()->LoadModel("player_bullet.obj"); // ←追加
-
+		// 3Dオブジェクトの描画キューの初期化（インスタンシング用のバッファを作る）
+		Object3dRenderQueue::GetInstance()->Initialize(srvManager_.get());
 
 
 		Input::GetInstance()->Initialize(winApp_.get());
@@ -121,7 +117,8 @@ namespace MyEngine {
 		sceneManager_ = std::make_unique<SceneManager>();
 		sceneManager_->Initialize(winApp_.get());
 
-		
+		// フレームの更新処理のタスクグラフ
+		BuildFrameGraph();
 	}
 
 	void SRFramework::Finelize()
@@ -139,6 +136,9 @@ namespace MyEngine {
 		CloseHandle(DirectXCommon::GetInstance()->GetFenceEvent());
 
 
+		// 非同期アセットローダーの終了（ワーカースレッドの停止）
+		AssetLoader::GetInstance()->Finalize();
+
 		// テクスチャマネージャの終了
 		TextureManager::GetInstance()->Finalize();
 		// 3Dモデルマネージャの終了
@@ -147,6 +147,12 @@ namespace MyEngine {
 		// パーティクルマネージャの終了
 		ParticleManager::GetInstance()->Finalize();
 
+		// ジョブシステムの終了（ワーカースレッドの停止）
+		JobSystem::GetInstance()->Finalize();
+
+		// フレームアリーナの終了
+		FrameArena::GetInstance()->Finalize();
+
 	}
 
 	void SRFramework::Update()
@@ -154,18 +160,40 @@ namespace MyEngine {
 		MSG msg{};
 		// ウィンドウの×ボタンが押されるまでループ
 
+		// ヒープ確保の計測を次のフレームに進め、フレームアリーナを切り替える（2 フレーム前の一時データを解放する）
+		AllocationCounter::BeginFrame();
+		FrameArena::GetInstance()->BeginFrame();
+
 		// Windowsのメッセージ処理
 		if (winApp_->ProcessMessage()) {
 			// ゲームループを抜ける
 			endRequest_ = true;
 		}
-		// シーンマネージャの更新
-		sceneManager_->Update();
-		camera_->Update();
+		// アセット登録・シーン・カメラ・パーティクルの更新
+		frameGraph_.Execute();
+	}
+
+	void SRFramework::BuildFrameGraph()
+	{
+		// 非同期読み込みが完了したアセットのGPU登録
+		frameGraph_.AddTask("AssetUpload", {}, { "GpuResources" }, []() { AssetLoader::GetInstance()->Update(); });
+
+		// シーンマネージャの更新（シーン内の更新はシーン自身のタスクグラフで並列化される）
+		frameGraph_.AddTask("Scene", { "GpuResources", "FrameworkCamera" }, { "Scene", "Particles", "PostEffects" }, [this]() { sceneManager_->Update(); });
 
-		PostEffectManager::GetInstance()->SetTimeParams(GetNowTimeInSeconds());
-		// パーティクルマネージャの更新
-		ParticleManager::GetInstance()->Update();
+		// カメラの更新
+		frameGraph_.AddTask("Camera", {}, { "FrameworkCamera" }, [this]() { camera_->Update(); });
+
+		// ライトとカメラの位置を共通の定数バッファに書き込む（シーンとカメラの更新後に 1 回だけ）
+		frameGraph_.AddTask("Lighting", { "Scene", "FrameworkCamera" }, { "Lighting" }, []() { LightManager::GetInstance()->Update(Object3dCommon::GetInstance()->GetDefaultCamera()); });
+
+		// ポストエフェクトの時間
+		frameGraph_.AddTask("PostEffectTime", {}, { "PostEffects" }, []() { PostEffectManager::GetInstance()->SetTimeParams(GetNowTimeInSeconds()); });
+
+		// パーティクルマネージャの更新（インスタンシング用バッファへの書き込みのみなのでワーカーで実行する）
+		frameGraph_.AddTask("Particles", { "FrameworkCamera" }, { "Particles" }, []() { ParticleManager::GetInstance()->Update(); }, TaskAffinity::AnyThread);
+
+		frameGraph_.Compile();
 	}
 
 	void SRFramework::PreDraw()
@@ -183,6 +211,8 @@ namespace MyEngine {
 
 		srvManager_->PreDraw();
 
+		// 描画キューのインスタンスバッファを先頭から使い直す（前フレームの GPU 処理は PostDraw で待ち終わっている）
+		Object3dRenderQueue::GetInstance()->BeginFrame();
 	}
 
 	void SRFramework::PostDraw()
@@ -227,6 +257,10 @@ namespace MyEngine {
 			// 描画
 			Draw();
 		}
+		// メモリ統計の書き出し（起動引数で指定されたとき。解放前の確保中バイト数を残す）
+		if (!memoryStatsDumpPath_.empty()) {
+			MemoryReport::WriteJson(memoryStatsDumpPath_);
+		}
 		// ゲームの終了
 		Finelize();
 	}
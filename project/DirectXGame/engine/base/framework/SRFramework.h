@@ -46,6 +46,7 @@
 #include "NoisePostEffect.h"
 #include "PostEffectManager.h"
 #include "GrayscalePostEffect.h"
+#include "FrameTaskGraph.h"
 
 #pragma comment(lib,"xaudio2.lib")
 
@@ -95,11 +96,21 @@ namespace MyEngine {
 		// 実行
 		void Run();
 
+		// 終了時にメモリ統計を書き出すファイル（空なら書き出さない）
+		void SetMemoryStatsDumpPath(const std::string& filePath) { memoryStatsDumpPath_ = filePath; }
+
 		/*------ゲッター------*/
 
 		// winappの取得
 		WinApp* GetWinApp() const { return winApp_.get(); }
 
+		// フレームの更新処理のタスクグラフの取得
+		const FrameTaskGraph& GetFrameGraph() const { return frameGraph_; }
+
+	private:
+		// フレームの更新処理のタスクグラフを組み立てる
+		void BuildFrameGraph();
+
 	protected:
 		// メンバ変数
 		// ポインタ
@@ -120,5 +131,11 @@ namespace MyEngine {
 		std::unique_ptr<GrayscalePostEffect> grayscalePostEffect_ = nullptr;
 
 		DirectXCommon* dxCommon_ = nullptr;
+
+		// フレームの更新処理のタスクグラフ（アセット登録 → シーン → カメラ → パーティクル）
+		FrameTaskGraph frameGraph_;
+
+		// 終了時のメモリ統計の書き出し先
+		std::string memoryStatsDumpPath_;
 	};
 }
@@ -0,0 +1,309 @@
+#include "FrameTaskGraph.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+#include <format>
+#include <fstream>
+#include <thread>
+
+//
+// FrameTaskGraph
+// - 毎フレームの更新処理を「どのリソースを読み、どのリソースに書くか」を宣言したタスクの集まりとして実行する。
+// - 依存関係（Compile）：追加順に見て、同じリソースに触れるタスク同士にだけ順序を付ける。
+//   * 読む  → そのリソースに最後に書いたタスクの後（書いた結果を読む）
+//   * 書く  → 最後に書いたタスクと、その後に読んだ全タスクの後（読み終わる前に書き換えない）
+//   つまり追加順は元の逐次実行の順番そのままで、リソースを共有しないタスク同士だけが入れ替わり・並列化される。
+// - 実行（Execute）：
+//   * 依存が 0 になったタスクから積む。AnyThread のタスクは JobSystem のジョブにし、
+//     MainThread のタスクはメインスレッド用の待ち行列に入れる。
+//   * メインスレッドは全タスクが終わるまで、待ち行列のタスク → JobSystem のジョブの順に実行し続ける。
+//   * タスクごとに開始時刻・実行時間・スレッド番号を記録する。
+// - クリティカルパス：追加順（= トポロジカル順）に「自分の時間 + 依存の中で最も遅く終わるもの」を求めた最長経路。
+//   ここが 1 フレームの更新時間の下限になるので、短くするならこの上のタスクから手を付ける。
+// - 設計メモ：
+//   * タスクの中から、同じグラフの Execute を呼ばないこと（別のグラフなら入れ子にしてよい）。
+//   * 宣言より多くのものに触るタスクを AnyThread にするとデータ競合になるため、迷ったら MainThread にする。
+//
+namespace MyEngine {
+
+	namespace {
+		// 経過時間（ミリ秒）
+		double ElapsedMilliseconds(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to)
+		{
+			return std::chrono::duration<double, std::milli>(to - from).count();
+		}
+	}
+
+	void FrameTaskGraph::AddTask(const std::string& name,
+		std::initializer_list<std::string_view> reads,
+		std::initializer_list<std::string_view> writes,
+		std::function<void()> function,
+		TaskAffinity affinity)
+	{
+		Task task;
+		task.name = name;
+		for (std::string_view read : reads) {
+			task.reads.push_back(GetResourceId(read));
+		}
+		for (std::string_view write : writes) {
+			task.writes.push_back(GetResourceId(write));
+		}
+		task.function = std::move(function);
+		task.affinity = affinity;
+
+		tasks_.push_back(std::move(task));
+		isCompiled_ = false;
+	}
+
+	void FrameTaskGraph::Compile()
+	{
+		// リソースごとの最後に書いたタスクと、その後に読んだタスク
+		constexpr uint32_t kNoWriter = UINT32_MAX;
+		std::vector<uint32_t> lastWriters(resourceNames_.size(), kNoWriter);
+		std::vector<std::vector<uint32_t>> readersSinceWrite(resourceNames_.size());
+
+		for (Task& task : tasks_) {
+			task.predecessors.clear();
+			task.successors.clear();
+		}
+
+		for (uint32_t taskIndex = 0; taskIndex < tasks_.size(); ++taskIndex) {
+			Task& task = tasks_[taskIndex];
+
+			for (uint32_t resource : task.reads) {
+				if (lastWriters[resource] != kNoWriter) {
+					task.predecessors.push_back(lastWriters[resource]);
+				}
+			}
+			for (uint32_t resource : task.writes) {
+				if (lastWriters[resource] != kNoWriter) {
+					task.predecessors.push_back(lastWriters[resource]);
+				}
+				task.predecessors.insert(task.predecessors.end(), readersSinceWrite[resource].begin(), readersSinceWrite[resource].end());
+			}
+
+			// 自分自身と重複を除く
+			std::erase(task.predecessors, taskIndex);
+			std::sort(task.predecessors.begin(), task.predecessors.end());
+			task.predecessors.erase(std::unique(task.predecessors.begin(), task.predecessors.end()), task.predecessors.end());
+			for (uint32_t predecessor : task.predecessors) {
+				tasks_[predecessor].successors.push_back(taskIndex);
+			}
+
+			// 読み → 書きの順に反映する（読んで書くリソースは、書いた時点で読み手の記録が消える）
+			for (uint32_t resource : task.reads) {
+				readersSinceWrite[resource].push_back(taskIndex);
+			}
+			for (uint32_t resource : task.writes) {
+				lastWriters[resource] = taskIndex;
+				readersSinceWrite[resource].clear();
+			}
+		}
+
+		remainingCounts_ = std::make_unique<std::atomic<uint32_t>[]>(tasks_.size());
+		isCompiled_ = true;
+	}
+
+	void FrameTaskGraph::Execute()
+	{
+		assert(isCompiled_ && "FrameTaskGraph::Compile must be called before Execute!");
+
+		frameStartTime_ = std::chrono::steady_clock::now();
+		JobSystem* jobSystem = JobSystem::GetInstance();
+
+		if (jobSystem->GetThreadCount() == 0) {
+			// ジョブシステムが無ければ追加順に実行する（追加順は常に依存を満たしている）
+			for (uint32_t taskIndex = 0; taskIndex < tasks_.size(); ++taskIndex) {
+				RunTask(taskIndex);
+			}
+		}
+		else {
+			finishedCount_ = 0;
+			for (uint32_t taskIndex = 0; taskIndex < tasks_.size(); ++taskIndex) {
+				remainingCounts_[taskIndex] = static_cast<uint32_t>(tasks_[taskIndex].predecessors.size());
+			}
+			for (uint32_t taskIndex = 0; taskIndex < tasks_.size(); ++taskIndex) {
+				if (tasks_[taskIndex].predecessors.empty()) {
+					Schedule(taskIndex);
+				}
+			}
+
+			// 全タスクが終わるまで、メインスレッド用のタスクとジョブを実行し続ける
+			while (finishedCount_.load(std::memory_order_acquire) < tasks_.size()) {
+				uint32_t taskIndex = 0;
+				bool hasMainTask = false;
+				{
+					std::lock_guard<std::mutex> lock(mainReadyMutex_);
+					if (!mainReadyTasks_.empty()) {
+						taskIndex = mainReadyTasks_.back();
+						mainReadyTasks_.pop_back();
+						hasMainTask = true;
+					}
+				}
+
+				if (hasMainTask) {
+					RunTask(taskIndex);
+					FinishTask(taskIndex);
+				}
+				else if (!jobSystem->ExecutePendingJob()) {
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		lastFrameMs_ = ElapsedMilliseconds(frameStartTime_, std::chrono::steady_clock::now());
+	}
+
+	void FrameTaskGraph::Clear()
+	{
+		tasks_.clear();
+		resourceNames_.clear();
+		remainingCounts_.reset();
+		mainReadyTasks_.clear();
+		isCompiled_ = false;
+	}
+
+	std::string FrameTaskGraph::Dump() const
+	{
+		const auto joinNames = [](const std::vector<uint32_t>& indices, const auto& getName) {
+			std::string result;
+			for (uint32_t index : indices) {
+				result += result.empty() ? "" : ", ";
+				result += getName(index);
+			}
+			return result.empty() ? std::string("-") : result;
+		};
+		const auto resourceName = [this](uint32_t index) { return resourceNames_[index]; };
+		const auto taskName = [this](uint32_t index) { return tasks_[index].name; };
+
+		std::string text = std::format("FrameTaskGraph: {} tasks, {} resources, last frame {:.3f} ms\n",
+			tasks_.size(), resourceNames_.size(), lastFrameMs_);
+
+		for (uint32_t taskIndex = 0; taskIndex < tasks_.size(); ++taskIndex) {
+			const Task& task = tasks_[taskIndex];
+			text += std::format("[{}] {} ({}) start {:.3f} ms, {:.3f} ms, thread {}\n",
+				taskIndex, task.name, task.affinity == TaskAffinity::MainThread ? "main" : "any",
+				task.startMs, task.durationMs, task.threadIndex);
+			text += std::format("    reads : {}\n", joinNames(task.reads, resourceName));
+			text += std::format("    writes: {}\n", joinNames(task.writes, resourceName));
+			text += std::format("    after : {}\n", joinNames(task.predecessors, taskName));
+		}
+
+		const std::vector<uint32_t> criticalPath = GetCriticalPath();
+		std::string pathText;
+		for (uint32_t taskIndex : criticalPath) {
+			pathText += pathText.empty() ? "" : " -> ";
+			pathText += tasks_[taskIndex].name;
+		}
+		text += std::format("critical path ({:.3f} ms): {}\n", GetCriticalPathMilliseconds(), pathText.empty() ? "-" : pathText);
+		return text;
+	}
+
+	bool FrameTaskGraph::WriteDump(const std::string& filePath) const
+	{
+		std::ofstream file(filePath, std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		file << Dump();
+		return true;
+	}
+
+	std::vector<uint32_t> FrameTaskGraph::GetCriticalPath() const
+	{
+		if (tasks_.empty() || !isCompiled_) {
+			return {};
+		}
+
+		// 未計測ならタスク数で数える
+		const bool isMeasured = std::any_of(tasks_.begin(), tasks_.end(), [](const Task& task) { return task.durationMs > 0.0; });
+
+		// 追加順はトポロジカル順なので、前から順に最も遅く終わる依存をたどる
+		constexpr uint32_t kNoPredecessor = UINT32_MAX;
+		std::vector<double> finishTimes(tasks_.size(), 0.0);
+		std::vector<uint32_t> slowestPredecessors(tasks_.size(), kNoPredecessor);
+		for (uint32_t taskIndex = 0; taskIndex < tasks_.size(); ++taskIndex) {
+			const Task& task = tasks_[taskIndex];
+			double startTime = 0.0;
+			for (uint32_t predecessor : task.predecessors) {
+				if (slowestPredecessors[taskIndex] == kNoPredecessor || finishTimes[predecessor] > startTime) {
+					startTime = finishTimes[predecessor];
+					slowestPredecessors[taskIndex] = predecessor;
+				}
+			}
+			finishTimes[taskIndex] = startTime + (isMeasured ? task.durationMs : 1.0);
+		}
+
+		// 最も遅く終わるタスクから逆にたどる
+		uint32_t taskIndex = static_cast<uint32_t>(std::max_element(finishTimes.begin(), finishTimes.end()) - finishTimes.begin());
+		std::vector<uint32_t> path;
+		while (taskIndex != kNoPredecessor) {
+			path.push_back(taskIndex);
+			taskIndex = slowestPredecessors[taskIndex];
+		}
+		std::reverse(path.begin(), path.end());
+		return path;
+	}
+
+	double FrameTaskGraph::GetCriticalPathMilliseconds() const
+	{
+		double total = 0.0;
+		for (uint32_t taskIndex : GetCriticalPath()) {
+			total += tasks_[taskIndex].durationMs;
+		}
+		return total;
+	}
+
+	// ===== ヘルパー関数 =====
+
+	uint32_t FrameTaskGraph::GetResourceId(std::string_view name)
+	{
+		const auto it = std::find(resourceNames_.begin(), resourceNames_.end(), name);
+		if (it != resourceNames_.end()) {
+			return static_cast<uint32_t>(it - resourceNames_.begin());
+		}
+		resourceNames_.emplace_back(name);
+		return static_cast<uint32_t>(resourceNames_.size() - 1);
+	}
+
+	void FrameTaskGraph::Schedule(uint32_t taskIndex)
+	{
+		if (tasks_[taskIndex].affinity == TaskAffinity::AnyThread) {
+			JobSystem::GetInstance()->Run([this, taskIndex]() {
+				RunTask(taskIndex);
+				FinishTask(taskIndex);
+				});
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mainReadyMutex_);
+		mainReadyTasks_.push_back(taskIndex);
+	}
+
+	void FrameTaskGraph::RunTask(uint32_t taskIndex)
+	{
+		Task& task = tasks_[taskIndex];
+
+		const auto startTime = std::chrono::steady_clock::now();
+		if (task.function) {
+			task.function();
+		}
+		const auto endTime = std::chrono::steady_clock::now();
+
+		task.startMs = ElapsedMilliseconds(frameStartTime_, startTime);
+		task.durationMs = ElapsedMilliseconds(startTime, endTime);
+		const uint32_t threadIndex = JobSystem::GetThreadIndex();
+		task.threadIndex = threadIndex == JobSystemConstants::kInvalidThreadIndex ? JobSystemConstants::kMainThreadIndex : threadIndex;
+	}
+
+	void FrameTaskGraph::FinishTask(uint32_t taskIndex)
+	{
+		// 後続の依存を減らし、0 になったものを積む
+		for (uint32_t successor : tasks_[taskIndex].successors) {
+			if (remainingCounts_[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				Schedule(successor);
+			}
+		}
+		finishedCount_.fetch_add(1, std::memory_order_release);
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MyEngine {
+
+	// FrameTaskGraph用の定数
+	namespace FrameTaskGraphConstants {
+		// 起動引数：タスクグラフとクリティカルパスをファイルに書き出して終了する
+		constexpr const char* kDumpCommand = "--dump-frame-graph";
+
+		// 書き出し先のデフォルト
+		constexpr const char* kDefaultDumpFilePath = "frame_graph.txt";
+	}
+
+	// タスクを実行するスレッド
+	enum class TaskAffinity {
+		MainThread,	// メインスレッドのみ（Input / D3D / ImGui / シーン遷移に触れるもの）
+		AnyThread,	// ワーカースレッドでもよい（自分の書き込み先以外に触れないもの）
+	};
+
+	/// <summary>
+	/// 1 フレーム分の更新処理のタスクグラフ
+	/// 各タスクが読み書きするリソース（名前）を宣言し、そこから依存関係を組み立てて、
+	/// 依存の無いタスク同士を JobSystem で並列に実行する
+	/// </summary>
+	class FrameTaskGraph
+	{
+	public:
+		/*------メンバ関数------*/
+
+		// コンストラクタ・デストラクタ
+		FrameTaskGraph() = default;
+		~FrameTaskGraph() = default;
+
+		// コピー禁止（実行中のジョブが this を保持するため）
+		FrameTaskGraph(const FrameTaskGraph&) = delete;
+		FrameTaskGraph& operator=(const FrameTaskGraph&) = delete;
+
+		// タスクの追加（追加した順が、同じリソースに触れるタスク同士の実行順になる）
+		void AddTask(const std::string& name,
+			std::initializer_list<std::string_view> reads,
+			std::initializer_list<std::string_view> writes,
+			std::function<void()> function,
+			TaskAffinity affinity = TaskAffinity::MainThread);
+
+		// 依存関係の構築（タスクを追加し終えたら 1 度呼ぶ）
+		void Compile();
+
+		// 1 フレーム分の実行（全タスクが終わるまで戻らない。JobSystem が未初期化なら追加順に順番に実行する）
+		void Execute();
+
+		// 全タスクの削除
+		void Clear();
+
+		// タスク・依存関係・直前の計測値・クリティカルパスを文字列にする
+		std::string Dump() const;
+
+		// Dump の内容をファイルに書き出す（書き出せなければ false）
+		bool WriteDump(const std::string& filePath) const;
+
+		// クリティカルパス（直前の計測時間で重み付けした最長経路。未計測ならタスク数で数える）
+		std::vector<uint32_t> GetCriticalPath() const;
+
+		/*------ゲッター------*/
+
+		uint32_t GetTaskCount() const { return static_cast<uint32_t>(tasks_.size()); }
+		const std::string& GetTaskName(uint32_t taskIndex) const { return tasks_[taskIndex].name; }
+		// 直前の実行時間（ミリ秒）と実行したスレッド番号
+		double GetTaskMilliseconds(uint32_t taskIndex) const { return tasks_[taskIndex].durationMs; }
+		uint32_t GetTaskThreadIndex(uint32_t taskIndex) const { return tasks_[taskIndex].threadIndex; }
+		// 直前の Execute 全体の時間（ミリ秒）
+		double GetLastFrameMilliseconds() const { return lastFrameMs_; }
+		// クリティカルパス上のタスクの合計時間（ミリ秒）
+		double GetCriticalPathMilliseconds() const;
+
+	private:
+		/*------構造体------*/
+
+		// タスク 1 つ分
+		struct Task {
+			std::string name;
+			std::vector<uint32_t> reads;
+			std::vector<uint32_t> writes;
+			std::function<void()> function;
+			TaskAffinity affinity = TaskAffinity::MainThread;
+			// 依存（先に終わっている必要があるタスク）と後続
+			std::vector<uint32_t> predecessors;
+			std::vector<uint32_t> successors;
+			// 直前の計測値（フレーム開始からの開始時刻と実行時間）
+			double startMs = 0.0;
+			double durationMs = 0.0;
+			uint32_t threadIndex = 0;
+		};
+
+		/*------プライベートメンバ関数------*/
+
+		// リソース名を番号にする（初出なら登録する）
+		uint32_t GetResourceId(std::string_view name);
+
+		// 実行可能になったタスクを積む
+		void Schedule(uint32_t taskIndex);
+
+		// タスクの実行と計測
+		void RunTask(uint32_t taskIndex);
+
+		// 後続への通知（依存が 0 になったものを積み、終了数を進める）
+		void FinishTask(uint32_t taskIndex);
+
+		/*------メンバ変数------*/
+
+		std::vector<Task> tasks_;
+		std::vector<std::string> resourceNames_;
+		bool isCompiled_ = false;
+
+		// 実行中の状態（タスクごとの残り依存数、終了数、メインスレッド用の実行待ち）
+		std::unique_ptr<std::atomic<uint32_t>[]> remainingCounts_;
+		std::atomic<uint32_t> finishedCount_ = 0;
+		std::mutex mainReadyMutex_;
+		std::vector<uint32_t> mainReadyTasks_;
+
+		// 計測
+		std::chrono::steady_clock::time_point frameStartTime_;
+		double lastFrameMs_ = 0.0;
+	};
+}
@@ -0,0 +1,301 @@
+#include "JobSystem.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cassert>
+#include <string>
+
+//
+// JobSystem
+// - 固定数のワーカースレッドとメインスレッドでジョブを実行するワークスティーリング方式のジョブシステム。
+// - キュー：
+//   * スレッドごとに 1 本持ち、積んだスレッドのキューに入る（メインスレッドは 0 番）。
+//   * 持ち主は末尾から取り出し（直前に積んだ、キャッシュに残っているジョブから処理する）、
+//     自分のキューが空のときは他のスレッドのキューの先頭から盗む（古い、大きめのジョブを持っていく）。
+//   * キューはスレッドごとの mutex で守る。持ち主以外が触るのは盗むときだけなので、競合はほとんど起きない。
+// - 完了カウンタ（JobCounter）：
+//   * Run で増やし、ジョブの終了で減らす。Wait は 0 になるまで他のジョブを実行しながら待つため、
+//     ジョブの中から Wait してもスレッドが止まらない（デッドロックしない）。
+//   * RunAfter の後続ジョブはカウンタに預けておき、0 にしたスレッドがまとめてキューに積む。
+//     減算と預け入れを同じロックで行うことで、0 になった直後に預けたジョブが取り残されないようにしている。
+// - 休止：積まれたジョブ数が 0 の間、ワーカーは条件変数で眠る。積む側は眠っているワーカーがいるときだけ起こす。
+// - 作業用メモリ：スレッドごとに ScratchAllocator を持ち、ジョブ 1 つが終わるたびに開始時の位置へ巻き戻す。
+// - メモリタグ：積んだスレッドの MemoryTag をジョブに記録し、実行中はそのタグで数える（並列化してもサブシステム別の集計が変わらない）。
+// - 設計メモ：
+//   * Run / Wait / ParallelFor はメインスレッドとワーカースレッドからのみ呼べる（AssetLoader のワーカーなどからは不可）。
+//   * ジョブの中で D3D のコマンドリストを触らないこと（コマンドリストはメインスレッドのみが扱う）。
+//
+namespace MyEngine {
+	using namespace JobSystemConstants;
+
+	namespace {
+		// 現在のスレッドのスレッド番号
+		thread_local uint32_t tlsThreadIndex = kInvalidThreadIndex;
+	}
+
+	JobSystem* JobSystem::GetInstance()
+	{
+		static JobSystem instance;
+		return &instance;
+	}
+
+	void JobSystem::Initialize(uint32_t workerCount)
+	{
+		assert(threads_.empty() && "JobSystem is already initialized!");
+
+		// ワーカー数の決定（メインスレッド分を除いたコア数）
+		if (workerCount == 0) {
+			const uint32_t hardwareCount = std::thread::hardware_concurrency();
+			workerCount = std::clamp(hardwareCount > 1 ? hardwareCount - 1 : kMinWorkerCount, kMinWorkerCount, kMaxWorkerCount);
+		}
+
+		// メインスレッドを含めたスレッドごとの状態
+		threads_.reserve(workerCount + 1);
+		for (uint32_t i = 0; i < workerCount + 1; ++i) {
+			auto context = std::make_unique<ThreadContext>();
+			context->scratch.Initialize(kScratchCapacity);
+			threads_.push_back(std::move(context));
+		}
+		tlsThreadIndex = kMainThreadIndex;
+
+		isRunning_ = true;
+		workers_.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; ++i) {
+			workers_.emplace_back(&JobSystem::WorkerMain, this, i + 1);
+		}
+
+		Logger::Log("JobSystem: started " + std::to_string(workerCount) + " worker threads\n");
+	}
+
+	void JobSystem::Finalize()
+	{
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex_);
+			isRunning_ = false;
+		}
+		sleepCondition_.notify_all();
+
+		for (std::thread& worker : workers_) {
+			if (worker.joinable()) {
+				worker.join();
+			}
+		}
+		workers_.clear();
+
+		// 未実行のジョブは破棄
+		threads_.clear();
+		queuedJobCount_ = 0;
+		executedJobCount_ = 0;
+		stolenJobCount_ = 0;
+		tlsThreadIndex = kInvalidThreadIndex;
+	}
+
+	void JobSystem::Run(std::function<void()> function, JobCounter* counter)
+	{
+		if (counter) {
+			counter->count_.fetch_add(1, std::memory_order_relaxed);
+		}
+		Push(Job{ std::move(function), counter, AllocationCounter::GetCurrentTag() });
+	}
+
+	void JobSystem::RunAfter(JobCounter& dependency, std::function<void()> function, JobCounter* counter)
+	{
+		if (counter) {
+			counter->count_.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(dependency.mutex_);
+			if (dependency.count_.load(std::memory_order_acquire) > 0) {
+				// 完了したスレッドが Complete で積む
+				dependency.continuations_.push_back(Job{ std::move(function), counter, AllocationCounter::GetCurrentTag() });
+				return;
+			}
+		}
+
+		// 既に完了している
+		Push(Job{ std::move(function), counter, AllocationCounter::GetCurrentTag() });
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		const uint32_t threadIndex = GetThreadIndex();
+		assert(threadIndex != kInvalidThreadIndex && "Wait must be called from the main thread or a job!");
+
+		while (!counter.IsDone()) {
+			if (!TryExecuteOne(threadIndex)) {
+				std::this_thread::yield();
+			}
+		}
+
+		// 最後に減らしたスレッドがロックを手放すまで待つ（この後 counter が破棄されてもよいように）
+		std::lock_guard<std::mutex> lock(counter.mutex_);
+	}
+
+	bool JobSystem::ExecutePendingJob()
+	{
+		const uint32_t threadIndex = GetThreadIndex();
+		assert(threadIndex != kInvalidThreadIndex && "ExecutePendingJob must be called from the main thread or a job!");
+		return TryExecuteOne(threadIndex);
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& body)
+	{
+		if (count == 0) {
+			return;
+		}
+
+		// 分割の大きさ（自動ならスレッドあたり kChunksPerThread 個に分ける）
+		if (grainSize == 0) {
+			const uint32_t chunkCount = (std::max)(GetThreadCount(), 1u) * kChunksPerThread;
+			grainSize = (std::max)((count + chunkCount - 1) / chunkCount, 1u);
+		}
+
+		// 1 つに収まるなら分割せずにその場で実行する（作業用メモリはジョブと同じく終了時に巻き戻す）
+		if (count <= grainSize) {
+			ScratchScope scratchScope(GetScratch());
+			body(0, count);
+			return;
+		}
+
+		// 先頭の 1 つは自分で実行し、残りをジョブにする
+		JobCounter counter;
+		for (uint32_t begin = grainSize; begin < count; begin += grainSize) {
+			const uint32_t end = (std::min)(begin + grainSize, count);
+			Run([&body, begin, end]() { body(begin, end); }, &counter);
+		}
+		{
+			ScratchScope scratchScope(GetScratch());
+			body(0, grainSize);
+		}
+
+		Wait(counter);
+	}
+
+	ScratchAllocator& JobSystem::GetScratch()
+	{
+		const uint32_t threadIndex = GetThreadIndex();
+		assert(threadIndex < threads_.size() && "GetScratch must be called from the main thread or a job!");
+		return threads_[threadIndex]->scratch;
+	}
+
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return tlsThreadIndex;
+	}
+
+	// ===== ヘルパー関数 =====
+
+	void JobSystem::WorkerMain(uint32_t threadIndex)
+	{
+		tlsThreadIndex = threadIndex;
+
+		while (true) {
+			if (TryExecuteOne(threadIndex)) {
+				continue;
+			}
+
+			// 積まれたジョブが無い間は眠る
+			std::unique_lock<std::mutex> lock(sleepMutex_);
+			sleepingWorkerCount_.fetch_add(1);
+			sleepCondition_.wait(lock, [this]() { return queuedJobCount_.load() > 0 || !isRunning_; });
+			sleepingWorkerCount_.fetch_sub(1);
+			if (!isRunning_) {
+				break;
+			}
+		}
+	}
+
+	void JobSystem::Push(Job job)
+	{
+		const uint32_t threadIndex = GetThreadIndex();
+		assert(threadIndex < threads_.size() && "Jobs must be pushed from the main thread or a job!");
+
+		ThreadContext& context = *threads_[threadIndex];
+		{
+			std::lock_guard<std::mutex> lock(context.mutex);
+			context.jobs.push_back(std::move(job));
+		}
+		queuedJobCount_.fetch_add(1);
+
+		// 眠っているワーカーがいるときだけ起こす
+		// （ワーカーは眠る前に sleepingWorkerCount_ を増やしてから queuedJobCount_ を見るため、どちらかが必ず相手に気付く）
+		if (sleepingWorkerCount_.load() > 0) {
+			{
+				std::lock_guard<std::mutex> lock(sleepMutex_);
+			}
+			sleepCondition_.notify_one();
+		}
+	}
+
+	bool JobSystem::TryExecuteOne(uint32_t threadIndex)
+	{
+		Job job;
+		if (!Pop(threadIndex, job) && !Steal(threadIndex, job)) {
+			return false;
+		}
+		Execute(threadIndex, job);
+		return true;
+	}
+
+	bool JobSystem::Pop(uint32_t threadIndex, Job& job)
+	{
+		ThreadContext& context = *threads_[threadIndex];
+		std::lock_guard<std::mutex> lock(context.mutex);
+		if (context.jobs.empty()) {
+			return false;
+		}
+		job = std::move(context.jobs.back());
+		context.jobs.pop_back();
+		queuedJobCount_.fetch_sub(1);
+		return true;
+	}
+
+	bool JobSystem::Steal(uint32_t threadIndex, Job& job)
+	{
+		// 隣のスレッドから順に見る（全員が 0 番に集中しないように）
+		const uint32_t threadCount = GetThreadCount();
+		for (uint32_t offset = 1; offset < threadCount; ++offset) {
+			ThreadContext& victim = *threads_[(threadIndex + offset) % threadCount];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (victim.jobs.empty()) {
+				continue;
+			}
+			job = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			queuedJobCount_.fetch_sub(1);
+			stolenJobCount_.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	void JobSystem::Execute(uint32_t threadIndex, Job& job)
+	{
+		// ジョブ内で確保した作業用メモリはジョブの終了で解放する
+		{
+			ScratchScope scratchScope(threads_[threadIndex]->scratch);
+			MemoryTagScope memoryTag(job.memoryTag);
+			job.function();
+		}
+		executedJobCount_.fetch_add(1, std::memory_order_relaxed);
+
+		if (job.counter) {
+			Complete(*job.counter);
+		}
+	}
+
+	void JobSystem::Complete(JobCounter& counter)
+	{
+		std::vector<Job> readyJobs;
+		{
+			std::lock_guard<std::mutex> lock(counter.mutex_);
+			if (counter.count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				readyJobs.swap(counter.continuations_);
+			}
+		}
+
+		for (Job& readyJob : readyJobs) {
+			Push(std::move(readyJob));
+		}
+	}
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ScratchAllocator.h"
+#include "AllocationCounter.h"
+
+namespace MyEngine {
+
+	// JobSystem用の定数
+	namespace JobSystemConstants {
+		// ワーカースレッド数の範囲（0指定時はコア数-1をこの範囲に収める）
+		constexpr uint32_t kMinWorkerCount = 1;
+		constexpr uint32_t kMaxWorkerCount = 8;
+
+		// スレッドごとの作業用メモリ
+		constexpr size_t kScratchCapacity = 256 * 1024;
+
+		// ParallelFor で分割数を自動決定するときの、スレッドあたりの分割数
+		constexpr uint32_t kChunksPerThread = 4;
+
+		// メインスレッドのスレッド番号（ワーカーは 1 から）
+		constexpr uint32_t kMainThreadIndex = 0;
+
+		// ジョブシステムに属さないスレッドのスレッド番号
+		constexpr uint32_t kInvalidThreadIndex = UINT32_MAX;
+	}
+
+	class JobCounter;
+
+	// ジョブ（完了時に counter を 1 つ減らす）
+	struct Job {
+		std::function<void()> function;
+		JobCounter* counter = nullptr;
+		// 積んだスレッドのメモリタグ（実行するスレッドに引き継ぐ）
+		MemoryTag memoryTag = MemoryTag::Untagged;
+	};
+
+	/// <summary>
+	/// ジョブの完了カウンタ
+	/// Run でジョブを積むたびに増え、ジョブが終わるたびに減る。0 になったら完了
+	/// RunAfter で積んだ後続ジョブは、このカウンタが 0 になった時点で実行可能になる
+	/// </summary>
+	class JobCounter
+	{
+	public:
+		// コンストラクタ・デストラクタ
+		JobCounter() = default;
+		~JobCounter() = default;
+
+		// コピー・ムーブ禁止（実行中のジョブがアドレスを保持するため）
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		// 完了しているか
+		bool IsDone() const { return count_.load(std::memory_order_acquire) == 0; }
+
+		// 未完了のジョブ数
+		uint32_t GetCount() const { return count_.load(std::memory_order_acquire); }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<uint32_t> count_ = 0;
+
+		// 完了待ちの後続ジョブ（count_ の減算と同じロックで守る）
+		std::mutex mutex_;
+		std::vector<Job> continuations_;
+	};
+
+	/// <summary>
+	/// ワークスティーリング方式のジョブシステム
+	/// スレッドごとのキューに積み、自分のキューが空になったら他のスレッドのキューから盗む
+	/// </summary>
+	class JobSystem
+	{
+	public:
+		/*------メンバ関数------*/
+
+		// シングルトンインスタンス
+		static JobSystem* GetInstance();
+
+		// コンストラクタ・デストラクタ
+		JobSystem() = default;
+		~JobSystem() = default;
+
+		// コピー・ムーブ禁止
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+
+		// 初期化（workerCount = 0 でコア数から自動決定。呼び出したスレッドがメインスレッドになる）
+		void Initialize(uint32_t workerCount = 0);
+
+		// 終了（未実行のジョブは破棄）
+		void Finalize();
+
+		// ジョブを積む（counter があれば完了時に減らす）
+		void Run(std::function<void()> function, JobCounter* counter = nullptr);
+
+		// dependency が完了してから実行するジョブを積む
+		void RunAfter(JobCounter& dependency, std::function<void()> function, JobCounter* counter = nullptr);
+
+		// counter の完了待ち（待っている間は他のジョブを実行する）
+		void Wait(JobCounter& counter);
+
+		// 積まれているジョブを 1 つ実行する（無ければ false。メインスレッドで他の処理を待つ間に呼ぶ）
+		bool ExecutePendingJob();
+
+		// [0, count) を分割して並列に実行し、全て終わるまで待つ
+		// body は (begin, end) の範囲を受け取る。grainSize = 0 で分割数を自動決定
+		void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t begin, uint32_t end)>& body);
+
+		// 現在のスレッドの作業用アロケータ（ジョブの中ではジョブ終了時に自動で巻き戻る）
+		ScratchAllocator& GetScratch();
+
+		/*------ゲッター------*/
+
+		// メインスレッドを含めたスレッド数
+		uint32_t GetThreadCount() const { return static_cast<uint32_t>(threads_.size()); }
+
+		// 現在のスレッド番号（ジョブシステムに属さないスレッドは kInvalidThreadIndex）
+		static uint32_t GetThreadIndex();
+
+		// 実行したジョブ数と、他のスレッドから盗んだジョブ数（累計）
+		uint64_t GetExecutedJobCount() const { return executedJobCount_.load(std::memory_order_relaxed); }
+		uint64_t GetStolenJobCount() const { return stolenJobCount_.load(std::memory_order_relaxed); }
+
+	private:
+		/*------構造体------*/
+
+		// スレッド 1 つ分の状態（キャッシュラインを共有しないように揃える）
+		struct alignas(64) ThreadContext {
+			// ジョブキュー（持ち主は末尾から、盗む側は先頭から取る）
+			std::mutex mutex;
+			std::deque<Job> jobs;
+			// 作業用メモリ
+			ScratchAllocator scratch;
+		};
+
+		/*------プライベートメンバ関数------*/
+
+		// ワーカースレッドの処理
+		void WorkerMain(uint32_t threadIndex);
+
+		// キューに積んで、眠っているワーカーを起こす
+		void Push(Job job);
+
+		// 自分のキューから取り出すか、他のスレッドから盗んで 1 つ実行する（無ければ false）
+		bool TryExecuteOne(uint32_t threadIndex);
+
+		// 自分のキューの末尾から取り出す
+		bool Pop(uint32_t threadIndex, Job& job);
+
+		// 他のスレッドのキューの先頭から盗む
+		bool Steal(uint32_t threadIndex, Job& job);
+
+		// ジョブの実行と完了通知
+		void Execute(uint32_t threadIndex, Job& job);
+
+		// カウンタを減らし、0 になったら後続ジョブを積む
+		void Complete(JobCounter& counter);
+
+		/*------メンバ変数------*/
+
+		// スレッドごとの状態（0 番はメインスレッド）
+		std::vector<std::unique_ptr<ThreadContext>> threads_;
+
+		// ワーカースレッド
+		std::vector<std::thread> workers_;
+
+		// ワーカーの休止（積まれたジョブ数が 0 の間だけ眠る）
+		std::mutex sleepMutex_;
+		std::condition_variable sleepCondition_;
+		std::atomic<uint32_t> queuedJobCount_ = 0;
+		std::atomic<uint32_t> sleepingWorkerCount_ = 0;
+
+		// 統計
+		std::atomic<uint64_t> executedJobCount_ = 0;
+		std::atomic<uint64_t> stolenJobCount_ = 0;
+
+		// 実行中フラグ（sleepMutex_ で守る）
+		bool isRunning_ = false;
+	};
+}
@@ -0,0 +1,46 @@
+#include "ScratchAllocator.h"
+#include <algorithm>
+#include <cassert>
+
+//
+// ScratchAllocator
+// - 固定長バッファの先頭からずらして確保するだけのアロケータ。個別の解放は無く、マーカーまで巻き戻して一括で解放する。
+// - スレッド間で共有しない前提のため、ロックも atomic も使わない（JobSystem がスレッドごとに 1 つ持つ）。
+// - 容量を超えた場合はヒープに逃がさず assert する。作業量の見積もりが間違っていることを早めに知るためで、
+//   GetPeakBytes で実際の最大使用量を確認して容量を決める。
+//
+namespace MyEngine {
+
+	void ScratchAllocator::Initialize(size_t capacity)
+	{
+		buffer_ = std::make_unique<std::byte[]>(capacity);
+		capacity_ = capacity;
+		offset_ = 0;
+		peakBytes_ = 0;
+	}
+
+	void* ScratchAllocator::Allocate(size_t size, size_t alignment)
+	{
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && "Alignment must be a power of two!");
+
+		// バッファのアドレスを含めて揃える（バッファ自体の揃えは max_align_t までしか保証されないため）
+		const uintptr_t base = reinterpret_cast<uintptr_t>(buffer_.get());
+		const uintptr_t alignedAddress = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+		const size_t alignedOffset = static_cast<size_t>(alignedAddress - base);
+
+		if (alignedOffset > capacity_ || size > capacity_ - alignedOffset) {
+			assert(false && "ScratchAllocator is out of memory!");
+			return nullptr;
+		}
+
+		offset_ = alignedOffset + size;
+		peakBytes_ = (std::max)(peakBytes_, offset_);
+		return buffer_.get() + alignedOffset;
+	}
+
+	void ScratchAllocator::Rewind(size_t marker)
+	{
+		assert(marker <= offset_ && "Rewind marker is ahead of the current offset!");
+		offset_ = marker;
+	}
+}
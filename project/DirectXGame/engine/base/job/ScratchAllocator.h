@@ -0,0 +1,78 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace MyEngine {
+
+	/// <summary>
+	/// スレッドごとの作業用リニアアロケータ
+	/// 確保は先頭からずらすだけで、解放はマーカーまで巻き戻して一括で行う
+	/// （ジョブ内の一時配列など、ジョブの終了と同時に不要になるメモリ用）
+	/// </summary>
+	class ScratchAllocator
+	{
+	public:
+		// コンストラクタ・デストラクタ
+		ScratchAllocator() = default;
+		~ScratchAllocator() = default;
+
+		// コピー禁止（確保済みのポインタが指すバッファを所有するため）
+		ScratchAllocator(const ScratchAllocator&) = delete;
+		ScratchAllocator& operator=(const ScratchAllocator&) = delete;
+
+		// 初期化（capacity バイトのバッファを確保する）
+		void Initialize(size_t capacity);
+
+		// 確保（容量が足りなければ assert して nullptr を返す）
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+		// 型付きの配列確保（要素は値初期化しないため、書き込んでから使うこと）
+		template <class T>
+		std::span<T> AllocateArray(size_t count)
+		{
+			T* data = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+			return data ? std::span<T>(data, count) : std::span<T>();
+		}
+
+		// 現在の位置（Rewind に渡して、それ以降の確保をまとめて解放する）
+		size_t GetMarker() const { return offset_; }
+
+		// マーカーまで巻き戻す
+		void Rewind(size_t marker);
+
+		// 全て解放
+		void Reset() { Rewind(0); }
+
+		// ゲッター
+		size_t GetCapacity() const { return capacity_; }
+		size_t GetUsedBytes() const { return offset_; }
+		// これまでの最大使用量（容量の見積もり用）
+		size_t GetPeakBytes() const { return peakBytes_; }
+
+	private:
+		std::unique_ptr<std::byte[]> buffer_;
+		size_t capacity_ = 0;
+		size_t offset_ = 0;
+		size_t peakBytes_ = 0;
+	};
+
+	/// <summary>
+	/// スコープを抜けるときに ScratchAllocator を巻き戻す
+	/// </summary>
+	class ScratchScope
+	{
+	public:
+		explicit ScratchScope(ScratchAllocator& allocator) : allocator_(allocator), marker_(allocator.GetMarker()) {}
+		~ScratchScope() { allocator_.Rewind(marker_); }
+
+		// コピー禁止
+		ScratchScope(const ScratchScope&) = delete;
+		ScratchScope& operator=(const ScratchScope&) = delete;
+
+	private:
+		ScratchAllocator& allocator_;
+		size_t marker_;
+	};
+}
@@ -0,0 +1,324 @@
+#include "AllocationCounter.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+//
+// AllocationCounter
+// - グローバルな operator new / delete を置き換えて、ヒープ確保の回数とバイト数をタグ（サブシステム）別に数える。
+// - 結果は ImGuiManager::DrawMemoryStats（パネル）と MemoryReport（JSON）で見る。
+//   フレームアリーナへ移した一時データの効果（1 フレームあたりの確保回数）もこの値で確認する。
+// - タグ：
+//   * 確保したスレッドの現在のタグ（MemoryTagScope で切り替える thread_local）で数える。
+//     JobSystem はジョブを積んだスレッドのタグをジョブに引き継ぐため、ワーカーで確保したものも同じタグになる。
+//   * 確保ごとに 16 バイトのヘッダを前に付けてサイズとタグを記録し、解放時は確保時のタグから引く。
+//     解放するスレッドのタグが違っても（別のサブシステムが delete しても）、確保中のバイト数がずれない。
+// - 置き換え：
+//   * 通常版・配列版・nothrow 版・サイズ付き delete・アライメント指定版（C++17）を全て置き換える。
+//     どれか 1 つでも漏れると、既定の new で確保したものを置き換えた delete で解放する組み合わせが生まれるため。
+//   * アライメント指定版は、MSVC では _aligned_malloc / _aligned_free の組でしか確保・解放できないため分けている。
+//     ヘッダはアライメント分の余白の末尾に置き、余白の大きさもヘッダに記録する。
+// - 設計メモ：
+//   * カウンタは relaxed の atomic で、計測のための同期はしない（合計値さえ合っていればよい）。
+//     タグごとにキャッシュラインを分けて、別スレッドの別タグの確保が競合しないようにしている。
+//   * 静的初期化より前の確保も数えられるよう、カウンタは定数初期化される atomic にしている。
+//   * malloc / _aligned_malloc を直接使うメモリ（DirectXTex の ScratchImage、ImGui など）と、
+//     D3D12 のリソース（GPU メモリ）は数えられない。
+//   * ENABLE_ALLOCATION_COUNTER が無効なビルド（Release）では置き換えず、既定の new / delete を使う。
+//
+namespace MyEngine {
+
+	const char* GetMemoryTagName(MemoryTag tag)
+	{
+		switch (tag) {
+		case MemoryTag::Untagged:  return "Untagged";
+		case MemoryTag::Particle:  return "Particle";
+		case MemoryTag::Collision: return "Collision";
+		case MemoryTag::Model:     return "Model";
+		case MemoryTag::Texture:   return "Texture";
+		case MemoryTag::Audio:     return "Audio";
+		case MemoryTag::Scene:     return "Scene";
+		default:                   return "Unknown";
+		}
+	}
+
+	namespace AllocationCounter {
+		namespace {
+			// タグ 1 つ分のカウンタ（キャッシュラインを共有しないように揃える）
+			struct alignas(64) TagCounters {
+				std::atomic<uint64_t> allocationCount = 0;
+				std::atomic<uint64_t> allocatedBytes = 0;
+				std::atomic<uint64_t> freeCount = 0;
+				std::atomic<int64_t> liveBytes = 0;
+				std::atomic<int64_t> peakBytes = 0;
+			};
+
+			// フレーム単位の統計（BeginFrame を呼ぶメインスレッドだけが触る）
+			struct FrameCounters {
+				uint64_t frameStartAllocationCount = 0;
+				uint64_t lastFrameAllocationCount = 0;
+				uint64_t peakFrameAllocationCount = 0;
+			};
+
+			std::array<TagCounters, kMemoryTagCount> tagCounters;
+			std::array<FrameCounters, kMemoryTagCount> frameCounters;
+			FrameCounters totalFrameCounters;
+			std::atomic<int64_t> totalLiveBytes = 0;
+			std::atomic<int64_t> totalPeakBytes = 0;
+			uint64_t frameCount = 0;
+
+			// 現在のスレッドのタグ
+			thread_local MemoryTag currentTag = MemoryTag::Untagged;
+		}
+
+#ifdef ENABLE_ALLOCATION_COUNTER
+		namespace {
+			// 確保ごとに返すポインタの直前に置くヘッダ
+			struct alignas(16) AllocationHeader {
+				uint64_t size;
+				// 確保したブロックの先頭から、返したポインタまでのバイト数
+				uint32_t offset;
+				MemoryTag tag;
+			};
+			static_assert(sizeof(AllocationHeader) == 16, "AllocationHeader must keep 16-byte alignment of returned pointers!");
+
+			// 最大値の更新
+			void UpdatePeak(std::atomic<int64_t>& peak, int64_t value)
+			{
+				int64_t current = peak.load(std::memory_order_relaxed);
+				while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+				}
+			}
+
+			void RecordAllocation(AllocationHeader* header, size_t size, size_t offset)
+			{
+				const MemoryTag tag = currentTag;
+				header->size = size;
+				header->offset = static_cast<uint32_t>(offset);
+				header->tag = tag;
+
+				TagCounters& counters = tagCounters[static_cast<uint32_t>(tag)];
+				counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+				counters.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+				const int64_t bytes = static_cast<int64_t>(size);
+				UpdatePeak(counters.peakBytes, counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+				UpdatePeak(totalPeakBytes, totalLiveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+			}
+
+			// 解放の記録（確保したブロックの先頭を返す）
+			void* RecordFree(void* pointer)
+			{
+				AllocationHeader* header = static_cast<AllocationHeader*>(pointer) - 1;
+				TagCounters& counters = tagCounters[static_cast<uint32_t>(header->tag)];
+				counters.freeCount.fetch_add(1, std::memory_order_relaxed);
+				const int64_t bytes = static_cast<int64_t>(header->size);
+				counters.liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+				totalLiveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+				return static_cast<std::byte*>(pointer) - header->offset;
+			}
+
+			void* CountedAllocate(size_t size)
+			{
+				// malloc の戻り値は 16 バイト境界なので、ヘッダ 1 つ分ずらしても揃ったまま
+				std::byte* block = static_cast<std::byte*>(std::malloc(size + sizeof(AllocationHeader)));
+				if (!block) {
+					return nullptr;
+				}
+				std::byte* pointer = block + sizeof(AllocationHeader);
+				RecordAllocation(reinterpret_cast<AllocationHeader*>(pointer) - 1, size, sizeof(AllocationHeader));
+				return pointer;
+			}
+
+			void* CountedAllocateAligned(size_t size, std::align_val_t alignment)
+			{
+				// ヘッダが収まり、返すポインタが揃うだけの余白を先頭に取る
+				const size_t align = (std::max)(static_cast<size_t>(alignment), sizeof(AllocationHeader));
+#ifdef _WIN32
+				std::byte* block = static_cast<std::byte*>(_aligned_malloc(size + align, align));
+#else
+				// aligned_alloc はサイズがアライメントの倍数である必要がある
+				const size_t alignedSize = (size + align + align - 1) & ~(align - 1);
+				std::byte* block = static_cast<std::byte*>(std::aligned_alloc(align, alignedSize));
+#endif
+				if (!block) {
+					return nullptr;
+				}
+				std::byte* pointer = block + align;
+				RecordAllocation(reinterpret_cast<AllocationHeader*>(pointer) - 1, size, align);
+				return pointer;
+			}
+
+			void CountedFree(void* pointer)
+			{
+				if (pointer) {
+					std::free(RecordFree(pointer));
+				}
+			}
+
+			void CountedFreeAligned(void* pointer)
+			{
+				if (pointer) {
+#ifdef _WIN32
+					_aligned_free(RecordFree(pointer));
+#else
+					std::free(RecordFree(pointer));
+#endif
+				}
+			}
+		}
+
+		bool IsEnabled() { return true; }
+#else
+		bool IsEnabled() { return false; }
+#endif
+
+		MemoryTag GetCurrentTag() { return currentTag; }
+		void SetCurrentTag(MemoryTag tag) { currentTag = tag; }
+
+		void BeginFrame()
+		{
+			// 直前のフレームの確保回数を確定し、次のフレームの基準にする
+			const auto advance = [](FrameCounters& frame, uint64_t allocationCount) {
+				frame.lastFrameAllocationCount = allocationCount - frame.frameStartAllocationCount;
+				frame.peakFrameAllocationCount = (std::max)(frame.peakFrameAllocationCount, frame.lastFrameAllocationCount);
+				frame.frameStartAllocationCount = allocationCount;
+			};
+
+			// 起動から最初のフレームまでの確保（初期化）は 1 フレーム分として数えない
+			const bool isFirstFrame = frameCount == 0;
+			for (uint32_t i = 0; i < kMemoryTagCount; ++i) {
+				advance(frameCounters[i], tagCounters[i].allocationCount.load(std::memory_order_relaxed));
+			}
+			advance(totalFrameCounters, GetAllocationCount());
+			if (isFirstFrame) {
+				for (FrameCounters& frame : frameCounters) {
+					frame.lastFrameAllocationCount = 0;
+					frame.peakFrameAllocationCount = 0;
+				}
+				totalFrameCounters.lastFrameAllocationCount = 0;
+				totalFrameCounters.peakFrameAllocationCount = 0;
+			}
+			++frameCount;
+		}
+
+		TagStats GetTagStats(MemoryTag tag)
+		{
+			const uint32_t index = static_cast<uint32_t>(tag);
+			const TagCounters& counters = tagCounters[index];
+			TagStats stats;
+			stats.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+			stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+			stats.allocationCount = counters.allocationCount.load(std::memory_order_relaxed);
+			stats.freeCount = counters.freeCount.load(std::memory_order_relaxed);
+			stats.lastFrameAllocationCount = frameCounters[index].lastFrameAllocationCount;
+			stats.peakFrameAllocationCount = frameCounters[index].peakFrameAllocationCount;
+			return stats;
+		}
+
+		TagStats GetTotalStats()
+		{
+			TagStats stats;
+			stats.liveBytes = totalLiveBytes.load(std::memory_order_relaxed);
+			stats.peakBytes = totalPeakBytes.load(std::memory_order_relaxed);
+			stats.allocationCount = GetAllocationCount();
+			stats.freeCount = GetFreeCount();
+			stats.lastFrameAllocationCount = totalFrameCounters.lastFrameAllocationCount;
+			stats.peakFrameAllocationCount = totalFrameCounters.peakFrameAllocationCount;
+			return stats;
+		}
+
+		uint64_t GetFrameCount() { return frameCount; }
+
+		uint64_t GetAllocationCount()
+		{
+			uint64_t count = 0;
+			for (const TagCounters& counters : tagCounters) {
+				count += counters.allocationCount.load(std::memory_order_relaxed);
+			}
+			return count;
+		}
+
+		uint64_t GetAllocatedBytes()
+		{
+			uint64_t bytes = 0;
+			for (const TagCounters& counters : tagCounters) {
+				bytes += counters.allocatedBytes.load(std::memory_order_relaxed);
+			}
+			return bytes;
+		}
+
+		uint64_t GetFreeCount()
+		{
+			uint64_t count = 0;
+			for (const TagCounters& counters : tagCounters) {
+				count += counters.freeCount.load(std::memory_order_relaxed);
+			}
+			return count;
+		}
+	}
+}
+
+#ifdef ENABLE_ALLOCATION_COUNTER
+
+// ===== グローバル operator new / delete の置き換え =====
+
+using MyEngine::AllocationCounter::CountedAllocate;
+using MyEngine::AllocationCounter::CountedAllocateAligned;
+using MyEngine::AllocationCounter::CountedFree;
+using MyEngine::AllocationCounter::CountedFreeAligned;
+
+void* operator new(size_t size)
+{
+	if (void* pointer = CountedAllocate(size)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	if (void* pointer = CountedAllocate(size)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedAllocate(size); }
+
+void operator delete(void* pointer) noexcept { CountedFree(pointer); }
+void operator delete[](void* pointer) noexcept { CountedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { CountedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { CountedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { CountedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { CountedFree(pointer); }
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	if (void* pointer = CountedAllocateAligned(size, alignment)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	if (void* pointer = CountedAllocateAligned(size, alignment)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return CountedAllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return CountedAllocateAligned(size, alignment); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept { CountedFreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { CountedFreeAligned(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { CountedFreeAligned(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { CountedFreeAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { CountedFreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { CountedFreeAligned(pointer); }
+
+#endif
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+
+// デバッグビルドではグローバルな operator new / delete を置き換えてヒープ確保を数える
+#ifdef _DEBUG
+#define ENABLE_ALLOCATION_COUNTER
+#endif
+
+namespace MyEngine {
+
+	// ヒープ確保の集計先（確保したスレッドの現在のタグで数え、解放時は確保時のタグから引く）
+	enum class MemoryTag : uint8_t {
+		Untagged,
+		Particle,
+		Collision,
+		Model,
+		Texture,
+		Audio,
+		Scene,
+		Count,
+	};
+
+	// タグの数
+	constexpr uint32_t kMemoryTagCount = static_cast<uint32_t>(MemoryTag::Count);
+
+	// タグの表示名
+	const char* GetMemoryTagName(MemoryTag tag);
+
+	/// <summary>
+	/// ヒープ確保の回数・バイト数の計測（タグ別）
+	/// ENABLE_ALLOCATION_COUNTER が無効なビルドでは全て 0 を返す
+	/// </summary>
+	namespace AllocationCounter {
+
+		// タグ 1 つ分の統計
+		struct TagStats {
+			// 確保中のバイト数と、その最大値
+			int64_t liveBytes = 0;
+			int64_t peakBytes = 0;
+			// 起動からの確保・解放回数
+			uint64_t allocationCount = 0;
+			uint64_t freeCount = 0;
+			// 直前のフレームの確保回数と、1 フレームの最大確保回数
+			uint64_t lastFrameAllocationCount = 0;
+			uint64_t peakFrameAllocationCount = 0;
+		};
+
+		// 計測が有効か
+		bool IsEnabled();
+
+		// 現在のスレッドのタグ（MemoryTagScope で切り替える）
+		MemoryTag GetCurrentTag();
+		void SetCurrentTag(MemoryTag tag);
+
+		// フレームの開始（メインスレッドで呼ぶ。直前のフレームの確保回数を確定する）
+		void BeginFrame();
+
+		// タグ別の統計と、全タグの合計
+		TagStats GetTagStats(MemoryTag tag);
+		TagStats GetTotalStats();
+
+		// 計測したフレーム数
+		uint64_t GetFrameCount();
+
+		// 起動からの累計（operator new の呼び出し回数と、要求バイト数）
+		uint64_t GetAllocationCount();
+		uint64_t GetAllocatedBytes();
+
+		// 起動からの累計（operator delete の呼び出し回数。nullptr の解放は数えない）
+		uint64_t GetFreeCount();
+	}
+
+	/// <summary>
+	/// スコープの間、現在のスレッドのヒープ確保を tag で数える（入れ子にした場合は内側が優先）
+	/// </summary>
+	class MemoryTagScope
+	{
+	public:
+		explicit MemoryTagScope(MemoryTag tag) : previousTag_(AllocationCounter::GetCurrentTag()) { AllocationCounter::SetCurrentTag(tag); }
+		~MemoryTagScope() { AllocationCounter::SetCurrentTag(previousTag_); }
+
+		// コピー禁止
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+	private:
+		MemoryTag previousTag_;
+	};
+}
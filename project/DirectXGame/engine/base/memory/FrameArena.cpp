@@ -0,0 +1,181 @@
+#include "FrameArena.h"
+#include "AllocationCounter.h"
+#include <algorithm>
+#include <cassert>
+#include <new>
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif
+
+//
+// FrameArena
+// - 1 フレームで使い捨てる一時データ（ログ文字列・作業用配列など）を、汎用ヒープではなく
+//   フレーム単位のバッファから確保するリニアアロケータ。std::pmr::memory_resource として使う。
+//     FrameString message(FrameArena::GetInstance()->GetResource());
+// - 二重バッファ：
+//   * BeginFrame でバッファを切り替え、切り替え先（2 フレーム前に使っていたもの）を空にする。
+//   * 前フレームに確保したデータは、今のフレームの間はまだ有効（前フレームの結果を次フレームで読む用途向け）。
+//     それより長く持つデータはフレームアリーナに置かないこと。
+// - 確保：
+//   * offset を CAS でずらすだけなので、ワーカースレッドのジョブからも同時に確保できる。
+//   * deallocate は何もしない（pmr コンテナが伸びたときの古い領域も、フレームの切り替えまで残る）。
+//   * 容量を超えた分はヒープから確保して記録し、そのバッファを空にするときに解放する。
+//     ScratchAllocator と違って assert はせず、溢れた量を ImGui に出して容量を見直す。
+// - 計測：BeginFrame で使用量と、AllocationCounter が確定した直前のフレームのヒープ確保回数を履歴に残す。
+// - 設計メモ：
+//   * BeginFrame はジョブが動いていない、フレームの先頭（SRFramework::Update の最初）でのみ呼ぶ。
+//     確保回数を読むため、AllocationCounter::BeginFrame の後に呼ぶこと。
+//   * 初期化前は GetResource が既定のリソース（new / delete）を返すため、起動時のコードからも同じ書き方で使える。
+//
+namespace MyEngine {
+	using namespace FrameArenaConstants;
+
+	FrameArena* FrameArena::GetInstance()
+	{
+		static FrameArena instance;
+		return &instance;
+	}
+
+	void FrameArena::Initialize(size_t capacityPerFrame)
+	{
+		assert(!IsInitialized() && "FrameArena is already initialized!");
+		assert(capacityPerFrame > 0 && "FrameArena capacity must not be zero!");
+
+		for (FrameBuffer& buffer : buffers_) {
+			buffer.memory = std::make_unique<std::byte[]>(capacityPerFrame);
+			buffer.offset = 0;
+			buffer.overflowBytes = 0;
+		}
+		capacity_ = capacityPerFrame;
+		currentIndex_ = 0;
+		peakBytes_ = 0;
+	}
+
+	void FrameArena::Finalize()
+	{
+		for (FrameBuffer& buffer : buffers_) {
+			ResetBuffer(buffer);
+			buffer.memory.reset();
+		}
+		capacity_ = 0;
+	}
+
+	void FrameArena::BeginFrame()
+	{
+		if (!IsInitialized()) {
+			return;
+		}
+
+		// 終わったフレームの統計
+		const uint64_t heapAllocationCount = AllocationCounter::GetTotalStats().lastFrameAllocationCount;
+		const size_t usedBytes = GetUsedBytes() + GetOverflowBytes();
+		peakBytes_ = (std::max)(peakBytes_, usedBytes);
+
+		heapAllocationHistory_[historyOffset_] = static_cast<float>(heapAllocationCount);
+		usedKilobytesHistory_[historyOffset_] = static_cast<float>(usedBytes) / 1024.0f;
+		historyOffset_ = (historyOffset_ + 1) % kHistoryCount;
+
+		// 2 フレーム前のバッファを空にして、このフレームのバッファにする
+		const uint32_t nextIndex = (currentIndex_.load(std::memory_order_relaxed) + 1) % kBufferCount;
+		ResetBuffer(buffers_[nextIndex]);
+		currentIndex_.store(nextIndex, std::memory_order_release);
+	}
+
+	std::pmr::memory_resource* FrameArena::GetResource()
+	{
+		return IsInitialized() ? static_cast<std::pmr::memory_resource*>(this) : std::pmr::get_default_resource();
+	}
+
+	void FrameArena::DrawImGui()
+	{
+#ifdef USE_IMGUI
+		ImGui::Begin("Frame Memory");
+
+		ImGui::Text("Arena : %.1f / %.1f KB (peak %.1f KB)",
+			GetUsedBytes() / 1024.0f, capacity_ / 1024.0f, peakBytes_ / 1024.0f);
+		if (GetOverflowBytes() > 0) {
+			ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Overflow : %.1f KB", GetOverflowBytes() / 1024.0f);
+		}
+		ImGui::PlotLines("Arena KB", usedKilobytesHistory_.data(), kHistoryCount, historyOffset_);
+
+		if (AllocationCounter::IsEnabled()) {
+			ImGui::Text("Heap allocations / frame : %llu", static_cast<unsigned long long>(AllocationCounter::GetTotalStats().lastFrameAllocationCount));
+			ImGui::PlotLines("Heap Allocs", heapAllocationHistory_.data(), kHistoryCount, historyOffset_);
+		}
+		else {
+			ImGui::TextDisabled("Heap allocation counter is disabled in this build");
+		}
+
+		ImGui::End();
+#endif
+	}
+
+	size_t FrameArena::GetUsedBytes() const
+	{
+		const FrameBuffer& buffer = buffers_[currentIndex_.load(std::memory_order_acquire)];
+		return buffer.offset.load(std::memory_order_relaxed);
+	}
+
+	size_t FrameArena::GetOverflowBytes() const
+	{
+		const FrameBuffer& buffer = buffers_[currentIndex_.load(std::memory_order_acquire)];
+		return buffer.overflowBytes.load(std::memory_order_relaxed);
+	}
+
+	// ===== ヘルパー関数 =====
+
+	void* FrameArena::do_allocate(size_t bytes, size_t alignment)
+	{
+		assert(IsInitialized() && "FrameArena is not initialized!");
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && "Alignment must be a power of two!");
+
+		FrameBuffer& buffer = buffers_[currentIndex_.load(std::memory_order_acquire)];
+		const uintptr_t base = reinterpret_cast<uintptr_t>(buffer.memory.get());
+
+		// 先頭をずらす（他のスレッドに先を越されたらやり直す）
+		size_t offset = buffer.offset.load(std::memory_order_relaxed);
+		while (true) {
+			const uintptr_t alignedAddress = (base + offset + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+			const size_t alignedOffset = static_cast<size_t>(alignedAddress - base);
+			if (alignedOffset > capacity_ || bytes > capacity_ - alignedOffset) {
+				break;
+			}
+			if (buffer.offset.compare_exchange_weak(offset, alignedOffset + bytes, std::memory_order_relaxed)) {
+				return buffer.memory.get() + alignedOffset;
+			}
+		}
+
+		// 容量を超えた分はヒープから確保し、バッファを空にするときに解放する
+		void* pointer = ::operator new(bytes, std::align_val_t(alignment));
+		{
+			std::lock_guard<std::mutex> lock(buffer.overflowMutex);
+			buffer.overflowBlocks.push_back(OverflowBlock{ pointer, bytes, alignment });
+		}
+		buffer.overflowBytes.fetch_add(bytes, std::memory_order_relaxed);
+		return pointer;
+	}
+
+	void FrameArena::do_deallocate(void* pointer, size_t bytes, size_t alignment)
+	{
+		// 個別には解放しない（BeginFrame でバッファごと空にする）
+		(void)pointer;
+		(void)bytes;
+		(void)alignment;
+	}
+
+	bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+
+	void FrameArena::ResetBuffer(FrameBuffer& buffer)
+	{
+		std::lock_guard<std::mutex> lock(buffer.overflowMutex);
+		for (const OverflowBlock& block : buffer.overflowBlocks) {
+			::operator delete(block.pointer, block.size, std::align_val_t(block.alignment));
+		}
+		buffer.overflowBlocks.clear();
+		buffer.offset.store(0, std::memory_order_relaxed);
+		buffer.overflowBytes.store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,122 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace MyEngine {
+
+	// FrameArena用の定数
+	namespace FrameArenaConstants {
+		// 1 フレーム分のバッファ容量（デフォルト）
+		constexpr size_t kDefaultCapacity = 1024 * 1024;
+
+		// バッファ数（前フレームに確保したものは次のフレームの間まで有効）
+		constexpr uint32_t kBufferCount = 2;
+
+		// ImGui に表示する履歴のフレーム数
+		constexpr uint32_t kHistoryCount = 120;
+	}
+
+	// フレームアリーナから確保する一時コンテナ（FrameArena::GetResource() を渡して作る）
+	template <class T>
+	using FrameVector = std::pmr::vector<T>;
+	using FrameString = std::pmr::string;
+
+	/// <summary>
+	/// フレーム単位の一時データ用リニアアロケータ（std::pmr::memory_resource）
+	/// 確保は先頭からずらすだけで個別の解放は無く、2 フレーム後の BeginFrame でまとめて解放される
+	/// </summary>
+	class FrameArena : public std::pmr::memory_resource
+	{
+	public:
+		/*------メンバ関数------*/
+
+		// シングルトンインスタンス
+		static FrameArena* GetInstance();
+
+		// コンストラクタ・デストラクタ
+		FrameArena() = default;
+		~FrameArena() override = default;
+
+		// コピー・ムーブ禁止
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+		FrameArena(FrameArena&&) = delete;
+		FrameArena& operator=(FrameArena&&) = delete;
+
+		// 初期化（1 フレーム分の容量のバッファを kBufferCount 個確保する）
+		void Initialize(size_t capacityPerFrame = FrameArenaConstants::kDefaultCapacity);
+
+		// 終了
+		void Finalize();
+
+		// フレームの開始（メインスレッドで、ジョブが動いていないときに呼ぶ）
+		// 使うバッファを切り替え、2 フレーム前に確保したものを解放する
+		void BeginFrame();
+
+		// 一時コンテナに渡すメモリリソース（未初期化なら既定のリソースを返す）
+		std::pmr::memory_resource* GetResource();
+
+		// ImGui
+		void DrawImGui();
+
+		/*------ゲッター------*/
+
+		bool IsInitialized() const { return capacity_ != 0; }
+		size_t GetCapacity() const { return capacity_; }
+		// 現在のフレームの使用量と、容量を超えてヒープに逃がした量
+		size_t GetUsedBytes() const;
+		size_t GetOverflowBytes() const;
+		// これまでの 1 フレームの最大使用量（容量の見積もり用）
+		size_t GetPeakBytes() const { return peakBytes_; }
+
+	private:
+		/*------構造体------*/
+
+		// 容量を超えたときにヒープから確保したブロック
+		struct OverflowBlock {
+			void* pointer;
+			size_t size;
+			size_t alignment;
+		};
+
+		// 1 フレーム分のバッファ
+		struct FrameBuffer {
+			std::unique_ptr<std::byte[]> memory;
+			std::atomic<size_t> offset = 0;
+			std::atomic<size_t> overflowBytes = 0;
+			std::mutex overflowMutex;
+			std::vector<OverflowBlock> overflowBlocks;
+		};
+
+		/*------プライベートメンバ関数------*/
+
+		// std::pmr::memory_resource の実装
+		void* do_allocate(size_t bytes, size_t alignment) override;
+		void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		// バッファを空にする（ヒープに逃がしたブロックも解放する）
+		void ResetBuffer(FrameBuffer& buffer);
+
+		/*------メンバ変数------*/
+
+		std::array<FrameBuffer, FrameArenaConstants::kBufferCount> buffers_;
+		std::atomic<uint32_t> currentIndex_ = 0;
+		size_t capacity_ = 0;
+
+		// 統計
+		size_t peakBytes_ = 0;
+
+		// ImGui 用の履歴（リングバッファ）
+		std::array<float, FrameArenaConstants::kHistoryCount> heapAllocationHistory_{};
+		std::array<float, FrameArenaConstants::kHistoryCount> usedKilobytesHistory_{};
+		uint32_t historyOffset_ = 0;
+	};
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <format>
+#include <iterator>
+#include "FrameArena.h"
+#include "Logger.h"
+
+// ログ出力名前空間（フレームアリーナを使う書式付きの出力。Logger 本体はアロケータに依存させない）
+namespace Logger {
+
+	// 書式付きのログ出力（文字列はフレームアリーナに組み立てるため、毎フレーム呼んでもヒープを使わない）
+	template <class... Args>
+	void LogFormat(std::format_string<Args...> format, Args&&... args)
+	{
+		MyEngine::FrameString message(MyEngine::FrameArena::GetInstance()->GetResource());
+		std::format_to(std::back_inserter(message), format, std::forward<Args>(args)...);
+		Log(message.c_str());
+	}
+}
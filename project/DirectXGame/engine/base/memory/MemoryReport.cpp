@@ -0,0 +1,57 @@
+#include "MemoryReport.h"
+#include "AllocationCounter.h"
+#include <fstream>
+#include <json.hpp>
+
+//
+// MemoryReport
+// - AllocationCounter の統計を JSON にまとめる。ImGuiManager::DrawMemoryStats の「Dump JSON」ボタンと、
+//   起動引数 "--dump-memory-stats [ファイル名]"（ゲームの終了時に書き出す）から使う。
+// - 形式：
+//   { "enabled", "frames",
+//     "total": { 統計 },
+//     "tags": { "Particle": { 統計 }, ... } }
+//   統計は liveBytes / peakBytes / allocations / frees / lastFrameAllocations / peakFrameAllocations。
+// - 設計メモ：JSON の組み立て自体もヒープを使うため、書き出した回の統計にはその分が Untagged として含まれる。
+//
+namespace MyEngine {
+	namespace {
+		nlohmann::json StatsToJson(const AllocationCounter::TagStats& stats)
+		{
+			nlohmann::json json;
+			json["liveBytes"] = stats.liveBytes;
+			json["peakBytes"] = stats.peakBytes;
+			json["allocations"] = stats.allocationCount;
+			json["frees"] = stats.freeCount;
+			json["lastFrameAllocations"] = stats.lastFrameAllocationCount;
+			json["peakFrameAllocations"] = stats.peakFrameAllocationCount;
+			return json;
+		}
+	}
+
+	namespace MemoryReport {
+
+		std::string ToJson()
+		{
+			nlohmann::json json;
+			json["enabled"] = AllocationCounter::IsEnabled();
+			json["frames"] = AllocationCounter::GetFrameCount();
+			json["total"] = StatsToJson(AllocationCounter::GetTotalStats());
+			for (uint32_t i = 0; i < kMemoryTagCount; ++i) {
+				const MemoryTag tag = static_cast<MemoryTag>(i);
+				json["tags"][GetMemoryTagName(tag)] = StatsToJson(AllocationCounter::GetTagStats(tag));
+			}
+			return json.dump(2);
+		}
+
+		bool WriteJson(const std::string& filePath)
+		{
+			std::ofstream file(filePath, std::ios::trunc);
+			if (!file.is_open()) {
+				return false;
+			}
+			file << ToJson() << '\n';
+			return true;
+		}
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+
+namespace MyEngine {
+
+	// MemoryReport用の定数
+	namespace MemoryReportConstants {
+		// 起動引数：ゲームの終了時にメモリ統計を JSON に書き出す
+		constexpr const char* kDumpCommand = "--dump-memory-stats";
+
+		// 書き出し先のデフォルト
+		constexpr const char* kDefaultDumpFilePath = "memory_stats.json";
+	}
+
+	/// <summary>
+	/// AllocationCounter のタグ別統計の書き出し（ImGui を使わずに記録・比較する用）
+	/// </summary>
+	namespace MemoryReport {
+
+		// タグ別の確保中・最大バイト数、確保回数、1 フレームあたりの確保回数を JSON 文字列にする
+		std::string ToJson();
+
+		// ToJson の内容をファイルに書き出す（書き出せなければ false）
+		bool WriteJson(const std::string& filePath);
+	}
+}
@@ -0,0 +1,262 @@
+#include "LightClusterGrid.h"
+#include <JobSystem.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//
+// LightClusterGrid
+// - ピクセルシェーダーが全てのライトを回さずに済むよう、ビュー空間の視錐台を X × Y × Z のクラスタ（froxel）に分け、
+//   クラスタごとに掛かるライトの番号を並べる。ピクセルは自分のクラスタの番号だけを回す。
+// - 奥行きは近クリップから遠クリップまでを指数分割する（スライス s の手前の奥行きは near * (far / near)^(s / Z)）。
+//   ピクセルシェーダーでは log(z) * zScale + zBias の 1 回でスライスが求まる。
+// - 分類：
+//   1. ライトの球をビュー空間に移し、掛かるスライスの範囲を求める（ここまでは呼び出したスレッドで行う）。
+//   2. スライスごとにジョブにする。スライスに掛かるライトについて、球をスライスの奥行きで切った箱を画面に投影して
+//      タイルの範囲を求め（箱の角の奥行きは範囲の両端なので、両端で割れば十分）、範囲内のクラスタだけ球と AABB で判定する。
+//      当たりを数えてからクラスタごとの先頭位置を決め、ライトの番号順に置く（全クラスタ × 全ライトの判定はしない）。
+//      スライスごとに結果の配列を持つので、ジョブ同士で書き込み先が重ならない。
+//   3. スライスの結果を手前から順に 1 つの配列につなぎ、クラスタの offset をずらす。
+// - 番号の並びはクラスタごとに点光源が先、スポットライトが後（ライトの配列も点光源・スポットライトで別）。
+// - クラスタの AABB・タイルの範囲はどちらも実際より広めに取るので、ライトが掛かっているクラスタを落とすことは無い。
+//
+namespace MyEngine {
+	using namespace LightClusterConstants;
+
+	namespace {
+		// 奥行きからスライスの番号（範囲外は端に寄せる）
+		uint32_t ToSlice(float depth, float zScale, float zBias)
+		{
+			const float slice = std::floor(std::log(depth) * zScale + zBias);
+			return static_cast<uint32_t>(std::clamp(slice, 0.0f, float(kClusterCountZ - 1)));
+		}
+
+		// 正規化デバイス座標からタイルの番号（範囲外は端に寄せる）
+		uint32_t ToTile(float ndc, uint32_t tileCount)
+		{
+			const float tile = std::floor((ndc + 1.0f) * 0.5f * float(tileCount));
+			return static_cast<uint32_t>(std::clamp(tile, 0.0f, float(tileCount - 1)));
+		}
+
+		// 球と AABB が重なるか
+		bool IntersectsSphereAABB(const Vector3& center, float radius, const Vector3& minimum, const Vector3& maximum)
+		{
+			const float dx = center.x - std::clamp(center.x, minimum.x, maximum.x);
+			const float dy = center.y - std::clamp(center.y, minimum.y, maximum.y);
+			const float dz = center.z - std::clamp(center.z, minimum.z, maximum.z);
+			return dx * dx + dy * dy + dz * dz <= radius * radius;
+		}
+	}
+
+	void LightClusterGrid::Build(const Desc& desc,
+		const BoundingSphere* pointLights, uint32_t pointLightCount,
+		const BoundingSphere* spotLights, uint32_t spotLightCount)
+	{
+		desc_ = desc;
+		tanHalfFovY_ = std::tan(desc.fovY * 0.5f);
+		tanHalfFovX_ = tanHalfFovY_ * desc.aspectRatio;
+
+		// スライス = log(z / near) / log(far / near) * Z
+		const float logDepthRange = std::log(desc.farClip / desc.nearClip);
+		shaderParams_.zScale = float(kClusterCountZ) / logDepthRange;
+		shaderParams_.zBias = -float(kClusterCountZ) * std::log(desc.nearClip) / logDepthRange;
+		shaderParams_.depthAxis = { desc.view.m[0][2], desc.view.m[1][2], desc.view.m[2][2], desc.view.m[3][2] };
+
+		// ライトをビュー空間に移す（点光源が先）
+		viewLights_.clear();
+		PrepareLights(pointLights, pointLightCount);
+		PrepareLights(spotLights, spotLightCount);
+		pointLightCount_ = pointLightCount;
+
+		clusters_.resize(kClusterCount);
+		sliceWorks_.resize(kClusterCountZ);
+
+		// スライスごとに分類する
+		JobSystem* jobSystem = JobSystem::GetInstance();
+		if (jobSystem->GetThreadCount() > 0) {
+			jobSystem->ParallelFor(kClusterCountZ, 1, [this](uint32_t begin, uint32_t end) {
+				for (uint32_t slice = begin; slice < end; slice++) {
+					BuildSlice(slice);
+				}
+			});
+		}
+		else {
+			for (uint32_t slice = 0; slice < kClusterCountZ; slice++) {
+				BuildSlice(slice);
+			}
+		}
+
+		// スライスの結果をつなぐ（上限を超えた分は切り詰める）
+		size_t totalIndexCount = 0;
+		for (const SliceWork& work : sliceWorks_) {
+			totalIndexCount += work.indices.size();
+		}
+		if (maxIndexCount_ != 0) {
+			totalIndexCount = (std::min)(totalIndexCount, size_t(maxIndexCount_));
+		}
+		indices_.resize(totalIndexCount);
+
+		uint32_t base = 0;
+		const uint32_t indexCount = static_cast<uint32_t>(indices_.size());
+		for (uint32_t slice = 0; slice < kClusterCountZ; slice++) {
+			const std::vector<uint32_t>& sliceIndices = sliceWorks_[slice].indices;
+			const uint32_t copyCount = (std::min)(static_cast<uint32_t>(sliceIndices.size()), indexCount - base);
+			if (copyCount > 0) {
+				std::memcpy(indices_.data() + base, sliceIndices.data(), sizeof(uint32_t) * copyCount);
+			}
+
+			Cluster* sliceClusters = &clusters_[GetClusterIndex(0, 0, slice)];
+			for (uint32_t i = 0; i < kClusterCountX * kClusterCountY; i++) {
+				Cluster& cluster = sliceClusters[i];
+				cluster.offset += base;
+				if (cluster.offset + cluster.pointCount + cluster.spotCount > indexCount) {
+					const uint32_t available = indexCount > cluster.offset ? indexCount - cluster.offset : 0;
+					cluster.pointCount = (std::min)(cluster.pointCount, available);
+					cluster.spotCount = (std::min)(cluster.spotCount, available - cluster.pointCount);
+				}
+			}
+			base += copyCount;
+		}
+	}
+
+	void LightClusterGrid::BuildSlice(uint32_t slice)
+	{
+		constexpr uint32_t kSliceClusterCount = kClusterCountX * kClusterCountY;
+		SliceWork& work = sliceWorks_[slice];
+		work.hits.clear();
+		work.indices.clear();
+
+		Cluster* sliceClusters = &clusters_[GetClusterIndex(0, 0, slice)];
+		for (uint32_t i = 0; i < kSliceClusterCount; i++) {
+			sliceClusters[i] = { 0, 0, 0 };
+		}
+
+		const float nearDepth = GetSliceDepth(slice);
+		const float farDepth = GetSliceDepth(slice + 1);
+		bool hasBounds = false;
+
+		// ライトごとに、掛かるタイルの範囲のクラスタだけを判定する
+		for (uint32_t i = 0; i < viewLights_.size(); i++) {
+			const ViewLight& light = viewLights_[i];
+			if (slice < light.firstSlice || light.lastSlice < slice) {
+				continue;
+			}
+
+			// 球をスライスの奥行きで切った箱の、手前と奥の面を投影する
+			const float depth0 = (std::max)(nearDepth, light.center.z - light.radius);
+			const float depth1 = (std::min)(farDepth, light.center.z + light.radius);
+			const float minX = (light.center.x - light.radius) / tanHalfFovX_;
+			const float maxX = (light.center.x + light.radius) / tanHalfFovX_;
+			const float minY = (light.center.y - light.radius) / tanHalfFovY_;
+			const float maxY = (light.center.y + light.radius) / tanHalfFovY_;
+			const float ndcMinX = (std::min)(minX / depth0, minX / depth1);
+			const float ndcMaxX = (std::max)(maxX / depth0, maxX / depth1);
+			const float ndcMinY = (std::min)(minY / depth0, minY / depth1);
+			const float ndcMaxY = (std::max)(maxY / depth0, maxY / depth1);
+			if (ndcMaxX < -1.0f || ndcMinX > 1.0f || ndcMaxY < -1.0f || ndcMinY > 1.0f) {
+				continue;
+			}
+
+			// クラスタの AABB はライトが掛かるスライスだけで作る
+			if (!hasBounds) {
+				BuildSliceBounds(work, nearDepth, farDepth);
+				hasBounds = true;
+			}
+
+			// タイルの y は画面の上から数える
+			const uint32_t tileMinX = ToTile(ndcMinX, kClusterCountX);
+			const uint32_t tileMaxX = ToTile(ndcMaxX, kClusterCountX);
+			const uint32_t tileMinY = kClusterCountY - 1 - ToTile(ndcMaxY, kClusterCountY);
+			const uint32_t tileMaxY = kClusterCountY - 1 - ToTile(ndcMinY, kClusterCountY);
+			for (uint32_t y = tileMinY; y <= tileMaxY; y++) {
+				for (uint32_t x = tileMinX; x <= tileMaxX; x++) {
+					const uint32_t cluster = y * kClusterCountX + x;
+					const ClusterBounds& bounds = work.bounds[cluster];
+					if (!IntersectsSphereAABB(light.center, light.radius, bounds.minimum, bounds.maximum)) {
+						continue;
+					}
+					work.hits.push_back({ cluster, i });
+					if (i < pointLightCount_) {
+						sliceClusters[cluster].pointCount++;
+					}
+					else {
+						sliceClusters[cluster].spotCount++;
+					}
+				}
+			}
+		}
+
+		// クラスタごとの先頭位置（スライスの先頭から）
+		work.cursors.resize(kSliceClusterCount);
+		uint32_t offset = 0;
+		for (uint32_t i = 0; i < kSliceClusterCount; i++) {
+			sliceClusters[i].offset = offset;
+			work.cursors[i] = offset;
+			offset += sliceClusters[i].pointCount + sliceClusters[i].spotCount;
+		}
+
+		// ライトの番号順に置く（点光源が先に来る。スポットライトはスポットライトの配列の番号にする）
+		work.indices.resize(offset);
+		for (const Hit& hit : work.hits) {
+			work.indices[work.cursors[hit.cluster]++] = hit.light < pointLightCount_ ? hit.light : hit.light - pointLightCount_;
+		}
+	}
+
+	void LightClusterGrid::BuildSliceBounds(SliceWork& work, float nearDepth, float farDepth) const
+	{
+		work.bounds.resize(kClusterCountX * kClusterCountY);
+		for (uint32_t y = 0; y < kClusterCountY; y++) {
+			// タイルの範囲（正規化デバイス座標）
+			const float ndcTop = 1.0f - 2.0f * float(y) / float(kClusterCountY);
+			const float ndcBottom = 1.0f - 2.0f * float(y + 1) / float(kClusterCountY);
+			for (uint32_t x = 0; x < kClusterCountX; x++) {
+				const float ndcLeft = -1.0f + 2.0f * float(x) / float(kClusterCountX);
+				const float ndcRight = -1.0f + 2.0f * float(x + 1) / float(kClusterCountX);
+
+				// タイルの端は奥行きに比例して広がるので、手前と奥の両方を含める
+				ClusterBounds& bounds = work.bounds[y * kClusterCountX + x];
+				bounds.minimum = {
+					(std::min)(ndcLeft * tanHalfFovX_ * nearDepth, ndcLeft * tanHalfFovX_ * farDepth),
+					(std::min)(ndcBottom * tanHalfFovY_ * nearDepth, ndcBottom * tanHalfFovY_ * farDepth),
+					nearDepth
+				};
+				bounds.maximum = {
+					(std::max)(ndcRight * tanHalfFovX_ * nearDepth, ndcRight * tanHalfFovX_ * farDepth),
+					(std::max)(ndcTop * tanHalfFovY_ * nearDepth, ndcTop * tanHalfFovY_ * farDepth),
+					farDepth
+				};
+			}
+		}
+	}
+
+	float LightClusterGrid::GetSliceDepth(uint32_t slice) const
+	{
+		return desc_.nearClip * std::pow(desc_.farClip / desc_.nearClip, float(slice) / float(kClusterCountZ));
+	}
+
+	void LightClusterGrid::PrepareLights(const BoundingSphere* spheres, uint32_t count)
+	{
+		const Matrix4x4& view = desc_.view;
+		for (uint32_t i = 0; i < count; i++) {
+			const Vector3& p = spheres[i].center;
+			ViewLight light;
+			light.center = {
+				p.x * view.m[0][0] + p.y * view.m[1][0] + p.z * view.m[2][0] + view.m[3][0],
+				p.x * view.m[0][1] + p.y * view.m[1][1] + p.z * view.m[2][1] + view.m[3][1],
+				p.x * view.m[0][2] + p.y * view.m[1][2] + p.z * view.m[2][2] + view.m[3][2]
+			};
+			light.radius = spheres[i].radius;
+
+			// 近クリップより手前・遠クリップより奥に収まるライトはどのスライスにも掛からない（空の範囲にする）
+			if (light.center.z + light.radius < desc_.nearClip || light.center.z - light.radius > desc_.farClip) {
+				light.firstSlice = 1;
+				light.lastSlice = 0;
+			}
+			else {
+				light.firstSlice = ToSlice((std::max)(light.center.z - light.radius, desc_.nearClip), shaderParams_.zScale, shaderParams_.zBias);
+				light.lastSlice = ToSlice((std::min)(light.center.z + light.radius, desc_.farClip), shaderParams_.zScale, shaderParams_.zBias);
+			}
+			viewLights_.push_back(light);
+		}
+	}
+}
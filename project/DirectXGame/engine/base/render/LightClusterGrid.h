@@ -0,0 +1,135 @@
+#pragma once
+#include "BoundingSphere.h"
+#include "Matrix4x4.h"
+#include "Vector4.h"
+#include <cstdint>
+#include <vector>
+
+namespace MyEngine {
+	// LightClusterGrid用の定数（Object3d.PS.hlsl の CLUSTER_COUNT_X / Y / Z と合わせる）
+	namespace LightClusterConstants {
+		// 画面の分割数（16:9 の画面でタイルがほぼ正方形になる数）
+		constexpr uint32_t kClusterCountX = 16;
+		constexpr uint32_t kClusterCountY = 9;
+
+		// 奥行きの分割数（指数分割なので手前ほど細かい）
+		constexpr uint32_t kClusterCountZ = 24;
+
+		// クラスタの総数
+		constexpr uint32_t kClusterCount = kClusterCountX * kClusterCountY * kClusterCountZ;
+	}
+
+	/// <summary>
+	/// クラスタ化ライトリスト（ビュー空間の視錐台を X × Y × Z の小さな視錐台に分け、それぞれに掛かるライトの番号を並べる）
+	/// グラフィックス API に依存しない。奥行きのスライスごとに JobSystem のワーカーで分類する
+	/// </summary>
+	class LightClusterGrid
+	{
+	public:
+		/*------構造体------*/
+
+		// 分類に使うカメラの情報
+		struct Desc {
+			Matrix4x4 view; // ビュー行列（行ベクトル規約）
+			float fovY = 0.0f; // 縦の画角（ラジアン）
+			float aspectRatio = 1.0f; // 横 / 縦
+			float nearClip = 0.1f; // 近クリップ
+			float farClip = 100.0f; // 遠クリップ
+		};
+
+		// クラスタ 1 つ分（GPU にそのまま渡す。indices の offset から点光源 pointCount 個、続けてスポットライト spotCount 個）
+		struct Cluster {
+			uint32_t offset;
+			uint32_t pointCount;
+			uint32_t spotCount;
+		};
+
+		// ピクセルシェーダーがクラスタの番号を求めるための値
+		struct ShaderParams {
+			Vector4 depthAxis; // ビュー空間の z = dot(float4(ワールド座標, 1), depthAxis)
+			float zScale; // スライス = log(z) * zScale + zBias
+			float zBias;
+		};
+
+		/*------メンバ関数------*/
+
+		// ライトを分類する（ライトはワールド空間の球。スポットライトは届く距離を半径とする球で近似する）
+		// ワーカーを使うのは JobSystem が初期化済みのときだけ（未初期化なら呼び出したスレッドで順に行う）
+		void Build(const Desc& desc,
+			const BoundingSphere* pointLights, uint32_t pointLightCount,
+			const BoundingSphere* spotLights, uint32_t spotLightCount);
+
+		// 番号の総数の上限（超えた分は奥のスライスのクラスタから切り詰める。0 で無制限）
+		void SetMaxIndexCount(uint32_t maxIndexCount) { maxIndexCount_ = maxIndexCount; }
+
+		/*------ゲッター------*/
+
+		const std::vector<Cluster>& GetClusters() const { return clusters_; }
+		const std::vector<uint32_t>& GetIndices() const { return indices_; }
+		const ShaderParams& GetShaderParams() const { return shaderParams_; }
+
+		// クラスタの番号（x, y は画面のタイル。y は上から）
+		static uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z) {
+			return (z * LightClusterConstants::kClusterCountY + y) * LightClusterConstants::kClusterCountX + x;
+		}
+
+	private:
+		// ビュー空間の球と、掛かるスライスの範囲
+		struct ViewLight {
+			Vector3 center;
+			float radius;
+			uint32_t firstSlice;
+			uint32_t lastSlice;
+		};
+
+		// ライトが掛かったクラスタ（cluster はスライスの中での番号、light は viewLights_ の番号）
+		struct Hit {
+			uint32_t cluster;
+			uint32_t light;
+		};
+
+		// クラスタの AABB（ビュー空間）
+		struct ClusterBounds {
+			Vector3 minimum;
+			Vector3 maximum;
+		};
+
+		// スライス 1 つ分の作業領域（スレッドごとに別のスライスを扱うので共有しない）
+		struct SliceWork {
+			std::vector<ClusterBounds> bounds;
+			std::vector<Hit> hits;
+			std::vector<uint32_t> cursors;
+			std::vector<uint32_t> indices;
+		};
+
+		// スライス 1 つ分の分類（clusters_ の offset はスライスの先頭からの位置）
+		void BuildSlice(uint32_t slice);
+
+		// スライスのクラスタの AABB を作る
+		void BuildSliceBounds(SliceWork& work, float nearDepth, float farDepth) const;
+
+		// スライスの境界の奥行き
+		float GetSliceDepth(uint32_t slice) const;
+
+		// ライトの球をビュー空間に移し、掛かるスライスを求める
+		void PrepareLights(const BoundingSphere* spheres, uint32_t count);
+
+		// 分類の結果
+		std::vector<Cluster> clusters_;
+		std::vector<uint32_t> indices_;
+		ShaderParams shaderParams_{};
+
+		// 作業領域
+		std::vector<ViewLight> viewLights_;
+		std::vector<SliceWork> sliceWorks_;
+		uint32_t pointLightCount_ = 0;
+
+		// 分類に使うカメラの値
+		Desc desc_{};
+		float tanHalfFovX_ = 0.0f;
+		float tanHalfFovY_ = 0.0f;
+
+		// 番号の総数の上限
+		uint32_t maxIndexCount_ = 0;
+	};
+}
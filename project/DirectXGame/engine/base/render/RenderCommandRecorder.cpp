@@ -0,0 +1,119 @@
+#include "RenderCommandRecorder.h"
+#include <array>
+#include <utility>
+
+//
+// RenderCommandRecorder
+// - 描画を (キー, payload) の組で記録し、Submit でまとめて出力先（RenderCommandSink）に流す。
+//   グラフィックス API の型を一切含まないので、出力先を差し替えれば Linux でも並べ替えと省略の結果を確かめられる。
+// - 並べ替え：8 ビットずつ 8 回の LSD 基数ソート（安定）。
+//   * 最初に 8 桁分のヒストグラムを 1 回の走査でまとめて数える。
+//   * 全てのキーで同じ値の桁（例：レイヤーが 1 種類しかない）は並びが変わらないので飛ばす。
+//   * 描画数は多くても数千なので、比較ソートより分岐が少なく、キーの分布に関わらず時間が一定になる。
+// - 省略：直前に設定したパイプライン・マテリアルを覚えておき、同じなら出力先を呼ばない。
+//   パイプラインを切り替えるとマテリアルのバインドも無効になる前提で、その直後は必ずマテリアルを設定し直す。
+//
+namespace MyEngine {
+	namespace {
+		// 基数ソートの桁
+		constexpr uint32_t kRadixBits = 8;
+		constexpr uint32_t kRadixBucketCount = 1u << kRadixBits;
+		constexpr uint32_t kRadixPassCount = 64 / kRadixBits;
+
+		// 未設定を表す値（キーのフィールドには入らない値）
+		constexpr uint32_t kUnbound = 0xFFFFFFFFu;
+	}
+
+	void RenderCommandRecorder::Reset()
+	{
+		commands_.clear();
+	}
+
+	void RenderCommandRecorder::Record(uint64_t sortKey, uint32_t payload)
+	{
+		commands_.push_back({ sortKey, payload });
+	}
+
+	void RenderCommandRecorder::Sort()
+	{
+		const size_t count = commands_.size();
+		if (count < 2) {
+			return;
+		}
+
+		// 全ての桁のヒストグラムを 1 回の走査で数える
+		std::array<std::array<uint32_t, kRadixBucketCount>, kRadixPassCount> histograms{};
+		for (const Command& command : commands_) {
+			for (uint32_t pass = 0; pass < kRadixPassCount; ++pass) {
+				++histograms[pass][(command.sortKey >> (pass * kRadixBits)) & (kRadixBucketCount - 1)];
+			}
+		}
+
+		scratch_.resize(count);
+		std::vector<Command>* source = &commands_;
+		std::vector<Command>* destination = &scratch_;
+		for (uint32_t pass = 0; pass < kRadixPassCount; ++pass) {
+			std::array<uint32_t, kRadixBucketCount>& histogram = histograms[pass];
+			const uint32_t shift = pass * kRadixBits;
+
+			// 全てのキーがこの桁で同じ値なら並びは変わらない
+			const uint32_t firstDigit = static_cast<uint32_t>(((*source)[0].sortKey >> shift) & (kRadixBucketCount - 1));
+			if (histogram[firstDigit] == count) {
+				continue;
+			}
+
+			// 各値の書き込み開始位置
+			uint32_t offset = 0;
+			for (uint32_t& bucket : histogram) {
+				const uint32_t bucketCount = bucket;
+				bucket = offset;
+				offset += bucketCount;
+			}
+
+			for (const Command& command : *source) {
+				(*destination)[histogram[(command.sortKey >> shift) & (kRadixBucketCount - 1)]++] = command;
+			}
+			std::swap(source, destination);
+		}
+
+		// 奇数回入れ替えたときは結果が作業領域側にある
+		if (source != &commands_) {
+			commands_.swap(scratch_);
+		}
+	}
+
+	RenderSubmitStats RenderCommandRecorder::Submit(RenderCommandSink& sink) const
+	{
+		RenderSubmitStats stats;
+		uint32_t boundPipeline = kUnbound;
+		uint32_t boundMaterial = kUnbound;
+
+		for (const Command& command : commands_) {
+			const uint32_t pipeline = RenderSortKey::GetPipeline(command.sortKey);
+			const uint32_t material = RenderSortKey::GetMaterial(command.sortKey);
+
+			if (pipeline != boundPipeline) {
+				sink.BindPipeline(pipeline);
+				boundPipeline = pipeline;
+				boundMaterial = kUnbound;
+				++stats.pipelineBindCount;
+			}
+			else {
+				++stats.skippedPipelineBinds;
+			}
+
+			if (material != boundMaterial) {
+				sink.BindMaterial(material);
+				boundMaterial = material;
+				++stats.materialBindCount;
+			}
+			else {
+				++stats.skippedMaterialBinds;
+			}
+
+			sink.Draw(command.payload);
+			++stats.commandCount;
+		}
+		return stats;
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "RenderSortKey.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MyEngine {
+	/// <summary>
+	/// 描画コマンドの出力先（グラフィックス API 側で実装する。テストでは呼ばれた順を記録するだけのものを渡せる）
+	/// </summary>
+	class RenderCommandSink
+	{
+	public:
+		virtual ~RenderCommandSink() = default;
+
+		// パイプライン（ルートシグネチャ・PSO など）を切り替える
+		virtual void BindPipeline(uint32_t pipeline) = 0;
+
+		// マテリアル（テクスチャ・定数など）を切り替える。パイプラインを切り替えた直後は必ず呼ばれる
+		virtual void BindMaterial(uint32_t material) = 0;
+
+		// 描画する（payload は Record に渡した値）
+		virtual void Draw(uint32_t payload) = 0;
+	};
+
+	// Submit の統計
+	struct RenderSubmitStats {
+		uint32_t commandCount = 0;         // 描画の数
+		uint32_t pipelineBindCount = 0;    // 実際に行ったパイプラインの切り替え
+		uint32_t materialBindCount = 0;    // 実際に行ったマテリアルの切り替え
+		uint32_t skippedPipelineBinds = 0; // 前と同じなので省いたパイプラインの切り替え
+		uint32_t skippedMaterialBinds = 0; // 前と同じなので省いたマテリアルの切り替え
+	};
+
+	/// <summary>
+	/// 描画コマンドの記録と並べ替え（グラフィックス API に依存しない）
+	/// 記録した描画を 64 ビットのキーで基数ソートし、前と同じパイプライン・マテリアルの設定を省いて出力先に流す
+	/// </summary>
+	class RenderCommandRecorder
+	{
+	public:
+		// 記録された描画（キーと、出力先に渡す値）
+		struct Command {
+			uint64_t sortKey;
+			uint32_t payload;
+		};
+
+		/*------メンバ関数------*/
+
+		// 記録を空にする（配列の容量は使い回す）
+		void Reset();
+
+		// 描画を記録する
+		void Record(uint64_t sortKey, uint32_t payload);
+		void Record(uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t depth, uint32_t payload) {
+			Record(RenderSortKey::Encode(layer, pipeline, material, depth), payload);
+		}
+
+		// キーの小さい順に並べ替える（安定。同じキーは記録した順のまま）
+		void Sort();
+
+		// 並べた順に出力先へ流す（同じパイプライン・マテリアルが続く間は切り替えを省く）
+		RenderSubmitStats Submit(RenderCommandSink& sink) const;
+
+		/*------ゲッター------*/
+
+		const std::vector<Command>& GetCommands() const { return commands_; }
+		size_t GetCommandCount() const { return commands_.size(); }
+
+	private:
+		/*------メンバ変数------*/
+
+		// 記録された描画
+		std::vector<Command> commands_;
+
+		// 基数ソートの作業領域
+		std::vector<Command> scratch_;
+	};
+}
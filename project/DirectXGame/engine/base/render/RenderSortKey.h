@@ -0,0 +1,59 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+
+namespace MyEngine {
+	// 描画コマンドの並べ替えキー
+	// 上位から レイヤー(4) / パイプライン(12) / マテリアル(24) / 深度(24) ビット。
+	// 整数として小さい順に並べるだけで、レイヤー → パイプライン → マテリアル → 深度 の優先順にまとまる
+	namespace RenderSortKey {
+		// 各フィールドのビット数
+		inline constexpr uint32_t kLayerBits = 4;
+		inline constexpr uint32_t kPipelineBits = 12;
+		inline constexpr uint32_t kMaterialBits = 24;
+		inline constexpr uint32_t kDepthBits = 24;
+
+		// 各フィールドの位置
+		inline constexpr uint32_t kDepthShift = 0;
+		inline constexpr uint32_t kMaterialShift = kDepthShift + kDepthBits;
+		inline constexpr uint32_t kPipelineShift = kMaterialShift + kMaterialBits;
+		inline constexpr uint32_t kLayerShift = kPipelineShift + kPipelineBits;
+		static_assert(kLayerShift + kLayerBits == 64, "sort key fields must fill 64 bits");
+
+		// 各フィールドの最大値
+		inline constexpr uint32_t kLayerMask = (1u << kLayerBits) - 1;
+		inline constexpr uint32_t kPipelineMask = (1u << kPipelineBits) - 1;
+		inline constexpr uint32_t kMaterialMask = (1u << kMaterialBits) - 1;
+		inline constexpr uint32_t kDepthMask = (1u << kDepthBits) - 1;
+
+		// レイヤー（小さいものから描く）
+		inline constexpr uint32_t kLayerOpaque = 0;      // 不透明（手前から）
+		inline constexpr uint32_t kLayerSky = 1;         // 空（不透明の後。深度テストで隠れた部分を省く）
+		inline constexpr uint32_t kLayerTransparent = 2; // 半透明（奥から）
+		inline constexpr uint32_t kLayerOverlay = 3;     // UI など
+
+		// キーを作る（範囲外の値は下位ビットだけを使う）
+		constexpr uint64_t Encode(uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t depth)
+		{
+			return (static_cast<uint64_t>(layer & kLayerMask) << kLayerShift) |
+				(static_cast<uint64_t>(pipeline & kPipelineMask) << kPipelineShift) |
+				(static_cast<uint64_t>(material & kMaterialMask) << kMaterialShift) |
+				(static_cast<uint64_t>(depth & kDepthMask) << kDepthShift);
+		}
+
+		// キーから各フィールドを取り出す
+		constexpr uint32_t GetLayer(uint64_t key) { return static_cast<uint32_t>(key >> kLayerShift) & kLayerMask; }
+		constexpr uint32_t GetPipeline(uint64_t key) { return static_cast<uint32_t>(key >> kPipelineShift) & kPipelineMask; }
+		constexpr uint32_t GetMaterial(uint64_t key) { return static_cast<uint32_t>(key >> kMaterialShift) & kMaterialMask; }
+		constexpr uint32_t GetDepth(uint64_t key) { return static_cast<uint32_t>(key >> kDepthShift) & kDepthMask; }
+
+		// 深度（0 以上の距離・距離の 2 乗など）を 24 ビットにする
+		// 0 以上の float はビット列をそのまま整数として比べても大小が変わらないので、上位 24 ビットを使う（範囲の指定が要らない）
+		// backToFront のときは反転して、遠いものほど小さいキーにする（半透明用）
+		constexpr uint32_t EncodeDepth(float depth, bool backToFront = false)
+		{
+			const uint32_t bits = depth > 0.0f ? std::bit_cast<uint32_t>(depth) >> (32 - kDepthBits) : 0u;
+			return backToFront ? (kDepthMask - bits) : bits;
+		}
+	}
+}
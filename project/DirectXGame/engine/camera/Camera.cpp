@@ -2,6 +2,8 @@
 #include <MakeAffineMatrix.h>
 #include <Inverse.h>
 #include <MakePerspectiveFovMatrix.h>
+#include <atomic>
+#include <cstring>
 
 //
 // Camera
@@ -16,26 +18,42 @@
 //   ・アスペクト比 (aspectRatio_) はウィンドウリサイズ時に更新する必要がある（ここでは初期化時に WinApp の値を使う）。
 //   ・fovY_ はラジアンで扱う想定（MakePerspectiveFovMatrix の契約に従うこと）。
 //   ・Update() は transform_ の値（translate/rotate/scale）を変更した後に呼び出すこと。
+//   ・回転は rotation_（クォータニオン）が正。SetRotate のオイラー角は設定時に変換し、transform_.rotate は取得用に残す。
 //   ・行列の掛け合わせ順はレンダリング側のシェーダ期待順に合わせてある（view * projection）。
+//   ・viewProjectionVersion_ は行列が実際に変わったときだけ新しい番号にする。
+//     番号は全カメラで共通の連番なので、WorldTransform はカメラの切り替えも含めて番号の比較だけで WVP の更新要否を判定できる。
+//   ・frustum_（カリング用の視錐台）も同じタイミングで作り直す。フレームごとに 1 回、変わったときだけ。
 //
 using namespace Math;
 namespace MyEngine {
 	using namespace CameraConstants;
 
+	namespace {
+		// ビュープロジェクション行列の番号を発行する（0 は「未設定」として使わない）
+		uint32_t IssueViewProjectionVersion()
+		{
+			static std::atomic<uint32_t> sVersion = 0;
+			return ++sVersion;
+		}
+	}
+
 	Camera::Camera()
 		: transform_({
 			{kDefaultScaleX, kDefaultScaleY, kDefaultScaleZ},
 			{kDefaultRotateX, kDefaultRotateY, kDefaultRotateZ},
 			{kDefaultTranslateX, kDefaultTranslateY, kDefaultTranslateZ}
 			})
+		, rotation_(MakeRotateXYZQuaternion(transform_.rotate))
 		, fovY_(kDefaultFovY)
 		, aspectRatio_(CalculateAspectRatio())
 		, nearClip_(kDefaultNearClip)
 		, farClip_(kDefaultFarClip)
-		, worldMatrix_(MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate))
-		, viewMatrix_(Inverse(worldMatrix_))
+		, worldMatrix_(MakeAffineMatrix(transform_.scale, rotation_, transform_.translate))
+		, viewMatrix_(InverseAffine(worldMatrix_))
 		, projectionMatrix_(MakePerspectiveFovMatrix(fovY_, aspectRatio_, nearClip_, farClip_))
 		, viewProjectionMatrix_(Multiply(viewMatrix_, projectionMatrix_))
+		, viewProjectionVersion_(IssueViewProjectionVersion())
+		, frustum_(MakeFrustum(viewProjectionMatrix_))
 	{
 	}
 
@@ -51,14 +69,14 @@ namespace MyEngine {
 
 	void Camera::UpdateWorldMatrix()
 	{
-		// worldMatrix_ を作成：スケール・回転・平行移動からワールド変換行列を合成する
-		worldMatrix_ = MakeAffineMatrix(transform_.scale, transform_.rotate, transform_.translate);
+		// worldMatrix_ を作成：スケール・回転（クォータニオン）・平行移動からワールド変換行列を合成する
+		worldMatrix_ = MakeAffineMatrix(transform_.scale, rotation_, transform_.translate);
 	}
 
 	void Camera::UpdateViewMatrix()
 	{
 		// viewMatrix_ は worldMatrix_ の逆行列（カメラ座標系へ変換）
-		viewMatrix_ = Inverse(worldMatrix_);
+		viewMatrix_ = InverseAffine(worldMatrix_);
 	}
 
 	void Camera::UpdateProjectionMatrix()
@@ -70,7 +88,14 @@ namespace MyEngine {
 	void Camera::UpdateViewProjectionMatrix()
 	{
 		// 最終的なワールド→クリップ空間変換を用意（描画時に直接使う）
-		viewProjectionMatrix_ = Multiply(viewMatrix_, projectionMatrix_);
+		const Matrix4x4 viewProjectionMatrix = Multiply(viewMatrix_, projectionMatrix_);
+
+		// 変わったときだけ番号を進める（静止したカメラでは WorldTransform の WVP の更新を省ける）
+		if (std::memcmp(&viewProjectionMatrix, &viewProjectionMatrix_, sizeof(Matrix4x4)) != 0) {
+			viewProjectionMatrix_ = viewProjectionMatrix;
+			viewProjectionVersion_ = IssueViewProjectionVersion();
+			frustum_ = MakeFrustum(viewProjectionMatrix_);
+		}
 	}
 
 	float Camera::CalculateAspectRatio()
@@ -1,6 +1,9 @@
 #pragma once
 #include <Transform.h>
+#include <cstdint>
 #include <Matrix4x4.h>
+#include <Frustum.h>
+#include <Quaternion.h>
 #include <WinApp.h>
 #include <Multiply.h>
 
@@ -43,7 +46,9 @@ namespace MyEngine {
 		void Update();
 
 		// セッター
-		void SetRotate(const Vector3& rotate) { transform_.rotate = rotate; }
+		// 回転はクォータニオンで持つ（オイラー角はここで変換する。補間には SetRotation を使う）
+		void SetRotate(const Vector3& rotate) { transform_.rotate = rotate; rotation_ = Math::MakeRotateXYZQuaternion(rotate); }
+		void SetRotation(const Quaternion& rotation) { rotation_ = Math::Normalize(rotation); transform_.rotate = Math::ToEulerXYZ(rotation_); }
 		void SetTranslate(const Vector3& translate) { transform_.translate = translate; }
 		void SetXPosition(float x) { transform_.translate.x = x; }
 		void SetFovY(float fovY) { fovY_ = fovY; }
@@ -56,10 +61,17 @@ namespace MyEngine {
 		const Matrix4x4& GetViewMatrix() const { return viewMatrix_; }
 		const Matrix4x4& GetProjectionMatrix() const { return projectionMatrix_; }
 		const Matrix4x4& GetViewProjectionMatrix() const { return viewProjectionMatrix_; }
+		// ワールド空間の視錐台（ビュープロジェクション行列が変わったときだけ作り直す）
+		const Frustum& GetFrustum() const { return frustum_; }
 		const Vector3& GetRotate() const { return transform_.rotate; }
+		const Quaternion& GetRotation() const { return rotation_; }
 		const Vector3& GetTranslate() const { return transform_.translate; }
 		float GetFovY() const { return fovY_; }
 		float GetAspectRatio() const { return aspectRatio_; }
+		float GetNearClip() const { return nearClip_; }
+		float GetFarClip() const { return farClip_; }
+		// ビュープロジェクション行列が変わるたびに変わる番号（全カメラで重複しない。WorldTransform が WVP の更新要否の判定に使う）
+		uint32_t GetViewProjectionVersion() const { return viewProjectionVersion_; }
 
 	private:
 		// 行列更新ヘルパー
@@ -71,8 +83,9 @@ namespace MyEngine {
 		// アスペクト比計算
 		static float CalculateAspectRatio();
 
-		// 変換情報
+		// 変換情報（transform_.rotate は取得用のオイラー角。行列は rotation_ から作る）
 		Transform transform_;
+		Quaternion rotation_;
 
 		// カメラパラメータ
 		float fovY_;
@@ -85,5 +98,11 @@ namespace MyEngine {
 		Matrix4x4 viewMatrix_;
 		Matrix4x4 projectionMatrix_;
 		Matrix4x4 viewProjectionMatrix_;
+
+		// ビュープロジェクション行列の番号
+		uint32_t viewProjectionVersion_;
+
+		// 視錐台（カリング用）
+		Frustum frustum_;
 	};
 }
@@ -0,0 +1,279 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace MyEngine {
+
+	// アセットの種類
+	enum class AssetType {
+		Texture,
+		Model,
+		Sound,
+		Json,
+	};
+
+	/// <summary>
+	/// 非同期読み込みのうち D3D に触れない部分
+	/// 同じアセットのリクエストをまとめ、ワーカースレッドでデコードし、結果をメインスレッドに受け渡す
+	/// デコードの中身（Decoded の作り方）は Initialize で渡す関数が決める。GPU 登録は ProcessCompleted に渡す関数で行う
+	/// </summary>
+	template <class Decoded>
+	class AssetDecodeQueue
+	{
+	public:
+		/*------型定義------*/
+
+		// 読み込みハンドル（ProcessCompleted で登録関数を呼び終えると ready になる）
+		using Handle = std::shared_future<void>;
+
+		// デコードするジョブ
+		struct Job {
+			AssetType type;
+			std::string filePath;
+			// リクエスト時刻（ログ用）
+			std::chrono::steady_clock::time_point requestTime;
+		};
+
+		// ワーカースレッドで呼ぶデコード関数
+		using DecodeFunction = std::function<Decoded(const Job& job)>;
+
+		// ワーカースレッドの開始時・終了時に呼ぶ関数（COM の初期化など）
+		using ThreadFunction = std::function<void()>;
+
+		/*------メンバ関数------*/
+
+		AssetDecodeQueue() = default;
+		~AssetDecodeQueue() { Finalize(); }
+
+		// コピー・ムーブ禁止
+		AssetDecodeQueue(const AssetDecodeQueue&) = delete;
+		AssetDecodeQueue& operator=(const AssetDecodeQueue&) = delete;
+
+		// 初期化（workerCount 本のワーカースレッドを起動する）
+		void Initialize(uint32_t workerCount, DecodeFunction decode, ThreadFunction threadBegin = nullptr, ThreadFunction threadEnd = nullptr)
+		{
+			assert(!isRunning_ && "AssetDecodeQueue is already initialized!");
+			assert(workerCount > 0 && decode);
+
+			decode_ = std::move(decode);
+			threadBegin_ = std::move(threadBegin);
+			threadEnd_ = std::move(threadEnd);
+			isRunning_ = true;
+			workers_.reserve(workerCount);
+			for (uint32_t i = 0; i < workerCount; ++i) {
+				workers_.emplace_back(&AssetDecodeQueue::WorkerMain, this);
+			}
+		}
+
+		// 終了（未処理のジョブとデコード済みの結果は破棄する）
+		void Finalize()
+		{
+			{
+				std::lock_guard<std::mutex> lock(jobMutex_);
+				isRunning_ = false;
+				jobs_.clear();
+				claimed_.clear();
+			}
+			jobCondition_.notify_all();
+
+			for (std::thread& worker : workers_) {
+				if (worker.joinable()) {
+					worker.join();
+				}
+			}
+			workers_.clear();
+
+			{
+				std::lock_guard<std::mutex> lock(completedMutex_);
+				completed_.clear();
+			}
+			handles_.clear();
+			requestedCount_ = 0;
+			completedCount_ = 0;
+		}
+
+		// 読み込みのリクエスト（メインスレッド専用）
+		// 同じパスのリクエストはハンドルを共有する。isLoaded なら（同期読み込み済みなど）デコードせずに即完了にする
+		Handle Request(AssetType type, const std::string& filePath, bool isLoaded)
+		{
+			assert(isRunning_ && "AssetDecodeQueue is not initialized!");
+
+			auto it = handles_.find(filePath);
+			if (it != handles_.end()) {
+				return it->second;
+			}
+
+			auto promise = std::make_shared<std::promise<void>>();
+			Handle handle = promise->get_future().share();
+			handles_.emplace(filePath, handle);
+
+			if (isLoaded) {
+				promise->set_value();
+				return handle;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(jobMutex_);
+				claimed_.insert(filePath);
+				jobs_.push_back(PendingJob{ Job{ type, filePath, std::chrono::steady_clock::now() }, std::move(promise) });
+			}
+			++requestedCount_;
+			jobCondition_.notify_one();
+			return handle;
+		}
+
+		// デコードを引き受ける（リクエスト済み・引き受け済みなら false。ワーカースレッドから呼べる）
+		// モデルのジョブが参照テクスチャを一緒にデコードするときに、同じテクスチャを二重にデコードしないために使う
+		bool Claim(const std::string& filePath)
+		{
+			std::lock_guard<std::mutex> lock(jobMutex_);
+			return claimed_.insert(filePath).second;
+		}
+
+		// リクエスト済みのハンドル（無ければ nullptr。メインスレッド専用）
+		const Handle* FindHandle(const std::string& filePath) const
+		{
+			auto it = handles_.find(filePath);
+			return it != handles_.end() ? &it->second : nullptr;
+		}
+
+		// ハンドルと引き受けの記録を消す（アセットを解放した後に呼ぶ。次のリクエストでは読み込み直す）
+		void Forget(const std::string& filePath)
+		{
+			handles_.erase(filePath);
+			std::lock_guard<std::mutex> lock(jobMutex_);
+			claimed_.erase(filePath);
+		}
+
+		// デコード済みの結果を最大 maxCount 件 upload に渡し、ハンドルを完了にする（メインスレッド専用）
+		// upload は void(Decoded& decoded, const Job& job, double decodeMs)。処理した件数を返す
+		template <class Upload>
+		uint32_t ProcessCompleted(uint32_t maxCount, Upload&& upload)
+		{
+			uint32_t processed = 0;
+			while (processed < maxCount) {
+				Completed completed;
+				{
+					std::lock_guard<std::mutex> lock(completedMutex_);
+					if (completed_.empty()) {
+						break;
+					}
+					completed = std::move(completed_.front());
+					completed_.pop_front();
+				}
+
+				upload(completed.decoded, completed.job, completed.decodeMs);
+				completed.promise->set_value();
+				++completedCount_;
+				++processed;
+			}
+			return processed;
+		}
+
+		/*------ゲッター------*/
+
+		// リクエスト総数（即完了にしたものは含まない）
+		uint32_t GetRequestedCount() const { return requestedCount_.load(); }
+
+		// 完了数
+		uint32_t GetCompletedCount() const { return completedCount_.load(); }
+
+		// ワーカースレッド数
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+	private:
+		/*------構造体------*/
+
+		// キューに積まれたジョブ
+		struct PendingJob {
+			Job job;
+			std::shared_ptr<std::promise<void>> promise;
+		};
+
+		// デコード済みの結果（メインスレッドでの登録待ち）
+		struct Completed {
+			Decoded decoded;
+			Job job;
+			std::shared_ptr<std::promise<void>> promise;
+			double decodeMs = 0.0;
+		};
+
+		/*------プライベートメンバ関数------*/
+
+		// ワーカースレッドの処理
+		void WorkerMain()
+		{
+			if (threadBegin_) {
+				threadBegin_();
+			}
+
+			while (true) {
+				PendingJob pending;
+				{
+					std::unique_lock<std::mutex> lock(jobMutex_);
+					jobCondition_.wait(lock, [this] { return !isRunning_ || !jobs_.empty(); });
+					if (!isRunning_) {
+						break;
+					}
+					pending = std::move(jobs_.front());
+					jobs_.pop_front();
+				}
+
+				const auto startTime = std::chrono::steady_clock::now();
+				Completed completed{ decode_(pending.job), std::move(pending.job), std::move(pending.promise) };
+				completed.decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+				std::lock_guard<std::mutex> lock(completedMutex_);
+				completed_.push_back(std::move(completed));
+			}
+
+			if (threadEnd_) {
+				threadEnd_();
+			}
+		}
+
+		/*------メンバ変数------*/
+
+		// デコード関数とスレッドの開始・終了時の関数
+		DecodeFunction decode_;
+		ThreadFunction threadBegin_;
+		ThreadFunction threadEnd_;
+
+		// ワーカースレッド
+		std::vector<std::thread> workers_;
+
+		// ジョブキューと、デコードを引き受けたアセット（重複デコード防止）
+		std::mutex jobMutex_;
+		std::condition_variable jobCondition_;
+		std::deque<PendingJob> jobs_;
+		std::unordered_set<std::string> claimed_;
+
+		// 登録待ちキュー
+		std::mutex completedMutex_;
+		std::deque<Completed> completed_;
+
+		// リクエスト済みハンドル（メインスレッド専用）
+		std::unordered_map<std::string, Handle> handles_;
+
+		// 進捗カウンタ
+		std::atomic<uint32_t> requestedCount_ = 0;
+		std::atomic<uint32_t> completedCount_ = 0;
+
+		// 実行中フラグ（jobMutex_ で守る）
+		bool isRunning_ = false;
+	};
+}
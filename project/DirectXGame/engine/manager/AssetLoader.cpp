@@ -0,0 +1,411 @@
+#include "AssetLoader.h"
+#include "TextureManager.h"
+#include "ModelManager.h"
+#include "JsonLoader.h"
+#include "LogFormat.h"
+#include <algorithm>
+#include <cassert>
+#include <Windows.h>
+
+//
+// AssetLoader
+// - テクスチャ / モデル / サウンド / JSON の非同期読み込みサービス。
+// - 処理の流れ：
+//   1) Request* はメインスレッドからジョブを積み、shared_future のハンドルを返す。
+//   2) ワーカースレッドがファイル読み込み・デコード（WIC/DDS 読み込み、ミップ生成、OBJ パース）を行う。
+//      この段階は TextureManager::DecodeTexture / ModelManager::DecodeModel のみを使い、D3D には触れない。
+//   3) デコード結果はアップロード待ちキューに積まれ、メインスレッドの Update で
+//      1 フレームあたり kMaxUploadsPerFrame 件ずつ GPU リソース作成・アップロードされる。
+//   4) 登録が終わるとハンドルの promise が満たされ、進捗カウンタが進む。
+//      アセットごとに デコード時間 / アップロード時間 / リクエストからの経過時間 をログに出す。
+//   * 1)〜3) のキュー（重複排除・ワーカー・受け渡し）は AssetDecodeQueue にあり、D3D を含まないので
+//     project/tests から OBJ / WAV の読み込みを確かめられる。ここではデコード関数と GPU 登録だけを持つ。
+// - マニフェスト：
+//   * PreloadManifest / EnterScene はマニフェストを依存順に展開し、全アセットを一度にリクエストしてから待つ
+//     （ワーカー数ぶん並列にデコードされる）。
+//   * EnterScene は前シーンが所有していたアセットのうち、次シーン（依存・先読み含む）で使わないものを解放する。
+//     寿命が Global のマニフェストに載っているアセットは解放しない。
+//   * テクスチャはリクエストごとにローダーが参照を 1 つ持ち、解放時はその参照を手放すだけにする。
+//     実際の解放は TextureManager がメモリ予算・SRV スロットが足りなくなったときに LRU で行うため、
+//     シーンを行き来しても直前のシーンのテクスチャは再読み込みせずに済む。
+// - 設計メモ：
+//   * コマンドリストはメインスレッドのみが扱うため、GPU 側の処理は必ず Update / WaitAll 経由で行う。
+//   * WIC はスレッドごとに COM 初期化が必要なため、ワーカー開始時に CoInitializeEx を呼ぶ。
+//   * 同期版の LoadTexture / LoadModel と重なった場合は先に登録された方が使われる（二重登録はしない）。
+//
+namespace MyEngine {
+	using namespace AssetLoaderConstants;
+
+	AssetLoader* AssetLoader::GetInstance()
+	{
+		static AssetLoader instance;
+		return &instance;
+	}
+
+	void AssetLoader::Initialize(uint32_t workerCount)
+	{
+		assert(!isRunning_ && "AssetLoader is already initialized!");
+
+		// ワーカー数の決定（メインスレッド分を除いたコア数）
+		if (workerCount == 0) {
+			const uint32_t hardwareCount = std::thread::hardware_concurrency();
+			workerCount = std::clamp(hardwareCount > 1 ? hardwareCount - 1 : kMinWorkerCount, kMinWorkerCount, kMaxWorkerCount);
+		}
+
+		isRunning_ = true;
+		decodeQueue_.Initialize(workerCount,
+			[this](const Job& job) { return Decode(job); },
+			[]() {
+				// WIC デコーダ用に COM を初期化
+				HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+				assert(SUCCEEDED(hr) && "CoInitializeEx failed on loader thread!");
+				(void)hr;
+			},
+			[]() { CoUninitialize(); });
+	}
+
+	void AssetLoader::Finalize()
+	{
+		// 未処理のジョブと未アップロードのアセットは破棄
+		decodeQueue_.Finalize();
+		isRunning_ = false;
+		sceneAssets_.clear();
+		globalAssets_.clear();
+	}
+
+	AssetLoader::Handle AssetLoader::RequestTexture(const std::string& filePath)
+	{
+		return Request(AssetType::Texture, filePath);
+	}
+
+	AssetLoader::Handle AssetLoader::RequestModel(const std::string& filePath)
+	{
+		return Request(AssetType::Model, filePath);
+	}
+
+	AssetLoader::Handle AssetLoader::RequestSound(const std::string& filePath)
+	{
+		return Request(AssetType::Sound, filePath);
+	}
+
+	AssetLoader::Handle AssetLoader::RequestJson(const std::string& fileName)
+	{
+		return Request(AssetType::Json, fileName);
+	}
+
+	void AssetLoader::PreloadManifest(const std::string& manifestName)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+
+		std::vector<AssetManifest> manifests;
+		std::unordered_set<std::string> visited;
+		ResolveManifest(manifestName, manifests, visited);
+
+		// 完了を待つ読み込みなので、テクスチャは一括読み込みで並列デコードし GPU 同期を 1 回にまとめる
+		std::vector<std::string> texturePaths;
+		for (const AssetManifest& manifest : manifests) {
+			texturePaths.insert(texturePaths.end(), manifest.textures.begin(), manifest.textures.end());
+		}
+		TextureManager::GetInstance()->LoadTextures(texturePaths);
+
+		// シーン寿命のアセットは現在のシーンの所有に加える（読み込み済みのテクスチャは即完了になる）
+		std::vector<Handle> handles = RequestManifests(manifests, sceneAssets_);
+		for (const Handle& handle : handles) {
+			Wait(handle);
+		}
+
+		const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+		Logger::LogFormat("[AssetLoader] manifest '{}' : {} assets, {:.2f} ms\n", manifestName, handles.size(), elapsedMs);
+	}
+
+	void AssetLoader::EnterScene(const std::string& manifestName)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+
+		// 次シーンのマニフェスト（依存含む）と先読みマニフェストを展開
+		std::vector<AssetManifest> manifests;
+		std::unordered_set<std::string> visited;
+		ResolveManifest(manifestName, manifests, visited);
+
+		std::vector<AssetManifest> prefetchManifests;
+		for (const AssetManifest& manifest : manifests) {
+			for (const std::string& prefetchName : manifest.prefetch) {
+				ResolveManifest(prefetchName, prefetchManifests, visited);
+			}
+		}
+
+		// 次シーンで使う全アセット
+		std::unordered_set<std::string> nextAssets;
+		for (const auto* list : { &manifests, &prefetchManifests }) {
+			for (const AssetManifest& manifest : *list) {
+				for (const auto* paths : { &manifest.textures, &manifest.models, &manifest.sounds, &manifest.jsons }) {
+					nextAssets.insert(paths->begin(), paths->end());
+				}
+			}
+		}
+
+		// 前シーン専用のアセットを解放（テクスチャを参照するモデルを先に解放する）
+		for (AssetType type : { AssetType::Model, AssetType::Texture, AssetType::Sound, AssetType::Json }) {
+			for (const auto& [filePath, assetType] : sceneAssets_) {
+				if (assetType == type && !nextAssets.contains(filePath) && !globalAssets_.contains(filePath)) {
+					Unload(assetType, filePath);
+				}
+			}
+		}
+		sceneAssets_.clear();
+
+		// 次シーンのアセットを読み込んで待つ
+		std::vector<Handle> handles = RequestManifests(manifests, sceneAssets_);
+		for (const Handle& handle : handles) {
+			Wait(handle);
+		}
+
+		// 先読みは待たない（タイトル画面などの裏で読み込む）
+		RequestManifests(prefetchManifests, sceneAssets_);
+
+		const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+		Logger::LogFormat("[AssetLoader] enter scene '{}' : {} assets, {:.2f} ms\n", manifestName, handles.size(), elapsedMs);
+	}
+
+	void AssetLoader::Update()
+	{
+		ProcessUploads(kMaxUploadsPerFrame);
+	}
+
+	void AssetLoader::Wait(const Handle& handle)
+	{
+		while (!IsReady(handle)) {
+			// デコード待ちの間は他スレッドに譲る
+			if (ProcessUploads(UINT32_MAX) == 0) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void AssetLoader::WaitAll()
+	{
+		while (!IsIdle()) {
+			// デコード待ちの間は他スレッドに譲る
+			if (ProcessUploads(UINT32_MAX) == 0) {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	bool AssetLoader::IsReady(const Handle& handle)
+	{
+		return handle.valid() && handle.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+
+	float AssetLoader::GetProgress() const
+	{
+		const uint32_t requested = GetRequestedCount();
+		if (requested == 0) {
+			return 1.0f;
+		}
+		return static_cast<float>(GetCompletedCount()) / static_cast<float>(requested);
+	}
+
+	// ===== ヘルパー関数 =====
+
+	AssetLoader::Handle AssetLoader::Request(AssetType type, const std::string& filePath)
+	{
+		assert(isRunning_ && "AssetLoader is not initialized!");
+
+		// 同じアセットのリクエストはハンドルを共有する
+		if (const Handle* handle = decodeQueue_.FindHandle(filePath)) {
+			return *handle;
+		}
+
+		// 既に同期読み込み済みなら即完了（テクスチャはローダーの参照を取る）
+		const bool isLoaded = IsLoaded(type, filePath);
+		if (isLoaded && type == AssetType::Texture) {
+			std::shared_ptr<TextureManager> textureManager = TextureManager::GetInstance();
+			textureManager->AddRef(textureManager->GetTextureHandle(filePath));
+		}
+		return decodeQueue_.Request(type, filePath, isLoaded);
+	}
+
+	AssetLoader::DecodedAsset AssetLoader::Decode(const Job& job)
+	{
+		DecodedAsset asset{};
+		switch (job.type) {
+		case AssetType::Texture:
+			asset.image = TextureManager::DecodeTexture(job.filePath);
+			break;
+
+		case AssetType::Model:
+			DecodeModel(asset, job.filePath);
+			break;
+
+		case AssetType::Sound:
+			asset.sound = Audio::DecodeWave(job.filePath.c_str());
+			break;
+
+		case AssetType::Json:
+			asset.json = JsonLoader::DecodeJson(job.filePath);
+			break;
+		}
+		return asset;
+	}
+
+	void AssetLoader::DecodeModel(DecodedAsset& asset, const std::string& filePath)
+	{
+		// OBJ をパースし、参照テクスチャが未着手なら同じジョブでデコードする
+		asset.modelData = ModelManager::DecodeModel(filePath);
+
+		const std::string& textureFilePath = asset.modelData.material.textureFilePath;
+		if (!textureFilePath.empty() && decodeQueue_.Claim(textureFilePath)) {
+			asset.textureFilePath = textureFilePath;
+			asset.textureImage = TextureManager::DecodeTexture(textureFilePath);
+		}
+	}
+
+	void AssetLoader::Upload(DecodedAsset& asset, const Job& job, double decodeMs)
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		std::shared_ptr<TextureManager> textureManager = TextureManager::GetInstance();
+
+		switch (job.type) {
+		case AssetType::Texture:
+			// 返されたハンドルの参照はローダーが持ち、Unload で手放す
+			textureManager->LoadTextureFromImage(job.filePath, asset.image);
+			break;
+
+		case AssetType::Model:
+			// 参照テクスチャを先に登録（未登録のまま Model を作ると同期読み込みになる）
+			// テクスチャの参照は Model 自身が持つため、登録時の参照はモデル作成後に手放す
+			if (!asset.textureFilePath.empty()) {
+				TextureHandle textureHandle = textureManager->LoadTextureFromImage(asset.textureFilePath, asset.textureImage);
+				ModelManager::GetInstance()->LoadModelFromData(job.filePath, std::move(asset.modelData));
+				textureManager->ReleaseTexture(textureHandle);
+			}
+			else {
+				ModelManager::GetInstance()->LoadModelFromData(job.filePath, std::move(asset.modelData));
+			}
+			break;
+
+		case AssetType::Sound:
+			Audio::GetInstance()->RegisterSound(job.filePath, std::move(asset.sound));
+			break;
+
+		case AssetType::Json:
+			JsonLoader::RegisterJson(job.filePath, std::move(asset.json));
+			break;
+		}
+
+		// 読み込み時間のログ（total はリクエストからの経過時間で、キュー待ちを含む）
+		const auto endTime = std::chrono::steady_clock::now();
+		const double uploadMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+		const double totalMs = std::chrono::duration<double, std::milli>(endTime - job.requestTime).count();
+		Logger::LogFormat("[AssetLoader] {} {} : decode {:.2f} ms, upload {:.2f} ms, total {:.2f} ms\n",
+			GetTypeName(job.type), job.filePath, decodeMs, uploadMs, totalMs);
+	}
+
+	bool AssetLoader::IsLoaded(AssetType type, const std::string& filePath)
+	{
+		switch (type) {
+		case AssetType::Texture:
+			return TextureManager::GetInstance()->IsTextureLoaded(filePath);
+		case AssetType::Model:
+			return ModelManager::GetInstance()->FindModel(filePath) != nullptr;
+		case AssetType::Sound:
+			return Audio::GetInstance()->IsSoundLoaded(filePath);
+		case AssetType::Json:
+			return JsonLoader::IsJsonLoaded(filePath);
+		}
+		return false;
+	}
+
+	void AssetLoader::ResolveManifest(const std::string& manifestName, std::vector<AssetManifest>& out, std::unordered_set<std::string>& visited)
+	{
+		if (!visited.insert(manifestName).second) {
+			return;
+		}
+
+		// 依存マニフェストを先に並べる
+		AssetManifest manifest = AssetManifest::Load(manifestName);
+		for (const std::string& dependency : manifest.dependencies) {
+			ResolveManifest(dependency, out, visited);
+		}
+		out.push_back(std::move(manifest));
+	}
+
+	std::vector<AssetLoader::Handle> AssetLoader::RequestManifests(const std::vector<AssetManifest>& manifests, std::unordered_map<std::string, AssetType>& sceneAssets)
+	{
+		std::vector<Handle> handles;
+
+		for (const AssetManifest& manifest : manifests) {
+			const auto request = [&](AssetType type, const std::vector<std::string>& paths) {
+				for (const std::string& path : paths) {
+					handles.push_back(Request(type, path));
+					if (manifest.scope == AssetManifest::Scope::Global) {
+						globalAssets_.insert(path);
+					}
+					else {
+						sceneAssets.emplace(path, type);
+					}
+				}
+			};
+
+			// テクスチャを先にリクエストし、モデルのジョブで同じテクスチャを二重にデコードしないようにする
+			request(AssetType::Texture, manifest.textures);
+			request(AssetType::Model, manifest.models);
+			request(AssetType::Sound, manifest.sounds);
+			request(AssetType::Json, manifest.jsons);
+		}
+
+		return handles;
+	}
+
+	void AssetLoader::Unload(AssetType type, const std::string& filePath)
+	{
+		// 読み込み途中のものは登録を待ってから解放する（解放後に登録されて取り残されないように）
+		if (const Handle* handle = decodeQueue_.FindHandle(filePath)) {
+			Wait(*handle);
+		}
+		decodeQueue_.Forget(filePath);
+
+		switch (type) {
+		case AssetType::Texture:
+			// ローダーの参照を手放す（GPU メモリからは予算を超えたときに LRU で解放される）
+			{
+				std::shared_ptr<TextureManager> textureManager = TextureManager::GetInstance();
+				textureManager->ReleaseTexture(textureManager->GetTextureHandle(filePath));
+			}
+			break;
+
+		case AssetType::Model:
+			ModelManager::GetInstance()->UnloadModel(filePath);
+			break;
+
+		case AssetType::Sound:
+			Audio::GetInstance()->UnloadSound(filePath);
+			break;
+
+		case AssetType::Json:
+			JsonLoader::UnloadJson(filePath);
+			break;
+		}
+
+		Logger::LogFormat("[AssetLoader] unload {} {}\n", GetTypeName(type), filePath);
+	}
+
+	const char* AssetLoader::GetTypeName(AssetType type)
+	{
+		switch (type) {
+		case AssetType::Texture: return "texture";
+		case AssetType::Model:   return "model";
+		case AssetType::Sound:   return "sound";
+		case AssetType::Json:    return "json";
+		}
+		return "unknown";
+	}
+
+	uint32_t AssetLoader::ProcessUploads(uint32_t maxCount)
+	{
+		return decodeQueue_.ProcessCompleted(maxCount, [this](DecodedAsset& asset, const Job& job, double decodeMs) {
+			Upload(asset, job, decodeMs);
+		});
+	}
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <d3d12.h>
+#include <DirectXTex.h>
+#include <json.hpp>
+#include "ModelData.h"
+#include "Audio.h"
+#include "AssetDecodeQueue.h"
+#include "AssetManifest.h"
+
+namespace MyEngine {
+
+	// AssetLoader用の定数
+	namespace AssetLoaderConstants {
+		// ワーカースレッド数の上限（0指定時はコア数-1をこの範囲に収める）
+		constexpr uint32_t kMinWorkerCount = 1;
+		constexpr uint32_t kMaxWorkerCount = 4;
+
+		// 1フレームあたりのGPUアップロード数上限（フレーム落ち防止）
+		constexpr uint32_t kMaxUploadsPerFrame = 4;
+	}
+
+	/// <summary>
+	/// 非同期アセットローダー
+	/// ファイル読み込み・デコードをワーカースレッドで行い（AssetDecodeQueue）、
+	/// GPUリソース作成とアップロードはメインスレッドの Update でまとめて行う
+	/// </summary>
+	class AssetLoader
+	{
+	public:
+		/*------型定義------*/
+
+		// アセットの種類
+		using AssetType = MyEngine::AssetType;
+
+		// 読み込みハンドル（GPUへの登録まで完了すると ready になる）
+		// メインスレッドで wait() するとアップロードが進まずデッドロックするため IsReady で確認すること
+		using Handle = std::shared_future<void>;
+
+		/*------メンバ関数------*/
+
+		// シングルトンインスタンス
+		static AssetLoader* GetInstance();
+
+		// コンストラクタ・デストラクタ
+		AssetLoader() = default;
+		~AssetLoader() = default;
+
+		// コピー・ムーブ禁止
+		AssetLoader(const AssetLoader&) = delete;
+		AssetLoader& operator=(const AssetLoader&) = delete;
+		AssetLoader(AssetLoader&&) = delete;
+		AssetLoader& operator=(AssetLoader&&) = delete;
+
+		// 初期化（workerCount = 0 でコア数から自動決定）
+		void Initialize(uint32_t workerCount = 0);
+
+		// 終了（未処理のリクエストは破棄）
+		void Finalize();
+
+		// テクスチャの読み込みリクエスト
+		Handle RequestTexture(const std::string& filePath);
+
+		// モデルの読み込みリクエスト（参照テクスチャも同じジョブで読み込む）
+		Handle RequestModel(const std::string& filePath);
+
+		// サウンドの読み込みリクエスト
+		Handle RequestSound(const std::string& filePath);
+
+		// JSONパラメータの読み込みリクエスト（拡張子なしのファイル名）
+		Handle RequestJson(const std::string& fileName);
+
+		// マニフェスト（依存含む）の全アセットを並列に読み込み、完了まで待つ
+		void PreloadManifest(const std::string& manifestName);
+
+		// シーン切り替え：前シーン専用のアセットを解放し、次シーンのマニフェストを読み込んで待つ
+		// （旧シーンを破棄した後、新シーンの初期化前に呼ぶこと）
+		void EnterScene(const std::string& manifestName);
+
+		// 更新（デコード済みアセットのGPU登録。メインスレッドで毎フレーム呼ぶ）
+		void Update();
+
+		// 指定ハンドルの完了待ち（メインスレッドでアップロードを回しながら待つ）
+		void Wait(const Handle& handle);
+
+		// 全リクエストの完了待ち（メインスレッドでアップロードを回しながら待つ）
+		void WaitAll();
+
+		// ハンドルの完了判定
+		static bool IsReady(const Handle& handle);
+
+		/*------ゲッター------*/
+
+		// リクエスト総数
+		uint32_t GetRequestedCount() const { return decodeQueue_.GetRequestedCount(); }
+
+		// 完了数
+		uint32_t GetCompletedCount() const { return decodeQueue_.GetCompletedCount(); }
+
+		// 進捗（0.0～1.0、リクエストが無ければ1.0）
+		float GetProgress() const;
+
+		// 全リクエストが完了しているか
+		bool IsIdle() const { return GetCompletedCount() == GetRequestedCount(); }
+
+	private:
+		/*------構造体------*/
+
+		// デコード済みアセット（メインスレッドでのGPU登録待ち。種類に応じたメンバだけを使う）
+		struct DecodedAsset {
+			DirectX::ScratchImage image;
+			ModelData modelData;
+			// モデルの参照テクスチャ（同じジョブでデコードした場合のみ有効）
+			std::string textureFilePath;
+			DirectX::ScratchImage textureImage;
+			SoundData sound;
+			nlohmann::json json;
+		};
+
+		// デコードキューのジョブ
+		using Job = AssetDecodeQueue<DecodedAsset>::Job;
+
+		/*------プライベートメンバ関数------*/
+
+		// リクエストの登録
+		Handle Request(AssetType type, const std::string& filePath);
+
+		// 登録済みか
+		static bool IsLoaded(AssetType type, const std::string& filePath);
+
+		// マニフェストを依存順に並べて読み込む（循環は無視）
+		static void ResolveManifest(const std::string& manifestName, std::vector<AssetManifest>& out, std::unordered_set<std::string>& visited);
+
+		// マニフェスト群の全アセットをリクエストし、シーン寿命のものを sceneAssets に加える
+		std::vector<Handle> RequestManifests(const std::vector<AssetManifest>& manifests, std::unordered_map<std::string, AssetType>& sceneAssets);
+
+		// アセットの解放
+		void Unload(AssetType type, const std::string& filePath);
+
+		// ログ用の種類名
+		static const char* GetTypeName(AssetType type);
+
+		// ジョブのデコード（ワーカースレッド）
+		DecodedAsset Decode(const Job& job);
+
+		// モデルのデコード（参照テクスチャが未着手なら一緒にデコードする）
+		void DecodeModel(DecodedAsset& asset, const std::string& filePath);
+
+		// デコード済みアセットのGPU登録（メインスレッド）
+		void Upload(DecodedAsset& asset, const Job& job, double decodeMs);
+
+		// アップロード待ちを最大 maxCount 件処理し、処理した件数を返す
+		uint32_t ProcessUploads(uint32_t maxCount);
+
+		/*------メンバ変数------*/
+
+		// リクエストの重複排除・ワーカースレッドでのデコード・アップロード待ちキュー
+		AssetDecodeQueue<DecodedAsset> decodeQueue_;
+
+		// 現在のシーンが所有するアセット（シーンを抜けるときの解放候補）
+		std::unordered_map<std::string, AssetType> sceneAssets_;
+
+		// 寿命が Global のアセット（解放しない）
+		std::unordered_set<std::string> globalAssets_;
+
+		// 実行中フラグ
+		bool isRunning_ = false;
+	};
+}
@@ -0,0 +1,65 @@
+#include "AssetManifest.h"
+#include <json.hpp>
+#include <fstream>
+#include <cassert>
+
+//
+// AssetManifest
+// - シーンごとのアセット一覧ファイルを読み込む。
+// - ファイル形式：
+//   {
+//     "scope": "scene",              // "global" なら解放しない（省略時 "scene"）
+//     "dependencies": ["common"],    // 先に読み込むマニフェスト
+//     "prefetch": ["gameplay"],      // 待たずに裏で読み込むマニフェスト
+//     "textures": ["resources/xxx.png"],
+//     "models": ["xxx.obj"],
+//     "sounds": ["resources/xxx.wav"],
+//     "json": ["xxxParameters"]
+//   }
+// - 依存関係の解決と読み込み自体は AssetLoader が行う。
+//
+namespace MyEngine {
+	using namespace AssetManifestConstants;
+
+	namespace {
+		// 文字列配列の読み込み（キーが無ければ空）
+		std::vector<std::string> ReadStringArray(const nlohmann::json& json, const char* key)
+		{
+			std::vector<std::string> result;
+			if (json.contains(key) && json[key].is_array()) {
+				for (const auto& element : json[key]) {
+					result.push_back(element.get<std::string>());
+				}
+			}
+			return result;
+		}
+	}
+
+	AssetManifest AssetManifest::Load(const std::string& name)
+	{
+		const std::string fullpath = kManifestDirectory + name + kManifestExtension;
+
+		std::ifstream file(fullpath);
+		assert(!file.fail() && "マニフェストファイルを開けませんでした");
+
+		nlohmann::json deserialized;
+		file >> deserialized;
+		assert(deserialized.is_object());
+
+		AssetManifest manifest;
+		manifest.name = name;
+
+		if (deserialized.contains("scope") && deserialized["scope"] == "global") {
+			manifest.scope = Scope::Global;
+		}
+
+		manifest.dependencies = ReadStringArray(deserialized, "dependencies");
+		manifest.prefetch = ReadStringArray(deserialized, "prefetch");
+		manifest.textures = ReadStringArray(deserialized, "textures");
+		manifest.models = ReadStringArray(deserialized, "models");
+		manifest.sounds = ReadStringArray(deserialized, "sounds");
+		manifest.jsons = ReadStringArray(deserialized, "json");
+
+		return manifest;
+	}
+}
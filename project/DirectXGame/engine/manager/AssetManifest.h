@@ -0,0 +1,53 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace MyEngine {
+
+	// AssetManifest用の定数
+	namespace AssetManifestConstants {
+		// マニフェストの配置ディレクトリと拡張子
+		constexpr const char* kManifestDirectory = "resources/manifests/";
+		constexpr const char* kManifestExtension = ".json";
+	}
+
+	/// <summary>
+	/// アセットマニフェスト
+	/// シーンで使うテクスチャ・モデル・サウンド・JSONパラメータを列挙したファイル（resources/manifests/名前.json）
+	/// </summary>
+	struct AssetManifest
+	{
+		// アセットの寿命
+		enum class Scope {
+			Global, // 起動中ずっと保持
+			Scene,  // シーンを抜けるときに解放
+		};
+
+		// マニフェスト名
+		std::string name;
+
+		// 寿命
+		Scope scope = Scope::Scene;
+
+		// 依存マニフェスト（先に読み込まれる）
+		std::vector<std::string> dependencies;
+
+		// 先読みマニフェスト（完了を待たずに裏で読み込む。次のシーン用）
+		std::vector<std::string> prefetch;
+
+		// テクスチャ（"resources/xxx.png"）
+		std::vector<std::string> textures;
+
+		// モデル（"xxx.obj"）
+		std::vector<std::string> models;
+
+		// サウンド（"resources/xxx.wav"）
+		std::vector<std::string> sounds;
+
+		// JSONパラメータ（拡張子なしのファイル名。JsonLoader と同じキー）
+		std::vector<std::string> jsons;
+
+		// マニフェストファイルの読み込み
+		static AssetManifest Load(const std::string& name);
+	};
+}
@@ -14,13 +14,14 @@
  - シーン内で利用する Camera* を保持し、毎フレーム Update() で必要な補間処理を実行する。
  - 主な責務:
    * メインカメラの登録と毎フレーム更新
-   * カメラ回転のイージング（easeTargetRotation_, easeFactor_ を用いた線形補間）
+   * カメラ回転のイージング（目標の向きへ毎フレーム easeFactor_ の割合だけ Slerp で近づける）
    * 指定座標へカメラを向ける LookAtTarget の計算（即時 or イージング）
    * カメラの簡易移動補助 MoveTargetAndCamera
 
  注意点:
  - 本クラスはスレッド非対応。メインスレッドから呼び出すことを想定。
- - 角度（ラジアン）の扱いは -π..π に正規化して最短経路で回転補間する。
+ - 回転の補間はクォータニオンの Slerp で行う（常に最短経路。オイラー角を軸ごとに補間すると、
+   ヨーとピッチが同時に大きく変わるときに経路が曲がり、真上・真下付近ではジンバルロックで破綻するため）。
  - easeFactor_ は 0..1 の範囲を期待する（範囲外はクランプする実装あり）。
  - LookAtTarget の pitch/yaw 計算は典型的な球面座標変換を利用している（gimbal lock の簡易対策は入れていない）。
 */
@@ -90,6 +91,7 @@ namespace MyEngine {
 		else {
 			// イージング開始
 			easeTargetRotation_ = targetRotation;
+			easeTargetQuaternion_ = Math::MakeRotateXYZQuaternion(targetRotation);
 			easeFactor_ = ClampEaseFactor(easeFactor);
 			isEasing_ = true;
 		}
@@ -120,48 +122,17 @@ namespace MyEngine {
 
 	void CameraManager::UpdateEasing()
 	{
-		const Vector3 curRot = mainCamera_->GetRotate();
+		const Quaternion& current = mainCamera_->GetRotation();
 
-		// 現在の回転角
-		float curPitch = curRot.x;
-		float curYaw = curRot.y;
-
-		// 目標との差を最短で取得
-		float diffPitch = ShortestAngleDiff(curPitch, easeTargetRotation_.x);
-		float diffYaw = ShortestAngleDiff(curYaw, easeTargetRotation_.y);
-
-		// 線形補間で新しい回転を計算
-		float newPitch = curPitch + diffPitch * easeFactor_;
-		float newYaw = curYaw + diffYaw * easeFactor_;
-
-		// 収束判定
-		if (IsEasingComplete(diffPitch, diffYaw)) {
+		// 収束判定（目標に十分近ければ目標のオイラー角をそのまま設定して終了）
+		if (IsEasingComplete(current, easeTargetQuaternion_)) {
 			isEasing_ = false;
-			newPitch = easeTargetRotation_.x;
-			newYaw = easeTargetRotation_.y;
+			mainCamera_->SetRotate(easeTargetRotation_);
+			return;
 		}
 
-		// Z（ロール）は 0 に固定
-		mainCamera_->SetRotate(Vector3(newPitch, newYaw, kDefaultRotationZ));
-	}
-
-	float CameraManager::NormalizeAngle(float angle)
-	{
-		// 角度を (-PI, PI] の範囲に正規化
-		while (angle > kPI) {
-			angle -= kTwoPI;
-		}
-		while (angle <= -kPI) {
-			angle += kTwoPI;
-		}
-		return angle;
-	}
-
-	float CameraManager::ShortestAngleDiff(float current, float target)
-	{
-		// 最短角度差を計算
-		float diff = NormalizeAngle(target - current);
-		return diff;
+		// 目標の向きへ easeFactor_ の割合だけ球面線形補間で近づける
+		mainCamera_->SetRotation(Math::Slerp(current, easeTargetQuaternion_, easeFactor_));
 	}
 
 	Vector3 CameraManager::CalculateRotationToTarget(const Vector3& fromPosition, const Vector3& toPosition)
@@ -185,10 +156,10 @@ namespace MyEngine {
 		return factor;
 	}
 
-	bool CameraManager::IsEasingComplete(float diffPitch, float diffYaw) const
+	bool CameraManager::IsEasingComplete(const Quaternion& current, const Quaternion& target) const
 	{
-		// 目標に十分近づいたかを判定
-		return std::fabs(diffPitch) < angleEpsilon_ && std::fabs(diffYaw) < angleEpsilon_;
+		// 目標の向きとの間の角度が十分小さいかを判定
+		return Math::AngleBetween(current, target) < angleEpsilon_;
 	}
 
 	void CameraManager::DrawImGuiCameraTransform()
@@ -9,7 +9,7 @@ namespace MyEngine {
 		// デフォルトのイージング係数
 		constexpr float kDefaultEaseFactor = 0.1f;
 
-		// 角度のイプシロン（収束判定用）
+		// 角度のイプシロン（収束判定用。現在の向きと目標の向きの間の角度）
 		constexpr float kAngleEpsilon = 1e-3f;
 
 		// イージング係数の範囲
@@ -21,10 +21,6 @@ namespace MyEngine {
 		constexpr float kDefaultRotationY = 0.0f;
 		constexpr float kDefaultRotationZ = 0.0f;
 
-		// 円周率
-		constexpr float kPI = 3.14159265358979323846f;
-		constexpr float kTwoPI = 2.0f * kPI;
-
 		// ImGuiの行列表示用
 		constexpr int kMatrixRows = 4;
 		constexpr int kMatrixColumns = 4;
@@ -72,12 +68,6 @@ namespace MyEngine {
 		// イージング更新
 		void UpdateEasing();
 
-		// 角度の正規化
-		static float NormalizeAngle(float angle);
-
-		// 最短角度差の計算
-		static float ShortestAngleDiff(float current, float target);
-
 		// 回転角の計算
 		static Vector3 CalculateRotationToTarget(const Vector3& fromPosition, const Vector3& toPosition);
 
@@ -85,7 +75,7 @@ namespace MyEngine {
 		static float ClampEaseFactor(float factor);
 
 		// イージング完了判定
-		bool IsEasingComplete(float diffPitch, float diffYaw) const;
+		bool IsEasingComplete(const Quaternion& current, const Quaternion& target) const;
 
 		// ImGuiヘルパー
 		void DrawImGuiCameraTransform();
@@ -101,6 +91,8 @@ namespace MyEngine {
 			CameraManagerConstants::kDefaultRotationY,
 			CameraManagerConstants::kDefaultRotationZ
 		};
+		// 目標の向き（easeTargetRotation_ をクォータニオンにしたもの。補間はこちらで行う）
+		Quaternion easeTargetQuaternion_ = Math::IdentityQuaternion();
 		float easeFactor_ = CameraManagerConstants::kDefaultEaseFactor;
 		float angleEpsilon_ = CameraManagerConstants::kAngleEpsilon;
 	};
@@ -1,6 +1,8 @@
 #include "CollisionManager.h"
 #include "Collider.h"
 #include "CollisionTypeIdDef.h"
+#include "AllocationCounter.h"
+#include <algorithm>
 #include <cmath>
 
 //
@@ -12,7 +14,7 @@
 //   * 衝突の判定は球（Sphere）による簡易判定を用いる。
 //   * 衝突発生時は各 Collider の OnCollision(Collider*) を呼び出して応答させる（コールバック方式）。
 // - 注意点 / 制約：
-//   * colliders_ は生ポインタのリストを保持している（所有権は外部が持つ想定）。登録解除やライフサイクル管理は呼び出し側で行うこと。
+//   * colliders_ は生ポインタの配列を保持している（所有権は外部が持つ想定）。登録解除やライフサイクル管理は呼び出し側で行うこと。
 //   * 大量のコライダーが存在する場合は Broad-phase（空間分割 / BVH / グリッド等）を導入して性能改善を検討すること。
 //   * CheckSphereCollision 内では距離計算に sqrt を用いて実際の距離を比較している（最適化の余地あり：距離の二乗を比較する方法を推奨）。
 //   * 衝突ペアのフィルタリングは CheckCollisionPair 内で行っている。新しいタイプ追加時はここにルールを追加する必要がある。
@@ -51,12 +53,15 @@ namespace MyEngine {
 	{
 		// 登録されているコライダー一覧をクリアする
 		// - コライダー自体の破棄は行わない（ownershipは外部）
+		// - clear は容量を残すため、次のフレームの登録ではヒープ確保が起きない
 		colliders_.clear();
 	}
 
 	void CollisionManager::CheckCollision()
 	{
 		// 全体の衝突判定ルーチン（全ペア総当たり）
+		// OnCollision の応答で確保したものも Collision として数える
+		MemoryTagScope memoryTag(MemoryTag::Collision);
 		CheckAllPairs();
 	}
 
@@ -66,6 +71,7 @@ namespace MyEngine {
 		if (!collider) return;
 
 		// コライダーを登録する
+		MemoryTagScope memoryTag(MemoryTag::Collision);
 		colliders_.push_back(collider);
 	}
 
@@ -74,8 +80,8 @@ namespace MyEngine {
 		// nullptrチェック
 		if (!collider) return;
 
-		// コライダーを登録リストから削除する
-		colliders_.remove(collider);
+		// コライダーを登録配列から削除する
+		std::erase(colliders_, collider);
 	}
 
 	void CollisionManager::CheckCollisionPair(Collider* colliderA, Collider* colliderB)
@@ -193,22 +199,19 @@ namespace MyEngine {
 
 	void CollisionManager::CheckAllPairs()
 	{
-		// 実装: 二重ループでペアを生成。重複チェックを避けるため itrB は itrA の次から開始する。
+		// 実装: 二重ループでペアを生成。重複チェックを避けるため indexB は indexA の次から開始する。
 		// 時間計算量は O(n^2)。要素数が増えると性能悪化するため注意。
+		// OnCollision 内で登録が増減しても添字が無効にならないよう、毎回 size() と比較する。
 
-		std::list<Collider*>::iterator itrA = colliders_.begin();
-		for (; itrA != colliders_.end(); ++itrA) {
-			Collider* colliderA = *itrA;
+		for (size_t indexA = 0; indexA < colliders_.size(); ++indexA) {
+			Collider* colliderA = colliders_[indexA];
 
 			// nullptrチェック
 			if (!colliderA) continue;
 
-			// itrB は itrA の次から回す（同一ペアの二重処理を回避）
-			std::list<Collider*>::iterator itrB = itrA;
-			++itrB;
-
-			for (; itrB != colliders_.end(); ++itrB) {
-				Collider* colliderB = *itrB;
+			// indexB は indexA の次から回す（同一ペアの二重処理を回避）
+			for (size_t indexB = indexA + 1; indexB < colliders_.size(); ++indexB) {
+				Collider* colliderB = colliders_[indexB];
 
 				// nullptrチェック
 				if (!colliderB) continue;
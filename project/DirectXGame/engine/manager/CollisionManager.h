@@ -1,6 +1,6 @@
 #pragma once
-#include <list>
 #include <memory>
+#include <vector>
 #include "Vector3.h"
 
 namespace MyEngine {
@@ -51,7 +51,7 @@ namespace CollisionManagerConstants {
 
 		// ゲッター
 		size_t GetColliderCount() const { return colliders_.size(); }
-		const std::list<Collider*>& GetColliders() const { return colliders_; }
+		const std::vector<Collider*>& GetColliders() const { return colliders_; }
 
 	private:
 		// 衝突判定のフィルタリング
@@ -66,7 +66,7 @@ namespace CollisionManagerConstants {
 		// 全ペアの衝突判定を実行
 		void CheckAllPairs();
 
-		// 衝突オブジェクトのリスト
-		std::list<Collider*> colliders_;
+		// 衝突オブジェクトの配列（毎フレーム登録し直すため、容量を保持する vector にしてノードの確保を無くしている）
+		std::vector<Collider*> colliders_;
 	};
 }
@@ -1,4 +1,6 @@
 #include "ImGuiManager.h"
+#include "AllocationCounter.h"
+#include "MemoryReport.h"
 #ifdef USE_IMGUI
 #include <imgui.h>
 #include <imgui_impl_win32.h>
@@ -16,6 +18,7 @@
 //   * Begin/End はアプリケーション側のレンダリングループでフレーム毎に呼び出すこと。
 //   * Draw() はコマンドリストを取得して SRV を含むヒープをセットし、ImGui のレンダリングを行う。
 //   * Finalize() は ImGui のバックエンドをシャットダウンし、確保したヒープを解放する。
+//   * DrawMemoryStats() は AllocationCounter のタグ別統計を表にし、MemoryReport で JSON に書き出せる。
 //
 namespace MyEngine {
 	void ImGuiManager::Initialize(WinApp* winApp_)
@@ -88,6 +91,59 @@ namespace MyEngine {
 	}
 
 
+	void ImGuiManager::DrawMemoryStats()
+	{
+#ifdef USE_IMGUI
+		ImGui::Begin("Memory Stats");
+
+		if (!AllocationCounter::IsEnabled()) {
+			ImGui::TextDisabled("Heap allocation counter is disabled in this build");
+			ImGui::End();
+			return;
+		}
+
+		// 1 行分（確保中・最大は KB、確保回数は直前のフレーム / 1 フレームの最大 / 起動からの累計）
+		const auto drawRow = [](const char* name, const AllocationCounter::TagStats& stats) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", static_cast<double>(stats.liveBytes) / 1024.0);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", static_cast<double>(stats.peakBytes) / 1024.0);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.lastFrameAllocationCount));
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.peakFrameAllocationCount));
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats.allocationCount));
+		};
+
+		if (ImGui::BeginTable("MemoryTags", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+			ImGui::TableSetupColumn("Tag");
+			ImGui::TableSetupColumn("Live KB");
+			ImGui::TableSetupColumn("Peak KB");
+			ImGui::TableSetupColumn("Allocs/Frame");
+			ImGui::TableSetupColumn("Peak/Frame");
+			ImGui::TableSetupColumn("Total Allocs");
+			ImGui::TableHeadersRow();
+
+			for (uint32_t i = 0; i < kMemoryTagCount; ++i) {
+				const MemoryTag tag = static_cast<MemoryTag>(i);
+				drawRow(GetMemoryTagName(tag), AllocationCounter::GetTagStats(tag));
+			}
+			drawRow("Total", AllocationCounter::GetTotalStats());
+
+			ImGui::EndTable();
+		}
+
+		if (ImGui::Button("Dump JSON")) {
+			MemoryReport::WriteJson(MemoryReportConstants::kDefaultDumpFilePath);
+		}
+
+		ImGui::End();
+#endif
+	}
 
 	void ImGuiManager::Finalize()
 	{
@@ -21,6 +21,9 @@ namespace MyEngine {
 		/// 描画
 		void Draw();
 
+		/// メモリ統計（タグ別の確保中・最大バイト数と 1 フレームあたりの確保回数）
+		void DrawMemoryStats();
+
 		/// <summary>
 		/// 終了
 		/// </summary>
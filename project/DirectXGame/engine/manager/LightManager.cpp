@@ -0,0 +1,234 @@
+#include "LightManager.h"
+#include "Camera.h"
+#include "DirectXCommon.h"
+#include "Logger.h"
+#include "Normalize.h"
+#include "WinApp.h"
+#include <ResourceManager.h>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <numbers>
+#ifdef USE_IMGUI
+#include <imgui.h>
+#endif
+
+//
+// LightManager
+// - 以前は Object3d が 1 つずつライト 3 種とカメラの定数バッファ（計 4 つ）を持っていたが、中身はどれもシーン共通の値だった。
+//   ここで 1 フレームに 1 つの定数バッファにまとめ、Object3dCommon::DrawSettings でパスごとに 1 回だけ設定する。
+// - オブジェクトごとに輝度だけを変えたいもの（スカイドームのポイントライトを 0 にするなど）は、
+//   輝度の上書きを表に登録し、その番号を Object3d がルート定数で渡す。表はバッファの末尾に置き、登録時に書き込む。
+// - カメラの位置とシーンのライトはフレームグラフの "Lighting" タスクで、シーンとカメラの更新後に 1 回だけ書き込む。
+// - 爆発などで一時的に足すライト（数百個）はシーンのライトのように全ピクセルで回すと重いので、
+//   LightClusterGrid で視錐台のクラスタに分類し、ピクセルは自分のクラスタに掛かるライトだけを回す。
+//   ライト・クラスタ・番号の配列は Upload ヒープの StructuredBuffer に直接書き、ルート SRV で渡す。
+//
+using namespace Math;
+namespace MyEngine {
+	using namespace LightManagerConstants;
+
+	// HLSL の定数バッファは構造体を 16 バイト単位で並べるので、C++ 側も 16 バイトの倍数にしておく
+	static_assert(sizeof(LightManager::DirectionalLight) % 16 == 0 && sizeof(LightManager::PointLight) % 16 == 0 &&
+		sizeof(LightManager::SpotLight) % 16 == 0 && sizeof(LightManager::LightOverride) % 16 == 0,
+		"light structs must match HLSL constant buffer packing");
+
+	LightManager* LightManager::GetInstance()
+	{
+		static LightManager instance;
+		return &instance;
+	}
+
+	void LightManager::Initialize(DirectXCommon* dxCommon)
+	{
+		// 定数バッファ作成
+		resource_ = ResourceManager::CreateBufferResource(dxCommon->GetDevice().Get(), sizeof(FrameLightingForGPU));
+		resource_->Map(0, nullptr, reinterpret_cast<void**>(&data_));
+		*data_ = {};
+
+		// ディレクショナルライトのデフォルト値
+		directionalLight_.color = kDefaultLightColor;
+		directionalLight_.direction = Normalize(Vector3{ 0.0f, kDefaultDirectionalLightDirectionY, 0.0f });
+		directionalLight_.intensity = kDefaultLightIntensity;
+
+		// ポイントライトのデフォルト値
+		pointLight_.color = kDefaultLightColor;
+		pointLight_.position = { 0.0f, kDefaultLightPositionY, 0.0f };
+		pointLight_.intensity = kDefaultPointLightIntensity;
+		pointLight_.radius = kDefaultPointLightRadius;
+		pointLight_.decay = kDefaultPointLightDecay;
+
+		// スポットライトのデフォルト値
+		spotLight_.color = kDefaultLightColor;
+		spotLight_.position = { 0.0f, kDefaultLightPositionY, 0.0f };
+		spotLight_.intensity = kDefaultSpotLightIntensity;
+		spotLight_.direction = { 0.0f, kDefaultDirectionalLightDirectionY, 0.0f };
+		spotLight_.cosAngle = std::cos(std::numbers::pi_v<float> / kSpotLightAngleDivisor);
+		spotLight_.cosFalloffStart = std::cos(std::numbers::pi_v<float> / kSpotLightFalloffAngleDivisor);
+		spotLight_.distance = kDefaultSpotLightDistance;
+		spotLight_.decay = kDefaultSpotLightDecay;
+
+		// 0 番は上書き無し
+		overrides_.clear();
+		overrides_.push_back(LightOverride{});
+		data_->overrides[0] = overrides_[0];
+		isOverrideOverflowLogged_ = false;
+
+		// クラスタの StructuredBuffer 作成（空のクラスタでも読めるよう、全て最大数で作っておく）
+		ID3D12Device* device = dxCommon->GetDevice().Get();
+		clusterPointLightResource_ = ResourceManager::CreateBufferResource(device, sizeof(PointLight) * kMaxClusterPointLightCount);
+		clusterSpotLightResource_ = ResourceManager::CreateBufferResource(device, sizeof(SpotLight) * kMaxClusterSpotLightCount);
+		clusterResource_ = ResourceManager::CreateBufferResource(device, sizeof(LightClusterGrid::Cluster) * LightClusterConstants::kClusterCount);
+		clusterLightIndexResource_ = ResourceManager::CreateBufferResource(device, sizeof(uint32_t) * kMaxClusterLightIndexCount);
+		clusterPointLightResource_->Map(0, nullptr, reinterpret_cast<void**>(&clusterPointLightData_));
+		clusterSpotLightResource_->Map(0, nullptr, reinterpret_cast<void**>(&clusterSpotLightData_));
+		clusterResource_->Map(0, nullptr, reinterpret_cast<void**>(&clusterData_));
+		clusterLightIndexResource_->Map(0, nullptr, reinterpret_cast<void**>(&clusterLightIndexData_));
+		std::memset(clusterData_, 0, sizeof(LightClusterGrid::Cluster) * LightClusterConstants::kClusterCount);
+
+		clusterGrid_.SetMaxIndexCount(kMaxClusterLightIndexCount);
+		transientPointLights_.clear();
+		transientSpotLights_.clear();
+		data_->clusterTileScaleX = float(LightClusterConstants::kClusterCountX) / float(WinApp::kClientWidth);
+		data_->clusterTileScaleY = float(LightClusterConstants::kClusterCountY) / float(WinApp::kClientHeight);
+	}
+
+	void LightManager::Update(const Camera* camera)
+	{
+		if (camera) {
+			data_->cameraWorldPosition = camera->GetTranslate();
+		}
+		data_->directionalLight = directionalLight_;
+		data_->pointLight = pointLight_;
+		data_->spotLight = spotLight_;
+
+		UpdateClusters(camera);
+	}
+
+	void LightManager::AddPointLight(const PointLight& light, float lifeTime)
+	{
+		std::lock_guard<std::mutex> lock(transientMutex_);
+		transientPointLights_.push_back({ light, lifeTime, 0.0f });
+	}
+
+	void LightManager::AddSpotLight(const SpotLight& light, float lifeTime)
+	{
+		std::lock_guard<std::mutex> lock(transientMutex_);
+		transientSpotLights_.push_back({ light, lifeTime, 0.0f });
+	}
+
+	void LightManager::UpdateClusters(const Camera* camera)
+	{
+		std::lock_guard<std::mutex> lock(transientMutex_);
+
+		// 寿命に合わせて輝度を下げたライトを StructuredBuffer に書き、分類用の球を作る（Upload ヒープは読み返さない）
+		pointLightSpheres_.clear();
+		spotLightSpheres_.clear();
+		clusterPointLightCount_ = (std::min)(static_cast<uint32_t>(transientPointLights_.size()), kMaxClusterPointLightCount);
+		clusterSpotLightCount_ = (std::min)(static_cast<uint32_t>(transientSpotLights_.size()), kMaxClusterSpotLightCount);
+		for (uint32_t i = 0; i < clusterPointLightCount_; i++) {
+			const TransientLight<PointLight>& transient = transientPointLights_[i];
+			PointLight light = transient.light;
+			if (transient.lifeTime > 0.0f) {
+				light.intensity *= (std::max)(0.0f, 1.0f - transient.time / transient.lifeTime);
+			}
+			clusterPointLightData_[i] = light;
+			pointLightSpheres_.push_back({ light.position, light.radius });
+		}
+		for (uint32_t i = 0; i < clusterSpotLightCount_; i++) {
+			const TransientLight<SpotLight>& transient = transientSpotLights_[i];
+			SpotLight light = transient.light;
+			if (transient.lifeTime > 0.0f) {
+				light.intensity *= (std::max)(0.0f, 1.0f - transient.time / transient.lifeTime);
+			}
+			clusterSpotLightData_[i] = light;
+			// 円錐は届く距離を半径とする球で近似する
+			spotLightSpheres_.push_back({ light.position, light.distance });
+		}
+
+		// 分類してクラスタと番号を書き込む（カメラが無いときは空のままにする）
+		if (camera) {
+			LightClusterGrid::Desc desc;
+			desc.view = camera->GetViewMatrix();
+			desc.fovY = camera->GetFovY();
+			desc.aspectRatio = camera->GetAspectRatio();
+			desc.nearClip = camera->GetNearClip();
+			desc.farClip = camera->GetFarClip();
+			clusterGrid_.Build(desc, pointLightSpheres_.data(), clusterPointLightCount_, spotLightSpheres_.data(), clusterSpotLightCount_);
+
+			const std::vector<LightClusterGrid::Cluster>& clusters = clusterGrid_.GetClusters();
+			const std::vector<uint32_t>& indices = clusterGrid_.GetIndices();
+			std::memcpy(clusterData_, clusters.data(), sizeof(LightClusterGrid::Cluster) * clusters.size());
+			if (!indices.empty()) {
+				std::memcpy(clusterLightIndexData_, indices.data(), sizeof(uint32_t) * indices.size());
+			}
+
+			const LightClusterGrid::ShaderParams& params = clusterGrid_.GetShaderParams();
+			data_->clusterDepthAxis = params.depthAxis;
+			data_->clusterZScale = params.zScale;
+			data_->clusterZBias = params.zBias;
+		}
+
+		// 寿命を進め、尽きたものを外す（寿命 0 のものはこのフレームだけ）
+		auto advance = [](auto& lights) {
+			for (auto& light : lights) {
+				light.time += kLightDeltaTime;
+			}
+			std::erase_if(lights, [](const auto& light) { return light.time >= light.lifeTime; });
+		};
+		advance(transientPointLights_);
+		advance(transientSpotLights_);
+	}
+
+	uint32_t LightManager::FindOrAddOverride(const LightOverride& lightOverride)
+	{
+		// Object3d の初期化は読み込みスレッドからも呼ばれうるので排他する
+		std::lock_guard<std::mutex> lock(overrideMutex_);
+		for (uint32_t i = 0; i < overrides_.size(); i++) {
+			if (overrides_[i] == lightOverride) {
+				return i;
+			}
+		}
+
+		// 表が埋まっていたら上書き無し（0 番）で描く。GPU 側の表の外へは書き込まない
+		if (overrides_.size() >= kMaxLightOverrideCount) {
+			if (!isOverrideOverflowLogged_) {
+				Logger::Log("LightManager: too many light overrides, falling back to the scene lights\n");
+				isOverrideOverflowLogged_ = true;
+			}
+			return 0;
+		}
+
+		const uint32_t index = static_cast<uint32_t>(overrides_.size());
+		overrides_.push_back(lightOverride);
+		data_->overrides[index] = lightOverride;
+		return index;
+	}
+
+	void LightManager::DrawImGui()
+	{
+#ifdef USE_IMGUI
+		ImGui::ColorEdit4("lightColor", &directionalLight_.color.x);
+		ImGui::DragFloat3("lightDirection", &directionalLight_.direction.x, 0.01f);
+		ImGui::DragFloat("intensity", &directionalLight_.intensity, 0.01f);
+
+		ImGui::ColorEdit4("pointLightColor", &pointLight_.color.x);
+		ImGui::DragFloat3("pointLightPosition", &pointLight_.position.x, 0.01f);
+		ImGui::DragFloat("pointLightIntensity", &pointLight_.intensity, 0.01f);
+
+		ImGui::ColorEdit4("spotLightColor", &spotLight_.color.x);
+		ImGui::DragFloat3("spotLightPosition", &spotLight_.position.x, 0.01f);
+		ImGui::DragFloat3("spotLightDirection", &spotLight_.direction.x, 0.01f);
+		ImGui::DragFloat("spotLightIntensity", &spotLight_.intensity, 0.01f);
+		ImGui::DragFloat("spotLightDistance", &spotLight_.distance, 0.01f);
+		ImGui::DragFloat("spotLightDecay", &spotLight_.decay, 0.01f);
+		ImGui::DragFloat("spotLightCosAngle", &spotLight_.cosAngle, 0.01f);
+		ImGui::DragFloat("spotLightCosFalloffStart", &spotLight_.cosFalloffStart, 0.01f);
+
+		ImGui::Text("light overrides: %u / %u", GetOverrideCount(), kMaxLightOverrideCount);
+		ImGui::Text("cluster lights: point %u / %u, spot %u / %u", clusterPointLightCount_, kMaxClusterPointLightCount,
+			clusterSpotLightCount_, kMaxClusterSpotLightCount);
+		ImGui::Text("cluster light indices: %u / %u", static_cast<uint32_t>(clusterGrid_.GetIndices().size()), kMaxClusterLightIndexCount);
+#endif
+	}
+}
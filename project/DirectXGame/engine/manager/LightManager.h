@@ -0,0 +1,215 @@
+#pragma once
+#include "LightClusterGrid.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <wrl.h>
+#include <d3d12.h>
+
+namespace MyEngine {
+	// 前方宣言
+	class Camera;
+	class DirectXCommon;
+
+	// LightManager用の定数
+	namespace LightManagerConstants {
+		// オブジェクトごとの上書きの最大数（0 番は「上書き無し」）
+		constexpr uint32_t kMaxLightOverrideCount = 16;
+
+		// 上書きの輝度がこの値ならシーンのライトの輝度をそのまま使う
+		constexpr float kUseSceneIntensity = -1.0f;
+
+		// ライトのデフォルト値
+		constexpr Vector4 kDefaultLightColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+		constexpr float kDefaultLightIntensity = 3.0f;
+		constexpr float kDefaultPointLightIntensity = 1.0f;
+		constexpr float kDefaultPointLightRadius = 10.0f;
+		constexpr float kDefaultPointLightDecay = 1.0f;
+		constexpr float kDefaultSpotLightIntensity = 4.0f;
+		constexpr float kDefaultSpotLightDistance = 7.0f;
+		constexpr float kDefaultSpotLightDecay = 2.0f;
+
+		// ポジションのデフォルト値
+		constexpr float kDefaultLightPositionY = 2.0f;
+		constexpr float kDefaultDirectionalLightDirectionY = -1.0f;
+
+		// スポットライトの角度
+		constexpr float kSpotLightAngleDivisor = 3.0f;
+		constexpr float kSpotLightFalloffAngleDivisor = 6.0f;
+
+		// クラスタで配る追加のライトの最大数（超えた分は捨てる）
+		constexpr uint32_t kMaxClusterPointLightCount = 256;
+		constexpr uint32_t kMaxClusterSpotLightCount = 64;
+
+		// クラスタのライトの番号の最大数（超えた分は奥のクラスタから切り詰める）
+		constexpr uint32_t kMaxClusterLightIndexCount = 32768;
+
+		// 追加のライトの寿命を進める 1 フレームの時間
+		constexpr float kLightDeltaTime = 1.0f / 60.0f;
+	}
+
+	/// <summary>
+	/// シーンのライトとカメラ（Object3d が共通で使う 1 フレームに 1 つの定数バッファ）
+	/// 爆発などで一時的に足すライトはクラスタに分類し、StructuredBuffer でピクセルシェーダーに渡す
+	/// </summary>
+	class LightManager
+	{
+	public:
+		/*------構造体------*/
+
+		// ディレクショナルライトデータ
+		struct DirectionalLight {
+			Vector4 color; // ライトの色
+			Vector3 direction; // ライトの向き
+			float intensity; // 輝度
+		};
+
+		// ポイントライトデータ
+		struct PointLight {
+			Vector4 color; // ライトの色
+			Vector3 position; // ライトの位置
+			float intensity; // 輝度
+			float radius; // ライトの届く最大距離
+			float decay; // 減衰率
+			float padding[2]; // パディング
+		};
+
+		// スポットライトデータ
+		struct SpotLight {
+			Vector4 color; // ライトの色
+			Vector3 position; // ライトの位置
+			float intensity; // 輝度
+			Vector3 direction; // ライトの向き
+			float cosAngle; // スポットライトの角度
+			float cosFalloffStart; // スポットライトの開始角度の余弦値
+			float distance; // ライトの届く最大距離
+			float decay; // 減衰率
+			float padding; // パディング
+		};
+
+		// オブジェクトごとのライトの輝度の上書き（kUseSceneIntensity ならシーンの値）
+		struct LightOverride {
+			float directionalIntensity = LightManagerConstants::kUseSceneIntensity;
+			float pointIntensity = LightManagerConstants::kUseSceneIntensity;
+			float spotIntensity = LightManagerConstants::kUseSceneIntensity;
+			float padding = 0.0f;
+
+			bool operator==(const LightOverride& other) const {
+				return directionalIntensity == other.directionalIntensity &&
+					pointIntensity == other.pointIntensity &&
+					spotIntensity == other.spotIntensity;
+			}
+		};
+
+		// GPU に渡すデータ（Object3d.PS.hlsl の FrameLighting と同じ並び。各メンバは 16 バイト単位）
+		struct FrameLightingForGPU {
+			Vector3 cameraWorldPosition; // カメラのワールド座標
+			float padding; // パディング
+			DirectionalLight directionalLight;
+			PointLight pointLight;
+			SpotLight spotLight;
+			LightOverride overrides[LightManagerConstants::kMaxLightOverrideCount];
+			Vector4 clusterDepthAxis; // ビュー空間の z = dot(float4(ワールド座標, 1), clusterDepthAxis)
+			float clusterTileScaleX; // ピクセル座標からタイルの番号への倍率
+			float clusterTileScaleY;
+			float clusterZScale; // スライス = log(z) * clusterZScale + clusterZBias
+			float clusterZBias;
+		};
+
+		/*------メンバ関数------*/
+
+		// シングルトンインスタンス
+		static LightManager* GetInstance();
+
+		// コンストラクタ・デストラクタ
+		LightManager() = default;
+		~LightManager() = default;
+
+		// コピー禁止
+		LightManager(const LightManager&) = delete;
+		LightManager& operator=(const LightManager&) = delete;
+
+		// 初期化（定数バッファを作り、ライトをデフォルト値にする）
+		void Initialize(DirectXCommon* dxCommon);
+
+		// 更新（カメラの位置とシーンのライトを定数バッファに書き込む）
+		void Update(const Camera* camera);
+
+		// 上書きの番号を返す（同じ内容のものがあれば使い回し、無ければ追加する。表が埋まっていたら 0 番＝上書き無し）
+		uint32_t FindOrAddOverride(const LightOverride& lightOverride);
+
+		// 追加のライト（lifeTime 秒かけて輝度が 0 になる。0 なら次の Update の 1 フレームだけ）
+		// ゲームオブジェクトの更新から呼ぶ。シーンのライトと違い、輝度の上書きは効かない
+		void AddPointLight(const PointLight& light, float lifeTime = 0.0f);
+		void AddSpotLight(const SpotLight& light, float lifeTime = 0.0f);
+
+		// ImGui でシーンのライトを編集する（呼び出し側の ImGui ウィンドウの中に描く）
+		void DrawImGui();
+
+		/*------ゲッター------*/
+
+		DirectionalLight& GetDirectionalLight() { return directionalLight_; }
+		PointLight& GetPointLight() { return pointLight_; }
+		SpotLight& GetSpotLight() { return spotLight_; }
+		D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress() const { return resource_->GetGPUVirtualAddress(); }
+		uint32_t GetOverrideCount() const { return static_cast<uint32_t>(overrides_.size()); }
+
+		// クラスタのバッファ（ルート SRV で渡す）
+		D3D12_GPU_VIRTUAL_ADDRESS GetClusterPointLightAddress() const { return clusterPointLightResource_->GetGPUVirtualAddress(); }
+		D3D12_GPU_VIRTUAL_ADDRESS GetClusterSpotLightAddress() const { return clusterSpotLightResource_->GetGPUVirtualAddress(); }
+		D3D12_GPU_VIRTUAL_ADDRESS GetClusterAddress() const { return clusterResource_->GetGPUVirtualAddress(); }
+		D3D12_GPU_VIRTUAL_ADDRESS GetClusterLightIndexAddress() const { return clusterLightIndexResource_->GetGPUVirtualAddress(); }
+
+	private:
+		// 寿命のある追加のライト
+		template<typename Light>
+		struct TransientLight {
+			Light light;
+			float lifeTime;
+			float time;
+		};
+
+		// 追加のライトを分類してバッファに書き込み、寿命を進める
+		void UpdateClusters(const Camera* camera);
+
+		/*------メンバ変数------*/
+
+		// シーンのライト
+		DirectionalLight directionalLight_{};
+		PointLight pointLight_{};
+		SpotLight spotLight_{};
+
+		// 登録済みの上書き（0 番は上書き無し。一度登録したものは変えないので、GPU 側へは登録時に書き込む）
+		std::vector<LightOverride> overrides_;
+		std::mutex overrideMutex_;
+		bool isOverrideOverflowLogged_ = false; // 表が埋まったことを出力したか（毎回は出さない）
+
+		// 追加のライト（ゲームオブジェクトの更新は複数のスレッドから呼ばれうるので排他する）
+		std::vector<TransientLight<PointLight>> transientPointLights_;
+		std::vector<TransientLight<SpotLight>> transientSpotLights_;
+		std::mutex transientMutex_;
+
+		// クラスタの分類と、分類に渡す球
+		LightClusterGrid clusterGrid_;
+		std::vector<BoundingSphere> pointLightSpheres_;
+		std::vector<BoundingSphere> spotLightSpheres_;
+		uint32_t clusterPointLightCount_ = 0;
+		uint32_t clusterSpotLightCount_ = 0;
+
+		// 定数バッファ（Upload ヒープ。GPU は毎フレームの終わりに待つので 1 つを使い回す）
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource_;
+		FrameLightingForGPU* data_ = nullptr;
+
+		// クラスタの StructuredBuffer（定数バッファと同じく Upload ヒープを使い回す）
+		Microsoft::WRL::ComPtr<ID3D12Resource> clusterPointLightResource_;
+		Microsoft::WRL::ComPtr<ID3D12Resource> clusterSpotLightResource_;
+		Microsoft::WRL::ComPtr<ID3D12Resource> clusterResource_;
+		Microsoft::WRL::ComPtr<ID3D12Resource> clusterLightIndexResource_;
+		PointLight* clusterPointLightData_ = nullptr;
+		SpotLight* clusterSpotLightData_ = nullptr;
+		LightClusterGrid::Cluster* clusterData_ = nullptr;
+		uint32_t* clusterLightIndexData_ = nullptr;
+	};
+}
@@ -1,14 +1,16 @@
 #include "ParticleManager.h"
 #include <Logger.h>
+#include <AllocationCounter.h>
+#include <FrameArena.h>
+#include <FastMath.h>
 #include <TextureManager.h>
 #include <MakeIdentity4x4.h>
-#include <MakeAffineMatrix.h>
-#include <Inverse.h>
+#include <Affine3x4.h>
 #include <MakeScaleMatrix.h>
 #include <MakeTranslateMatrix.h>
 #include <Material.h>
 #include <imgui.h>
-#include <MakeRotateXYZMatrix.h>
+#include <array>
 #include <iostream>
 #include <numbers>
 #include <Lerp.h>
@@ -52,6 +54,9 @@ namespace MyEngine {
 		constexpr float kRingRotationX = 1.0f;
 		constexpr float kRingRotationY = 1.0f;
 		constexpr float kRingLifeTime = 1.0f;
+
+		// 指数フェードの速さ（fade = exp(-kFadeRate * 経過時間の割合)）
+		constexpr float kFadeRate = 3.0f;
 	}
 
 	ParticleManager* ParticleManager::GetInstance()
@@ -83,14 +88,12 @@ namespace MyEngine {
 
 	void ParticleManager::Update()
 	{
-		// ビュー行列とプロジェクション行列をカメラから取得
-		Matrix4x4 cameraMatrix = MakeAffineMatrix(
-			{ 1.0f, 1.0f, 1.0f },
-			camera_->GetRotate(),
-			camera_->GetTranslate());
-		Matrix4x4 viewMatrix = Inverse(cameraMatrix);
-		Matrix4x4 projectionMatrix = camera_->GetProjectionMatrix();
-		Matrix4x4 viewProjectionMatrix = Multiply(viewMatrix, projectionMatrix);
+		// パーティクルの追加・削除によるヒープ確保を Particle として数える
+		MemoryTagScope memoryTag(MemoryTag::Particle);
+
+		// ビュー行列とプロジェクション行列をカメラから取得（カメラの Update で計算済みのものを使う）
+		const Matrix4x4& cameraMatrix = camera_->GetWorldMatrix();
+		const Matrix4x4& viewProjectionMatrix = camera_->GetViewProjectionMatrix();
 
 		// UV変換行列の計算
 		Matrix4x4 uvTransformMatrix = MakeScaleMatrix(uvTransform_.scale);
@@ -119,31 +122,49 @@ namespace MyEngine {
 	{
 		group.numParticles = 0; // 生存パーティクル数をリセット
 
-		for (auto particleIterator = group.particles.begin(); particleIterator != group.particles.end();)
+		// 指数フェードはグループ分をまとめて求める（このフレームで進めた後の経過時間で計算する。寿命切れの分は使わない）
+		FrameVector<float> fades(group.particles.size(), FrameArena::GetInstance()->GetResource());
+		for (size_t index = 0; index < group.particles.size(); ++index)
+		{
+			const Particle& particle = group.particles[index];
+			fades[index] = -kFadeRate * ((particle.currentTime + kDeltaTime) / particle.lifeTime);
+		}
+		FastExp(fades.data(), fades.data(), fades.size());
+
+		// 生存しているものを前に詰めながら更新する（順序は保つ）
+		size_t aliveCount = 0;
+		for (size_t index = 0; index < group.particles.size(); ++index)
 		{
 			// 生存時間を超えたパーティクルは削除
-			if (particleIterator->lifeTime <= particleIterator->currentTime)
+			Particle& particle = group.particles[index];
+			if (particle.lifeTime <= particle.currentTime)
 			{
-				particleIterator = group.particles.erase(particleIterator);
 				continue;
 			}
 
 			// 最大インスタンス数を超えない場合のみ更新
 			if (group.numParticles < kMaxInstanceCount)
 			{
-				UpdateParticle(*particleIterator, group, billboardMatrix, viewProjectionMatrix);
+				UpdateParticle(particle, group, billboardMatrix, viewProjectionMatrix, fades[index]);
 				++group.numParticles;
 			}
 
-			++particleIterator;
+			if (aliveCount != index)
+			{
+				group.particles[aliveCount] = particle;
+			}
+			++aliveCount;
 		}
+		// 末尾の寿命切れを除く（容量は残すため、次の Emit でヒープ確保が起きない）
+		group.particles.resize(aliveCount);
 	}
 
 	void ParticleManager::UpdateParticle(
 		Particle& particle,
 		ParticleGroup& group,
 		const Matrix4x4& billboardMatrix,
-		const Matrix4x4& viewProjectionMatrix)
+		const Matrix4x4& viewProjectionMatrix,
+		float fade)
 	{
 		// 速度を適用して位置を更新
 		particle.transform.translate += particle.velocity * kDeltaTime;
@@ -164,11 +185,7 @@ namespace MyEngine {
 		group.instanceData[group.numParticles].color = particle.color;
 		group.instanceData[group.numParticles].color.w = alpha;
 
-		float t = particle.currentTime / particle.lifeTime;
-
-		// 指数フェード（炎・スラスター向き）
-		float fade = exp(-3.0f * t);
-
+		// 指数フェード（炎・スラスター向き。fade は UpdateParticleGroup でまとめて計算済み）
 		// 色の明るさそのものを落とす
 		particle.color.x *= fade;
 		particle.color.y *= fade;
@@ -200,17 +217,26 @@ namespace MyEngine {
 		const Particle& particle,
 		const Matrix4x4& billboardMatrix) const
 	{
-		Matrix4x4 scaleMatrix = MakeScaleMatrix(particle.transform.scale);
-		Matrix4x4 translateMatrix = MakeTranslateMatrix(particle.transform.translate);
-
+		// スケール * 回転 * 平行移動 を行列の積を使わずに求める
 		if (useBillboard_)
 		{
-			return scaleMatrix * billboardMatrix * translateMatrix;
+			// ビルボード行列は平行移動を 0 にしてあるので、各行をスケールして平行移動を入れるだけでよい
+			Matrix4x4 worldMatrix = billboardMatrix;
+			const float scale[3] = { particle.transform.scale.x, particle.transform.scale.y, particle.transform.scale.z };
+			for (int row = 0; row < 3; ++row) {
+				for (int column = 0; column < 4; ++column) {
+					worldMatrix.m[row][column] *= scale[row];
+				}
+			}
+			worldMatrix.m[3][0] = particle.transform.translate.x;
+			worldMatrix.m[3][1] = particle.transform.translate.y;
+			worldMatrix.m[3][2] = particle.transform.translate.z;
+			worldMatrix.m[3][3] = 1.0f;
+			return worldMatrix;
 		}
 		else
 		{
-			Matrix4x4 rotateMatrix = MakeRotateXYZMatrix(particle.transform.rotate);
-			return scaleMatrix * rotateMatrix * translateMatrix;
+			return ToMatrix4x4(MakeAffine3x4(particle.transform.scale, particle.transform.rotate, particle.transform.translate));
 		}
 	}
 
@@ -242,37 +268,51 @@ namespace MyEngine {
 		// VBVを設定
 		commandList->IASetVertexBuffers(0, 1, &vertexBufferView_);
 
-		// すべてのパーティクルグループについて処理する
-		for (auto& group : particleGroups_)
+		// マテリアルCBVを設定
+		commandList->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
+
+		// 描画するグループを PSO・テクスチャ順に並べ、同じものが続くときは設定を省く
+		drawGroups_.clear();
+		drawRecorder_.Reset();
+		for (auto& [name, group] : particleGroups_)
 		{
-			if (group.second.numParticles == 0) {
+			if (group.numParticles == 0) {
 				continue;
 			}
-			// 👇 PSO切り替え
-			if (group.second.isAdditive)
-			{
-				commandList->SetPipelineState(graphicsPipelineStateAdditive_.Get());
-			}
-			else
-			{
-				commandList->SetPipelineState(graphicsPipelineStateAlpha_.Get());
-			}
+			const uint32_t pipeline = group.isAdditive ? kPipelineAdditive : kPipelineAlpha;
+			drawRecorder_.Record(RenderSortKey::kLayerTransparent, pipeline, group.textureSrvIndex, 0,
+				static_cast<uint32_t>(drawGroups_.size()));
+			drawGroups_.push_back(&group);
+		}
+		drawRecorder_.Sort();
+		drawRecorder_.Submit(*this);
+	}
 
-			// マテリアルCBVを設定
-			commandList->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
+	void ParticleManager::BindPipeline(uint32_t pipeline)
+	{
+		dxCommon_->GetCommandList()->SetPipelineState(
+			pipeline == kPipelineAdditive ? graphicsPipelineStateAdditive_.Get() : graphicsPipelineStateAlpha_.Get());
+	}
 
-			// インスタンシングデータのSRVのデスクリプタテーブルを設定
-			commandList->SetGraphicsRootDescriptorTable(1, srvManager_->GetGPUDescriptorHandle(group.second.srvIndex));
+	void ParticleManager::BindMaterial(uint32_t material)
+	{
+		// テクスチャのSRVのデスクリプタテーブルを設定
+		dxCommon_->GetCommandList()->SetGraphicsRootDescriptorTable(2, srvManager_->GetGPUDescriptorHandle(material));
+	}
 
-			// テクスチャのSRVのデスクリプタテーブルを設定
-			commandList->SetGraphicsRootDescriptorTable(2, srvManager_->GetGPUDescriptorHandle(group.second.textureSrvIndex));
+	void ParticleManager::Draw(uint32_t payload)
+	{
+		ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+		ParticleGroup& group = *drawGroups_[payload];
 
-			// インスタンシング描画
-			commandList->DrawInstanced(UINT(modelData_.vertices.size()), group.second.numParticles, 0, 0);
+		// インスタンシングデータのSRVのデスクリプタテーブルを設定
+		commandList->SetGraphicsRootDescriptorTable(1, srvManager_->GetGPUDescriptorHandle(group.srvIndex));
 
-			// インスタンス数をリセット
-			group.second.numParticles = 0;
-		}
+		// インスタンシング描画
+		commandList->DrawInstanced(UINT(modelData_.vertices.size()), group.numParticles, 0, 0);
+
+		// インスタンス数をリセット
+		group.numParticles = 0;
 	}
 
 	void ParticleManager::Finalize()
@@ -296,6 +336,8 @@ namespace MyEngine {
 			return;
 		}
 
+		MemoryTagScope memoryTag(MemoryTag::Particle);
+
 		// 新たな空のパーティクルグループを作成
 		ParticleGroup group{};
 		group.materialData.textureFilePath = textureFilePath;
@@ -326,7 +368,7 @@ namespace MyEngine {
 		particleGroups_.emplace(name, group);
 	}
 
-	void ParticleManager::Emit(const std::string name, const Vector3& position, uint32_t count)
+	void ParticleManager::Emit(const std::string& name, const Vector3& position, uint32_t count)
 	{
 		assert(particleGroups_.find(name) != particleGroups_.end() && "Particle Group is not found");
 
@@ -336,6 +378,8 @@ namespace MyEngine {
 			return;
 		}
 
+		MemoryTagScope memoryTag(MemoryTag::Particle);
+
 		for (uint32_t index = 0; index < count; ++index)
 		{
 			Particle particle = CreateParticleByType(position);
@@ -366,6 +410,7 @@ namespace MyEngine {
 		assert(particleGroups_.find(name) != particleGroups_.end() && "Particle Group is not found");
 
 		ParticleGroup& group = particleGroups_[name];
+		MemoryTagScope memoryTag(MemoryTag::Particle);
 
 		// 中心の大きなパーティクル
 		{
@@ -382,7 +427,14 @@ namespace MyEngine {
 			group.particles.push_back(particle);
 		}
 
-		// サブパーティクル
+		// サブパーティクル（位置の sin / cos は全て生成してからまとめて求める。乱数を引く順番は変えない）
+		std::pmr::memory_resource* frameResource = FrameArena::GetInstance()->GetResource();
+		FrameVector<float> angles(count, frameResource);
+		FrameVector<float> radii(count, frameResource);
+		FrameVector<float> sines(count, frameResource);
+		FrameVector<float> cosines(count, frameResource);
+		const size_t firstSubIndex = group.particles.size();
+
 		std::uniform_real_distribution<float> distAngle(0.0f, 2.0f * float(std::numbers::pi));
 		std::uniform_real_distribution<float> distRadius(kExplosionSubRadiusMin, kExplosionSubRadiusMax);
 		std::uniform_real_distribution<float> distScale(kExplosionSubScaleMin, kExplosionSubScaleMax);
@@ -391,17 +443,15 @@ namespace MyEngine {
 
 		for (uint32_t i = 0; i < count; ++i)
 		{
-			float angle = distAngle(randomEngine_);
-			float radius = distRadius(randomEngine_);
-			float x = std::cos(angle) * radius;
-			float y = std::sin(angle) * radius;
+			angles[i] = distAngle(randomEngine_);
+			radii[i] = distRadius(randomEngine_);
 			float z = (distAngle(randomEngine_) - static_cast<float>(std::numbers::pi)) * kExplosionSubZRange;
 
 			Particle particle;
 			particle.maxScale = distScale(randomEngine_);
 			particle.transform.scale = { 0.0f, 0.0f, 0.0f };
 			particle.transform.rotate = { 0.0f, 0.0f, 0.0f };
-			particle.transform.translate = position + Vector3{ x, y, z };
+			particle.transform.translate = position + Vector3{ 0.0f, 0.0f, z };
 			particle.color = kExplosionColorSub;
 			particle.lifeTime = distLife(randomEngine_);
 			particle.currentTime = distStartTime(randomEngine_);
@@ -410,6 +460,14 @@ namespace MyEngine {
 			particle.isSubExplosion = true;
 			group.particles.push_back(particle);
 		}
+
+		FastSinCos(angles.data(), sines.data(), cosines.data(), count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			Vector3& translate = group.particles[firstSubIndex + i].transform.translate;
+			translate.x += cosines[i] * radii[i];
+			translate.y += sines[i] * radii[i];
+		}
 	}
 
 	void ParticleManager::EmitWithVelocity(
@@ -421,6 +479,7 @@ namespace MyEngine {
 		assert(particleGroups_.find(name) != particleGroups_.end() && "Particle Group is not found");
 
 		ParticleGroup& particleGroup = particleGroups_[name];
+		MemoryTagScope memoryTag(MemoryTag::Particle);
 
 		/*if (particleGroup.particles.size() >= count) {
 			return;
@@ -605,12 +664,22 @@ namespace MyEngine {
 	{
 		const float radianPerDivide = 2.0f * std::numbers::pi_v<float> / float(kRingDivision);
 
+		// 分割点の sin / cos をまとめて求める（index + 1 の分も使うので 1 つ多く）
+		std::array<float, kRingDivision + 1> angles;
+		std::array<float, kRingDivision + 1> sines;
+		std::array<float, kRingDivision + 1> cosines;
+		for (uint32_t index = 0; index <= kRingDivision; ++index)
+		{
+			angles[index] = index * radianPerDivide;
+		}
+		FastSinCos(angles.data(), sines.data(), cosines.data(), angles.size());
+
 		for (uint32_t index = 0; index < kRingDivision; ++index)
 		{
-			float sin = std::sin(index * radianPerDivide);
-			float cos = std::cos(index * radianPerDivide);
-			float sinNext = std::sin((index + 1) * radianPerDivide);
-			float cosNext = std::cos((index + 1) * radianPerDivide);
+			float sin = sines[index];
+			float cos = cosines[index];
+			float sinNext = sines[index + 1];
+			float cosNext = cosines[index + 1];
 			float u = float(index) / float(kRingDivision);
 			float uNext = float(index + 1) / float(kRingDivision);
 
@@ -654,12 +723,22 @@ namespace MyEngine {
 	{
 		const float radianPerDivide = 2.0f * std::numbers::pi_v<float> / float(kCylinderDivision);
 
+		// 分割点の sin / cos をまとめて求める（index + 1 の分も使うので 1 つ多く）
+		std::array<float, kCylinderDivision + 1> angles;
+		std::array<float, kCylinderDivision + 1> sines;
+		std::array<float, kCylinderDivision + 1> cosines;
+		for (uint32_t index = 0; index <= kCylinderDivision; ++index)
+		{
+			angles[index] = index * radianPerDivide;
+		}
+		FastSinCos(angles.data(), sines.data(), cosines.data(), angles.size());
+
 		for (uint32_t index = 0; index < kCylinderDivision; ++index)
 		{
-			float sin = std::sin(index * radianPerDivide);
-			float cos = std::cos(index * radianPerDivide);
-			float sinNext = std::sin((index + 1) * radianPerDivide);
-			float cosNext = std::cos((index + 1) * radianPerDivide);
+			float sin = sines[index];
+			float cos = cosines[index];
+			float sinNext = sines[index + 1];
+			float cosNext = cosines[index + 1];
 			float u = float(index) / float(kCylinderDivision);
 			float uNext = float(index + 1) / float(kCylinderDivision);
 
@@ -8,7 +8,9 @@
 #include <random>
 #include "Material.h"
 #include <ParticleType.h>
+#include <RenderCommandRecorder.h>
 #include <string>
+#include <vector>
 #include <cstdint>
 
 namespace MyEngine {
@@ -23,6 +25,10 @@ namespace MyEngine {
 		// インスタンシング
 		constexpr uint32_t kMaxInstanceCount = 2000;
 
+		// 並べ替えキーのパイプライン
+		constexpr uint32_t kPipelineAlpha = 0;
+		constexpr uint32_t kPipelineAdditive = 1;
+
 		// デルタタイム
 		constexpr float kDeltaTime = 1.0f / 60.0f;
 
@@ -120,7 +126,7 @@ namespace MyEngine {
 	/// <summary>
 	/// パーティクルを管理するクラス
 	/// </summary>
-	class ParticleManager
+	class ParticleManager : public RenderCommandSink
 	{
 	public:
 		/*------構造体------*/
@@ -174,7 +180,8 @@ namespace MyEngine {
 		// パーティクルグループの構造体
 		struct ParticleGroup {
 			MaterialData materialData;
-			std::list<Particle> particles;
+			// 生存中のパーティクル（寿命切れは更新時に詰めて除くため、毎フレームのノード確保・解放が無い）
+			std::vector<Particle> particles;
 			uint32_t srvIndex;
 			uint32_t textureSrvIndex;
 			ParticleForGPU* instanceData;
@@ -190,7 +197,7 @@ namespace MyEngine {
 
 		// コンストラクタ・デストラクタ
 		ParticleManager() = default;
-		~ParticleManager() = default;
+		~ParticleManager() override = default;
 
 		// コピー・ムーブ禁止
 		ParticleManager(const ParticleManager&) = delete;
@@ -215,7 +222,7 @@ namespace MyEngine {
 
 
 		// パーティクルの発生
-		void Emit(const std::string name, const Vector3& position, uint32_t count);
+		void Emit(const std::string& name, const Vector3& position, uint32_t count);
 		void EmitExplosion(const std::string& name, const Vector3& position, uint32_t count);
 		void EmitWithVelocity(const std::string& name, const Vector3& position, uint32_t count, const Vector3& velocity);
 
@@ -255,6 +262,17 @@ namespace MyEngine {
 
 
 	private:
+		/*------RenderCommandSink------*/
+
+		// PSO の切り替え（アルファ / 加算）
+		void BindPipeline(uint32_t pipeline) override;
+
+		// テクスチャの切り替え
+		void BindMaterial(uint32_t material) override;
+
+		// グループ 1 つ分のインスタンシング描画
+		void Draw(uint32_t payload) override;
+
 		/*------プライベートメンバ関数------*/
 
 		// ルートシグネチャの作成
@@ -274,12 +292,13 @@ namespace MyEngine {
 			const Matrix4x4& billboardMatrix,
 			const Matrix4x4& viewProjectionMatrix);
 
-		// パーティクルの更新
+		// パーティクルの更新（fade は指数フェードの係数）
 		void UpdateParticle(
 			Particle& particle,
 			ParticleGroup& group,
 			const Matrix4x4& billboardMatrix,
-			const Matrix4x4& viewProjectionMatrix);
+			const Matrix4x4& viewProjectionMatrix,
+			float fade);
 
 		// ワールド行列の計算
 		Matrix4x4 CalculateWorldMatrix(
@@ -369,5 +388,9 @@ namespace MyEngine {
 
 		// パーティクルグループ
 		std::unordered_map<std::string, ParticleGroup> particleGroups_;
+
+		// 描画するグループ（payload はこの配列の番号）と、PSO・テクスチャ順に並べるための記録
+		std::vector<ParticleGroup*> drawGroups_;
+		RenderCommandRecorder drawRecorder_;
 	};
 }
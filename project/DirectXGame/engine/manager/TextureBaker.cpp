@@ -0,0 +1,139 @@
+#include "TextureBaker.h"
+#include "TextureCache.h"
+#include "TextureDecoder.h"
+#include "LogFormat.h"
+#include <DirectXTex.h>
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <unordered_set>
+
+//
+// TextureBaker
+// - PNG を起動のたびにデコード＋ミップ生成するコストを無くすためのオフラインベイカー（TextureCache から切り出したもの）。
+// - ベイク内容：TextureDecoder::LoadSourceFile で読み込み（sRGB） → GenerateMipMaps でフルミップ → BCn 圧縮 → DDS で保存。
+//   * 完全不透明な画像は BC1（4bpp）、アルファを含む画像は BC7（8bpp）に圧縮する。
+//   * 幅・高さが 4 の倍数でない画像は D3D12 で BC テクスチャとして扱えないためベイクしない。
+//   * PNG の読み込みは WIC を使うため Windows のみ。それ以外の環境では TGA だけをベイクし、
+//     PNG はハッシュの記録と既存キャッシュの確認だけ行う（Windows でベイクしたキャッシュは消さない）。
+// - 古いファイルは BakeDirectory が削除する。キャッシュのディレクトリは全ソースで共有しているので、
+//   削除するのはベイクしたディレクトリのソースにマニフェスト上で対応していたハッシュのうち、
+//   どのソースからも参照されなくなったものだけ（他のディレクトリのキャッシュは残る）。
+// - 実行方法：
+//   * 単体の実行ファイル TextureBaker [ディレクトリ]（project/tools/TextureBaker。CMake で Windows / Linux 向けにビルドする）
+//   * ゲームの実行ファイルを "--bake-textures [ディレクトリ]" 付きで起動（main.cpp）
+//
+namespace MyEngine {
+	using namespace TextureBakerConstants;
+
+	namespace {
+		// ベイク対象の拡張子か
+		bool IsSourceExtension(const std::string& extension)
+		{
+			return std::find(std::begin(kSourceExtensions), std::end(kSourceExtensions), extension) != std::end(kSourceExtensions);
+		}
+	}
+
+	bool TextureBaker::Bake(const std::string& sourcePath)
+	{
+		const uint64_t hash = TextureCache::GetSourceHash(sourcePath);
+		if (hash == 0) {
+			return false;
+		}
+
+		const std::string cachePath = TextureCache::GetCachePath(hash);
+		std::error_code error;
+		if (std::filesystem::exists(cachePath, error)) {
+			return true;
+		}
+
+		// 読み込み（TextureManager と同じく sRGB として扱う）
+		DirectX::ScratchImage image = TextureDecoder::LoadSourceFile(sourcePath);
+		if (image.GetImageCount() == 0) {
+			Logger::LogFormat("[TextureBaker] load failed : {}\n", sourcePath);
+			return false;
+		}
+
+		const DirectX::TexMetadata& metadata = image.GetMetadata();
+		if (metadata.width % kBlockSize != 0 || metadata.height % kBlockSize != 0) {
+			Logger::LogFormat("[TextureBaker] skip (size is not a multiple of {}) : {}\n", kBlockSize, sourcePath);
+			return false;
+		}
+
+		// フルミップ生成
+		DirectX::ScratchImage mipImages{};
+		HRESULT hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), metadata, DirectX::TEX_FILTER_DEFAULT, 0, mipImages);
+		if (FAILED(hr)) {
+			Logger::LogFormat("[TextureBaker] mip generation failed : {}\n", sourcePath);
+			return false;
+		}
+
+		// アルファの有無で圧縮形式を選ぶ
+		const bool isOpaque = mipImages.IsAlphaAllOpaque();
+		const DXGI_FORMAT compressedFormat = isOpaque ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM_SRGB;
+
+		DirectX::ScratchImage compressedImages{};
+		hr = DirectX::Compress(mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(),
+			compressedFormat, DirectX::TEX_COMPRESS_PARALLEL | DirectX::TEX_COMPRESS_BC7_QUICK, DirectX::TEX_THRESHOLD_DEFAULT, compressedImages);
+		if (FAILED(hr)) {
+			Logger::LogFormat("[TextureBaker] compression failed : {}\n", sourcePath);
+			return false;
+		}
+
+		std::filesystem::create_directories(TextureCacheConstants::kCacheDirectory, error);
+		hr = DirectX::SaveToDDSFile(compressedImages.GetImages(), compressedImages.GetImageCount(), compressedImages.GetMetadata(),
+			DirectX::DDS_FLAGS_NONE, TextureDecoder::ToWidePath(cachePath).c_str());
+		if (FAILED(hr)) {
+			Logger::LogFormat("[TextureBaker] save failed : {}\n", cachePath);
+			return false;
+		}
+
+		Logger::LogFormat("[TextureBaker] baked {} -> {} ({})\n", sourcePath, cachePath, isOpaque ? "BC1" : "BC7");
+		return true;
+	}
+
+	uint32_t TextureBaker::BakeDirectory(const std::string& sourceDirectory)
+	{
+		const std::string directory = TextureCache::NormalizePath(sourceDirectory);
+		uint32_t bakedCount = 0;
+		std::error_code error;
+
+		// ベイク前にこのディレクトリのソースへ対応していたハッシュ（ソースの削除・書き換えで使われなくなる候補）
+		const std::unordered_set<uint64_t> previousHashes = TextureCache::GetDirectoryHashes(directory);
+
+		std::unordered_set<std::string> currentSources;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+			if (!entry.is_regular_file() || !IsSourceExtension(entry.path().extension().generic_string())) {
+				continue;
+			}
+
+			// TextureManager に渡されるのと同じ "resources/xxx.png" 形式のパス
+			const std::string sourcePath = TextureCache::NormalizePath(entry.path().generic_string());
+			currentSources.insert(sourcePath);
+			if (Bake(sourcePath)) {
+				++bakedCount;
+			}
+		}
+
+		// 無くなったソースの記録を消す（このディレクトリの分だけ）
+		TextureCache::ForgetMissingSources(directory, currentSources);
+
+		// どのソースからも参照されなくなったハッシュのキャッシュを削除（同じ内容の別ファイルや他のディレクトリが使っていれば残す）
+		for (uint64_t hash : previousHashes) {
+			if (TextureCache::IsHashReferenced(hash)) {
+				continue;
+			}
+			const std::string cachePath = TextureCache::GetCachePath(hash);
+			if (std::filesystem::remove(cachePath, error)) {
+				Logger::LogFormat("[TextureBaker] removed stale {}\n", cachePath);
+			}
+		}
+
+		if (!TextureCache::SaveManifest()) {
+			Logger::LogFormat("[TextureBaker] manifest save failed : {}\n", TextureCacheConstants::kManifestFilePath);
+		}
+
+		Logger::LogFormat("[TextureBaker] {} textures cached in {}\n", bakedCount, TextureCacheConstants::kCacheDirectory);
+		return bakedCount;
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+namespace MyEngine {
+
+	// TextureBaker用の定数
+	namespace TextureBakerConstants {
+		// ベイク対象を探すデフォルトのディレクトリ
+		constexpr const char* kDefaultSourceDirectory = "resources";
+
+		// ベイク対象の拡張子（PNG は WIC で読むため Windows でのみベイクできる）
+		constexpr const char* kSourceExtensions[] = { ".png", ".tga" };
+
+		// ゲームの実行ファイルでベイク処理を起動するコマンドライン引数
+		constexpr const char* kBakeCommand = "--bake-textures";
+
+		// BCn 圧縮はブロック単位（4x4）のため、幅と高さがこの倍数の画像のみベイクする
+		constexpr size_t kBlockSize = 4;
+	}
+
+	/// <summary>
+	/// テクスチャのベイク
+	/// ソース画像をミップ付きの BC7 / BC1 の DDS に変換し、TextureCache のキー（ファイル内容のハッシュ）で保存する
+	/// D3D のデバイスを使わないので、単体の実行ファイル（project/tools/TextureBaker）からも使う
+	/// </summary>
+	class TextureBaker
+	{
+	public:
+		// 1ファイルをベイク（既にキャッシュがあれば何もしない。ベイク対象外なら false）
+		static bool Bake(const std::string& sourcePath);
+
+		// ディレクトリ以下のソースをすべてベイクし、このディレクトリのソースから作られて使われなくなったキャッシュを削除する
+		// （他のディレクトリのソースのキャッシュは消さない）。戻り値はキャッシュが有効なファイル数
+		static uint32_t BakeDirectory(const std::string& sourceDirectory);
+	};
+}
@@ -0,0 +1,214 @@
+#include "TextureCache.h"
+#include <filesystem>
+#include <fstream>
+#include <format>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <unordered_map>
+
+//
+// TextureCache
+// - TextureBaker がベイクした DDS（BCn 圧縮・フルミップ）を、ソースのパスから引くためのキャッシュ。
+// - キャッシュのキーはソースファイル内容のハッシュ（＋ベイク設定のバージョン）。
+//   ソースを書き換えるとキーが変わるため、古いキャッシュが誤って使われることはない。
+// - ハッシュを求めるにはソースを全部読む必要があるため、ソースのパスごとにサイズ・更新時刻・ハッシュを
+//   マニフェスト（kManifestFilePath）に記録し、サイズと更新時刻が一致すれば記録済みのハッシュを使う。
+//   一致しなければ読み直してメモリ上の記録を更新する（ファイルへの保存はベイク時のみ）。
+// - TextureDecoder::LoadFile は PNG を読む前に FindCachedFile を引き、あれば DDS を読む
+//   （圧縮済みのためミップ生成も省略される）。
+// - DirectXTex にも D3D にも依存しないので、ゲームと TextureBaker（project/tools/TextureBaker）の両方で使う。
+//
+namespace MyEngine {
+	using namespace TextureCacheConstants;
+
+	namespace {
+		// マニフェストの 1 項目
+		struct ManifestEntry {
+			uint64_t hash = 0;
+			uint64_t size = 0;
+			int64_t writeTime = 0;
+		};
+
+		// マニフェスト（キーは正規化したソースのパス）
+		std::mutex manifestMutex;
+		std::unordered_map<std::string, ManifestEntry> manifest;
+		bool isManifestLoaded = false;
+
+		// ファイルのサイズと更新時刻（取得できなければ false）
+		bool GetFileStamp(const std::string& filePath, uint64_t& size, int64_t& writeTime)
+		{
+			std::error_code error;
+			size = std::filesystem::file_size(filePath, error);
+			if (error) {
+				return false;
+			}
+			writeTime = std::filesystem::last_write_time(filePath, error).time_since_epoch().count();
+			return !error;
+		}
+
+		// マニフェストの読み込み（manifestMutex を持った状態で呼ぶ。ベイク設定のバージョンが違えば捨てる）
+		void LoadManifestLocked()
+		{
+			if (isManifestLoaded) {
+				return;
+			}
+			isManifestLoaded = true;
+
+			std::ifstream file(kManifestFilePath);
+			std::string line;
+			if (!file || !std::getline(file, line) || line != std::format("{} {}", kManifestVersionKey, kBakeVersion)) {
+				return;
+			}
+
+			// 1 行 1 項目 : ハッシュ(16進) サイズ 更新時刻 ソースのパス
+			while (std::getline(file, line)) {
+				std::istringstream stream(line);
+				ManifestEntry entry;
+				std::string sourcePath;
+				if (stream >> std::hex >> entry.hash >> std::dec >> entry.size >> entry.writeTime && std::getline(stream >> std::ws, sourcePath)) {
+					manifest[sourcePath] = entry;
+				}
+			}
+		}
+
+		// マニフェストの保存（manifestMutex を持った状態で呼ぶ）
+		bool SaveManifestLocked()
+		{
+			std::ofstream file(kManifestFilePath, std::ios::trunc);
+			if (!file) {
+				return false;
+			}
+			file << std::format("{} {}\n", kManifestVersionKey, kBakeVersion);
+			for (const auto& [sourcePath, entry] : manifest) {
+				file << std::format("{:016x} {} {} {}\n", entry.hash, entry.size, entry.writeTime, sourcePath);
+			}
+			return static_cast<bool>(file);
+		}
+
+		// sourcePath が directory 以下にあるか（どちらも正規化済み）
+		bool IsUnderDirectory(const std::string& sourcePath, const std::string& directory)
+		{
+			const std::filesystem::path relative = std::filesystem::path(sourcePath).lexically_relative(directory);
+			return !relative.empty() && *relative.begin() != "..";
+		}
+	}
+
+	uint64_t TextureCache::HashFile(const std::string& filePath)
+	{
+		std::ifstream file(filePath, std::ios::binary);
+		if (!file) {
+			return 0;
+		}
+
+		const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		// FNV-1a にベイク設定のバージョンを混ぜる
+		uint64_t hash = kFnvOffsetBasis ^ kBakeVersion;
+		for (char byte : bytes) {
+			hash ^= static_cast<uint8_t>(byte);
+			hash *= kFnvPrime;
+		}
+		return hash;
+	}
+
+	std::string TextureCache::GetCachePath(uint64_t hash)
+	{
+		return std::format("{}{:016x}{}", kCacheDirectory, hash, kCacheExtension);
+	}
+
+	uint64_t TextureCache::GetSourceHash(const std::string& sourcePath)
+	{
+		const std::string key = NormalizePath(sourcePath);
+		uint64_t size = 0;
+		int64_t writeTime = 0;
+		if (!GetFileStamp(key, size, writeTime)) {
+			return 0;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(manifestMutex);
+			LoadManifestLocked();
+			auto it = manifest.find(key);
+			if (it != manifest.end() && it->second.size == size && it->second.writeTime == writeTime) {
+				return it->second.hash;
+			}
+		}
+
+		// サイズか更新時刻が違う（または未登録）ときだけ全体を読む。読んでいる間は排他しない
+		const uint64_t hash = HashFile(key);
+		if (hash != 0) {
+			std::lock_guard<std::mutex> lock(manifestMutex);
+			manifest[key] = ManifestEntry{ hash, size, writeTime };
+		}
+		return hash;
+	}
+
+	std::string TextureCache::FindCachedFile(const std::string& sourcePath)
+	{
+		// キャッシュが無い環境ではソースのハッシュ計算も省略する
+		std::error_code error;
+		if (!std::filesystem::is_directory(kCacheDirectory, error)) {
+			return {};
+		}
+
+		const uint64_t hash = GetSourceHash(sourcePath);
+		if (hash == 0) {
+			return {};
+		}
+
+		std::string cachePath = GetCachePath(hash);
+		if (!std::filesystem::exists(cachePath, error)) {
+			return {};
+		}
+		return cachePath;
+	}
+
+	std::string TextureCache::NormalizePath(const std::string& filePath)
+	{
+		return std::filesystem::path(filePath).lexically_normal().generic_string();
+	}
+
+	std::unordered_set<uint64_t> TextureCache::GetDirectoryHashes(const std::string& directory)
+	{
+		std::unordered_set<uint64_t> hashes;
+		std::lock_guard<std::mutex> lock(manifestMutex);
+		LoadManifestLocked();
+		for (const auto& [sourcePath, entry] : manifest) {
+			if (IsUnderDirectory(sourcePath, directory)) {
+				hashes.insert(entry.hash);
+			}
+		}
+		return hashes;
+	}
+
+	void TextureCache::ForgetMissingSources(const std::string& directory, const std::unordered_set<std::string>& currentSources)
+	{
+		std::lock_guard<std::mutex> lock(manifestMutex);
+		LoadManifestLocked();
+		std::erase_if(manifest, [&](const auto& item) {
+			return IsUnderDirectory(item.first, directory) && !currentSources.contains(item.first);
+		});
+	}
+
+	bool TextureCache::IsHashReferenced(uint64_t hash)
+	{
+		std::lock_guard<std::mutex> lock(manifestMutex);
+		LoadManifestLocked();
+		for (const auto& [sourcePath, entry] : manifest) {
+			if (entry.hash == hash) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool TextureCache::SaveManifest()
+	{
+		std::lock_guard<std::mutex> lock(manifestMutex);
+		LoadManifestLocked();
+		std::error_code error;
+		std::filesystem::create_directories(kCacheDirectory, error);
+		return SaveManifestLocked();
+	}
+}
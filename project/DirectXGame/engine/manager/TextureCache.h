@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include <unordered_set>
+
+namespace MyEngine {
+
+	// TextureCache用の定数
+	namespace TextureCacheConstants {
+		// ベイク済みテクスチャの保存先
+		constexpr const char* kCacheDirectory = "resources/textureCache/";
+		constexpr const char* kCacheExtension = ".dds";
+
+		// ソースのサイズ・更新時刻とハッシュの対応を保存するファイル（キャッシュのディレクトリに置く）
+		constexpr const char* kManifestFilePath = "resources/textureCache/manifest.txt";
+		constexpr const char* kManifestVersionKey = "version";
+
+		// ベイク設定のバージョン（圧縮設定を変えたら上げて既存のキャッシュを無効化する）
+		constexpr uint64_t kBakeVersion = 1;
+
+		// FNV-1a (64bit)
+		constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+		constexpr uint64_t kFnvPrime = 1099511628211ull;
+	}
+
+	/// <summary>
+	/// ベイク済みテクスチャキャッシュ
+	/// ファイル内容のハッシュをキーに、TextureBaker が作った DDS を探す
+	/// ソースごとのハッシュはサイズ・更新時刻と一緒にマニフェストに記録し、変わっていなければ読み直さない
+	/// </summary>
+	class TextureCache
+	{
+	public:
+		// ファイル内容のハッシュ（読み込めなければ 0）
+		static uint64_t HashFile(const std::string& filePath);
+
+		// ハッシュに対応するキャッシュファイルのパス
+		static std::string GetCachePath(uint64_t hash);
+
+		// ソースのハッシュ（マニフェストのサイズ・更新時刻と一致すれば記録済みの値を返し、違えば読み直して記録し直す）
+		// 読み込みスレッドからも呼ばれるため排他している。読めなければ 0
+		static uint64_t GetSourceHash(const std::string& sourcePath);
+
+		// ベイク済みファイルを探す（無ければ空文字列）
+		static std::string FindCachedFile(const std::string& sourcePath);
+
+		// パスを "resources/xxx.png" の形にそろえる（マニフェストのキー）
+		static std::string NormalizePath(const std::string& filePath);
+
+		/*------マニフェストの更新（TextureBaker 用）------*/
+
+		// directory 以下のソースにマニフェスト上で対応しているハッシュ（directory は正規化済み）
+		static std::unordered_set<uint64_t> GetDirectoryHashes(const std::string& directory);
+
+		// directory 以下で currentSources に無いソースの記録を消す
+		static void ForgetMissingSources(const std::string& directory, const std::unordered_set<std::string>& currentSources);
+
+		// どれかのソースがこのハッシュを使っているか
+		static bool IsHashReferenced(uint64_t hash);
+
+		// マニフェストの保存
+		static bool SaveManifest();
+	};
+}
@@ -0,0 +1,179 @@
+#include "TextureDecoder.h"
+#include "TextureCache.h"
+#include "AllocationCounter.h"
+#include "JobSystem.h"
+#include "LogFormat.h"
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <filesystem>
+#ifdef _WIN32
+#include <Windows.h>
+#include "StringUtility.h"
+#endif
+
+//
+// TextureDecoder
+// - TextureManager から切り出した、テクスチャのファイル読み込みとミップ生成（CPU のみ）。
+// - 読み込み：
+//   * PNG 等は TextureCache にベイク済みの DDS（BC1/BC7・フルミップ）があればそちらを読む（LoadFile のみ）。
+//   * 拡張子が .dds / .tga / .hdr なら DirectXTex の各ローダーで、それ以外は WIC で読む（sRGB として扱う）。
+//     WIC は Windows にしか無いため、それ以外の環境（project/tests のベンチマーク、TextureBaker の Linux ビルド）では
+//     DDS / TGA / HDR だけを読める。
+// - 圧縮テクスチャ（BCn 等）はミップ生成を行わずそのまま利用する。非圧縮テクスチャは GenerateMipMaps を使う。
+// - DecodeAll は WIC デコードと GenerateMipMaps（起動時間の大半）を JobSystem のワーカーで並列化する。
+//   WIC はスレッドごとに COM の初期化が要るため、ワーカーが初めてデコードするときに 1 回だけ初期化する。
+//
+namespace MyEngine {
+	using namespace TextureDecoderConstants;
+
+	namespace {
+#ifdef _WIN32
+		// 現在のスレッドで COM を初期化する（スレッドごとに 1 回だけ。スレッド終了時に解除する）
+		void EnsureComInitialized()
+		{
+			struct ComScope {
+				ComScope() { hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED); }
+				~ComScope() {
+					if (SUCCEEDED(hr)) {
+						CoUninitialize();
+					}
+				}
+				HRESULT hr;
+			};
+			thread_local ComScope comScope;
+			assert(SUCCEEDED(comScope.hr) && "CoInitializeEx failed on decode thread!");
+		}
+#endif
+
+		// 小文字にそろえた拡張子（".png" など）
+		std::string GetLowerExtension(const std::string& filePath)
+		{
+			std::string extension = std::filesystem::path(filePath).extension().generic_string();
+			std::transform(extension.begin(), extension.end(), extension.begin(),
+				[](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return extension;
+		}
+	}
+
+	DirectX::ScratchImage TextureDecoder::LoadSourceFile(const std::string& filePath)
+	{
+		DirectX::ScratchImage image{};
+		const std::wstring filePathW = ToWidePath(filePath);
+		const std::string extension = GetLowerExtension(filePath);
+		HRESULT hr = E_FAIL;
+
+		if (extension == kDDSExtension) {
+			hr = DirectX::LoadFromDDSFile(filePathW.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+		}
+		else if (extension == kTGAExtension) {
+			hr = DirectX::LoadFromTGAFile(filePathW.c_str(), DirectX::TGA_FLAGS_FORCE_SRGB, nullptr, image);
+		}
+		else if (extension == kHDRExtension) {
+			hr = DirectX::LoadFromHDRFile(filePathW.c_str(), nullptr, image);
+		}
+		else {
+#ifdef _WIN32
+			hr = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
+#else
+			Logger::LogFormat("[TextureDecoder] {} needs WIC (Windows only) : {}\n", extension, filePath);
+#endif
+		}
+
+		if (FAILED(hr)) {
+			Logger::LogFormat("[TextureDecoder] load failed : {} (HRESULT {:#010x})\n", filePath, static_cast<uint32_t>(hr));
+			return {};
+		}
+		return image;
+	}
+
+	DirectX::ScratchImage TextureDecoder::LoadFile(const std::string& filePath)
+	{
+		// ベイク済みキャッシュがあれば DDS として読む（ファイルパスのキーは元のまま）
+		std::string loadPath = filePath;
+		if (GetLowerExtension(filePath) != kDDSExtension) {
+			const std::string cachedFilePath = TextureCache::FindCachedFile(filePath);
+			if (!cachedFilePath.empty()) {
+				loadPath = cachedFilePath;
+			}
+		}
+
+		DirectX::ScratchImage image = LoadSourceFile(loadPath);
+		assert(image.GetImageCount() > 0 && "Failed to load texture file!");
+		return image;
+	}
+
+	DirectX::ScratchImage TextureDecoder::GenerateMipMapsIfNeeded(DirectX::ScratchImage& image)
+	{
+		DirectX::ScratchImage mipImages{};
+
+		if (DirectX::IsCompressed(image.GetMetadata().format)) {
+			// 圧縮テクスチャはそのまま使用
+			mipImages = std::move(image);
+		}
+		else {
+			// 非圧縮テクスチャは自動でミップマップを生成
+			HRESULT hr = DirectX::GenerateMipMaps(
+				image.GetImages(),
+				image.GetImageCount(),
+				image.GetMetadata(),
+				DirectX::TEX_FILTER_DEFAULT,
+				kDefaultGenerateMipLevel,
+				mipImages);
+			assert(SUCCEEDED(hr) && "Failed to generate mipmaps!");
+			(void)hr;
+		}
+
+		return mipImages;
+	}
+
+	DirectX::ScratchImage TextureDecoder::Decode(const std::string& filePath)
+	{
+		MemoryTagScope memoryTag(MemoryTag::Texture);
+
+		// ファイル読み込み
+		DirectX::ScratchImage image = LoadFile(filePath);
+
+		// ミップマップ生成
+		return GenerateMipMapsIfNeeded(image);
+	}
+
+	std::vector<DirectX::ScratchImage> TextureDecoder::DecodeAll(std::span<const std::string> filePaths)
+	{
+		if (filePaths.empty()) {
+			return {};
+		}
+
+		std::vector<DirectX::ScratchImage> results(filePaths.size());
+		auto decodeRange = [&](uint32_t begin, uint32_t end) {
+#ifdef _WIN32
+			EnsureComInitialized();
+#endif
+			for (uint32_t i = begin; i < end; ++i) {
+				results[i] = Decode(filePaths[i]);
+			}
+		};
+
+		// ファイルごとにサイズの差が大きいので 1 ファイル 1 ジョブにして、空いたワーカーから順に取らせる
+		// ジョブシステムの外のスレッド（AssetLoader のワーカーなど）や未初期化のときはその場で順に行う
+		const uint32_t count = static_cast<uint32_t>(filePaths.size());
+		JobSystem* jobSystem = JobSystem::GetInstance();
+		if (jobSystem->GetThreadCount() > 0 && JobSystem::GetThreadIndex() != JobSystemConstants::kInvalidThreadIndex) {
+			jobSystem->ParallelFor(count, 1, decodeRange);
+		}
+		else {
+			decodeRange(0, count);
+		}
+
+		return results;
+	}
+
+	std::wstring TextureDecoder::ToWidePath(const std::string& filePath)
+	{
+#ifdef _WIN32
+		return StringUtility::ConvertString(filePath);
+#else
+		return std::filesystem::path(std::u8string(filePath.begin(), filePath.end())).wstring();
+#endif
+	}
+}
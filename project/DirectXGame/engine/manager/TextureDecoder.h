@@ -0,0 +1,47 @@
+#pragma once
+#include <string>
+#include <span>
+#include <vector>
+#include <DirectXTex.h>
+
+namespace MyEngine {
+
+	// TextureDecoder用の定数
+	namespace TextureDecoderConstants {
+		// デフォルトのGenerateMipMapsレベル（0 でフルミップ）
+		constexpr size_t kDefaultGenerateMipLevel = 0;
+
+		// WIC を通さずに読むファイルの拡張子
+		constexpr const char* kDDSExtension = ".dds";
+		constexpr const char* kTGAExtension = ".tga";
+		constexpr const char* kHDRExtension = ".hdr";
+	}
+
+	/// <summary>
+	/// テクスチャのデコード（ファイル読み込みとミップ生成）
+	/// D3D のデバイスに触れないため、ワーカースレッドや project/tests から呼べる
+	/// PNG などの WIC が必要な形式は Windows でのみ読める。DDS / TGA / HDR はどの環境でも読める
+	/// </summary>
+	class TextureDecoder
+	{
+	public:
+		// ソースファイルの読み込み（ベイク済みキャッシュは見ない。sRGB として扱う。失敗したら空のイメージ）
+		static DirectX::ScratchImage LoadSourceFile(const std::string& filePath);
+
+		// テクスチャファイルの読み込み（ベイク済みキャッシュがあればそちらを読む。失敗したら assert）
+		static DirectX::ScratchImage LoadFile(const std::string& filePath);
+
+		// 非圧縮のイメージならフルミップを生成する（圧縮済みはそのまま返す）
+		static DirectX::ScratchImage GenerateMipMapsIfNeeded(DirectX::ScratchImage& image);
+
+		// ファイル読み込みとミップ生成
+		static DirectX::ScratchImage Decode(const std::string& filePath);
+
+		// 複数ファイルのデコードを JobSystem で並列に行う（結果は filePaths と同じ順）
+		// ジョブシステムの外のスレッドや未初期化のときはその場で順に行う
+		static std::vector<DirectX::ScratchImage> DecodeAll(std::span<const std::string> filePaths);
+
+		// UTF-8 のパスを DirectXTex に渡すワイド文字列に変換する
+		static std::wstring ToWidePath(const std::string& filePath);
+	};
+}
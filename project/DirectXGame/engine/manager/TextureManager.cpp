@@ -1,7 +1,12 @@
 #include "TextureManager.h"
-#include "StringUtility.h"
 #include <cassert>
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
 #include "DirectXCommon.h"
+#include "LogFormat.h"
+#include "TextureDecoder.h"
+#include "AllocationCounter.h"
 
 //
 // TextureManager
@@ -9,14 +14,24 @@
 // - 機能概要：ファイルからテクスチャを読み込み（WIC / DDS）、必要に応じてミップマップを生成し、
 //   Direct3D のリソースへアップロードして SRV（Shader Resource View）を作成・管理する。
 // - 設計メモ：
-//   * textureDatas_ はファイルパスをキーにした連想配列（unordered_map）で、読み込み済みテクスチャを保持する。
+//   * textureDatas_ は配列で、読み込み時に返す TextureHandle（インデックス＋世代番号）で O(1) に引く。
+//     ファイルパスからインデックスへの対応（textureIndices_）は読み込み・初期化時のみ使い、描画経路では文字列を扱わない。
+//   * 解放したスロットは世代番号を進めて再利用するため、解放済みテクスチャの古いハンドルは assert で検出される。
 //   * SRV のヒープインデックスは内部で srvManager_ に Allocate させ、そのハンドルを保存する。
 //   * ImGui 利用の都合で 0 番を予約しており、実際のテクスチャは kSRVIndexTop (=1) から割り当てる。
-//   * 圧縮テクスチャ（BCn 等）はミップ生成を行わずそのまま利用する。非圧縮テクスチャは GenerateMipMaps を使う。
+//   * ファイル読み込みとミップ生成（CPU のみ）は TextureDecoder が行う。PNG 等はベイク済みの DDS があればそちらを読み、
+//     圧縮テクスチャ（BCn 等）はミップ生成を行わずそのまま利用する。
 //   * 実装は簡易化のためアップロード同期（SyncCPUWithGPU）を呼び出している。大規模ロードやストリーミング化する場合は
 //     非同期アップロード＋複数バッファ戦略に変更することを推奨する。
+//   * LoadTextures は WIC デコードと GenerateMipMaps（起動時間の大半）を TextureDecoder::DecodeAll で並列化し、
+//     GPU リソース作成・コピー命令の積み込みは直列に行ったうえで SyncCPUWithGPU を 1 回だけ呼ぶ。
+//   * LoadTexture / LoadTextureFromImage は参照を 1 つ増やし、呼び出し側は不要になったら ReleaseTexture で手放す。
+//     参照 0 のテクスチャはすぐには解放せず、新しいテクスチャを作るときにメモリ予算か SRV スロットが足りなければ
+//     TextureResidency が選んだ古い順（LRU）に解放して SRV スロットを再利用する。
+//     解放は読み込み（Update 中）にのみ起こり、DirectXCommon::PostDraw で毎フレーム GPU を待っているため
+//     前フレームまでの描画で使われたテクスチャを解放しても安全。
+//   * 参照を取らずに SRV ハンドルだけを保持する古い呼び出し側は、LoadTexture の参照を手放さないため常駐のままになる。
 //   * 呼び出し側は Initialize(SrvManager*) を呼んでから使用すること。
-//   * Finalize() は将来的なリソース解放処理を入れるフック（現状内容なし）。
 //
 namespace MyEngine {
 	using namespace TextureManagerConstants;
@@ -40,67 +55,184 @@ namespace MyEngine {
 		dxCommon_ = DirectXCommon::GetInstance();
 		srvManager_ = srvManager;
 
-		// 内部コンテナの予約
+		// 内部コンテナの予約（確保済みの要素への参照が再確保で無効にならないように最大数ぶん確保）
 		textureDatas_.reserve(srvManager_->GetMaxSRVCount());
+		textureIndices_.reserve(srvManager_->GetMaxSRVCount());
+
+		// メモリ予算の初期値
+		residency_.SetBudget(kDefaultMemoryBudgetBytes);
 	}
 
 	void TextureManager::Finalize()
 	{
 		// リソースの解放
 		textureDatas_.clear();
+		textureIndices_.clear();
+		freeTextureIndices_.clear();
+		residency_ = TextureResidency{};
 	}
 
-	void TextureManager::LoadTexture(const std::string& filePath)
+	TextureHandle TextureManager::LoadTexture(const std::string& filePath)
 	{
-		// 既に読み込まれている場合は早期リターン
+		// 既に読み込まれている場合は既存のハンドルに参照を足して返す
 		if (IsTextureExists(filePath)) {
+			TextureHandle handle = GetTextureHandle(filePath);
+			AddRef(handle);
+			return handle;
+		}
+
+		// 管理データなどのヒープ確保を Texture として数える
+		MemoryTagScope memoryTag(MemoryTag::Texture);
+
+		// ファイル読み込み＋ミップマップ生成
+		DirectX::ScratchImage mipImages = DecodeTexture(filePath);
+
+		// GPU リソースの作成とアップロード
+		return LoadTextureFromImage(filePath, mipImages);
+	}
+
+	void TextureManager::LoadTextures(std::span<const std::string> filePaths)
+	{
+		MemoryTagScope memoryTag(MemoryTag::Texture);
+
+		// 未読み込みのものだけを重複なしで集める
+		std::vector<std::string> pendingPaths;
+		std::unordered_set<std::string> seen;
+		for (const std::string& filePath : filePaths) {
+			if (!IsTextureExists(filePath) && seen.insert(filePath).second) {
+				pendingPaths.push_back(filePath);
+			}
+		}
+		if (pendingPaths.empty()) {
 			return;
 		}
 
-		// テクスチャ枚数上限チェック
-		assert(CanLoadMoreTextures() && "Cannot load more textures, SRV heap is full!");
+		// デコード＋ミップ生成（並列）
+		const auto decodeStart = std::chrono::steady_clock::now();
+		std::vector<DirectX::ScratchImage> mipImages = DecodeTextures(pendingPaths);
+		const auto uploadStart = std::chrono::steady_clock::now();
+
+		// GPU リソース作成とコピー命令の積み込み（直列）。中間リソースは同期まで保持する
+		// 同期前に同じバッチのテクスチャが追い出されないよう、同期までは仮の参照を持っておく
+		std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> intermediateResources;
+		std::vector<TextureHandle> handles;
+		intermediateResources.reserve(pendingPaths.size());
+		handles.reserve(pendingPaths.size());
+		for (size_t i = 0; i < pendingPaths.size(); ++i) {
+			TextureHandle handle = CreateTextureData(pendingPaths[i], mipImages[i]);
+			AddRef(handle);
+			handles.push_back(handle);
+			intermediateResources.push_back(dxCommon_->UploadTextureData(GetTextureData(handle).resource.Get(), mipImages[i]));
+		}
 
-		// ファイル読み込み
-		DirectX::ScratchImage image = LoadTextureFile(filePath);
+		// まとめて 1 回だけ GPU と同期
+		dxCommon_->SyncCPUWithGPU();
 
-		// ミップマップ生成
-		DirectX::ScratchImage mipImages = GenerateMipMapsIfNeeded(image);
+		for (TextureHandle handle : handles) {
+			ReleaseTexture(handle);
+		}
 
-		// TextureData を作成
-		TextureData& textureData = textureDatas_[filePath];
+		const auto endTime = std::chrono::steady_clock::now();
+		Logger::LogFormat("[TextureManager] LoadTextures : {} files, decode {:.2f} ms, upload {:.2f} ms\n",
+			pendingPaths.size(),
+			std::chrono::duration<double, std::milli>(uploadStart - decodeStart).count(),
+			std::chrono::duration<double, std::milli>(endTime - uploadStart).count());
+	}
 
-		// リソース作成
-		CreateTextureResource(textureData, mipImages);
+	std::vector<DirectX::ScratchImage> TextureManager::DecodeTextures(std::span<const std::string> filePaths)
+	{
+		return TextureDecoder::DecodeAll(filePaths);
+	}
 
-		// SRV作成
-		CreateShaderResourceView(textureData, mipImages.GetMetadata());
+	TextureHandle TextureManager::LoadTextureFromImage(const std::string& filePath, DirectX::ScratchImage& mipImages)
+	{
+		// 非同期読み込みと同期読み込みが重なった場合は先に登録された方を使う
+		if (IsTextureExists(filePath)) {
+			TextureHandle handle = GetTextureHandle(filePath);
+			AddRef(handle);
+			return handle;
+		}
+
+		MemoryTagScope memoryTag(MemoryTag::Texture);
+
+		// リソース・SRV作成
+		TextureHandle handle = CreateTextureData(filePath, mipImages);
+		AddRef(handle);
 
 		// GPU へアップロード
-		UploadTextureToGPU(textureData, mipImages);
+		UploadTextureToGPU(GetTextureData(handle), mipImages);
+		return handle;
 	}
 
-	const DirectX::TexMetadata& TextureManager::GetMetaData(const std::string& filePath)
+	DirectX::ScratchImage TextureManager::DecodeTexture(const std::string& filePath)
 	{
-		assert(IsTextureExists(filePath) && "Texture not found!");
-		return textureDatas_[filePath].metadata;
+		return TextureDecoder::Decode(filePath);
 	}
 
-	uint32_t TextureManager::GetTextureIndexByFilePath(const std::string& filePath)
+	void TextureManager::UnloadTexture(const std::string& filePath)
 	{
-		assert(IsTextureExists(filePath) && "Texture not found!");
+		auto it = textureIndices_.find(filePath);
+		if (it == textureIndices_.end()) {
+			return;
+		}
+
+		ReleaseTextureData(it->second);
+	}
+
+	void TextureManager::AddRef(TextureHandle handle)
+	{
+		assert(IsValid(handle) && "Invalid or released texture handle!");
+		residency_.AddRef(handle.index);
+	}
+
+	void TextureManager::ReleaseTexture(TextureHandle handle)
+	{
+		// 強制解放済み・終了処理後のハンドルは無視する
+		if (!IsValid(handle)) {
+			return;
+		}
+		residency_.Release(handle.index);
+	}
+
+	void TextureManager::SetMemoryBudget(uint64_t budgetBytes)
+	{
+		residency_.SetBudget(budgetBytes);
+		EvictTextures(0);
+	}
 
-		auto it = textureDatas_.find(filePath);
-		
-		return textureDatas_[filePath].srvIndex;
+	TextureHandle TextureManager::GetTextureHandle(const std::string& filePath) const
+	{
+		auto it = textureIndices_.find(filePath);
+		if (it == textureIndices_.end()) {
+			return {};
+		}
+		return TextureHandle{ it->second, textureDatas_[it->second].generation };
+	}
+
+	bool TextureManager::IsValid(TextureHandle handle) const
+	{
+		return handle.IsValid()
+			&& handle.index < textureDatas_.size()
+			&& textureDatas_[handle.index].isUsed
+			&& textureDatas_[handle.index].generation == handle.generation;
 	}
 
-	D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetSrvHandleGPU(const std::string& filePath)
+	const DirectX::TexMetadata& TextureManager::GetMetaData(const std::string& filePath) const
 	{
 		assert(IsTextureExists(filePath) && "Texture not found!");
+		return GetMetaData(GetTextureHandle(filePath));
+	}
 
-		TextureData& textureData = textureDatas_[filePath];
-		textureData.srvHandleGPU = srvManager_->GetGPUDescriptorHandle(textureData.srvIndex);
-		return textureData.srvHandleGPU;
+	uint32_t TextureManager::GetTextureIndexByFilePath(const std::string& filePath) const
+	{
+		assert(IsTextureExists(filePath) && "Texture not found!");
+		return GetSrvIndex(GetTextureHandle(filePath));
+	}
+
+	D3D12_GPU_DESCRIPTOR_HANDLE TextureManager::GetSrvHandleGPU(const std::string& filePath) const
+	{
+		assert(IsTextureExists(filePath) && "Texture not found!");
+		return GetSrvHandleGPU(GetTextureHandle(filePath));
 	}
 
 	bool TextureManager::IsTextureLoaded(const std::string& filePath) const
@@ -110,49 +242,79 @@ namespace MyEngine {
 
 	// ===== ヘルパー関数 =====
 
-	DirectX::ScratchImage TextureManager::LoadTextureFile(const std::string& filePath)
+	TextureHandle TextureManager::CreateTextureData(const std::string& filePath, const DirectX::ScratchImage& mipImages)
 	{
-		DirectX::ScratchImage image{};
-		std::wstring filePathW = StringUtility::ConvertString(filePath);
-		HRESULT hr;
+		// 予算と SRV スロットを空けるため、参照されていないテクスチャを古い順に解放する
+		const uint64_t sizeInBytes = mipImages.GetPixelsSize();
+		EvictTextures(sizeInBytes);
 
-		if (IsDDSFile(filePathW)) {
-			hr = DirectX::LoadFromDDSFile(filePathW.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+		// テクスチャ枚数上限チェック（参照中のテクスチャだけで SRV が埋まっている）
+		assert(CanLoadMoreTextures() && "Cannot load more textures, SRV heap is full!");
+
+		// 空きスロットを再利用し、無ければ末尾に追加
+		uint32_t index = 0;
+		if (!freeTextureIndices_.empty()) {
+			index = freeTextureIndices_.back();
+			freeTextureIndices_.pop_back();
 		}
 		else {
-			hr = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
+			index = static_cast<uint32_t>(textureDatas_.size());
+			textureDatas_.emplace_back();
 		}
 
-		if (!SUCCEEDED(hr)) {
-			OutputDebugStringA(("Texture load failed: " + filePath + "\n").c_str());
-			OutputDebugStringA(("HRESULT: " + std::to_string(hr) + "\n").c_str());
-			assert(false && "Failed to load texture file!");
-		}
+		TextureData& textureData = textureDatas_[index];
+		textureData.isUsed = true;
+		textureData.filePath = filePath;
+		textureData.sizeInBytes = sizeInBytes;
+		textureIndices_.emplace(filePath, index);
+
+		// 参照 0 の追い出し候補として登録（呼び出し側が参照を足す）
+		residency_.Add(index, sizeInBytes);
+
+		// リソース作成
+		CreateTextureResource(textureData, mipImages);
+
+		// SRV作成
+		CreateShaderResourceView(textureData, mipImages.GetMetadata());
 
-		return image;
+		return TextureHandle{ index, textureData.generation };
 	}
 
-	DirectX::ScratchImage TextureManager::GenerateMipMapsIfNeeded(DirectX::ScratchImage& image)
+	const TextureManager::TextureData& TextureManager::GetTextureData(TextureHandle handle) const
 	{
-		DirectX::ScratchImage mipImages{};
+		assert(IsValid(handle) && "Invalid or released texture handle!");
+		return textureDatas_[handle.index];
+	}
 
-		if (DirectX::IsCompressed(image.GetMetadata().format)) {
-			// 圧縮テクスチャはそのまま使用
-			mipImages = std::move(image);
+	void TextureManager::EvictTextures(uint64_t incomingBytes)
+	{
+		const uint32_t requiredSlots = srvManager_->HasFreeSlot() ? 0 : 1;
+		for (uint32_t index : residency_.CollectEvictions(incomingBytes, requiredSlots)) {
+			Logger::LogFormat("[TextureManager] evict {} ({} KB)\n", textureDatas_[index].filePath, textureDatas_[index].sizeInBytes / 1024);
+			ReleaseTextureData(index);
 		}
-		else {
-			// 非圧縮テクスチャは自動でミップマップを生成
-			HRESULT hr = DirectX::GenerateMipMaps(
-				image.GetImages(),
-				image.GetImageCount(),
-				image.GetMetadata(),
-				DirectX::TEX_FILTER_DEFAULT,
-				kDefaultGenerateMipLevel,
-				mipImages);
-			assert(SUCCEEDED(hr) && "Failed to generate mipmaps!");
+
+		// 参照中のテクスチャだけで予算を超えている場合は警告のみ（描画中のテクスチャは解放できない）
+		if (residency_.GetUsedBytes() + incomingBytes > residency_.GetBudget()) {
+			Logger::LogFormat("[TextureManager] over budget : {} KB used, {} KB budget\n",
+				(residency_.GetUsedBytes() + incomingBytes) / 1024, residency_.GetBudget() / 1024);
 		}
+	}
 
-		return mipImages;
+	void TextureManager::ReleaseTextureData(uint32_t index)
+	{
+		// SRVスロットを返却してリソースを解放
+		TextureData& textureData = textureDatas_[index];
+		srvManager_->Free(textureData.srvIndex);
+		textureData.resource.Reset();
+		residency_.Remove(index);
+		textureIndices_.erase(textureData.filePath);
+		textureData.filePath.clear();
+
+		// 世代番号を進めて古いハンドルを無効化し、スロットを再利用に回す
+		++textureData.generation;
+		textureData.isUsed = false;
+		freeTextureIndices_.push_back(index);
 	}
 
 	void TextureManager::CreateTextureResource(TextureData& textureData, const DirectX::ScratchImage& mipImages)
@@ -213,18 +375,13 @@ namespace MyEngine {
 		return srvDesc;
 	}
 
-	bool TextureManager::IsDDSFile(const std::wstring& filePath) const
-	{
-		return filePath.ends_with(kDDSExtension);
-	}
-
 	bool TextureManager::IsTextureExists(const std::string& filePath) const
 	{
-		return textureDatas_.contains(filePath);
+		return textureIndices_.contains(filePath);
 	}
 
 	bool TextureManager::CanLoadMoreTextures() const
 	{
-		return textureDatas_.size() + kSRVIndexTop < srvManager_->GetMaxSRVCount();
+		return srvManager_->HasFreeSlot();
 	}
 }
\ No newline at end of file
@@ -4,8 +4,11 @@
 #include <wrl.h>
 #include <d3d12.h>
 #include <SrvManager.h>
+#include "TextureResidency.h"
 #include <unordered_map>
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace MyEngine {
 	// 前方宣言
@@ -25,13 +28,29 @@ namespace MyEngine {
 		// デフォルトのResourceMinLODClamp
 		constexpr float kDefaultResourceMinLODClamp = 0.0f;
 
-		// デフォルトのGenerateMipMapsレベル
-		constexpr size_t kDefaultGenerateMipLevel = 0;
+		// 無効なテクスチャハンドルのインデックス
+		constexpr uint32_t kInvalidTextureIndex = UINT32_MAX;
 
-		// DDSファイル拡張子
-		constexpr const wchar_t* kDDSExtension = L".dds";
+		// テクスチャメモリ予算のデフォルト値（超えると参照されていないテクスチャを古い順に解放する）
+		constexpr uint64_t kDefaultMemoryBudgetBytes = 256ull * 1024ull * 1024ull;
 	}
 
+	/// <summary>
+	/// テクスチャハンドル
+	/// 読み込み時に返されるテクスチャ配列のインデックスと世代番号の組
+	/// （解放されたスロットが再利用されても、世代番号で古いハンドルを検出できる）
+	/// </summary>
+	struct TextureHandle
+	{
+		uint32_t index = TextureManagerConstants::kInvalidTextureIndex;
+		uint32_t generation = 0;
+
+		// 有効なハンドルか（解放済みかどうかは TextureManager::IsValid で判定する）
+		bool IsValid() const { return index != TextureManagerConstants::kInvalidTextureIndex; }
+
+		bool operator==(const TextureHandle&) const = default;
+	};
+
 	/// <summary>
 	/// テクスチャマネージャー
 	/// </summary>
@@ -53,21 +72,74 @@ namespace MyEngine {
 		// 終了
 		void Finalize();
 
-		// テクスチャファイルの読み込み
-		void LoadTexture(const std::string& filePath);
+		// テクスチャファイルの読み込み（読み込み済みなら既存のハンドルを返す）
+		// 返したハンドルの参照を 1 つ呼び出し側が持つ。不要になったら ReleaseTexture で手放すこと
+		TextureHandle LoadTexture(const std::string& filePath);
+
+		// テクスチャファイルの一括読み込み
+		// デコードとミップ生成を複数スレッドで並列に行い、GPUリソース作成とアップロードだけをメインスレッドでまとめて行う
+		// 参照は増やさない（保持する場合は LoadTexture か AddRef で参照を取ること）
+		void LoadTextures(std::span<const std::string> filePaths);
+
+		// 複数ファイルのデコードとミップ生成を JobSystem で並列に行う（CPUのみ。結果は filePaths と同じ順。TextureDecoder::DecodeAll）
+		static std::vector<DirectX::ScratchImage> DecodeTextures(std::span<const std::string> filePaths);
+
+		// デコード済みイメージからテクスチャを登録（GPUリソース作成・アップロードのみ、メインスレッド専用）
+		// LoadTexture と同様に参照を 1 つ呼び出し側が持つ
+		TextureHandle LoadTextureFromImage(const std::string& filePath, DirectX::ScratchImage& mipImages);
+
+		// ファイル読み込みとミップ生成（CPUのみ。D3Dに触れないためワーカースレッドから呼び出し可。TextureDecoder::Decode）
+		static DirectX::ScratchImage DecodeTexture(const std::string& filePath);
+
+		// テクスチャの強制解放（参照カウントに関係なく解放する。GPUが参照していないタイミングで呼ぶこと）
+		void UnloadTexture(const std::string& filePath);
+
+		/*------参照カウントとメモリ予算------*/
+
+		// 参照を増やす
+		void AddRef(TextureHandle handle);
+
+		// 参照を手放す（0 になったテクスチャはすぐには解放されず、予算や SRV が足りなくなったときに古い順に解放される）
+		// 解放済みのハンドルは無視する
+		void ReleaseTexture(TextureHandle handle);
+
+		// メモリ予算の設定（超えている場合はその場で参照されていないテクスチャを解放する）
+		void SetMemoryBudget(uint64_t budgetBytes);
+
+		/*------ハンドル経由の取得（O(1)。毎フレームの描画・更新ではこちらを使う）------*/
+
+		// ファイルパスからハンドルを取得（未読み込みなら無効なハンドル。初期化時に一度だけ呼ぶ想定）
+		TextureHandle GetTextureHandle(const std::string& filePath) const;
+
+		// ハンドルが現在も有効か（解放済みなら false）
+		bool IsValid(TextureHandle handle) const;
+
+		// SRVインデックスの取得
+		uint32_t GetSrvIndex(TextureHandle handle) const { return GetTextureData(handle).srvIndex; }
+
+		// GPUハンドルの取得
+		D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(TextureHandle handle) const { return GetTextureData(handle).srvHandleGPU; }
+
+		// メタデータの取得
+		const DirectX::TexMetadata& GetMetaData(TextureHandle handle) const { return GetTextureData(handle).metadata; }
+
+		/*------ファイルパス経由の取得（初期化時用）------*/
 
 		// テクスチャインデックスの取得
-		uint32_t GetTextureIndexByFilePath(const std::string& filePath);
+		uint32_t GetTextureIndexByFilePath(const std::string& filePath) const;
 
 		// テクスチャ番号からGPUハンドルを取得
-		D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(const std::string& filePath);
+		D3D12_GPU_DESCRIPTOR_HANDLE GetSrvHandleGPU(const std::string& filePath) const;
 
 		// メタデータを取得
-		const DirectX::TexMetadata& GetMetaData(const std::string& filePath);
+		const DirectX::TexMetadata& GetMetaData(const std::string& filePath) const;
 
 		// ゲッター
 		bool IsTextureLoaded(const std::string& filePath) const;
-		size_t GetLoadedTextureCount() const { return textureDatas_.size(); }
+		size_t GetLoadedTextureCount() const { return textureIndices_.size(); }
+		uint32_t GetRefCount(TextureHandle handle) const { return IsValid(handle) ? residency_.GetRefCount(handle.index) : 0; }
+		uint64_t GetMemoryBudget() const { return residency_.GetBudget(); }
+		uint64_t GetUsedMemory() const { return residency_.GetUsedBytes(); }
 		uint32_t GetSRVIndexTop() const { return TextureManagerConstants::kSRVIndexTop; }
 
 	private:
@@ -81,29 +153,53 @@ namespace MyEngine {
 			uint32_t srvIndex;
 			D3D12_CPU_DESCRIPTOR_HANDLE srvHandleCPU;
 			D3D12_GPU_DESCRIPTOR_HANDLE srvHandleGPU;
+			// ファイルパス（解放時に textureIndices_ から取り除くため）
+			std::string filePath;
+			// テクスチャデータのサイズ（バイト、全ミップ分）
+			uint64_t sizeInBytes = 0;
+			// スロットの世代番号（解放のたびに進む）
+			uint32_t generation = 0;
+			// スロットが使用中か
+			bool isUsed = false;
 		};
 
 		// テクスチャ読み込みヘルパー
-		DirectX::ScratchImage LoadTextureFile(const std::string& filePath);
-		DirectX::ScratchImage GenerateMipMapsIfNeeded(DirectX::ScratchImage& image);
 		void CreateTextureResource(TextureData& textureData, const DirectX::ScratchImage& mipImages);
 		void CreateShaderResourceView(TextureData& textureData, const DirectX::TexMetadata& metadata);
 		void UploadTextureToGPU(const TextureData& textureData, const DirectX::ScratchImage& mipImages);
 
+		// GPUリソース作成とSRV作成のみ（アップロードは呼び出し側で行う）
+		TextureHandle CreateTextureData(const std::string& filePath, const DirectX::ScratchImage& mipImages);
+
+		// ハンドルからテクスチャデータを取得（無効なハンドルは assert）
+		const TextureData& GetTextureData(TextureHandle handle) const;
+
+		// 予算と SRV スロットに収まるよう、参照されていないテクスチャを古い順に解放する
+		void EvictTextures(uint64_t incomingBytes);
+
+		// スロットの解放（SRV・リソースを返却し、世代番号を進める）
+		void ReleaseTextureData(uint32_t index);
+
 		// SRV記述子の設定
 		D3D12_SHADER_RESOURCE_VIEW_DESC CreateSRVDesc(const DirectX::TexMetadata& metadata) const;
 
-		// ファイルタイプの判定
-		bool IsDDSFile(const std::wstring& filePath) const;
-
 		// テクスチャ存在チェック
 		bool IsTextureExists(const std::string& filePath) const;
 
 		// テクスチャ枚数上限チェック
 		bool CanLoadMoreTextures() const;
 
-		// テクスチャデータ
-		std::unordered_map<std::string, TextureData> textureDatas_;
+		// テクスチャデータ（ハンドルのインデックスで直接引く）
+		std::vector<TextureData> textureDatas_;
+
+		// ファイルパスからテクスチャデータのインデックスへの対応（読み込み・初期化時のみ使う）
+		std::unordered_map<std::string, uint32_t> textureIndices_;
+
+		// 解放済みで再利用できるインデックス
+		std::vector<uint32_t> freeTextureIndices_;
+
+		// 参照カウント・メモリ予算・LRU の管理（キーはテクスチャデータのインデックス）
+		TextureResidency residency_;
 
 		// DirectXCommon
 		DirectXCommon* dxCommon_ = nullptr;
@@ -0,0 +1,83 @@
+#include "TextureResidency.h"
+#include <cassert>
+
+//
+// TextureResidency
+// - TextureManager が持つテクスチャの常駐ポリシー。
+// - 参照カウントが 0 のテクスチャだけを LRU リストに並べ、0 になった順（＝最後に使われた順）で古いものから追い出す。
+//   参照中のテクスチャはリストに入らないため、描画中のオブジェクトが持つテクスチャが追い出されることはない。
+// - 追い出しの判定（CollectEvictions）は状態を変えない純粋な計算で、D3D に依存しないため単体で検証できる。
+//
+namespace MyEngine {
+
+	void TextureResidency::Add(uint32_t id, uint64_t sizeBytes)
+	{
+		assert(!entries_.contains(id) && "Texture is already registered!");
+
+		Entry& entry = entries_[id];
+		entry.sizeBytes = sizeBytes;
+		entry.lruIt = lru_.insert(lru_.end(), id);
+		usedBytes_ += sizeBytes;
+	}
+
+	void TextureResidency::Remove(uint32_t id)
+	{
+		auto it = entries_.find(id);
+		if (it == entries_.end()) {
+			return;
+		}
+
+		if (it->second.refCount == 0) {
+			lru_.erase(it->second.lruIt);
+		}
+		usedBytes_ -= it->second.sizeBytes;
+		entries_.erase(it);
+	}
+
+	void TextureResidency::AddRef(uint32_t id)
+	{
+		auto it = entries_.find(id);
+		assert(it != entries_.end() && "Texture is not registered!");
+
+		// 参照されたら追い出し候補から外す
+		if (it->second.refCount++ == 0) {
+			lru_.erase(it->second.lruIt);
+		}
+	}
+
+	void TextureResidency::Release(uint32_t id)
+	{
+		auto it = entries_.find(id);
+		assert(it != entries_.end() && "Texture is not registered!");
+		assert(it->second.refCount > 0 && "Texture reference count underflow!");
+
+		// 参照が無くなったら最も新しい追い出し候補にする
+		if (--it->second.refCount == 0) {
+			it->second.lruIt = lru_.insert(lru_.end(), id);
+		}
+	}
+
+	FrameVector<uint32_t> TextureResidency::CollectEvictions(uint64_t incomingBytes, uint32_t requiredSlots) const
+	{
+		// 呼び出し側でその場で使い切る一時配列なので、フレームアリーナから確保する
+		FrameVector<uint32_t> evictions(FrameArena::GetInstance()->GetResource());
+		uint64_t usedBytes = usedBytes_;
+
+		for (uint32_t id : lru_) {
+			const bool isOverBudget = usedBytes + incomingBytes > budgetBytes_;
+			if (!isOverBudget && evictions.size() >= requiredSlots) {
+				break;
+			}
+			evictions.push_back(id);
+			usedBytes -= entries_.at(id).sizeBytes;
+		}
+
+		return evictions;
+	}
+
+	uint32_t TextureResidency::GetRefCount(uint32_t id) const
+	{
+		auto it = entries_.find(id);
+		return it != entries_.end() ? it->second.refCount : 0;
+	}
+}
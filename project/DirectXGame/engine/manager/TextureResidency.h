@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "FrameArena.h"
+
+namespace MyEngine {
+
+	/// <summary>
+	/// テクスチャの常駐管理（参照カウント・メモリ予算・LRU）
+	/// デバイスに触れない純粋な CPU 側のポリシーで、どのテクスチャを追い出すかだけを決める
+	/// （実際の解放は TextureManager が行う）
+	/// </summary>
+	class TextureResidency
+	{
+	public:
+		// メモリ予算の設定（バイト）
+		void SetBudget(uint64_t budgetBytes) { budgetBytes_ = budgetBytes; }
+
+		// テクスチャの登録（参照 0 で、最も最近使われたものとして LRU に入る）
+		void Add(uint32_t id, uint64_t sizeBytes);
+
+		// テクスチャの登録解除
+		void Remove(uint32_t id);
+
+		// 参照カウントの増減（0 になったものが追い出し候補になる）
+		void AddRef(uint32_t id);
+		void Release(uint32_t id);
+
+		// 予算内に収め、SRV スロットを requiredSlots 個空けるために追い出すテクスチャを古い順に返す
+		// 参照中のテクスチャは対象外のため、足りない場合は返せる分だけ返す（状態は変更しない）
+		FrameVector<uint32_t> CollectEvictions(uint64_t incomingBytes, uint32_t requiredSlots) const;
+
+		// ゲッター
+		bool Contains(uint32_t id) const { return entries_.contains(id); }
+		uint32_t GetRefCount(uint32_t id) const;
+		uint64_t GetBudget() const { return budgetBytes_; }
+		uint64_t GetUsedBytes() const { return usedBytes_; }
+		size_t GetEvictableCount() const { return lru_.size(); }
+
+	private:
+		// テクスチャ1枚分の常駐情報
+		struct Entry {
+			uint64_t sizeBytes = 0;
+			uint32_t refCount = 0;
+			// 参照 0 の間だけ有効な LRU 上の位置
+			std::list<uint32_t>::iterator lruIt;
+		};
+
+		// 登録中のテクスチャ
+		std::unordered_map<uint32_t, Entry> entries_;
+
+		// 参照 0 のテクスチャ（先頭が最も古い）
+		std::list<uint32_t> lru_;
+
+		// メモリ予算と使用量
+		uint64_t budgetBytes_ = UINT64_MAX;
+		uint64_t usedBytes_ = 0;
+	};
+}
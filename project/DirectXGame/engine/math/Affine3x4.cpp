@@ -0,0 +1,172 @@
+#include "Affine3x4.h"
+#include "MathSimd.h"
+#include <cmath>
+
+//
+// Affine3x4
+// - WorldTransform のワールド行列用。最終列 (0, 0, 0, 1) を持たないので、合成・逆行列で 0 や 1 との演算を行わない。
+//   * 合成：3x3 の積（27 回の乗算）と平行移動の変換（9 回）。4x4 の積は 64 回。
+//   * 逆行列：3x3 の逆行列（行ベクトルの外積）と -t * (3x3 の逆行列)。一般の 4x4 の逆行列より大幅に少ない。
+//   * 法線行列：3x3 の逆行列の転置 = 外積の各行 / 行列式 なので、転置の並べ替えも不要。
+// - MakeAffine3x4 は回転行列を 3 回掛ける代わりに、X → Y → Z の合成結果を sin / cos から直接求める。
+// - 4x4 への変換は GPU に送るとき（WVP・World・法線行列）だけ行う。
+//
+namespace Math {
+	namespace {
+		// 3x3 部分の行 a, b の外積
+		inline void Cross(const float a[3], const float b[3], float out[3])
+		{
+			out[0] = a[1] * b[2] - a[2] * b[1];
+			out[1] = a[2] * b[0] - a[0] * b[2];
+			out[2] = a[0] * b[1] - a[1] * b[0];
+		}
+
+		// 3x3 部分の余因子（行ごとの外積）と行列式の逆数を求める
+		// cofactor[i] は 3x3 の逆行列の i 列目 * 行列式
+		inline float Cofactor(const Affine3x4& a, float cofactor[3][3])
+		{
+			Cross(a.m[1], a.m[2], cofactor[0]);
+			Cross(a.m[2], a.m[0], cofactor[1]);
+			Cross(a.m[0], a.m[1], cofactor[2]);
+			return 1.0f / (a.m[0][0] * cofactor[0][0] + a.m[0][1] * cofactor[0][1] + a.m[0][2] * cofactor[0][2]);
+		}
+	}
+
+	Affine3x4 MakeAffine3x4(const Vector3& scale, const Vector3& rotate, const Vector3& translate)
+	{
+		const float sinX = std::sin(rotate.x);
+		const float cosX = std::cos(rotate.x);
+		const float sinY = std::sin(rotate.y);
+		const float cosY = std::cos(rotate.y);
+		const float sinZ = std::sin(rotate.z);
+		const float cosZ = std::cos(rotate.z);
+
+		// RotateX * RotateY * RotateZ を展開したもの
+		Affine3x4 result;
+		result.m[0][0] = scale.x * (cosY * cosZ);
+		result.m[0][1] = scale.x * (cosY * sinZ);
+		result.m[0][2] = scale.x * (-sinY);
+		result.m[1][0] = scale.y * (sinX * sinY * cosZ - cosX * sinZ);
+		result.m[1][1] = scale.y * (sinX * sinY * sinZ + cosX * cosZ);
+		result.m[1][2] = scale.y * (sinX * cosY);
+		result.m[2][0] = scale.z * (cosX * sinY * cosZ + sinX * sinZ);
+		result.m[2][1] = scale.z * (cosX * sinY * sinZ - sinX * cosZ);
+		result.m[2][2] = scale.z * (cosX * cosY);
+		result.m[3][0] = translate.x;
+		result.m[3][1] = translate.y;
+		result.m[3][2] = translate.z;
+		return result;
+	}
+
+	Affine3x4 MakeIdentityAffine3x4()
+	{
+		Affine3x4 result = {};
+		result.m[0][0] = 1.0f;
+		result.m[1][1] = 1.0f;
+		result.m[2][2] = 1.0f;
+		return result;
+	}
+
+	Affine3x4 Multiply(const Affine3x4& a, const Affine3x4& b)
+	{
+		Affine3x4 result;
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 3; j++) {
+				result.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j];
+			}
+		}
+		// 平行移動の行は b の平行移動を足す（省いた w = 1 の分）
+		result.m[3][0] += b.m[3][0];
+		result.m[3][1] += b.m[3][1];
+		result.m[3][2] += b.m[3][2];
+		return result;
+	}
+
+	Matrix4x4 Multiply(const Affine3x4& a, const Matrix4x4& m)
+	{
+		Matrix4x4 result;
+#ifdef MATH_USE_SSE
+		const __m128 row0 = Simd::LoadRow(m, 0);
+		const __m128 row1 = Simd::LoadRow(m, 1);
+		const __m128 row2 = Simd::LoadRow(m, 2);
+		for (int i = 0; i < 4; i++) {
+			// 平行移動の行は m の平行移動から始める（省いた w = 1 の分）
+			__m128 row = (i == 3) ? Simd::LoadRow(m, 3) : _mm_setzero_ps();
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][0]), row0));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][1]), row1));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][2]), row2));
+			Simd::StoreRow(result, i, row);
+		}
+#else
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				result.m[i][j] = a.m[i][0] * m.m[0][j] + a.m[i][1] * m.m[1][j] + a.m[i][2] * m.m[2][j];
+			}
+		}
+		for (int j = 0; j < 4; j++) {
+			result.m[3][j] += m.m[3][j];
+		}
+#endif
+		return result;
+	}
+
+	Affine3x4 Inverse(const Affine3x4& a)
+	{
+		float cofactor[3][3];
+		const float inverseDet = Cofactor(a, cofactor);
+
+		// 3x3 の逆行列（余因子を転置して行列式で割る）
+		Affine3x4 result;
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				result.m[i][j] = cofactor[j][i] * inverseDet;
+			}
+		}
+
+		// 平行移動 = -t * (3x3 の逆行列)
+		for (int j = 0; j < 3; j++) {
+			result.m[3][j] = -(a.m[3][0] * result.m[0][j] + a.m[3][1] * result.m[1][j] + a.m[3][2] * result.m[2][j]);
+		}
+		return result;
+	}
+
+	Matrix4x4 MakeNormalMatrix(const Affine3x4& a)
+	{
+		float cofactor[3][3];
+		const float inverseDet = Cofactor(a, cofactor);
+
+		// 逆行列の転置なので、余因子をそのまま行として並べる
+		Matrix4x4 result = {};
+		for (int i = 0; i < 3; i++) {
+			for (int j = 0; j < 3; j++) {
+				result.m[i][j] = cofactor[i][j] * inverseDet;
+			}
+		}
+		result.m[3][3] = 1.0f;
+		return result;
+	}
+
+	Matrix4x4 ToMatrix4x4(const Affine3x4& a)
+	{
+		Matrix4x4 result;
+		for (int i = 0; i < 4; i++) {
+			result.m[i][0] = a.m[i][0];
+			result.m[i][1] = a.m[i][1];
+			result.m[i][2] = a.m[i][2];
+			result.m[i][3] = 0.0f;
+		}
+		result.m[3][3] = 1.0f;
+		return result;
+	}
+
+	Affine3x4 ToAffine3x4(const Matrix4x4& m)
+	{
+		Affine3x4 result;
+		for (int i = 0; i < 4; i++) {
+			result.m[i][0] = m.m[i][0];
+			result.m[i][1] = m.m[i][1];
+			result.m[i][2] = m.m[i][2];
+		}
+		return result;
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector3.h"
+
+// アフィン変換行列（3x4）
+// 行ベクトル規約（v * M）の 4x4 アフィン行列から、常に (0, 0, 0, 1) になる最終列を省いたもの
+// m[0]〜m[2] が回転・拡縮（せん断を含んでもよい）、m[3] が平行移動
+struct Affine3x4 {
+	float m[4][3];
+};
+
+// アフィン変換行列の関数（WorldTransform 用。GPU に送るときだけ 4x4 に変換する）
+namespace Math
+{
+	// スケール・回転（X → Y → Z）・平行移動から作成（MakeAffineMatrix と同じ行列）
+	Affine3x4 MakeAffine3x4(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+
+	// 単位行列
+	Affine3x4 MakeIdentityAffine3x4();
+
+	// 合成（a を適用してから b を適用する。Multiply(Matrix4x4, Matrix4x4) と同じ順序）
+	Affine3x4 Multiply(const Affine3x4& a, const Affine3x4& b);
+
+	// アフィン行列と 4x4 行列の積（ワールド行列 * ビュープロジェクション行列）
+	Matrix4x4 Multiply(const Affine3x4& a, const Matrix4x4& m);
+
+	// 逆行列
+	Affine3x4 Inverse(const Affine3x4& a);
+
+	// 法線用の行列（左上 3x3 の逆行列の転置。平行移動は含まない）
+	Matrix4x4 MakeNormalMatrix(const Affine3x4& a);
+
+	// 4x4 行列との変換（ToAffine3x4 は最終列を捨てるので、アフィン行列にのみ使う）
+	Matrix4x4 ToMatrix4x4(const Affine3x4& a);
+	Affine3x4 ToAffine3x4(const Matrix4x4& m);
+}
@@ -0,0 +1,85 @@
+#include "BoundingSphere.h"
+#include <algorithm>
+#include <cmath>
+
+//
+// BoundingSphere
+// - 視錐台カリング用の境界球。モデルの読み込み時にローカル座標で 1 回求め、描画前にワールド行列で変換して使う。
+// - ワールド行列の変換は中心を行列で移し、半径に 3x3 部分の行の長さの最大値（最大のスケール）を掛ける。
+//   回転だけなら半径は変わらず、非一様スケールでも元の球を必ず含む（見えるものを消すことは無い）。
+//
+namespace Math {
+	BoundingSphere ComputeBoundingSphere(const std::vector<VertexData>& vertices)
+	{
+		if (vertices.empty()) {
+			return { { 0.0f, 0.0f, 0.0f }, 0.0f };
+		}
+
+		// AABB の中心を球の中心にする
+		Vector3 minimum = { vertices[0].position.x, vertices[0].position.y, vertices[0].position.z };
+		Vector3 maximum = minimum;
+		for (const VertexData& vertex : vertices) {
+			minimum.x = (std::min)(minimum.x, vertex.position.x);
+			minimum.y = (std::min)(minimum.y, vertex.position.y);
+			minimum.z = (std::min)(minimum.z, vertex.position.z);
+			maximum.x = (std::max)(maximum.x, vertex.position.x);
+			maximum.y = (std::max)(maximum.y, vertex.position.y);
+			maximum.z = (std::max)(maximum.z, vertex.position.z);
+		}
+		const Vector3 center = {
+			(minimum.x + maximum.x) * 0.5f,
+			(minimum.y + maximum.y) * 0.5f,
+			(minimum.z + maximum.z) * 0.5f
+		};
+
+		// 最も遠い頂点までの距離（平方根は最後に 1 回だけ）
+		float maxDistanceSq = 0.0f;
+		for (const VertexData& vertex : vertices) {
+			const float dx = vertex.position.x - center.x;
+			const float dy = vertex.position.y - center.y;
+			const float dz = vertex.position.z - center.z;
+			maxDistanceSq = (std::max)(maxDistanceSq, dx * dx + dy * dy + dz * dz);
+		}
+		return { center, std::sqrt(maxDistanceSq) };
+	}
+
+	BoundingSphere MergeBoundingSphere(const BoundingSphere& a, const BoundingSphere& b)
+	{
+		const Vector3 offset = { b.center.x - a.center.x, b.center.y - a.center.y, b.center.z - a.center.z };
+		const float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+
+		// 片方がもう片方を含むなら大きい方をそのまま使う
+		if (distance + b.radius <= a.radius) {
+			return a;
+		}
+		if (distance + a.radius <= b.radius) {
+			return b;
+		}
+
+		// 2 つの球の両端を直径とする球
+		const float radius = (distance + a.radius + b.radius) * 0.5f;
+		const float t = (radius - a.radius) / distance;
+		return {
+			{ a.center.x + offset.x * t, a.center.y + offset.y * t, a.center.z + offset.z * t },
+			radius
+		};
+	}
+
+	BoundingSphere TransformBoundingSphere(const BoundingSphere& sphere, const Affine3x4& world)
+	{
+		const Vector3& c = sphere.center;
+		const Vector3 center = {
+			c.x * world.m[0][0] + c.y * world.m[1][0] + c.z * world.m[2][0] + world.m[3][0],
+			c.x * world.m[0][1] + c.y * world.m[1][1] + c.z * world.m[2][1] + world.m[3][1],
+			c.x * world.m[0][2] + c.y * world.m[1][2] + c.z * world.m[2][2] + world.m[3][2]
+		};
+
+		// 行ベクトル規約なので、行 i の長さが軸 i のスケール
+		float maxScaleSq = 0.0f;
+		for (int i = 0; i < 3; i++) {
+			const float lengthSq = world.m[i][0] * world.m[i][0] + world.m[i][1] * world.m[i][1] + world.m[i][2] * world.m[i][2];
+			maxScaleSq = (std::max)(maxScaleSq, lengthSq);
+		}
+		return { center, sphere.radius * std::sqrt(maxScaleSq) };
+	}
+}
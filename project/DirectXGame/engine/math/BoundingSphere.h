@@ -0,0 +1,24 @@
+#pragma once
+#include "Affine3x4.h"
+#include "Vector3.h"
+#include "VertexData.h"
+#include <vector>
+
+// 境界球（16 バイト。カリングでは 4 つずつ SIMD レジスタに読んで転置する）
+struct BoundingSphere {
+	Vector3 center;
+	float radius;
+};
+
+// 境界球の関数
+namespace Math
+{
+	// 頂点を全て含む球（AABB の中心から最も遠い頂点までを半径にする。最小の球ではないが、読み込み時に 1 回求めるだけなので十分）
+	BoundingSphere ComputeBoundingSphere(const std::vector<VertexData>& vertices);
+
+	// 2 つの球を含む球
+	BoundingSphere MergeBoundingSphere(const BoundingSphere& a, const BoundingSphere& b);
+
+	// ワールド行列で変換した球（スケールが軸ごとに違うときは最大のスケールで半径を広げる）
+	BoundingSphere TransformBoundingSphere(const BoundingSphere& sphere, const Affine3x4& world);
+}
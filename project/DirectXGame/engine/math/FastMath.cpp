@@ -0,0 +1,271 @@
+#include "FastMath.h"
+#include "MathSimd.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+//
+// FastMath
+// - パーティクルのフェード（exp）、爆発・弾幕の発射方向（sin / cos）、弾の正規化（sqrt）は 1 フレームに何百回も呼ばれるが、
+//   libm の精度（1ulp 以下）や errno・巨大な引数への対応は要らない。ここでは Cephes の単精度版と同じ多項式で近似する。
+// - sin / cos：
+//   * 引数を π/4 の偶数倍 j で引いて [-π/4, π/4] に縮め、sin と cos の多項式を両方計算する。
+//     j の 2 のビットで sin と cos を入れ替え、4 のビットと引数の符号で符号を決める（SIMD では分岐の代わりにマスクで選ぶ）。
+//   * π/4 を 3 つに分けて引く（Cody-Waite）ので、|angle| <= 8192 なら縮めたときの誤差はほとんど出ない。それより大きい要素は libm に任せる。
+// - exp：x = n・ln2 + r（|r| <= ln2 / 2）に分け、e^r を 5 次の多項式、2^n を指数部のビットに直接書き込んで求める。
+// - 平方根の逆数：SSE の rsqrt（12bit 精度）をニュートン法で 1 回補正する。SSE が無いときは 1 / std::sqrt。
+// - MATH_EXACT_TRANSCENDENTAL を定義すると全て libm になる。近似による見た目の違いを確認するときに使う。
+//
+namespace Math {
+	namespace {
+		// sin / cos を多項式で求める引数の範囲
+		constexpr float kMaxSinCosAngle = 8192.0f;
+
+		// 4 / π と、π/4 を 3 つに分けたもの（上位ほど仮数部の下位ビットが 0 なので、j を掛けても丸め誤差が出ない）
+		constexpr float kFourOverPi = 1.27323954473516f;
+		constexpr float kPiOver4Part1 = 0.78515625f;
+		constexpr float kPiOver4Part2 = 2.4187564849853515625e-4f;
+		constexpr float kPiOver4Part3 = 3.77489497744594108e-8f;
+
+		// [-π/4, π/4] での sin / cos の多項式の係数
+		constexpr float kSin0 = -1.9515295891e-4f;
+		constexpr float kSin1 = 8.3321608736e-3f;
+		constexpr float kSin2 = -1.6666654611e-1f;
+		constexpr float kCos0 = 2.443315711809948e-5f;
+		constexpr float kCos1 = -1.388731625493765e-3f;
+		constexpr float kCos2 = 4.166664568298827e-2f;
+
+		// exp の入力の範囲（結果が FLT_MIN 以上、有限になる範囲）
+		constexpr float kExpMin = -87.3365f;
+		constexpr float kExpMax = 88.0f;
+
+		// log2(e) と、ln2 を 2 つに分けたもの
+		constexpr float kLog2e = 1.44269504088896341f;
+		constexpr float kLn2Part1 = 0.693359375f;
+		constexpr float kLn2Part2 = -2.12194440e-4f;
+
+		// [-ln2/2, ln2/2] での (e^r - 1 - r) / r^2 の多項式の係数
+		constexpr float kExp0 = 1.9875691500e-4f;
+		constexpr float kExp1 = 1.3981999507e-3f;
+		constexpr float kExp2 = 8.3334519073e-3f;
+		constexpr float kExp3 = 4.1665795894e-2f;
+		constexpr float kExp4 = 1.6666665459e-1f;
+		constexpr float kExp5 = 5.0000001201e-1f;
+
+		// 単精度の指数部のバイアスと位置
+		constexpr int32_t kExponentBias = 127;
+		constexpr int32_t kMantissaBits = 23;
+
+		// ===== ヘルパー関数 =====
+
+		inline void SinCosScalar(float angle, float& sine, float& cosine)
+		{
+			const float x = std::fabs(angle);
+			if (!(x <= kMaxSinCosAngle)) {
+				sine = std::sin(angle);
+				cosine = std::cos(angle);
+				return;
+			}
+
+			// x に最も近い π/4 の偶数倍 j を引く
+			const int32_t j = (static_cast<int32_t>(x * kFourOverPi) + 1) & ~1;
+			const float y = static_cast<float>(j);
+			const float r = ((x - y * kPiOver4Part1) - y * kPiOver4Part2) - y * kPiOver4Part3;
+			const float z = r * r;
+
+			const float cosPoly = ((kCos0 * z + kCos1) * z + kCos2) * z * z - 0.5f * z + 1.0f;
+			const float sinPoly = ((kSin0 * z + kSin1) * z + kSin2) * z * r + r;
+
+			// j が 2, 6 のときは sin と cos が入れ替わる
+			const bool isSwapped = (j & 2) != 0;
+			sine = isSwapped ? cosPoly : sinPoly;
+			cosine = isSwapped ? sinPoly : cosPoly;
+			if (((j & 4) != 0) != (angle < 0.0f)) {
+				sine = -sine;
+			}
+			if (((j - 2) & 4) == 0) {
+				cosine = -cosine;
+			}
+		}
+
+		inline float ExpScalar(float value)
+		{
+			// NaN はそのまま返す（整数への変換に NaN を渡さない）
+			if (std::isnan(value)) {
+				return value;
+			}
+
+			float x = std::clamp(value, kExpMin, kExpMax);
+			const float n = std::floor(x * kLog2e + 0.5f);
+			x = x - n * kLn2Part1 - n * kLn2Part2;
+			const float z = x * x;
+
+			float poly = kExp0;
+			poly = poly * x + kExp1;
+			poly = poly * x + kExp2;
+			poly = poly * x + kExp3;
+			poly = poly * x + kExp4;
+			poly = poly * x + kExp5;
+			poly = poly * z + x + 1.0f;
+
+			// 2^n は指数部に直接書き込む
+			const float pow2n = std::bit_cast<float>((static_cast<int32_t>(n) + kExponentBias) << kMantissaBits);
+			return poly * pow2n;
+		}
+
+#ifdef MATH_USE_SSE
+		inline __m128 Select(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+		{
+			return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+		}
+
+		// SinCosScalar の 4 要素版（範囲外の要素が無いこと）
+		inline void SinCos4(__m128 angle, __m128& sine, __m128& cosine)
+		{
+			const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(INT32_MIN));
+			const __m128 x = _mm_andnot_ps(signMask, angle);
+
+			__m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(kFourOverPi)));
+			j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+			const __m128 y = _mm_cvtepi32_ps(j);
+			__m128 r = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(kPiOver4Part1)));
+			r = _mm_sub_ps(r, _mm_mul_ps(y, _mm_set1_ps(kPiOver4Part2)));
+			r = _mm_sub_ps(r, _mm_mul_ps(y, _mm_set1_ps(kPiOver4Part3)));
+			const __m128 z = _mm_mul_ps(r, r);
+
+			__m128 cosPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kCos0), z), _mm_set1_ps(kCos1));
+			cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(kCos2));
+			cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+			cosPoly = _mm_sub_ps(cosPoly, _mm_mul_ps(_mm_set1_ps(0.5f), z));
+			cosPoly = _mm_add_ps(cosPoly, _mm_set1_ps(1.0f));
+
+			__m128 sinPoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(kSin0), z), _mm_set1_ps(kSin1));
+			sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(kSin2));
+			sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), r), r);
+
+			const __m128i two = _mm_set1_epi32(2);
+			const __m128i four = _mm_set1_epi32(4);
+			const __m128 swapMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, two), two));
+			const __m128 sineSign = _mm_xor_ps(_mm_and_ps(angle, signMask),
+				_mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, four), 29)));
+			const __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, two), four), 29));
+
+			sine = _mm_xor_ps(Select(swapMask, cosPoly, sinPoly), sineSign);
+			cosine = _mm_xor_ps(Select(swapMask, sinPoly, cosPoly), cosineSign);
+		}
+
+		// ExpScalar の 4 要素版
+		inline __m128 Exp4(__m128 value)
+		{
+			__m128 x = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(kExpMin)), _mm_set1_ps(kExpMax));
+
+			// floor は切り捨ての結果が大きければ 1 を引いて求める
+			const __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(kLog2e)), _mm_set1_ps(0.5f));
+			__m128 n = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+			n = _mm_sub_ps(n, _mm_and_ps(_mm_cmpgt_ps(n, fx), _mm_set1_ps(1.0f)));
+
+			x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(kLn2Part1)));
+			x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(kLn2Part2)));
+			const __m128 z = _mm_mul_ps(x, x);
+
+			__m128 poly = _mm_set1_ps(kExp0);
+			poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(kExp1));
+			poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(kExp2));
+			poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(kExp3));
+			poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(kExp4));
+			poly = _mm_add_ps(_mm_mul_ps(poly, x), _mm_set1_ps(kExp5));
+			poly = _mm_add_ps(_mm_add_ps(_mm_mul_ps(poly, z), x), _mm_set1_ps(1.0f));
+
+			const __m128i exponent = _mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(kExponentBias));
+			const __m128 result = _mm_mul_ps(poly, _mm_castsi128_ps(_mm_slli_epi32(exponent, kMantissaBits)));
+
+			// クランプで NaN が kExpMin に置き換わるので、NaN の要素は入力をそのまま返す
+			return Select(_mm_cmpord_ps(value, value), result, value);
+		}
+
+		// rsqrt の概算をニュートン法で 1 回補正する：r' = r * (1.5 - 0.5 * x * r * r)
+		inline __m128 ReciprocalSqrt4(__m128 value)
+		{
+			const __m128 estimate = _mm_rsqrt_ps(value);
+			const __m128 halfValue = _mm_mul_ps(value, _mm_set1_ps(0.5f));
+			const __m128 correction = _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfValue, _mm_mul_ps(estimate, estimate)));
+			return _mm_mul_ps(estimate, correction);
+		}
+#endif
+	}
+
+	void FastSinCos(const float* angles, float* sines, float* cosines, size_t count)
+	{
+		size_t index = 0;
+#if defined(MATH_USE_SSE) && !defined(MATH_EXACT_TRANSCENDENTAL)
+		const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(INT32_MIN));
+		const __m128 maxAngle = _mm_set1_ps(kMaxSinCosAngle);
+		for (; index + 4 <= count; index += 4) {
+			const __m128 angle = _mm_loadu_ps(angles + index);
+
+			// 範囲外（NaN を含む）の要素があれば、その 4 要素だけスカラーで計算する
+			if (_mm_movemask_ps(_mm_cmple_ps(_mm_andnot_ps(signMask, angle), maxAngle)) != 0xF) {
+				for (size_t lane = index; lane < index + 4; ++lane) {
+					SinCosScalar(angles[lane], sines[lane], cosines[lane]);
+				}
+				continue;
+			}
+
+			__m128 sine;
+			__m128 cosine;
+			SinCos4(angle, sine, cosine);
+			_mm_storeu_ps(sines + index, sine);
+			_mm_storeu_ps(cosines + index, cosine);
+		}
+#endif
+		for (; index < count; ++index) {
+#ifdef MATH_EXACT_TRANSCENDENTAL
+			sines[index] = std::sin(angles[index]);
+			cosines[index] = std::cos(angles[index]);
+#else
+			SinCosScalar(angles[index], sines[index], cosines[index]);
+#endif
+		}
+	}
+
+	void FastExp(const float* values, float* results, size_t count)
+	{
+		size_t index = 0;
+#if defined(MATH_USE_SSE) && !defined(MATH_EXACT_TRANSCENDENTAL)
+		for (; index + 4 <= count; index += 4) {
+			_mm_storeu_ps(results + index, Exp4(_mm_loadu_ps(values + index)));
+		}
+#endif
+		for (; index < count; ++index) {
+#ifdef MATH_EXACT_TRANSCENDENTAL
+			// 範囲外の入力の扱い（クランプ）は近似と揃える
+			results[index] = std::exp(std::clamp(values[index], kExpMin, kExpMax));
+#else
+			results[index] = ExpScalar(values[index]);
+#endif
+		}
+	}
+
+	void FastReciprocalSqrt(const float* values, float* results, size_t count)
+	{
+		size_t index = 0;
+#if defined(MATH_USE_SSE) && !defined(MATH_EXACT_TRANSCENDENTAL)
+		for (; index + 4 <= count; index += 4) {
+			_mm_storeu_ps(results + index, ReciprocalSqrt4(_mm_loadu_ps(values + index)));
+		}
+#endif
+		for (; index < count; ++index) {
+			results[index] = FastReciprocalSqrt(values[index]);
+		}
+	}
+
+	float FastReciprocalSqrt(float value)
+	{
+#if defined(MATH_USE_SSE) && !defined(MATH_EXACT_TRANSCENDENTAL)
+		return _mm_cvtss_f32(ReciprocalSqrt4(_mm_set_ss(value)));
+#else
+		return 1.0f / std::sqrt(value);
+#endif
+	}
+}
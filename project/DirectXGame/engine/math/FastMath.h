@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+
+// 近似の超越関数（パーティクル・弾の更新など、精度より量が効く箇所用）
+// - 配列をまとめて計算する。SIMD が使えるときは 4 要素ずつ、端数は同じ式のスカラー実装で計算する。
+//   多項式のスカラー実装は 1 要素ずつでは libm より速くならないので、sin / cos / exp は配列版だけを用意する。
+// - 誤差の上限（libm との比較）：
+//   * FastSinCos        : 絶対誤差 1e-7（|angle| <= 8192。それより大きい要素は libm で計算する）
+//   * FastExp           : 相対誤差 1e-7（入力は [-87.3, 88.0] にクランプする。結果は FLT_MIN 以上 / 有限）
+//                         -inf や -87.3 未満は 0 ではなく FLT_MIN 付近、+inf は e^88 になる。NaN は NaN のまま返す
+//   * FastReciprocalSqrt: 相対誤差 3e-7（入力は正の正規化数であること。0 や負の数は NaN になる）
+// - results は values と同じ配列でもよい
+// - MATH_EXACT_TRANSCENDENTAL を定義すると全て std::sin / std::exp / std::sqrt に切り替わる（結果の比較・検証用。exp のクランプは同じ）
+namespace Math
+{
+	// sin と cos を同時に求める
+	void FastSinCos(const float* angles, float* sines, float* cosines, size_t count);
+
+	// e の累乗
+	void FastExp(const float* values, float* results, size_t count);
+
+	// 平方根の逆数（ベクトルの正規化用。1 / std::sqrt(x) の代わり）
+	void FastReciprocalSqrt(const float* values, float* results, size_t count);
+	float FastReciprocalSqrt(float value);
+}
@@ -0,0 +1,101 @@
+#include "Frustum.h"
+#include "MathSimd.h"
+#include <bit>
+#include <cmath>
+
+//
+// Frustum
+// - 描画前に境界球と視錐台を比べ、画面に映らないオブジェクトのコマンド記録を省く。
+// - 平面の取り出し（Gribb / Hartmann）：
+//   * 行ベクトル規約ではクリップ座標の各成分は v と行列の列の内積になる。-w <= x <= w などの条件を列の和・差で書くと、
+//     そのままワールド空間の平面になる。z は D3D の [0, 1] なので近平面は 3 列目だけ（0 <= z）。
+//   * (a, b, c) を正規化しておき、平面との符号付き距離が -半径 以上なら「その平面の内側に掛かっている」とする。
+//     6 枚全ての内側に掛かっていれば見える（角付近では実際には見えない球も残るが、見えるものを消すことは無い）。
+// - まとめての判定：BoundingSphere は 16 バイトなので 4 つ読んで転置し、x / y / z / 半径をそれぞれ 4 要素のレジスタにする。
+//   平面 1 枚につき乗算 3 回・加算 3 回・比較 1 回で 4 つの球を判定でき、結果はビットマスクから番号の列にする。
+// - 視錐台はカメラ（Camera::Update）がビュープロジェクション行列の変わったときだけ作り直す。
+//
+namespace Math {
+	namespace {
+		// 平面 (a, b, c, d) を (a, b, c) の長さで割る
+		inline Vector4 NormalizePlane(const Vector4& plane)
+		{
+			const float inverseLength = 1.0f / std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			return { plane.x * inverseLength, plane.y * inverseLength, plane.z * inverseLength, plane.w * inverseLength };
+		}
+
+		// 行列の列 column に sign を掛けて w の列（3 列目）に足したもの
+		inline Vector4 CombineColumns(const Matrix4x4& m, int column, float sign)
+		{
+			return {
+				m.m[0][3] + sign * m.m[0][column],
+				m.m[1][3] + sign * m.m[1][column],
+				m.m[2][3] + sign * m.m[2][column],
+				m.m[3][3] + sign * m.m[3][column]
+			};
+		}
+	}
+
+	Frustum MakeFrustum(const Matrix4x4& viewProjection)
+	{
+		const Matrix4x4& m = viewProjection;
+		Frustum frustum;
+		frustum.planes[0] = NormalizePlane(CombineColumns(m, 0, 1.0f));  // 左：-w <= x
+		frustum.planes[1] = NormalizePlane(CombineColumns(m, 0, -1.0f)); // 右：x <= w
+		frustum.planes[2] = NormalizePlane(CombineColumns(m, 1, 1.0f));  // 下：-w <= y
+		frustum.planes[3] = NormalizePlane(CombineColumns(m, 1, -1.0f)); // 上：y <= w
+		frustum.planes[4] = NormalizePlane({ m.m[0][2], m.m[1][2], m.m[2][2], m.m[3][2] }); // 近：0 <= z
+		frustum.planes[5] = NormalizePlane(CombineColumns(m, 2, -1.0f)); // 遠：z <= w
+		return frustum;
+	}
+
+	bool IsVisible(const Frustum& frustum, const BoundingSphere& sphere)
+	{
+		for (const Vector4& plane : frustum.planes) {
+			const float distance = plane.x * sphere.center.x + plane.y * sphere.center.y + plane.z * sphere.center.z + plane.w;
+			if (distance < -sphere.radius) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	size_t CullSpheres(const Frustum& frustum, const BoundingSphere* spheres, size_t count, uint32_t* visibleIndices)
+	{
+		size_t visibleCount = 0;
+		size_t index = 0;
+#ifdef MATH_USE_SSE
+		for (; index + 4 <= count; index += 4) {
+			// 4 つの球を転置して x / y / z / 半径 ごとのレジスタにする
+			__m128 x = _mm_loadu_ps(&spheres[index + 0].center.x);
+			__m128 y = _mm_loadu_ps(&spheres[index + 1].center.x);
+			__m128 z = _mm_loadu_ps(&spheres[index + 2].center.x);
+			__m128 radius = _mm_loadu_ps(&spheres[index + 3].center.x);
+			_MM_TRANSPOSE4_PS(x, y, z, radius);
+			const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (const Vector4& plane : frustum.planes) {
+				__m128 distance = _mm_mul_ps(_mm_set1_ps(plane.x), x);
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.y), y));
+				distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), z));
+				distance = _mm_add_ps(distance, _mm_set1_ps(plane.w));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+			}
+
+			// 見える球のビットを番号にする
+			uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(inside));
+			while (mask != 0) {
+				visibleIndices[visibleCount++] = static_cast<uint32_t>(index) + std::countr_zero(mask);
+				mask &= mask - 1;
+			}
+		}
+#endif
+		for (; index < count; ++index) {
+			if (IsVisible(frustum, spheres[index])) {
+				visibleIndices[visibleCount++] = static_cast<uint32_t>(index);
+			}
+		}
+		return visibleCount;
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "BoundingSphere.h"
+#include "Matrix4x4.h"
+#include "Vector4.h"
+#include <cstddef>
+#include <cstdint>
+
+// 視錐台の平面の数（左・右・下・上・近・遠）
+inline constexpr size_t kFrustumPlaneCount = 6;
+
+// 視錐台（平面 (a, b, c, d) は a*x + b*y + c*z + d >= 0 が内側。(a, b, c) は正規化済みなので値はそのまま距離になる）
+struct Frustum {
+	Vector4 planes[kFrustumPlaneCount];
+};
+
+// 視錐台カリングの関数
+namespace Math
+{
+	// ビュープロジェクション行列から視錐台を作る（行ベクトル規約、クリップ空間の z は [0, 1]）
+	Frustum MakeFrustum(const Matrix4x4& viewProjection);
+
+	// 球が視錐台と重なるか（点の判定は半径 0 の球で行う）
+	bool IsVisible(const Frustum& frustum, const BoundingSphere& sphere);
+
+	// 球をまとめて判定し、見える球の番号を順に visibleIndices に書き込む（戻り値は見える数）
+	// visibleIndices は count 要素以上あること。SIMD が使えるときは 4 つずつ判定する
+	size_t CullSpheres(const Frustum& frustum, const BoundingSphere* spheres, size_t count, uint32_t* visibleIndices);
+}
@@ -1,65 +1,245 @@
 #include "Inverse.h"
+#include "MathSimd.h"
 
+//
+// Inverse / InverseAffine
+// - Inverse：一般の 4x4 行列の逆行列。
+//   * SIMD 版は 2x2 のブロックに分けて求める方法（各ブロックの行列式と余因子行列を使う）。
+//     行列式の逆数は 1 回だけ求めて掛ける（スカラー版は 16 要素それぞれで行列式による除算を行う）。
+//   * SIMD が使えない（MATH_FORCE_SCALAR を含む）場合は従来の余因子展開による実装（Math::Scalar::Inverse）になる。
+// - InverseAffine：最終列が (0, 0, 0, 1) のアフィン行列（ワールド行列・カメラ行列）専用の高速版。
+//   * 左上 3x3 の逆行列を行ベクトルの外積（余因子）から求め、平行移動は -t * (3x3 の逆行列) で求める。
+//   * 回転・拡縮だけでなく、親子付けで生じるせん断を含んでいても正しい（直交性は仮定しない）。
+//   * 射影行列など、最終列が (0, 0, 0, 1) でない行列には使えない（結果が不定になる）。
+//
 namespace Math {
-    Matrix4x4 Inverse(const Matrix4x4& m)
-    {
-		Matrix4x4 resultInverse = {};
-		float A = m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2]
-			- m.m[0][0] * m.m[1][3] * m.m[2][2] * m.m[3][1] - m.m[0][0] * m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[0][0] * m.m[1][1] * m.m[2][3] * m.m[3][2]
-			- m.m[0][1] * m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[1][0] * m.m[2][3] * m.m[3][1] - m.m[0][3] * m.m[1][0] * m.m[2][1] * m.m[3][2]
-			+ m.m[0][3] * m.m[1][0] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[0][1] * m.m[1][0] * m.m[2][3] * m.m[3][2]
-			+ m.m[0][1] * m.m[1][2] * m.m[2][0] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] * m.m[3][2]
-			- m.m[0][3] * m.m[1][2] * m.m[2][0] * m.m[3][1] - m.m[0][2] * m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] * m.m[3][2]
-			- m.m[0][1] * m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[0][2] * m.m[1][3] * m.m[2][1] * m.m[3][0] - m.m[0][3] * m.m[1][1] * m.m[2][2] * m.m[3][0]
-			+ m.m[0][3] * m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[0][2] * m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[0][1] * m.m[1][3] * m.m[2][2] * m.m[3][0];
-		resultInverse.m[0][0] = (
-			m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[1][3] * m.m[2][1] * m.m[3][2]
-			- m.m[1][3] * m.m[2][2] * m.m[3][1] - m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[1][1] * m.m[2][3] * m.m[3][2]) / A;
-		resultInverse.m[0][1] = (
-			-m.m[0][1] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[2][3] * m.m[3][1] - m.m[0][3] * m.m[2][1] * m.m[3][2]
-			+ m.m[0][3] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[2][1] * m.m[3][3] + m.m[0][1] * m.m[2][3] * m.m[3][2]) / A;
-		resultInverse.m[0][2] = (
-			m.m[0][1] * m.m[1][2] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[3][2]
-			- m.m[0][3] * m.m[1][2] * m.m[3][1] - m.m[0][2] * m.m[1][1] * m.m[3][3] - m.m[0][1] * m.m[1][3] * m.m[3][2]) / A;
-		resultInverse.m[0][3] = (
-			-m.m[0][1] * m.m[1][2] * m.m[2][3] - m.m[0][2] * m.m[1][3] * m.m[2][1] - m.m[0][3] * m.m[1][1] * m.m[2][2]
-			+ m.m[0][3] * m.m[1][2] * m.m[2][1] + m.m[0][2] * m.m[1][1] * m.m[2][3] + m.m[0][1] * m.m[1][3] * m.m[2][2]) / A;
-		resultInverse.m[1][0] = (
-			-m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[1][3] * m.m[2][0] * m.m[3][2]
-			+ m.m[1][3] * m.m[2][2] * m.m[3][0] + m.m[1][2] * m.m[2][0] * m.m[3][3] + m.m[1][0] * m.m[2][3] * m.m[3][2]) / A;
-		resultInverse.m[1][1] = (
-			m.m[0][0] * m.m[2][2] * m.m[3][3] + m.m[0][2] * m.m[2][3] * m.m[3][0] + m.m[0][3] * m.m[2][0] * m.m[3][2]
-			- m.m[0][3] * m.m[2][2] * m.m[3][0] - m.m[0][2] * m.m[2][0] * m.m[3][3] - m.m[0][0] * m.m[2][3] * m.m[3][2]) / A;
-		resultInverse.m[1][2] = (
-			-m.m[0][0] * m.m[1][2] * m.m[3][3] - m.m[0][2] * m.m[1][3] * m.m[3][0] - m.m[0][3] * m.m[1][0] * m.m[3][2]
-			+ m.m[0][3] * m.m[1][2] * m.m[3][0] + m.m[0][2] * m.m[1][0] * m.m[3][3] + m.m[0][0] * m.m[1][3] * m.m[3][2]) / A;
-		resultInverse.m[1][3] = (
-			m.m[0][0] * m.m[1][2] * m.m[2][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] + m.m[0][3] * m.m[1][0] * m.m[2][2]
-			- m.m[0][3] * m.m[1][2] * m.m[2][0] - m.m[0][2] * m.m[1][0] * m.m[2][3] - m.m[0][0] * m.m[1][3] * m.m[2][2]) / A;
-		resultInverse.m[2][0] = (
-			m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[1][3] * m.m[2][0] * m.m[3][1]
-			- m.m[1][3] * m.m[2][1] * m.m[3][0] - m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[1][0] * m.m[2][3] * m.m[3][1]) / A;
-		resultInverse.m[2][1] = (
-			-m.m[0][0] * m.m[2][1] * m.m[3][3] - m.m[0][1] * m.m[2][3] * m.m[3][0] - m.m[0][3] * m.m[2][0] * m.m[3][1]
-			+ m.m[0][3] * m.m[2][1] * m.m[3][0] + m.m[0][1] * m.m[2][0] * m.m[3][3] + m.m[0][0] * m.m[2][3] * m.m[3][1]) / A;
-		resultInverse.m[2][2] = (
-			m.m[0][0] * m.m[1][1] * m.m[3][3] + m.m[0][1] * m.m[1][3] * m.m[3][0] + m.m[0][3] * m.m[1][0] * m.m[3][1]
-			- m.m[0][3] * m.m[1][1] * m.m[3][0] - m.m[0][1] * m.m[1][0] * m.m[3][3] - m.m[0][0] * m.m[1][3] * m.m[3][1]) / A;
-		resultInverse.m[2][3] = (
-			-m.m[0][0] * m.m[1][1] * m.m[2][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] - m.m[0][3] * m.m[1][0] * m.m[2][1]
-			+ m.m[0][3] * m.m[1][1] * m.m[2][0] + m.m[0][1] * m.m[1][0] * m.m[2][3] + m.m[0][0] * m.m[1][3] * m.m[2][1]) / A;
-		resultInverse.m[3][0] = (
-			-m.m[1][0] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][2] * m.m[3][0] - m.m[1][2] * m.m[2][0] * m.m[3][1]
-			+ m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[1][1] * m.m[2][0] * m.m[3][2] + m.m[1][0] * m.m[2][2] * m.m[3][1]) / A;
-		resultInverse.m[3][1] = (
-			m.m[0][0] * m.m[2][1] * m.m[3][2] + m.m[0][1] * m.m[2][2] * m.m[3][0] + m.m[0][2] * m.m[2][0] * m.m[3][1]
-			- m.m[0][2] * m.m[2][1] * m.m[3][0] - m.m[0][1] * m.m[2][0] * m.m[3][2] - m.m[0][0] * m.m[2][2] * m.m[3][1]) / A;
-		resultInverse.m[3][2] = (
-			-m.m[0][0] * m.m[1][1] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[3][0] - m.m[0][2] * m.m[1][0] * m.m[3][1]
-			+ m.m[0][2] * m.m[1][1] * m.m[3][0] + m.m[0][1] * m.m[1][0] * m.m[3][2] + m.m[0][0] * m.m[1][2] * m.m[3][1]) / A;
-		resultInverse.m[3][3] = (
-			m.m[0][0] * m.m[1][1] * m.m[2][2] + m.m[0][1] * m.m[1][2] * m.m[2][0] + m.m[0][2] * m.m[1][0] * m.m[2][1]
-			- m.m[0][2] * m.m[1][1] * m.m[2][0] - m.m[0][1] * m.m[1][0] * m.m[2][2] - m.m[0][0] * m.m[1][2] * m.m[2][1]) / A;
+#ifdef MATH_USE_SSE
+	namespace {
+		using namespace Simd;
+
+		// ベクトルの並べ替え
+		template <int kX, int kY, int kZ, int kW>
+		inline __m128 Swizzle(__m128 v) { return Shuffle<kX, kY, kZ, kW>(v, v); }
+
+		// 4 要素の合計を全要素に入れる
+		inline __m128 HorizontalSum(__m128 v)
+		{
+			v = _mm_add_ps(v, Swizzle<1, 0, 3, 2>(v));
+			return _mm_add_ps(v, Swizzle<2, 3, 0, 1>(v));
+		}
+
+		// 2x2 行列（行優先で 4 要素）の積 A * B
+		inline __m128 Mat2Multiply(__m128 a, __m128 b)
+		{
+			return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+
+		// 2x2 行列の余因子行列との積 adj(A) * B
+		inline __m128 Mat2AdjugateMultiply(__m128 a, __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+		}
+
+		// 2x2 行列と余因子行列の積 A * adj(B)
+		inline __m128 Mat2MultiplyAdjugate(__m128 a, __m128 b)
+		{
+			return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+
+		// 外積（w 要素は 0 になる）
+		inline __m128 Cross(__m128 a, __m128 b)
+		{
+			return _mm_sub_ps(
+				_mm_mul_ps(Swizzle<1, 2, 0, 3>(a), Swizzle<2, 0, 1, 3>(b)),
+				_mm_mul_ps(Swizzle<2, 0, 1, 3>(a), Swizzle<1, 2, 0, 3>(b)));
+		}
+	}
+#endif
+
+	Matrix4x4 Inverse(const Matrix4x4& m)
+	{
+#ifdef MATH_USE_SSE
+		const __m128 row0 = LoadRow(m, 0);
+		const __m128 row1 = LoadRow(m, 1);
+		const __m128 row2 = LoadRow(m, 2);
+		const __m128 row3 = LoadRow(m, 3);
+
+		// 2x2 のブロック | A B |
+		//                | C D |
+		const __m128 a = _mm_movelh_ps(row0, row1);
+		const __m128 b = _mm_movehl_ps(row1, row0);
+		const __m128 c = _mm_movelh_ps(row2, row3);
+		const __m128 d = _mm_movehl_ps(row3, row2);
+
+		// 各ブロックの行列式 (|A|, |B|, |C|, |D|)
+		const __m128 detSub = _mm_sub_ps(
+			_mm_mul_ps(Shuffle<0, 2, 0, 2>(row0, row2), Shuffle<1, 3, 1, 3>(row1, row3)),
+			_mm_mul_ps(Shuffle<1, 3, 1, 3>(row0, row2), Shuffle<0, 2, 0, 2>(row1, row3)));
+		const __m128 detA = Splat<0>(detSub);
+		const __m128 detB = Splat<1>(detSub);
+		const __m128 detC = Splat<2>(detSub);
+		const __m128 detD = Splat<3>(detSub);
+
+		// 逆行列 = 1/|M| * | X Y |  として、各ブロックの余因子行列 X#, Y#, Z#, W# を求める
+		//                  | Z W |
+		const __m128 adjDC = Mat2AdjugateMultiply(d, c);
+		const __m128 adjAB = Mat2AdjugateMultiply(a, b);
+		__m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), Mat2Multiply(b, adjDC));
+		__m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), Mat2Multiply(c, adjAB));
+		__m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), Mat2MultiplyAdjugate(d, adjAB));
+		__m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), Mat2MultiplyAdjugate(a, adjDC));
+
+		// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+		const __m128 trace = HorizontalSum(_mm_mul_ps(adjAB, Swizzle<0, 2, 1, 3>(adjDC)));
+		const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), trace);
+
+		// 余因子行列の符号 (+, -, -, +) と 1/|M| をまとめて掛ける
+		const __m128 inverseDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), det);
+		x = _mm_mul_ps(x, inverseDet);
+		y = _mm_mul_ps(y, inverseDet);
+		z = _mm_mul_ps(z, inverseDet);
+		w = _mm_mul_ps(w, inverseDet);
+
+		// 余因子行列の並べ替えと、ブロックから行への並べ替えをまとめて行う
+		Matrix4x4 resultInverse;
+		StoreRow(resultInverse, 0, Shuffle<3, 1, 3, 1>(x, y));
+		StoreRow(resultInverse, 1, Shuffle<2, 0, 2, 0>(x, y));
+		StoreRow(resultInverse, 2, Shuffle<3, 1, 3, 1>(z, w));
+		StoreRow(resultInverse, 3, Shuffle<2, 0, 2, 0>(z, w));
 		return resultInverse;
-    }
+#else
+		return Scalar::Inverse(m);
+#endif
+	}
+
+	Matrix4x4 InverseAffine(const Matrix4x4& m)
+	{
+#ifdef MATH_USE_SSE
+		const __m128 row0 = LoadRow(m, 0);
+		const __m128 row1 = LoadRow(m, 1);
+		const __m128 row2 = LoadRow(m, 2);
+
+		// 3x3 の逆行列の列 = 行ベクトル同士の外積 / 行列式
+		__m128 column0 = Cross(row1, row2);
+		__m128 column1 = Cross(row2, row0);
+		__m128 column2 = Cross(row0, row1);
+		__m128 column3 = _mm_setzero_ps();
+		const __m128 inverseDet = _mm_div_ps(_mm_set1_ps(1.0f), HorizontalSum(_mm_mul_ps(row0, column0)));
+
+		// 列を行に並べ替える（w 要素は外積で 0 になっている）
+		_MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+		const __m128 inverse0 = _mm_mul_ps(column0, inverseDet);
+		const __m128 inverse1 = _mm_mul_ps(column1, inverseDet);
+		const __m128 inverse2 = _mm_mul_ps(column2, inverseDet);
+
+		// 平行移動 = -t * (3x3 の逆行列)、w = 1
+		const __m128 translate = LoadRow(m, 3);
+		__m128 inverseTranslate = _mm_mul_ps(Splat<0>(translate), inverse0);
+		inverseTranslate = _mm_add_ps(inverseTranslate, _mm_mul_ps(Splat<1>(translate), inverse1));
+		inverseTranslate = _mm_add_ps(inverseTranslate, _mm_mul_ps(Splat<2>(translate), inverse2));
+
+		Matrix4x4 resultInverse;
+		StoreRow(resultInverse, 0, inverse0);
+		StoreRow(resultInverse, 1, inverse1);
+		StoreRow(resultInverse, 2, inverse2);
+		StoreRow(resultInverse, 3, _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), inverseTranslate));
+		return resultInverse;
+#else
+		return Scalar::InverseAffine(m);
+#endif
+	}
+
+	namespace Scalar {
+		// 余因子展開による逆行列（SIMD 化する前からの実装）
+		Matrix4x4 Inverse(const Matrix4x4& m)
+		{
+			Matrix4x4 resultInverse = {};
+			float A = m.m[0][0] * m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[0][0] * m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[0][0] * m.m[1][3] * m.m[2][1] * m.m[3][2]
+				- m.m[0][0] * m.m[1][3] * m.m[2][2] * m.m[3][1] - m.m[0][0] * m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[0][0] * m.m[1][1] * m.m[2][3] * m.m[3][2]
+				- m.m[0][1] * m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[1][0] * m.m[2][3] * m.m[3][1] - m.m[0][3] * m.m[1][0] * m.m[2][1] * m.m[3][2]
+				+ m.m[0][3] * m.m[1][0] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[0][1] * m.m[1][0] * m.m[2][3] * m.m[3][2]
+				+ m.m[0][1] * m.m[1][2] * m.m[2][0] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[2][0] * m.m[3][2]
+				- m.m[0][3] * m.m[1][2] * m.m[2][0] * m.m[3][1] - m.m[0][2] * m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] * m.m[3][2]
+				- m.m[0][1] * m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[0][2] * m.m[1][3] * m.m[2][1] * m.m[3][0] - m.m[0][3] * m.m[1][1] * m.m[2][2] * m.m[3][0]
+				+ m.m[0][3] * m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[0][2] * m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[0][1] * m.m[1][3] * m.m[2][2] * m.m[3][0];
+			resultInverse.m[0][0] = (
+				m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][1] + m.m[1][3] * m.m[2][1] * m.m[3][2]
+				- m.m[1][3] * m.m[2][2] * m.m[3][1] - m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[1][1] * m.m[2][3] * m.m[3][2]) / A;
+			resultInverse.m[0][1] = (
+				-m.m[0][1] * m.m[2][2] * m.m[3][3] - m.m[0][2] * m.m[2][3] * m.m[3][1] - m.m[0][3] * m.m[2][1] * m.m[3][2]
+				+ m.m[0][3] * m.m[2][2] * m.m[3][1] + m.m[0][2] * m.m[2][1] * m.m[3][3] + m.m[0][1] * m.m[2][3] * m.m[3][2]) / A;
+			resultInverse.m[0][2] = (
+				m.m[0][1] * m.m[1][2] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[3][1] + m.m[0][3] * m.m[1][1] * m.m[3][2]
+				- m.m[0][3] * m.m[1][2] * m.m[3][1] - m.m[0][2] * m.m[1][1] * m.m[3][3] - m.m[0][1] * m.m[1][3] * m.m[3][2]) / A;
+			resultInverse.m[0][3] = (
+				-m.m[0][1] * m.m[1][2] * m.m[2][3] - m.m[0][2] * m.m[1][3] * m.m[2][1] - m.m[0][3] * m.m[1][1] * m.m[2][2]
+				+ m.m[0][3] * m.m[1][2] * m.m[2][1] + m.m[0][2] * m.m[1][1] * m.m[2][3] + m.m[0][1] * m.m[1][3] * m.m[2][2]) / A;
+			resultInverse.m[1][0] = (
+				-m.m[1][0] * m.m[2][2] * m.m[3][3] - m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[1][3] * m.m[2][0] * m.m[3][2]
+				+ m.m[1][3] * m.m[2][2] * m.m[3][0] + m.m[1][2] * m.m[2][0] * m.m[3][3] + m.m[1][0] * m.m[2][3] * m.m[3][2]) / A;
+			resultInverse.m[1][1] = (
+				m.m[0][0] * m.m[2][2] * m.m[3][3] + m.m[0][2] * m.m[2][3] * m.m[3][0] + m.m[0][3] * m.m[2][0] * m.m[3][2]
+				- m.m[0][3] * m.m[2][2] * m.m[3][0] - m.m[0][2] * m.m[2][0] * m.m[3][3] - m.m[0][0] * m.m[2][3] * m.m[3][2]) / A;
+			resultInverse.m[1][2] = (
+				-m.m[0][0] * m.m[1][2] * m.m[3][3] - m.m[0][2] * m.m[1][3] * m.m[3][0] - m.m[0][3] * m.m[1][0] * m.m[3][2]
+				+ m.m[0][3] * m.m[1][2] * m.m[3][0] + m.m[0][2] * m.m[1][0] * m.m[3][3] + m.m[0][0] * m.m[1][3] * m.m[3][2]) / A;
+			resultInverse.m[1][3] = (
+				m.m[0][0] * m.m[1][2] * m.m[2][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] + m.m[0][3] * m.m[1][0] * m.m[2][2]
+				- m.m[0][3] * m.m[1][2] * m.m[2][0] - m.m[0][2] * m.m[1][0] * m.m[2][3] - m.m[0][0] * m.m[1][3] * m.m[2][2]) / A;
+			resultInverse.m[2][0] = (
+				m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[1][1] * m.m[2][3] * m.m[3][0] + m.m[1][3] * m.m[2][0] * m.m[3][1]
+				- m.m[1][3] * m.m[2][1] * m.m[3][0] - m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[1][0] * m.m[2][3] * m.m[3][1]) / A;
+			resultInverse.m[2][1] = (
+				-m.m[0][0] * m.m[2][1] * m.m[3][3] - m.m[0][1] * m.m[2][3] * m.m[3][0] - m.m[0][3] * m.m[2][0] * m.m[3][1]
+				+ m.m[0][3] * m.m[2][1] * m.m[3][0] + m.m[0][1] * m.m[2][0] * m.m[3][3] + m.m[0][0] * m.m[2][3] * m.m[3][1]) / A;
+			resultInverse.m[2][2] = (
+				m.m[0][0] * m.m[1][1] * m.m[3][3] + m.m[0][1] * m.m[1][3] * m.m[3][0] + m.m[0][3] * m.m[1][0] * m.m[3][1]
+				- m.m[0][3] * m.m[1][1] * m.m[3][0] - m.m[0][1] * m.m[1][0] * m.m[3][3] - m.m[0][0] * m.m[1][3] * m.m[3][1]) / A;
+			resultInverse.m[2][3] = (
+				-m.m[0][0] * m.m[1][1] * m.m[2][3] - m.m[0][1] * m.m[1][3] * m.m[2][0] - m.m[0][3] * m.m[1][0] * m.m[2][1]
+				+ m.m[0][3] * m.m[1][1] * m.m[2][0] + m.m[0][1] * m.m[1][0] * m.m[2][3] + m.m[0][0] * m.m[1][3] * m.m[2][1]) / A;
+			resultInverse.m[3][0] = (
+				-m.m[1][0] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][2] * m.m[3][0] - m.m[1][2] * m.m[2][0] * m.m[3][1]
+				+ m.m[1][2] * m.m[2][1] * m.m[3][0] + m.m[1][1] * m.m[2][0] * m.m[3][2] + m.m[1][0] * m.m[2][2] * m.m[3][1]) / A;
+			resultInverse.m[3][1] = (
+				m.m[0][0] * m.m[2][1] * m.m[3][2] + m.m[0][1] * m.m[2][2] * m.m[3][0] + m.m[0][2] * m.m[2][0] * m.m[3][1]
+				- m.m[0][2] * m.m[2][1] * m.m[3][0] - m.m[0][1] * m.m[2][0] * m.m[3][2] - m.m[0][0] * m.m[2][2] * m.m[3][1]) / A;
+			resultInverse.m[3][2] = (
+				-m.m[0][0] * m.m[1][1] * m.m[3][2] - m.m[0][1] * m.m[1][2] * m.m[3][0] - m.m[0][2] * m.m[1][0] * m.m[3][1]
+				+ m.m[0][2] * m.m[1][1] * m.m[3][0] + m.m[0][1] * m.m[1][0] * m.m[3][2] + m.m[0][0] * m.m[1][2] * m.m[3][1]) / A;
+			resultInverse.m[3][3] = (
+				m.m[0][0] * m.m[1][1] * m.m[2][2] + m.m[0][1] * m.m[1][2] * m.m[2][0] + m.m[0][2] * m.m[1][0] * m.m[2][1]
+				- m.m[0][2] * m.m[1][1] * m.m[2][0] - m.m[0][1] * m.m[1][0] * m.m[2][2] - m.m[0][0] * m.m[1][2] * m.m[2][1]) / A;
+			return resultInverse;
+		}
+
+		Matrix4x4 InverseAffine(const Matrix4x4& m)
+		{
+			// 3x3 の逆行列の列 = 行ベクトル同士の外積 / 行列式
+			const auto cross = [&m](int a, int b, float out[3]) {
+				out[0] = m.m[a][1] * m.m[b][2] - m.m[a][2] * m.m[b][1];
+				out[1] = m.m[a][2] * m.m[b][0] - m.m[a][0] * m.m[b][2];
+				out[2] = m.m[a][0] * m.m[b][1] - m.m[a][1] * m.m[b][0];
+			};
+			float columns[3][3];
+			cross(1, 2, columns[0]);
+			cross(2, 0, columns[1]);
+			cross(0, 1, columns[2]);
+			const float inverseDet = 1.0f / (m.m[0][0] * columns[0][0] + m.m[0][1] * columns[0][1] + m.m[0][2] * columns[0][2]);
+
+			Matrix4x4 resultInverse = {};
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 3; j++) {
+					resultInverse.m[i][j] = columns[j][i] * inverseDet;
+				}
+			}
+
+			// 平行移動 = -t * (3x3 の逆行列)、w = 1
+			for (int j = 0; j < 3; j++) {
+				resultInverse.m[3][j] = -(m.m[3][0] * resultInverse.m[0][j] + m.m[3][1] * resultInverse.m[1][j] + m.m[3][2] * resultInverse.m[2][j]);
+			}
+			resultInverse.m[3][3] = 1.0f;
+			return resultInverse;
+		}
+	}
 }
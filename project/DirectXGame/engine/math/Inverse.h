@@ -6,5 +6,15 @@ namespace Math
 {
 	// 逆行列
 	Matrix4x4 Inverse(const Matrix4x4& m);
+
+	// アフィン行列（最終列が (0, 0, 0, 1)）の逆行列。ワールド行列・カメラ行列用の高速版
+	Matrix4x4 InverseAffine(const Matrix4x4& m);
+
+	// SIMD を使わない実装（MATH_FORCE_SCALAR のときは上の関数もこれになる。結果・速度の比較用）
+	namespace Scalar
+	{
+		Matrix4x4 Inverse(const Matrix4x4& m);
+		Matrix4x4 InverseAffine(const Matrix4x4& m);
+	}
 }
 
@@ -1,8 +1,21 @@
 #include "Logger.h"
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <cstdio>
+#endif
 
 namespace Logger {
 	void Log(const std::string& message) {
-		OutputDebugStringA(message.c_str());
+		Log(message.c_str());
 	}
-}
\ No newline at end of file
+
+	void Log(const char* message) {
+#ifdef _WIN32
+		OutputDebugStringA(message);
+#else
+		// Windows 以外（project/tests のテスト・ベンチマーク）は標準エラーに出す
+		std::fputs(message, stderr);
+#endif
+	}
+}
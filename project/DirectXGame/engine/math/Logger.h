@@ -1,8 +1,8 @@
 #pragma once
 #include <string>
 
-// ログ出力名前空間
+// ログ出力名前空間（書式付きの出力は LogFormat.h）
 namespace Logger {
 	void Log(const std::string& message);
+	void Log(const char* message);
 }
-
@@ -1,12 +1,10 @@
 #include "MakeRotateXYZMatrix.h"
+#include "Quaternion.h"
 
 namespace Math {
 	Matrix4x4 MakeRotateXYZMatrix(Vector3 rotate)
 	{
-		Matrix4x4 rotateMatrix;
-		return rotateMatrix = MakeRotateXMatrix(rotate.x) *
-			MakeRotateYMatrix(rotate.y) *
-			MakeRotateZMatrix(rotate.z);
-
+		// RotateX * RotateY * RotateZ と同じ回転を、行列を 3 回掛けずにクォータニオンから求める
+		return MakeRotateMatrix(MakeRotateXYZQuaternion(rotate));
 	}
-}
\ No newline at end of file
+}
@@ -1,9 +1,18 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#ifdef _WIN32
+#include <d3d12.h>
+#else
+// D3D12 を使わないビルド（project/tests の OBJ パース）用。パースの結果では使わないので形だけ合わせる
+struct D3D12_GPU_DESCRIPTOR_HANDLE {
+	uint64_t ptr;
+};
+#endif
 
 // マテリアルデータ構造体
 struct MaterialData {
 	std::string textureFilePath;
 	uint32_t textureIndex = 0;
 	D3D12_GPU_DESCRIPTOR_HANDLE gpuHandle{};
-};
\ No newline at end of file
+};
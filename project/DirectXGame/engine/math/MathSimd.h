@@ -0,0 +1,64 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector4.h"
+
+// 行列演算の SIMD 実装の切り替え
+// - MATH_USE_SSE : x64 / SSE2 が使えるとき（x64 は常に使える）
+// - MATH_USE_AVX : /arch:AVX 以上でビルドしたとき（行列積を 2 行ずつ計算する）
+// - MATH_FORCE_SCALAR を定義すると SIMD を使わずスカラー実装になる（結果の比較・デバッグ用）
+#if !defined(MATH_FORCE_SCALAR) && (defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__))
+#define MATH_USE_SSE
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define MATH_USE_AVX
+#include <immintrin.h>
+#endif
+#endif
+
+#ifdef MATH_USE_SSE
+
+// 行列演算の SIMD 用の補助関数（Multiply.cpp / Inverse.cpp の内部でのみ使う）
+namespace Math::Simd
+{
+	// シャッフルの指定（_MM_SHUFFLE と逆順で、結果の要素 0, 1, 2, 3 に入れる要素番号を並べる）
+	constexpr int ShuffleMask(int x, int y, int z, int w) { return x | (y << 2) | (z << 4) | (w << 6); }
+
+	// 行列の 1 行の読み込み・書き込み（Matrix4x4 は 16 バイト境界に揃っていないため unaligned）
+	inline __m128 LoadRow(const Matrix4x4& m, int row) { return _mm_loadu_ps(m.m[row]); }
+	inline void StoreRow(Matrix4x4& m, int row, __m128 value) { _mm_storeu_ps(m.m[row], value); }
+
+	// a の 2 要素と b の 2 要素を並べる（_mm_shuffle_ps の指定を ShuffleMask と同じ順で書く）
+	// 指定は即値でなければならず、GCC の最適化なしのビルドでは constexpr 関数の呼び出しを直接渡せないため、定数に受けてから渡す
+	template <int kX, int kY, int kZ, int kW>
+	inline __m128 Shuffle(__m128 a, __m128 b)
+	{
+		constexpr int kMask = ShuffleMask(kX, kY, kZ, kW);
+		return _mm_shuffle_ps(a, b, kMask);
+	}
+
+	// ベクトルの 1 要素を 4 要素に複製
+	template <int kIndex>
+	inline __m128 Splat(__m128 v) { return Shuffle<kIndex, kIndex, kIndex, kIndex>(v, v); }
+
+#ifdef MATH_USE_AVX
+	// 上下 128bit のそれぞれで 1 要素を 4 要素に複製
+	template <int kIndex>
+	inline __m256 Splat(__m256 v)
+	{
+		constexpr int kMask = ShuffleMask(kIndex, kIndex, kIndex, kIndex);
+		return _mm256_shuffle_ps(v, v, kMask);
+	}
+#endif
+
+	// 行ベクトル v と行列（4 行）の積 v * M（各要素を対応する行に掛けて足す）
+	inline __m128 MultiplyRow(__m128 v, __m128 row0, __m128 row1, __m128 row2, __m128 row3)
+	{
+		__m128 result = _mm_mul_ps(Splat<0>(v), row0);
+		result = _mm_add_ps(result, _mm_mul_ps(Splat<1>(v), row1));
+		result = _mm_add_ps(result, _mm_mul_ps(Splat<2>(v), row2));
+		result = _mm_add_ps(result, _mm_mul_ps(Splat<3>(v), row3));
+		return result;
+	}
+}
+
+#endif
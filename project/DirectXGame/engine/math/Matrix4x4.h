@@ -26,18 +26,8 @@ struct Matrix4x4 {
         return result;
     }
 
-    // 行列の乗算
-    Matrix4x4 operator*(const Matrix4x4& other) const {
-        Matrix4x4 result = {};
-        for (int i = 0; i < 4; ++i) {
-            for (int j = 0; j < 4; ++j) {
-                for (int k = 0; k < 4; ++k) {
-                    result.m[i][j] += this->m[i][k] * other.m[k][j];
-                }
-            }
-        }
-        return result;
-    }
+    // 行列の乗算（Math::Multiply と同じ。実装は Multiply.cpp）
+    Matrix4x4 operator*(const Matrix4x4& other) const;
 
     // 行列のスカラー乗算
     Matrix4x4 operator*(float scalar) const {
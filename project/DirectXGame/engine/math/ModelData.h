@@ -2,9 +2,12 @@
 #include <vector>
 #include "MaterialData.h"
 #include "VertexData.h"
+#include "BoundingSphere.h"
 
 // モデルデータ構造体
 struct ModelData {
 	std::vector<VertexData> vertices;
 	MaterialData material;
+	// ローカル座標の境界球（読み込み時に求める。視錐台カリング用）
+	BoundingSphere boundingSphere{};
 };
\ No newline at end of file
@@ -1,25 +1,86 @@
 #include "Multiply.h"
+#include "MathSimd.h"
 
+//
+// Multiply
+// - 行列と行列、行列とベクトルの積。オブジェクト・パーティクルごとに毎フレーム呼ばれる。
+// - 規約：行ベクトル（v * M）。結果の i 行目は「m1 の i 行目の各要素で m2 の各行を重み付けして足したもの」になるため、
+//   SIMD では m2 の 4 行をレジスタに載せ、m1 の要素を複製して掛け足すだけで 1 行が求まる（転置は不要）。
+// - AVX が使えるビルドでは 2 行分を 256bit で同時に計算する。
+// - SIMD が使えない（MATH_FORCE_SCALAR を含む）場合は従来のスカラー実装（Math::Scalar）になる。
+//   Math::Scalar はどのビルドでも使えるので、project/tests の MathPrecisionTest / MathBench で SIMD 版と比べる。
+//
 namespace Math {
 	Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2)
 	{
-		Matrix4x4 resultMultiply = {};
+		Matrix4x4 resultMultiply;
+#if defined(MATH_USE_AVX)
+		// m2 の各行を上下 128bit に複製し、m1 の 2 行を同時に処理する（シャッフルは 128bit 単位で行われる）
+		const __m256 row0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[0]));
+		const __m256 row1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[1]));
+		const __m256 row2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[2]));
+		const __m256 row3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[3]));
+		for (int i = 0; i < 4; i += 2) {
+			const __m256 a = _mm256_loadu_ps(m1.m[i]);
+			__m256 result = _mm256_mul_ps(Simd::Splat<0>(a), row0);
+			result = _mm256_add_ps(result, _mm256_mul_ps(Simd::Splat<1>(a), row1));
+			result = _mm256_add_ps(result, _mm256_mul_ps(Simd::Splat<2>(a), row2));
+			result = _mm256_add_ps(result, _mm256_mul_ps(Simd::Splat<3>(a), row3));
+			_mm256_storeu_ps(resultMultiply.m[i], result);
+		}
+#elif defined(MATH_USE_SSE)
+		const __m128 row0 = Simd::LoadRow(m2, 0);
+		const __m128 row1 = Simd::LoadRow(m2, 1);
+		const __m128 row2 = Simd::LoadRow(m2, 2);
+		const __m128 row3 = Simd::LoadRow(m2, 3);
 		for (int i = 0; i < 4; i++) {
-			for (int j = 0; j < 4; j++) {
-				resultMultiply.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] + m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
-			}
+			Simd::StoreRow(resultMultiply, i, Simd::MultiplyRow(Simd::LoadRow(m1, i), row0, row1, row2, row3));
 		}
+#else
+		resultMultiply = Scalar::Multiply(m1, m2);
+#endif
 		return resultMultiply;
 	}
 
 	// Matrix4x4とVector4の乗算
 	Vector4 Multiply(const Matrix4x4& mat, const Vector4& vec)
 	{
+#ifdef MATH_USE_SSE
 		Vector4 result = {};
-		result.x = mat.m[0][0] * vec.x + mat.m[1][0] * vec.y + mat.m[2][0] * vec.z + mat.m[3][0] * vec.w;
-		result.y = mat.m[0][1] * vec.x + mat.m[1][1] * vec.y + mat.m[2][1] * vec.z + mat.m[3][1] * vec.w;
-		result.z = mat.m[0][2] * vec.x + mat.m[1][2] * vec.y + mat.m[2][2] * vec.z + mat.m[3][2] * vec.w;
-		result.w = mat.m[0][3] * vec.x + mat.m[1][3] * vec.y + mat.m[2][3] * vec.z + mat.m[3][3] * vec.w;
+		const __m128 v = _mm_loadu_ps(&vec.x);
+		_mm_storeu_ps(&result.x, Simd::MultiplyRow(v, Simd::LoadRow(mat, 0), Simd::LoadRow(mat, 1), Simd::LoadRow(mat, 2), Simd::LoadRow(mat, 3)));
 		return result;
+#else
+		return Scalar::Multiply(mat, vec);
+#endif
 	}
-}
\ No newline at end of file
+
+	namespace Scalar {
+		Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2)
+		{
+			Matrix4x4 resultMultiply;
+			for (int i = 0; i < 4; i++) {
+				for (int j = 0; j < 4; j++) {
+					resultMultiply.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] + m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+				}
+			}
+			return resultMultiply;
+		}
+
+		Vector4 Multiply(const Matrix4x4& mat, const Vector4& vec)
+		{
+			Vector4 result = {};
+			result.x = mat.m[0][0] * vec.x + mat.m[1][0] * vec.y + mat.m[2][0] * vec.z + mat.m[3][0] * vec.w;
+			result.y = mat.m[0][1] * vec.x + mat.m[1][1] * vec.y + mat.m[2][1] * vec.z + mat.m[3][1] * vec.w;
+			result.z = mat.m[0][2] * vec.x + mat.m[1][2] * vec.y + mat.m[2][2] * vec.z + mat.m[3][2] * vec.w;
+			result.w = mat.m[0][3] * vec.x + mat.m[1][3] * vec.y + mat.m[2][3] * vec.z + mat.m[3][3] * vec.w;
+			return result;
+		}
+	}
+}
+
+// 行列の乗算（Math::Multiply と同じ実装を使う）
+Matrix4x4 Matrix4x4::operator*(const Matrix4x4& other) const
+{
+	return Math::Multiply(*this, other);
+}
@@ -7,5 +7,12 @@ namespace Math
 {
 	Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
 	Vector4 Multiply(const Matrix4x4& mat, const Vector4& vec);
+
+	// SIMD を使わない実装（MATH_FORCE_SCALAR のときは上の関数もこれになる。結果・速度の比較用）
+	namespace Scalar
+	{
+		Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
+		Vector4 Multiply(const Matrix4x4& mat, const Vector4& vec);
+	}
 }
 
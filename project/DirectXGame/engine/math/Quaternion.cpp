@@ -0,0 +1,244 @@
+#include "Quaternion.h"
+#include <algorithm>
+#include <cmath>
+
+//
+// Quaternion
+// - 回転をオイラー角の代わりにクォータニオンで持つための関数群。
+//   * 行列への変換は積と和だけで求まる（三角関数も行列の積も不要）。WorldTransform / Camera は回転をクォータニオンで持ち、
+//     三角関数はオイラー角を設定したときの 1 回（半角の sin / cos）だけにする。
+//   * 補間は Slerp / Nlerp。オイラー角を軸ごとに補間すると経路が曲がり、ジンバルロック付近で破綻するため、
+//     カメラのイージングなど「向き」を補間する箇所はこちらを使う。
+// - 規約：
+//   * 行ベクトル（v * M）。MakeRotateMatrix は MakeRotateXMatrix などと同じ向きに回る行列を返す。
+//   * オイラー角は X → Y → Z の順に適用（MakeRotateXYZMatrix = RotateX * RotateY * RotateZ と同じ）。
+//     クォータニオンでは q = qZ * qY * qX（右から順に適用）。
+// - 並びは Vector4 と同じ (x, y, z, w) の 16 バイトなので、SIMD ではそのまま 1 レジスタに読める。
+//
+namespace Math {
+	namespace {
+		// これより内積が大きい（ほぼ同じ向き）ときは Slerp の代わりに Nlerp を使う（sin(θ) が 0 に近く不安定なため）
+		constexpr float kSlerpThreshold = 0.9995f;
+
+		// 行列の 3 行（スケール込み）を書き込む
+		template <class MatrixType>
+		inline void WriteRotateRows(const Quaternion& q, const Vector3& scale, MatrixType& out)
+		{
+			const float x2 = q.x + q.x;
+			const float y2 = q.y + q.y;
+			const float z2 = q.z + q.z;
+			const float xx = q.x * x2;
+			const float yy = q.y * y2;
+			const float zz = q.z * z2;
+			const float xy = q.x * y2;
+			const float xz = q.x * z2;
+			const float yz = q.y * z2;
+			const float wx = q.w * x2;
+			const float wy = q.w * y2;
+			const float wz = q.w * z2;
+
+			out.m[0][0] = scale.x * (1.0f - (yy + zz));
+			out.m[0][1] = scale.x * (xy + wz);
+			out.m[0][2] = scale.x * (xz - wy);
+			out.m[1][0] = scale.y * (xy - wz);
+			out.m[1][1] = scale.y * (1.0f - (xx + zz));
+			out.m[1][2] = scale.y * (yz + wx);
+			out.m[2][0] = scale.z * (xz + wy);
+			out.m[2][1] = scale.z * (yz - wx);
+			out.m[2][2] = scale.z * (1.0f - (xx + yy));
+		}
+	}
+
+	Quaternion IdentityQuaternion()
+	{
+		return { 0.0f, 0.0f, 0.0f, 1.0f };
+	}
+
+	Quaternion Multiply(const Quaternion& q1, const Quaternion& q2)
+	{
+		return {
+			q1.w * q2.x + q1.x * q2.w + q1.y * q2.z - q1.z * q2.y,
+			q1.w * q2.y - q1.x * q2.z + q1.y * q2.w + q1.z * q2.x,
+			q1.w * q2.z + q1.x * q2.y - q1.y * q2.x + q1.z * q2.w,
+			q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z
+		};
+	}
+
+	Quaternion Conjugate(const Quaternion& q)
+	{
+		return { -q.x, -q.y, -q.z, q.w };
+	}
+
+	float Norm(const Quaternion& q)
+	{
+		return std::sqrt(Dot(q, q));
+	}
+
+	Quaternion Normalize(const Quaternion& q)
+	{
+		const float norm = Norm(q);
+		if (norm == 0.0f) {
+			return IdentityQuaternion();
+		}
+		const float inverseNorm = 1.0f / norm;
+		return { q.x * inverseNorm, q.y * inverseNorm, q.z * inverseNorm, q.w * inverseNorm };
+	}
+
+	Quaternion Inverse(const Quaternion& q)
+	{
+		const float inverseNormSq = 1.0f / Dot(q, q);
+		const Quaternion conjugate = Conjugate(q);
+		return { conjugate.x * inverseNormSq, conjugate.y * inverseNormSq, conjugate.z * inverseNormSq, conjugate.w * inverseNormSq };
+	}
+
+	float Dot(const Quaternion& q1, const Quaternion& q2)
+	{
+		return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w;
+	}
+
+	Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle)
+	{
+		const float halfSin = std::sin(angle * 0.5f);
+		return { axis.x * halfSin, axis.y * halfSin, axis.z * halfSin, std::cos(angle * 0.5f) };
+	}
+
+	Quaternion MakeRotateXYZQuaternion(const Vector3& rotate)
+	{
+		const float sinX = std::sin(rotate.x * 0.5f);
+		const float cosX = std::cos(rotate.x * 0.5f);
+		const float sinY = std::sin(rotate.y * 0.5f);
+		const float cosY = std::cos(rotate.y * 0.5f);
+		const float sinZ = std::sin(rotate.z * 0.5f);
+		const float cosZ = std::cos(rotate.z * 0.5f);
+
+		// qZ * qY * qX を展開したもの
+		return {
+			sinX * cosY * cosZ - cosX * sinY * sinZ,
+			cosX * sinY * cosZ + sinX * cosY * sinZ,
+			cosX * cosY * sinZ - sinX * sinY * cosZ,
+			cosX * cosY * cosZ + sinX * sinY * sinZ
+		};
+	}
+
+	Vector3 ToEulerXYZ(const Quaternion& q)
+	{
+		// 回転行列（RotateX * RotateY * RotateZ）の要素から求める
+		const float m00 = 1.0f - 2.0f * (q.y * q.y + q.z * q.z);
+		const float m01 = 2.0f * (q.x * q.y + q.w * q.z);
+		const float m02 = 2.0f * (q.x * q.z - q.w * q.y);
+		const float m10 = 2.0f * (q.x * q.y - q.w * q.z);
+		const float m11 = 1.0f - 2.0f * (q.x * q.x + q.z * q.z);
+		const float m12 = 2.0f * (q.y * q.z + q.w * q.x);
+		const float m20 = 2.0f * (q.x * q.z + q.w * q.y);
+		const float m21 = 2.0f * (q.y * q.z - q.w * q.x);
+		const float m22 = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
+
+		// X は m[1][2] = sin(X)cos(Y), m[2][2] = cos(X)cos(Y) から、Y は asin より精度の落ちにくい atan2 で求める
+		const float x = std::atan2(m12, m22);
+		const float y = std::atan2(-m02, std::sqrt(m00 * m00 + m01 * m01));
+
+		// Z は求めた X で行 1, 2 を回し戻してから求める。
+		// cos(Y) が 0 に近い（ジンバルロック）と X の精度は落ちるが、Z がその分を打ち消すので行列としては元に戻る
+		const float sinX = std::sin(x);
+		const float cosX = std::cos(x);
+		const float z = std::atan2(sinX * m20 - cosX * m10, cosX * m11 - sinX * m21);
+		return { x, y, z };
+	}
+
+	Vector3 RotateVector(const Vector3& vector, const Quaternion& q)
+	{
+		// v' = v + 2w(u × v) + 2u × (u × v)（u は q の虚部）
+		const Vector3 u = { q.x, q.y, q.z };
+		const Vector3 uv = {
+			u.y * vector.z - u.z * vector.y,
+			u.z * vector.x - u.x * vector.z,
+			u.x * vector.y - u.y * vector.x
+		};
+		const Vector3 uuv = {
+			u.y * uv.z - u.z * uv.y,
+			u.z * uv.x - u.x * uv.z,
+			u.x * uv.y - u.y * uv.x
+		};
+		return {
+			vector.x + 2.0f * (q.w * uv.x + uuv.x),
+			vector.y + 2.0f * (q.w * uv.y + uuv.y),
+			vector.z + 2.0f * (q.w * uv.z + uuv.z)
+		};
+	}
+
+	Matrix4x4 MakeRotateMatrix(const Quaternion& q)
+	{
+		return MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, q, { 0.0f, 0.0f, 0.0f });
+	}
+
+	Affine3x4 MakeAffine3x4(const Vector3& scale, const Quaternion& rotate, const Vector3& translate)
+	{
+		Affine3x4 result;
+		WriteRotateRows(rotate, scale, result);
+		result.m[3][0] = translate.x;
+		result.m[3][1] = translate.y;
+		result.m[3][2] = translate.z;
+		return result;
+	}
+
+	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate)
+	{
+		Matrix4x4 result;
+		WriteRotateRows(rotate, scale, result);
+		result.m[0][3] = 0.0f;
+		result.m[1][3] = 0.0f;
+		result.m[2][3] = 0.0f;
+		result.m[3][0] = translate.x;
+		result.m[3][1] = translate.y;
+		result.m[3][2] = translate.z;
+		result.m[3][3] = 1.0f;
+		return result;
+	}
+
+	Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t)
+	{
+		// 内積が負なら片方を反転して短い方の経路を通る
+		float dot = Dot(q0, q1);
+		Quaternion end = q1;
+		if (dot < 0.0f) {
+			end = { -q1.x, -q1.y, -q1.z, -q1.w };
+			dot = -dot;
+		}
+
+		if (dot > kSlerpThreshold) {
+			return Nlerp(q0, end, t);
+		}
+
+		const float theta = std::acos(dot);
+		const float inverseSin = 1.0f / std::sin(theta);
+		const float scale0 = std::sin((1.0f - t) * theta) * inverseSin;
+		const float scale1 = std::sin(t * theta) * inverseSin;
+		return {
+			scale0 * q0.x + scale1 * end.x,
+			scale0 * q0.y + scale1 * end.y,
+			scale0 * q0.z + scale1 * end.z,
+			scale0 * q0.w + scale1 * end.w
+		};
+	}
+
+	Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t)
+	{
+		// 内積が負なら片方を反転して短い方の経路を通る
+		const float sign = (Dot(q0, q1) < 0.0f) ? -1.0f : 1.0f;
+		const float scale0 = 1.0f - t;
+		const float scale1 = t * sign;
+		return Normalize(Quaternion{
+			scale0 * q0.x + scale1 * q1.x,
+			scale0 * q0.y + scale1 * q1.y,
+			scale0 * q0.z + scale1 * q1.z,
+			scale0 * q0.w + scale1 * q1.w
+			});
+	}
+
+	float AngleBetween(const Quaternion& q0, const Quaternion& q1)
+	{
+		// q と -q は同じ回転なので内積の絶対値を使う
+		const float dot = std::clamp(std::fabs(Dot(q0, q1)), 0.0f, 1.0f);
+		return 2.0f * std::acos(dot);
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "Affine3x4.h"
+#include "Matrix4x4.h"
+#include "Vector3.h"
+
+// クォータニオン構造体（x, y, z が虚部、w が実部。Vector4 と同じ並びで 16 バイト）
+struct Quaternion {
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+// クォータニオンの関数
+// 回転の合成順：Multiply(q1, q2) は「q2 を適用してから q1 を適用する」回転（ハミルトン積）
+// 行列にすると MakeRotateMatrix(Multiply(q1, q2)) == MakeRotateMatrix(q2) * MakeRotateMatrix(q1)（行ベクトル規約）
+namespace Math
+{
+	// 単位クォータニオン（無回転）
+	Quaternion IdentityQuaternion();
+
+	// 積・共役・ノルム・正規化・逆・内積
+	Quaternion Multiply(const Quaternion& q1, const Quaternion& q2);
+	Quaternion Conjugate(const Quaternion& q);
+	float Norm(const Quaternion& q);
+	Quaternion Normalize(const Quaternion& q);
+	Quaternion Inverse(const Quaternion& q);
+	float Dot(const Quaternion& q1, const Quaternion& q2);
+
+	// 任意軸回転（axis は正規化済みであること）
+	Quaternion MakeRotateAxisAngleQuaternion(const Vector3& axis, float angle);
+
+	// オイラー角（X → Y → Z の順に回転。MakeRotateXYZMatrix と同じ回転）との変換
+	Quaternion MakeRotateXYZQuaternion(const Vector3& rotate);
+	Vector3 ToEulerXYZ(const Quaternion& q);
+
+	// ベクトルの回転
+	Vector3 RotateVector(const Vector3& vector, const Quaternion& q);
+
+	// 回転行列への変換（q は正規化済みであること）
+	Matrix4x4 MakeRotateMatrix(const Quaternion& q);
+
+	// スケール・回転・平行移動からアフィン行列を作成（三角関数を使わない）
+	Affine3x4 MakeAffine3x4(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+	Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+
+	// 球面線形補間（最短経路。ほぼ同じ向きのときは Nlerp で代用する）
+	Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+	// 正規化線形補間（最短経路。角速度は一定にならないが Slerp より軽い）
+	Quaternion Nlerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+	// 2 つの回転の間の角度（ラジアン）
+	float AngleBetween(const Quaternion& q0, const Quaternion& q1);
+}
@@ -1,5 +1,5 @@
 #pragma once
-#include <corecrt_math.h>
+#include <cmath>
 #include <Vector4.h>
 #include <Matrix4x4.h>
 #include <Multiply.h>
@@ -16,17 +16,61 @@ namespace MyEngine {
 		const std::string kExtension = ".json";
 	}
 
-	LevelData* JsonLoader::Load(const std::string& fileName)
+	std::unordered_map<std::string, nlohmann::json> JsonLoader::jsonCache_;
+
+	nlohmann::json JsonLoader::DecodeJson(const std::string& fileName)
+	{
+		const std::string fullpath = kDefaultBaseDirectory + fileName + kExtension;
+
+		std::ifstream file(fullpath);
+		assert(!file.fail() && "JSONファイルを開けませんでした");
+
+		nlohmann::json deserialized;
+		file >> deserialized;
+		return deserialized;
+	}
+
+	void JsonLoader::RegisterJson(const std::string& fileName, nlohmann::json json)
 	{
+		jsonCache_.try_emplace(fileName, std::move(json));
+	}
+
+	void JsonLoader::UnloadJson(const std::string& fileName)
+	{
+		jsonCache_.erase(fileName);
+	}
+
+	bool JsonLoader::IsJsonLoaded(const std::string& fileName)
+	{
+		return jsonCache_.contains(fileName);
+	}
+
+	bool JsonLoader::ReadJson(const std::string& fileName, nlohmann::json& out)
+	{
+		// AssetLoader で先読み済みならパースを省略する
+		auto it = jsonCache_.find(fileName);
+		if (it != jsonCache_.end()) {
+			out = it->second;
+			return true;
+		}
+
 		const std::string fullpath = kDefaultBaseDirectory + fileName + kExtension;
 
 		std::ifstream file(fullpath);
 		if (file.fail()) {
-			assert(!"ファイルを開けませんでした");
+			return false;
 		}
 
+		file >> out;
+		return true;
+	}
+
+	LevelData* JsonLoader::Load(const std::string& fileName)
+	{
 		nlohmann::json deserialized;
-		file >> deserialized;
+		if (!ReadJson(fileName, deserialized)) {
+			assert(!"ファイルを開けませんでした");
+		}
 
 		assert(deserialized.is_object());
 		assert(deserialized.contains("name"));
@@ -209,17 +253,12 @@ namespace MyEngine {
 
 	EnemyParameters JsonLoader::LoadEnemyParameters(const std::string& fileName)
 	{
-		const std::string fullpath = kDefaultBaseDirectory + fileName + kExtension;
-
-		std::ifstream file(fullpath);
-		if (file.fail()) {
+		nlohmann::json deserialized;
+		if (!ReadJson(fileName, deserialized)) {
 			// ファイルが開けない場合はデフォルト値を返す
 			return EnemyParameters();
 		}
 
-		nlohmann::json deserialized;
-		file >> deserialized;
-
 		EnemyParameters params;
 
 		// 基本パラメータ
@@ -286,17 +325,12 @@ namespace MyEngine {
 
 	EnemyAttackParameters JsonLoader::LoadEnemyAttackParameters(const std::string& fileName)
 	{
-		const std::string fullpath = kDefaultBaseDirectory + fileName + kExtension;
-
-		std::ifstream file(fullpath);
-		if (file.fail()) {
+		nlohmann::json deserialized;
+		if (!ReadJson(fileName, deserialized)) {
 			// ファイルが開けない場合はデフォルト値を返す
 			return EnemyAttackParameters();
 		}
 
-		nlohmann::json deserialized;
-		file >> deserialized;
-
 		EnemyAttackParameters params;
 
 		// Pattern1: 扇形
@@ -377,17 +411,12 @@ namespace MyEngine {
 
 	EnemyBulletParameters JsonLoader::LoadEnemyBulletParameters(const std::string& fileName)
 	{
-		const std::string fullpath = kDefaultBaseDirectory + fileName + kExtension;
-
-		std::ifstream file(fullpath);
-		if (file.fail()) {
+		nlohmann::json deserialized;
+		if (!ReadJson(fileName, deserialized)) {
 			// ファイルが開けない場合はデフォルト値を返す
 			return EnemyBulletParameters();
 		}
 
-		nlohmann::json deserialized;
-		file >> deserialized;
-
 		EnemyBulletParameters params;
 
 		// 生存フレーム数
@@ -424,17 +453,12 @@ namespace MyEngine {
 
 	PlayerParameters JsonLoader::LoadPlayerParameters(const std::string& fileName)
 	{
-		const std::string fullpath = kDefaultBaseDirectory + fileName + kExtension;
-
-		std::ifstream file(fullpath);
-		if (file.fail()) {
+		nlohmann::json deserialized;
+		if (!ReadJson(fileName, deserialized)) {
 			// ファイルが開けない場合はデフォルト値を返す
 			return PlayerParameters();
 		}
 
-		nlohmann::json deserialized;
-		file >> deserialized;
-
 		PlayerParameters params;
 
 		// 基本パラメータ
@@ -513,17 +537,12 @@ namespace MyEngine {
 
 	PlayerBulletParameters JsonLoader::LoadPlayerBulletParameters(const std::string& fileName)
 	{
-		const std::string fullpath = kDefaultBaseDirectory + fileName + kExtension;
-
-		std::ifstream file(fullpath);
-		if (file.fail()) {
+		nlohmann::json deserialized;
+		if (!ReadJson(fileName, deserialized)) {
 			// ファイルが開けない場合はデフォルト値を返す
 			return PlayerBulletParameters();
 		}
 
-		nlohmann::json deserialized;
-		file >> deserialized;
-
 		PlayerBulletParameters params;
 
 		// 生存フレーム
@@ -572,17 +591,12 @@ namespace MyEngine {
 
 	PlayerChargeBulletParameters JsonLoader::LoadPlayerChargeBulletParameters(const std::string& fileName)
 	{
-		const std::string fullpath = kDefaultBaseDirectory + fileName + kExtension;
-
-		std::ifstream file(fullpath);
-		if (file.fail()) {
+		nlohmann::json deserialized;
+		if (!ReadJson(fileName, deserialized)) {
 			// ファイルが開けない場合はデフォルト値を返す
 			return PlayerChargeBulletParameters();
 		}
 
-		nlohmann::json deserialized;
-		file >> deserialized;
-
 		PlayerChargeBulletParameters params;
 
 		// チャージ弾専用パラメータ
@@ -637,16 +651,11 @@ namespace MyEngine {
 
 	std::unordered_map<std::string, CurveData> JsonLoader::LoadEnemyCurves(const std::string& fileName)
 	{
-		const std::string fullpath = kDefaultBaseDirectory + fileName + kExtension;
-
-		std::ifstream file(fullpath);
-		if (file.fail()) {
+		nlohmann::json deserialized;
+		if (!ReadJson(fileName, deserialized)) {
 			assert(!"カーブファイルを開けませんでした");
 		}
 
-		nlohmann::json deserialized;
-		file >> deserialized;
-
 		assert(deserialized.is_object());
 		assert(deserialized.contains("objects"));
 		assert(deserialized["objects"].is_array());
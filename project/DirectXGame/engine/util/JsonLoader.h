@@ -76,5 +76,26 @@
 
 		// EnemyMove文字列をEnemyMove列挙型に変換する
 		static EnemyMove ParseEnemyMove(const std::string& move);
+
+		/*------キャッシュ------*/
+
+		// JSONファイルのパース（ファイル読み込みのみ。ワーカースレッドから呼び出し可）
+		static nlohmann::json DecodeJson(const std::string& fileName);
+
+		// パース済みJSONをキャッシュに登録（メインスレッド専用）
+		static void RegisterJson(const std::string& fileName, nlohmann::json json);
+
+		// キャッシュから解放
+		static void UnloadJson(const std::string& fileName);
+
+		// キャッシュ済みか
+		static bool IsJsonLoaded(const std::string& fileName);
+
+	private:
+		// キャッシュがあればそれを、無ければファイルを読み込む（失敗時は false）
+		static bool ReadJson(const std::string& fileName, nlohmann::json& out);
+
+		// 先読み済みJSON（拡張子なしのファイル名をキーとする）
+		static std::unordered_map<std::string, nlohmann::json> jsonCache_;
 	};
 }
\ No newline at end of file
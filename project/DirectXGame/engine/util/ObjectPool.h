@@ -0,0 +1,119 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cassert>
+
+namespace MyEngine {
+
+	/// <summary>
+	/// 型付きオブジェクトプール
+	/// 初期化時にオブジェクトをまとめて生成し、取得・返却で使い回す
+	/// （生成時コールバックでGPUリソースなども事前に確保しておく）
+	/// </summary>
+	template <class T>
+	class ObjectPool
+	{
+	public:
+		/*------型定義------*/
+
+		// 生成時コールバック（リソース確保など）
+		using CreateFunc = std::function<void(T&)>;
+
+		/*------メンバ関数------*/
+
+		// コンストラクタ・デストラクタ
+		ObjectPool() = default;
+		~ObjectPool() = default;
+
+		// コピー禁止（所有するオブジェクトのアドレスを外部が保持するため）
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		// 初期化（capacity個を事前生成）
+		void Initialize(size_t capacity, CreateFunc onCreate = {})
+		{
+			onCreate_ = std::move(onCreate);
+			storage_.reserve(capacity);
+			freeList_.reserve(capacity);
+			Grow(capacity);
+		}
+
+		// 取得（空きが無い場合のみ拡張する）
+		T* Acquire()
+		{
+			if (freeList_.empty()) {
+				// 容量不足：倍に拡張（通常は初期容量で足りるように設定する）
+				Grow(storage_.empty() ? 1 : storage_.size());
+			}
+			T* object = freeList_.back();
+			freeList_.pop_back();
+			return object;
+		}
+
+		// 返却
+		void Release(T* object)
+		{
+			assert(object && "ObjectPool::Release: null object");
+			assert(freeList_.size() < storage_.size() && "ObjectPool::Release: double release");
+			freeList_.push_back(object);
+		}
+
+		/*------ゲッター------*/
+
+		// 総容量
+		size_t GetCapacity() const { return storage_.size(); }
+
+		// 空き数
+		size_t GetFreeCount() const { return freeList_.size(); }
+
+		// 使用中の数
+		size_t GetActiveCount() const { return storage_.size() - freeList_.size(); }
+
+	private:
+		/*------プライベートメンバ関数------*/
+
+		// count個のオブジェクトを生成して空きリストへ積む
+		void Grow(size_t count)
+		{
+			for (size_t i = 0; i < count; ++i) {
+				auto object = std::make_unique<T>();
+				if (onCreate_) {
+					onCreate_(*object);
+				}
+				freeList_.push_back(object.get());
+				storage_.push_back(std::move(object));
+			}
+		}
+
+		/*------メンバ変数------*/
+
+		// 実体（アドレス固定のため個別確保）
+		std::vector<std::unique_ptr<T>> storage_;
+
+		// 空きリスト
+		std::vector<T*> freeList_;
+
+		// 生成時コールバック
+		CreateFunc onCreate_;
+	};
+
+	/// <summary>
+	/// 密配列から条件に合う要素を取り除く（順序は保持しない）
+	/// release には取り除いた要素が渡される
+	/// </summary>
+	template <class T, class Pred, class ReleaseFunc>
+	void EraseUnorderedIf(std::vector<T*>& objects, Pred pred, ReleaseFunc release)
+	{
+		for (size_t i = 0; i < objects.size();) {
+			if (pred(objects[i])) {
+				release(objects[i]);
+				objects[i] = objects.back();
+				objects.pop_back();
+			} else {
+				++i;
+			}
+		}
+	}
+}
@@ -0,0 +1,177 @@
+#include "TransformHierarchy.h"
+#include <JobSystem.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+//
+// TransformHierarchy
+// - WorldTransform は各所有者が Update を呼び、親の matWorld_ を読むため「親を先に更新する」ことを呼び出し側に頼っている。
+//   こちらは変換をまとめて持ち、順序の保証と変更の無いノードの省略をまとめて行う。
+// - 配置：
+//   * ノードは深さ順（深さ 0 → 1 → ...）に連続した配列に並べる。親は必ず子より前にあるので、先頭から 1 回走査するだけで
+//     親の結果を使って子を計算できる。
+//   * ノード番号（Add の戻り値）は変わらず、indices_ で配列上の位置に変換する。並べ直しは追加があった後の Update でだけ行う。
+// - 変更の伝播：
+//   * Set〜 でノードに isDirty を立てる。Update ではローカル行列を作り直し（isDirty のときのみ）、ワールド行列を計算する。
+//   * 親の isWorldChanged が立っている子は、ローカル行列はそのままでワールド行列だけを計算し直す。
+//   * どちらでもないノードは何もしない（静止したレベルのオブジェクトは初回以降ほぼ 0 コスト）。
+// - 並列化：同じ深さのノード同士は互いに依存しないので、ノード数が多い深さは JobSystem::ParallelFor で分割する。
+//   深さごとに完了を待つので、子の計算時には親の深さが全て終わっている。
+//
+namespace MyEngine {
+	using namespace Math;
+	using namespace TransformHierarchyConstants;
+
+	uint32_t TransformHierarchy::Add(const Vector3& scale, const Vector3& rotate, const Vector3& translate, uint32_t parent)
+	{
+		assert((parent == kNoParent || parent < indices_.size()) && "TransformHierarchy: parent is not added yet!");
+
+		Node node{};
+		node.scale = scale;
+		node.rotate = rotate;
+		node.translate = translate;
+		node.parentIndex = (parent == kNoParent) ? kNoParent : indices_[parent];
+		node.id = static_cast<uint32_t>(indices_.size());
+		node.depth = (parent == kNoParent) ? 0 : nodes_[node.parentIndex].depth + 1;
+		node.isDirty = true;
+		node.isWorldChanged = false;
+
+		// 末尾に追加しても親は子より前にあるので、並べ直すまでの間もそのまま使える
+		indices_.push_back(static_cast<uint32_t>(nodes_.size()));
+		nodes_.push_back(node);
+		needsRebuild_ = true;
+		return node.id;
+	}
+
+	void TransformHierarchy::Clear()
+	{
+		nodes_.clear();
+		indices_.clear();
+		depthOffsets_ = { 0 };
+		needsRebuild_ = false;
+		lastUpdatedCount_ = 0;
+	}
+
+	void TransformHierarchy::Update()
+	{
+		if (needsRebuild_) {
+			Rebuild();
+		}
+
+		// JobSystem のスレッド（メインスレッドかジョブの中）からのみ並列に実行できる
+		JobSystem* jobSystem = JobSystem::GetInstance();
+		const bool canRunParallel = jobSystem->GetThreadCount() > 1 &&
+			JobSystem::GetThreadIndex() != JobSystemConstants::kInvalidThreadIndex;
+
+		uint32_t updatedCount = 0;
+		for (size_t depth = 0; depth + 1 < depthOffsets_.size(); ++depth) {
+			const uint32_t begin = depthOffsets_[depth];
+			const uint32_t end = depthOffsets_[depth + 1];
+
+			if (canRunParallel && end - begin >= kParallelThreshold) {
+				std::atomic<uint32_t> updatedInDepth = 0;
+				jobSystem->ParallelFor(end - begin, kGrainSize, [this, begin, &updatedInDepth](uint32_t rangeBegin, uint32_t rangeEnd) {
+					updatedInDepth.fetch_add(UpdateRange(begin + rangeBegin, begin + rangeEnd), std::memory_order_relaxed);
+					});
+				updatedCount += updatedInDepth.load(std::memory_order_relaxed);
+			}
+			else {
+				updatedCount += UpdateRange(begin, end);
+			}
+		}
+		lastUpdatedCount_ = updatedCount;
+	}
+
+	void TransformHierarchy::SetTransform(uint32_t node, const Vector3& scale, const Vector3& rotate, const Vector3& translate)
+	{
+		Node& target = Touch(node);
+		target.scale = scale;
+		target.rotate = rotate;
+		target.translate = translate;
+	}
+
+	void TransformHierarchy::SetScale(uint32_t node, const Vector3& scale)
+	{
+		Touch(node).scale = scale;
+	}
+
+	void TransformHierarchy::SetRotate(uint32_t node, const Vector3& rotate)
+	{
+		Touch(node).rotate = rotate;
+	}
+
+	void TransformHierarchy::SetTranslate(uint32_t node, const Vector3& translate)
+	{
+		Touch(node).translate = translate;
+	}
+
+	// ===== ヘルパー関数 =====
+
+	void TransformHierarchy::Rebuild()
+	{
+		// 深さごとの数を数えて、深さ順に安定に並べ替える（計数ソート）
+		uint32_t depthCount = 0;
+		for (const Node& node : nodes_) {
+			depthCount = (std::max)(depthCount, node.depth + 1);
+		}
+		depthOffsets_.assign(depthCount + 1, 0);
+		for (const Node& node : nodes_) {
+			++depthOffsets_[node.depth + 1];
+		}
+		for (uint32_t depth = 0; depth < depthCount; ++depth) {
+			depthOffsets_[depth + 1] += depthOffsets_[depth];
+		}
+
+		std::vector<uint32_t> cursors(depthOffsets_.begin(), depthOffsets_.end() - 1);
+		std::vector<Node> sorted(nodes_.size());
+		for (const Node& node : nodes_) {
+			const uint32_t newIndex = cursors[node.depth]++;
+			sorted[newIndex] = node;
+			indices_[node.id] = newIndex;
+		}
+
+		// 親の位置を新しい配列上の位置に付け替える
+		for (Node& node : sorted) {
+			if (node.parentIndex != kNoParent) {
+				node.parentIndex = indices_[nodes_[node.parentIndex].id];
+			}
+		}
+
+		nodes_ = std::move(sorted);
+		needsRebuild_ = false;
+	}
+
+	uint32_t TransformHierarchy::UpdateRange(uint32_t begin, uint32_t end)
+	{
+		uint32_t updatedCount = 0;
+		for (uint32_t i = begin; i < end; ++i) {
+			Node& node = nodes_[i];
+			const Node* parent = (node.parentIndex != kNoParent) ? &nodes_[node.parentIndex] : nullptr;
+
+			// 自分も親も変わっていなければ何もしない
+			if (!node.isDirty && !(parent && parent->isWorldChanged)) {
+				node.isWorldChanged = false;
+				continue;
+			}
+
+			// ローカル行列は自分が変わったときだけ作り直す
+			if (node.isDirty) {
+				node.local = MakeAffine3x4(node.scale, node.rotate, node.translate);
+				node.isDirty = false;
+			}
+			node.world = parent ? Multiply(node.local, parent->world) : node.local;
+			node.isWorldChanged = true;
+			++updatedCount;
+		}
+		return updatedCount;
+	}
+
+	TransformHierarchy::Node& TransformHierarchy::Touch(uint32_t node)
+	{
+		assert(node < indices_.size() && "TransformHierarchy: invalid node!");
+		Node& target = nodes_[indices_[node]];
+		target.isDirty = true;
+		return target;
+	}
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <Affine3x4.h>
+#include <Vector3.h>
+#include <cstdint>
+#include <vector>
+
+namespace MyEngine {
+
+	// TransformHierarchy用の定数
+	namespace TransformHierarchyConstants {
+		// 親が無いことを表すノード番号
+		constexpr uint32_t kNoParent = UINT32_MAX;
+
+		// 1 つの階層（深さ）のノード数がこれ以上なら JobSystem で並列に更新する
+		constexpr uint32_t kParallelThreshold = 512;
+
+		// 並列に更新するときの 1 ジョブあたりのノード数
+		constexpr uint32_t kGrainSize = 128;
+	}
+
+	/// <summary>
+	/// 親子関係を持つ変換をまとめて管理し、変わったものだけを 1 回の走査で更新する
+	/// ノードは深さ順（親が必ず子より前）に連続した配列に並べ、深さごとに並列に更新できる
+	/// 所有者のスレッドからのみ操作すること（内部で JobSystem を使うのは Update の間だけ）
+	/// </summary>
+	class TransformHierarchy
+	{
+	public:
+		/*------メンバ関数------*/
+
+		// ノードの追加（parent は追加済みのノード番号か kNoParent。戻り値はノード番号で、以後変わらない）
+		uint32_t Add(const Vector3& scale, const Vector3& rotate, const Vector3& translate,
+			uint32_t parent = TransformHierarchyConstants::kNoParent);
+
+		// 全ノードの削除
+		void Clear();
+
+		// 更新（変更されたノードと、その子孫のワールド行列だけを計算し直す）
+		void Update();
+
+		// 状態設定（変更したノードは次の Update で計算し直す）
+		void SetTransform(uint32_t node, const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+		void SetScale(uint32_t node, const Vector3& scale);
+		void SetRotate(uint32_t node, const Vector3& rotate);
+		void SetTranslate(uint32_t node, const Vector3& translate);
+
+		/*------ゲッター------*/
+
+		const Vector3& GetScale(uint32_t node) const { return nodes_[indices_[node]].scale; }
+		const Vector3& GetRotate(uint32_t node) const { return nodes_[indices_[node]].rotate; }
+		const Vector3& GetTranslate(uint32_t node) const { return nodes_[indices_[node]].translate; }
+		const Affine3x4& GetWorldMatrix(uint32_t node) const { return nodes_[indices_[node]].world; }
+		// 直前の Update でワールド行列が変わったか
+		bool IsWorldChanged(uint32_t node) const { return nodes_[indices_[node]].isWorldChanged; }
+
+		uint32_t GetNodeCount() const { return static_cast<uint32_t>(nodes_.size()); }
+		// 階層の深さの数（親の無いノードだけなら 1）
+		uint32_t GetDepthCount() const { return static_cast<uint32_t>(depthOffsets_.size()) - 1; }
+		// 直前の Update で計算し直したノード数
+		uint32_t GetLastUpdatedCount() const { return lastUpdatedCount_; }
+
+	private:
+		/*------構造体------*/
+
+		// ノード 1 つ分のデータ（Update で先頭から順に読むため 1 つにまとめる）
+		struct Node {
+			Vector3 scale;
+			Vector3 rotate;
+			Vector3 translate;
+			// 親の配列上の位置（kNoParent なら親無し）
+			uint32_t parentIndex;
+			// ノード番号と深さ
+			uint32_t id;
+			uint32_t depth;
+			// scale / rotate / translate が変わったか・直前の Update でワールド行列が変わったか
+			bool isDirty;
+			bool isWorldChanged;
+			// ローカル行列（isDirty のときだけ作り直す）とワールド行列
+			Affine3x4 local;
+			Affine3x4 world;
+		};
+
+		/*------プライベートメンバ関数------*/
+
+		// ノードを深さ順に並べ直す（追加があったときだけ）
+		void Rebuild();
+
+		// 配列の [begin, end) のノードを更新する（戻り値は計算し直したノード数）
+		uint32_t UpdateRange(uint32_t begin, uint32_t end);
+
+		// ノードの変更を記録する
+		Node& Touch(uint32_t node);
+
+		/*------メンバ変数------*/
+
+		// 深さ順に並べたノード
+		std::vector<Node> nodes_;
+
+		// ノード番号から配列上の位置への変換
+		std::vector<uint32_t> indices_;
+
+		// 深さ d のノードは nodes_[depthOffsets_[d], depthOffsets_[d + 1])
+		std::vector<uint32_t> depthOffsets_ = { 0 };
+
+		// 追加後にまだ並べ直していないか
+		bool needsRebuild_ = false;
+
+		// 統計
+		uint32_t lastUpdatedCount_ = 0;
+	};
+}
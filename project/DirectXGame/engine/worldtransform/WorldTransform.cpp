@@ -2,8 +2,6 @@
 #include <Object3dCommon.h>
 #include <Object3d.h>
 #include <MakeIdentity4x4.h>
-#include <MakeAffineMatrix.h>
-#include <Inverse.h>
 #include <ResourceManager.h>
 
 namespace MyEngine {
@@ -21,37 +19,71 @@ namespace MyEngine {
 		// WVP用のリソースの設定
 		wvpResource_->Map(0, nullptr, reinterpret_cast<void**>(&wvpData_));
 		// 単位行列
-		wvpData_->WVP = MakeIdentity4x4();
+		matrices_.WVP = MakeIdentity4x4();
 		// ワールド行列
-		wvpData_->World = MakeIdentity4x4();
+		matrices_.World = MakeIdentity4x4();
 		// ワールド逆行列の転置
-		wvpData_->WorldInversedTranspose = MakeIdentity4x4();
+		matrices_.WorldInversedTranspose = MakeIdentity4x4();
+		*wvpData_ = matrices_;
+
+		// 次の Update で必ず書き込む
+		isDirty_ = true;
+		cameraVersion_ = 0;
 	}
 
 	void WorldTransform::Update()
 	{
-		Matrix4x4 worldMatrix = MakeAffineMatrix(scale_, rotate_, translate_);
-		Matrix4x4 worldViewProjectionMatrix;
-
-		// 親オブジェクトがあれば親のワールド行列を掛ける
-		if (parent_)
+		// 自分か親が変わったときだけワールド行列を作り直す（静止したオブジェクトは行列の積も行わない）
+		const bool isParentChanged = parent_ && parent_->worldVersion_ != parentWorldVersion_;
+		if (isDirty_ || isParentChanged)
 		{
-			worldMatrix = Multiply(worldMatrix, parent_->matWorld_);
+			matWorld_ = MakeAffine3x4(scale_, rotation_, translate_);
+
+			// 親オブジェクトがあれば親のワールド行列を掛ける
+			if (parent_)
+			{
+				matWorld_ = Multiply(matWorld_, parent_->matWorld_);
+				parentWorldVersion_ = parent_->worldVersion_;
+			}
+
+			isDirty_ = false;
+			isWorldPending_ = true;
+			++worldVersion_;
 		}
 
-		if (camera_)
+		// WVP はワールド行列かカメラが変わったときだけ書き込む
+		const uint32_t cameraVersion = camera_ ? camera_->GetViewProjectionVersion() : 0;
+		if (isWorldPending_ || cameraVersion != cameraVersion_)
 		{
-			const Matrix4x4& viewProjectionMatrix = camera_->GetViewProjectionMatrix();
-			worldViewProjectionMatrix = Multiply(worldMatrix, viewProjectionMatrix);
+			if (camera_)
+			{
+				matrices_.WVP = Multiply(matWorld_, camera_->GetViewProjectionMatrix());
+			}
+			else
+			{
+				matrices_.WVP = ToMatrix4x4(matWorld_);
+			}
+			wvpData_->WVP = matrices_.WVP;
+			cameraVersion_ = cameraVersion;
 		}
-		else
+
+		// GPU に送るときだけ 4x4 に変換する（法線はシェーダーで左上 3x3 のみ使う）
+		if (isWorldPending_)
 		{
-			worldViewProjectionMatrix = worldMatrix;
+			matrices_.World = ToMatrix4x4(matWorld_);
+			matrices_.WorldInversedTranspose = MakeNormalMatrix(matWorld_);
+			wvpData_->World = matrices_.World;
+			wvpData_->WorldInversedTranspose = matrices_.WorldInversedTranspose;
+			isWorldPending_ = false;
 		}
+	}
 
-		wvpData_->WVP = worldViewProjectionMatrix;
-		wvpData_->World = worldMatrix;
-		wvpData_->WorldInversedTranspose = Matrix4x4::Transpose(Inverse(worldMatrix));
+	void WorldTransform::SetWorldMatrix(const Affine3x4& world)
+	{
+		matWorld_ = world;
+		isDirty_ = false;
+		isWorldPending_ = true;
+		++worldVersion_;
 	}
 
 	void WorldTransform::SetPipeline()
@@ -1,6 +1,9 @@
 #pragma once
 #include <Matrix4x4.h>
+#include <Affine3x4.h>
+#include <Quaternion.h>
 #include <Vector3.h>
+#include <cstdint>
 #include <wrl.h> // Microsoft::WRL::ComPtrを使用するためのヘッダーファイル
 #include <d3d12.h>
 
@@ -25,7 +28,7 @@ namespace MyEngine {
 		// 初期化
 		void Initialize();
 
-		// 更新
+		// 更新（scale / rotate / translate・親・カメラのどれかが変わったときだけ行列を作り直して GPU に書き込む）
 		void Update();
 
 		// パイプラインの設定
@@ -34,21 +37,40 @@ namespace MyEngine {
 		// 状態設定（OAOO：同じ処理の使い回し） - ヘッダーにインライン定義
 		void SetTransform(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
 			scale_ = scale;
-			rotate_ = rotate;
+			SetRotate(rotate);
 			translate_ = translate;
 		}
-		void SetScale(const Vector3& scale) { scale_ = scale; }
-		void SetRotate(const Vector3& rotate) { rotate_ = rotate; }
-		void SetTranslate(const Vector3& translate) { translate_ = translate; }
+		void SetScale(const Vector3& scale) { scale_ = scale; isDirty_ = true; }
+		// 回転はクォータニオンで持つ（オイラー角はここで 1 度だけ変換し、Update では三角関数を使わない）
+		void SetRotate(const Vector3& rotate) {
+			rotate_ = rotate;
+			rotation_ = Math::MakeRotateXYZQuaternion(rotate);
+			isDirty_ = true;
+		}
+		void SetRotation(const Quaternion& rotation) {
+			rotation_ = Math::Normalize(rotation);
+			rotate_ = Math::ToEulerXYZ(rotation_);
+			isDirty_ = true;
+		}
+		void SetTranslate(const Vector3& translate) { translate_ = translate; isDirty_ = true; }
+
+		// ワールド行列を直接設定する（TransformHierarchy でまとめて計算した行列用）
+		// 次の Update では scale / rotate / translate から作り直さず、この行列を GPU に書き込む
+		void SetWorldMatrix(const Affine3x4& world);
 
 		// 取得（コピー回避のためconst参照を返す） - ヘッダーにインライン定義
 		const Vector3& GetScale() const { return scale_; }
 		const Vector3& GetRotate() const { return rotate_; }
+		const Quaternion& GetRotation() const { return rotation_; }
 		const Vector3& GetTranslate() const { return translate_; }
-		const Matrix4x4& GetMatWorld() const { return matWorld_; }
+		const Affine3x4& GetAffineMatWorld() const { return matWorld_; }
+		// 4x4 に変換して返す（親子の合成などには GetAffineMatWorld を使う）
+		Matrix4x4 GetMatWorld() const { return Math::ToMatrix4x4(matWorld_); }
+		// GPU に書き込んだものと同じ変換行列（インスタンシング描画でまとめて書き込むときに使う）
+		const TransformationMatrix& GetTransformationMatrix() const { return matrices_; }
 
 		// 親の設定・取得
-		void SetParent(const WorldTransform* parent) { parent_ = parent; }
+		void SetParent(const WorldTransform* parent) { parent_ = parent; isDirty_ = true; }
 		const WorldTransform* GetParent() const { return parent_; }
 
 	private:
@@ -57,21 +79,34 @@ namespace MyEngine {
 		// スケール
 		Vector3 scale_ = { 1.0f, 1.0f, 1.0f };
 
-		// 回転
+		// 回転（オイラー角は取得用。行列はクォータニオンから作る）
 		Vector3 rotate_ = { 0.0f, 0.0f, 0.0f };
+		Quaternion rotation_ = Math::IdentityQuaternion();
 
 		// 移動
 		Vector3 translate_ = { 0.0f, 0.0f, 0.0f };
 
-		// ワールド変換行列
-		Matrix4x4 matWorld_;
+		// ワールド変換行列（アフィン行列のまま保持し、GPU に送るときだけ 4x4 にする）
+		Affine3x4 matWorld_ = Math::MakeIdentityAffine3x4();
 
 		// 親となるワールド変換
 		const WorldTransform* parent_ = nullptr;
 
+		// 変更の追跡
+		// scale / rotate / translate・親が変わったか
+		bool isDirty_ = true;
+		// matWorld_ を GPU にまだ書き込んでいないか
+		bool isWorldPending_ = true;
+		// matWorld_ が変わるたびに進む番号と、前回の Update で見た親・カメラの番号
+		uint32_t worldVersion_ = 0;
+		uint32_t parentWorldVersion_ = 0;
+		uint32_t cameraVersion_ = 0;
+
 		Camera* camera_ = nullptr; // カメラ
 
 		TransformationMatrix* wvpData_ = nullptr; // 変換行列
+		// wvpData_ の CPU 側の写し（wvpData_ は書き込み結合のメモリなので読み出しはこちらから行う）
+		TransformationMatrix matrices_{};
 
 		Microsoft::WRL::ComPtr<ID3D12Resource> wvpResource_ = nullptr; // ワールドビュー射影行列バッファ
 	};
@@ -0,0 +1,58 @@
+# externals/DirectXTex の CPU 側（読み込み・ミップ生成・BCn 圧縮・DDS 保存）だけを静的ライブラリ DirectXTexCore にする
+# （project/tests のテクスチャのベンチマークと project/tools/TextureBaker が使う）
+#   Windows : Windows SDK の DirectXMath / d3d12 と WIC を使う
+#   その他  : DirectXMath と DirectX-Headers（directx/dxgiformat.h, wsl/winadapter.h）が必要。WIC は無い
+#             （-DDIRECTXMATH_INCLUDE_DIR=... -DDIRECTX_HEADERS_INCLUDE_DIR=... で場所を指定できる）
+# 見つかれば GE3_HAS_DIRECTXTEX を ON にする
+if(TARGET DirectXTexCore)
+	return()
+endif()
+
+set(GE3_DIRECTXTEX_DIR ${CMAKE_CURRENT_LIST_DIR}/../../externals/DirectXTex)
+set(GE3_HAS_DIRECTXTEX OFF)
+
+set(GE3_DIRECTXTEX_SOURCES
+	${GE3_DIRECTXTEX_DIR}/BC.cpp
+	${GE3_DIRECTXTEX_DIR}/BC4BC5.cpp
+	${GE3_DIRECTXTEX_DIR}/BC6HBC7.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexCompress.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexConvert.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexDDS.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexHDR.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexImage.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexMipmaps.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexMisc.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexNormalMaps.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexPMAlpha.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexResize.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexTGA.cpp
+	${GE3_DIRECTXTEX_DIR}/DirectXTexUtil.cpp
+)
+
+if(WIN32)
+	# WIC を使うもの（PNG などの読み込み、回転・反転）
+	list(APPEND GE3_DIRECTXTEX_SOURCES
+		${GE3_DIRECTXTEX_DIR}/DirectXTexFlipRotate.cpp
+		${GE3_DIRECTXTEX_DIR}/DirectXTexWIC.cpp
+	)
+	add_library(DirectXTexCore STATIC ${GE3_DIRECTXTEX_SOURCES})
+	target_include_directories(DirectXTexCore PUBLIC ${GE3_DIRECTXTEX_DIR})
+	target_compile_definitions(DirectXTexCore PUBLIC _UNICODE UNICODE _WIN32_WINNT=0x0A00)
+	target_link_libraries(DirectXTexCore PUBLIC ole32 windowscodecs uuid)
+	set(GE3_HAS_DIRECTXTEX ON)
+else()
+	find_path(DIRECTXMATH_INCLUDE_DIR DirectXMath.h PATH_SUFFIXES directxmath)
+	find_path(DIRECTX_HEADERS_INCLUDE_DIR directx/dxgiformat.h)
+	if(DIRECTXMATH_INCLUDE_DIR AND DIRECTX_HEADERS_INCLUDE_DIR)
+		add_library(DirectXTexCore STATIC ${GE3_DIRECTXTEX_SOURCES})
+		target_include_directories(DirectXTexCore PUBLIC
+			${GE3_DIRECTXTEX_DIR}
+			${DIRECTXMATH_INCLUDE_DIR}
+			${DIRECTX_HEADERS_INCLUDE_DIR}
+			${DIRECTX_HEADERS_INCLUDE_DIR}/wsl/stubs
+		)
+		set(GE3_HAS_DIRECTXTEX ON)
+	else()
+		message(STATUS "DirectXMath / DirectX-Headers not found: DirectXTex targets are skipped")
+	endif()
+endif()
@@ -1,10 +1,73 @@
 #include "MyGame.h"
 #include "SRFramework.h"
+#include "TextureBaker.h"
+#include "FrameTaskGraph.h"
+#include "MemoryReport.h"
+#include "Audio.h"
 #include <memory>
+#include <sstream>
 // Windowsアプリでのエントリーポイント(main関数)
-int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int) {
+	// "--bake-textures [ディレクトリ]" で起動された場合はテクスチャのベイクだけ行って終了する（project/tools/TextureBaker と同じ処理）
+	const std::string commandLine = lpCmdLine;
+	if (commandLine.starts_with(TextureBakerConstants::kBakeCommand)) {
+		std::string sourceDirectory = commandLine.substr(std::char_traits<char>::length(TextureBakerConstants::kBakeCommand));
+		sourceDirectory.erase(0, sourceDirectory.find_first_not_of(' '));
+		if (sourceDirectory.empty()) {
+			sourceDirectory = TextureBakerConstants::kDefaultSourceDirectory;
+		}
+
+		// WIC 用に COM を初期化
+		CoInitializeEx(0, COINIT_MULTITHREADED);
+		TextureBaker::BakeDirectory(sourceDirectory);
+		CoUninitialize();
+		return 0;
+	}
+
+	// "--render-audio 出力.wav 入力.wav ..." で起動された場合は入力を同時に鳴らしてソフトウェアミキサーで合成し、WAV に書き出して終了する
+	// （ウィンドウも XAudio2 も作らない。パスは空白で区切る）
+	if (commandLine.starts_with(AudioConstants::kRenderCommand)) {
+		std::istringstream arguments(commandLine.substr(std::char_traits<char>::length(AudioConstants::kRenderCommand)));
+		std::string outputPath;
+		std::vector<std::string> inputPaths;
+		arguments >> outputPath;
+		for (std::string inputPath; arguments >> inputPath;) {
+			inputPaths.push_back(inputPath);
+		}
+		if (outputPath.empty() || inputPaths.empty()) {
+			return 1;
+		}
+		return Audio::RenderToWaveFile(outputPath, inputPaths) ? 0 : 1;
+	}
+
+	// "--dump-frame-graph [ファイル名]" で起動された場合はゲームプレイの更新タスクグラフとクリティカルパスを書き出して終了する
+	// （ウィンドウも D3D も作らない。タスクは実行しないため、クリティカルパスはタスク数で数えたもの）
+	if (commandLine.starts_with(FrameTaskGraphConstants::kDumpCommand)) {
+		std::string filePath = commandLine.substr(std::char_traits<char>::length(FrameTaskGraphConstants::kDumpCommand));
+		filePath.erase(0, filePath.find_first_not_of(' '));
+		if (filePath.empty()) {
+			filePath = FrameTaskGraphConstants::kDefaultDumpFilePath;
+		}
+
+		GamePlayScene scene;
+		FrameTaskGraph graph;
+		scene.BuildUpdateGraph(graph);
+		graph.Compile();
+		return graph.WriteDump(filePath) ? 0 : 1;
+	}
+
 	std::unique_ptr<SRFramework> game = std::make_unique<MyGame>();
 
+	// "--dump-memory-stats [ファイル名]" で起動された場合は通常通り実行し、終了時にサブシステム別のメモリ統計を JSON で書き出す
+	if (commandLine.starts_with(MemoryReportConstants::kDumpCommand)) {
+		std::string filePath = commandLine.substr(std::char_traits<char>::length(MemoryReportConstants::kDumpCommand));
+		filePath.erase(0, filePath.find_first_not_of(' '));
+		if (filePath.empty()) {
+			filePath = MemoryReportConstants::kDefaultDumpFilePath;
+		}
+		game->SetMemoryStatsDumpPath(filePath);
+	}
+
 	game->Run();
 
 	return 0;
@@ -21,11 +21,6 @@ struct TransformationMatrix
     float32_t4x4 World;
 };
 
-struct Camera
-{
-    float32_t3 worldPosition;
-};
-
 struct PointLight
 {
     float32_t4 color; // ライトの色
@@ -33,6 +28,7 @@ struct PointLight
     float intensity; // 輝度
     float radius; // ライトの届く最大距離
     float decay; // 減衰率
+    float32_t2 padding;
 };
 
 struct SpotLight
@@ -41,10 +37,55 @@ struct SpotLight
     float32_t3 position; // ライトの位置
     float32_t intensity; // 輝度
     float32_t3 direction; // ライトの向き
-    float32_t distance; // ライトの届く最大距離
-    float32_t decay; // 減衰率
     float32_t cosAngle; // スポットライトの角度
     float32_t cosFalloffStart; // 開始角度
+    float32_t distance; // ライトの届く最大距離
+    float32_t decay; // 減衰率
+    float32_t padding;
+};
+
+// オブジェクトごとのライトの輝度の上書き（負の値ならシーンの輝度を使う）
+struct LightOverride
+{
+    float32_t directionalIntensity;
+    float32_t pointIntensity;
+    float32_t spotIntensity;
+    float32_t padding;
+};
+
+#define MAX_LIGHT_OVERRIDE_COUNT 16 // LightManagerConstants::kMaxLightOverrideCount と合わせる
+
+// クラスタの分割数（LightClusterConstants と合わせる）
+#define CLUSTER_COUNT_X 16
+#define CLUSTER_COUNT_Y 9
+#define CLUSTER_COUNT_Z 24
+
+// クラスタ 1 つ分（gClusterLightIndices の offset から点光源 pointCount 個、続けてスポットライト spotCount 個）
+struct LightCluster
+{
+    uint32_t offset;
+    uint32_t pointCount;
+    uint32_t spotCount;
+};
+
+// シーン共通のライトとカメラ（LightManager が 1 フレームに 1 回書き込む）
+struct FrameLighting
+{
+    float32_t3 cameraWorldPosition;
+    float32_t padding;
+    DirectionalLight directionalLight;
+    PointLight pointLight;
+    SpotLight spotLight;
+    LightOverride overrides[MAX_LIGHT_OVERRIDE_COUNT];
+    float32_t4 clusterDepthAxis; // ビュー空間の z = dot(float4(ワールド座標, 1), clusterDepthAxis)
+    float32_t2 clusterTileScale; // ピクセル座標からタイルの番号への倍率
+    float32_t clusterZScale; // スライス = log(z) * clusterZScale + clusterZBias
+    float32_t clusterZBias;
+};
+
+struct LightOverrideIndex
+{
+    uint32_t index;
 };
 
 ConstantBuffer<Material> gMaterial : register(b0);
@@ -52,10 +93,37 @@ Texture2D<float32_t4> gTexture : register(t0);
 SamplerState gSampler : register(s0);
 TextureCube<float32_t4> gEnvironmentTexture : register(t1); // 環境マッピング用のキューブマップ
 
-ConstantBuffer<DirectionalLight> gDirectionalLight : register(b1);
-ConstantBuffer<Camera> gCamera : register(b2);
-ConstantBuffer<PointLight> gPointLight : register(b3);
-ConstantBuffer<SpotLight> gSpotLight : register(b4);
+ConstantBuffer<FrameLighting> gFrameLighting : register(b1);
+ConstantBuffer<LightOverrideIndex> gLightOverrideIndex : register(b2);
+
+// 爆発などで一時的に足すライト（LightManager がクラスタに分類する）
+StructuredBuffer<PointLight> gClusterPointLights : register(t2);
+StructuredBuffer<SpotLight> gClusterSpotLights : register(t3);
+StructuredBuffer<LightCluster> gClusters : register(t4);
+StructuredBuffer<uint32_t> gClusterLightIndices : register(t5);
+
+// 上書きがあればその輝度、無ければシーンの輝度
+float ResolveIntensity(float overrideIntensity, float sceneIntensity)
+{
+    return overrideIntensity >= 0.0f ? overrideIntensity : sceneIntensity;
+}
+
+// 届く距離で 0 になるように減衰を掛ける窓（クラスタは届く距離の球で分類しているので、その外で光らないようにする）
+float RangeWindow(float distance, float range)
+{
+    float ratio = distance / max(range, 0.0001f);
+    float window = saturate(1.0f - ratio * ratio * ratio * ratio);
+    return window * window;
+}
+
+// ピクセルのクラスタの番号
+uint32_t GetClusterIndex(float32_t2 pixelPosition, float32_t3 worldPosition)
+{
+    uint32_t2 tile = min(uint32_t2(pixelPosition * gFrameLighting.clusterTileScale), uint32_t2(CLUSTER_COUNT_X - 1, CLUSTER_COUNT_Y - 1));
+    float viewZ = dot(float32_t4(worldPosition, 1.0f), gFrameLighting.clusterDepthAxis);
+    uint32_t slice = uint32_t(clamp(floor(log(max(viewZ, 0.0001f)) * gFrameLighting.clusterZScale + gFrameLighting.clusterZBias), 0.0f, CLUSTER_COUNT_Z - 1));
+    return (slice * CLUSTER_COUNT_Y + tile.y) * CLUSTER_COUNT_X + tile.x;
+}
 struct PixelShaderOutput {
     float32_t4 color : SV_TARGET0;
 };
@@ -71,13 +139,22 @@ PixelShaderOutput main(VertexShaderOutput input){
      // 照明効果の統合
     if (gMaterial.enableLighting != 0)
     {
+        // シーンのライトにこのオブジェクトの輝度の上書きを反映する
+        LightOverride lightOverride = gFrameLighting.overrides[gLightOverrideIndex.index];
+        DirectionalLight directionalLight = gFrameLighting.directionalLight;
+        PointLight pointLight = gFrameLighting.pointLight;
+        SpotLight spotLight = gFrameLighting.spotLight;
+        directionalLight.intensity = ResolveIntensity(lightOverride.directionalIntensity, directionalLight.intensity);
+        pointLight.intensity = ResolveIntensity(lightOverride.pointIntensity, pointLight.intensity);
+        spotLight.intensity = ResolveIntensity(lightOverride.spotIntensity, spotLight.intensity);
+
         // ライト方向と法線、カメラ方向の計算
-        float32_t3 lightDir = normalize(gDirectionalLight.direction); // ライト方向（逆方向）  
+        float32_t3 lightDir = normalize(directionalLight.direction); // ライト方向（逆方向）  
         float32_t3 normal = normalize(input.normal); // 法線の正規化
-        float32_t3 viewDir = normalize(gCamera.worldPosition - input.worldPosition); // 視線方向（カメラ方向）
+        float32_t3 viewDir = normalize(gFrameLighting.cameraWorldPosition - input.worldPosition); // 視線方向（カメラ方向）
 
         // 環境光（Ambient）
-        float32_t3 ambientColor = gMaterial.color.rgb * gDirectionalLight.color.rgb * gDirectionalLight.intensity * 0.1f; // 環境光を少し抑える
+        float32_t3 ambientColor = gMaterial.color.rgb * directionalLight.color.rgb * directionalLight.intensity * 0.1f; // 環境光を少し抑える
     
         /*------平行光源------*/
     
@@ -86,27 +163,27 @@ PixelShaderOutput main(VertexShaderOutput input){
         float halfLambertFactor = saturate(pow(NdotL * 0.5f + 0.5f, 2.0f)); // ハーフランバート反射
     
         // 平行光源の拡散反射（Diffuse）
-        float32_t3 diffuseColor = gMaterial.color.rgb * textureColor.rgb * gDirectionalLight.color.rgb * gDirectionalLight.intensity * halfLambertFactor;
+        float32_t3 diffuseColor = gMaterial.color.rgb * textureColor.rgb * directionalLight.color.rgb * directionalLight.intensity * halfLambertFactor;
 
         // 平行光源の鏡面反射（Specular）
         float32_t3 specularColor = float32_t3(0.0f, 0.0f, 0.0f);
-        if (gDirectionalLight.intensity > 0.0f && NdotL > 0.0f)
+        if (directionalLight.intensity > 0.0f && NdotL > 0.0f)
         {
             float32_t3 halfVector = normalize(lightDir + viewDir);
             float NdotH = max(dot(normal, halfVector), 0.0f);
             float shininess = max(gMaterial.shininess, 50.0f); // 光沢度を調整
-            specularColor = float32_t3(1.0f, 1.0f, 1.0f) * pow(NdotH, shininess) * gDirectionalLight.intensity;
+            specularColor = float32_t3(1.0f, 1.0f, 1.0f) * pow(NdotH, shininess) * directionalLight.intensity;
         }
     
         /*------ポイントライト------*/
    
         // ポイントライトの方向
-        float32_t3 pointLightDir = gPointLight.position - input.worldPosition;
+        float32_t3 pointLightDir = pointLight.position - input.worldPosition;
         float distance = length(pointLightDir); // ポイントライトへの距離
         pointLightDir = normalize(pointLightDir); // 正規化
     
         // 減衰の計算（逆二乗の法則）
-        float attenuation = 1.0f / (1.0f + gPointLight.decay * pow(distance / (gPointLight.radius + 1.0f), gPointLight.decay));
+        float attenuation = 1.0f / (1.0f + pointLight.decay * pow(distance / (pointLight.radius + 1.0f), pointLight.decay));
         attenuation = saturate(attenuation); // 0～1にクランプ
     
         // ポイントライトのハーフランバート反射の計算
@@ -114,53 +191,93 @@ PixelShaderOutput main(VertexShaderOutput input){
         float pointLightHalfLambertFactor = saturate(pow(pointNdotL * 0.5f + 0.5f, 2.0f)); // ハーフランバート反射
     
         // ポイントライトの拡散反射
-        float32_t3 pointDiffuseColor = gMaterial.color.rgb * textureColor.rgb * gPointLight.color.rgb * gPointLight.intensity * pointLightHalfLambertFactor * attenuation;
+        float32_t3 pointDiffuseColor = gMaterial.color.rgb * textureColor.rgb * pointLight.color.rgb * pointLight.intensity * pointLightHalfLambertFactor * attenuation;
     
         // ポイントライトの鏡面反射
         float32_t3 pointSpecularColor = float32_t3(0.0f, 0.0f, 0.0f);
-        if (gPointLight.intensity > 0.0f && pointNdotL > 0.0f)
+        if (pointLight.intensity > 0.0f && pointNdotL > 0.0f)
         {
             float32_t3 pointHalfVector = normalize(pointLightDir + viewDir);
             float pointNdotH = max(dot(normal, pointHalfVector), 0.0f);
             float shininess = max(gMaterial.shininess, 50.0f);
-            pointSpecularColor = float32_t3(1.0f, 1.0f, 1.0f) * pow(pointNdotH, shininess) * gPointLight.intensity;
+            pointSpecularColor = float32_t3(1.0f, 1.0f, 1.0f) * pow(pointNdotH, shininess) * pointLight.intensity;
         }
     
         /*------スポットライト------*/
     
-        float32_t3 spotLightDir = gSpotLight.position - input.worldPosition; // スポットライトからピクセルへの方向
+        float32_t3 spotLightDir = spotLight.position - input.worldPosition; // スポットライトからピクセルへの方向
         float spotLightDistance = length(spotLightDir); // 距離
         spotLightDir = normalize(spotLightDir); // 正規化
     
         // 距離減衰と逆二乗の法則を計算
-        float spotAttenuation = 1.0f / (1.0f + gSpotLight.decay * pow(spotLightDistance / (gSpotLight.distance + 1.0f), 2.0f));
+        float spotAttenuation = 1.0f / (1.0f + spotLight.decay * pow(spotLightDistance / (spotLight.distance + 1.0f), 2.0f));
         spotAttenuation = saturate(spotAttenuation); // クランプ
     
         // 角度減衰の計算
-        float cosAngle = dot(-spotLightDir, normalize(gSpotLight.direction));
-        float spotAngleFactor = saturate((cosAngle - gSpotLight.cosAngle) / (gSpotLight.cosFalloffStart - gSpotLight.cosAngle)); // 緩やかに減衰
+        float cosAngle = dot(-spotLightDir, normalize(spotLight.direction));
+        float spotAngleFactor = saturate((cosAngle - spotLight.cosAngle) / (spotLight.cosFalloffStart - spotLight.cosAngle)); // 緩やかに減衰
     
         // スポットライトの拡散反射
         float spotNdotL = dot(normal, spotLightDir); // 法線とライト方向
         float spotLghtHalfLambertFactor = saturate(pow(spotNdotL * 0.5f + 0.5f, 2.0f)); // ハーフランバート反射
-        float32_t3 spotDiffuseColor = gMaterial.color.rgb * textureColor.rgb * gSpotLight.color.rgb * gSpotLight.intensity * spotLghtHalfLambertFactor * spotAttenuation * spotAngleFactor;
+        float32_t3 spotDiffuseColor = gMaterial.color.rgb * textureColor.rgb * spotLight.color.rgb * spotLight.intensity * spotLghtHalfLambertFactor * spotAttenuation * spotAngleFactor;
     
         // スポットライトの鏡面反射
         float32_t3 spotSpecularColor = float32_t3(0.0f, 0.0f, 0.0f);
-        if (gSpotLight.intensity > 0.0f && spotNdotL > 0.0f)
+        if (spotLight.intensity > 0.0f && spotNdotL > 0.0f)
         {
             float32_t3 spotHalfVector = normalize(spotLightDir + viewDir); // ハーフベクトル
             float spotNdotH = max(dot(normal, spotHalfVector), 0.0f);
             float shininess = max(gMaterial.shininess, 50.0f);
-            spotSpecularColor = float32_t3(1.0f, 1.0f, 1.0f) * pow(spotNdotH, shininess) * gSpotLight.intensity * spotAttenuation * spotAngleFactor;
+            spotSpecularColor = float32_t3(1.0f, 1.0f, 1.0f) * pow(spotNdotH, shininess) * spotLight.intensity * spotAttenuation * spotAngleFactor;
         }
         
-        // 環境光 + 拡散反射 + 鏡面反射 + 点光源の拡散反射 + 点光源の鏡面反射 + スポットライトの拡散反射 + スポットライトの鏡面反射
-        float32_t3 finalColor = /*ambientColor + */diffuseColor + specularColor + pointDiffuseColor + pointSpecularColor + spotDiffuseColor + spotSpecularColor;
+        /*------クラスタのライト------*/
+
+        // 自分のクラスタに掛かるライトだけを回す（減衰・反射はシーンのライトと同じ式に、届く距離の窓を掛ける）
+        float32_t3 clusterColor = float32_t3(0.0f, 0.0f, 0.0f);
+        LightCluster cluster = gClusters[GetClusterIndex(input.position.xy, input.worldPosition)];
+        float clusterShininess = max(gMaterial.shininess, 50.0f);
+        for (uint32_t i = 0; i < cluster.pointCount; i++)
+        {
+            PointLight light = gClusterPointLights[gClusterLightIndices[cluster.offset + i]];
+            float32_t3 toLight = light.position - input.worldPosition;
+            float lightDistance = length(toLight);
+            toLight /= max(lightDistance, 0.0001f);
+            float lightAttenuation = saturate(1.0f / (1.0f + light.decay * pow(lightDistance / (light.radius + 1.0f), light.decay))) * RangeWindow(lightDistance, light.radius);
+            float lightNdotL = dot(normal, toLight);
+            float lightHalfLambert = saturate(pow(lightNdotL * 0.5f + 0.5f, 2.0f));
+            clusterColor += gMaterial.color.rgb * textureColor.rgb * light.color.rgb * light.intensity * lightHalfLambert * lightAttenuation;
+            if (lightNdotL > 0.0f)
+            {
+                float lightNdotH = max(dot(normal, normalize(toLight + viewDir)), 0.0f);
+                clusterColor += light.color.rgb * pow(lightNdotH, clusterShininess) * light.intensity * lightAttenuation;
+            }
+        }
+        for (uint32_t j = 0; j < cluster.spotCount; j++)
+        {
+            SpotLight light = gClusterSpotLights[gClusterLightIndices[cluster.offset + cluster.pointCount + j]];
+            float32_t3 toLight = light.position - input.worldPosition;
+            float lightDistance = length(toLight);
+            toLight /= max(lightDistance, 0.0001f);
+            float lightAttenuation = saturate(1.0f / (1.0f + light.decay * pow(lightDistance / (light.distance + 1.0f), 2.0f))) * RangeWindow(lightDistance, light.distance);
+            float lightAngleFactor = saturate((dot(-toLight, normalize(light.direction)) - light.cosAngle) / (light.cosFalloffStart - light.cosAngle));
+            float lightNdotL = dot(normal, toLight);
+            float lightHalfLambert = saturate(pow(lightNdotL * 0.5f + 0.5f, 2.0f));
+            clusterColor += gMaterial.color.rgb * textureColor.rgb * light.color.rgb * light.intensity * lightHalfLambert * lightAttenuation * lightAngleFactor;
+            if (lightNdotL > 0.0f)
+            {
+                float lightNdotH = max(dot(normal, normalize(toLight + viewDir)), 0.0f);
+                clusterColor += light.color.rgb * pow(lightNdotH, clusterShininess) * light.intensity * lightAttenuation * lightAngleFactor;
+            }
+        }
+
+        // 環境光 + 拡散反射 + 鏡面反射 + 点光源の拡散反射 + 点光源の鏡面反射 + スポットライトの拡散反射 + スポットライトの鏡面反射 + クラスタのライト
+        float32_t3 finalColor = /*ambientColor + */diffuseColor + specularColor + pointDiffuseColor + pointSpecularColor + spotDiffuseColor + spotSpecularColor + clusterColor;
         output.color.rgb = saturate(finalColor);
         
         // 環境マッピングの計算
-        float32_t3 cameraToPosition = normalize(input.worldPosition - gCamera.worldPosition);
+        float32_t3 cameraToPosition = normalize(input.worldPosition - gFrameLighting.cameraWorldPosition);
         float32_t3 reflectedVector = reflect(cameraToPosition, normalize(input.normal));
         float32_t4 environmentColor = gEnvironmentTexture.Sample(gSampler, reflectedVector);
         output.color.rgb += environmentColor.rgb * gMaterial.environmentCoefficient;
@@ -0,0 +1,31 @@
+#include "Object3d.hlsli"
+
+// インスタンシング描画用（変換行列はインスタンスごとに StructuredBuffer から読む。ピクセルシェーダーは Object3d.PS.hlsl と共通）
+struct TransformationMatrix{
+    float32_t4x4 WVP;
+    float32_t4x4 World;
+    float32_t4x4 WorldInverseTranspose;
+};
+StructuredBuffer<TransformationMatrix> gTransformationMatrices : register(t0);
+
+// このドローの先頭インスタンスが gTransformationMatrices の何番目か（SV_InstanceID は 0 から始まるため）
+struct InstanceOffset{
+    uint32_t offset;
+};
+ConstantBuffer<InstanceOffset> gInstanceOffset : register(b0);
+
+struct VertexShaderInput{
+    float32_t4 position : POSITION0;
+    float32_t2 texcoord : TEXCOORD0;
+    float32_t3 normal : NORMAL0;
+};
+
+VertexShaderOutput main(VertexShaderInput input, uint32_t instanceId : SV_InstanceID){
+    TransformationMatrix transformationMatrix = gTransformationMatrices[gInstanceOffset.offset + instanceId];
+    VertexShaderOutput output;
+    output.position = mul(input.position, transformationMatrix.WVP);
+    output.texcoord = input.texcoord;
+    output.normal = normalize(mul(input.normal, (float32_t3x3) transformationMatrix.WorldInverseTranspose));
+    output.worldPosition = mul(input.position, transformationMatrix.World).xyz;
+    return output;
+}
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "TestCommon.h"
+#include "BenchCommon.h"
+#include "Affine3x4.h"
+#include "Inverse.h"
+#include "MakeAffineMatrix.h"
+#include "MakePerspectiveFovMatrix.h"
+#include "MakeRotateXMatrix.h"
+#include "MakeRotateYMatrix.h"
+#include "MakeRotateZMatrix.h"
+#include "Multiply.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//
+// AffineTransformBench
+// - WorldTransform::Update が 1 オブジェクトごとに行う行列計算を、Affine3x4 にする前後で比べるヘッドレスのベンチマーク。
+//   * 4x4    : 以前の処理。MakeAffineMatrix（回転行列 3 つの積）→ 親の 4x4 行列を掛ける → WVP の 4x4 の積
+//              → 法線行列 Transpose(Inverse(world))
+//   * affine : 今の処理。MakeAffine3x4 → 親の Affine3x4 を掛ける → Multiply(Affine3x4, Matrix4x4) で WVP
+//              → MakeNormalMatrix、GPU に送る World だけ ToMatrix4x4
+//   内訳として、合成（親との積）・逆行列・法線行列をそれぞれ単独でも測る。
+// - 2 つの処理の結果（World / WVP / 法線行列の 3x3）が 1e-5 以内で一致することを計測の前に確かめる。
+// - 使い方：AffineTransformBench [--quick]
+//
+namespace {
+	// 計測の規模
+	struct BenchConfig {
+		size_t objectCount = 4096;
+		int repeatCount = 200;
+	};
+
+	// 2 つの処理の結果の差として許す量（行列全体の大きさに対する相対誤差）
+	constexpr double kTolerance = 1e-5;
+
+	// オブジェクト 1 つ分の入力（親は自分より前のオブジェクト。無ければ -1）
+	struct ObjectInput {
+		Vector3 scale;
+		Vector3 rotate;
+		Vector3 translate;
+		int parentIndex;
+	};
+
+	// オブジェクト 1 つ分の出力（定数バッファに書く 3 つ）
+	struct ObjectOutput {
+		Matrix4x4 world;
+		Matrix4x4 worldViewProjection;
+		Matrix4x4 normal;
+	};
+
+	std::vector<ObjectInput> MakeObjects(size_t count)
+	{
+		std::mt19937 random(4242);
+		std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+		std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+		std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+
+		std::vector<ObjectInput> objects;
+		for (size_t i = 0; i < count; ++i) {
+			// 半分は親子付けあり（親の親までの 2 段程度の階層になる）
+			const int parentIndex = (i % 2 == 1) ? static_cast<int>(i - 1) : -1;
+			objects.push_back({ { scale(random), scale(random), scale(random) },
+				{ angle(random), angle(random), angle(random) },
+				{ position(random), position(random), position(random) }, parentIndex });
+		}
+		return objects;
+	}
+
+	// 以前の MakeAffineMatrix（回転行列 3 つの積に拡縮と平行移動を入れる）
+	Matrix4x4 MakeAffineMatrixByRotateProduct(const Vector3& scale, const Vector3& rotate, const Vector3& translate)
+	{
+		const Matrix4x4 rotateXYZ = Math::Multiply(Math::MakeRotateXMatrix(rotate.x), Math::Multiply(Math::MakeRotateYMatrix(rotate.y), Math::MakeRotateZMatrix(rotate.z)));
+		Matrix4x4 result = {};
+		for (int j = 0; j < 3; ++j) {
+			result.m[0][j] = scale.x * rotateXYZ.m[0][j];
+			result.m[1][j] = scale.y * rotateXYZ.m[1][j];
+			result.m[2][j] = scale.z * rotateXYZ.m[2][j];
+		}
+		result.m[3][0] = translate.x;
+		result.m[3][1] = translate.y;
+		result.m[3][2] = translate.z;
+		result.m[3][3] = 1.0f;
+		return result;
+	}
+
+	// 以前の WorldTransform::Update の行列計算
+	void UpdateMatrix4x4(const std::vector<ObjectInput>& objects, const Matrix4x4& viewProjection, std::vector<Matrix4x4>& worlds, std::vector<ObjectOutput>& outputs)
+	{
+		for (size_t i = 0; i < objects.size(); ++i) {
+			const ObjectInput& object = objects[i];
+			Matrix4x4 world = MakeAffineMatrixByRotateProduct(object.scale, object.rotate, object.translate);
+			if (object.parentIndex >= 0) {
+				world = Math::Multiply(world, worlds[object.parentIndex]);
+			}
+			worlds[i] = world;
+			outputs[i].world = world;
+			outputs[i].worldViewProjection = Math::Multiply(world, viewProjection);
+			outputs[i].normal = Matrix4x4::Transpose(Math::Inverse(world));
+		}
+	}
+
+	// 今の WorldTransform::Update の行列計算
+	void UpdateAffine3x4(const std::vector<ObjectInput>& objects, const Matrix4x4& viewProjection, std::vector<Affine3x4>& worlds, std::vector<ObjectOutput>& outputs)
+	{
+		for (size_t i = 0; i < objects.size(); ++i) {
+			const ObjectInput& object = objects[i];
+			Affine3x4 world = Math::MakeAffine3x4(object.scale, object.rotate, object.translate);
+			if (object.parentIndex >= 0) {
+				world = Math::Multiply(world, worlds[object.parentIndex]);
+			}
+			worlds[i] = world;
+			outputs[i].world = Math::ToMatrix4x4(world);
+			outputs[i].worldViewProjection = Math::Multiply(world, viewProjection);
+			outputs[i].normal = Math::MakeNormalMatrix(world);
+		}
+	}
+
+	// 行列全体の大きさに対する差（rowCount 行 × columnCount 列だけ比べる）
+	double RelativeError(const Matrix4x4& actual, const Matrix4x4& expected, int rowCount = 4, int columnCount = 4)
+	{
+		double maxDifference = 0.0;
+		double maxMagnitude = 1.0;
+		for (int i = 0; i < rowCount; ++i) {
+			for (int j = 0; j < columnCount; ++j) {
+				maxDifference = (std::max)(maxDifference, std::abs(static_cast<double>(actual.m[i][j]) - expected.m[i][j]));
+				maxMagnitude = (std::max)(maxMagnitude, std::abs(static_cast<double>(expected.m[i][j])));
+			}
+		}
+		return maxDifference / maxMagnitude;
+	}
+
+	// 2 つの処理の結果が一致するか（法線行列はシェーダーが使う左上 3x3 だけ。以前は逆行列の平行移動が転置されて入っていた）
+	void VerifyOutputs(const std::vector<ObjectOutput>& matrixOutputs, const std::vector<ObjectOutput>& affineOutputs)
+	{
+		double worldError = 0.0;
+		double worldViewProjectionError = 0.0;
+		double normalError = 0.0;
+		for (size_t i = 0; i < matrixOutputs.size(); ++i) {
+			worldError = (std::max)(worldError, RelativeError(affineOutputs[i].world, matrixOutputs[i].world));
+			worldViewProjectionError = (std::max)(worldViewProjectionError, RelativeError(affineOutputs[i].worldViewProjection, matrixOutputs[i].worldViewProjection));
+			normalError = (std::max)(normalError, RelativeError(affineOutputs[i].normal, matrixOutputs[i].normal, 3, 3));
+		}
+		std::printf("  max relative difference : world %.3g, wvp %.3g, normal %.3g\n", worldError, worldViewProjectionError, normalError);
+		TEST_CHECK(worldError <= kTolerance);
+		TEST_CHECK(worldViewProjectionError <= kTolerance);
+		TEST_CHECK(normalError <= kTolerance);
+	}
+
+	// 合成・逆行列・法線行列の単独の時間
+	void BenchParts(const std::vector<Matrix4x4>& matrixWorlds, const std::vector<Affine3x4>& affineWorlds, const BenchConfig& config)
+	{
+		const size_t count = matrixWorlds.size();
+		const double operationCount = static_cast<double>(count);
+		std::vector<Matrix4x4> matrixResults(count);
+		std::vector<Affine3x4> affineResults(count);
+
+		const auto measure = [&](const char* name, auto function) {
+			const double totalNs = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&] {
+				for (size_t i = 0; i < count; ++i) {
+					function(i);
+				}
+			});
+			BenchCommon::Report(name, totalNs, operationCount);
+		};
+
+		measure("compose 4x4 Multiply", [&](size_t i) { matrixResults[i] = Math::Multiply(matrixWorlds[i], matrixWorlds[count - 1 - i]); });
+		measure("compose Affine3x4 Multiply", [&](size_t i) { affineResults[i] = Math::Multiply(affineWorlds[i], affineWorlds[count - 1 - i]); });
+		measure("inverse 4x4 Inverse", [&](size_t i) { matrixResults[i] = Math::Inverse(matrixWorlds[i]); });
+		measure("inverse 4x4 InverseAffine", [&](size_t i) { matrixResults[i] = Math::InverseAffine(matrixWorlds[i]); });
+		measure("inverse Affine3x4 Inverse", [&](size_t i) { affineResults[i] = Math::Inverse(affineWorlds[i]); });
+		measure("normal Transpose(Inverse)", [&](size_t i) { matrixResults[i] = Matrix4x4::Transpose(Math::Inverse(matrixWorlds[i])); });
+		measure("normal Transpose(InverseAffine)", [&](size_t i) { matrixResults[i] = Matrix4x4::Transpose(Math::InverseAffine(matrixWorlds[i])); });
+		measure("normal MakeNormalMatrix", [&](size_t i) { matrixResults[i] = Math::MakeNormalMatrix(affineWorlds[i]); });
+
+		// Affine3x4 の逆行列と 4x4 の逆行列が一致するか
+		double inverseError = 0.0;
+		for (size_t i = 0; i < count; ++i) {
+			inverseError = (std::max)(inverseError, RelativeError(Math::ToMatrix4x4(Math::Inverse(affineWorlds[i])), Math::Inverse(matrixWorlds[i])));
+		}
+		TEST_CHECK(inverseError <= kTolerance);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchConfig config;
+	if (BenchCommon::IsQuick(argc, argv)) {
+		config = BenchConfig{ 256, 1 };
+	}
+
+	const std::vector<ObjectInput> objects = MakeObjects(config.objectCount);
+	const Matrix4x4 viewProjection = Math::Multiply(
+		Math::InverseAffine(Math::MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, { 0.3f, -0.5f, 0.0f }, { 0.0f, 10.0f, -40.0f })),
+		Math::MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, 1000.0f));
+
+	std::printf("AffineTransformBench: %zu objects (half parented)\n", objects.size());
+	std::vector<Matrix4x4> matrixWorlds(objects.size());
+	std::vector<Affine3x4> affineWorlds(objects.size());
+	std::vector<ObjectOutput> matrixOutputs(objects.size());
+	std::vector<ObjectOutput> affineOutputs(objects.size());
+
+	const double operationCount = static_cast<double>(objects.size());
+	const double matrixNs = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&] {
+		UpdateMatrix4x4(objects, viewProjection, matrixWorlds, matrixOutputs);
+	});
+	BenchCommon::Report("per object 4x4 (before)", matrixNs, operationCount);
+	const double affineNs = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&] {
+		UpdateAffine3x4(objects, viewProjection, affineWorlds, affineOutputs);
+	});
+	BenchCommon::Report("per object Affine3x4 (after)", affineNs, operationCount);
+	VerifyOutputs(matrixOutputs, affineOutputs);
+
+	BenchParts(matrixWorlds, affineWorlds, config);
+
+	return TestCommon::Finish("AffineTransformBench");
+}
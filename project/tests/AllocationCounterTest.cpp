@@ -0,0 +1,261 @@
+#include "TestCommon.h"
+#include "AllocationCounter.h"
+#include "MemoryReport.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <thread>
+#include <json.hpp>
+
+//
+// AllocationCounterTest
+// - ENABLE_ALLOCATION_COUNTER を定義してビルドした AllocationCounter（グローバル operator new / delete の置き換え）で、
+//   MemoryTagScope ごとの確保中・最大バイト数と確保・解放回数が合うことを確かめる。
+//   * 解放は確保時のタグから引く（別のタグのスコープや別スレッドで delete しても、確保したタグに戻る）
+//   * アライメント指定版の new / delete（alignas 付きの型、配列、nothrow、明示的な呼び出し）も同じく数える
+//   * BeginFrame で直前のフレームの確保回数が確定する
+// - MemoryReport::ToJson / WriteJson（"--dump-memory-stats" の出力）が同じ値を持つ JSON になることも確かめる。
+// - タグの値は他のテストと共有しないよう、このテストだけで使うタグ（Particle / Collision / Model / Audio / Scene / Texture）を
+//   それぞれ 1 つの確認にだけ使い、確保前からの差で比べる。
+//
+using namespace MyEngine;
+
+namespace {
+	struct alignas(64) CacheLineBlock {
+		float values[16];
+	};
+
+	// 確保した回数・バイト数が、確保前の統計との差として現れる
+	void TestScopeCountsLiveAndPeakBytes()
+	{
+		TEST_CHECK(AllocationCounter::IsEnabled());
+		const AllocationCounter::TagStats before = AllocationCounter::GetTagStats(MemoryTag::Particle);
+		const AllocationCounter::TagStats totalBefore = AllocationCounter::GetTotalStats();
+
+		int* first = nullptr;
+		int* second = nullptr;
+		{
+			MemoryTagScope memoryTag(MemoryTag::Particle);
+			TEST_CHECK(AllocationCounter::GetCurrentTag() == MemoryTag::Particle);
+			first = new int[100];
+			second = new int[50];
+		}
+		TEST_CHECK(AllocationCounter::GetCurrentTag() == MemoryTag::Untagged);
+
+		const AllocationCounter::TagStats allocated = AllocationCounter::GetTagStats(MemoryTag::Particle);
+		TEST_CHECK(allocated.allocationCount == before.allocationCount + 2);
+		TEST_CHECK(allocated.liveBytes == before.liveBytes + static_cast<int64_t>(150 * sizeof(int)));
+		TEST_CHECK(allocated.peakBytes == before.liveBytes + static_cast<int64_t>(150 * sizeof(int)));
+		TEST_CHECK(allocated.freeCount == before.freeCount);
+		TEST_CHECK(AllocationCounter::GetTotalStats().allocationCount >= totalBefore.allocationCount + 2);
+
+		// スコープの外（Untagged）で解放しても Particle から引かれる
+		const AllocationCounter::TagStats untaggedBefore = AllocationCounter::GetTagStats(MemoryTag::Untagged);
+		delete[] first;
+		delete[] second;
+		const AllocationCounter::TagStats freed = AllocationCounter::GetTagStats(MemoryTag::Particle);
+		TEST_CHECK(freed.liveBytes == before.liveBytes);
+		TEST_CHECK(freed.freeCount == before.freeCount + 2);
+		TEST_CHECK(freed.peakBytes == allocated.peakBytes);
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Untagged).freeCount == untaggedBefore.freeCount);
+	}
+
+	// 入れ子のスコープは内側のタグで数え、抜けると外側に戻る
+	void TestNestedScopes()
+	{
+		const AllocationCounter::TagStats outerBefore = AllocationCounter::GetTagStats(MemoryTag::Collision);
+		const AllocationCounter::TagStats innerBefore = AllocationCounter::GetTagStats(MemoryTag::Scene);
+
+		char* outer = nullptr;
+		char* inner = nullptr;
+		char* outerAgain = nullptr;
+		{
+			MemoryTagScope outerTag(MemoryTag::Collision);
+			outer = new char[32];
+			{
+				MemoryTagScope innerTag(MemoryTag::Scene);
+				TEST_CHECK(AllocationCounter::GetCurrentTag() == MemoryTag::Scene);
+				inner = new char[64];
+			}
+			TEST_CHECK(AllocationCounter::GetCurrentTag() == MemoryTag::Collision);
+			outerAgain = new char[16];
+		}
+
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Collision).liveBytes == outerBefore.liveBytes + 48);
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Collision).allocationCount == outerBefore.allocationCount + 2);
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Scene).liveBytes == innerBefore.liveBytes + 64);
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Scene).allocationCount == innerBefore.allocationCount + 1);
+
+		delete[] outer;
+		delete[] inner;
+		delete[] outerAgain;
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Collision).liveBytes == outerBefore.liveBytes);
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Scene).liveBytes == innerBefore.liveBytes);
+	}
+
+	// 最大値は同時に確保していた量で、解放しても下がらない
+	void TestPeakBytesKeepsMaximum()
+	{
+		const AllocationCounter::TagStats before = AllocationCounter::GetTagStats(MemoryTag::Audio);
+		MemoryTagScope memoryTag(MemoryTag::Audio);
+
+		std::byte* a = new std::byte[1000];
+		std::byte* b = new std::byte[2000];
+		delete[] a;
+		std::byte* c = new std::byte[500];
+		delete[] b;
+		delete[] c;
+
+		const AllocationCounter::TagStats after = AllocationCounter::GetTagStats(MemoryTag::Audio);
+		TEST_CHECK(after.liveBytes == before.liveBytes);
+		TEST_CHECK(after.peakBytes == (std::max)(before.peakBytes, before.liveBytes + 3000));
+		TEST_CHECK(after.allocationCount == before.allocationCount + 3);
+		TEST_CHECK(after.freeCount == before.freeCount + 3);
+	}
+
+	// アライメント指定版の new / delete も組になって数えられ、戻り値が揃っている
+	void TestAlignedNewDeletePairing()
+	{
+		const AllocationCounter::TagStats before = AllocationCounter::GetTagStats(MemoryTag::Model);
+		MemoryTagScope memoryTag(MemoryTag::Model);
+
+		// alignas 付きの型（operator new(size_t, align_val_t) / delete(void*, size_t, align_val_t)）
+		CacheLineBlock* single = new CacheLineBlock();
+		TEST_CHECK(reinterpret_cast<uintptr_t>(single) % alignof(CacheLineBlock) == 0);
+		// 配列版
+		CacheLineBlock* array = new CacheLineBlock[3];
+		TEST_CHECK(reinterpret_cast<uintptr_t>(array) % alignof(CacheLineBlock) == 0);
+		// nothrow 版
+		CacheLineBlock* nothrow = new (std::nothrow) CacheLineBlock();
+		TEST_CHECK(nothrow != nullptr && reinterpret_cast<uintptr_t>(nothrow) % alignof(CacheLineBlock) == 0);
+		// ヘッダより大きいアライメントを明示的に
+		void* page = ::operator new(100, std::align_val_t(256));
+		TEST_CHECK(reinterpret_cast<uintptr_t>(page) % 256 == 0);
+
+		const AllocationCounter::TagStats allocated = AllocationCounter::GetTagStats(MemoryTag::Model);
+		TEST_CHECK(allocated.allocationCount == before.allocationCount + 4);
+		TEST_CHECK(allocated.liveBytes >= before.liveBytes + static_cast<int64_t>(5 * sizeof(CacheLineBlock) + 100));
+
+		// 書き込んでもヘッダが壊れない（解放時に確保時のサイズを引ける）
+		single->values[15] = 1.0f;
+		array[2].values[15] = 2.0f;
+		static_cast<std::byte*>(page)[99] = std::byte{ 3 };
+
+		delete single;
+		delete[] array;
+		delete nothrow;
+		::operator delete(page, 100, std::align_val_t(256));
+
+		const AllocationCounter::TagStats freed = AllocationCounter::GetTagStats(MemoryTag::Model);
+		TEST_CHECK(freed.liveBytes == before.liveBytes);
+		TEST_CHECK(freed.freeCount == before.freeCount + 4);
+	}
+
+	// 別のスレッドで解放しても、確保したタグから引かれる
+	void TestFreeOnAnotherThread()
+	{
+		const AllocationCounter::TagStats before = AllocationCounter::GetTagStats(MemoryTag::Texture);
+		std::string* text = nullptr;
+		{
+			MemoryTagScope memoryTag(MemoryTag::Texture);
+			text = new std::string(200, 'x');
+		}
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Texture).liveBytes > before.liveBytes);
+
+		std::thread thread([text] {
+			// ワーカー側のタグは Untagged のまま
+			delete text;
+		});
+		thread.join();
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Texture).liveBytes == before.liveBytes);
+		// std::string 本体と文字列のバッファの 2 つ
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Texture).freeCount == before.freeCount + 2);
+	}
+
+	// BeginFrame で直前のフレームの確保回数が確定する（最初のフレームは数えない）
+	void TestFrameAllocationCount()
+	{
+		AllocationCounter::BeginFrame();
+		const uint64_t frameCount = AllocationCounter::GetFrameCount();
+		{
+			MemoryTagScope memoryTag(MemoryTag::Texture);
+			for (int i = 0; i < 5; ++i) {
+				delete new int(i);
+			}
+		}
+		AllocationCounter::BeginFrame();
+		TEST_CHECK(AllocationCounter::GetFrameCount() == frameCount + 1);
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Texture).lastFrameAllocationCount == 5);
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Texture).peakFrameAllocationCount >= 5);
+		TEST_CHECK(AllocationCounter::GetTotalStats().lastFrameAllocationCount >= 5);
+
+		// 何も確保しないフレーム
+		AllocationCounter::BeginFrame();
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Texture).lastFrameAllocationCount == 0);
+		TEST_CHECK(AllocationCounter::GetTagStats(MemoryTag::Texture).peakFrameAllocationCount >= 5);
+	}
+
+	// JSON のタグ 1 つ分が統計と一致するか
+	bool IsSameStats(const nlohmann::json& json, const AllocationCounter::TagStats& stats)
+	{
+		return json.at("liveBytes").get<int64_t>() == stats.liveBytes &&
+			json.at("peakBytes").get<int64_t>() == stats.peakBytes &&
+			json.at("allocations").get<uint64_t>() == stats.allocationCount &&
+			json.at("frees").get<uint64_t>() == stats.freeCount &&
+			json.at("lastFrameAllocations").get<uint64_t>() == stats.lastFrameAllocationCount &&
+			json.at("peakFrameAllocations").get<uint64_t>() == stats.peakFrameAllocationCount;
+	}
+
+	// "--dump-memory-stats" と同じ出力（MemoryReport）が、全タグの統計を持つ JSON になる
+	void TestMemoryReportJson()
+	{
+		// JSON の組み立て自体は Untagged で確保するので、ファイルとの比較はここで使っていないタグの値で行う
+		const nlohmann::json report = nlohmann::json::parse(MemoryReport::ToJson());
+		TEST_CHECK(report.at("enabled").get<bool>());
+		TEST_CHECK(report.at("frames").get<uint64_t>() == AllocationCounter::GetFrameCount());
+		TEST_CHECK(report.at("total").contains("liveBytes"));
+		TEST_CHECK(report.at("tags").size() == kMemoryTagCount);
+		for (uint32_t i = 0; i < kMemoryTagCount; ++i) {
+			TEST_CHECK(report.at("tags").contains(GetMemoryTagName(static_cast<MemoryTag>(i))));
+		}
+		TEST_CHECK(IsSameStats(report.at("tags").at("Audio"), AllocationCounter::GetTagStats(MemoryTag::Audio)));
+
+		const AllocationCounter::TagStats particle = AllocationCounter::GetTagStats(MemoryTag::Particle);
+		const AllocationCounter::TagStats model = AllocationCounter::GetTagStats(MemoryTag::Model);
+
+		// ファイルへの書き出しと読み戻し
+		const std::filesystem::path filePath = std::filesystem::temp_directory_path() / "AllocationCounterTest_memory_stats.json";
+		TEST_CHECK(MemoryReport::WriteJson(filePath.string()));
+		std::ifstream file(filePath);
+		TEST_CHECK(file.is_open());
+		const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		file.close();
+		const nlohmann::json json = nlohmann::json::parse(text, nullptr, false);
+		TEST_CHECK(!json.is_discarded());
+		if (!json.is_discarded()) {
+			TEST_CHECK(IsSameStats(json.at("tags").at("Particle"), particle));
+			TEST_CHECK(IsSameStats(json.at("tags").at("Model"), model));
+			TEST_CHECK(json.at("total").at("allocations").get<uint64_t>() > 0);
+		}
+		std::error_code error;
+		std::filesystem::remove(filePath, error);
+
+		// 書き出せない場所では false
+		TEST_CHECK(!MemoryReport::WriteJson((filePath.parent_path() / "no_such_directory" / "stats.json").string()));
+	}
+}
+
+int main()
+{
+	TestScopeCountsLiveAndPeakBytes();
+	TestNestedScopes();
+	TestPeakBytesKeepsMaximum();
+	TestAlignedNewDeletePairing();
+	TestFreeOnAnotherThread();
+	TestFrameAllocationCount();
+	TestMemoryReportJson();
+	return TestCommon::Finish("AllocationCounterTest");
+}
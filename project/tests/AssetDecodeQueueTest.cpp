@@ -0,0 +1,326 @@
+#include "TestCommon.h"
+#include "AssetDecodeQueue.h"
+#include "ObjLoader.h"
+#include "WaveFile.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+//
+// AssetDecodeQueueTest
+// - fixtures/assets の小さな OBJ / MTL / WAV を、AssetLoader と同じ形（ワーカーでデコード → メインスレッドで登録）で読み込む。
+// - テクスチャのデコードは WIC / DirectXTex を使えないので、呼ばれた回数を数えるだけのものに置き換える。
+// - 同じパスのリクエストの共有、モデルとテクスチャで同じテクスチャを二重にデコードしないこと、
+//   1 回に登録する件数の上限、読み込み済みの即完了、Forget 後の読み込み直しを見る。
+//
+using namespace MyEngine;
+
+namespace {
+	const std::string kFixtureDirectory = std::string(GE3_TEST_FIXTURE_DIR) + "/assets";
+
+	// AssetLoader::DecodedAsset の D3D を使わない部分
+	struct DecodedAsset {
+		ModelData modelData;
+		std::string textureFilePath;
+		bool isTextureDecoded = false;
+		WaveFormat waveFormat;
+		std::vector<uint8_t> samples;
+	};
+
+	using Queue = AssetDecodeQueue<DecodedAsset>;
+
+	// 登録側（メインスレッド）で受け取った結果
+	struct Registry {
+		std::vector<std::string> textures;
+		std::vector<std::string> models;
+		std::vector<std::string> sounds;
+		uint32_t modelVertexCount = 0;
+		WaveFormat waveFormat;
+		uint32_t sampleByteCount = 0;
+	};
+
+	/// <summary>
+	/// AssetLoader の Decode / Upload をテスト用に置き換えたもの
+	/// </summary>
+	class FixtureLoader
+	{
+	public:
+		void Initialize(uint32_t workerCount)
+		{
+			queue_.Initialize(workerCount,
+				[this](const Queue::Job& job) { return Decode(job); },
+				[this]() { ++threadBeginCount_; },
+				[this]() { ++threadEndCount_; });
+		}
+
+		Queue::Handle Request(AssetType type, const std::string& fileName, bool isLoaded = false)
+		{
+			return queue_.Request(type, kFixtureDirectory + "/" + fileName, isLoaded);
+		}
+
+		// ProcessCompleted を 1 件ずつ呼び、ハンドルが全て完了するまで待つ
+		bool ProcessUntilReady(const std::vector<Queue::Handle>& handles)
+		{
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+			while (std::chrono::steady_clock::now() < deadline) {
+				const uint32_t processed = queue_.ProcessCompleted(1, [this](DecodedAsset& asset, const Queue::Job& job, double decodeMs) {
+					Upload(asset, job, decodeMs);
+				});
+				TEST_CHECK(processed <= 1);
+
+				bool isAllReady = true;
+				for (const Queue::Handle& handle : handles) {
+					isAllReady = isAllReady && IsReady(handle);
+				}
+				if (isAllReady) {
+					return true;
+				}
+				if (processed == 0) {
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+			return false;
+		}
+
+		static bool IsReady(const Queue::Handle& handle)
+		{
+			return handle.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+
+		Queue& GetQueue() { return queue_; }
+		const Registry& GetRegistry() const { return registry_; }
+		uint32_t GetTextureDecodeCount() const { return textureDecodeCount_.load(); }
+		uint32_t GetThreadBeginCount() const { return threadBeginCount_.load(); }
+		uint32_t GetThreadEndCount() const { return threadEndCount_.load(); }
+
+	private:
+		// ワーカースレッドでのデコード（AssetLoader::Decode と同じ分岐）
+		DecodedAsset Decode(const Queue::Job& job)
+		{
+			DecodedAsset asset{};
+			switch (job.type) {
+			case AssetType::Texture:
+				DecodeTexture(asset, job.filePath);
+				break;
+
+			case AssetType::Model:
+			{
+				// 参照テクスチャが未着手なら同じジョブでデコードする（AssetLoader::DecodeModel と同じ）
+				const size_t separator = job.filePath.find_last_of('/');
+				asset.modelData = ObjLoader::LoadObjFile(job.filePath.substr(0, separator), job.filePath.substr(separator + 1));
+				const std::string& textureFilePath = asset.modelData.material.textureFilePath;
+				if (!textureFilePath.empty() && queue_.Claim(textureFilePath)) {
+					DecodeTexture(asset, textureFilePath);
+				}
+				break;
+			}
+
+			case AssetType::Sound:
+			{
+				WaveFile wave;
+				if (wave.Open(job.filePath)) {
+					asset.waveFormat = wave.GetFormat();
+					asset.samples.assign(wave.GetSamples().begin(), wave.GetSamples().end());
+				}
+				break;
+			}
+
+			case AssetType::Json:
+				break;
+			}
+			return asset;
+		}
+
+		// テクスチャのデコードの代わり（回数だけ数える）
+		void DecodeTexture(DecodedAsset& asset, const std::string& filePath)
+		{
+			++textureDecodeCount_;
+			asset.textureFilePath = filePath;
+			asset.isTextureDecoded = true;
+		}
+
+		// メインスレッドでの登録（AssetLoader::Upload の代わり）
+		void Upload(DecodedAsset& asset, const Queue::Job& job, double decodeMs)
+		{
+			TEST_CHECK(decodeMs >= 0.0);
+			if (asset.isTextureDecoded) {
+				registry_.textures.push_back(asset.textureFilePath);
+			}
+			switch (job.type) {
+			case AssetType::Model:
+				registry_.models.push_back(job.filePath);
+				registry_.modelVertexCount += static_cast<uint32_t>(asset.modelData.vertices.size());
+				break;
+
+			case AssetType::Sound:
+				registry_.sounds.push_back(job.filePath);
+				registry_.waveFormat = asset.waveFormat;
+				registry_.sampleByteCount = static_cast<uint32_t>(asset.samples.size());
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		Queue queue_;
+		Registry registry_;
+		std::atomic<uint32_t> textureDecodeCount_ = 0;
+		std::atomic<uint32_t> threadBeginCount_ = 0;
+		std::atomic<uint32_t> threadEndCount_ = 0;
+	};
+
+	bool NearlyEqual(float a, float b)
+	{
+		return std::abs(a - b) < 1.0e-6f;
+	}
+
+	void TestObjFixture()
+	{
+		const ModelData model = ObjLoader::LoadObjFile(kFixtureDirectory, "triangle.obj");
+		TEST_CHECK(model.vertices.size() == 3);
+		if (model.vertices.size() != 3) {
+			return;
+		}
+
+		// 回り順は逆になり、X は反転、V は 1 - v になる
+		const VertexData& first = model.vertices[0];
+		TEST_CHECK(NearlyEqual(first.position.x, 0.0f) && NearlyEqual(first.position.z, 3.0f));
+		TEST_CHECK(NearlyEqual(first.position.w, 1.0f));
+		TEST_CHECK(NearlyEqual(first.texcoord.x, 0.0f) && NearlyEqual(first.texcoord.y, 0.75f));
+		const VertexData& last = model.vertices[2];
+		TEST_CHECK(NearlyEqual(last.position.x, -1.0f) && NearlyEqual(last.position.y, 0.0f));
+		TEST_CHECK(NearlyEqual(last.texcoord.y, 1.0f));
+		TEST_CHECK(NearlyEqual(last.normal.x, -1.0f));
+
+		// map_Kd はディレクトリと連結される
+		TEST_CHECK(model.material.textureFilePath == kFixtureDirectory + "/shared.png");
+
+		// 境界球は全ての頂点を含む
+		for (const VertexData& vertex : model.vertices) {
+			const float dx = vertex.position.x - model.boundingSphere.center.x;
+			const float dy = vertex.position.y - model.boundingSphere.center.y;
+			const float dz = vertex.position.z - model.boundingSphere.center.z;
+			TEST_CHECK(std::sqrt(dx * dx + dy * dy + dz * dz) <= model.boundingSphere.radius + 1.0e-5f);
+		}
+	}
+
+	void TestLoadFixtureSet()
+	{
+		FixtureLoader loader;
+		loader.Initialize(3);
+		TEST_CHECK(loader.GetQueue().GetWorkerCount() == 3);
+
+		// テクスチャを先にリクエストしておけば、同じテクスチャを参照するモデルのジョブはデコードしない
+		std::vector<Queue::Handle> handles;
+		handles.push_back(loader.Request(AssetType::Texture, "shared.png"));
+		handles.push_back(loader.Request(AssetType::Model, "triangle.obj"));
+		handles.push_back(loader.Request(AssetType::Model, "quad.obj"));
+		handles.push_back(loader.Request(AssetType::Sound, "tone.wav"));
+
+		// 同じパスのリクエストはジョブを増やさない
+		handles.push_back(loader.Request(AssetType::Model, "triangle.obj"));
+		TEST_CHECK(loader.GetQueue().GetRequestedCount() == 4);
+		TEST_CHECK(loader.GetQueue().FindHandle(kFixtureDirectory + "/triangle.obj") != nullptr);
+		TEST_CHECK(loader.GetQueue().FindHandle(kFixtureDirectory + "/missing.obj") == nullptr);
+
+		TEST_CHECK(loader.ProcessUntilReady(handles));
+		TEST_CHECK(loader.GetQueue().GetCompletedCount() == 4);
+
+		const Registry& registry = loader.GetRegistry();
+		TEST_CHECK(loader.GetTextureDecodeCount() == 1);
+		TEST_CHECK(registry.textures.size() == 1);
+		TEST_CHECK(registry.models.size() == 2);
+		TEST_CHECK(registry.modelVertexCount == 3 + 6);
+
+		TEST_CHECK(registry.sounds.size() == 1);
+		TEST_CHECK(registry.waveFormat.channels == 1);
+		TEST_CHECK(registry.waveFormat.samplesPerSec == 22050);
+		TEST_CHECK(registry.waveFormat.bitsPerSample == 16);
+		TEST_CHECK(registry.sampleByteCount == 64 * sizeof(int16_t));
+
+		loader.GetQueue().Finalize();
+		TEST_CHECK(loader.GetThreadBeginCount() == 3);
+		TEST_CHECK(loader.GetThreadEndCount() == 3);
+	}
+
+	void TestModelClaimsTexture()
+	{
+		// テクスチャを直接リクエストしない場合は、先に着手したモデルのジョブが 1 回だけデコードする
+		FixtureLoader loader;
+		loader.Initialize(2);
+		std::vector<Queue::Handle> handles;
+		handles.push_back(loader.Request(AssetType::Model, "triangle.obj"));
+		handles.push_back(loader.Request(AssetType::Model, "quad.obj"));
+		TEST_CHECK(loader.ProcessUntilReady(handles));
+
+		TEST_CHECK(loader.GetTextureDecodeCount() == 1);
+		TEST_CHECK(loader.GetRegistry().textures.size() == 1);
+		TEST_CHECK(loader.GetRegistry().textures.front() == kFixtureDirectory + "/shared.png");
+	}
+
+	void TestLoadedAssetCompletesImmediately()
+	{
+		FixtureLoader loader;
+		loader.Initialize(1);
+
+		// 読み込み済み（同期読み込みと重なった）ならデコードせずに完了する
+		const Queue::Handle handle = loader.Request(AssetType::Model, "triangle.obj", true);
+		TEST_CHECK(FixtureLoader::IsReady(handle));
+		TEST_CHECK(loader.GetQueue().GetRequestedCount() == 0);
+		TEST_CHECK(loader.ProcessUntilReady({ handle }));
+		TEST_CHECK(loader.GetRegistry().models.empty());
+	}
+
+	void TestForgetReloads()
+	{
+		FixtureLoader loader;
+		loader.Initialize(1);
+
+		const std::string texturePath = kFixtureDirectory + "/shared.png";
+		TEST_CHECK(loader.ProcessUntilReady({ loader.Request(AssetType::Texture, "shared.png") }));
+		TEST_CHECK(!loader.GetQueue().Claim(texturePath));
+
+		// 解放後に Forget すれば、次のリクエストで読み込み直す
+		loader.GetQueue().Forget(texturePath);
+		TEST_CHECK(loader.GetQueue().FindHandle(texturePath) == nullptr);
+		TEST_CHECK(loader.ProcessUntilReady({ loader.Request(AssetType::Texture, "shared.png") }));
+		TEST_CHECK(loader.GetTextureDecodeCount() == 2);
+		TEST_CHECK(loader.GetQueue().GetRequestedCount() == 2);
+		TEST_CHECK(loader.GetQueue().GetCompletedCount() == 2);
+	}
+
+	void TestFinalizeDropsPendingWork()
+	{
+		// 登録せずに終了しても、ワーカーは止まり進捗は初期化される
+		FixtureLoader loader;
+		loader.Initialize(2);
+		loader.Request(AssetType::Model, "triangle.obj");
+		loader.Request(AssetType::Sound, "tone.wav");
+		loader.GetQueue().Finalize();
+		TEST_CHECK(loader.GetQueue().GetWorkerCount() == 0);
+		TEST_CHECK(loader.GetQueue().GetRequestedCount() == 0);
+		TEST_CHECK(loader.GetQueue().FindHandle(kFixtureDirectory + "/triangle.obj") == nullptr);
+		TEST_CHECK(loader.GetRegistry().models.empty());
+
+		// 終了後は再び初期化できる
+		loader.Initialize(1);
+		TEST_CHECK(loader.ProcessUntilReady({ loader.Request(AssetType::Sound, "tone.wav") }));
+		TEST_CHECK(loader.GetRegistry().sounds.size() == 1);
+	}
+}
+
+int main()
+{
+	TestObjFixture();
+	TestLoadFixtureSet();
+	TestModelClaimsTexture();
+	TestLoadedAssetCompletesImmediately();
+	TestForgetReloads();
+	TestFinalizeDropsPendingWork();
+	return TestCommon::Finish("AssetDecodeQueueTest");
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+//
+// BenchCommon
+// - project/tests のマイクロベンチマークで使う計測と表示。
+// - 既定では時間をかけて計測し、"--quick" を付けると反復を減らして動作確認だけ行う（ctest はこちらで実行する）。
+//
+namespace BenchCommon {
+
+	// コマンドライン引数に "--quick" があるか
+	inline bool IsQuick(int argc, char** argv)
+	{
+		for (int i = 1; i < argc; ++i) {
+			if (std::strcmp(argv[i], "--quick") == 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// function を repeatCount 回実行し、最も速かった 1 回の時間（ナノ秒）を返す
+	template <class Function>
+	double MeasureBestNanoseconds(int repeatCount, Function&& function)
+	{
+		double best = 0.0;
+		for (int i = 0; i < repeatCount; ++i) {
+			const auto start = std::chrono::steady_clock::now();
+			function();
+			const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			best = (i == 0) ? elapsed : (std::min)(best, elapsed);
+		}
+		return best;
+	}
+
+	// 1 行分の結果（1 回あたりの時間と、全体の時間）
+	inline void Report(const char* name, double totalNanoseconds, double operationCount)
+	{
+		std::printf("  %-40s %10.1f ns/op %12.3f ms total\n", name, totalNanoseconds / operationCount, totalNanoseconds / 1e6);
+	}
+}
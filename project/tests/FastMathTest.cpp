@@ -0,0 +1,297 @@
+#include "TestCommon.h"
+#include "FastMath.h"
+#include "MathSimd.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+//
+// FastMathTest
+// - FastSinCos / FastExp / FastReciprocalSqrt を倍精度の libm（std::sin / std::cos / std::exp / 1 / std::sqrt）と比べ、
+//   FastMath.h に書いた誤差の上限に収まることを確かめる。
+//   * sin / cos : [-8192, 8192] を細かく走査し、絶対誤差 1e-7 以内。それより大きい角度（libm に任せる要素）も同じ上限で、
+//                 4 要素の中に範囲内と範囲外が混ざる場合も確かめる
+//   * exp       : クランプしない範囲 [-87.3, 88.0] を走査し、相対誤差 1e-7 以内
+//   * rsqrt     : 正の正規化数の全域を走査し、相対誤差 3e-7 以内
+// - SIMD は 4 要素ずつなので、要素数 1〜3 と 4 の倍数 + 1〜3（端数をスカラーで計算する）、結果を入力と同じ配列に書く場合も確かめる。
+// - 範囲外の入力：NaN は NaN のまま、exp は [-87.3, 88.0] にクランプする（-inf は FLT_MIN 付近、+inf は有限）。
+// - CMake では既定（SSE2）、MATH_FORCE_SCALAR（FastMathTestScalar）、MATH_EXACT_TRANSCENDENTAL（FastMathTestExact）でビルドする。
+//   MATH_EXACT_TRANSCENDENTAL のときは単精度の libm（std::sin(float) など）とビット単位で一致することも確かめる。
+//
+namespace {
+	constexpr double kSinCosTolerance = 1e-7;
+	constexpr double kExpTolerance = 1e-7;
+	constexpr double kReciprocalSqrtTolerance = 3e-7;
+
+	constexpr float kMaxSinCosAngle = 8192.0f;
+	constexpr float kExpMin = -87.3365f;
+	constexpr float kExpMax = 88.0f;
+
+	const char* GetPathName()
+	{
+#if defined(MATH_EXACT_TRANSCENDENTAL)
+		return "exact (libm)";
+#elif defined(MATH_USE_SSE)
+		return "SSE2";
+#else
+		return "scalar";
+#endif
+	}
+
+	// 誤差の最大値と、その入力
+	struct ErrorStat {
+		double maxError = 0.0;
+		float worstInput = 0.0f;
+
+		void Add(double error, float input)
+		{
+			if (error > maxError) {
+				maxError = error;
+				worstInput = input;
+			}
+		}
+	};
+
+	// 入力の配列を作る（[minValue, maxValue] を等間隔に count 個と、乱数で count 個）
+	std::vector<float> MakeSweep(float minValue, float maxValue, size_t count, uint32_t seed)
+	{
+		std::vector<float> values;
+		values.reserve(count * 2);
+		for (size_t i = 0; i < count; ++i) {
+			const double t = static_cast<double>(i) / static_cast<double>(count - 1);
+			values.push_back(static_cast<float>(minValue + (static_cast<double>(maxValue) - minValue) * t));
+		}
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> distribution(minValue, maxValue);
+		for (size_t i = 0; i < count; ++i) {
+			values.push_back(distribution(random));
+		}
+		return values;
+	}
+
+	// ===== 誤差の計測 =====
+
+	void MeasureSinCos(const std::vector<float>& angles, ErrorStat& sine, ErrorStat& cosine)
+	{
+		std::vector<float> sines(angles.size());
+		std::vector<float> cosines(angles.size());
+		Math::FastSinCos(angles.data(), sines.data(), cosines.data(), angles.size());
+		for (size_t i = 0; i < angles.size(); ++i) {
+			sine.Add(std::abs(sines[i] - std::sin(static_cast<double>(angles[i]))), angles[i]);
+			cosine.Add(std::abs(cosines[i] - std::cos(static_cast<double>(angles[i]))), angles[i]);
+		}
+	}
+
+	void MeasureExp(const std::vector<float>& values, ErrorStat& stat)
+	{
+		std::vector<float> results(values.size());
+		Math::FastExp(values.data(), results.data(), values.size());
+		for (size_t i = 0; i < values.size(); ++i) {
+			const double expected = std::exp(static_cast<double>(values[i]));
+			stat.Add(std::abs(results[i] - expected) / expected, values[i]);
+		}
+	}
+
+	void MeasureReciprocalSqrt(const std::vector<float>& values, ErrorStat& stat)
+	{
+		std::vector<float> results(values.size());
+		Math::FastReciprocalSqrt(values.data(), results.data(), values.size());
+		for (size_t i = 0; i < values.size(); ++i) {
+			const double expected = 1.0 / std::sqrt(static_cast<double>(values[i]));
+			stat.Add(std::abs(results[i] - expected) / expected, values[i]);
+			// 1 要素版も同じ上限
+			stat.Add(std::abs(Math::FastReciprocalSqrt(values[i]) - expected) / expected, values[i]);
+		}
+	}
+
+	// ===== テスト =====
+
+	void TestSinCosSweep()
+	{
+		ErrorStat sine;
+		ErrorStat cosine;
+		MeasureSinCos(MakeSweep(-kMaxSinCosAngle, kMaxSinCosAngle, 1 << 20, 11), sine, cosine);
+		// 小さい角度（多項式だけで求まる範囲）は細かく
+		MeasureSinCos(MakeSweep(-8.0f, 8.0f, 1 << 18, 12), sine, cosine);
+		std::printf("  FastSinCos  |x| <= 8192 : sin %.3g (x = %g), cos %.3g (x = %g)\n",
+			sine.maxError, sine.worstInput, cosine.maxError, cosine.worstInput);
+		TEST_CHECK(sine.maxError <= kSinCosTolerance);
+		TEST_CHECK(cosine.maxError <= kSinCosTolerance);
+
+		// 8192 を超える角度は libm で計算する（4 要素の中に 1 つだけ混ざる場合も）
+		ErrorStat largeSine;
+		ErrorStat largeCosine;
+		std::vector<float> large = { 8192.0f, std::nextafter(8192.0f, 1e9f), -8193.0f, 10000.5f,
+			1.0f, 2.0f, 3.0e4f, 4.0f, -1.0e6f, 123456.7f, 3.0e7f, -1.0e30f, 5.0f };
+		for (float angle : MakeSweep(-1.0e6f, 1.0e6f, 4096, 13)) {
+			large.push_back(std::abs(angle) > kMaxSinCosAngle ? angle : angle + std::copysign(kMaxSinCosAngle, angle));
+		}
+		MeasureSinCos(large, largeSine, largeCosine);
+		std::printf("  FastSinCos  |x| > 8192 (mixed) : sin %.3g (x = %g), cos %.3g (x = %g)\n",
+			largeSine.maxError, largeSine.worstInput, largeCosine.maxError, largeCosine.worstInput);
+		TEST_CHECK(largeSine.maxError <= kSinCosTolerance);
+		TEST_CHECK(largeCosine.maxError <= kSinCosTolerance);
+	}
+
+	void TestExpSweep()
+	{
+		ErrorStat stat;
+		MeasureExp(MakeSweep(kExpMin, kExpMax, 1 << 20, 21), stat);
+		// パーティクルのフェードで使う範囲は細かく
+		MeasureExp(MakeSweep(-10.0f, 10.0f, 1 << 18, 22), stat);
+		std::printf("  FastExp     [-87.3, 88] : relative %.3g (x = %g)\n", stat.maxError, stat.worstInput);
+		TEST_CHECK(stat.maxError <= kExpTolerance);
+	}
+
+	void TestReciprocalSqrtSweep()
+	{
+		// 指数部の全域（FLT_MIN〜FLT_MAX）を対数で等間隔に
+		std::vector<float> values;
+		for (int i = 0; i < (1 << 18); ++i) {
+			const double t = static_cast<double>(i) / ((1 << 18) - 1);
+			values.push_back(static_cast<float>(std::exp(std::log(static_cast<double>(FLT_MIN)) * (1.0 - t) + std::log(static_cast<double>(FLT_MAX) * 0.999) * t)));
+		}
+		const std::vector<float> unit = MakeSweep(0.25f, 4.0f, 1 << 16, 31);
+		values.insert(values.end(), unit.begin(), unit.end());
+
+		ErrorStat stat;
+		MeasureReciprocalSqrt(values, stat);
+		std::printf("  FastReciprocalSqrt      : relative %.3g (x = %g)\n", stat.maxError, stat.worstInput);
+		TEST_CHECK(stat.maxError <= kReciprocalSqrtTolerance);
+	}
+
+	// 要素数が 4 の倍数でないとき（端数はスカラー）と、結果を入力と同じ配列に書くとき
+	void TestTailLengths()
+	{
+		const std::vector<float> source = MakeSweep(-20.0f, 20.0f, 64, 41);
+		for (size_t count : { 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 13, 14, 15 }) {
+			for (size_t offset : { 0, 1, 3 }) {
+				const float* angles = source.data() + offset;
+
+				// 配列の後ろに書き込んでいないことを確かめるための番兵
+				std::vector<float> sines(count + 1, -7.0f);
+				std::vector<float> cosines(count + 1, -7.0f);
+				std::vector<float> exps(count + 1, -7.0f);
+				std::vector<float> reciprocalSqrts(count + 1, -7.0f);
+				std::vector<float> positives(count);
+				for (size_t i = 0; i < count; ++i) {
+					positives[i] = std::abs(angles[i]) + 0.5f;
+				}
+
+				Math::FastSinCos(angles, sines.data(), cosines.data(), count);
+				Math::FastExp(angles, exps.data(), count);
+				Math::FastReciprocalSqrt(positives.data(), reciprocalSqrts.data(), count);
+				for (size_t i = 0; i < count; ++i) {
+					const double x = angles[i];
+					TEST_CHECK(std::abs(sines[i] - std::sin(x)) <= kSinCosTolerance);
+					TEST_CHECK(std::abs(cosines[i] - std::cos(x)) <= kSinCosTolerance);
+					TEST_CHECK(std::abs(exps[i] - std::exp(x)) <= kExpTolerance * std::exp(x));
+					const double rsqrt = 1.0 / std::sqrt(static_cast<double>(positives[i]));
+					TEST_CHECK(std::abs(reciprocalSqrts[i] - rsqrt) <= kReciprocalSqrtTolerance * rsqrt);
+				}
+				TEST_CHECK(sines[count] == -7.0f && cosines[count] == -7.0f);
+				TEST_CHECK(exps[count] == -7.0f && reciprocalSqrts[count] == -7.0f);
+
+				// 入力と同じ配列に結果を書く
+				std::vector<float> inPlace(angles, angles + count);
+				Math::FastExp(inPlace.data(), inPlace.data(), count);
+				for (size_t i = 0; i < count; ++i) {
+					TEST_CHECK(inPlace[i] == exps[i]);
+				}
+				std::vector<float> inPlaceSines(angles, angles + count);
+				std::vector<float> otherCosines(count);
+				Math::FastSinCos(inPlaceSines.data(), inPlaceSines.data(), otherCosines.data(), count);
+				for (size_t i = 0; i < count; ++i) {
+					TEST_CHECK(inPlaceSines[i] == sines[i]);
+				}
+			}
+		}
+
+		// 要素数 0 は何もしない
+		Math::FastSinCos(nullptr, nullptr, nullptr, 0);
+		Math::FastExp(nullptr, nullptr, 0);
+		Math::FastReciprocalSqrt(nullptr, nullptr, 0);
+	}
+
+	// NaN・無限大・クランプの範囲外（4 要素の SIMD とスカラーの端数の両方で）
+	void TestSpecialValues()
+	{
+		const float nan = std::numeric_limits<float>::quiet_NaN();
+		const float infinity = std::numeric_limits<float>::infinity();
+		// 5 要素なので先頭 4 つは SIMD、最後の 1 つはスカラーで計算する
+		for (size_t position = 0; position < 5; ++position) {
+			std::vector<float> values = { 0.5f, -1.0f, 2.0f, 3.0f, -0.25f };
+			values[position] = nan;
+			std::vector<float> exps(values.size());
+			std::vector<float> sines(values.size());
+			std::vector<float> cosines(values.size());
+			Math::FastExp(values.data(), exps.data(), values.size());
+			Math::FastSinCos(values.data(), sines.data(), cosines.data(), values.size());
+			for (size_t i = 0; i < values.size(); ++i) {
+				if (i == position) {
+					TEST_CHECK(std::isnan(exps[i]));
+					TEST_CHECK(std::isnan(sines[i]) && std::isnan(cosines[i]));
+				}
+				else {
+					TEST_CHECK(std::abs(exps[i] - std::exp(static_cast<double>(values[i]))) <= kExpTolerance * std::exp(static_cast<double>(values[i])));
+					TEST_CHECK(std::abs(sines[i] - std::sin(static_cast<double>(values[i]))) <= kSinCosTolerance);
+				}
+			}
+		}
+
+		// exp は [-87.3, 88.0] にクランプする（-inf や小さすぎる値は FLT_MIN 付近、+inf や大きすぎる値は有限）
+		const std::vector<float> outside = { -infinity, -1000.0f, -88.0f, kExpMin, 89.0f, 1000.0f, infinity, -100.0f, 100.0f };
+		std::vector<float> exps(outside.size());
+		Math::FastExp(outside.data(), exps.data(), outside.size());
+		for (size_t i = 0; i < outside.size(); ++i) {
+			const double expected = std::exp(static_cast<double>(std::clamp(outside[i], kExpMin, kExpMax)));
+			TEST_CHECK(std::isfinite(exps[i]) && exps[i] >= FLT_MIN);
+			TEST_CHECK(std::abs(exps[i] - expected) <= kExpTolerance * expected);
+		}
+
+		// sin / cos の無限大は NaN（libm と同じ）
+		const float infinities[] = { infinity, -infinity };
+		float sines[2];
+		float cosines[2];
+		Math::FastSinCos(infinities, sines, cosines, 2);
+		TEST_CHECK(std::isnan(sines[0]) && std::isnan(cosines[0]) && std::isnan(sines[1]) && std::isnan(cosines[1]));
+	}
+
+#ifdef MATH_EXACT_TRANSCENDENTAL
+	// libm に切り替えたときは単精度の libm と同じ結果になる
+	void TestExactMatchesLibm()
+	{
+		const std::vector<float> values = MakeSweep(-80.0f, 80.0f, 4099, 51);
+		std::vector<float> sines(values.size());
+		std::vector<float> cosines(values.size());
+		std::vector<float> exps(values.size());
+		Math::FastSinCos(values.data(), sines.data(), cosines.data(), values.size());
+		Math::FastExp(values.data(), exps.data(), values.size());
+		for (size_t i = 0; i < values.size(); ++i) {
+			TEST_CHECK(sines[i] == std::sin(values[i]));
+			TEST_CHECK(cosines[i] == std::cos(values[i]));
+			TEST_CHECK(exps[i] == std::exp(values[i]));
+			const float positive = std::abs(values[i]) + 1.0f;
+			TEST_CHECK(Math::FastReciprocalSqrt(positive) == 1.0f / std::sqrt(positive));
+		}
+	}
+#endif
+}
+
+int main()
+{
+	std::printf("FastMathTest: %s\n", GetPathName());
+	TestSinCosSweep();
+	TestExpSweep();
+	TestReciprocalSqrtSweep();
+	TestTailLengths();
+	TestSpecialValues();
+#ifdef MATH_EXACT_TRANSCENDENTAL
+	TestExactMatchesLibm();
+#endif
+	return TestCommon::Finish("FastMathTest");
+}
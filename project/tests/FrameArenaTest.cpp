@@ -0,0 +1,281 @@
+#include "TestCommon.h"
+#include "FrameArena.h"
+#include "TextureResidency.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+//
+// FrameArenaTest
+// - FrameArena の確保（アラインメント）、容量を超えたときのヒープへの逃がし、
+//   二重バッファの切り替え（2 回目の BeginFrame で空になり、逃がしたブロックも解放される）を確かめる。
+// - グローバルな operator new / delete をこのテストで置き換えて呼び出し回数を数え、
+//   フレームアリーナに移した呼び出し元（TextureResidency::CollectEvictions、ログ文字列の組み立て）の
+//   1 フレームあたりのヒープ確保回数を、アリーナの初期化前（既定のリソース）と後で比べて表示する。
+//
+using namespace MyEngine;
+
+namespace {
+	// operator new / delete の呼び出し回数（アラインメント指定付きは別に数える）
+	std::atomic<uint64_t> gAllocationCount = 0;
+	std::atomic<uint64_t> gAlignedAllocationCount = 0;
+	std::atomic<uint64_t> gAlignedFreeCount = 0;
+
+	void* AllocateCounted(size_t size)
+	{
+		gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+		void* pointer = std::malloc(size == 0 ? 1 : size);
+		if (pointer == nullptr) {
+			throw std::bad_alloc();
+		}
+		return pointer;
+	}
+
+	void* AllocateAlignedCounted(size_t size, std::align_val_t alignment)
+	{
+		gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+		gAlignedAllocationCount.fetch_add(1, std::memory_order_relaxed);
+		// aligned_alloc はサイズがアラインメントの倍数である必要がある
+		const size_t align = static_cast<size_t>(alignment);
+		const size_t roundedSize = ((size == 0 ? 1 : size) + align - 1) / align * align;
+		void* pointer = std::aligned_alloc(align, roundedSize);
+		if (pointer == nullptr) {
+			throw std::bad_alloc();
+		}
+		return pointer;
+	}
+
+	void FreeAlignedCounted(void* pointer)
+	{
+		if (pointer != nullptr) {
+			gAlignedFreeCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		std::free(pointer);
+	}
+}
+
+void* operator new(size_t size) { return AllocateCounted(size); }
+void* operator new[](size_t size) { return AllocateCounted(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return AllocateAlignedCounted(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return AllocateAlignedCounted(size, alignment); }
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { FreeAlignedCounted(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { FreeAlignedCounted(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { FreeAlignedCounted(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { FreeAlignedCounted(pointer); }
+
+namespace {
+	constexpr size_t kSmallCapacity = 256;
+
+	bool IsAligned(const void* pointer, size_t alignment)
+	{
+		return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+	}
+
+	// 確保したポインタが、最初に確保した位置から容量の範囲内か（バッファの中から確保されたか）
+	bool IsInsideBuffer(const void* pointer, size_t bytes, const void* bufferBegin, size_t capacity)
+	{
+		const uintptr_t begin = reinterpret_cast<uintptr_t>(bufferBegin);
+		const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+		return address >= begin && address + bytes <= begin + capacity;
+	}
+
+	// 1〜256 バイトのアラインメントで交互に確保しても、すべて揃っていて重ならない
+	void TestAllocationIsAligned()
+	{
+		FrameArena arena;
+		arena.Initialize(64 * 1024);
+		std::pmr::memory_resource* resource = arena.GetResource();
+		TEST_CHECK(resource == &arena);
+
+		// 先頭（オフセット 0）の位置を基準にする
+		std::byte* bufferBegin = static_cast<std::byte*>(resource->allocate(1, 1));
+		std::byte* previousEnd = bufferBegin + 1;
+
+		const size_t alignments[] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+		for (int round = 0; round < 4; ++round) {
+			for (size_t alignment : alignments) {
+				// サイズを半端にして、次の確保の位置をずらす
+				const size_t bytes = alignment + 3;
+				std::byte* pointer = static_cast<std::byte*>(resource->allocate(bytes, alignment));
+				TEST_CHECK(IsAligned(pointer, alignment));
+				TEST_CHECK(pointer >= previousEnd);
+				TEST_CHECK(IsInsideBuffer(pointer, bytes, bufferBegin, arena.GetCapacity()));
+				std::memset(pointer, 0xCD, bytes);
+				previousEnd = pointer + bytes;
+			}
+		}
+		TEST_CHECK(arena.GetUsedBytes() == static_cast<size_t>(previousEnd - bufferBegin));
+		TEST_CHECK(arena.GetOverflowBytes() == 0);
+
+		// pmr コンテナ越しでも要素の型のアラインメントが守られる
+		struct alignas(64) Aligned64 {
+			float values[16];
+		};
+		FrameVector<Aligned64> vector(arena.GetResource());
+		vector.resize(3);
+		TEST_CHECK(IsAligned(vector.data(), 64));
+
+		arena.Finalize();
+	}
+
+	// 容量を超えた確保はヒープへ逃がし、使用量は容量を超えない
+	void TestOverflowFallsBackToHeap()
+	{
+		FrameArena arena;
+		arena.Initialize(kSmallCapacity);
+		std::pmr::memory_resource* resource = arena.GetResource();
+
+		std::byte* inside = static_cast<std::byte*>(resource->allocate(200, 8));
+		TEST_CHECK(arena.GetUsedBytes() == 200);
+
+		// 残り 56 バイトに収まらない → ヒープ
+		const uint64_t alignedAllocationsBefore = gAlignedAllocationCount.load();
+		std::byte* overflow = static_cast<std::byte*>(resource->allocate(100, 64));
+		TEST_CHECK(gAlignedAllocationCount.load() == alignedAllocationsBefore + 1);
+		TEST_CHECK(IsAligned(overflow, 64));
+		TEST_CHECK(!IsInsideBuffer(overflow, 100, inside, kSmallCapacity));
+		TEST_CHECK(arena.GetUsedBytes() == 200);
+		TEST_CHECK(arena.GetOverflowBytes() == 100);
+		std::memset(overflow, 0xAB, 100);
+
+		// 容量そのものより大きい確保もヒープへ
+		std::byte* large = static_cast<std::byte*>(resource->allocate(kSmallCapacity * 4, 16));
+		TEST_CHECK(IsAligned(large, 16));
+		TEST_CHECK(arena.GetOverflowBytes() == 100 + kSmallCapacity * 4);
+		std::memset(large, 0xEF, kSmallCapacity * 4);
+
+		// 収まる大きさならバッファの残りから確保する
+		std::byte* tail = static_cast<std::byte*>(resource->allocate(56, 1));
+		TEST_CHECK(tail == inside + 200);
+		TEST_CHECK(arena.GetUsedBytes() == kSmallCapacity);
+
+		// deallocate は何もしない（ヒープに逃がしたものも BeginFrame まで残る）
+		const uint64_t alignedFreesBefore = gAlignedFreeCount.load();
+		resource->deallocate(overflow, 100, 64);
+		TEST_CHECK(gAlignedFreeCount.load() == alignedFreesBefore);
+		TEST_CHECK(arena.GetOverflowBytes() == 100 + kSmallCapacity * 4);
+
+		arena.Finalize();
+		TEST_CHECK(gAlignedFreeCount.load() == alignedFreesBefore + 2);
+	}
+
+	// 前フレームのデータは次のフレームの間は残り、2 回目の BeginFrame でバッファが空になる
+	void TestSecondBeginFrameResetsBuffer()
+	{
+		FrameArena arena;
+		arena.Initialize(kSmallCapacity);
+		std::pmr::memory_resource* resource = arena.GetResource();
+
+		// フレーム 0（バッファ 0）：バッファ内に 1 つ、ヒープに 2 つ
+		char* frame0 = static_cast<char*>(resource->allocate(64, 8));
+		std::memcpy(frame0, "frame0", 7);
+		void* overflow32 = resource->allocate(kSmallCapacity, 32);
+		void* overflow128 = resource->allocate(kSmallCapacity, 128);
+		TEST_CHECK(IsAligned(overflow32, 32) && IsAligned(overflow128, 128));
+		TEST_CHECK(arena.GetUsedBytes() == 64);
+		TEST_CHECK(arena.GetOverflowBytes() == kSmallCapacity * 2);
+
+		// フレーム 1（バッファ 1）：フレーム 0 のデータもヒープのブロックもまだ有効
+		const uint64_t alignedFreesBefore = gAlignedFreeCount.load();
+		arena.BeginFrame();
+		TEST_CHECK(arena.GetUsedBytes() == 0);
+		TEST_CHECK(arena.GetOverflowBytes() == 0);
+		TEST_CHECK(arena.GetPeakBytes() == 64 + kSmallCapacity * 2);
+		TEST_CHECK(gAlignedFreeCount.load() == alignedFreesBefore);
+		char* frame1 = static_cast<char*>(resource->allocate(64, 8));
+		std::memcpy(frame1, "frame1", 7);
+		TEST_CHECK(frame1 != frame0);
+		TEST_CHECK(std::strcmp(frame0, "frame0") == 0);
+
+		// フレーム 2（バッファ 0 に戻る）：空にされ、ヒープに逃がした 2 つが解放される
+		arena.BeginFrame();
+		TEST_CHECK(gAlignedFreeCount.load() == alignedFreesBefore + 2);
+		TEST_CHECK(arena.GetUsedBytes() == 0);
+		TEST_CHECK(arena.GetOverflowBytes() == 0);
+		TEST_CHECK(std::strcmp(frame1, "frame1") == 0);
+		char* frame2 = static_cast<char*>(resource->allocate(64, 8));
+		TEST_CHECK(frame2 == frame0);
+
+		// 最大使用量は小さいフレームで下がらない
+		TEST_CHECK(arena.GetPeakBytes() == 64 + kSmallCapacity * 2);
+
+		arena.Finalize();
+		TEST_CHECK(gAlignedFreeCount.load() == alignedFreesBefore + 2);
+	}
+
+	// 初期化前は既定のリソース（new / delete）を返す
+	void TestUninitializedUsesDefaultResource()
+	{
+		FrameArena arena;
+		TEST_CHECK(!arena.IsInitialized());
+		TEST_CHECK(arena.GetResource() == std::pmr::get_default_resource());
+		arena.BeginFrame();
+		TEST_CHECK(arena.GetUsedBytes() == 0);
+	}
+
+	// フレームアリーナに移した呼び出し元を 1 フレーム分動かす
+	// （TextureManager の追い出し判定と、読み込みのたびのログ文字列）
+	void RunFrameWorkload(const TextureResidency& residency)
+	{
+		constexpr int kLogLineCount = 4;
+		for (int i = 0; i < kLogLineCount; ++i) {
+			FrameVector<uint32_t> evictions = residency.CollectEvictions(1024, 0);
+			FrameString message(FrameArena::GetInstance()->GetResource());
+			message += "[TextureManager] evicted ";
+			message += std::to_string(evictions.size()).c_str();
+			message += " textures for resources/textures/some_long_texture_name.png\n";
+			TEST_CHECK(evictions.size() == 9);
+		}
+	}
+
+	// 1 フレームあたりのヒープ確保回数（アリーナの初期化前と後）
+	void TestHeapAllocationsPerFrame()
+	{
+		// 参照を手放したテクスチャが 16 枚あり、次の読み込み（1 枚分）で 9 枚を追い出す状態
+		TextureResidency residency;
+		residency.SetBudget(1024 * 8);
+		for (uint32_t id = 0; id < 16; ++id) {
+			residency.Add(id, 1024);
+		}
+
+		constexpr int kFrameCount = 8;
+		FrameArena* arena = FrameArena::GetInstance();
+
+		const uint64_t beforeStart = gAllocationCount.load();
+		for (int frame = 0; frame < kFrameCount; ++frame) {
+			arena->BeginFrame();
+			RunFrameWorkload(residency);
+		}
+		const double before = static_cast<double>(gAllocationCount.load() - beforeStart) / kFrameCount;
+
+		arena->Initialize(64 * 1024);
+		const uint64_t afterStart = gAllocationCount.load();
+		for (int frame = 0; frame < kFrameCount; ++frame) {
+			arena->BeginFrame();
+			RunFrameWorkload(residency);
+		}
+		const double after = static_cast<double>(gAllocationCount.load() - afterStart) / kFrameCount;
+		TEST_CHECK(arena->GetOverflowBytes() == 0);
+		arena->Finalize();
+
+		std::printf("FrameArenaTest: heap allocations / frame : default resource %.1f -> frame arena %.1f\n", before, after);
+		TEST_CHECK(before > 0.0);
+		TEST_CHECK(after == 0.0);
+	}
+}
+
+int main()
+{
+	TestAllocationIsAligned();
+	TestOverflowFallsBackToHeap();
+	TestSecondBeginFrameResetsBuffer();
+	TestUninitializedUsesDefaultResource();
+	TestHeapAllocationsPerFrame();
+	return TestCommon::Finish("FrameArenaTest");
+}
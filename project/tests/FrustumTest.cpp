@@ -0,0 +1,227 @@
+#include "TestCommon.h"
+#include "Frustum.h"
+#include "Inverse.h"
+#include "MakeAffineMatrix.h"
+#include "MakePerspectiveFovMatrix.h"
+#include "MathSimd.h"
+#include "Multiply.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//
+// FrustumTest
+// - MakeFrustum / IsVisible / CullSpheres を確かめる（D3D を使わない）。
+//   * 平面の取り出し：近平面が D3D のクリップ空間（0 <= z <= w）の z = near になっていること（OpenGL の -w <= z だと
+//     near の半分ほどの位置になる）。点の判定がクリップ座標での判定と一致すること
+//   * 各平面にまたがる球：平面との距離が -半径 をわずかに上回れば残り、わずかに下回れば消える。SIMD の 4 つのどのレーンでも同じ
+//   * CullSpheres の 4 つずつの判定と端数のスカラーの判定が、1 つずつの IsVisible と一致する（4 の倍数でない数・境界付近の球）
+// - CMake では既定（SSE2）と MATH_FORCE_SCALAR（FrustumTestScalar）でビルドする。
+//
+namespace {
+	constexpr float kNearClip = 0.5f;
+	constexpr float kFarClip = 200.0f;
+
+	// 回したカメラのビュープロジェクション行列
+	Matrix4x4 MakeViewProjection(const Vector3& cameraRotate, const Vector3& cameraTranslate)
+	{
+		const Matrix4x4 view = Math::InverseAffine(Math::MakeAffineMatrix({ 1.0f, 1.0f, 1.0f }, cameraRotate, cameraTranslate));
+		return Math::Multiply(view, Math::MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, kNearClip, kFarClip));
+	}
+
+	// 点 v（行ベクトル）をクリップ座標にする
+	Vector4 ToClip(const Vector3& v, const Matrix4x4& m)
+	{
+		return {
+			v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + m.m[3][0],
+			v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + m.m[3][1],
+			v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + m.m[3][2],
+			v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + m.m[3][3]
+		};
+	}
+
+	float PlaneDistance(const Vector4& plane, const Vector3& point)
+	{
+		return plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w;
+	}
+
+	// 1 つずつ IsVisible で判定した結果
+	std::vector<uint32_t> CullOneByOne(const Frustum& frustum, const BoundingSphere* spheres, size_t count)
+	{
+		std::vector<uint32_t> indices;
+		for (size_t i = 0; i < count; ++i) {
+			if (Math::IsVisible(frustum, spheres[i])) {
+				indices.push_back(static_cast<uint32_t>(i));
+			}
+		}
+		return indices;
+	}
+
+	std::vector<uint32_t> Cull(const Frustum& frustum, const BoundingSphere* spheres, size_t count)
+	{
+		std::vector<uint32_t> indices(count + 1, UINT32_MAX);
+		const size_t visibleCount = Math::CullSpheres(frustum, spheres, count, indices.data());
+		// 見える数より後ろには書き込まない
+		TEST_CHECK(indices[visibleCount] == UINT32_MAX);
+		indices.resize(visibleCount);
+		return indices;
+	}
+
+	// 近平面・遠平面は D3D のクリップ空間の z = near, z = far
+	void TestPlaneExtraction()
+	{
+		const Frustum frustum = Math::MakeFrustum(Math::MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, kNearClip, kFarClip));
+		const Vector4& nearPlane = frustum.planes[4];
+		const Vector4& farPlane = frustum.planes[5];
+		TEST_CHECK(std::abs(nearPlane.x) <= 1e-6f && std::abs(nearPlane.y) <= 1e-6f && std::abs(nearPlane.z - 1.0f) <= 1e-6f);
+		TEST_CHECK(std::abs(nearPlane.w + kNearClip) <= 1e-5f);
+		TEST_CHECK(std::abs(farPlane.z + 1.0f) <= 1e-6f);
+		TEST_CHECK(std::abs(farPlane.w - kFarClip) <= 1e-3f);
+
+		// 平面は正規化されている
+		for (const Vector4& plane : frustum.planes) {
+			TEST_CHECK(std::abs(std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z) - 1.0f) <= 1e-6f);
+		}
+
+		// near の 0.75 倍の位置は映らない（OpenGL の -w <= z で取り出すと近平面は near の約半分になり、ここが残ってしまう）
+		TEST_CHECK(!Math::IsVisible(frustum, { { 0.0f, 0.0f, kNearClip * 0.75f }, 0.0f }));
+		TEST_CHECK(!Math::IsVisible(frustum, { { 0.0f, 0.0f, kNearClip * 0.99f }, 0.0f }));
+		TEST_CHECK(Math::IsVisible(frustum, { { 0.0f, 0.0f, kNearClip * 1.01f }, 0.0f }));
+		TEST_CHECK(Math::IsVisible(frustum, { { 0.0f, 0.0f, kFarClip * 0.99f }, 0.0f }));
+		TEST_CHECK(!Math::IsVisible(frustum, { { 0.0f, 0.0f, kFarClip * 1.01f }, 0.0f }));
+		// カメラの後ろ
+		TEST_CHECK(!Math::IsVisible(frustum, { { 0.0f, 0.0f, -10.0f }, 0.0f }));
+	}
+
+	// 点の判定はクリップ座標での判定（-w <= x <= w, -w <= y <= w, 0 <= z <= w）と一致する
+	void TestPointsMatchClipSpace()
+	{
+		const Matrix4x4 viewProjection = MakeViewProjection({ 0.3f, -0.8f, 0.1f }, { 5.0f, 3.0f, -20.0f });
+		const Frustum frustum = Math::MakeFrustum(viewProjection);
+		std::mt19937 random(5005);
+		std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+		int checkedCount = 0;
+		int visibleCount = 0;
+		for (int i = 0; i < 20000; ++i) {
+			const Vector3 point = { position(random), position(random), position(random) };
+			const Vector4 clip = ToClip(point, viewProjection);
+			// クリップ座標で境界のすぐ近くにある点は丸め誤差で結果が分かれるので除く
+			const float margin = 1e-3f * std::abs(clip.w) + 1e-3f;
+			const float distances[] = { clip.w + clip.x, clip.w - clip.x, clip.w + clip.y, clip.w - clip.y, clip.z, clip.w - clip.z };
+			bool isInside = true;
+			bool isNearBoundary = false;
+			for (float distance : distances) {
+				isInside = isInside && distance >= 0.0f;
+				isNearBoundary = isNearBoundary || std::abs(distance) < margin;
+			}
+			if (isNearBoundary) {
+				continue;
+			}
+			TEST_CHECK(Math::IsVisible(frustum, { point, 0.0f }) == isInside);
+			++checkedCount;
+			visibleCount += isInside ? 1 : 0;
+		}
+		// 見える点と見えない点の両方を確かめている
+		TEST_CHECK(checkedCount > 15000 && visibleCount > 100);
+	}
+
+	// 各平面にまたがる球（4 つのどのレーンに置いても、端数でも同じ）
+	void TestSpheresStraddlingEachPlane()
+	{
+		const Matrix4x4 viewProjection = MakeViewProjection({ -0.2f, 0.6f, 0.0f }, { -4.0f, 2.0f, 7.0f });
+		const Frustum frustum = Math::MakeFrustum(viewProjection);
+		const Matrix4x4 inverseViewProjection = Math::Inverse(viewProjection);
+
+		// 視錐台の中の点（クリップ空間の中心をワールドに戻す）
+		const Vector4 center = Math::Multiply(inverseViewProjection, Vector4{ 0.0f, 0.0f, 0.5f, 1.0f });
+		const Vector3 inside = { center.x / center.w, center.y / center.w, center.z / center.w };
+		for (const Vector4& plane : frustum.planes) {
+			TEST_CHECK(PlaneDistance(plane, inside) > 0.0f);
+		}
+
+		constexpr float kRadius = 0.05f;
+		constexpr float kGap = 1e-3f;
+		for (size_t planeIndex = 0; planeIndex < kFrustumPlaneCount; ++planeIndex) {
+			// 中の点を平面に下ろした点から、外向きに (半径 -+ kGap) ずらす
+			const Vector4& plane = frustum.planes[planeIndex];
+			const float distance = PlaneDistance(plane, inside);
+			const Vector3 onPlane = { inside.x - plane.x * distance, inside.y - plane.y * distance, inside.z - plane.z * distance };
+			const float touching = kRadius - kGap;
+			const float separated = kRadius + kGap;
+			const BoundingSphere straddling = { { onPlane.x - plane.x * touching, onPlane.y - plane.y * touching, onPlane.z - plane.z * touching }, kRadius };
+			const BoundingSphere outside = { { onPlane.x - plane.x * separated, onPlane.y - plane.y * separated, onPlane.z - plane.z * separated }, kRadius };
+			TEST_CHECK(Math::IsVisible(frustum, straddling));
+			TEST_CHECK(!Math::IsVisible(frustum, outside));
+			// 中心が平面の外側でも、半径の分だけ掛かっていれば残る
+			TEST_CHECK(PlaneDistance(plane, straddling.center) < 0.0f);
+
+			// 5 つの球の中で位置を変えて（先頭 4 つは SIMD、最後の 1 つはスカラー）、見える球だけが残る
+			for (size_t lane = 0; lane < 5; ++lane) {
+				BoundingSphere spheres[5];
+				for (size_t i = 0; i < 5; ++i) {
+					spheres[i] = { inside, 0.5f };
+				}
+				spheres[lane] = outside;
+				std::vector<uint32_t> visible = Cull(frustum, spheres, 5);
+				TEST_CHECK(visible.size() == 4);
+				for (uint32_t index : visible) {
+					TEST_CHECK(index != lane);
+				}
+
+				spheres[lane] = straddling;
+				visible = Cull(frustum, spheres, 5);
+				TEST_CHECK(visible.size() == 5);
+			}
+		}
+	}
+
+	// 4 つずつの判定と端数の判定は、1 つずつの判定と同じ番号を同じ順に返す
+	void TestCullMatchesOneByOne()
+	{
+		const Matrix4x4 viewProjection = MakeViewProjection({ 0.1f, 2.5f, 0.0f }, { 10.0f, 1.0f, 10.0f });
+		const Frustum frustum = Math::MakeFrustum(viewProjection);
+		std::mt19937 random(6006);
+		std::uniform_real_distribution<float> position(-120.0f, 120.0f);
+		std::uniform_real_distribution<float> radius(0.0f, 8.0f);
+
+		std::vector<BoundingSphere> spheres(1027 + 1);
+		for (BoundingSphere& sphere : spheres) {
+			sphere = { { position(random), position(random), position(random) }, radius(random) };
+		}
+		// 平面のすぐ近くの球も混ぜる
+		for (size_t i = 0; i < spheres.size(); i += 7) {
+			const Vector4& plane = frustum.planes[i % kFrustumPlaneCount];
+			const float distance = PlaneDistance(plane, spheres[i].center) + spheres[i].radius;
+			spheres[i].center = { spheres[i].center.x - plane.x * distance, spheres[i].center.y - plane.y * distance, spheres[i].center.z - plane.z * distance };
+		}
+
+		size_t totalVisible = 0;
+		for (size_t count : { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 31, 64, 1027 }) {
+			// 先頭をずらして 16 バイト境界に揃っていない配列も使う
+			for (size_t offset : { 0, 1 }) {
+				const BoundingSphere* first = spheres.data() + offset;
+				const std::vector<uint32_t> expected = CullOneByOne(frustum, first, count);
+				TEST_CHECK(Cull(frustum, first, count) == expected);
+				totalVisible += expected.size();
+			}
+		}
+		const std::vector<uint32_t> all = CullOneByOne(frustum, spheres.data(), 1027);
+		std::printf("  CullSpheres: %zu / 1027 visible\n", all.size());
+		TEST_CHECK(totalVisible > 0 && all.size() < 1027);
+	}
+}
+
+int main()
+{
+#if defined(MATH_USE_SSE)
+	std::printf("FrustumTest: SSE2\n");
+#else
+	std::printf("FrustumTest: scalar\n");
+#endif
+	TestPlaneExtraction();
+	TestPointsMatchClipSpace();
+	TestSpheresStraddlingEachPlane();
+	TestCullMatchesOneByOne();
+	return TestCommon::Finish("FrustumTest");
+}
@@ -0,0 +1,171 @@
+#include "TestCommon.h"
+#include "BenchCommon.h"
+#include "JobSystem.h"
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+//
+// JobSystemBench
+// - JobSystem のオーバーヘッドを測るヘッドレスのマイクロベンチマーク（D3D もウィンドウも使わない）。
+//   * spawn   : メインスレッドから空のジョブを Run して Wait する（積む・取り出す・完了通知の往復）
+//   * steal   : メインスレッドは積むだけで実行せず、全てのジョブをワーカーに盗ませる
+//   * nested  : ジョブの中からジョブを積む（ワーカー自身のキューと、そこからの盗み合い）
+//   * chain   : RunAfter で 1 つずつつないだ依存の連鎖
+//   * parallel_for : 軽いループを ParallelFor で回したときと、1 スレッドで回したとき
+// - 各計測で実行数・結果を確かめ、食い違えば失敗として終了コード 1 を返す。
+// - 使い方：JobSystemBench [--quick] [--workers N]
+//
+using namespace MyEngine;
+
+namespace {
+	// 計測の規模
+	struct BenchConfig {
+		uint32_t jobCount = 100000;
+		uint32_t chainLength = 20000;
+		uint32_t loopCount = 1u << 22;
+		int repeatCount = 5;
+	};
+
+	// 空のジョブを積んで待つ
+	void BenchSpawn(JobSystem& jobSystem, const BenchConfig& config)
+	{
+		std::atomic<uint32_t> executed = 0;
+		const double nanoseconds = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&]() {
+			executed = 0;
+			JobCounter counter;
+			for (uint32_t i = 0; i < config.jobCount; ++i) {
+				jobSystem.Run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+			}
+			jobSystem.Wait(counter);
+		});
+		TEST_CHECK(executed == config.jobCount);
+		BenchCommon::Report("spawn (Run + Wait, empty job)", nanoseconds, config.jobCount);
+	}
+
+	// メインスレッドは実行せず、ワーカーに全て盗ませる
+	void BenchSteal(JobSystem& jobSystem, const BenchConfig& config)
+	{
+		std::atomic<uint32_t> executed = 0;
+		uint64_t stolen = 0;
+		const double nanoseconds = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&]() {
+			executed = 0;
+			const uint64_t stolenBefore = jobSystem.GetStolenJobCount();
+			JobCounter counter;
+			for (uint32_t i = 0; i < config.jobCount; ++i) {
+				jobSystem.Run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+			}
+			// Wait はメインスレッドでもジョブを実行するため、ここでは完了を眺めるだけにする
+			while (!counter.IsDone()) {
+				std::this_thread::yield();
+			}
+			// 完了済みなので何も実行せず、最後に減らしたワーカーがカウンタのロックを手放すまで待つだけ
+			// （これを省いて counter を破棄すると、Complete 中のワーカーと競合する）
+			jobSystem.Wait(counter);
+			stolen = jobSystem.GetStolenJobCount() - stolenBefore;
+		});
+		TEST_CHECK(executed == config.jobCount);
+		TEST_CHECK(stolen == config.jobCount);
+		BenchCommon::Report("steal (main pushes, workers steal)", nanoseconds, config.jobCount);
+	}
+
+	// ジョブの中からジョブを積む（ワーカーごとに 1 つの親が子を積む）
+	void BenchNested(JobSystem& jobSystem, const BenchConfig& config)
+	{
+		const uint32_t parentCount = (std::max)(jobSystem.GetThreadCount(), 1u) * 4;
+		const uint32_t childCount = config.jobCount / parentCount;
+		std::atomic<uint32_t> executed = 0;
+		const double nanoseconds = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&]() {
+			executed = 0;
+			JobCounter parents;
+			for (uint32_t i = 0; i < parentCount; ++i) {
+				jobSystem.Run([&jobSystem, &executed, childCount]() {
+					JobCounter children;
+					for (uint32_t j = 0; j < childCount; ++j) {
+						jobSystem.Run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &children);
+					}
+					jobSystem.Wait(children);
+				}, &parents);
+			}
+			jobSystem.Wait(parents);
+		});
+		TEST_CHECK(executed == parentCount * childCount);
+		BenchCommon::Report("nested (jobs spawning jobs)", nanoseconds, static_cast<double>(parentCount) * childCount);
+	}
+
+	// RunAfter でつないだ連鎖（前のジョブが終わるまで次は積まれない）
+	void BenchChain(JobSystem& jobSystem, const BenchConfig& config)
+	{
+		std::vector<uint32_t> order;
+		order.reserve(config.chainLength);
+		const double nanoseconds = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&]() {
+			order.clear();
+			std::vector<JobCounter> counters(config.chainLength);
+			jobSystem.Run([&order]() { order.push_back(0); }, &counters[0]);
+			for (uint32_t i = 1; i < config.chainLength; ++i) {
+				jobSystem.RunAfter(counters[i - 1], [&order, i]() { order.push_back(i); }, &counters[i]);
+			}
+			jobSystem.Wait(counters.back());
+		});
+		bool isOrdered = order.size() == config.chainLength;
+		for (uint32_t i = 0; isOrdered && i < config.chainLength; ++i) {
+			isOrdered = order[i] == i;
+		}
+		TEST_CHECK(isOrdered);
+		BenchCommon::Report("chain (RunAfter dependency)", nanoseconds, config.chainLength);
+	}
+
+	// 軽いループの ParallelFor と 1 スレッドの比較
+	void BenchParallelFor(JobSystem& jobSystem, const BenchConfig& config)
+	{
+		std::vector<float> values(config.loopCount);
+		auto body = [&values](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+				values[i] = static_cast<float>(i % 1024) * 0.5f + 1.0f;
+			}
+		};
+
+		const double serial = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&]() { body(0, config.loopCount); });
+		std::fill(values.begin(), values.end(), 0.0f);
+		const double parallel = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&]() { jobSystem.ParallelFor(config.loopCount, 0, body); });
+
+		bool isFilled = true;
+		for (uint32_t i = 0; isFilled && i < config.loopCount; ++i) {
+			isFilled = values[i] == static_cast<float>(i % 1024) * 0.5f + 1.0f;
+		}
+		TEST_CHECK(isFilled);
+		BenchCommon::Report("parallel_for serial loop", serial, config.loopCount);
+		BenchCommon::Report("parallel_for (grain auto)", parallel, config.loopCount);
+		std::printf("  %-40s %10.2fx\n", "parallel_for speedup", serial / parallel);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchConfig config;
+	if (BenchCommon::IsQuick(argc, argv)) {
+		config = BenchConfig{ 2000, 500, 1u << 16, 1 };
+	}
+
+	// "--workers N" でワーカー数を指定（0 でコア数から自動決定）
+	uint32_t workerCount = 0;
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (std::strcmp(argv[i], "--workers") == 0) {
+			workerCount = static_cast<uint32_t>(std::atoi(argv[i + 1]));
+		}
+	}
+
+	JobSystem& jobSystem = *JobSystem::GetInstance();
+	jobSystem.Initialize(workerCount);
+	std::printf("JobSystemBench: %u threads (main + workers), %u jobs\n", jobSystem.GetThreadCount(), config.jobCount);
+
+	BenchSpawn(jobSystem, config);
+	BenchSteal(jobSystem, config);
+	BenchNested(jobSystem, config);
+	BenchChain(jobSystem, config);
+	BenchParallelFor(jobSystem, config);
+
+	jobSystem.Finalize();
+	return TestCommon::Finish("JobSystemBench");
+}
@@ -0,0 +1,314 @@
+#include "TestCommon.h"
+#include "BenchCommon.h"
+#include "JobSystem.h"
+#include "LightClusterGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+//
+// LightClusterGridBench
+// - LightClusterGrid の CPU でのクラスタ分類を測るヘッドレスのベンチマーク（D3D もウィンドウも使わない）。
+//   * serial   : JobSystem を初期化する前（呼び出したスレッドで全スライスを順に分類する）
+//   * parallel : JobSystem を初期化した後（スライスごとにワーカーで分類する）
+// - 計測の前に、結果を全クラスタ × 全ライトの総当たりと比べる（掛かるライトを落とさない・AABB に掛からないライトを入れない）。
+//   serial と parallel の結果が一致すること、番号の上限で切り詰めても範囲外を指さないことも確かめる。
+// - 使い方：LightClusterGridBench [--quick] [--workers N]
+//
+using namespace MyEngine;
+using namespace MyEngine::LightClusterConstants;
+
+namespace {
+	// 計測の規模
+	struct BenchConfig {
+		std::vector<uint32_t> pointLightCounts = { 64, 512, 4096 };
+		int repeatCount = 20;
+	};
+
+	// 総当たりとの比較で許す誤差（スライスの境界の奥行きは log と pow の往復で丸めが入る）
+	constexpr float kRadiusTolerance = 1e-3f;
+
+	// クラスタの中に取る点の数（1 辺あたり。境界の丸めを避けるため、端から少し内側に取る）
+	constexpr uint32_t kSampleCountPerAxis = 6;
+	constexpr float kSampleInset = 0.01f;
+
+	// 再現できる疑似乱数（xorshift32）
+	class Random
+	{
+	public:
+		explicit Random(uint32_t seed) : state_(seed) {}
+
+		float Range(float minimum, float maximum)
+		{
+			state_ ^= state_ << 13;
+			state_ ^= state_ >> 17;
+			state_ ^= state_ << 5;
+			return minimum + (maximum - minimum) * float(state_ >> 8) / float(1u << 24);
+		}
+
+	private:
+		uint32_t state_;
+	};
+
+	// 分類に使うカメラ（原点から +z を向く。16:9）
+	LightClusterGrid::Desc MakeDesc()
+	{
+		LightClusterGrid::Desc desc;
+		desc.view = {};
+		for (int i = 0; i < 4; ++i) {
+			desc.view.m[i][i] = 1.0f;
+		}
+		desc.fovY = 0.45f;
+		desc.aspectRatio = 16.0f / 9.0f;
+		desc.nearClip = 0.1f;
+		desc.farClip = 100.0f;
+		return desc;
+	}
+
+	// 視錐台の周りに散らしたライト（一部は視錐台の外や近クリップの手前に出る）
+	std::vector<BoundingSphere> MakeLights(uint32_t count, uint32_t seed)
+	{
+		Random random(seed);
+		std::vector<BoundingSphere> lights(count);
+		for (BoundingSphere& light : lights) {
+			light.center = { random.Range(-60.0f, 60.0f), random.Range(-20.0f, 20.0f), random.Range(-5.0f, 105.0f) };
+			light.radius = random.Range(0.5f, 6.0f);
+		}
+		return lights;
+	}
+
+	// 球と AABB の距離の 2 乗
+	float DistanceSquared(const Vector3& center, const Vector3& minimum, const Vector3& maximum)
+	{
+		const float dx = center.x - std::clamp(center.x, minimum.x, maximum.x);
+		const float dy = center.y - std::clamp(center.y, minimum.y, maximum.y);
+		const float dz = center.z - std::clamp(center.z, minimum.z, maximum.z);
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	// クラスタ（視錐台を切った小さな視錐台）の中の点のどれかが球に入るか
+	bool HitsClusterSample(const BoundingSphere& light, float radius, float tanHalfFovX, float tanHalfFovY,
+		float ndcLeft, float ndcRight, float ndcBottom, float ndcTop, float nearDepth, float farDepth)
+	{
+		for (uint32_t k = 0; k < kSampleCountPerAxis; ++k) {
+			for (uint32_t j = 0; j < kSampleCountPerAxis; ++j) {
+				for (uint32_t i = 0; i < kSampleCountPerAxis; ++i) {
+					auto at = [](uint32_t index) {
+						return kSampleInset + (1.0f - 2.0f * kSampleInset) * float(index) / float(kSampleCountPerAxis - 1);
+					};
+					const float depth = nearDepth + (farDepth - nearDepth) * at(k);
+					const float ndcY = ndcBottom + (ndcTop - ndcBottom) * at(j);
+					const float ndcX = ndcLeft + (ndcRight - ndcLeft) * at(i);
+					const float dx = ndcX * tanHalfFovX * depth - light.center.x;
+					const float dy = ndcY * tanHalfFovY * depth - light.center.y;
+					const float dz = depth - light.center.z;
+					if (dx * dx + dy * dy + dz * dz <= radius * radius) {
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	// 番号の上限が無いときの結果を総当たりと比べる（view は単位行列なのでワールド空間 = ビュー空間）
+	// - 落としていないか：クラスタの中の点に届くライトは必ず入っている
+	// - 余計に入れていないか：入っているライトは必ずクラスタの AABB に掛かる（分類は AABB で判定するので、これより狭くはできない）
+	void VerifyAgainstBruteForce(const LightClusterGrid& grid, const LightClusterGrid::Desc& desc,
+		const std::vector<BoundingSphere>& pointLights, const std::vector<BoundingSphere>& spotLights)
+	{
+		const std::vector<LightClusterGrid::Cluster>& clusters = grid.GetClusters();
+		const std::vector<uint32_t>& indices = grid.GetIndices();
+		TEST_CHECK(clusters.size() == kClusterCount);
+		if (clusters.size() != kClusterCount) {
+			return;
+		}
+
+		const float tanHalfFovY = std::tan(desc.fovY * 0.5f);
+		const float tanHalfFovX = tanHalfFovY * desc.aspectRatio;
+		std::vector<uint8_t> isListed;
+		uint32_t missingCount = 0;
+		uint32_t extraCount = 0;
+		uint32_t orderErrorCount = 0;
+		size_t expectedIndexCount = 0;
+
+		for (uint32_t z = 0; z < kClusterCountZ; ++z) {
+			const float nearDepth = desc.nearClip * std::pow(desc.farClip / desc.nearClip, float(z) / float(kClusterCountZ));
+			const float farDepth = desc.nearClip * std::pow(desc.farClip / desc.nearClip, float(z + 1) / float(kClusterCountZ));
+			for (uint32_t y = 0; y < kClusterCountY; ++y) {
+				const float ndcTop = 1.0f - 2.0f * float(y) / float(kClusterCountY);
+				const float ndcBottom = 1.0f - 2.0f * float(y + 1) / float(kClusterCountY);
+				for (uint32_t x = 0; x < kClusterCountX; ++x) {
+					const float ndcLeft = -1.0f + 2.0f * float(x) / float(kClusterCountX);
+					const float ndcRight = -1.0f + 2.0f * float(x + 1) / float(kClusterCountX);
+					const Vector3 minimum = {
+						(std::min)(ndcLeft * tanHalfFovX * nearDepth, ndcLeft * tanHalfFovX * farDepth),
+						(std::min)(ndcBottom * tanHalfFovY * nearDepth, ndcBottom * tanHalfFovY * farDepth),
+						nearDepth
+					};
+					const Vector3 maximum = {
+						(std::max)(ndcRight * tanHalfFovX * nearDepth, ndcRight * tanHalfFovX * farDepth),
+						(std::max)(ndcTop * tanHalfFovY * nearDepth, ndcTop * tanHalfFovY * farDepth),
+						farDepth
+					};
+
+					const LightClusterGrid::Cluster& cluster = clusters[LightClusterGrid::GetClusterIndex(x, y, z)];
+					expectedIndexCount += cluster.pointCount + cluster.spotCount;
+					if (cluster.offset + cluster.pointCount + cluster.spotCount > indices.size()) {
+						++extraCount;
+						continue;
+					}
+
+					// 点光源・スポットライトの順に、それぞれ番号の小さい順で並ぶ
+					auto check = [&](const std::vector<BoundingSphere>& lights, uint32_t begin, uint32_t count) {
+						isListed.assign(lights.size(), 0);
+						for (uint32_t i = 0; i < count; ++i) {
+							const uint32_t light = indices[begin + i];
+							if (light >= lights.size()) {
+								++extraCount;
+								continue;
+							}
+							if (i > 0 && indices[begin + i - 1] >= light) {
+								++orderErrorCount;
+							}
+							isListed[light] = 1;
+						}
+						for (uint32_t light = 0; light < lights.size(); ++light) {
+							const float distanceSquared = DistanceSquared(lights[light].center, minimum, maximum);
+							const float inner = lights[light].radius * (1.0f - kRadiusTolerance);
+							const float outer = lights[light].radius * (1.0f + kRadiusTolerance);
+							if (isListed[light] && distanceSquared > outer * outer) {
+								++extraCount;
+							}
+							// AABB に届かないライトはクラスタの中の点にも届かないので、点を調べるのは AABB に届くものだけ
+							if (!isListed[light] && distanceSquared <= inner * inner &&
+								HitsClusterSample(lights[light], inner, tanHalfFovX, tanHalfFovY,
+									ndcLeft, ndcRight, ndcBottom, ndcTop, nearDepth, farDepth)) {
+								++missingCount;
+							}
+						}
+					};
+					check(pointLights, cluster.offset, cluster.pointCount);
+					check(spotLights, cluster.offset + cluster.pointCount, cluster.spotCount);
+				}
+			}
+		}
+
+		TEST_CHECK(missingCount == 0);
+		TEST_CHECK(extraCount == 0);
+		TEST_CHECK(orderErrorCount == 0);
+		TEST_CHECK(expectedIndexCount == indices.size());
+	}
+
+	// 番号の上限で切り詰めても、クラスタが番号の配列の外を指さない
+	void VerifyTruncation(const LightClusterGrid::Desc& desc,
+		const std::vector<BoundingSphere>& pointLights, const std::vector<BoundingSphere>& spotLights, const LightClusterGrid& full)
+	{
+		const uint32_t maxIndexCount = static_cast<uint32_t>(full.GetIndices().size() / 3);
+		LightClusterGrid grid;
+		grid.SetMaxIndexCount(maxIndexCount);
+		grid.Build(desc, pointLights.data(), static_cast<uint32_t>(pointLights.size()),
+			spotLights.data(), static_cast<uint32_t>(spotLights.size()));
+
+		TEST_CHECK(grid.GetIndices().size() <= maxIndexCount);
+		bool isInRange = true;
+		for (const LightClusterGrid::Cluster& cluster : grid.GetClusters()) {
+			const uint32_t count = cluster.pointCount + cluster.spotCount;
+			isInRange = isInRange && (count == 0 || cluster.offset + count <= grid.GetIndices().size());
+		}
+		TEST_CHECK(isInRange);
+
+		// 手前のスライスは切り詰められない（奥から削る）
+		TEST_CHECK(std::equal(grid.GetIndices().begin(), grid.GetIndices().end(), full.GetIndices().begin()));
+	}
+
+	// 2 つの結果が同じか
+	bool IsSameResult(const LightClusterGrid& a, const LightClusterGrid& b)
+	{
+		if (a.GetIndices() != b.GetIndices() || a.GetClusters().size() != b.GetClusters().size()) {
+			return false;
+		}
+		for (size_t i = 0; i < a.GetClusters().size(); ++i) {
+			const LightClusterGrid::Cluster& ca = a.GetClusters()[i];
+			const LightClusterGrid::Cluster& cb = b.GetClusters()[i];
+			if (ca.offset != cb.offset || ca.pointCount != cb.pointCount || ca.spotCount != cb.spotCount) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// ライトの数ごとの場面
+	struct Scene {
+		std::vector<BoundingSphere> pointLights;
+		std::vector<BoundingSphere> spotLights;
+		LightClusterGrid serialResult;
+	};
+
+	// 分類 1 回分の時間を測る
+	void BenchBuild(const char* label, const LightClusterGrid::Desc& desc, Scene& scene, const BenchConfig& config)
+	{
+		LightClusterGrid grid;
+		const double nanoseconds = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&]() {
+			grid.Build(desc, scene.pointLights.data(), static_cast<uint32_t>(scene.pointLights.size()),
+				scene.spotLights.data(), static_cast<uint32_t>(scene.spotLights.size()));
+		});
+
+		char name[64];
+		std::snprintf(name, sizeof(name), "%s %u+%u lights", label,
+			static_cast<uint32_t>(scene.pointLights.size()), static_cast<uint32_t>(scene.spotLights.size()));
+		BenchCommon::Report(name, nanoseconds, 1.0);
+
+		if (scene.serialResult.GetClusters().empty()) {
+			scene.serialResult = grid;
+		}
+		else {
+			TEST_CHECK(IsSameResult(grid, scene.serialResult));
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchConfig config;
+	if (BenchCommon::IsQuick(argc, argv)) {
+		config = BenchConfig{ { 64, 512 }, 1 };
+	}
+
+	// "--workers N" でワーカー数を指定（0 でコア数から自動決定）
+	uint32_t workerCount = 0;
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (std::strcmp(argv[i], "--workers") == 0) {
+			workerCount = static_cast<uint32_t>(std::atoi(argv[i + 1]));
+		}
+	}
+
+	const LightClusterGrid::Desc desc = MakeDesc();
+	std::vector<Scene> scenes;
+	for (uint32_t pointLightCount : config.pointLightCounts) {
+		Scene& scene = scenes.emplace_back();
+		scene.pointLights = MakeLights(pointLightCount, 0x1234u + pointLightCount);
+		scene.spotLights = MakeLights(pointLightCount / 4, 0x5678u + pointLightCount);
+	}
+
+	// JobSystem を初期化する前は呼び出したスレッドだけで分類する
+	std::printf("LightClusterGridBench: %u x %u x %u clusters\n", kClusterCountX, kClusterCountY, kClusterCountZ);
+	for (Scene& scene : scenes) {
+		BenchBuild("serial  ", desc, scene, config);
+		VerifyAgainstBruteForce(scene.serialResult, desc, scene.pointLights, scene.spotLights);
+		VerifyTruncation(desc, scene.pointLights, scene.spotLights, scene.serialResult);
+	}
+
+	JobSystem& jobSystem = *JobSystem::GetInstance();
+	jobSystem.Initialize(workerCount);
+	std::printf("LightClusterGridBench: %u threads (main + workers)\n", jobSystem.GetThreadCount());
+	for (Scene& scene : scenes) {
+		BenchBuild("parallel", desc, scene, config);
+	}
+	jobSystem.Finalize();
+
+	return TestCommon::Finish("LightClusterGridBench");
+}
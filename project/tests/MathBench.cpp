@@ -0,0 +1,175 @@
+#include "TestCommon.h"
+#include "BenchCommon.h"
+#include "Inverse.h"
+#include "MakeAffineMatrix.h"
+#include "MathSimd.h"
+#include "Multiply.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//
+// MathBench
+// - 行列演算（Math::Multiply / Inverse / InverseAffine）の SIMD 版と、SIMD を使わない Math::Scalar を同じ入力で測る。
+//   * multiply        : 4x4 行列の積（ワールド行列 × ビュープロジェクション）
+//   * multiply vector : 行列とベクトルの積
+//   * inverse         : 一般の逆行列（スカラーは余因子展開）
+//   * inverse affine  : アフィン行列の逆行列（カメラ行列・法線行列用）
+// - 行列の配列をまとめて処理し、1 回あたりの時間を出す。結果が Math::Scalar と 1e-6 以内で一致することも確かめる
+//   （精度の詳しい確認は MathPrecisionTest）。
+// - SSE2 の既定のビルド（MathBench）と、AVX でビルドしたもの（MathBenchAvx）がある。
+// - 使い方：MathBench [--quick]
+//
+namespace {
+	// 計測の規模
+	struct BenchConfig {
+		size_t matrixCount = 4096;
+		int repeatCount = 200;
+	};
+
+	constexpr double kTolerance = 1e-6;
+
+	const char* GetPathName()
+	{
+#if defined(MATH_USE_AVX)
+		return "AVX";
+#elif defined(MATH_USE_SSE)
+		return "SSE2";
+#else
+		return "scalar";
+#endif
+	}
+
+	// 入力（ワールド行列とベクトル）
+	struct BenchInput {
+		std::vector<Matrix4x4> worlds;
+		std::vector<Matrix4x4> viewProjections;
+		std::vector<Vector4> vectors;
+	};
+
+	BenchInput MakeInput(size_t count)
+	{
+		std::mt19937 random(2024);
+		std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+		std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+		std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+
+		BenchInput input;
+		for (size_t i = 0; i < count; ++i) {
+			input.worlds.push_back(Math::MakeAffineMatrix({ scale(random), scale(random), scale(random) },
+				{ angle(random), angle(random), angle(random) }, { position(random), position(random), position(random) }));
+			Matrix4x4 viewProjection = Math::MakeAffineMatrix({ 1.0f, 1.0f, 1.0f },
+				{ angle(random), angle(random), 0.0f }, { position(random), position(random), position(random) });
+			viewProjection.m[2][3] = 1.0f;
+			viewProjection.m[3][3] = 0.0f;
+			input.viewProjections.push_back(viewProjection);
+			input.vectors.push_back({ position(random), position(random), position(random), 1.0f });
+		}
+		return input;
+	}
+
+	// 行列全体の大きさに対する差
+	double RelativeError(const Matrix4x4& actual, const Matrix4x4& expected)
+	{
+		double maxDifference = 0.0;
+		double maxMagnitude = 1.0;
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				maxDifference = (std::max)(maxDifference, std::abs(static_cast<double>(actual.m[i][j]) - expected.m[i][j]));
+				maxMagnitude = (std::max)(maxMagnitude, std::abs(static_cast<double>(expected.m[i][j])));
+			}
+		}
+		return maxDifference / maxMagnitude;
+	}
+
+	double MaxRelativeError(const std::vector<Matrix4x4>& actual, const std::vector<Matrix4x4>& expected)
+	{
+		double maxError = 0.0;
+		for (size_t i = 0; i < actual.size(); ++i) {
+			maxError = (std::max)(maxError, RelativeError(actual[i], expected[i]));
+		}
+		return maxError;
+	}
+
+	// 行列の配列に function を適用する時間を測って表示する
+	template <class Function>
+	void BenchMatrices(const char* name, const BenchConfig& config, std::vector<Matrix4x4>& results, Function function)
+	{
+		const double totalNs = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&] {
+			for (size_t i = 0; i < results.size(); ++i) {
+				results[i] = function(i);
+			}
+		});
+		BenchCommon::Report(name, totalNs, static_cast<double>(results.size()));
+	}
+
+	void BenchMultiply(const BenchInput& input, const BenchConfig& config)
+	{
+		std::vector<Matrix4x4> simd(input.worlds.size());
+		std::vector<Matrix4x4> scalar(input.worlds.size());
+		BenchMatrices("multiply (Math)", config, simd, [&](size_t i) { return Math::Multiply(input.worlds[i], input.viewProjections[i]); });
+		BenchMatrices("multiply (Math::Scalar)", config, scalar, [&](size_t i) { return Math::Scalar::Multiply(input.worlds[i], input.viewProjections[i]); });
+		TEST_CHECK(MaxRelativeError(simd, scalar) <= kTolerance);
+	}
+
+	void BenchMultiplyVector(const BenchInput& input, const BenchConfig& config)
+	{
+		std::vector<Vector4> simd(input.vectors.size());
+		std::vector<Vector4> scalar(input.vectors.size());
+		const double simdNs = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&] {
+			for (size_t i = 0; i < simd.size(); ++i) {
+				simd[i] = Math::Multiply(input.viewProjections[i], input.vectors[i]);
+			}
+		});
+		BenchCommon::Report("multiply vector (Math)", simdNs, static_cast<double>(simd.size()));
+		const double scalarNs = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&] {
+			for (size_t i = 0; i < scalar.size(); ++i) {
+				scalar[i] = Math::Scalar::Multiply(input.viewProjections[i], input.vectors[i]);
+			}
+		});
+		BenchCommon::Report("multiply vector (Math::Scalar)", scalarNs, static_cast<double>(scalar.size()));
+
+		double maxError = 0.0;
+		for (size_t i = 0; i < simd.size(); ++i) {
+			const float difference = (std::max)({ std::abs(simd[i].x - scalar[i].x), std::abs(simd[i].y - scalar[i].y),
+				std::abs(simd[i].z - scalar[i].z), std::abs(simd[i].w - scalar[i].w) });
+			const float magnitude = (std::max)({ 1.0f, std::abs(scalar[i].x), std::abs(scalar[i].y), std::abs(scalar[i].z), std::abs(scalar[i].w) });
+			maxError = (std::max)(maxError, static_cast<double>(difference / magnitude));
+		}
+		TEST_CHECK(maxError <= kTolerance);
+	}
+
+	void BenchInverse(const BenchInput& input, const BenchConfig& config)
+	{
+		std::vector<Matrix4x4> simd(input.worlds.size());
+		std::vector<Matrix4x4> scalar(input.worlds.size());
+		BenchMatrices("inverse (Math)", config, simd, [&](size_t i) { return Math::Inverse(input.worlds[i]); });
+		BenchMatrices("inverse (Math::Scalar)", config, scalar, [&](size_t i) { return Math::Scalar::Inverse(input.worlds[i]); });
+		TEST_CHECK(MaxRelativeError(simd, scalar) <= kTolerance);
+
+		std::vector<Matrix4x4> affine(input.worlds.size());
+		std::vector<Matrix4x4> affineScalar(input.worlds.size());
+		BenchMatrices("inverse affine (Math)", config, affine, [&](size_t i) { return Math::InverseAffine(input.worlds[i]); });
+		BenchMatrices("inverse affine (Math::Scalar)", config, affineScalar, [&](size_t i) { return Math::Scalar::InverseAffine(input.worlds[i]); });
+		TEST_CHECK(MaxRelativeError(affine, scalar) <= kTolerance);
+		TEST_CHECK(MaxRelativeError(affineScalar, scalar) <= kTolerance);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchConfig config;
+	if (BenchCommon::IsQuick(argc, argv)) {
+		config = BenchConfig{ 256, 1 };
+	}
+
+	std::printf("MathBench: %s, %zu matrices\n", GetPathName(), config.matrixCount);
+	const BenchInput input = MakeInput(config.matrixCount);
+	BenchMultiply(input, config);
+	BenchMultiplyVector(input, config);
+	BenchInverse(input, config);
+
+	return TestCommon::Finish("MathBench");
+}
@@ -0,0 +1,198 @@
+#include "TestCommon.h"
+#include "Inverse.h"
+#include "MakeAffineMatrix.h"
+#include "MakePerspectiveFovMatrix.h"
+#include "MathSimd.h"
+#include "Multiply.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+//
+// MathPrecisionTest
+// - SIMD 版の Math::Multiply / Inverse / InverseAffine を、SIMD を使わない Math::Scalar（MATH_FORCE_SCALAR のときの実装。
+//   Inverse は SIMD 化する前の余因子展開）と比べ、差が 1e-6 以内であることを確かめる。
+// - 差は行列全体の大きさで割った相対誤差（max|a - b| / max(1, max|b|)）で測る。
+//   逆行列は計算の順番が違うため丸め誤差の分だけずれるが、条件の悪くない行列（ワールド行列・カメラ行列・透視投影行列）に限る。
+// - CMake では既定の SSE2、AVX（-mavx）、MATH_FORCE_SCALAR の 3 通りでビルドして実行する（MathPrecisionTest / Avx / Scalar）。
+//   MATH_FORCE_SCALAR のビルドでは Math:: と Math::Scalar:: が同じ実装になるので、差は 0 になる。
+//
+namespace {
+	constexpr double kTolerance = 1e-6;
+	constexpr int kMatrixCount = 2000;
+
+	// 実行している実装の名前
+	const char* GetPathName()
+	{
+#if defined(MATH_USE_AVX)
+		return "AVX";
+#elif defined(MATH_USE_SSE)
+		return "SSE2";
+#else
+		return "scalar";
+#endif
+	}
+
+	// 行列全体の大きさに対する差
+	double RelativeError(const Matrix4x4& actual, const Matrix4x4& expected)
+	{
+		double maxDifference = 0.0;
+		double maxMagnitude = 1.0;
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				maxDifference = (std::max)(maxDifference, std::abs(static_cast<double>(actual.m[i][j]) - expected.m[i][j]));
+				maxMagnitude = (std::max)(maxMagnitude, std::abs(static_cast<double>(expected.m[i][j])));
+			}
+		}
+		return maxDifference / maxMagnitude;
+	}
+
+	double RelativeError(const Vector4& actual, const Vector4& expected)
+	{
+		const double a[] = { actual.x, actual.y, actual.z, actual.w };
+		const double e[] = { expected.x, expected.y, expected.z, expected.w };
+		double maxDifference = 0.0;
+		double maxMagnitude = 1.0;
+		for (int i = 0; i < 4; ++i) {
+			maxDifference = (std::max)(maxDifference, std::abs(a[i] - e[i]));
+			maxMagnitude = (std::max)(maxMagnitude, std::abs(e[i]));
+		}
+		return maxDifference / maxMagnitude;
+	}
+
+	double MaxMagnitude(const Matrix4x4& m)
+	{
+		double maxMagnitude = 0.0;
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				maxMagnitude = (std::max)(maxMagnitude, std::abs(static_cast<double>(m.m[i][j])));
+			}
+		}
+		return maxMagnitude;
+	}
+
+	// M * M^-1 と単位行列の差（積の各項の大きさ max|M| * max|M^-1| で割る）
+	double IdentityError(const Matrix4x4& m, const Matrix4x4& inverse)
+	{
+		const Matrix4x4 product = Math::Scalar::Multiply(m, inverse);
+		double maxDifference = 0.0;
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				maxDifference = (std::max)(maxDifference, std::abs(product.m[i][j] - (i == j ? 1.0 : 0.0)));
+			}
+		}
+		return maxDifference / (MaxMagnitude(m) * MaxMagnitude(inverse));
+	}
+
+	// ゲームで逆行列を求める行列（ワールド行列・カメラ行列・透視投影行列）を乱数で作る
+	struct TestMatrices {
+		std::vector<Matrix4x4> affine;
+		std::vector<Matrix4x4> projection;
+		std::vector<Matrix4x4> general;
+	};
+
+	TestMatrices MakeTestMatrices()
+	{
+		std::mt19937 random(12345);
+		std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+		std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+		std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+		TestMatrices matrices;
+		for (int i = 0; i < kMatrixCount; ++i) {
+			// 親子付けで生じるせん断も含めるため、2 つのアフィン行列の積も混ぜる
+			Matrix4x4 world = Math::MakeAffineMatrix({ scale(random), scale(random), scale(random) },
+				{ angle(random), angle(random), angle(random) }, { position(random), position(random), position(random) });
+			if (i % 2 == 1) {
+				const Matrix4x4 parent = Math::MakeAffineMatrix({ scale(random), scale(random), scale(random) },
+					{ angle(random), angle(random), angle(random) }, { position(random), position(random), position(random) });
+				world = Math::Scalar::Multiply(world, parent);
+			}
+			matrices.affine.push_back(world);
+
+			matrices.projection.push_back(Math::MakePerspectiveFovMatrix(0.3f + 0.002f * static_cast<float>(i % 600),
+				16.0f / 9.0f, 0.1f, 100.0f + static_cast<float>(i)));
+
+			// 対角が大きい一般の行列（条件数が小さい）
+			Matrix4x4 general;
+			for (int r = 0; r < 4; ++r) {
+				for (int c = 0; c < 4; ++c) {
+					general.m[r][c] = unit(random) + (r == c ? 4.0f : 0.0f);
+				}
+			}
+			matrices.general.push_back(general);
+		}
+		return matrices;
+	}
+
+	// 行列の積と、行列とベクトルの積
+	void TestMultiplyMatchesScalar(const TestMatrices& matrices)
+	{
+		std::mt19937 random(777);
+		std::uniform_real_distribution<float> unit(-10.0f, 10.0f);
+		double maxError = 0.0;
+		double maxVectorError = 0.0;
+		for (size_t i = 0; i + 1 < matrices.affine.size(); ++i) {
+			const Matrix4x4& a = matrices.affine[i];
+			const Matrix4x4& b = (i % 3 == 0) ? matrices.projection[i] : matrices.general[i + 1];
+			maxError = (std::max)(maxError, RelativeError(Math::Multiply(a, b), Math::Scalar::Multiply(a, b)));
+			maxError = (std::max)(maxError, RelativeError(a * b, Math::Scalar::Multiply(a, b)));
+
+			const Vector4 v = { unit(random), unit(random), unit(random), 1.0f };
+			maxVectorError = (std::max)(maxVectorError, RelativeError(Math::Multiply(b, v), Math::Scalar::Multiply(b, v)));
+		}
+		std::printf("  Multiply(matrix)        max relative error %.3g\n", maxError);
+		std::printf("  Multiply(vector)        max relative error %.3g\n", maxVectorError);
+		TEST_CHECK(maxError <= kTolerance);
+		TEST_CHECK(maxVectorError <= kTolerance);
+	}
+
+	// 一般の逆行列（SIMD は 2x2 ブロック、スカラーは余因子展開）
+	void TestInverseMatchesCofactor(const TestMatrices& matrices)
+	{
+		const std::vector<Matrix4x4>* groups[] = { &matrices.affine, &matrices.projection, &matrices.general };
+		const char* names[] = { "affine", "projection", "general" };
+		for (size_t g = 0; g < std::size(groups); ++g) {
+			double maxError = 0.0;
+			double maxIdentityError = 0.0;
+			for (const Matrix4x4& m : *groups[g]) {
+				const Matrix4x4 inverse = Math::Inverse(m);
+				maxError = (std::max)(maxError, RelativeError(inverse, Math::Scalar::Inverse(m)));
+				maxIdentityError = (std::max)(maxIdentityError, IdentityError(m, inverse));
+			}
+			std::printf("  Inverse(%-10s)      max relative error %.3g (M * inv - I : %.3g)\n", names[g], maxError, maxIdentityError);
+			TEST_CHECK(maxError <= kTolerance);
+			TEST_CHECK(maxIdentityError <= kTolerance);
+		}
+	}
+
+	// アフィン行列の逆行列は、一般の逆行列（余因子展開）とも、スカラーの InverseAffine とも一致する
+	void TestInverseAffineMatchesCofactor(const TestMatrices& matrices)
+	{
+		double maxCofactorError = 0.0;
+		double maxScalarError = 0.0;
+		for (const Matrix4x4& m : matrices.affine) {
+			const Matrix4x4 inverse = Math::InverseAffine(m);
+			maxCofactorError = (std::max)(maxCofactorError, RelativeError(inverse, Math::Scalar::Inverse(m)));
+			maxScalarError = (std::max)(maxScalarError, RelativeError(inverse, Math::Scalar::InverseAffine(m)));
+			// 最終列は正確に (0, 0, 0, 1)
+			TEST_CHECK(inverse.m[0][3] == 0.0f && inverse.m[1][3] == 0.0f && inverse.m[2][3] == 0.0f && inverse.m[3][3] == 1.0f);
+		}
+		std::printf("  InverseAffine           max relative error %.3g (vs cofactor Inverse), %.3g (vs scalar)\n", maxCofactorError, maxScalarError);
+		TEST_CHECK(maxCofactorError <= kTolerance);
+		TEST_CHECK(maxScalarError <= kTolerance);
+	}
+}
+
+int main()
+{
+	std::printf("MathPrecisionTest: %s\n", GetPathName());
+	const TestMatrices matrices = MakeTestMatrices();
+	TestMultiplyMatchesScalar(matrices);
+	TestInverseMatchesCofactor(matrices);
+	TestInverseAffineMatchesCofactor(matrices);
+	return TestCommon::Finish("MathPrecisionTest");
+}
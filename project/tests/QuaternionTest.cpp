@@ -0,0 +1,247 @@
+#include "TestCommon.h"
+#include "Quaternion.h"
+#include "MakeRotateXMatrix.h"
+#include "MakeRotateYMatrix.h"
+#include "MakeRotateZMatrix.h"
+#include "Multiply.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+//
+// QuaternionTest
+// - Quaternion の関数を、三角関数で作った回転行列（MakeRotateX/Y/ZMatrix の積）と倍精度の計算を基準に確かめる。
+//   * MakeRotateXYZQuaternion → MakeRotateMatrix が RotateX * RotateY * RotateZ と一致する
+//   * オイラー角 → クォータニオン → オイラー角の往復。Y = ±π/2（ジンバルロック）とその近くでは角度は一意に決まらないので、
+//     戻した角度から作った回転が元の回転と一致することで確かめる
+//   * Slerp の両端・最短経路・角速度が一定であること・倍精度の Slerp との一致と、ほぼ同じ向きで Nlerp に切り替わる場合
+// - 回転の比較は行列の要素の差の最大値で行う（q と -q は同じ回転なので、クォータニオンの成分は直接比べない）。
+//
+namespace {
+	constexpr float kPi = 3.14159265358979f;
+	constexpr double kMatrixTolerance = 1e-5;
+	constexpr int kSampleCount = 2000;
+
+	// 回転行列の左上 3x3 の差の最大値
+	double MatrixDifference(const Matrix4x4& a, const Matrix4x4& b)
+	{
+		double maxDifference = 0.0;
+		for (int i = 0; i < 3; ++i) {
+			for (int j = 0; j < 3; ++j) {
+				maxDifference = (std::max)(maxDifference, std::abs(static_cast<double>(a.m[i][j]) - b.m[i][j]));
+			}
+		}
+		return maxDifference;
+	}
+
+	// 三角関数で作った X → Y → Z の回転行列
+	Matrix4x4 MakeRotateXYZByMatrices(const Vector3& rotate)
+	{
+		return Math::Multiply(Math::MakeRotateXMatrix(rotate.x), Math::Multiply(Math::MakeRotateYMatrix(rotate.y), Math::MakeRotateZMatrix(rotate.z)));
+	}
+
+	double QuaternionLength(const Quaternion& q)
+	{
+		return std::sqrt(static_cast<double>(q.x) * q.x + static_cast<double>(q.y) * q.y + static_cast<double>(q.z) * q.z + static_cast<double>(q.w) * q.w);
+	}
+
+	// 角度の差（2π の周期を除く）
+	double AngleDifference(double a, double b)
+	{
+		const double difference = std::remainder(a - b, 2.0 * 3.14159265358979323846);
+		return std::abs(difference);
+	}
+
+	// オイラー角から作ったクォータニオンは行列の積と同じ回転になる
+	void TestEulerQuaternionMatchesMatrices()
+	{
+		std::mt19937 random(1001);
+		std::uniform_real_distribution<float> angle(-kPi, kPi);
+		double maxDifference = 0.0;
+		for (int i = 0; i < kSampleCount; ++i) {
+			const Vector3 rotate = { angle(random), angle(random), angle(random) };
+			const Quaternion q = Math::MakeRotateXYZQuaternion(rotate);
+			maxDifference = (std::max)(maxDifference, MatrixDifference(Math::MakeRotateMatrix(q), MakeRotateXYZByMatrices(rotate)));
+			TEST_CHECK(std::abs(QuaternionLength(q) - 1.0) <= 1e-6);
+
+			// ベクトルの回転も行列と同じ
+			const Vector3 v = { 1.0f, -2.0f, 0.5f };
+			const Vector3 rotated = Math::RotateVector(v, q);
+			const Matrix4x4 m = MakeRotateXYZByMatrices(rotate);
+			TEST_CHECK(std::abs(rotated.x - (v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0])) <= 1e-5f);
+			TEST_CHECK(std::abs(rotated.y - (v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1])) <= 1e-5f);
+			TEST_CHECK(std::abs(rotated.z - (v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2])) <= 1e-5f);
+		}
+		std::printf("  MakeRotateXYZQuaternion max matrix difference %.3g\n", maxDifference);
+		TEST_CHECK(maxDifference <= kMatrixTolerance);
+
+		// 合成の順序：Multiply(q1, q2) は q2 を適用してから q1
+		const Quaternion qX = Math::MakeRotateAxisAngleQuaternion({ 1.0f, 0.0f, 0.0f }, 0.7f);
+		const Quaternion qY = Math::MakeRotateAxisAngleQuaternion({ 0.0f, 1.0f, 0.0f }, -1.1f);
+		const Quaternion qZ = Math::MakeRotateAxisAngleQuaternion({ 0.0f, 0.0f, 1.0f }, 2.3f);
+		const Quaternion composed = Math::Multiply(qZ, Math::Multiply(qY, qX));
+		TEST_CHECK(MatrixDifference(Math::MakeRotateMatrix(composed), MakeRotateXYZByMatrices({ 0.7f, -1.1f, 2.3f })) <= kMatrixTolerance);
+	}
+
+	// ジンバルロックから離れた角度は、角度そのものが元に戻る
+	void TestEulerRoundTrip()
+	{
+		std::mt19937 random(2002);
+		std::uniform_real_distribution<float> angle(-kPi, kPi);
+		std::uniform_real_distribution<float> pitch(-kPi * 0.5f + 0.05f, kPi * 0.5f - 0.05f);
+		double maxAngleDifference = 0.0;
+		for (int i = 0; i < kSampleCount; ++i) {
+			const Vector3 rotate = { angle(random), pitch(random), angle(random) };
+			const Vector3 euler = Math::ToEulerXYZ(Math::MakeRotateXYZQuaternion(rotate));
+			maxAngleDifference = (std::max)({ maxAngleDifference, AngleDifference(euler.x, rotate.x),
+				AngleDifference(euler.y, rotate.y), AngleDifference(euler.z, rotate.z) });
+		}
+		std::printf("  Euler round trip        max angle difference %.3g rad\n", maxAngleDifference);
+		TEST_CHECK(maxAngleDifference <= 1e-4);
+
+		// Y が ±π/2 を超える角度は、別の（同じ回転になる）角度の組で戻る。Y は [-π/2, π/2] に収まる
+		const Vector3 overPitch = { 0.3f, 2.0f, -0.4f };
+		const Vector3 euler = Math::ToEulerXYZ(Math::MakeRotateXYZQuaternion(overPitch));
+		TEST_CHECK(std::abs(euler.y) <= kPi * 0.5f + 1e-6f);
+		TEST_CHECK(MatrixDifference(MakeRotateXYZByMatrices(euler), MakeRotateXYZByMatrices(overPitch)) <= kMatrixTolerance);
+	}
+
+	// Y = ±π/2 とその近くでは角度は一意に決まらないが、戻した角度から作った回転は元と同じ
+	void TestEulerRoundTripAtGimbalLock()
+	{
+		std::mt19937 random(3003);
+		std::uniform_real_distribution<float> angle(-kPi, kPi);
+		const float pitches[] = { kPi * 0.5f, -kPi * 0.5f, std::nextafter(kPi * 0.5f, 0.0f), std::nextafter(-kPi * 0.5f, 0.0f),
+			kPi * 0.5f - 1e-4f, -kPi * 0.5f + 1e-4f, kPi * 0.5f - 1e-3f, -kPi * 0.5f + 1e-3f };
+		double maxDifference = 0.0;
+		for (float y : pitches) {
+			for (int i = 0; i < kSampleCount / 8; ++i) {
+				const Vector3 rotate = { angle(random), y, angle(random) };
+				const Quaternion q = Math::MakeRotateXYZQuaternion(rotate);
+				const Vector3 euler = Math::ToEulerXYZ(q);
+				TEST_CHECK(std::isfinite(euler.x) && std::isfinite(euler.y) && std::isfinite(euler.z));
+				TEST_CHECK(std::abs(euler.y - y) <= 1e-3f);
+
+				// 戻した角度から三角関数で作った回転と、クォータニオンからもう一度作った回転がどちらも元と一致する
+				const Matrix4x4 expected = MakeRotateXYZByMatrices(rotate);
+				maxDifference = (std::max)(maxDifference, MatrixDifference(MakeRotateXYZByMatrices(euler), expected));
+				maxDifference = (std::max)(maxDifference, MatrixDifference(Math::MakeRotateMatrix(Math::MakeRotateXYZQuaternion(euler)), expected));
+			}
+		}
+		std::printf("  Euler round trip at Y = +-pi/2 max matrix difference %.3g\n", maxDifference);
+		TEST_CHECK(maxDifference <= kMatrixTolerance);
+
+		// 回転の無い場合と、Y だけの回転
+		const Vector3 identity = Math::ToEulerXYZ(Math::IdentityQuaternion());
+		TEST_CHECK(identity.x == 0.0f && identity.y == 0.0f && identity.z == 0.0f);
+		const Vector3 pitchOnly = Math::ToEulerXYZ(Math::MakeRotateXYZQuaternion({ 0.0f, kPi * 0.5f, 0.0f }));
+		TEST_CHECK(std::abs(pitchOnly.y - kPi * 0.5f) <= 1e-3f);
+		TEST_CHECK(MatrixDifference(MakeRotateXYZByMatrices(pitchOnly), MakeRotateXYZByMatrices({ 0.0f, kPi * 0.5f, 0.0f })) <= kMatrixTolerance);
+	}
+
+	// 倍精度の Slerp（基準）
+	void ReferenceSlerp(const Quaternion& q0, const Quaternion& q1, double t, double out[4])
+	{
+		const double a[] = { q0.x, q0.y, q0.z, q0.w };
+		double b[] = { q1.x, q1.y, q1.z, q1.w };
+		double dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+		if (dot < 0.0) {
+			for (double& value : b) {
+				value = -value;
+			}
+			dot = -dot;
+		}
+		const double theta = std::acos((std::min)(dot, 1.0));
+		const double scale0 = std::sin((1.0 - t) * theta) / std::sin(theta);
+		const double scale1 = std::sin(t * theta) / std::sin(theta);
+		for (int i = 0; i < 4; ++i) {
+			out[i] = scale0 * a[i] + scale1 * b[i];
+		}
+	}
+
+	// クォータニオンの差（q と -q は同じ回転なので、符号を合わせてから比べる）
+	double QuaternionDifference(const Quaternion& q, const double expected[4])
+	{
+		const double value[] = { q.x, q.y, q.z, q.w };
+		double same = 0.0;
+		double flipped = 0.0;
+		for (int i = 0; i < 4; ++i) {
+			same = (std::max)(same, std::abs(value[i] - expected[i]));
+			flipped = (std::max)(flipped, std::abs(value[i] + expected[i]));
+		}
+		return (std::min)(same, flipped);
+	}
+
+	void TestSlerp()
+	{
+		std::mt19937 random(4004);
+		std::uniform_real_distribution<float> angle(-kPi, kPi);
+		double maxReferenceDifference = 0.0;
+		double maxEndpointDifference = 0.0;
+		for (int i = 0; i < kSampleCount / 4; ++i) {
+			const Quaternion q0 = Math::MakeRotateXYZQuaternion({ angle(random), angle(random), angle(random) });
+			const Quaternion q1 = Math::MakeRotateXYZQuaternion({ angle(random), angle(random), angle(random) });
+
+			// 両端は q0 と q1（と同じ回転）
+			maxEndpointDifference = (std::max)(maxEndpointDifference, MatrixDifference(Math::MakeRotateMatrix(Math::Slerp(q0, q1, 0.0f)), Math::MakeRotateMatrix(q0)));
+			maxEndpointDifference = (std::max)(maxEndpointDifference, MatrixDifference(Math::MakeRotateMatrix(Math::Slerp(q0, q1, 1.0f)), Math::MakeRotateMatrix(q1)));
+
+			// q1 と -q1 は同じ回転なので、どちらに向けても同じ（最短の）経路を通る
+			const Quaternion negated = { -q1.x, -q1.y, -q1.z, -q1.w };
+			const float totalAngle = Math::AngleBetween(q0, q1);
+			TEST_CHECK(totalAngle <= kPi + 1e-5f);
+			for (float t = 0.125f; t < 1.0f; t += 0.125f) {
+				const Quaternion q = Math::Slerp(q0, q1, t);
+				double expected[4];
+				ReferenceSlerp(q0, q1, t, expected);
+				maxReferenceDifference = (std::max)(maxReferenceDifference, QuaternionDifference(q, expected));
+				maxReferenceDifference = (std::max)(maxReferenceDifference, QuaternionDifference(Math::Slerp(q0, negated, t), expected));
+				TEST_CHECK(std::abs(QuaternionLength(q) - 1.0) <= 1e-5);
+			}
+		}
+		std::printf("  Slerp                   max difference %.3g (vs double), endpoints %.3g\n", maxReferenceDifference, maxEndpointDifference);
+		TEST_CHECK(maxReferenceDifference <= 1e-5);
+		TEST_CHECK(maxEndpointDifference <= kMatrixTolerance);
+
+		// 同じ軸の回転の間では、t に比例した角度の軸回転になる（角速度が一定）
+		const Vector3 axis = { 0.0f, 0.6f, 0.8f };
+		const Quaternion from = Math::IdentityQuaternion();
+		const Quaternion to = Math::MakeRotateAxisAngleQuaternion(axis, 2.5f);
+		for (int step = 0; step <= 10; ++step) {
+			const float t = 0.1f * static_cast<float>(step);
+			const Matrix4x4 expected = Math::MakeRotateMatrix(Math::MakeRotateAxisAngleQuaternion(axis, 2.5f * t));
+			TEST_CHECK(MatrixDifference(Math::MakeRotateMatrix(Math::Slerp(from, to, t)), expected) <= kMatrixTolerance);
+		}
+
+		// 180° を超える回転へは反対回りの短い経路を通る（3.5 rad の代わりに -(2π - 3.5) rad）
+		const Quaternion far = Math::MakeRotateAxisAngleQuaternion(axis, 3.5f);
+		const Quaternion halfway = Math::Slerp(from, far, 0.5f);
+		TEST_CHECK(std::abs(Math::AngleBetween(from, halfway) - (2.0f * kPi - 3.5f) * 0.5f) <= 1e-3f);
+
+		// ほぼ同じ向き（Nlerp に切り替わる範囲）でも正規化され、間にある
+		const Quaternion near0 = Math::MakeRotateAxisAngleQuaternion(axis, 0.5f);
+		const Quaternion near1 = Math::MakeRotateAxisAngleQuaternion(axis, 0.52f);
+		TEST_CHECK(Math::Dot(near0, near1) > 0.9995f);
+		for (int step = 0; step <= 4; ++step) {
+			const float t = 0.25f * static_cast<float>(step);
+			const Quaternion q = Math::Slerp(near0, near1, t);
+			TEST_CHECK(std::abs(QuaternionLength(q) - 1.0) <= 1e-6);
+			const Matrix4x4 expected = Math::MakeRotateMatrix(Math::MakeRotateAxisAngleQuaternion(axis, 0.5f + 0.02f * t));
+			TEST_CHECK(MatrixDifference(Math::MakeRotateMatrix(q), expected) <= kMatrixTolerance);
+		}
+
+		// 同じ回転同士の補間はそのまま
+		const Quaternion same = Math::Slerp(near0, near0, 0.3f);
+		TEST_CHECK(MatrixDifference(Math::MakeRotateMatrix(same), Math::MakeRotateMatrix(near0)) <= kMatrixTolerance);
+	}
+}
+
+int main()
+{
+	TestEulerQuaternionMatchesMatrices();
+	TestEulerRoundTrip();
+	TestEulerRoundTripAtGimbalLock();
+	TestSlerp();
+	return TestCommon::Finish("QuaternionTest");
+}
@@ -0,0 +1,355 @@
+#include "TestCommon.h"
+#include "RenderCommandRecorder.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+//
+// RenderCommandRecorderTest
+// - D3D12 の代わりに、呼ばれた順を記録するだけの MockCommandSink に流して RenderCommandRecorder を確かめる。
+// - キーの詰め方、基数ソートの順序と安定性（std::stable_sort と一致すること）、同じ状態の切り替えの省略、統計を見る。
+// - Object3dRenderQueue と同じまとめ方をする BatchingSink で、キーに入れる番号による DrawInstanced の数の違いも見る。
+//
+using namespace MyEngine;
+
+namespace {
+	// 出力先に届いた呼び出し 1 回分
+	struct SinkCall {
+		enum class Type { kPipeline, kMaterial, kDraw };
+		Type type;
+		uint32_t value;
+
+		bool operator==(const SinkCall&) const = default;
+	};
+
+	/// <summary>
+	/// テスト用の出力先
+	/// 呼ばれた順に記録するだけ
+	/// </summary>
+	class MockCommandSink : public RenderCommandSink
+	{
+	public:
+		void BindPipeline(uint32_t pipeline) override { calls_.push_back({ SinkCall::Type::kPipeline, pipeline }); }
+		void BindMaterial(uint32_t material) override { calls_.push_back({ SinkCall::Type::kMaterial, material }); }
+		void Draw(uint32_t payload) override { calls_.push_back({ SinkCall::Type::kDraw, payload }); }
+
+		const std::vector<SinkCall>& GetCalls() const { return calls_; }
+
+		// 指定した種類の呼び出し数
+		uint32_t Count(SinkCall::Type type) const
+		{
+			return static_cast<uint32_t>(std::count_if(calls_.begin(), calls_.end(),
+				[type](const SinkCall& call) { return call.type == type; }));
+		}
+
+	private:
+		std::vector<SinkCall> calls_;
+	};
+
+	SinkCall Pipeline(uint32_t pipeline) { return { SinkCall::Type::kPipeline, pipeline }; }
+	SinkCall Material(uint32_t material) { return { SinkCall::Type::kMaterial, material }; }
+	SinkCall Draw(uint32_t payload) { return { SinkCall::Type::kDraw, payload }; }
+
+	// 再現できる疑似乱数（xorshift32）
+	uint32_t NextRandom(uint32_t& state)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	void TestSortKeyEncoding()
+	{
+		using namespace RenderSortKey;
+
+		constexpr uint64_t key = Encode(3, 0xABC, 0x123456, 0x789ABC);
+		static_assert(GetLayer(key) == 3);
+		static_assert(GetPipeline(key) == 0xABC);
+		static_assert(GetMaterial(key) == 0x123456);
+		static_assert(GetDepth(key) == 0x789ABC);
+
+		// 範囲外の値は下位ビットだけが入り、隣のフィールドを壊さない
+		constexpr uint64_t overflow = Encode(0x11, 0x1FFF, 0x1FFFFFF, 0x1FFFFFF);
+		static_assert(GetLayer(overflow) == 1);
+		static_assert(GetPipeline(overflow) == kPipelineMask);
+		static_assert(GetMaterial(overflow) == kMaterialMask);
+		static_assert(GetDepth(overflow) == kDepthMask);
+
+		// 上位のフィールドほど優先される
+		TEST_CHECK(Encode(0, kPipelineMask, kMaterialMask, kDepthMask) < Encode(1, 0, 0, 0));
+		TEST_CHECK(Encode(0, 0, kMaterialMask, kDepthMask) < Encode(0, 1, 0, 0));
+		TEST_CHECK(Encode(0, 0, 0, kDepthMask) < Encode(0, 0, 1, 0));
+
+		// 深度：手前ほど小さく、backToFront では奥ほど小さい
+		TEST_CHECK(EncodeDepth(0.0f) == 0);
+		TEST_CHECK(EncodeDepth(-1.0f) == 0);
+		TEST_CHECK(EncodeDepth(1.0f) < EncodeDepth(2.0f));
+		TEST_CHECK(EncodeDepth(2.0f) < EncodeDepth(1000.0f));
+		TEST_CHECK(EncodeDepth(1.0f, true) > EncodeDepth(2.0f, true));
+		TEST_CHECK(EncodeDepth(1000.0f) <= kDepthMask);
+	}
+
+	void TestSortOrder()
+	{
+		RenderCommandRecorder recorder;
+		recorder.Record(RenderSortKey::kLayerTransparent, 1, 1, 5, 0);
+		recorder.Record(RenderSortKey::kLayerOpaque, 2, 1, 9, 1);
+		recorder.Record(RenderSortKey::kLayerOpaque, 1, 2, 3, 2);
+		recorder.Record(RenderSortKey::kLayerSky, 0, 0, 0, 3);
+		recorder.Record(RenderSortKey::kLayerOpaque, 1, 2, 1, 4);
+		recorder.Record(RenderSortKey::kLayerOpaque, 1, 1, 7, 5);
+		recorder.Sort();
+
+		// レイヤー → パイプライン → マテリアル → 深度 の順
+		const std::vector<uint32_t> expected = { 5, 4, 2, 1, 3, 0 };
+		TEST_CHECK(recorder.GetCommandCount() == expected.size());
+		for (size_t i = 0; i < expected.size() && i < recorder.GetCommandCount(); ++i) {
+			TEST_CHECK(recorder.GetCommands()[i].payload == expected[i]);
+		}
+	}
+
+	void TestSortMatchesStableSort()
+	{
+		// 件数と、キーの散らばり方（桁を飛ばす経路・奇数回の入れ替えも通す）を変えて std::stable_sort と比べる
+		const uint32_t counts[] = { 0, 1, 2, 3, 17, 256, 1000, 4099 };
+		const uint64_t keyMasks[] = {
+			~0ull,                                 // 全ての桁がばらばら
+			0x00000000000000FFull,                 // 最下位の 1 桁だけ（入れ替え 1 回）
+			0x0000000000FFFF00ull,                 // 中間の 2 桁だけ
+			0xFF00000000000000ull,                 // 最上位の 1 桁だけ
+			0x0F0000000000000Full,                 // レイヤーと深度の下位だけ
+			0ull,                                  // 全て同じキー（安定性だけ）
+		};
+
+		uint32_t state = 0x12345678u;
+		for (uint32_t count : counts) {
+			for (uint64_t keyMask : keyMasks) {
+				RenderCommandRecorder recorder;
+				std::vector<RenderCommandRecorder::Command> expected;
+				for (uint32_t i = 0; i < count; ++i) {
+					const uint64_t random = (static_cast<uint64_t>(NextRandom(state)) << 32) | NextRandom(state);
+					// 重複を多めに出すため、ときどき直前のキーを使う
+					const uint64_t key = (i > 0 && (NextRandom(state) & 3) == 0) ? expected.back().sortKey : (random & keyMask);
+					recorder.Record(key, i);
+					expected.push_back({ key, i });
+				}
+				std::stable_sort(expected.begin(), expected.end(),
+					[](const RenderCommandRecorder::Command& a, const RenderCommandRecorder::Command& b) { return a.sortKey < b.sortKey; });
+
+				recorder.Sort();
+				const std::vector<RenderCommandRecorder::Command>& commands = recorder.GetCommands();
+				TEST_CHECK(commands.size() == expected.size());
+				bool isSame = commands.size() == expected.size();
+				for (size_t i = 0; isSame && i < commands.size(); ++i) {
+					isSame = commands[i].sortKey == expected[i].sortKey && commands[i].payload == expected[i].payload;
+				}
+				TEST_CHECK(isSame);
+			}
+		}
+	}
+
+	void TestRedundantStateIsSkipped()
+	{
+		RenderCommandRecorder recorder;
+		recorder.Record(0, 1, 10, 3, 0);
+		recorder.Record(0, 1, 10, 1, 1);
+		recorder.Record(0, 1, 11, 2, 2);
+		recorder.Record(0, 2, 11, 4, 3);
+		recorder.Record(0, 2, 11, 5, 4);
+		recorder.Record(1, 2, 11, 0, 5);
+		recorder.Sort();
+
+		MockCommandSink sink;
+		const RenderSubmitStats stats = recorder.Submit(sink);
+
+		// レイヤーが変わってもパイプライン・マテリアルが同じなら設定し直さない
+		// パイプラインを切り替えた直後は、マテリアルが前と同じでも設定し直す
+		const std::vector<SinkCall> expected = {
+			Pipeline(1), Material(10), Draw(1), Draw(0),
+			Material(11), Draw(2),
+			Pipeline(2), Material(11), Draw(3), Draw(4),
+			Draw(5),
+		};
+		TEST_CHECK(sink.GetCalls() == expected);
+
+		TEST_CHECK(stats.commandCount == 6);
+		TEST_CHECK(stats.pipelineBindCount == 2);
+		TEST_CHECK(stats.materialBindCount == 3);
+		TEST_CHECK(stats.skippedPipelineBinds == 4);
+		TEST_CHECK(stats.skippedMaterialBinds == 3);
+		TEST_CHECK(stats.commandCount == stats.pipelineBindCount + stats.skippedPipelineBinds);
+		TEST_CHECK(stats.commandCount == stats.materialBindCount + stats.skippedMaterialBinds);
+	}
+
+	void TestSortingReducesStateChanges()
+	{
+		// パイプライン 4 種 × マテリアル 8 種を交互に記録すると、並べ替えなしではほぼ毎回切り替わる
+		RenderCommandRecorder recorder;
+		uint32_t state = 0x9E3779B9u;
+		constexpr uint32_t kDrawCount = 512;
+		for (uint32_t i = 0; i < kDrawCount; ++i) {
+			recorder.Record(RenderSortKey::kLayerOpaque, i % 4, (i / 4) % 8, NextRandom(state) & RenderSortKey::kDepthMask, i);
+		}
+
+		MockCommandSink unsortedSink;
+		const RenderSubmitStats unsorted = recorder.Submit(unsortedSink);
+		TEST_CHECK(unsorted.pipelineBindCount == kDrawCount);
+
+		recorder.Sort();
+		MockCommandSink sortedSink;
+		const RenderSubmitStats sorted = recorder.Submit(sortedSink);
+		TEST_CHECK(sorted.commandCount == kDrawCount);
+		TEST_CHECK(sorted.pipelineBindCount == 4);
+		TEST_CHECK(sorted.materialBindCount == 4 * 8);
+		TEST_CHECK(sortedSink.Count(SinkCall::Type::kDraw) == kDrawCount);
+		TEST_CHECK(sortedSink.Count(SinkCall::Type::kPipeline) == sorted.pipelineBindCount);
+		TEST_CHECK(sortedSink.Count(SinkCall::Type::kMaterial) == sorted.materialBindCount);
+
+		// 全ての描画がちょうど 1 回ずつ届く
+		std::vector<uint32_t> payloads;
+		for (const SinkCall& call : sortedSink.GetCalls()) {
+			if (call.type == SinkCall::Type::kDraw) {
+				payloads.push_back(call.value);
+			}
+		}
+		std::sort(payloads.begin(), payloads.end());
+		bool isEveryDrawOnce = payloads.size() == kDrawCount;
+		for (uint32_t i = 0; isEveryDrawOnce && i < kDrawCount; ++i) {
+			isEveryDrawOnce = payloads[i] == i;
+		}
+		TEST_CHECK(isEveryDrawOnce);
+	}
+
+	/// <summary>
+	/// Object3dRenderQueue と同じまとめ方をする出力先
+	/// BindMaterial か、前と状態が違う Draw でまとめている描画を 1 回の DrawInstanced として確定する
+	/// </summary>
+	class BatchingSink : public RenderCommandSink
+	{
+	public:
+		explicit BatchingSink(const std::vector<uint32_t>& states) : states_(states) {}
+
+		void BindPipeline([[maybe_unused]] uint32_t pipeline) override { FlushBatch(); }
+		void BindMaterial([[maybe_unused]] uint32_t material) override { FlushBatch(); }
+		void Draw(uint32_t payload) override
+		{
+			if (batchCount_ > 0 && states_[payload] != batchState_) {
+				FlushBatch();
+			}
+			batchState_ = states_[payload];
+			++batchCount_;
+		}
+
+		// 最後にまとめている描画を確定して DrawInstanced の回数を返す
+		uint32_t Finish()
+		{
+			FlushBatch();
+			return drawInstancedCount_;
+		}
+
+	private:
+		void FlushBatch()
+		{
+			if (batchCount_ > 0) {
+				++drawInstancedCount_;
+				batchCount_ = 0;
+			}
+		}
+
+		const std::vector<uint32_t>& states_;
+		uint32_t batchState_ = 0;
+		uint32_t batchCount_ = 0;
+		uint32_t drawInstancedCount_ = 0;
+	};
+
+	// 同じメッシュで状態（色・ライト）が違うものは、キーに状態の番号を入れないと距離順に交互に並んで DrawInstanced が区切られる
+	void TestBatchStateKeyKeepsInstancesTogether()
+	{
+		constexpr uint32_t kDrawCount = 256;
+		constexpr uint32_t kStateCount = 4;
+		constexpr uint32_t kMeshId = 1;
+		uint32_t random = 0x2545F491u;
+		std::vector<uint32_t> states(kDrawCount);
+		std::vector<uint32_t> depths(kDrawCount);
+		for (uint32_t i = 0; i < kDrawCount; ++i) {
+			states[i] = i % kStateCount;
+			depths[i] = NextRandom(random) & RenderSortKey::kDepthMask;
+		}
+
+		// メッシュの番号だけのキー
+		RenderCommandRecorder meshKeyed;
+		for (uint32_t i = 0; i < kDrawCount; ++i) {
+			meshKeyed.Record(RenderSortKey::kLayerOpaque, 0, kMeshId, depths[i], i);
+		}
+		meshKeyed.Sort();
+		BatchingSink meshSink(states);
+		meshKeyed.Submit(meshSink);
+		const uint32_t meshKeyedDraws = meshSink.Finish();
+
+		// 状態の番号を距離より前に入れたキー（Object3dRenderQueue::FindOrAddBatchStateId）
+		RenderCommandRecorder stateKeyed;
+		for (uint32_t i = 0; i < kDrawCount; ++i) {
+			stateKeyed.Record(RenderSortKey::kLayerOpaque, 0, states[i], depths[i], i);
+		}
+		stateKeyed.Sort();
+		BatchingSink stateSink(states);
+		const RenderSubmitStats stats = stateKeyed.Submit(stateSink);
+		const uint32_t stateKeyedDraws = stateSink.Finish();
+
+		std::printf("  same mesh, %u states: DrawInstanced %u (mesh key) -> %u (batch state key)\n", kStateCount, meshKeyedDraws, stateKeyedDraws);
+		TEST_CHECK(stateKeyedDraws == kStateCount);
+		TEST_CHECK(stats.materialBindCount == kStateCount);
+		TEST_CHECK(meshKeyedDraws > kDrawCount / 2);
+
+		// 同じ状態の中は手前から（距離の小さい順）
+		uint32_t previousState = UINT32_MAX;
+		uint32_t previousDepth = 0;
+		bool isFrontToBack = true;
+		for (const RenderCommandRecorder::Command& command : stateKeyed.GetCommands()) {
+			const uint32_t depth = RenderSortKey::GetDepth(command.sortKey);
+			if (states[command.payload] == previousState) {
+				isFrontToBack = isFrontToBack && previousDepth <= depth;
+			}
+			previousState = states[command.payload];
+			previousDepth = depth;
+		}
+		TEST_CHECK(isFrontToBack);
+	}
+
+	void TestResetKeepsNothing()
+	{
+		RenderCommandRecorder recorder;
+		recorder.Record(0, 1, 1, 1, 0);
+		recorder.Record(0, 2, 2, 2, 1);
+		recorder.Sort();
+		recorder.Reset();
+		TEST_CHECK(recorder.GetCommandCount() == 0);
+
+		// 空で Submit しても出力先は呼ばれない
+		MockCommandSink sink;
+		const RenderSubmitStats stats = recorder.Submit(sink);
+		TEST_CHECK(sink.GetCalls().empty());
+		TEST_CHECK(stats.commandCount == 0);
+
+		// 前のフレームの状態を持ち越さない（毎回最初にバインドし直す）
+		recorder.Record(0, 2, 2, 2, 7);
+		recorder.Sort();
+		recorder.Submit(sink);
+		const std::vector<SinkCall> expected = { Pipeline(2), Material(2), Draw(7) };
+		TEST_CHECK(sink.GetCalls() == expected);
+	}
+}
+
+int main()
+{
+	TestSortKeyEncoding();
+	TestSortOrder();
+	TestSortMatchesStableSort();
+	TestRedundantStateIsSkipped();
+	TestSortingReducesStateChanges();
+	TestBatchStateKeyKeepsInstancesTogether();
+	TestResetKeepsNothing();
+	return TestCommon::Finish("RenderCommandRecorderTest");
+}
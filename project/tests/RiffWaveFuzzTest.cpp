@@ -0,0 +1,299 @@
+#include "TestCommon.h"
+#include "WaveTestData.h"
+#include "RiffReader.h"
+#include "WaveFile.h"
+#include <filesystem>
+#include <memory>
+
+//
+// RiffWaveFuzzTest
+// - RiffReader / WaveFile に対するコーパスのテスト（ヘッドレスで動く）。
+//   1) 正常なコーパス：PCM16 / PCM24 / float × モノラル / ステレオ × チャンクの並び（LIST / bext / cue / JUNK、data が先など）
+//   2) 対応外・壊れたコーパス：RIFF でない、fmt / data が無い、チャンネル数やビット数の不正など
+//   3) 正常なファイルを途中で切ったもの・乱数でバイトを書き換えたもの
+// - どの入力でも落ちず、返した span が入力の範囲内を指していることを確かめる。
+//   入力は毎回ちょうどの大きさのヒープに複製するため、サニタイザ付きでビルドすれば範囲外の読み込みも検出できる。
+//
+using namespace MyEngine;
+using namespace MyEngine::RiffConstants;
+using namespace MyEngine::WaveFileConstants;
+
+namespace {
+	constexpr uint32_t kSampleRate = 48000;
+	constexpr uint32_t kFrameCount = 64;
+
+	// 乱数で書き換える回数と、1 回で書き換えるバイト数の上限
+	constexpr uint32_t kMutationCount = 20000;
+	constexpr uint32_t kMaxMutatedBytes = 8;
+
+	// 決まった並びの乱数（xorshift32）
+	class Random
+	{
+	public:
+		explicit Random(uint32_t seed) : state_(seed) {}
+		uint32_t Next()
+		{
+			state_ ^= state_ << 13;
+			state_ ^= state_ >> 17;
+			state_ ^= state_ << 5;
+			return state_;
+		}
+
+	private:
+		uint32_t state_;
+	};
+
+	// 正常なコーパスのサンプル形式
+	struct FormatCase {
+		const char* name;
+		uint16_t formatTag;
+		uint16_t bitsPerSample;
+		SampleFormat expected;
+	};
+	constexpr FormatCase kFormatCases[] = {
+		{ "pcm16", kFormatTagPcm, 16, SampleFormat::Pcm16 },
+		{ "pcm24", kFormatTagPcm, 24, SampleFormat::Pcm24 },
+		{ "float32", kFormatTagFloat, 32, SampleFormat::Float32 },
+	};
+
+	// 正常なコーパスのチャンクの並び
+	enum class Layout {
+		Plain,
+		MetadataBeforeFormat,
+		DataBeforeFormat,
+		JunkAndOddChunks,
+		Extensible,
+		Count,
+	};
+
+	// span が入力の範囲内を指しているか
+	bool IsInside(std::span<const uint8_t> inner, std::span<const uint8_t> outer)
+	{
+		if (inner.empty()) {
+			return true;
+		}
+		return inner.data() >= outer.data() && inner.data() + inner.size() <= outer.data() + outer.size();
+	}
+
+	// ちょうどの大きさのヒープに複製して解析し、結果の範囲を検証する（戻り値は Parse の結果）
+	bool ParseExact(const std::vector<uint8_t>& bytes, WaveFile* result = nullptr)
+	{
+		std::unique_ptr<uint8_t[]> copy(new uint8_t[bytes.size() + 1]);
+		std::copy(bytes.begin(), bytes.end(), copy.get());
+		const std::span<const uint8_t> input(copy.get(), bytes.size());
+
+		WaveFile waveFile;
+		const bool isValid = waveFile.Parse(input);
+		TEST_CHECK(isValid == waveFile.IsValid());
+		for (const RiffChunk& chunk : waveFile.GetRiff().GetChunks()) {
+			TEST_CHECK(IsInside(chunk.data, input));
+		}
+		TEST_CHECK(IsInside(waveFile.GetSamples(), input));
+		TEST_CHECK(IsInside(waveFile.GetFormatChunk(), input));
+		if (isValid) {
+			TEST_CHECK(waveFile.GetFormat().blockAlign > 0);
+			TEST_CHECK(waveFile.GetSamples().size() % waveFile.GetFormat().blockAlign == 0);
+		}
+		else {
+			TEST_CHECK(waveFile.GetSamples().empty());
+		}
+
+		if (result != nullptr) {
+			result->Parse(input);
+		}
+		return isValid;
+	}
+
+	// 正常なコーパスを 1 つ作る
+	std::vector<uint8_t> BuildValidWave(const FormatCase& formatCase, uint16_t channels, Layout layout, const std::vector<uint8_t>& samples)
+	{
+		const std::vector<uint8_t> format = WaveTestData::MakeFormatChunk(
+			formatCase.formatTag, channels, kSampleRate, formatCase.bitsPerSample, layout == Layout::Extensible);
+		const WaveTestData::Chunk list{ MakeFourCC('L', 'I', 'S', 'T'), WaveTestData::MakePattern(34, 5) };
+		const WaveTestData::Chunk bext{ MakeFourCC('b', 'e', 'x', 't'), WaveTestData::MakePattern(602, 6) };
+		const WaveTestData::Chunk cue{ MakeFourCC('c', 'u', 'e', ' '), WaveTestData::MakePattern(28, 7) };
+
+		switch (layout) {
+		case Layout::MetadataBeforeFormat:
+			return WaveTestData::BuildRiff({ list, bext, { kFmtId, format }, cue, { kDataId, samples } });
+		case Layout::DataBeforeFormat:
+			return WaveTestData::BuildRiff({ { kDataId, samples }, list, { kFmtId, format } });
+		case Layout::JunkAndOddChunks:
+			// 奇数サイズのチャンクの後ろのパディングを飛ばせるか
+			return WaveTestData::BuildRiff({
+				{ MakeFourCC('J', 'U', 'N', 'K'), WaveTestData::MakePattern(13, 8) },
+				{ kFmtId, format },
+				{ MakeFourCC('J', 'U', 'N', 'K'), WaveTestData::MakePattern(1, 9) },
+				{ MakeFourCC('i', 'X', 'M', 'L'), WaveTestData::MakePattern(7, 10) },
+				{ kDataId, samples },
+				cue,
+			});
+		default:
+			return WaveTestData::BuildWave(format, samples);
+		}
+	}
+
+	// 1) 正常なコーパスはすべて読め、fmt / data がコピーされずに元のバイト列を指す
+	void TestValidCorpus()
+	{
+		for (const FormatCase& formatCase : kFormatCases) {
+			for (uint16_t channels = kMinChannelCount; channels <= kMaxChannelCount; ++channels) {
+				for (int layout = 0; layout < static_cast<int>(Layout::Count); ++layout) {
+					const uint32_t blockAlign = channels * formatCase.bitsPerSample / 8;
+					const std::vector<uint8_t> samples = WaveTestData::MakePattern(blockAlign * kFrameCount, layout);
+					const std::vector<uint8_t> bytes = BuildValidWave(formatCase, channels, static_cast<Layout>(layout), samples);
+
+					WaveFile waveFile;
+					TEST_CHECK(waveFile.Parse(bytes));
+					TEST_CHECK(waveFile.GetSampleFormat() == formatCase.expected);
+					TEST_CHECK(waveFile.GetFormat().formatTag == formatCase.formatTag);
+					TEST_CHECK(waveFile.GetFormat().channels == channels);
+					TEST_CHECK(waveFile.GetFormat().samplesPerSec == kSampleRate);
+					TEST_CHECK(waveFile.GetFormat().avgBytesPerSec == kSampleRate * blockAlign);
+					TEST_CHECK(waveFile.GetFrameCount() == kFrameCount);
+					TEST_CHECK(IsInside(waveFile.GetSamples(), bytes));
+					TEST_CHECK(std::equal(samples.begin(), samples.end(), waveFile.GetSamples().begin(), waveFile.GetSamples().end()));
+
+					// 途中で切ったもの（サイズはヘッダのまま）も落ちずに処理できる
+					for (size_t size = 0; size <= bytes.size(); ++size) {
+						ParseExact(std::vector<uint8_t>(bytes.begin(), bytes.begin() + size));
+					}
+				}
+			}
+		}
+	}
+
+	// 2) 対応外・壊れたコーパスはすべて false になる
+	void TestInvalidCorpus()
+	{
+		const std::vector<uint8_t> samples = WaveTestData::MakePattern(4 * kFrameCount);
+		const std::vector<uint8_t> format = WaveTestData::MakeFormatChunk(kFormatTagPcm, 2, kSampleRate, 16);
+
+		// fmt の一部を書き換えたもの
+		auto withFormatField = [&](size_t offset, uint16_t value) {
+			std::vector<uint8_t> changed = format;
+			std::memcpy(changed.data() + offset, &value, sizeof(value));
+			return WaveTestData::BuildWave(changed, samples);
+		};
+
+		std::vector<uint8_t> notRiff = WaveTestData::BuildWave(format, samples);
+		notRiff[3] = 'X';
+		std::vector<uint8_t> shortExtensible = WaveTestData::MakeFormatChunk(kFormatTagPcm, 2, kSampleRate, 16, true);
+		shortExtensible.resize(kExtensibleFormatChunkMinSize - 2);
+		std::vector<uint8_t> zeroRate = format;
+		std::memset(zeroRate.data() + 4, 0, sizeof(uint32_t));
+
+		const std::vector<std::vector<uint8_t>> corpus = {
+			{},
+			{ 'R', 'I', 'F', 'F' },
+			notRiff,
+			WaveTestData::BuildRiff({ { kFmtId, format }, { kDataId, samples } }, MakeFourCC('A', 'V', 'I', ' ')),
+			WaveTestData::BuildRiff({ { kDataId, samples } }),
+			WaveTestData::BuildRiff({ { kFmtId, format } }),
+			WaveTestData::BuildRiff({}),
+			WaveTestData::BuildWave(std::vector<uint8_t>(format.begin(), format.begin() + kFormatChunkMinSize - 1), samples),
+			WaveTestData::BuildWave(WaveTestData::MakeFormatChunk(kFormatTagPcm, 2, kSampleRate, 8), samples),
+			WaveTestData::BuildWave(WaveTestData::MakeFormatChunk(kFormatTagPcm, 2, kSampleRate, 32), samples),
+			WaveTestData::BuildWave(WaveTestData::MakeFormatChunk(kFormatTagFloat, 2, kSampleRate, 64), samples),
+			WaveTestData::BuildWave(WaveTestData::MakeFormatChunk(2, 2, kSampleRate, 16), samples),
+			WaveTestData::BuildWave(shortExtensible, samples),
+			WaveTestData::BuildWave(zeroRate, samples),
+			withFormatField(2, 0),
+			withFormatField(2, 3),
+			withFormatField(12, 0),
+			withFormatField(12, 3),
+		};
+
+		for (const std::vector<uint8_t>& bytes : corpus) {
+			TEST_CHECK(!ParseExact(bytes));
+		}
+	}
+
+	// RIFF ヘッダやチャンクのサイズがファイルより大きくても、読める範囲だけを索引にする
+	void TestOversizedSizes()
+	{
+		const std::vector<uint8_t> samples = WaveTestData::MakePattern(4 * kFrameCount);
+		std::vector<uint8_t> bytes = WaveTestData::BuildWave(WaveTestData::MakeFormatChunk(kFormatTagPcm, 2, kSampleRate, 16), samples);
+
+		// RIFF のサイズだけ大きい
+		std::vector<uint8_t> largeRiff = bytes;
+		const uint32_t maxSize = UINT32_MAX;
+		std::memcpy(largeRiff.data() + 4, &maxSize, sizeof(maxSize));
+		TEST_CHECK(ParseExact(largeRiff));
+
+		// data のサイズがファイルより大きい（最後の 1 フレームの途中で切れている）
+		std::vector<uint8_t> largeData = bytes;
+		const size_t dataSizeOffset = largeData.size() - samples.size() - sizeof(uint32_t);
+		std::memcpy(largeData.data() + dataSizeOffset, &maxSize, sizeof(maxSize));
+		largeData.pop_back();
+		WaveFile waveFile;
+		TEST_CHECK(ParseExact(largeData, &waveFile));
+		TEST_CHECK(waveFile.GetFrameCount() == kFrameCount - 1);
+
+		// RIFF のサイズがファイルより小さい場合は、その範囲の外にある data を見ない
+		std::vector<uint8_t> smallRiff = bytes;
+		// RIFF のサイズは形式 ID（4 バイト）から数えるので、fmt チャンクの末尾までにする
+		const uint32_t headerOnly = static_cast<uint32_t>(sizeof(uint32_t) + kChunkHeaderSize + kFormatChunkMinSize);
+		std::memcpy(smallRiff.data() + 4, &headerOnly, sizeof(headerOnly));
+		TEST_CHECK(!ParseExact(smallRiff));
+	}
+
+	// 3) 正常なファイルのバイトを乱数で書き換えても落ちない
+	void TestRandomMutations()
+	{
+		Random random(0x5EED1234u);
+		std::vector<std::vector<uint8_t>> seeds;
+		for (const FormatCase& formatCase : kFormatCases) {
+			for (int layout = 0; layout < static_cast<int>(Layout::Count); ++layout) {
+				const uint32_t blockAlign = 2 * formatCase.bitsPerSample / 8;
+				seeds.push_back(BuildValidWave(formatCase, 2, static_cast<Layout>(layout), WaveTestData::MakePattern(blockAlign * 8, layout)));
+			}
+		}
+
+		uint32_t validCount = 0;
+		for (uint32_t i = 0; i < kMutationCount; ++i) {
+			std::vector<uint8_t> bytes = seeds[random.Next() % seeds.size()];
+			const uint32_t mutatedBytes = 1 + random.Next() % kMaxMutatedBytes;
+			for (uint32_t j = 0; j < mutatedBytes; ++j) {
+				// 書き換えの大半はヘッダ付近（サイズ・ID・fmt）に集める
+				const size_t range = (random.Next() & 1) ? (std::min)(bytes.size(), size_t{ 64 }) : bytes.size();
+				bytes[random.Next() % range] = static_cast<uint8_t>(random.Next());
+			}
+			if (random.Next() % 4 == 0) {
+				bytes.resize(random.Next() % (bytes.size() + 1));
+			}
+			validCount += ParseExact(bytes) ? 1 : 0;
+		}
+
+		// 書き換えがデータ部分だけだったものは読めるはず（全部が失敗するのは解析側の誤り）
+		TEST_CHECK(validCount > 0);
+	}
+
+	// メモリマップ経由（WaveFile::Open）でも同じ結果になる
+	void TestOpenMappedFile()
+	{
+		const std::vector<uint8_t> samples = WaveTestData::MakePattern(6 * kFrameCount);
+		const std::vector<uint8_t> bytes = BuildValidWave(kFormatCases[1], 2, Layout::MetadataBeforeFormat, samples);
+		const std::string path = WaveTestData::WriteTempFile("RiffWaveFuzzTest_mapped.wav", bytes);
+
+		WaveFile waveFile;
+		TEST_CHECK(waveFile.Open(path));
+		TEST_CHECK(waveFile.GetSampleFormat() == SampleFormat::Pcm24);
+		TEST_CHECK(waveFile.GetRiff().GetChunks().size() == 5);
+		TEST_CHECK(std::equal(samples.begin(), samples.end(), waveFile.GetSamples().begin(), waveFile.GetSamples().end()));
+		waveFile.Close();
+		TEST_CHECK(!waveFile.IsValid());
+
+		std::filesystem::remove(path);
+	}
+}
+
+int main()
+{
+	TestValidCorpus();
+	TestInvalidCorpus();
+	TestOversizedSizes();
+	TestRandomMutations();
+	TestOpenMappedFile();
+	return TestCommon::Finish("RiffWaveFuzzTest");
+}
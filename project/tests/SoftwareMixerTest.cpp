@@ -0,0 +1,276 @@
+#include "TestCommon.h"
+#include "WaveTestData.h"
+#include "MixKernels.h"
+#include "SoftwareMixer.h"
+#include "VoicePool.h"
+#include <cmath>
+#include <filesystem>
+#include <numbers>
+
+//
+// SoftwareMixerTest
+// - 既知の波形を SoftwareMixer で合成し、バスのサンプルを期待値と比べる（決定的な音声テスト）。
+// - 期待値はテスト側でスカラーの式から求める。SSE2 の経路とスカラーの経路は同じ演算順なので一致するはず。
+// - Audio::RenderToWaveFile と同じく VoicePool + SoftwareMixer + WavFileAudioSink で書き出し、2 回の出力が同じになることも確かめる。
+//
+using namespace MyEngine;
+using namespace MyEngine::WaveFileConstants;
+
+namespace {
+	constexpr uint32_t kSampleRate = SoftwareMixerConstants::kDefaultSampleRate;
+
+	// 浮動小数の比較の許容誤差（変換・補間の丸め分）
+	constexpr float kTolerance = 1e-6f;
+
+	bool IsNear(float a, float b, float tolerance = kTolerance) { return std::fabs(a - b) <= tolerance; }
+
+	// PCM16 のサンプル列を作る（値は frame * 37 + channel * 1000 を 16bit に収めたもの）
+	std::vector<int16_t> MakePcm16(uint32_t frameCount, uint16_t channels)
+	{
+		std::vector<int16_t> samples(static_cast<size_t>(frameCount) * channels);
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+			for (uint16_t channel = 0; channel < channels; ++channel) {
+				samples[frame * channels + channel] = static_cast<int16_t>((static_cast<int32_t>(frame) * 37 + channel * 1000) % 30000 - 15000);
+			}
+		}
+		return samples;
+	}
+
+	std::span<const uint8_t> AsBytes(const std::vector<int16_t>& samples)
+	{
+		return { reinterpret_cast<const uint8_t*>(samples.data()), samples.size() * sizeof(int16_t) };
+	}
+
+	WaveFormat MakeFormat(uint16_t formatTag, uint16_t channels, uint32_t sampleRate, uint16_t bitsPerSample)
+	{
+		const uint16_t blockAlign = static_cast<uint16_t>(channels * bitsPerSample / 8);
+		return WaveFormat{ formatTag, channels, sampleRate, sampleRate * blockAlign, blockAlign, bitsPerSample };
+	}
+
+	// ステレオのソースは中央で素通し、モノラルは中央で 1/√2（等パワー）
+	void TestPanGains()
+	{
+		float left = 0.0f;
+		float right = 0.0f;
+
+		MixKernels::CalculatePanGains(1.0f, 0.0f, 2, left, right);
+		TEST_CHECK(left == 1.0f && right == 1.0f);
+		MixKernels::CalculatePanGains(0.5f, -1.0f, 2, left, right);
+		TEST_CHECK(left == 0.5f && right == 0.0f);
+		MixKernels::CalculatePanGains(1.0f, 0.5f, 2, left, right);
+		TEST_CHECK(left == 0.5f && right == 1.0f);
+
+		MixKernels::CalculatePanGains(1.0f, 0.0f, 1, left, right);
+		TEST_CHECK(IsNear(left, std::numbers::sqrt2_v<float> / 2.0f) && IsNear(right, std::numbers::sqrt2_v<float> / 2.0f));
+		MixKernels::CalculatePanGains(1.0f, 1.0f, 1, left, right);
+		TEST_CHECK(IsNear(left, 0.0f) && IsNear(right, 1.0f));
+		MixKernels::CalculatePanGains(1.0f, 0.3f, 1, left, right);
+		TEST_CHECK(IsNear(left * left + right * right, 1.0f, 1e-5f));
+	}
+
+	// 同じレートのステレオ PCM16 は、中央なら元の値がそのままバスに出て、終わった後は無音
+	void TestStereoPassThrough()
+	{
+		constexpr uint32_t kFrameCount = 1000;
+		const std::vector<int16_t> samples = MakePcm16(kFrameCount, 2);
+
+		SoftwareMixer mixer;
+		mixer.Initialize(nullptr, kSampleRate);
+		const uint32_t voiceId = mixer.CreateVoice(MakeFormat(kFormatTagPcm, 2, kSampleRate, 16));
+		mixer.Start(voiceId, AsBytes(samples));
+
+		mixer.Render(kFrameCount + 24);
+		const std::span<const float> bus = mixer.GetBus();
+		TEST_CHECK(bus.size() == (kFrameCount + 24) * 2);
+		bool isSame = true;
+		for (uint32_t i = 0; i < kFrameCount * 2; ++i) {
+			isSame = isSame && bus[i] == static_cast<float>(samples[i]) / 32768.0f;
+		}
+		TEST_CHECK(isSame);
+		for (uint32_t i = kFrameCount * 2; i < bus.size(); ++i) {
+			TEST_CHECK(bus[i] == 0.0f);
+		}
+		TEST_CHECK(!mixer.IsPlaying(voiceId));
+		TEST_CHECK(mixer.GetLastMixedVoiceCount() == 1);
+	}
+
+	// モノラル 24bit は音量とパンのゲインを掛けて左右に出る。Render を分けても同じ結果になる
+	void TestMonoGainAndBlockSplit()
+	{
+		constexpr uint32_t kFrameCount = 700;
+		std::vector<uint8_t> bytes;
+		std::vector<float> expected;
+		for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+			const int32_t value = static_cast<int32_t>(frame * 9973 % 16000000) - 8000000;
+			bytes.push_back(static_cast<uint8_t>(value & 0xFF));
+			bytes.push_back(static_cast<uint8_t>((value >> 8) & 0xFF));
+			bytes.push_back(static_cast<uint8_t>((value >> 16) & 0xFF));
+			expected.push_back(static_cast<float>(value) / 8388608.0f);
+		}
+
+		float gainLeft = 0.0f;
+		float gainRight = 0.0f;
+		MixKernels::CalculatePanGains(0.8f, -0.25f, 1, gainLeft, gainRight);
+
+		SoftwareMixer mixer;
+		mixer.Initialize(nullptr, kSampleRate);
+		const uint32_t voiceId = mixer.CreateVoice(MakeFormat(kFormatTagPcm, 1, kSampleRate, 24));
+		mixer.SetVoiceVolume(voiceId, 0.8f);
+		mixer.SetVoicePan(voiceId, -0.25f);
+		mixer.Start(voiceId, bytes);
+
+		// 半端な大きさで分けて合成する
+		uint32_t frame = 0;
+		for (uint32_t blockFrames : { 1u, 255u, 257u, 187u }) {
+			mixer.Render(blockFrames);
+			const std::span<const float> bus = mixer.GetBus();
+			for (uint32_t i = 0; i < blockFrames; ++i, ++frame) {
+				TEST_CHECK(IsNear(bus[i * 2], expected[frame] * gainLeft));
+				TEST_CHECK(IsNear(bus[i * 2 + 1], expected[frame] * gainRight));
+			}
+		}
+		TEST_CHECK(!mixer.IsPlaying(voiceId));
+	}
+
+	// ソースが半分のレートなら線形補間で 2 倍の長さになる
+	void TestResampleHalfRate()
+	{
+		constexpr uint32_t kSourceFrames = 300;
+		std::vector<float> samples(kSourceFrames);
+		for (uint32_t i = 0; i < kSourceFrames; ++i) {
+			samples[i] = std::sin(static_cast<float>(i) * 0.05f) * 0.5f;
+		}
+		const std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(samples.data()), samples.size() * sizeof(float));
+
+		SoftwareMixer mixer;
+		mixer.Initialize(nullptr, kSampleRate);
+		const uint32_t voiceId = mixer.CreateVoice(MakeFormat(kFormatTagFloat, 1, kSampleRate / 2, 32));
+		mixer.SetVoicePan(voiceId, 1.0f);
+		mixer.Start(voiceId, bytes);
+		mixer.Render(kSourceFrames * 2);
+
+		float gainLeft = 0.0f;
+		float gainRight = 0.0f;
+		MixKernels::CalculatePanGains(1.0f, 1.0f, 1, gainLeft, gainRight);
+
+		const std::span<const float> bus = mixer.GetBus();
+		for (uint32_t frame = 0; frame + 2 < kSourceFrames * 2; ++frame) {
+			const uint32_t index = frame / 2;
+			const float t = (frame % 2) * 0.5f;
+			const float expected = samples[index] + (samples[index + 1] - samples[index]) * t;
+			TEST_CHECK(IsNear(bus[frame * 2 + 1], expected * gainRight));
+			TEST_CHECK(IsNear(bus[frame * 2], expected * gainLeft));
+		}
+		TEST_CHECK(!mixer.IsPlaying(voiceId));
+	}
+
+	// 複数のボイスはバスに加算される（ステレオとモノラルの混在）
+	void TestVoicesAreSummed()
+	{
+		constexpr uint32_t kFrameCount = 64;
+		const std::vector<int16_t> stereo = MakePcm16(kFrameCount, 2);
+		const std::vector<int16_t> mono = MakePcm16(kFrameCount, 1);
+
+		SoftwareMixer mixer;
+		mixer.Initialize(nullptr, kSampleRate);
+		const uint32_t stereoId = mixer.CreateVoice(MakeFormat(kFormatTagPcm, 2, kSampleRate, 16));
+		const uint32_t monoId = mixer.CreateVoice(MakeFormat(kFormatTagPcm, 1, kSampleRate, 16));
+		mixer.Start(stereoId, AsBytes(stereo));
+		mixer.Start(monoId, AsBytes(mono));
+		mixer.Render(kFrameCount);
+
+		float gainLeft = 0.0f;
+		float gainRight = 0.0f;
+		MixKernels::CalculatePanGains(1.0f, 0.0f, 1, gainLeft, gainRight);
+
+		const std::span<const float> bus = mixer.GetBus();
+		for (uint32_t frame = 0; frame < kFrameCount; ++frame) {
+			const float monoValue = static_cast<float>(mono[frame]) / 32768.0f;
+			TEST_CHECK(IsNear(bus[frame * 2], static_cast<float>(stereo[frame * 2]) / 32768.0f + monoValue * gainLeft));
+			TEST_CHECK(IsNear(bus[frame * 2 + 1], static_cast<float>(stereo[frame * 2 + 1]) / 32768.0f + monoValue * gainRight));
+		}
+		TEST_CHECK(mixer.GetLastMixedVoiceCount() == 2);
+
+		// 対応外のフォーマットはボイスを作らない
+		TEST_CHECK(mixer.CreateVoice(MakeFormat(kFormatTagPcm, 2, kSampleRate, 8)) == VoiceBackendConstants::kInvalidVoiceId);
+	}
+
+	// Audio::RenderToWaveFile と同じ流れで WAV に書き出す（戻り値は書き出したフレーム数）
+	uint64_t RenderToWaveFile(const std::string& outputPath, const std::vector<std::vector<int16_t>>& sounds)
+	{
+		WavFileAudioSink sink;
+		TEST_CHECK(sink.Open(outputPath, kSampleRate));
+
+		SoftwareMixer mixer;
+		mixer.Initialize(&sink, kSampleRate);
+		VoicePool pool;
+		pool.Initialize(&mixer);
+		for (const std::vector<int16_t>& sound : sounds) {
+			VoicePlayRequest request{};
+			request.soundKey = &sound;
+			request.format = MakeFormat(kFormatTagPcm, 2, kSampleRate / 2, 16);
+			request.samples = AsBytes(sound);
+			TEST_CHECK(pool.Play(request));
+		}
+
+		uint64_t renderedFrames = 0;
+		while (pool.GetActiveVoiceCount() > 0) {
+			mixer.Render(1024);
+			pool.Reclaim();
+			renderedFrames += 1024;
+		}
+		pool.Finalize();
+		sink.Close();
+		return renderedFrames;
+	}
+
+	// WAV への書き出しは決定的で、書き出したファイルは float32 ステレオとして読める
+	void TestWaveSinkIsDeterministic()
+	{
+		const std::vector<std::vector<int16_t>> sounds = { MakePcm16(3000, 2), MakePcm16(1234, 2) };
+		const std::string firstPath = (std::filesystem::temp_directory_path() / "SoftwareMixerTest_first.wav").string();
+		const std::string secondPath = (std::filesystem::temp_directory_path() / "SoftwareMixerTest_second.wav").string();
+
+		const uint64_t renderedFrames = RenderToWaveFile(firstPath, sounds);
+		TEST_CHECK(RenderToWaveFile(secondPath, sounds) == renderedFrames);
+
+		WaveFile first;
+		WaveFile second;
+		TEST_CHECK(first.Open(firstPath));
+		TEST_CHECK(second.Open(secondPath));
+		TEST_CHECK(first.GetSampleFormat() == SampleFormat::Float32);
+		TEST_CHECK(first.GetFormat().channels == 2);
+		TEST_CHECK(first.GetFormat().samplesPerSec == kSampleRate);
+		TEST_CHECK(first.GetFrameCount() == renderedFrames);
+		TEST_CHECK(renderedFrames >= 6000);
+		TEST_CHECK(std::equal(first.GetSamples().begin(), first.GetSamples().end(), second.GetSamples().begin(), second.GetSamples().end()));
+
+		first.Close();
+		second.Close();
+		std::filesystem::remove(firstPath);
+		std::filesystem::remove(secondPath);
+	}
+
+	// NullAudioSink は書き出されたフレーム数だけ数える
+	void TestNullSinkCountsFrames()
+	{
+		NullAudioSink sink;
+		SoftwareMixer mixer;
+		mixer.Initialize(&sink, kSampleRate);
+		mixer.Render(100);
+		mixer.Render(28);
+		TEST_CHECK(sink.GetWrittenFrameCount() == 128);
+	}
+}
+
+int main()
+{
+	TestPanGains();
+	TestStereoPassThrough();
+	TestMonoGainAndBlockSplit();
+	TestResampleHalfRate();
+	TestVoicesAreSummed();
+	TestWaveSinkIsDeterministic();
+	TestNullSinkCountsFrames();
+	return TestCommon::Finish("SoftwareMixerTest");
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdio>
+
+//
+// TestCommon
+// - project/tests のテストで使う最小限のチェック用マクロ。
+// - 失敗しても止めずに場所を出して数え、main の最後で TestCommon::Finish() の戻り値を返す（0 なら成功）。
+//
+namespace TestCommon {
+
+	// 失敗したチェックの数
+	inline int& GetFailureCount()
+	{
+		static int failureCount = 0;
+		return failureCount;
+	}
+
+	// 失敗の記録
+	inline void ReportFailure(const char* expression, const char* file, int line)
+	{
+		std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+		++GetFailureCount();
+	}
+
+	// 結果の表示（main の戻り値にする）
+	inline int Finish(const char* testName)
+	{
+		const int failureCount = GetFailureCount();
+		std::printf("%s: %s (%d failure(s))\n", testName, failureCount == 0 ? "passed" : "FAILED", failureCount);
+		return failureCount == 0 ? 0 : 1;
+	}
+}
+
+// 条件が偽なら失敗として記録する
+#define TEST_CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			TestCommon::ReportFailure(#condition, __FILE__, __LINE__); \
+		} \
+	} while (false)
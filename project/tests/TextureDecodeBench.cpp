@@ -0,0 +1,264 @@
+#include "TestCommon.h"
+#include "BenchCommon.h"
+#include "JobSystem.h"
+#include "TextureDecoder.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+//
+// TextureDecodeBench
+// - TextureDecoder のデコード（ファイル読み込み＋GenerateMipMaps）を測るヘッドレスのベンチマーク（D3D もウィンドウも使わない）。
+//   以前はゲームの実行ファイルの "--bench-texture-decode" で測っていたもの。
+//   * load     : ファイル読み込みだけ
+//   * mips     : 読み込み済みイメージのミップ生成だけ
+//   * serial   : Decode を 1 ファイルずつ順に（TextureManager::LoadTexture と同じ）
+//   * parallel : DecodeAll で JobSystem のワーカーに分ける（TextureManager::LoadTextures と同じ）
+// - 入力は一時ディレクトリに書き出した決まった模様の RGBA8 画像（TGA。Windows では WIC を通す PNG も）。
+//   "--dir ディレクトリ" を付けると、代わりにそのディレクトリ以下の画像（PNG は Windows のみ）を測る。
+// - 計測の前に、フルミップになっていること、最上段が元の画素と一致すること、serial と parallel の結果が一致することを確かめる。
+// - 使い方：TextureDecodeBench [--quick] [--workers N] [--dir ディレクトリ]
+//
+using namespace MyEngine;
+
+namespace {
+	// 計測の規模（1 辺の長さと枚数）
+	struct TextureSize {
+		uint32_t size;
+		uint32_t count;
+	};
+	struct BenchConfig {
+		std::vector<TextureSize> textureSizes = { { 256, 8 }, { 1024, 4 }, { 2048, 2 } };
+		int repeatCount = 5;
+	};
+
+	// 書き出す形式（拡張子）
+#ifdef _WIN32
+	const char* const kGeneratedExtensions[] = { ".tga", ".png" };
+#else
+	const char* const kGeneratedExtensions[] = { ".tga" };
+#endif
+
+	// 決まった模様の RGBA8 画像（グラデーションに細かい模様を重ねて、ミップ生成の結果が一様にならないようにする）
+	DirectX::ScratchImage MakePatternImage(uint32_t size, uint32_t seed)
+	{
+		DirectX::ScratchImage image;
+		HRESULT hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, size, size, 1, 1);
+		TEST_CHECK(SUCCEEDED(hr));
+		const DirectX::Image* pixels = image.GetImage(0, 0, 0);
+		for (uint32_t y = 0; y < size; ++y) {
+			uint8_t* row = pixels->pixels + y * pixels->rowPitch;
+			for (uint32_t x = 0; x < size; ++x) {
+				row[x * 4 + 0] = static_cast<uint8_t>(x * 255 / size);
+				row[x * 4 + 1] = static_cast<uint8_t>(y * 255 / size);
+				row[x * 4 + 2] = static_cast<uint8_t>((x ^ y) * 7 + seed * 31);
+				row[x * 4 + 3] = 255;
+			}
+		}
+		return image;
+	}
+
+	// 画像を書き出す（拡張子で形式を選ぶ）
+	bool SaveImage(const DirectX::ScratchImage& image, const std::string& filePath)
+	{
+		const std::wstring filePathW = TextureDecoder::ToWidePath(filePath);
+#ifdef _WIN32
+		if (filePath.ends_with(".png")) {
+			return SUCCEEDED(DirectX::SaveToWICFile(*image.GetImage(0, 0, 0), DirectX::WIC_FLAGS_FORCE_SRGB,
+				DirectX::GetWICCodec(DirectX::WIC_CODEC_PNG), filePathW.c_str()));
+		}
+#endif
+		return SUCCEEDED(DirectX::SaveToTGAFile(*image.GetImage(0, 0, 0), DirectX::TGA_FLAGS_NONE, filePathW.c_str()));
+	}
+
+	// 一時ディレクトリに入力を書き出し、パスを返す（元の画像は最上段の比較用に sources に残す）
+	std::vector<std::string> WriteInputs(const BenchConfig& config, const std::filesystem::path& directory, std::vector<DirectX::ScratchImage>& sources)
+	{
+		std::filesystem::create_directories(directory);
+		std::vector<std::string> filePaths;
+		uint32_t seed = 0;
+		for (const TextureSize& textureSize : config.textureSizes) {
+			for (uint32_t i = 0; i < textureSize.count; ++i, ++seed) {
+				const char* extension = kGeneratedExtensions[seed % std::size(kGeneratedExtensions)];
+				const std::string filePath = (directory / ("texture" + std::to_string(seed) + extension)).generic_string();
+				DirectX::ScratchImage image = MakePatternImage(textureSize.size, seed);
+				TEST_CHECK(SaveImage(image, filePath));
+				filePaths.push_back(filePath);
+				sources.push_back(std::move(image));
+			}
+		}
+		return filePaths;
+	}
+
+	// ディレクトリ以下の読める画像を集める
+	std::vector<std::string> CollectInputs(const std::string& directory)
+	{
+		std::vector<std::string> filePaths;
+		std::error_code error;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, error)) {
+			const std::string extension = entry.path().extension().generic_string();
+#ifdef _WIN32
+			const bool isSupported = extension == ".png" || extension == ".tga" || extension == ".dds";
+#else
+			const bool isSupported = extension == ".tga" || extension == ".dds";
+#endif
+			if (entry.is_regular_file() && isSupported) {
+				filePaths.push_back(entry.path().generic_string());
+			}
+		}
+		return filePaths;
+	}
+
+	// 1 辺の長さからフルミップの段数
+	size_t GetFullMipCount(size_t width, size_t height)
+	{
+		size_t count = 1;
+		while (width > 1 || height > 1) {
+			width = (std::max)(width / 2, size_t(1));
+			height = (std::max)(height / 2, size_t(1));
+			++count;
+		}
+		return count;
+	}
+
+	bool IsSamePixels(const DirectX::ScratchImage& a, const DirectX::ScratchImage& b)
+	{
+		return a.GetPixelsSize() == b.GetPixelsSize() && std::memcmp(a.GetPixels(), b.GetPixels(), a.GetPixelsSize()) == 0;
+	}
+
+	// デコード結果の検証（元の画像が分かっていれば最上段と比べる）
+	void VerifyDecoded(const std::vector<DirectX::ScratchImage>& serial, const std::vector<DirectX::ScratchImage>& parallel,
+		const std::vector<DirectX::ScratchImage>& sources)
+	{
+		TEST_CHECK(serial.size() == parallel.size());
+		for (size_t i = 0; i < serial.size() && i < parallel.size(); ++i) {
+			const DirectX::TexMetadata& metadata = serial[i].GetMetadata();
+			TEST_CHECK(DirectX::IsCompressed(metadata.format) || metadata.mipLevels == GetFullMipCount(metadata.width, metadata.height));
+			TEST_CHECK(IsSamePixels(serial[i], parallel[i]));
+
+			if (i < sources.size()) {
+				const DirectX::Image* source = sources[i].GetImage(0, 0, 0);
+				const DirectX::Image* top = serial[i].GetImage(0, 0, 0);
+				TEST_CHECK(top != nullptr && top->width == source->width && top->height == source->height);
+				TEST_CHECK(top != nullptr && top->format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB);
+				bool isSameTop = top != nullptr && top->width == source->width && top->height == source->height;
+				for (size_t y = 0; isSameTop && y < source->height; ++y) {
+					isSameTop = std::memcmp(top->pixels + y * top->rowPitch, source->pixels + y * source->rowPitch, source->width * 4) == 0;
+				}
+				TEST_CHECK(isSameTop);
+			}
+		}
+	}
+
+	// 読み込みだけ・ミップ生成だけの内訳
+	void BenchStages(const std::vector<std::string>& filePaths, const BenchConfig& config)
+	{
+		const double operationCount = static_cast<double>(filePaths.size());
+		const double loadNs = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&] {
+			for (const std::string& filePath : filePaths) {
+				DirectX::ScratchImage image = TextureDecoder::LoadFile(filePath);
+			}
+		});
+		BenchCommon::Report("load", loadNs, operationCount);
+
+		std::vector<DirectX::ScratchImage> images;
+		for (const std::string& filePath : filePaths) {
+			images.push_back(TextureDecoder::LoadFile(filePath));
+		}
+		const double mipsNs = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&] {
+			for (const DirectX::ScratchImage& image : images) {
+				// GenerateMipMapsIfNeeded は圧縮済みのイメージを引数から移してしまうため、毎回複製して渡す
+				DirectX::ScratchImage copy;
+				copy.InitializeFromImage(*image.GetImage(0, 0, 0));
+				DirectX::ScratchImage mipImages = TextureDecoder::GenerateMipMapsIfNeeded(copy);
+			}
+		});
+		BenchCommon::Report("mips", mipsNs, operationCount);
+	}
+
+	// 順に・並列にデコードして時間を出し、結果を返す
+	void BenchDecode(const char* name, const std::vector<std::string>& filePaths, const BenchConfig& config,
+		std::vector<DirectX::ScratchImage>& results, bool isParallel)
+	{
+		const double totalNs = BenchCommon::MeasureBestNanoseconds(config.repeatCount, [&] {
+			if (isParallel) {
+				results = TextureDecoder::DecodeAll(filePaths);
+			}
+			else {
+				results.clear();
+				for (const std::string& filePath : filePaths) {
+					results.push_back(TextureDecoder::Decode(filePath));
+				}
+			}
+		});
+		BenchCommon::Report(name, totalNs, static_cast<double>(filePaths.size()));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchConfig config;
+	if (BenchCommon::IsQuick(argc, argv)) {
+		config = BenchConfig{ { { 64, 3 }, { 256, 2 } }, 1 };
+	}
+
+	// "--workers N" でワーカー数を指定（0 でコア数から自動決定）、"--dir ディレクトリ" で実際の画像を測る
+	uint32_t workerCount = 0;
+	std::string inputDirectory;
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (std::strcmp(argv[i], "--workers") == 0) {
+			workerCount = static_cast<uint32_t>(std::atoi(argv[i + 1]));
+		}
+		else if (std::strcmp(argv[i], "--dir") == 0) {
+			inputDirectory = argv[i + 1];
+		}
+	}
+
+#ifdef _WIN32
+	// WIC 用に COM を初期化（ワーカーは TextureDecoder::DecodeAll が初期化する）
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+	// 入力の用意
+	const std::filesystem::path generatedDirectory = std::filesystem::temp_directory_path() / "TextureDecodeBench";
+	std::vector<DirectX::ScratchImage> sources;
+	const std::vector<std::string> filePaths = inputDirectory.empty()
+		? WriteInputs(config, generatedDirectory, sources)
+		: CollectInputs(inputDirectory);
+	TEST_CHECK(!filePaths.empty());
+	if (filePaths.empty()) {
+		return TestCommon::Finish("TextureDecodeBench");
+	}
+	std::printf("TextureDecodeBench: %zu files\n", filePaths.size());
+
+	// JobSystem を初期化する前は呼び出したスレッドだけでデコードする
+	std::vector<DirectX::ScratchImage> serial;
+	BenchStages(filePaths, config);
+	BenchDecode("serial", filePaths, config, serial, false);
+
+	JobSystem& jobSystem = *JobSystem::GetInstance();
+	jobSystem.Initialize(workerCount);
+	std::printf("TextureDecodeBench: %u threads (main + workers)\n", jobSystem.GetThreadCount());
+	std::vector<DirectX::ScratchImage> parallel;
+	BenchDecode("parallel", filePaths, config, parallel, true);
+	jobSystem.Finalize();
+
+	VerifyDecoded(serial, parallel, sources);
+
+	if (inputDirectory.empty()) {
+		std::error_code error;
+		std::filesystem::remove_all(generatedDirectory, error);
+	}
+#ifdef _WIN32
+	CoUninitialize();
+#endif
+	return TestCommon::Finish("TextureDecodeBench");
+}
@@ -0,0 +1,106 @@
+#include "TestCommon.h"
+#include "TextureResidency.h"
+
+//
+// TextureResidencyTest
+// - TextureManager と同じ順番（追い出し → 登録 → 参照）で TextureResidency を動かし、
+//   参照を手放したテクスチャだけが予算超過時に古い順で追い出されることを確かめる。
+//
+using namespace MyEngine;
+
+namespace {
+	constexpr uint64_t kTextureSize = 1024;
+
+	// TextureManager::LoadTexture と同じ手順で読み込む（予算を超える分を先に追い出す）
+	void Load(TextureResidency& residency, uint32_t id, uint64_t sizeBytes)
+	{
+		for (uint32_t evictedId : residency.CollectEvictions(sizeBytes, 0)) {
+			residency.Remove(evictedId);
+		}
+		residency.Add(id, sizeBytes);
+		residency.AddRef(id);
+	}
+
+	// 読み込み → 解放 → 予算超過で、解放したものが追い出される
+	void TestReleasedTextureIsEvictedOverBudget()
+	{
+		TextureResidency residency;
+		residency.SetBudget(kTextureSize * 2);
+
+		Load(residency, 0, kTextureSize);
+		Load(residency, 1, kTextureSize);
+		residency.Release(0);
+		TEST_CHECK(residency.GetRefCount(0) == 0);
+		TEST_CHECK(residency.GetEvictableCount() == 1);
+
+		Load(residency, 2, kTextureSize);
+		TEST_CHECK(!residency.Contains(0));
+		TEST_CHECK(residency.Contains(1));
+		TEST_CHECK(residency.Contains(2));
+		TEST_CHECK(residency.GetUsedBytes() == kTextureSize * 2);
+	}
+
+	// 参照中のテクスチャは予算を超えても追い出さない
+	void TestReferencedTextureIsNeverEvicted()
+	{
+		TextureResidency residency;
+		residency.SetBudget(kTextureSize);
+
+		Load(residency, 0, kTextureSize);
+		TEST_CHECK(residency.CollectEvictions(kTextureSize, 0).empty());
+
+		Load(residency, 1, kTextureSize);
+		TEST_CHECK(residency.Contains(0));
+		TEST_CHECK(residency.GetUsedBytes() > residency.GetBudget());
+	}
+
+	// 参照 0 になった順（最後に使われた順）で古いものから追い出す
+	void TestEvictionFollowsReleaseOrder()
+	{
+		TextureResidency residency;
+		residency.SetBudget(kTextureSize * 3);
+
+		Load(residency, 0, kTextureSize);
+		Load(residency, 1, kTextureSize);
+		Load(residency, 2, kTextureSize);
+		residency.Release(1);
+		residency.Release(0);
+		residency.Release(2);
+
+		// 1 枚分の空きを作るには最も古い 1 だけ、2 枚分なら 1 と 0
+		auto one = residency.CollectEvictions(kTextureSize, 0);
+		TEST_CHECK(one.size() == 1 && one[0] == 1);
+		auto two = residency.CollectEvictions(kTextureSize * 2, 0);
+		TEST_CHECK(two.size() == 2 && two[0] == 1 && two[1] == 0);
+
+		// 再び参照されたものは候補から外れ、次に手放したときは最も新しくなる
+		residency.AddRef(1);
+		residency.Release(1);
+		auto reordered = residency.CollectEvictions(kTextureSize, 0);
+		TEST_CHECK(reordered.size() == 1 && reordered[0] == 0);
+	}
+
+	// 予算内でも SRV スロットが足りなければ要求された数だけ追い出す
+	void TestRequiredSlotsEvictWithinBudget()
+	{
+		TextureResidency residency;
+
+		Load(residency, 0, kTextureSize);
+		Load(residency, 1, kTextureSize);
+		residency.Release(0);
+		residency.Release(1);
+
+		TEST_CHECK(residency.CollectEvictions(0, 0).empty());
+		auto evictions = residency.CollectEvictions(0, 1);
+		TEST_CHECK(evictions.size() == 1 && evictions[0] == 0);
+	}
+}
+
+int main()
+{
+	TestReleasedTextureIsEvictedOverBudget();
+	TestReferencedTextureIsNeverEvicted();
+	TestEvictionFollowsReleaseOrder();
+	TestRequiredSlotsEvictWithinBudget();
+	return TestCommon::Finish("TextureResidencyTest");
+}
@@ -0,0 +1,292 @@
+#include "TestCommon.h"
+#include "TransformHierarchy.h"
+#include "JobSystem.h"
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace MyEngine;
+
+//
+// TransformHierarchyTest
+// - TransformHierarchy の変更の伝播と並列更新を確かめる（D3D を使わない）。
+//   * 変更したノードとその子孫だけを計算し直し、それ以外のノードの行列と isWorldChanged はそのまま
+//   * 何も変えていない階層は 2 回目以降の Update で 1 つも計算しない
+//   * 更新後に追加したノードは、並べ直しの後も番号が変わらず、追加したノードだけを計算する
+//   * 深さごとの ParallelFor で更新した結果が、1 スレッドで更新した結果とビット単位で一致する
+// - 期待値は MakeAffine3x4 と Multiply(Affine3x4, Affine3x4) を親から順に適用して作る（同じ計算なので完全に一致する）。
+//
+namespace {
+	// ノード 1 つ分の入力（期待値の計算用）
+	struct NodeDesc {
+		Vector3 scale;
+		Vector3 rotate;
+		Vector3 translate;
+		uint32_t parent;
+	};
+
+	bool IsSameMatrix(const Affine3x4& a, const Affine3x4& b)
+	{
+		return std::memcmp(&a, &b, sizeof(Affine3x4)) == 0;
+	}
+
+	// 親から順にたどったワールド行列（descs は親が子より前にある）
+	std::vector<Affine3x4> ComputeExpectedWorlds(const std::vector<NodeDesc>& descs)
+	{
+		std::vector<Affine3x4> worlds(descs.size());
+		for (size_t i = 0; i < descs.size(); ++i) {
+			const NodeDesc& desc = descs[i];
+			const Affine3x4 local = Math::MakeAffine3x4(desc.scale, desc.rotate, desc.translate);
+			worlds[i] = (desc.parent == TransformHierarchyConstants::kNoParent) ? local : Math::Multiply(local, worlds[desc.parent]);
+		}
+		return worlds;
+	}
+
+	uint32_t AddNode(TransformHierarchy& hierarchy, std::vector<NodeDesc>& descs, const NodeDesc& desc)
+	{
+		descs.push_back(desc);
+		return hierarchy.Add(desc.scale, desc.rotate, desc.translate, desc.parent);
+	}
+
+	// 全ノードが期待値と一致するか
+	bool MatchesExpected(const TransformHierarchy& hierarchy, const std::vector<NodeDesc>& descs)
+	{
+		const std::vector<Affine3x4> expected = ComputeExpectedWorlds(descs);
+		for (uint32_t id = 0; id < expected.size(); ++id) {
+			if (!IsSameMatrix(hierarchy.GetWorldMatrix(id), expected[id])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 親を変えたときは、その部分木だけを計算し直す
+	void TestChangedParentUpdatesOnlySubtree()
+	{
+		using TransformHierarchyConstants::kNoParent;
+		TransformHierarchy hierarchy;
+		std::vector<NodeDesc> descs;
+		//  rootA ─ childA1 ─ grandchildA11
+		//        └ childA2
+		//  rootB ─ childB1
+		const uint32_t rootA = AddNode(hierarchy, descs, { { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.5f, 0.0f }, { 1.0f, 0.0f, 0.0f }, kNoParent });
+		const uint32_t rootB = AddNode(hierarchy, descs, { { 2.0f, 2.0f, 2.0f }, { 0.0f, 0.0f, 0.3f }, { 0.0f, 5.0f, 0.0f }, kNoParent });
+		const uint32_t childA1 = AddNode(hierarchy, descs, { { 1.0f, 1.0f, 1.0f }, { 0.2f, 0.0f, 0.0f }, { 0.0f, 0.0f, 3.0f }, rootA });
+		const uint32_t childB1 = AddNode(hierarchy, descs, { { 0.5f, 0.5f, 0.5f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, rootB });
+		const uint32_t grandchildA11 = AddNode(hierarchy, descs, { { 1.0f, 2.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 2.0f, 0.0f }, childA1 });
+		const uint32_t childA2 = AddNode(hierarchy, descs, { { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { -3.0f, 0.0f, 0.0f }, rootA });
+
+		hierarchy.Update();
+		TEST_CHECK(hierarchy.GetLastUpdatedCount() == 6);
+		TEST_CHECK(hierarchy.GetDepthCount() == 3);
+		TEST_CHECK(MatchesExpected(hierarchy, descs));
+
+		// 中間のノードを動かすと、そのノードと子だけが変わる
+		const Affine3x4 rootAWorld = hierarchy.GetWorldMatrix(rootA);
+		const Affine3x4 childA2World = hierarchy.GetWorldMatrix(childA2);
+		const Affine3x4 childB1World = hierarchy.GetWorldMatrix(childB1);
+		descs[childA1].translate = { 0.0f, 0.0f, 6.0f };
+		hierarchy.SetTranslate(childA1, descs[childA1].translate);
+		hierarchy.Update();
+		TEST_CHECK(hierarchy.GetLastUpdatedCount() == 2);
+		TEST_CHECK(hierarchy.IsWorldChanged(childA1));
+		TEST_CHECK(hierarchy.IsWorldChanged(grandchildA11));
+		TEST_CHECK(!hierarchy.IsWorldChanged(rootA));
+		TEST_CHECK(!hierarchy.IsWorldChanged(childA2));
+		TEST_CHECK(!hierarchy.IsWorldChanged(rootB));
+		TEST_CHECK(!hierarchy.IsWorldChanged(childB1));
+		TEST_CHECK(IsSameMatrix(hierarchy.GetWorldMatrix(rootA), rootAWorld));
+		TEST_CHECK(IsSameMatrix(hierarchy.GetWorldMatrix(childA2), childA2World));
+		TEST_CHECK(IsSameMatrix(hierarchy.GetWorldMatrix(childB1), childB1World));
+		TEST_CHECK(MatchesExpected(hierarchy, descs));
+
+		// 根を動かすと部分木全体（rootA, childA1, childA2, grandchildA11）が変わり、rootB 側は変わらない
+		descs[rootA].rotate = { 0.0f, -0.7f, 0.0f };
+		hierarchy.SetRotate(rootA, descs[rootA].rotate);
+		hierarchy.Update();
+		TEST_CHECK(hierarchy.GetLastUpdatedCount() == 4);
+		TEST_CHECK(!hierarchy.IsWorldChanged(rootB));
+		TEST_CHECK(!hierarchy.IsWorldChanged(childB1));
+		TEST_CHECK(MatchesExpected(hierarchy, descs));
+
+		// 葉を動かしても親は計算し直さない
+		descs[childB1].scale = { 3.0f, 3.0f, 3.0f };
+		hierarchy.SetScale(childB1, descs[childB1].scale);
+		hierarchy.Update();
+		TEST_CHECK(hierarchy.GetLastUpdatedCount() == 1);
+		TEST_CHECK(!hierarchy.IsWorldChanged(rootB));
+		TEST_CHECK(hierarchy.IsWorldChanged(childB1));
+		TEST_CHECK(MatchesExpected(hierarchy, descs));
+	}
+
+	// 何も変えていない静止した鎖は、2 回目以降 1 つも計算しない
+	void TestStaticChainIsSkipped()
+	{
+		TransformHierarchy hierarchy;
+		std::vector<NodeDesc> descs;
+		uint32_t parent = TransformHierarchyConstants::kNoParent;
+		for (int i = 0; i < 16; ++i) {
+			parent = AddNode(hierarchy, descs, { { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.1f * i, 0.0f }, { 1.0f, 0.0f, 0.0f }, parent });
+		}
+
+		hierarchy.Update();
+		TEST_CHECK(hierarchy.GetLastUpdatedCount() == 16);
+		TEST_CHECK(hierarchy.GetDepthCount() == 16);
+		const std::vector<Affine3x4> expected = ComputeExpectedWorlds(descs);
+
+		for (int frame = 0; frame < 3; ++frame) {
+			hierarchy.Update();
+			TEST_CHECK(hierarchy.GetLastUpdatedCount() == 0);
+			for (uint32_t id = 0; id < descs.size(); ++id) {
+				TEST_CHECK(!hierarchy.IsWorldChanged(id));
+				TEST_CHECK(IsSameMatrix(hierarchy.GetWorldMatrix(id), expected[id]));
+			}
+		}
+
+		// 同じ値を設定しても変更として扱う（値の比較はしない）
+		hierarchy.SetTranslate(15, descs[15].translate);
+		hierarchy.Update();
+		TEST_CHECK(hierarchy.GetLastUpdatedCount() == 1);
+	}
+
+	// 更新後に追加したノードは並べ直した後も番号が変わらず、追加したノードだけを計算する
+	void TestAddAfterUpdateKeepsIds()
+	{
+		using TransformHierarchyConstants::kNoParent;
+		TransformHierarchy hierarchy;
+		std::vector<NodeDesc> descs;
+		const uint32_t root = AddNode(hierarchy, descs, { { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, kNoParent });
+		const uint32_t child = AddNode(hierarchy, descs, { { 1.0f, 1.0f, 1.0f }, { 0.3f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, root });
+		hierarchy.Update();
+
+		// 深さ 0 のノードを後から追加すると、配列上では child より前に並べ直される
+		const uint32_t lateRoot = AddNode(hierarchy, descs, { { 2.0f, 1.0f, 1.0f }, { 0.0f, 0.4f, 0.0f }, { 4.0f, 0.0f, 0.0f }, kNoParent });
+		const uint32_t lateChild = AddNode(hierarchy, descs, { { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.2f }, { 0.0f, 2.0f, 0.0f }, child });
+		TEST_CHECK(lateRoot == 2 && lateChild == 3);
+		hierarchy.Update();
+		TEST_CHECK(hierarchy.GetLastUpdatedCount() == 2);
+		TEST_CHECK(!hierarchy.IsWorldChanged(root));
+		TEST_CHECK(!hierarchy.IsWorldChanged(child));
+		TEST_CHECK(hierarchy.GetTranslate(lateRoot).x == 4.0f);
+		TEST_CHECK(hierarchy.GetTranslate(child).z == 1.0f);
+		TEST_CHECK(MatchesExpected(hierarchy, descs));
+
+		// 並べ直した後も、ノード番号で指定した変更が正しいノードに届く
+		descs[root].translate = { 0.0f, -1.0f, 0.0f };
+		hierarchy.SetTranslate(root, descs[root].translate);
+		hierarchy.Update();
+		TEST_CHECK(hierarchy.GetLastUpdatedCount() == 3);
+		TEST_CHECK(!hierarchy.IsWorldChanged(lateRoot));
+		TEST_CHECK(MatchesExpected(hierarchy, descs));
+
+		hierarchy.Clear();
+		TEST_CHECK(hierarchy.GetNodeCount() == 0);
+		TEST_CHECK(hierarchy.GetDepthCount() == 0);
+	}
+
+	// 1 つの深さに kParallelThreshold 以上のノードがある階層を、同じ内容で 2 つ作る
+	void BuildWideHierarchy(TransformHierarchy& serial, TransformHierarchy& parallel, std::vector<NodeDesc>& descs)
+	{
+		constexpr uint32_t kDepthCount = 4;
+		constexpr uint32_t kWidth = TransformHierarchyConstants::kParallelThreshold * 2 + 37;
+		std::mt19937 random(31337);
+		std::uniform_real_distribution<float> scale(0.8f, 1.25f);
+		std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+		std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+
+		// 深さ d のノードは深さ d - 1 のどれかを親にする。追加は深さを混ぜた順で行い、並べ直しも通す
+		std::vector<std::vector<uint32_t>> idsByDepth(kDepthCount);
+		for (uint32_t i = 0; i < kWidth * kDepthCount; ++i) {
+			uint32_t depth = i % kDepthCount;
+			while (depth > 0 && idsByDepth[depth - 1].empty()) {
+				--depth;
+			}
+			uint32_t parent = TransformHierarchyConstants::kNoParent;
+			if (depth > 0) {
+				const std::vector<uint32_t>& parents = idsByDepth[depth - 1];
+				parent = parents[random() % parents.size()];
+			}
+			const NodeDesc desc = { { scale(random), scale(random), scale(random) },
+				{ angle(random), angle(random), angle(random) },
+				{ position(random), position(random), position(random) }, parent };
+			const uint32_t id = AddNode(serial, descs, desc);
+			TEST_CHECK(parallel.Add(desc.scale, desc.rotate, desc.translate, desc.parent) == id);
+			idsByDepth[depth].push_back(id);
+		}
+	}
+
+	// JobSystem のスレッドでないところから呼ぶと 1 スレッドで更新する
+	void UpdateSerially(TransformHierarchy& hierarchy)
+	{
+		std::thread thread([&hierarchy] { hierarchy.Update(); });
+		thread.join();
+	}
+
+	bool MatchesEachOther(const TransformHierarchy& a, const TransformHierarchy& b)
+	{
+		if (a.GetNodeCount() != b.GetNodeCount() || a.GetLastUpdatedCount() != b.GetLastUpdatedCount()) {
+			return false;
+		}
+		for (uint32_t id = 0; id < a.GetNodeCount(); ++id) {
+			if (!IsSameMatrix(a.GetWorldMatrix(id), b.GetWorldMatrix(id)) || a.IsWorldChanged(id) != b.IsWorldChanged(id)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 深さごとの ParallelFor の結果は 1 スレッドの結果と一致する
+	void TestParallelMatchesSerial()
+	{
+		TransformHierarchy serial;
+		TransformHierarchy parallel;
+		std::vector<NodeDesc> descs;
+		BuildWideHierarchy(serial, parallel, descs);
+
+		JobSystem& jobSystem = *JobSystem::GetInstance();
+		jobSystem.Initialize(3);
+		TEST_CHECK(jobSystem.GetThreadCount() > 1);
+
+		UpdateSerially(serial);
+		const uint64_t executedBefore = jobSystem.GetExecutedJobCount();
+		parallel.Update();
+		// 実際にジョブに分割された
+		TEST_CHECK(jobSystem.GetExecutedJobCount() > executedBefore);
+		TEST_CHECK(serial.GetLastUpdatedCount() == descs.size());
+		TEST_CHECK(MatchesEachOther(serial, parallel));
+		TEST_CHECK(MatchesExpected(parallel, descs));
+
+		// 一部のノードを動かしたときの部分的な更新も一致する
+		std::mt19937 random(99);
+		for (int frame = 0; frame < 4; ++frame) {
+			for (int i = 0; i < 64; ++i) {
+				const uint32_t id = static_cast<uint32_t>(random() % descs.size());
+				descs[id].translate.y += 1.0f;
+				serial.SetTranslate(id, descs[id].translate);
+				parallel.SetTranslate(id, descs[id].translate);
+			}
+			UpdateSerially(serial);
+			parallel.Update();
+			TEST_CHECK(parallel.GetLastUpdatedCount() > 0);
+			TEST_CHECK(parallel.GetLastUpdatedCount() < descs.size());
+			TEST_CHECK(MatchesEachOther(serial, parallel));
+			TEST_CHECK(MatchesExpected(parallel, descs));
+		}
+
+		// 変更が無ければ並列でも何もしない
+		parallel.Update();
+		TEST_CHECK(parallel.GetLastUpdatedCount() == 0);
+
+		jobSystem.Finalize();
+	}
+}
+
+int main()
+{
+	TestChangedParentUpdatesOnlySubtree();
+	TestStaticChainIsSkipped();
+	TestAddAfterUpdateKeepsIds();
+	TestParallelMatchesSerial();
+	return TestCommon::Finish("TransformHierarchyTest");
+}
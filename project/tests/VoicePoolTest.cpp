@@ -0,0 +1,261 @@
+#include "TestCommon.h"
+#include "VoicePool.h"
+#include <map>
+
+//
+// VoicePoolTest
+// - XAudio2 の代わりに、作ったボイスと再生状態を覚えるだけの FakeVoiceBackend で VoicePool を動かす。
+// - 使い回し・同時再生数の上限・優先度による奪い合い・フォーマット違いの作り直し・リークしないことを確かめる。
+//
+using namespace MyEngine;
+using namespace MyEngine::VoiceBackendConstants;
+
+namespace {
+	/// <summary>
+	/// テスト用のバックエンド
+	/// 再生は Finish を呼ぶまで終わらない。作成・破棄の回数を数え、生きているボイスを覚える
+	/// </summary>
+	class FakeVoiceBackend : public VoiceBackendBase
+	{
+	public:
+		uint32_t CreateVoice(const WaveFormat& format) override
+		{
+			if (failCreate_) {
+				return kInvalidVoiceId;
+			}
+			const uint32_t voiceId = nextVoiceId_++;
+			voices_[voiceId] = FakeVoice{ format, {}, false };
+			++createCount_;
+			return voiceId;
+		}
+
+		void DestroyVoice(uint32_t voiceId) override
+		{
+			TEST_CHECK(voices_.erase(voiceId) == 1);
+			++destroyCount_;
+		}
+
+		void Start(uint32_t voiceId, std::span<const uint8_t> samples) override
+		{
+			FakeVoice& voice = voices_.at(voiceId);
+			TEST_CHECK(!voice.isPlaying);
+			voice.samples = samples;
+			voice.isPlaying = true;
+		}
+
+		void Stop(uint32_t voiceId) override { voices_.at(voiceId).isPlaying = false; }
+
+		bool IsPlaying(uint32_t voiceId) const override { return voices_.at(voiceId).isPlaying; }
+
+		// samples を再生中のボイスを自然に再生し終えさせる
+		void Finish(std::span<const uint8_t> samples)
+		{
+			for (auto& [voiceId, voice] : voices_) {
+				if (voice.isPlaying && voice.samples.data() == samples.data()) {
+					voice.isPlaying = false;
+				}
+			}
+		}
+
+		// samples を再生中のボイス数
+		uint32_t CountPlaying(std::span<const uint8_t> samples) const
+		{
+			uint32_t count = 0;
+			for (const auto& [voiceId, voice] : voices_) {
+				count += (voice.isPlaying && voice.samples.data() == samples.data()) ? 1 : 0;
+			}
+			return count;
+		}
+
+		void SetFailCreate(bool failCreate) { failCreate_ = failCreate; }
+		uint32_t GetCreateCount() const { return createCount_; }
+		uint32_t GetDestroyCount() const { return destroyCount_; }
+		size_t GetLiveVoiceCount() const { return voices_.size(); }
+
+	private:
+		struct FakeVoice {
+			WaveFormat format;
+			std::span<const uint8_t> samples;
+			bool isPlaying = false;
+		};
+
+		std::map<uint32_t, FakeVoice> voices_;
+		uint32_t nextVoiceId_ = 0;
+		uint32_t createCount_ = 0;
+		uint32_t destroyCount_ = 0;
+		bool failCreate_ = false;
+	};
+
+	// テスト用のサウンド（波形のアドレスを soundKey にする）
+	struct FakeSound {
+		WaveFormat format;
+		std::vector<uint8_t> samples;
+
+		VoicePlayRequest MakeRequest(int32_t priority = VoicePoolConstants::kDefaultPriority,
+			uint32_t maxInstances = VoicePoolConstants::kDefaultMaxInstances) const
+		{
+			return VoicePlayRequest{ this, format, samples, priority, maxInstances };
+		}
+	};
+
+	const WaveFormat kStereo16{ WaveFileConstants::kFormatTagPcm, 2, 44100, 44100 * 4, 4, 16 };
+	const WaveFormat kMonoFloat{ WaveFileConstants::kFormatTagFloat, 1, 48000, 48000 * 4, 4, 32 };
+
+	// 再生し終えたボイスは同じフォーマットの次の再生に使い回す（作り直さない）
+	void TestFinishedVoiceIsReused()
+	{
+		FakeVoiceBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 4);
+		const FakeSound a{ kStereo16, std::vector<uint8_t>(64) };
+		const FakeSound b{ kStereo16, std::vector<uint8_t>(64) };
+
+		for (int i = 0; i < 100; ++i) {
+			TEST_CHECK(pool.Play(a.MakeRequest()));
+			backend.Finish(a.samples);
+			TEST_CHECK(pool.Play(b.MakeRequest()));
+			backend.Finish(b.samples);
+		}
+		TEST_CHECK(backend.GetCreateCount() == 1);
+		TEST_CHECK(pool.GetVoiceCount() == 1);
+
+		pool.Reclaim();
+		TEST_CHECK(pool.GetActiveVoiceCount() == 0);
+
+		pool.Finalize();
+		TEST_CHECK(backend.GetLiveVoiceCount() == 0);
+	}
+
+	// 同じサウンドは maxInstances 個までで、超えたら最も古いものを止めて鳴らす
+	void TestPerSoundInstanceLimit()
+	{
+		FakeVoiceBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 8);
+		const FakeSound explosion{ kStereo16, std::vector<uint8_t>(64) };
+
+		for (int i = 0; i < 5; ++i) {
+			TEST_CHECK(pool.Play(explosion.MakeRequest(0, 2)));
+			TEST_CHECK(backend.CountPlaying(explosion.samples) <= 2);
+		}
+		TEST_CHECK(backend.CountPlaying(explosion.samples) == 2);
+		TEST_CHECK(pool.GetActiveVoiceCount() == 2);
+		TEST_CHECK(pool.GetVoiceCount() <= 2);
+
+		pool.Finalize();
+		TEST_CHECK(backend.GetLiveVoiceCount() == 0);
+	}
+
+	// 上限に達したら優先度が低く古いものから奪い、リクエストより高いものしか無ければ鳴らさない
+	void TestPriorityStealing()
+	{
+		FakeVoiceBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 2);
+		const FakeSound low{ kStereo16, std::vector<uint8_t>(64) };
+		const FakeSound lowLater{ kStereo16, std::vector<uint8_t>(64) };
+		const FakeSound high{ kStereo16, std::vector<uint8_t>(64) };
+		const FakeSound highOther{ kStereo16, std::vector<uint8_t>(64) };
+
+		TEST_CHECK(pool.Play(low.MakeRequest(0)));
+		TEST_CHECK(pool.Play(lowLater.MakeRequest(0)));
+
+		// 優先度の同じ 2 つのうち古い方（low）が奪われる
+		TEST_CHECK(pool.Play(high.MakeRequest(10)));
+		TEST_CHECK(backend.CountPlaying(low.samples) == 0);
+		TEST_CHECK(backend.CountPlaying(lowLater.samples) == 1);
+		TEST_CHECK(backend.CountPlaying(high.samples) == 1);
+
+		// 次は残った低優先度のもの
+		TEST_CHECK(pool.Play(highOther.MakeRequest(10)));
+		TEST_CHECK(backend.CountPlaying(lowLater.samples) == 0);
+
+		// 全部がリクエストより高優先度なら鳴らさない
+		TEST_CHECK(!pool.Play(low.MakeRequest(5)));
+		TEST_CHECK(backend.CountPlaying(high.samples) == 1);
+		TEST_CHECK(backend.CountPlaying(highOther.samples) == 1);
+		TEST_CHECK(pool.GetVoiceCount() == 2);
+
+		pool.Finalize();
+		TEST_CHECK(backend.GetLiveVoiceCount() == 0);
+	}
+
+	// 空きボイスのフォーマットが違えば、上限の範囲で作り直して鳴らす
+	void TestFormatMismatchRecreatesIdleVoice()
+	{
+		FakeVoiceBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 1);
+		const FakeSound stereo{ kStereo16, std::vector<uint8_t>(64) };
+		const FakeSound mono{ kMonoFloat, std::vector<uint8_t>(64) };
+
+		TEST_CHECK(pool.Play(stereo.MakeRequest()));
+		backend.Finish(stereo.samples);
+		TEST_CHECK(pool.Play(mono.MakeRequest()));
+		TEST_CHECK(backend.GetCreateCount() == 2);
+		TEST_CHECK(backend.GetDestroyCount() == 1);
+		TEST_CHECK(backend.GetLiveVoiceCount() == 1);
+
+		pool.Finalize();
+		TEST_CHECK(backend.GetLiveVoiceCount() == 0);
+	}
+
+	// StopSound で止めたボイスは破棄され、以後の再生でも生きているボイスは上限を超えない
+	void TestStopSoundAndVoiceCap()
+	{
+		FakeVoiceBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 3);
+		const FakeSound a{ kStereo16, std::vector<uint8_t>(64) };
+		const FakeSound b{ kMonoFloat, std::vector<uint8_t>(64) };
+
+		for (int i = 0; i < 50; ++i) {
+			pool.Play(a.MakeRequest(i % 3, 2));
+			pool.Play(b.MakeRequest(i % 2, 2));
+			if (i % 7 == 0) {
+				pool.StopSound(&a);
+				TEST_CHECK(backend.CountPlaying(a.samples) == 0);
+			}
+			if (i % 5 == 0) {
+				backend.Finish(b.samples);
+			}
+			TEST_CHECK(backend.GetLiveVoiceCount() <= 3);
+			TEST_CHECK(pool.GetActiveVoiceCount() <= 3);
+		}
+
+		pool.Finalize();
+		TEST_CHECK(backend.GetLiveVoiceCount() == 0);
+		TEST_CHECK(backend.GetCreateCount() == backend.GetDestroyCount());
+	}
+
+	// ボイスを作れなければ再生は失敗し、状態は壊れない
+	void TestCreateFailure()
+	{
+		FakeVoiceBackend backend;
+		VoicePool pool;
+		pool.Initialize(&backend, 2);
+		const FakeSound a{ kStereo16, std::vector<uint8_t>(64) };
+
+		backend.SetFailCreate(true);
+		TEST_CHECK(!pool.Play(a.MakeRequest()));
+		TEST_CHECK(pool.GetActiveVoiceCount() == 0);
+
+		backend.SetFailCreate(false);
+		TEST_CHECK(pool.Play(a.MakeRequest()));
+		TEST_CHECK(pool.GetActiveVoiceCount() == 1);
+
+		pool.Finalize();
+		TEST_CHECK(backend.GetLiveVoiceCount() == 0);
+	}
+}
+
+int main()
+{
+	TestFinishedVoiceIsReused();
+	TestPerSoundInstanceLimit();
+	TestPriorityStealing();
+	TestFormatMismatchRecreatesIdleVoice();
+	TestStopSoundAndVoiceCap();
+	TestCreateFailure();
+	return TestCommon::Finish("VoicePoolTest");
+}
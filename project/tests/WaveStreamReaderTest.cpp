@@ -0,0 +1,194 @@
+#include "TestCommon.h"
+#include "WaveTestData.h"
+#include "WaveStreamReader.h"
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <filesystem>
+
+//
+// WaveStreamReaderTest
+// - AudioStream と同じリングバッファの回し方で WaveStreamReader から読み、XAudio2 の代わりに
+//   何も鳴らさないボイス（NullStreamVoice）へ積む。積まれたバイト列が data チャンクと一致することを確かめる。
+//
+using namespace MyEngine;
+using namespace MyEngine::RiffConstants;
+using namespace MyEngine::WaveStreamConstants;
+
+namespace {
+	constexpr uint32_t kSampleRate = 44100;
+
+	/// <summary>
+	/// 何も鳴らさないストリーム用ボイス
+	/// 積まれたバッファを順に「再生」して出力に連結し、同時に積まれていた最大数を記録する
+	/// </summary>
+	class NullStreamVoice
+	{
+	public:
+		void SubmitBuffer(std::span<const uint8_t> buffer)
+		{
+			queued_.push_back(buffer);
+			maxQueuedCount_ = (std::max)(maxQueuedCount_, queued_.size());
+		}
+
+		// 先頭のバッファを 1 つ再生し終える（OnBufferEnd 相当）
+		void PlayOneBuffer()
+		{
+			output_.insert(output_.end(), queued_.front().begin(), queued_.front().end());
+			queued_.pop_front();
+		}
+
+		size_t GetQueuedCount() const { return queued_.size(); }
+		size_t GetMaxQueuedCount() const { return maxQueuedCount_; }
+		const std::vector<uint8_t>& GetOutput() const { return output_; }
+
+	private:
+		std::deque<std::span<const uint8_t>> queued_;
+		std::vector<uint8_t> output_;
+		size_t maxQueuedCount_ = 0;
+	};
+
+	// AudioStream と同じく、kStreamBufferCount 個のバッファを読んでは積み、1 つ再生し終えるたびに詰め直す
+	// loopCount 回目の終端まで流し、読み込みのサイズを検証する
+	void StreamToNullVoice(WaveStreamReader& reader, NullStreamVoice& voice, uint32_t loopCount)
+	{
+		std::array<std::vector<uint8_t>, kStreamBufferCount> buffers;
+		for (std::vector<uint8_t>& buffer : buffers) {
+			buffer.resize(kStreamChunkBytes);
+		}
+
+		uint32_t nextBuffer = 0;
+		uint32_t loop = 0;
+		while (true) {
+			// 空いているバッファを埋めて積む
+			while (voice.GetQueuedCount() < kStreamBufferCount && loop < loopCount) {
+				std::vector<uint8_t>& buffer = buffers[nextBuffer];
+				const size_t size = reader.Read(buffer);
+				if (size == 0) {
+					// 終端。ループする間は先頭に戻る
+					if (++loop < loopCount) {
+						reader.Rewind();
+					}
+					continue;
+				}
+				TEST_CHECK(size <= kStreamChunkBytes);
+				TEST_CHECK(size % reader.GetFormat().blockAlign == 0);
+				voice.SubmitBuffer(std::span<const uint8_t>(buffer.data(), size));
+				nextBuffer = (nextBuffer + 1) % kStreamBufferCount;
+			}
+			if (voice.GetQueuedCount() == 0) {
+				break;
+			}
+			voice.PlayOneBuffer();
+		}
+	}
+
+	// 順不同のチャンクを含む長い WAV を、少ないバッファで先頭から最後まで正しく流せる
+	void TestStreamsWholeDataChunk()
+	{
+		// チャンク 2.5 個分 + 端数（4 バイト/フレームの倍数）
+		const std::vector<uint8_t> samples = WaveTestData::MakePattern(kStreamChunkBytes * 5 / 2 + 4 * 37);
+		const std::vector<uint8_t> bytes = WaveTestData::BuildRiff({
+			{ MakeFourCC('L', 'I', 'S', 'T'), WaveTestData::MakePattern(27) },
+			{ kFmtId, WaveTestData::MakeFormatChunk(WaveFileConstants::kFormatTagPcm, 2, kSampleRate, 16) },
+			{ MakeFourCC('c', 'u', 'e', ' '), WaveTestData::MakePattern(24) },
+			{ kDataId, samples },
+		});
+		const std::string path = WaveTestData::WriteTempFile("WaveStreamReaderTest_stream.wav", bytes);
+
+		WaveStreamReader reader;
+		TEST_CHECK(reader.Open(path));
+		TEST_CHECK(reader.GetFormat().channels == 2);
+		TEST_CHECK(reader.GetDataSize() == samples.size());
+
+		NullStreamVoice voice;
+		StreamToNullVoice(reader, voice, 1);
+		TEST_CHECK(voice.GetOutput() == samples);
+		TEST_CHECK(voice.GetMaxQueuedCount() <= kStreamBufferCount);
+		TEST_CHECK(reader.IsEnd());
+
+		std::array<uint8_t, 16> rest{};
+		TEST_CHECK(reader.Read(rest) == 0);
+
+		reader.Close();
+		std::filesystem::remove(path);
+	}
+
+	// ループ再生では終端で先頭に戻り、同じ波形を繰り返す
+	void TestLoopRewindsToDataStart()
+	{
+		// 24bit モノラル（3 バイト/フレーム）はチャンクの大きさで割り切れないため、毎回端数を切り詰めて読む
+		const std::vector<uint8_t> samples = WaveTestData::MakePattern(3 * 22000, 2);
+		const std::vector<uint8_t> bytes = WaveTestData::BuildWave(
+			WaveTestData::MakeFormatChunk(WaveFileConstants::kFormatTagPcm, 1, kSampleRate, 24), samples);
+		const std::string path = WaveTestData::WriteTempFile("WaveStreamReaderTest_loop.wav", bytes);
+
+		WaveStreamReader reader;
+		TEST_CHECK(reader.Open(path));
+
+		NullStreamVoice voice;
+		StreamToNullVoice(reader, voice, 3);
+
+		std::vector<uint8_t> expected;
+		for (int i = 0; i < 3; ++i) {
+			expected.insert(expected.end(), samples.begin(), samples.end());
+		}
+		TEST_CHECK(voice.GetOutput() == expected);
+
+		reader.Close();
+		std::filesystem::remove(path);
+	}
+
+	// data の末尾が途中で切れたフレームは読まない
+	void TestPartialFrameIsDropped()
+	{
+		const std::vector<uint8_t> samples = WaveTestData::MakePattern(8 * 100 + 5, 3);
+		const std::vector<uint8_t> bytes = WaveTestData::BuildWave(
+			WaveTestData::MakeFormatChunk(WaveFileConstants::kFormatTagFloat, 2, kSampleRate, 32), samples);
+		const std::string path = WaveTestData::WriteTempFile("WaveStreamReaderTest_partial.wav", bytes);
+
+		WaveStreamReader reader;
+		TEST_CHECK(reader.Open(path));
+		TEST_CHECK(reader.GetDataSize() == 8 * 100);
+
+		// バッファがフレームの途中で終わる場合も blockAlign の倍数に切り詰める
+		std::vector<uint8_t> buffer(8 * 30 + 3);
+		std::vector<uint8_t> output;
+		while (size_t size = reader.Read(buffer)) {
+			TEST_CHECK(size == 8 * 30 || size == 8 * 10);
+			output.insert(output.end(), buffer.begin(), buffer.begin() + size);
+		}
+		TEST_CHECK(output.size() == 8 * 100);
+		TEST_CHECK(std::equal(output.begin(), output.end(), samples.begin()));
+
+		reader.Close();
+		std::filesystem::remove(path);
+	}
+
+	// 開けないファイル・対応していない形式は Open が false を返し、読んでも何も返さない
+	void TestOpenFailures()
+	{
+		WaveStreamReader reader;
+		TEST_CHECK(!reader.Open((std::filesystem::temp_directory_path() / "WaveStreamReaderTest_missing.wav").string()));
+		TEST_CHECK(!reader.IsOpen());
+
+		// 8bit PCM は対応外
+		const std::vector<uint8_t> bytes = WaveTestData::BuildWave(
+			WaveTestData::MakeFormatChunk(WaveFileConstants::kFormatTagPcm, 1, kSampleRate, 8), WaveTestData::MakePattern(64));
+		const std::string path = WaveTestData::WriteTempFile("WaveStreamReaderTest_pcm8.wav", bytes);
+		TEST_CHECK(!reader.Open(path));
+
+		std::array<uint8_t, 16> buffer{};
+		TEST_CHECK(reader.Read(buffer) == 0);
+		std::filesystem::remove(path);
+	}
+}
+
+int main()
+{
+	TestStreamsWholeDataChunk();
+	TestLoopRewindsToDataStart();
+	TestPartialFrameIsDropped();
+	TestOpenFailures();
+	return TestCommon::Finish("WaveStreamReaderTest");
+}
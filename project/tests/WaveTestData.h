@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "RiffReader.h"
+#include "WaveFile.h"
+
+//
+// WaveTestData
+// - テスト用の WAV / RIFF のバイト列をメモリ上で組み立てる。
+// - チャンクの並び・パディング・サイズを自由に決められるので、壊れたファイルや珍しい並びも作れる。
+//
+namespace WaveTestData {
+
+	// チャンク 1 つ分
+	struct Chunk {
+		uint32_t id = 0;
+		std::vector<uint8_t> data;
+	};
+
+	// リトルエンディアンで値を追加する
+	template <typename T>
+	void Append(std::vector<uint8_t>& bytes, T value)
+	{
+		uint8_t raw[sizeof(T)];
+		std::memcpy(raw, &value, sizeof(T));
+		bytes.insert(bytes.end(), raw, raw + sizeof(T));
+	}
+
+	// fmt チャンクの本体（extensible なら WAVE_FORMAT_EXTENSIBLE の 40 バイト版）
+	inline std::vector<uint8_t> MakeFormatChunk(uint16_t formatTag, uint16_t channels, uint32_t sampleRate, uint16_t bitsPerSample, bool extensible = false)
+	{
+		const uint16_t blockAlign = static_cast<uint16_t>(channels * bitsPerSample / 8);
+		std::vector<uint8_t> bytes;
+		Append<uint16_t>(bytes, extensible ? MyEngine::WaveFileConstants::kFormatTagExtensible : formatTag);
+		Append<uint16_t>(bytes, channels);
+		Append<uint32_t>(bytes, sampleRate);
+		Append<uint32_t>(bytes, sampleRate * blockAlign);
+		Append<uint16_t>(bytes, blockAlign);
+		Append<uint16_t>(bytes, bitsPerSample);
+		if (extensible) {
+			// cbSize, wValidBitsPerSample, dwChannelMask, SubFormat（先頭 2 バイトがフォーマットタグ）
+			Append<uint16_t>(bytes, 22);
+			Append<uint16_t>(bytes, bitsPerSample);
+			Append<uint32_t>(bytes, channels == 1 ? 0x4u : 0x3u);
+			Append<uint16_t>(bytes, formatTag);
+			bytes.resize(MyEngine::WaveFileConstants::kExtensibleFormatChunkMinSize, 0);
+		}
+		return bytes;
+	}
+
+	// 決まった並びのダミーデータ（中身の比較用）
+	inline std::vector<uint8_t> MakePattern(size_t size, uint32_t seed = 1)
+	{
+		std::vector<uint8_t> bytes(size);
+		for (size_t i = 0; i < size; ++i) {
+			bytes[i] = static_cast<uint8_t>((i * 31 + seed * 17 + (i >> 8)) & 0xFF);
+		}
+		return bytes;
+	}
+
+	// RIFF ファイル全体を組み立てる（奇数サイズのチャンクの後ろにはパディングを入れる）
+	inline std::vector<uint8_t> BuildRiff(const std::vector<Chunk>& chunks, uint32_t formType = MyEngine::RiffConstants::kWaveId)
+	{
+		std::vector<uint8_t> bytes;
+		Append<uint32_t>(bytes, MyEngine::RiffConstants::kRiffId);
+		Append<uint32_t>(bytes, 0);
+		Append<uint32_t>(bytes, formType);
+		for (const Chunk& chunk : chunks) {
+			Append<uint32_t>(bytes, chunk.id);
+			Append<uint32_t>(bytes, static_cast<uint32_t>(chunk.data.size()));
+			bytes.insert(bytes.end(), chunk.data.begin(), chunk.data.end());
+			if (chunk.data.size() & 1) {
+				bytes.push_back(0);
+			}
+		}
+		const uint32_t riffSize = static_cast<uint32_t>(bytes.size() - MyEngine::RiffConstants::kChunkHeaderSize);
+		std::memcpy(bytes.data() + 4, &riffSize, sizeof(riffSize));
+		return bytes;
+	}
+
+	// fmt → data だけの素直な WAV
+	inline std::vector<uint8_t> BuildWave(const std::vector<uint8_t>& formatChunk, const std::vector<uint8_t>& samples)
+	{
+		return BuildRiff({ { MyEngine::RiffConstants::kFmtId, formatChunk }, { MyEngine::RiffConstants::kDataId, samples } });
+	}
+
+	// 一時ディレクトリにファイルとして書き出し、パスを返す
+	inline std::string WriteTempFile(const std::string& fileName, const std::vector<uint8_t>& bytes)
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / fileName;
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		return path.string();
+	}
+}
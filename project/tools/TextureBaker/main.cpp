@@ -0,0 +1,35 @@
+#include "TextureBaker.h"
+#include "TextureCache.h"
+#include <cstdio>
+#include <string>
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+//
+// TextureBaker
+// - ゲームを起動せずにテクスチャをベイクする単体の実行ファイル（処理は engine/manager/TextureBaker）。
+// - キャッシュとマニフェストは実行時のディレクトリからの相対パス（resources/textureCache/）に置くため、
+//   ゲームと同じく project ディレクトリで実行する。
+// - 使い方：TextureBaker [ディレクトリ]（省略時は resources）
+//   ファイルごとの結果はログ（Windows はデバッグ出力、それ以外は標準エラー）に、件数は標準出力に出す。
+//
+int main(int argc, char** argv)
+{
+	using namespace MyEngine;
+
+	const std::string sourceDirectory = argc > 1 ? argv[1] : TextureBakerConstants::kDefaultSourceDirectory;
+
+#ifdef _WIN32
+	// WIC 用に COM を初期化
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+	const uint32_t bakedCount = TextureBaker::BakeDirectory(sourceDirectory);
+	std::printf("TextureBaker: %u textures cached in %s\n", bakedCount, TextureCacheConstants::kCacheDirectory);
+
+#ifdef _WIN32
+	CoUninitialize();
+#endif
+	return 0;
+}